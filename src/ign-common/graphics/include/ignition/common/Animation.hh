@@ -145,11 +145,12 @@ namespace ignition
       /// \param[out] _kf PoseKeyFrame reference to hold the interpolated result
       public: void InterpolatedKeyFrame(PoseKeyFrame &_kf) const;
 
-      /// \brief Get a keyframe using a passed in time.
+      /// \brief Get a keyframe using a passed in time, without changing the
+      /// animation's current time.
       /// \param[in] _time Time in seconds
       /// \param[out] _kf PoseKeyFrame reference to hold the interpolated result
-      protected: void InterpolatedKeyFrame(const double _time,
-                                              PoseKeyFrame &_kf) const;
+      public: void InterpolatedKeyFrame(const double _time,
+                                        PoseKeyFrame &_kf) const;
 
       /// \brief Update the pose splines
       protected: void BuildInterpolationSplines() const;
@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_COMMON_CONVEXDECOMPOSITION_HH_
+#define IGNITION_COMMON_CONVEXDECOMPOSITION_HH_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <ignition/math/Vector3.hh>
+
+#include <ignition/common/graphics/Export.hh>
+#include <ignition/common/SuppressWarning.hh>
+
+namespace ignition
+{
+  namespace common
+  {
+    /// \brief forward declaration
+    class ConvexDecompositionPrivate;
+    class Mesh;
+    class SubMesh;
+
+    /// \class ConvexDecomposition ConvexDecomposition.hh
+    /// ignition/common/ConvexDecomposition.hh
+    /// \brief Approximates a mesh by a set of convex hulls, which collision
+    /// checkers handle much faster and more robustly than arbitrary
+    /// triangle meshes.
+    ///
+    /// The triangles of the mesh are voxelized, and the set of voxels is
+    /// split recursively by axis aligned planes, each time splitting the part
+    /// whose convex hull is furthest from the voxels it encloses, until the
+    /// maximum number of hulls is reached or every part is convex enough.
+    /// The hull of each part is built from the mesh surface inside the part
+    /// and from the faces of the voxels along the cuts, so a convex mesh
+    /// gives back its own convex hull.
+    ///
+    /// The mesh should be closed for its inside to be filled. Open parts
+    /// are approximated from their surface only.
+    class IGNITION_COMMON_GRAPHICS_VISIBLE ConvexDecomposition
+    {
+      /// \brief Constructor
+      public: ConvexDecomposition();
+
+      /// \brief Destructor
+      public: virtual ~ConvexDecomposition();
+
+      /// \brief Set the maximum number of convex hulls.
+      /// \param[in] _count Maximum number of hulls. The default is 16.
+      public: void SetMaxConvexHulls(const unsigned int _count);
+
+      /// \brief Get the maximum number of convex hulls.
+      /// \return Maximum number of hulls.
+      public: unsigned int MaxConvexHulls() const;
+
+      /// \brief Set the number of voxels along the longest side of the mesh
+      /// bounding box.
+      /// \param[in] _resolution Voxel resolution. The default is 32.
+      public: void SetVoxelResolution(const unsigned int _resolution);
+
+      /// \brief Get the number of voxels along the longest side of the mesh
+      /// bounding box.
+      /// \return Voxel resolution.
+      public: unsigned int VoxelResolution() const;
+
+      /// \brief Set the volume between a part and its hull, relative to the
+      /// volume of the whole mesh, below which a part isn't split anymore.
+      /// \param[in] _concavity Maximum concavity. The default is 0.01.
+      public: void SetMaxConcavity(const double _concavity);
+
+      /// \brief Get the maximum concavity of a part.
+      /// \return Maximum concavity.
+      public: double MaxConcavity() const;
+
+      /// \brief Set the maximum number of vertices of each convex hull.
+      /// Hulls with more extreme points are built from the ones furthest
+      /// out.
+      /// \param[in] _count Maximum number of vertices, at least 4. The
+      /// default is 64.
+      public: void SetMaxHullVertices(const unsigned int _count);
+
+      /// \brief Get the maximum number of vertices of each convex hull.
+      /// \return Maximum number of vertices.
+      public: unsigned int MaxHullVertices() const;
+
+      /// \brief Decompose all the triangle submeshes of a mesh together.
+      /// \param[in] _mesh The mesh to decompose.
+      /// \return A new mesh, owned by the caller, with one submesh per
+      /// convex hull, or nullptr if the mesh has no triangles with an area.
+      public: Mesh *Decompose(const Mesh &_mesh) const;
+
+      /// \brief Compute the convex hull of a set of points.
+      /// \param[in] _points The points.
+      /// \param[in] _maxVertices Maximum number of vertices of the hull, or
+      /// 0 for no limit.
+      /// \return A closed submesh made of the triangles of the hull, facing
+      /// outwards, or nullptr if the points are all on a plane.
+      public: static std::unique_ptr<SubMesh> ConvexHull(
+                  const std::vector<ignition::math::Vector3d> &_points,
+                  const unsigned int _maxVertices = 0);
+
+      /// \brief Get a name for the cached decomposition of a mesh, which
+      /// depends on the decomposition parameters.
+      /// \return Name to use as a MeshCache variant.
+      /// \sa MeshCache::Load
+      public: std::string CacheVariant() const;
+
+      IGN_COMMON_WARN_IGNORE__DLL_INTERFACE_MISSING
+      /// \brief Pointer to private data
+      private: std::unique_ptr<ConvexDecompositionPrivate> dataPtr;
+      IGN_COMMON_WARN_RESUME__DLL_INTERFACE_MISSING
+    };
+  }
+}
+#endif
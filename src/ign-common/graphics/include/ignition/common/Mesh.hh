@@ -27,6 +27,7 @@
 #include <ignition/common/graphics/Types.hh>
 #include <ignition/common/graphics/Export.hh>
 #include <ignition/common/SuppressWarning.hh>
+#include <ignition/common/SubMesh.hh>
 
 namespace ignition
 {
@@ -189,6 +190,13 @@ namespace ignition
       /// \param[in] _vec Amount to translate vertices.
       public: void Translate(const ignition::math::Vector3d &_vec);
 
+      /// \brief Set the precision in which the vertex attributes of all
+      /// current submeshes are stored.
+      /// \param[in] _precision The vertex precision.
+      /// \sa SubMesh::SetVertexPrecision
+      public: void SetVertexPrecision(
+                  const SubMesh::VertexPrecision _precision);
+
       IGN_COMMON_WARN_IGNORE__DLL_INTERFACE_MISSING
       /// \brief Private data pointer.
       private: std::unique_ptr<MeshPrivate> dataPtr;
@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_COMMON_MESHCACHE_HH_
+#define IGNITION_COMMON_MESHCACHE_HH_
+
+#include <memory>
+#include <string>
+
+#include <ignition/common/graphics/Export.hh>
+#include <ignition/common/SuppressWarning.hh>
+
+namespace ignition
+{
+  namespace common
+  {
+    /// \brief forward declaration
+    class Mesh;
+    class MeshCachePrivate;
+
+    /// \class MeshCache MeshCache.hh ignition/common/MeshCache.hh
+    /// \brief On-disk cache of meshes loaded from files. Each mesh is stored
+    /// in its own file of the cache directory, in a binary format made of
+    /// flat arrays which is read in a single pass, including its materials,
+    /// skeleton and skeleton animations.
+    ///
+    /// A cached mesh is only used if its source file still has the path,
+    /// modification time and content hash it had when the mesh was saved.
+    ///
+    /// Meshes derived from a source file, such as its convex decomposition,
+    /// are cached under a variant name next to the mesh itself, and are
+    /// invalidated along with it.
+    class IGNITION_COMMON_GRAPHICS_VISIBLE MeshCache
+    {
+      /// \brief Constructor
+      /// \param[in] _path Directory holding the cached meshes. It is created
+      /// when the first mesh is saved.
+      public: explicit MeshCache(const std::string &_path);
+
+      /// \brief Destructor
+      public: virtual ~MeshCache();
+
+      /// \brief Get the directory holding the cached meshes.
+      /// \return Path to the cache directory.
+      public: std::string Path() const;
+
+      /// \brief Load the cached copy of a mesh file.
+      /// \param[in] _filename Full path to the source mesh file.
+      /// \param[in] _variant Name of a mesh derived from the source mesh,
+      /// or empty for the source mesh itself.
+      /// \return A new mesh, owned by the caller, or nullptr if the mesh
+      /// isn't cached or its source file changed since it was cached.
+      public: Mesh *Load(const std::string &_filename,
+                  const std::string &_variant = "") const;
+
+      /// \brief Save a mesh loaded from a file to the cache.
+      /// \param[in] _mesh The mesh loaded from _filename, or derived from
+      /// it.
+      /// \param[in] _filename Full path to the source mesh file.
+      /// \param[in] _variant Name of the mesh derived from the source mesh,
+      /// or empty for the source mesh itself. It must be usable in a file
+      /// name.
+      /// \return True if the mesh was written to the cache.
+      public: bool Save(const Mesh &_mesh, const std::string &_filename,
+                  const std::string &_variant = "") const;
+
+      /// \brief Get the path of the cache file of a mesh file.
+      /// \param[in] _filename Full path to the source mesh file.
+      /// \param[in] _variant Name of a mesh derived from the source mesh,
+      /// or empty for the source mesh itself.
+      /// \return Path to the cache file, which may not exist.
+      public: std::string CacheFilename(const std::string &_filename,
+                  const std::string &_variant = "") const;
+
+      IGN_COMMON_WARN_IGNORE__DLL_INTERFACE_MISSING
+      /// \brief Pointer to private data
+      private: std::unique_ptr<MeshCachePrivate> dataPtr;
+      IGN_COMMON_WARN_RESUME__DLL_INTERFACE_MISSING
+    };
+  }
+}
+#endif
@@ -17,6 +17,7 @@
 #ifndef IGNITION_COMMON_MESHMANAGER_HH_
 #define IGNITION_COMMON_MESHMANAGER_HH_
 
+#include <future>
 #include <map>
 #include <utility>
 #include <string>
@@ -57,11 +58,68 @@ namespace ignition
       /// Destroys the collada loader, the stl loader and all the meshes
       private: virtual ~MeshManager();
 
-      /// \brief Load a mesh from a file
+      /// \brief Load a mesh from a file. Different meshes can be loaded
+      /// from different threads at the same time. If the mesh is already
+      /// being loaded by another thread or by LoadAsync, this waits for
+      /// that load to finish.
       /// \param[in] _filename the path to the mesh
       /// \return a pointer to the created mesh
       public: const Mesh *Load(const std::string &_filename);
 
+      /// \brief Start loading a mesh from a file on a pool of background
+      /// threads, for example to load all the meshes of a world in
+      /// parallel before they are needed. The future holds nullptr if the
+      /// mesh couldn't be loaded.
+      /// \param[in] _filename the path to the mesh
+      /// \return Future holding the mesh once it's loaded.
+      /// \sa Load
+      public: std::shared_future<const Mesh *> LoadAsync(
+                  const std::string &_filename);
+
+      /// \brief Load the convex decomposition of a mesh file, made of one
+      /// convex hull per submesh. The decomposition is computed once and
+      /// kept under the name "<_filename>#<variant>", where the variant is
+      /// ConvexDecomposition::CacheVariant. It is also saved to the on-disk
+      /// mesh cache when the cache is enabled.
+      /// \param[in] _filename the path to the mesh
+      /// \param[in] _maxConvexHulls Maximum number of convex hulls.
+      /// \return The decomposition, or nullptr if the mesh couldn't be
+      /// loaded or has no volume.
+      /// \sa ConvexDecomposition
+      public: const Mesh *LoadConvexDecomposition(const std::string &_filename,
+                  const unsigned int _maxConvexHulls);
+
+      /// \brief Load a copy of a mesh file simplified to a number of
+      /// triangles, for example to collide faster with meshes exported from
+      /// CAD models. Each submesh keeps the same fraction of its triangles,
+      /// so the result can have a few more triangles than requested, and
+      /// more when further simplification would fold the surface. The
+      /// simplified mesh is computed once and kept under the name
+      /// "<_filename>#simplified_<_maxTriangles>". It is also saved to the
+      /// on-disk mesh cache when the cache is enabled.
+      /// \param[in] _filename the path to the mesh
+      /// \param[in] _maxTriangles Number of triangles to simplify to.
+      /// \return The simplified mesh, the mesh itself if it doesn't have more
+      /// than _maxTriangles triangles, or nullptr if it couldn't be loaded.
+      /// \sa MeshSimplifier
+      public: const Mesh *LoadSimplified(const std::string &_filename,
+                  const unsigned int _maxTriangles);
+
+      /// \brief Set the directory of the on-disk mesh cache. Meshes loaded
+      /// from files are saved there, and loading the same unchanged files
+      /// again, even from another process, reads them from the cache instead
+      /// of parsing them. The cache is disabled unless a directory is set
+      /// here or in the IGN_MESH_CACHE_PATH environment variable.
+      /// \param[in] _path Cache directory, or an empty string to disable
+      /// the cache.
+      /// \sa MeshCache
+      public: void SetCachePath(const std::string &_path);
+
+      /// \brief Get the directory of the on-disk mesh cache.
+      /// \return The cache directory, or an empty string if the cache is
+      /// disabled.
+      public: std::string CachePath() const;
+
       /// \brief Export a mesh to a file
       /// \param[in] _mesh Pointer to the mesh to be exported
       /// \param[in] _filename Exported file's path and name
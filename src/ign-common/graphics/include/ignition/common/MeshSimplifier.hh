@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_COMMON_MESHSIMPLIFIER_HH_
+#define IGNITION_COMMON_MESHSIMPLIFIER_HH_
+
+#include <memory>
+#include <vector>
+
+#include <ignition/common/graphics/Export.hh>
+#include <ignition/common/SuppressWarning.hh>
+
+namespace ignition
+{
+  namespace common
+  {
+    /// \brief forward declaration
+    class Mesh;
+    class MeshSimplifierPrivate;
+    class SubMesh;
+
+    /// \class MeshSimplifier MeshSimplifier.hh
+    /// ignition/common/MeshSimplifier.hh
+    /// \brief Reduces the number of triangles of meshes with quadric error
+    /// metric edge collapses.
+    ///
+    /// Vertices which share a position are welded before simplifying. Their
+    /// normals are merged when they are within the crease angle of each
+    /// other, so faceted meshes such as STL files simplify as smooth
+    /// surfaces, while sharper creases, texture seams and open borders are
+    /// preserved. Each collapse moves a vertex onto one of its neighbors, so
+    /// the remaining vertices keep their original positions, texture
+    /// coordinates and skeleton node assignments.
+    ///
+    /// Only TRIANGLES submeshes are simplified, other submeshes are copied.
+    class IGNITION_COMMON_GRAPHICS_VISIBLE MeshSimplifier
+    {
+      /// \brief Constructor
+      public: MeshSimplifier();
+
+      /// \brief Destructor
+      public: virtual ~MeshSimplifier();
+
+      /// \brief Set the largest distance that simplification may move the
+      /// surface by, approximately. Simplification stops before reaching
+      /// the requested triangle count if it would exceed it.
+      /// \param[in] _error Maximum error in meters. The default is no limit.
+      public: void SetMaxError(const double _error);
+
+      /// \brief Get the largest distance that simplification may move the
+      /// surface by.
+      /// \return Maximum error in meters.
+      public: double MaxError() const;
+
+      /// \brief Set the angle between the normals of vertices sharing a
+      /// position above which they are kept as a crease.
+      /// \param[in] _angle Crease angle in radians. The default is 45
+      /// degrees.
+      public: void SetCreaseAngle(const double _angle);
+
+      /// \brief Get the crease angle.
+      /// \return Crease angle in radians.
+      public: double CreaseAngle() const;
+
+      /// \brief Simplify a submesh.
+      /// \param[in] _subMesh The submesh to simplify.
+      /// \param[in] _ratio Fraction of the triangles to keep, between 0 and
+      /// 1.
+      /// \return The simplified submesh.
+      public: std::unique_ptr<SubMesh> Simplify(const SubMesh &_subMesh,
+                  const double _ratio) const;
+
+      /// \brief Simplify all the submeshes of a mesh. The new mesh shares
+      /// the materials and skeleton of _mesh.
+      /// \param[in] _mesh The mesh to simplify.
+      /// \param[in] _ratio Fraction of the triangles to keep, between 0 and
+      /// 1.
+      /// \return A new mesh, owned by the caller.
+      public: Mesh *Simplify(const Mesh &_mesh, const double _ratio) const;
+
+      /// \brief Generate levels of detail of a submesh in a single pass.
+      /// Each level is simplified further from the previous one.
+      /// \param[in] _subMesh The submesh to simplify.
+      /// \param[in] _ratios Fraction of the triangles of _subMesh to keep in
+      /// each level, in decreasing order.
+      /// \return One submesh per ratio. A level has more triangles than
+      /// requested when the maximum error is reached.
+      public: std::vector<std::unique_ptr<SubMesh>> LodChain(
+                  const SubMesh &_subMesh,
+                  const std::vector<double> &_ratios) const;
+
+      IGN_COMMON_WARN_IGNORE__DLL_INTERFACE_MISSING
+      /// \brief Pointer to private data
+      private: std::unique_ptr<MeshSimplifierPrivate> dataPtr;
+      IGN_COMMON_WARN_RESUME__DLL_INTERFACE_MISSING
+    };
+  }
+}
+#endif
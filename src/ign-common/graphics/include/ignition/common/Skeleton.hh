@@ -102,6 +102,10 @@ namespace ignition
       /// \param[in] _vertices the new size
       public: void SetNumVertAttached(const unsigned int _vertices);
 
+      /// \brief Returns the size of the raw node weight array
+      /// \return the number of vertices with a weight table
+      public: unsigned int NumVertAttached() const;
+
       /// \brief Add a new weight to a node (bone)
       /// \param[in] _vertex index of the vertex
       /// \param[in] _node name of the bone
@@ -150,6 +154,10 @@ namespace ignition
       public: std::string NodeNameAnimToSkin(unsigned int _index,
                   const std::string &_animNodeName);
 
+      /// \copydoc NodeNameAnimToSkin(unsigned int, const std::string &)
+      public: std::string NodeNameAnimToSkin(unsigned int _index,
+                  const std::string &_animNodeName) const;
+
       /// \brief Get the transformation to align translation from
       /// the animation skeleton to skin skeleton
       /// \param[in] _index the animation index
@@ -158,6 +166,10 @@ namespace ignition
       public: math::Matrix4d AlignTranslation(unsigned int _index,
                   const std::string &_animNodeName);
 
+      /// \copydoc AlignTranslation(unsigned int, const std::string &)
+      public: math::Matrix4d AlignTranslation(unsigned int _index,
+                  const std::string &_animNodeName) const;
+
       /// \brief Get the transformation to align rotation from
       /// the animation skeleton to skin skeleton
       /// \param[in] _index the animation index
@@ -166,6 +178,10 @@ namespace ignition
       public: math::Matrix4d AlignRotation(unsigned int _index,
                   const std::string &_animNodeName);
 
+      /// \copydoc AlignRotation(unsigned int, const std::string &)
+      public: math::Matrix4d AlignRotation(unsigned int _index,
+                  const std::string &_animNodeName) const;
+
       /// \brief Initializes the hande numbers for each node in the map
       /// using breadth first traversal
       private: void BuildNodeMap();
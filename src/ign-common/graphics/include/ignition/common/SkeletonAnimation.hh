@@ -31,6 +31,7 @@ namespace ignition
   namespace common
   {
     /// Forward declare private data class
+    class NodeAnimation;
     class SkeletonAnimationPrivate;
 
     /// \class SkeletonAnimation SkeletonAnimation.hh
@@ -63,6 +64,10 @@ namespace ignition
       /// \return true if the node exits
       public: bool HasNode(const std::string &_node) const;
 
+      /// \brief Returns the node animations
+      /// \return the node animations, indexed by node name
+      public: const std::map<std::string, NodeAnimation *> &Nodes() const;
+
       /// \brief Adds or replaces a named key frame at a specific time
       /// \param[in] _node the name of the new or existing node
       /// \param[in] _time the time
@@ -0,0 +1,166 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef IGNITION_COMMON_SKELETONANIMATIONCLIP_HH_
+#define IGNITION_COMMON_SKELETONANIMATIONCLIP_HH_
+
+#include <memory>
+#include <string>
+
+#include <ignition/math/Matrix4.hh>
+
+#include <ignition/common/graphics/Export.hh>
+#include <ignition/common/SuppressWarning.hh>
+
+namespace ignition
+{
+  namespace common
+  {
+    /// Forward declarations
+    class Skeleton;
+    class SkeletonAnimation;
+    class SkeletonAnimationClipPrivate;
+
+    /// \class SkeletonAnimationClip SkeletonAnimationClip.hh
+    /// ignition/common/SkeletonAnimationClip.hh
+    /// \brief A skeleton animation compiled for fast sampling.
+    ///
+    /// The key frames of all the nodes of a SkeletonAnimation are stored in
+    /// flat arrays, with each transform split in a translation and a
+    /// rotation when the clip is built. Nodes are referred to by index, and
+    /// PoseAt writes the transform of every node to a buffer owned by the
+    /// caller, so sampling a clip doesn't allocate. A clip is immutable once
+    /// loaded and can be shared by any number of actors, each keeping its
+    /// own key frame cursors.
+    ///
+    /// A clip can also be compiled from an animation of a Skeleton, such
+    /// as a BVH animation added with Skeleton::AddBvhAnimation. The clip is
+    /// then retargeted to the skin: its nodes are named after the skin nodes
+    /// they drive, and the transforms given by Skeleton::AlignTranslation
+    /// and Skeleton::AlignRotation are pre-multiplied into its key frames,
+    /// so sampling it doesn't involve looking nodes up by name.
+    class IGNITION_COMMON_GRAPHICS_VISIBLE SkeletonAnimationClip
+    {
+      /// \brief Constructor. The clip is empty.
+      public: SkeletonAnimationClip();
+
+      /// \brief Constructor. Compiles an animation.
+      /// \param[in] _animation Animation to compile.
+      public: explicit SkeletonAnimationClip(
+                  const SkeletonAnimation &_animation);
+
+      /// \brief Constructor. Compiles an animation of a skeleton,
+      /// retargeted to the skeleton's skin.
+      /// \param[in] _skeleton Skeleton the animation belongs to.
+      /// \param[in] _index Index of the animation in the skeleton.
+      public: SkeletonAnimationClip(const Skeleton &_skeleton,
+                  const unsigned int _index);
+
+      /// \brief Copy constructor
+      /// \param[in] _other Clip to copy.
+      public: SkeletonAnimationClip(const SkeletonAnimationClip &_other);
+
+      /// \brief Destructor
+      public: ~SkeletonAnimationClip();
+
+      /// \brief Assignment operator
+      /// \param[in] _other Clip to copy.
+      /// \return Reference to this clip.
+      public: SkeletonAnimationClip &operator=(
+                  const SkeletonAnimationClip &_other);
+
+      /// \brief Compile an animation, replacing the content of the clip.
+      /// Later changes to the animation are not reflected in the clip.
+      /// \param[in] _animation Animation to compile.
+      public: void Load(const SkeletonAnimation &_animation);
+
+      /// \brief Compile an animation of a skeleton retargeted to the
+      /// skeleton's skin, replacing the content of the clip. Sampling node
+      /// "n" of the clip gives the same transform as
+      /// _skeleton.AlignTranslation(_index, a) * t *
+      /// _skeleton.AlignRotation(_index, a), where "a" is the animation node
+      /// that drives skin node "n" and "t" is the transform of "a" in the
+      /// animation. The clip is empty if the index is out of bounds.
+      /// \param[in] _skeleton Skeleton the animation belongs to.
+      /// \param[in] _index Index of the animation in the skeleton.
+      public: void Load(const Skeleton &_skeleton, const unsigned int _index);
+
+      /// \brief Get the name of the compiled animation.
+      /// \return The animation name.
+      public: std::string Name() const;
+
+      /// \brief Get the number of animated nodes. Nodes are sorted by name,
+      /// like the dictionary returned by SkeletonAnimation::PoseAt.
+      /// \return The node count.
+      public: unsigned int NodeCount() const;
+
+      /// \brief Get the name of a node.
+      /// \param[in] _index Index of the node.
+      /// \return The node name, or an empty string if the index is out of
+      /// bounds.
+      public: std::string NodeName(const unsigned int _index) const;
+
+      /// \brief Get the index of a node.
+      /// \param[in] _name Name of the node.
+      /// \return The node index, or -1 if the node isn't animated.
+      public: int NodeIndex(const std::string &_name) const;
+
+      /// \brief Get the number of key frames of a node.
+      /// \param[in] _index Index of the node.
+      /// \return The key frame count, or 0 if the index is out of bounds.
+      public: unsigned int FrameCount(const unsigned int _index) const;
+
+      /// \brief Get the duration of the animation.
+      /// \return The duration in seconds.
+      public: double Length() const;
+
+      /// \brief Compute the transforms of all the nodes at a given time. Each
+      /// node is sampled like NodeAnimation::FrameAt.
+      /// \param[in] _time Time in seconds.
+      /// \param[out] _transforms Array of NodeCount() transforms, indexed
+      /// like the nodes.
+      /// \param[in,out] _cursors Optional array of NodeCount() key frame
+      /// indices, initialized to zero, that remember where the previous
+      /// sample of each node was. When the time moves forward by less than
+      /// a key frame between calls, finding the key frames is then constant
+      /// time. Pass null to search the key frames from scratch.
+      /// \param[in] _loop When true, the time of each node wraps around its
+      /// last key frame.
+      public: void PoseAt(const double _time, math::Matrix4d *_transforms,
+                  unsigned int *_cursors = nullptr,
+                  const bool _loop = true) const;
+
+      /// \brief Find the time when the translation of a node along the X
+      /// axis is equal to _x, like SkeletonAnimation::PoseAtX does. For
+      /// retargeted clips, the translation is the one of the animation,
+      /// before alignment to the skin.
+      /// \param[in] _x Value along X. It is clamped to the first key frame,
+      /// and wraps around the last one.
+      /// \param[in] _index Index of the node.
+      /// \param[in] _loop When false, _x is also clamped to the last key
+      /// frame.
+      /// \return The time in seconds, or 0 if the index is out of bounds.
+      public: double TimeAtX(const double _x, const unsigned int _index,
+                  const bool _loop = true) const;
+
+      IGN_COMMON_WARN_IGNORE__DLL_INTERFACE_MISSING
+      /// \brief Private data pointer.
+      private: std::unique_ptr<SkeletonAnimationClipPrivate> dataPtr;
+      IGN_COMMON_WARN_RESUME__DLL_INTERFACE_MISSING
+    };
+  }
+}
+#endif
@@ -17,6 +17,7 @@
 #ifndef IGNITION_COMMON_SUBMESH_HH_
 #define IGNITION_COMMON_SUBMESH_HH_
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
@@ -61,6 +62,23 @@ namespace ignition
                 TRISTRIPS
               };
 
+      /// \brief How vertex attributes and indices are stored. The compact
+      /// precisions keep each attribute in its own flat array, which
+      /// rendering engines can upload without conversion, and store the
+      /// indices in 16 bits as long as every index fits.
+      public: enum VertexPrecision
+              {
+                /// \brief Double precision vertices, normals and texture
+                /// coordinates, and 32 bit indices. This is the default.
+                DOUBLE_PRECISION,
+                /// \brief Single precision vertices, normals and texture
+                /// coordinates.
+                SINGLE_PRECISION,
+                /// \brief Single precision vertices and texture
+                /// coordinates, and half precision normals.
+                HALF_PRECISION
+              };
+
       /// \brief Constructor
       public: SubMesh();
 
@@ -91,6 +109,18 @@ namespace ignition
       /// \return The primitive type
       public: PrimitiveType SubMeshPrimitiveType() const;
 
+      /// \brief Set the precision in which vertex attributes are stored.
+      /// Existing vertices, normals, texture coordinates and indices are
+      /// converted, so switching to a compact precision loses the extra
+      /// precision.
+      /// \param[in] _precision The vertex precision
+      /// \sa VertexBuffer()
+      public: void SetVertexPrecision(const VertexPrecision _precision);
+
+      /// \brief Get the precision in which vertex attributes are stored.
+      /// \return The vertex precision
+      public: VertexPrecision SubMeshVertexPrecision() const;
+
       /// \brief Add an index to the mesh
       /// \param[in] _index The new vertex index
       public: void AddIndex(const unsigned int _index);
@@ -223,6 +253,46 @@ namespace ignition
       /// \return The highest index value.
       public: unsigned int MaxIndex() const;
 
+      /// \brief Get the vertex positions, as x, y and z for each vertex.
+      /// \return VertexCount() * 3 floats, or nullptr in DOUBLE_PRECISION.
+      /// The pointer is invalidated when the submesh is modified.
+      public: const float *VertexBuffer() const;
+
+      /// \brief Get the normals, as x, y and z for each normal.
+      /// \return NormalCount() * 3 floats, or nullptr unless the precision
+      /// is SINGLE_PRECISION. The pointer is invalidated when the submesh
+      /// is modified.
+      public: const float *NormalBuffer() const;
+
+      /// \brief Get the half precision normals, as x, y and z for each
+      /// normal, in the IEEE 754 binary16 format.
+      /// \return NormalCount() * 3 values, or nullptr unless the precision
+      /// is HALF_PRECISION. The pointer is invalidated when the submesh is
+      /// modified.
+      public: const uint16_t *HalfNormalBuffer() const;
+
+      /// \brief Get the texture coordinates, as u and v for each
+      /// coordinate.
+      /// \return TexCoordCount() * 2 floats, or nullptr in
+      /// DOUBLE_PRECISION. The pointer is invalidated when the submesh is
+      /// modified.
+      public: const float *TexCoordBuffer() const;
+
+      /// \brief Get the 32 bit indices.
+      /// \return IndexCount() indices, or nullptr if the indices are
+      /// stored in 16 bits. The pointer is invalidated when the submesh is
+      /// modified.
+      /// \sa ShortIndexBuffer()
+      public: const unsigned int *IndexBuffer() const;
+
+      /// \brief Get the 16 bit indices. Outside of DOUBLE_PRECISION, the
+      /// indices are stored in 16 bits until an index above 65535 is added.
+      /// \return IndexCount() indices, or nullptr if the indices are
+      /// stored in 32 bits. The pointer is invalidated when the submesh is
+      /// modified.
+      /// \sa IndexBuffer()
+      public: const uint16_t *ShortIndexBuffer() const;
+
       /// \brief Set the material index. Relates to the parent mesh material
       /// list.
       /// \param[in] _index Index to set the material to.
@@ -15,6 +15,8 @@
  *
 */
 #include <algorithm>
+#include <cmath>
+#include <vector>
 
 #include <ignition/math/Spline.hh>
 #include <ignition/math/Vector2.hh>
@@ -62,9 +64,12 @@ class ignition::common::TrajectoryInfoPrivate
   /// from start time.
   public: common::PoseAnimation *waypoints{nullptr};
 
-  /// \brief Distance on the XY plane covered by each segment. The key is the
-  /// duration from start time, the value is the distance in meters.
-  public: std::map<std::chrono::steady_clock::duration, double> segDistance;
+  /// \brief Duration from start time of each waypoint, sorted.
+  public: std::vector<std::chrono::steady_clock::duration> waypointTimes;
+
+  /// \brief Distance on the XY plane covered from the first waypoint up to
+  /// each waypoint, in meters.
+  public: std::vector<double> waypointDistances;
 };
 
 /////////////////////////////////////////////////
@@ -159,9 +164,15 @@ double Animation::KeyFramesAtTime(double _time, common::KeyFrame **_kf1,
   // t2 = time of next keyframe
   double t1, t2;
 
+  // Wrap to (0, length], like repeatedly subtracting the length
+  if (_time > this->length && this->length > 0.0)
+  {
+    _time = std::fmod(_time, this->length);
+    if (_time <= 0.0)
+      _time = this->length;
+  }
+
   // Find first key frame after or on current time
-  while (_time > this->length && this->length > 0.0)
-    _time -= this->length;
 
   KeyFrame_V::const_iterator iter;
   common::KeyFrame timeKey(_time);
@@ -369,7 +380,8 @@ void TrajectoryInfo::CopyFrom(const TrajectoryInfo &_trajInfo)
   this->dataPtr->endTime = _trajInfo.dataPtr->endTime;
   this->dataPtr->translated = _trajInfo.dataPtr->translated;
   this->dataPtr->waypoints = _trajInfo.dataPtr->waypoints;
-  this->dataPtr->segDistance = _trajInfo.dataPtr->segDistance;
+  this->dataPtr->waypointTimes = _trajInfo.dataPtr->waypointTimes;
+  this->dataPtr->waypointDistances = _trajInfo.dataPtr->waypointDistances;
 }
 
 //////////////////////////////////////////////////
@@ -420,28 +432,23 @@ std::chrono::steady_clock::duration TrajectoryInfo::Duration() const
 double TrajectoryInfo::DistanceSoFar(
     const std::chrono::steady_clock::duration &_time) const
 {
-  double distance = 0.0;
-
-  // Sum all completed segments
-  auto segment = this->dataPtr->segDistance.begin();
-  auto prevSegment = segment;
-  for (; segment != this->dataPtr->segDistance.end() && segment->first <= _time;
-      prevSegment = segment, ++segment)
-  {
-    distance += segment->second;
-  }
+  const auto &times = this->dataPtr->waypointTimes;
+  const auto &distances = this->dataPtr->waypointDistances;
 
-  if (segment == this->dataPtr->segDistance.end())
-    return distance;
+  // First waypoint after the time
+  auto next = std::upper_bound(times.begin(), times.end(), _time);
+  if (next == times.begin())
+    return 0.0;
+  if (next == times.end())
+    return distances.back();
 
-  // Add difference
-  if (_time - prevSegment->first > std::chrono::steady_clock::duration())
-  {
-    distance += static_cast<double>((_time - prevSegment->first).count()) /
-        static_cast<double>((segment->first - prevSegment->first).count()) *
-        segment->second;
-  }
-  return distance;
+  // Interpolate within the current segment
+  auto index = next - times.begin();
+  auto prevTime = times[index - 1];
+  return distances[index - 1] +
+      static_cast<double>((_time - prevTime).count()) /
+      static_cast<double>((times[index] - prevTime).count()) *
+      (distances[index] - distances[index - 1]);
 }
 
 /////////////////////////////////////////////////
@@ -492,7 +499,8 @@ common::PoseAnimation *TrajectoryInfo::Waypoints() const
 void TrajectoryInfo::SetWaypoints(
     std::map<std::chrono::steady_clock::time_point, math::Pose3d> _waypoints)
 {
-  this->dataPtr->segDistance.clear();
+  this->dataPtr->waypointTimes.clear();
+  this->dataPtr->waypointDistances.clear();
 
   auto first = _waypoints.begin();
   auto last = _waypoints.rbegin();
@@ -513,8 +521,10 @@ void TrajectoryInfo::SetWaypoints(
 
     math::Vector2d p1(prevPose.X(), prevPose.Y());
     math::Vector2d p2(pIter->second.Pos().X(), pIter->second.Pos().Y());
-    this->dataPtr->segDistance[pIter->first - this->StartTime()] =
-        p1.Distance(p2);
+    double distance = this->dataPtr->waypointDistances.empty() ? 0.0 :
+        this->dataPtr->waypointDistances.back();
+    this->dataPtr->waypointTimes.push_back(pIter->first - this->StartTime());
+    this->dataPtr->waypointDistances.push_back(distance + p1.Distance(p2));
 
     key->Translation(pIter->second.Pos());
     key->Rotation(pIter->second.Rot());
@@ -17,6 +17,8 @@
 
 #include <gtest/gtest.h>
 
+#include <cmath>
+
 #include <ignition/math/Vector3.hh>
 #include <ignition/math/Quaternion.hh>
 #include <ignition/common/KeyFrame.hh>
@@ -77,6 +79,17 @@ TEST_F(AnimationTest, PoseAnimation)
       math::Vector3d(3.76, 7.52, 11.28));
   EXPECT_TRUE(interpolatedKey.Rotation() ==
       math::Quaterniond(0.0302776, 0.0785971, 0.109824));
+
+  // Passing the time doesn't change the animation's time, and wraps around
+  // the length
+  common::PoseKeyFrame timeKey(-1.0);
+  anim.InterpolatedKeyFrame(24.0, timeKey);
+  EXPECT_DOUBLE_EQ(4.0, anim.Time());
+  EXPECT_EQ(interpolatedKey.Translation(), timeKey.Translation());
+  EXPECT_EQ(interpolatedKey.Rotation(), timeKey.Rotation());
+
+  anim.InterpolatedKeyFrame(20.0, timeKey);
+  EXPECT_EQ(math::Vector3d(10, 20, 30), timeKey.Translation());
 }
 
 /////////////////////////////////////////////////
@@ -159,6 +172,22 @@ TEST_F(AnimationTest, TrajectoryInfo)
   EXPECT_DOUBLE_EQ(4.0, trajInfo.DistanceSoFar(200ms));
   EXPECT_DOUBLE_EQ(4.0, trajInfo.DistanceSoFar(500ms));
 
+  // Many segments
+  waypoints.clear();
+  for (int i = 0; i <= 100; ++i)
+  {
+    waypoints[TP(i * 10ms)] =
+        math::Pose3d(i % 2 ? 0 : 0.5, i * 1.0, 0, 0, 0, 0);
+  }
+  trajInfo.SetWaypoints(waypoints);
+  double segment = std::sqrt(1.25);
+  EXPECT_DOUBLE_EQ(0.0, trajInfo.DistanceSoFar(0ms));
+  EXPECT_NEAR(segment * 0.5, trajInfo.DistanceSoFar(5ms), 1e-9);
+  EXPECT_NEAR(segment * 42, trajInfo.DistanceSoFar(420ms), 1e-9);
+  EXPECT_NEAR(segment * 42.3, trajInfo.DistanceSoFar(423ms), 1e-9);
+  EXPECT_NEAR(segment * 100, trajInfo.DistanceSoFar(1000ms), 1e-9);
+  EXPECT_NEAR(segment * 100, trajInfo.DistanceSoFar(1500ms), 1e-9);
+
   waypoints.clear();
   // duration from start == 0
   waypoints[TP(200ms)] = math::Pose3d(1, 0, 0, 0, 0, 0);
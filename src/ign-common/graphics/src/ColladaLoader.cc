@@ -14,9 +14,12 @@
  * limitations under the License.
  *
  */
+#include <cctype>
+#include <cstdlib>
 #include <sstream>
 #include <unordered_map>
 #include <map>
+#include <string>
 #include <vector>
 #include <set>
 
@@ -159,6 +162,17 @@ namespace ignition
       public: tinyxml2::XMLElement *ElementId(const std::string &_name,
                                                const std::string &_id);
 
+      /// \brief Index the elements of a subtree by their id and sid
+      /// attributes, in document order.
+      /// \param[in] _elem Root of the subtree.
+      public: void IndexElementIds(tinyxml2::XMLElement *_elem);
+
+      /// \brief Elements that have an id or sid attribute, indexed by the
+      /// attribute's value in document order. Built when a file is loaded,
+      /// so that resolving a reference doesn't search the document.
+      public: std::unordered_map<std::string,
+              std::vector<tinyxml2::XMLElement *>> elementIds;
+
       /// \brief Load a node
       /// \param[in] _elem Pointer to the node XML instance
       /// \param[in,out] _mesh Pointer to the current mesh
@@ -340,6 +354,88 @@ struct Vector2dHash
   }
 };
 
+/////////////////////////////////////////////////
+/// \brief Parse a whitespace separated list of numbers, such as the content
+/// of a <float_array>, without splitting it into strings first. Tokens that
+/// don't start with a number are read as NaN, like math::parseFloat does.
+/// \param[in] _str Text to parse. It can be null.
+/// \param[out] _values The parsed numbers are appended here.
+static void parseFloats(const char *_str, std::vector<double> &_values)
+{
+  if (nullptr == _str)
+    return;
+
+  const char *p = _str;
+  while (true)
+  {
+    while (*p && std::isspace(static_cast<unsigned char>(*p)))
+      ++p;
+    if (!*p)
+      break;
+
+    char *end;
+    double value = std::strtod(p, &end);
+    if (end == p)
+      value = math::NAN_D;
+
+    // Skip the rest of the token
+    p = end;
+    while (*p && !std::isspace(static_cast<unsigned char>(*p)))
+      ++p;
+
+    _values.push_back(value);
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Parse a whitespace separated list of integers, such as the
+/// content of a <p> element, without splitting it into strings first.
+/// Tokens that don't start with a number are read as 0, like math::parseInt
+/// does.
+/// \param[in] _str Text to parse. It can be null.
+/// \param[out] _values The parsed numbers are appended here.
+static void parseInts(const char *_str, std::vector<int> &_values)
+{
+  if (nullptr == _str)
+    return;
+
+  const char *p = _str;
+  while (true)
+  {
+    while (*p && std::isspace(static_cast<unsigned char>(*p)))
+      ++p;
+    if (!*p)
+      break;
+
+    char *end;
+    long value = std::strtol(p, &end, 10);
+    if (end == p)
+      value = 0;
+
+    // Skip the rest of the token
+    p = end;
+    while (*p && !std::isspace(static_cast<unsigned char>(*p)))
+      ++p;
+
+    _values.push_back(static_cast<int>(value));
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Parse a 4x4 matrix in row major order. Missing values are 0.
+/// \param[in] _str Text to parse. It can be null.
+/// \return The matrix.
+static ignition::math::Matrix4d parseMatrix(const char *_str)
+{
+  std::vector<double> values;
+  parseFloats(_str, values);
+  values.resize(16, 0.0);
+  return ignition::math::Matrix4d(values[0], values[1], values[2], values[3],
+      values[4], values[5], values[6], values[7],
+      values[8], values[9], values[10], values[11],
+      values[12], values[13], values[14], values[15]);
+}
+
 //////////////////////////////////////////////////
 ColladaLoader::ColladaLoader()
 : MeshLoader(), dataPtr(new ColladaLoaderPrivate)
@@ -364,6 +460,7 @@ Mesh *ColladaLoader::Load(const std::string &_filename)
   this->dataPtr->positionDuplicateMap.clear();
   this->dataPtr->normalDuplicateMap.clear();
   this->dataPtr->texcoordDuplicateMap.clear();
+  this->dataPtr->elementIds.clear();
 
   // reset scale
   this->dataPtr->meter = 1.0;
@@ -384,6 +481,10 @@ Mesh *ColladaLoader::Load(const std::string &_filename)
   if (!this->dataPtr->colladaXml)
     ignerr << "Missing COLLADA tag\n";
 
+  this->dataPtr->elementIds.clear();
+  if (this->dataPtr->colladaXml)
+    this->dataPtr->IndexElementIds(this->dataPtr->colladaXml);
+
   if (std::string(this->dataPtr->colladaXml->Attribute("version")) != "1.4.0" &&
       std::string(this->dataPtr->colladaXml->Attribute("version")) != "1.4.1")
     ignerr << "Invalid collada file. Must be version 1.4.0 or 1.4.1\n";
@@ -563,15 +664,7 @@ ignition::math::Matrix4d ColladaLoaderPrivate::LoadNodeTransform(
 
   if (_elem->FirstChildElement("matrix"))
   {
-    std::string matrixStr = _elem->FirstChildElement("matrix")->GetText();
-    std::istringstream iss(matrixStr);
-    std::vector<double> values(16);
-    for (unsigned int i = 0; i < 16; ++i)
-      iss >> values[i];
-    transform.Set(values[0], values[1], values[2], values[3],
-        values[4], values[5], values[6], values[7],
-        values[8], values[9], values[10], values[11],
-        values[12], values[13], values[14], values[15]);
+    transform = parseMatrix(_elem->FirstChildElement("matrix")->GetText());
   }
   else
   {
@@ -630,17 +723,8 @@ void ColladaLoaderPrivate::LoadController(tinyxml2::XMLElement *_contrXml,
   tinyxml2::XMLElement *skinXml = _contrXml->FirstChildElement("skin");
   std::string geomURL = skinXml->Attribute("source");
 
-  ignition::math::Matrix4d bindTrans;
-  std::string matrixStr =
-        skinXml->FirstChildElement("bind_shape_matrix")->GetText();
-  std::istringstream iss(matrixStr);
-  std::vector<double> values(16);
-  for (unsigned int i = 0; i < 16; ++i)
-    iss >> values[i];
-  bindTrans.Set(values[0], values[1], values[2], values[3],
-                values[4], values[5], values[6], values[7],
-                values[8], values[9], values[10], values[11],
-                values[12], values[13], values[14], values[15]);
+  ignition::math::Matrix4d bindTrans = parseMatrix(
+      skinXml->FirstChildElement("bind_shape_matrix")->GetText());
 
   tinyxml2::XMLElement *jointsXml = skinXml->FirstChildElement("joints");
   std::string jointsURL, invBindMatURL;
@@ -704,30 +788,17 @@ void ColladaLoaderPrivate::LoadController(tinyxml2::XMLElement *_contrXml,
         << "Faild to parse skinning information in Collada file." << std::endl;
   }
 
-  std::string posesStr = invBMXml->FirstChildElement("float_array")->GetText();
-
-  std::vector<std::string> strs = split(posesStr, " \t\r\n");
+  std::vector<double> poses;
+  parseFloats(invBMXml->FirstChildElement("float_array")->GetText(), poses);
+  poses.resize(joints.size() * 16, 0.0);
 
   for (unsigned int i = 0; i < joints.size(); ++i)
   {
-    unsigned int id = i * 16;
-    ignition::math::Matrix4d mat;
-    mat.Set(ignition::math::parseFloat(strs[id +  0]),
-            ignition::math::parseFloat(strs[id +  1]),
-            ignition::math::parseFloat(strs[id +  2]),
-            ignition::math::parseFloat(strs[id +  3]),
-            ignition::math::parseFloat(strs[id +  4]),
-            ignition::math::parseFloat(strs[id +  5]),
-            ignition::math::parseFloat(strs[id +  6]),
-            ignition::math::parseFloat(strs[id +  7]),
-            ignition::math::parseFloat(strs[id +  8]),
-            ignition::math::parseFloat(strs[id +  9]),
-            ignition::math::parseFloat(strs[id + 10]),
-            ignition::math::parseFloat(strs[id + 11]),
-            ignition::math::parseFloat(strs[id + 12]),
-            ignition::math::parseFloat(strs[id + 13]),
-            ignition::math::parseFloat(strs[id + 14]),
-            ignition::math::parseFloat(strs[id + 15]));
+    const double *m = poses.data() + i * 16;
+    ignition::math::Matrix4d mat(m[0], m[1], m[2], m[3],
+                                 m[4], m[5], m[6], m[7],
+                                 m[8], m[9], m[10], m[11],
+                                 m[12], m[13], m[14], m[15]);
 
     skeleton->NodeByName(joints[i])->SetInverseBindTransform(mat);
     skeleton->NodeByName(joints[i])->SetModelTransform(mat.Inverse(), false);
@@ -763,36 +834,25 @@ void ColladaLoaderPrivate::LoadController(tinyxml2::XMLElement *_contrXml,
 
   tinyxml2::XMLElement *weightsXml = this->ElementId("source", weightsURL);
 
-  std::string wString = weightsXml->FirstChildElement("float_array")->GetText();
-  std::vector<std::string> wStrs = split(wString, " \t\r\n");
-
-  std::vector<float> weights;
-  for (unsigned int i = 0; i < wStrs.size(); ++i)
-    weights.push_back(math::parseFloat(wStrs[i]));
-
-  std::string cString = vertWeightsXml->FirstChildElement("vcount")->GetText();
-  std::string vString = vertWeightsXml->FirstChildElement("v")->GetText();
-  std::vector<std::string> vCountStrs = split(cString, " \t\r\n");
-  std::vector<std::string> vStrs = split(vString, " \t\r\n");
+  std::vector<double> weights;
+  parseFloats(weightsXml->FirstChildElement("float_array")->GetText(),
+      weights);
 
-  std::vector<unsigned int> vCount;
-  std::vector<unsigned int> v;
-
-  for (unsigned int i = 0; i < vCountStrs.size(); ++i)
-    vCount.push_back(math::parseInt(vCountStrs[i]));
-
-  for (unsigned int i = 0; i < vStrs.size(); ++i)
-    v.push_back(math::parseInt(vStrs[i]));
+  std::vector<int> vCount;
+  std::vector<int> v;
+  parseInts(vertWeightsXml->FirstChildElement("vcount")->GetText(), vCount);
+  parseInts(vertWeightsXml->FirstChildElement("v")->GetText(), v);
 
   skeleton->SetNumVertAttached(vCount.size());
 
   unsigned int vIndex = 0;
   for (unsigned int i = 0; i < vCount.size(); ++i)
   {
-    for (unsigned int j = 0; j < vCount[i]; ++j)
+    for (unsigned int j = 0; j < static_cast<unsigned int>(vCount[i]); ++j)
     {
+      // Weights are single precision
       skeleton->AddVertNodeWeight(i, joints[v[vIndex + jOffset]],
-                                    weights[v[vIndex + wOffset]]);
+          static_cast<float>(weights[v[vIndex + wOffset]]));
       vIndex += (jOffset + wOffset + 1);
     }
   }
@@ -906,21 +966,13 @@ void ColladaLoaderPrivate::LoadAnimationSet(tinyxml2::XMLElement *_xml,
       }
       tinyxml2::XMLElement *timeArray =
           frameTimesXml->FirstChildElement("float_array");
-      std::string timeStr = timeArray->GetText();
-      std::vector<std::string> timeStrs = split(timeStr, " \t\r\n");
-
       std::vector<double> times;
-      for (unsigned int i = 0; i < timeStrs.size(); ++i)
-        times.push_back(math::parseFloat(timeStrs[i]));
+      parseFloats(timeArray->GetText(), times);
 
       tinyxml2::XMLElement *output =
           frameTransXml->FirstChildElement("float_array");
-      std::string outputStr = output->GetText();
-      std::vector<std::string> outputStrs = split(outputStr, " \t\r\n");
-
       std::vector<double> values;
-      for (unsigned int i = 0; i < outputStrs.size(); ++i)
-        values.push_back(math::parseFloat(outputStrs[i]));
+      parseFloats(output->GetText(), values);
 
       tinyxml2::XMLElement *accessor =
         frameTransXml->FirstChildElement("technique_common");
@@ -1038,15 +1090,7 @@ void ColladaLoaderPrivate::SetSkeletonNodeTransform(tinyxml2::XMLElement *_elem,
 
   if (_elem->FirstChildElement("matrix"))
   {
-    std::string matrixStr = _elem->FirstChildElement("matrix")->GetText();
-    std::istringstream iss(matrixStr);
-    std::vector<double> values(16);
-    for (unsigned int i = 0; i < 16; ++i)
-      iss >> values[i];
-    transform.Set(values[0], values[1], values[2], values[3],
-        values[4], values[5], values[6], values[7],
-        values[8], values[9], values[10], values[11],
-        values[12], values[13], values[14], values[15]);
+    transform = parseMatrix(_elem->FirstChildElement("matrix")->GetText());
 
     NodeTransform nt(transform);
     nt.SetSourceValues(transform);
@@ -1174,6 +1218,26 @@ tinyxml2::XMLElement *ColladaLoaderPrivate::ElementId(
   if (id.length() > 0 && id[0] == '#')
     id.erase(0, 1);
 
+  // References are resolved with the index: the first element with the id
+  // in document order that is within _parent is the one a depth first
+  // search of _parent would find.
+  if (!id.empty())
+  {
+    auto it = this->elementIds.find(id);
+    if (it == this->elementIds.end())
+      return nullptr;
+
+    for (tinyxml2::XMLElement *elem : it->second)
+    {
+      for (tinyxml2::XMLNode *node = elem; node; node = node->Parent())
+      {
+        if (node == _parent)
+          return elem;
+      }
+    }
+    return nullptr;
+  }
+
   if ((id.empty() && _parent->Value() == _name) ||
       (_parent->Attribute("id") && _parent->Attribute("id") == id) ||
       (_parent->Attribute("sid") && _parent->Attribute("sid") == id))
@@ -1196,6 +1260,24 @@ tinyxml2::XMLElement *ColladaLoaderPrivate::ElementId(
   return NULL;
 }
 
+/////////////////////////////////////////////////
+void ColladaLoaderPrivate::IndexElementIds(tinyxml2::XMLElement *_elem)
+{
+  const char *id = _elem->Attribute("id");
+  if (id)
+    this->elementIds[id].push_back(_elem);
+
+  const char *sid = _elem->Attribute("sid");
+  if (sid && !(id && std::string(id) == sid))
+    this->elementIds[sid].push_back(_elem);
+
+  for (tinyxml2::XMLElement *child = _elem->FirstChildElement(); child;
+       child = child->NextSiblingElement())
+  {
+    this->IndexElementIds(child);
+  }
+}
+
 /////////////////////////////////////////////////
 void ColladaLoaderPrivate::LoadVertices(const std::string &_id,
     const ignition::math::Matrix4d &_transform,
@@ -1292,19 +1374,15 @@ void ColladaLoaderPrivate::LoadPositions(const std::string &_id,
 
     return;
   }
-  std::string valueStr = floatArrayXml->GetText();
+  std::vector<double> values;
+  parseFloats(floatArrayXml->GetText(), values);
 
   std::unordered_map<ignition::math::Vector3d,
       unsigned int, Vector3Hash> unique;
 
-  std::vector<std::string>::iterator iter, end;
-  std::vector<std::string> strs = split(valueStr, " \t\r\n");
-  end = strs.end();
-  for (iter = strs.begin(); iter != end; iter += 3)
+  for (std::size_t i = 0; i + 2 < values.size(); i += 3)
   {
-    ignition::math::Vector3d vec(math::parseFloat(*iter),
-        ignition::math::parseFloat(*(iter+1)),
-        ignition::math::parseFloat(*(iter+2)));
+    ignition::math::Vector3d vec(values[i], values[i+1], values[i+2]);
 
     vec = _transform * vec;
     _values.push_back(vec);
@@ -1377,25 +1455,21 @@ void ColladaLoaderPrivate::LoadNormals(const std::string &_id,
   std::unordered_map<ignition::math::Vector3d,
       unsigned int, Vector3Hash> unique;
 
-  std::string valueStr = floatArrayXml->GetText();
-  std::istringstream iss(valueStr);
-  do
+  std::vector<double> values;
+  parseFloats(floatArrayXml->GetText(), values);
+  for (std::size_t i = 0; i + 2 < values.size(); i += 3)
   {
-    ignition::math::Vector3d vec;
-    iss >> vec.X() >> vec.Y() >> vec.Z();
-    if (iss)
-    {
-      vec = rotMat * vec;
-      vec.Normalize();
-      _values.push_back(vec);
+    ignition::math::Vector3d vec(values[i], values[i+1], values[i+2]);
+    vec = rotMat * vec;
+    vec.Normalize();
+    _values.push_back(vec);
 
-      // create a map of duplicate indices
-      if (unique.find(vec) != unique.end())
-        _duplicates[_values.size()-1] = unique[vec];
-      else
-        unique[vec] = _values.size()-1;
-    }
-  } while (iss);
+    // create a map of duplicate indices
+    if (unique.find(vec) != unique.end())
+      _duplicates[_values.size()-1] = unique[vec];
+    else
+      unique[vec] = _values.size()-1;
+  }
 
   this->normalDuplicateMap[_id] = _duplicates;
   this->normalIds[_id] = _values;
@@ -1527,16 +1601,16 @@ void ColladaLoaderPrivate::LoadTexCoords(const std::string &_id,
   std::unordered_map<ignition::math::Vector2d,
       unsigned int, Vector2dHash> unique;
 
-  // Read the raw texture values, and split them on spaces.
-  std::string valueStr = floatArrayXml->GetText();
-  std::vector<std::string> values = split(valueStr, " \t\r\n");
+  // Read the raw texture values
+  std::vector<double> values;
+  parseFloats(floatArrayXml->GetText(), values);
 
   // Read in all the texture coordinates.
-  for (int i = 0; i < totCount; i += stride)
+  for (int i = 0; i < totCount && i + 1 < static_cast<int>(values.size());
+       i += stride)
   {
     // We only handle 2D texture coordinates right now.
-    ignition::math::Vector2d vec(std::stod(values[i]),
-          1.0 - std::stod(values[i+1]));
+    ignition::math::Vector2d vec(values[i], 1.0 - values[i+1]);
     _values.push_back(vec);
 
     // create a map of duplicate indices
@@ -2194,12 +2268,13 @@ void ColladaLoaderPrivate::LoadTriangles(tinyxml2::XMLElement *_trianglesXml,
   std::map<unsigned int, std::vector<GeometryIndices> > vertexIndexMap;
 
   unsigned int *values = new unsigned int[offsetSize];
-  std::vector<std::string> strs = split(pStr, " \t\r\n");
+  std::vector<int> indices;
+  parseInts(pStr.c_str(), indices);
 
-  for (unsigned int j = 0; j < strs.size(); j += offsetSize)
+  for (unsigned int j = 0; j + offsetSize <= indices.size(); j += offsetSize)
   {
     for (unsigned int i = 0; i < offsetSize; ++i)
-      values[i] = ignition::math::parseInt(strs[j+i]);
+      values[i] = indices[j+i];
 
     unsigned int daeVertIndex = 0;
     bool addIndex = !hasVertices;
@@ -0,0 +1,1206 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "ignition/common/ConvexDecomposition.hh"
+#include "ignition/common/Mesh.hh"
+#include "ignition/common/SubMesh.hh"
+
+using namespace ignition;
+using namespace common;
+
+/// \brief Number of split planes tried along each axis of a part
+static const int kCandidatesPerAxis = 8;
+
+
+/// \brief Private data for ConvexDecomposition
+class ignition::common::ConvexDecompositionPrivate
+{
+  /// \brief Maximum number of hulls
+  public: unsigned int maxConvexHulls = 16;
+
+  /// \brief Number of voxels along the longest side of the mesh
+  public: unsigned int voxelResolution = 32;
+
+  /// \brief Concavity below which parts aren't split
+  public: double maxConcavity = 0.01;
+
+  /// \brief Maximum number of vertices of a hull
+  public: unsigned int maxHullVertices = 64;
+};
+
+namespace
+{
+  /// \brief Convex hull of a set of points, built with quickhull.
+  class Hull
+  {
+    /// \brief A triangle of the hull, facing outwards
+    public: struct Face
+    {
+      /// \brief Indices of the corners in the point set
+      std::array<unsigned int, 3> v;
+
+      /// \brief Unit normal
+      math::Vector3d normal;
+
+      /// \brief Distance of the plane of the face from the origin
+      double offset;
+
+      /// \brief False once the face is removed
+      bool alive;
+
+      /// \brief Points in front of the face which aren't assigned to
+      /// another face
+      std::vector<unsigned int> outside;
+
+      /// \brief Point of outside furthest from the face
+      unsigned int furthest;
+
+      /// \brief Distance of the furthest point from the face
+      double furthestDistance;
+    };
+
+    /// \brief Build the hull.
+    /// \param[in] _points The points.
+    /// \param[in] _maxVertices Maximum number of vertices, 0 for no limit.
+    /// When there are more extreme points, the hull is built from the
+    /// furthest ones and the others may be left out.
+    /// \return False if the points are all on a plane.
+    public: bool Build(const std::vector<math::Vector3d> &_points,
+                const unsigned int _maxVertices);
+
+    /// \brief Check if a point is inside the hull.
+    /// \param[in] _p The point.
+    /// \return True if inside or on the hull.
+    public: bool Contains(const math::Vector3d &_p) const;
+
+    /// \brief Make a submesh of the hull.
+    /// \return The submesh.
+    public: std::unique_ptr<SubMesh> ToSubMesh() const;
+
+    /// \brief Add a face.
+    /// \param[in] _a First corner.
+    /// \param[in] _b Second corner.
+    /// \param[in] _c Third corner.
+    private: void AddFace(const unsigned int _a, const unsigned int _b,
+                 const unsigned int _c);
+
+    /// \brief Build the hull of a subset of the points.
+    /// \param[in] _indices Indices of the points.
+    /// \param[in] _maxVertices Maximum number of vertices, 0 for no limit.
+    /// \return False if the points are all on a plane.
+    private: bool BuildFrom(const std::vector<unsigned int> &_indices,
+                 const unsigned int _maxVertices);
+
+    /// \brief Find the vertices of the hull which lie on one of its edges
+    /// or faces. They are left when a point on a face is added before the
+    /// extreme points around it.
+    /// \param[out] _kept The other vertices.
+    /// \return True if there are such vertices.
+    private: bool RedundantVertices(std::vector<unsigned int> &_kept) const;
+
+    /// \brief Assign points to the face they are furthest in front of.
+    /// Points behind all faces are dropped.
+    /// \param[in] _points Indices of the points.
+    /// \param[in] _firstFace Index of the first face to consider.
+    private: void Assign(const std::vector<unsigned int> &_points,
+                 const size_t _firstFace);
+
+    /// \brief Key of a directed edge.
+    /// \param[in] _a Start of the edge.
+    /// \param[in] _b End of the edge.
+    /// \return The key.
+    private: static uint64_t EdgeKey(const unsigned int _a,
+                 const unsigned int _b)
+    {
+      return (static_cast<uint64_t>(_a) << 32) | _b;
+    }
+
+    /// \brief The points
+    private: const std::vector<math::Vector3d> *points = nullptr;
+
+    /// \brief Distance below which a point is considered on a face
+    private: double eps = 0;
+
+    /// \brief Faces, including removed ones
+    private: std::vector<Face> faces;
+
+    /// \brief Face of each directed edge of the hull
+    private: std::unordered_map<uint64_t, unsigned int> edges;
+  };
+
+  //////////////////////////////////////////////////
+  void Hull::AddFace(const unsigned int _a, const unsigned int _b,
+      const unsigned int _c)
+  {
+    const auto &p = *this->points;
+    Face face;
+    face.v = {{_a, _b, _c}};
+    face.normal = (p[_b] - p[_a]).Cross(p[_c] - p[_a]);
+    const double length = face.normal.Length();
+    if (length > 0)
+      face.normal /= length;
+    face.offset = face.normal.Dot(p[_a]);
+    face.alive = true;
+    face.furthest = 0;
+    face.furthestDistance = 0;
+
+    const unsigned int index = static_cast<unsigned int>(this->faces.size());
+    this->faces.push_back(std::move(face));
+    this->edges[EdgeKey(_a, _b)] = index;
+    this->edges[EdgeKey(_b, _c)] = index;
+    this->edges[EdgeKey(_c, _a)] = index;
+  }
+
+  //////////////////////////////////////////////////
+  void Hull::Assign(const std::vector<unsigned int> &_points,
+      const size_t _firstFace)
+  {
+    const auto &p = *this->points;
+    for (unsigned int i : _points)
+    {
+      Face *best = nullptr;
+      double bestDistance = this->eps;
+      for (size_t f = _firstFace; f < this->faces.size(); ++f)
+      {
+        Face &face = this->faces[f];
+        if (!face.alive)
+          continue;
+        const double d = face.normal.Dot(p[i]) - face.offset;
+        if (d > bestDistance)
+        {
+          bestDistance = d;
+          best = &face;
+        }
+      }
+
+      if (!best)
+        continue;
+
+      best->outside.push_back(i);
+      if (bestDistance > best->furthestDistance)
+      {
+        best->furthestDistance = bestDistance;
+        best->furthest = i;
+      }
+    }
+  }
+
+  //////////////////////////////////////////////////
+  bool Hull::Build(const std::vector<math::Vector3d> &_points,
+      const unsigned int _maxVertices)
+  {
+    this->points = &_points;
+    if (_points.empty())
+      return false;
+
+    math::Vector3d min = _points[0];
+    math::Vector3d max = _points[0];
+    for (const auto &p : _points)
+    {
+      min.Min(p);
+      max.Max(p);
+    }
+    this->eps = 1e-9 * std::max(1.0, (max - min).Length());
+
+    std::vector<unsigned int> indices(_points.size());
+    for (unsigned int i = 0; i < indices.size(); ++i)
+      indices[i] = i;
+    if (!this->BuildFrom(indices, _maxVertices))
+      return false;
+
+    // Rebuilding from the extreme points only gives a hull without them
+    for (int pass = 0; pass < 3 && this->RedundantVertices(indices); ++pass)
+    {
+      if (!this->BuildFrom(indices, 0))
+        return false;
+    }
+    return true;
+  }
+
+  //////////////////////////////////////////////////
+  bool Hull::RedundantVertices(std::vector<unsigned int> &_kept) const
+  {
+    // A vertex is extreme only if the normals of its faces don't all lie in
+    // a plane: on a face they're all the same, on an edge they're in two
+    // planes sharing the direction of the edge
+    std::unordered_map<unsigned int, std::vector<math::Vector3d>> normals;
+    for (const auto &face : this->faces)
+    {
+      if (!face.alive)
+        continue;
+      for (unsigned int v : face.v)
+        normals[v].push_back(face.normal);
+    }
+
+    const double tolerance = 1e-6;
+    bool redundant = false;
+    _kept.clear();
+    for (const auto &vertex : normals)
+    {
+      const auto &n = vertex.second;
+      math::Vector3d axis;
+      for (const auto &other : n)
+      {
+        const math::Vector3d cross = n[0].Cross(other);
+        if (cross.SquaredLength() > axis.SquaredLength())
+          axis = cross;
+      }
+
+      bool extreme = false;
+      if (axis.Length() > tolerance)
+      {
+        axis.Normalize();
+        for (const auto &other : n)
+          extreme = extreme || std::abs(axis.Dot(other)) > tolerance;
+      }
+
+      if (extreme)
+        _kept.push_back(vertex.first);
+      else
+        redundant = true;
+    }
+    return redundant && _kept.size() >= 4u;
+  }
+
+  //////////////////////////////////////////////////
+  bool Hull::BuildFrom(const std::vector<unsigned int> &_indices,
+      const unsigned int _maxVertices)
+  {
+    const auto &_points = *this->points;
+    this->faces.clear();
+    this->edges.clear();
+
+    if (_indices.size() < 4u)
+      return false;
+
+    // Initial tetrahedron from extreme points
+    unsigned int i0 = _indices[0];
+    for (unsigned int i : _indices)
+    {
+      if (_points[i].X() < _points[i0].X())
+        i0 = i;
+    }
+
+    unsigned int i1 = i0;
+    double best = 0;
+    for (unsigned int i : _indices)
+    {
+      const double d = (_points[i] - _points[i0]).SquaredLength();
+      if (d > best)
+      {
+        best = d;
+        i1 = i;
+      }
+    }
+    if (best <= this->eps * this->eps)
+      return false;
+
+    const math::Vector3d dir = (_points[i1] - _points[i0]).Normalized();
+    unsigned int i2 = i0;
+    best = 0;
+    for (unsigned int i : _indices)
+    {
+      const double d = dir.Cross(_points[i] - _points[i0]).Length();
+      if (d > best)
+      {
+        best = d;
+        i2 = i;
+      }
+    }
+    if (best <= this->eps)
+      return false;
+
+    const math::Vector3d n = (_points[i1] - _points[i0]).Cross(
+        _points[i2] - _points[i0]).Normalized();
+    unsigned int i3 = i0;
+    best = 0;
+    for (unsigned int i : _indices)
+    {
+      const double d = std::abs(n.Dot(_points[i] - _points[i0]));
+      if (d > best)
+      {
+        best = d;
+        i3 = i;
+      }
+    }
+    if (best <= this->eps)
+      return false;
+
+    if (n.Dot(_points[i3] - _points[i0]) > 0)
+      std::swap(i1, i2);
+
+    this->AddFace(i0, i1, i2);
+    this->AddFace(i0, i3, i1);
+    this->AddFace(i1, i3, i2);
+    this->AddFace(i2, i3, i0);
+
+    std::vector<unsigned int> remaining;
+    remaining.reserve(_indices.size());
+    for (unsigned int i : _indices)
+    {
+      if (i != i0 && i != i1 && i != i2 && i != i3)
+        remaining.push_back(i);
+    }
+    this->Assign(remaining, 0);
+
+    std::vector<unsigned int> visible;
+    std::vector<unsigned int> stack;
+    std::vector<std::pair<unsigned int, unsigned int>> horizon;
+    std::vector<char> isVisible;
+
+    // Each step adds the point furthest out of the hull, so that a hull cut
+    // short by the vertex limit is as close as possible to the full one
+    for (unsigned int vertexCount = 4;
+         _maxVertices == 0 || vertexCount < _maxVertices; ++vertexCount)
+    {
+      int start = -1;
+      double startDistance = 0;
+      for (unsigned int f = 0; f < this->faces.size(); ++f)
+      {
+        const Face &face = this->faces[f];
+        if (face.alive && !face.outside.empty() &&
+            face.furthestDistance > startDistance)
+        {
+          startDistance = face.furthestDistance;
+          start = static_cast<int>(f);
+        }
+      }
+      if (start < 0)
+        break;
+
+      const unsigned int i = this->faces[start].furthest;
+      const math::Vector3d &p = _points[i];
+
+      // Grow the visible region through neighboring faces so that it stays
+      // connected
+      isVisible.assign(this->faces.size(), 0);
+      visible.clear();
+      stack.assign(1, static_cast<unsigned int>(start));
+      isVisible[start] = 1;
+      while (!stack.empty())
+      {
+        const unsigned int f = stack.back();
+        stack.pop_back();
+        visible.push_back(f);
+        for (unsigned int k = 0; k < 3; ++k)
+        {
+          const unsigned int a = this->faces[f].v[k];
+          const unsigned int b = this->faces[f].v[(k + 1) % 3];
+          auto twin = this->edges.find(EdgeKey(b, a));
+          if (twin == this->edges.end())
+            continue;
+          const unsigned int g = twin->second;
+          if (isVisible[g])
+            continue;
+          const Face &face = this->faces[g];
+          if (face.normal.Dot(p) - face.offset > this->eps)
+          {
+            isVisible[g] = 1;
+            stack.push_back(g);
+          }
+        }
+      }
+
+      horizon.clear();
+      remaining.clear();
+      for (unsigned int f : visible)
+      {
+        Face &face = this->faces[f];
+        for (unsigned int k = 0; k < 3; ++k)
+        {
+          const unsigned int a = face.v[k];
+          const unsigned int b = face.v[(k + 1) % 3];
+          auto twin = this->edges.find(EdgeKey(b, a));
+          if (twin == this->edges.end() || !isVisible[twin->second])
+            horizon.emplace_back(a, b);
+        }
+        for (unsigned int o : face.outside)
+        {
+          if (o != i)
+            remaining.push_back(o);
+        }
+      }
+
+      for (unsigned int f : visible)
+      {
+        Face &face = this->faces[f];
+        face.alive = false;
+        face.outside.clear();
+        face.outside.shrink_to_fit();
+        for (unsigned int k = 0; k < 3; ++k)
+          this->edges.erase(EdgeKey(face.v[k], face.v[(k + 1) % 3]));
+      }
+
+      const size_t firstNew = this->faces.size();
+      for (const auto &edge : horizon)
+        this->AddFace(edge.first, edge.second, i);
+      this->Assign(remaining, firstNew);
+    }
+
+    return true;
+  }
+
+  //////////////////////////////////////////////////
+  bool Hull::Contains(const math::Vector3d &_p) const
+  {
+    for (const auto &face : this->faces)
+    {
+      if (face.alive && face.normal.Dot(_p) > face.offset)
+        return false;
+    }
+    return true;
+  }
+
+  //////////////////////////////////////////////////
+  std::unique_ptr<SubMesh> Hull::ToSubMesh() const
+  {
+    const auto &p = *this->points;
+    std::unique_ptr<SubMesh> subMesh(new SubMesh());
+    subMesh->SetPrimitiveType(SubMesh::TRIANGLES);
+
+    std::unordered_map<unsigned int, unsigned int> newIndex;
+    std::vector<math::Vector3d> normals;
+    for (const auto &face : this->faces)
+    {
+      if (!face.alive)
+        continue;
+      for (unsigned int v : face.v)
+      {
+        auto inserted = newIndex.emplace(v,
+            static_cast<unsigned int>(normals.size()));
+        if (inserted.second)
+        {
+          subMesh->AddVertex(p[v]);
+          normals.push_back(math::Vector3d::Zero);
+        }
+        normals[inserted.first->second] += face.normal;
+        subMesh->AddIndex(inserted.first->second);
+      }
+    }
+
+    for (auto &normal : normals)
+      subMesh->AddNormal(normal.Normalize());
+
+    return subMesh;
+  }
+
+  /// \brief Voxelized mesh, split into parts which become convex hulls.
+  class Decomposition
+  {
+    /// \brief Constructor.
+    /// \param[in] _maxHullVertices Maximum number of vertices of a hull.
+    public: explicit Decomposition(const unsigned int _maxHullVertices)
+      : maxHullVertices(_maxHullVertices)
+    {
+    }
+
+    /// \brief Voxelize the triangles of a mesh.
+    /// \param[in] _mesh The mesh.
+    /// \param[in] _resolution Voxels along the longest side.
+    /// \return False if the mesh has no triangle with an area.
+    public: bool Voxelize(const Mesh &_mesh, const unsigned int _resolution);
+
+    /// \brief Split the voxels into parts.
+    /// \param[in] _maxParts Maximum number of parts.
+    /// \param[in] _maxConcavity Concavity below which parts aren't split,
+    /// relative to the volume of the mesh.
+    public: void Split(const unsigned int _maxParts,
+                const double _maxConcavity);
+
+    /// \brief Build the hulls of the parts.
+    /// \param[out] _mesh Mesh receiving one submesh per hull.
+    public: void BuildHulls(Mesh &_mesh) const;
+
+    /// \brief A set of voxels
+    private: struct Part
+    {
+      /// \brief Label of the voxels of the part
+      int label;
+
+      /// \brief Indices of the voxels
+      std::vector<unsigned int> voxels;
+
+      /// \brief Number of empty voxels inside the hull of the part
+      double concavity;
+
+      /// \brief False if the part can't be split
+      bool splittable;
+    };
+
+    /// \brief A selection of the voxels of a part on one side of a plane
+    private: struct Side
+    {
+      /// \brief Part the voxels are from
+      int label;
+
+      /// \brief Axis of the plane, or -1 for the whole part
+      int axis;
+
+      /// \brief Voxel coordinate of the plane along the axis
+      int plane;
+
+      /// \brief True for the voxels below the plane
+      bool below;
+    };
+
+    /// \brief Check if a voxel is on a side of a part.
+    /// \param[in] _side The side.
+    /// \param[in] _c Coordinates of the voxel.
+    /// \return True if the voxel is in the part and on the side.
+    private: bool OnSide(const Side &_side, const std::array<int, 3> &_c) const
+    {
+      if (!this->InGrid(_c) || this->labels[this->Index(_c)] != _side.label)
+        return false;
+      if (_side.axis < 0)
+        return true;
+      return (_c[_side.axis] < _side.plane) == _side.below;
+    }
+
+    /// \brief Collect the points whose hull encloses the voxels on a side of
+    /// a part.
+    /// \param[in] _voxels Voxels of the part.
+    /// \param[in] _side The side.
+    /// \param[out] _points The points.
+    private: void HullPoints(const std::vector<unsigned int> &_voxels,
+                 const Side &_side,
+                 std::vector<math::Vector3d> &_points) const;
+
+    /// \brief Estimate the concavity of the voxels on a side of a part.
+    /// \param[in] _voxels Voxels of the part.
+    /// \param[in] _side The side.
+    /// \return Number of empty voxels inside the hull of the voxels.
+    private: double Concavity(const std::vector<unsigned int> &_voxels,
+                 const Side &_side) const;
+
+    /// \brief Split a part in two along the best plane.
+    /// \param[in] _part Index of the part.
+    /// \return False if the part can't be split.
+    private: bool SplitPart(const size_t _part);
+
+    /// \brief Check if voxel coordinates are in the grid.
+    /// \param[in] _c Coordinates.
+    /// \return True if in the grid.
+    private: bool InGrid(const std::array<int, 3> &_c) const
+    {
+      return _c[0] >= 0 && _c[1] >= 0 && _c[2] >= 0 &&
+          _c[0] < this->dims[0] && _c[1] < this->dims[1] &&
+          _c[2] < this->dims[2];
+    }
+
+    /// \brief Get the index of a voxel.
+    /// \param[in] _c Coordinates, in the grid.
+    /// \return Index of the voxel.
+    private: unsigned int Index(const std::array<int, 3> &_c) const
+    {
+      return static_cast<unsigned int>(
+          (_c[2] * this->dims[1] + _c[1]) * this->dims[0] + _c[0]);
+    }
+
+    /// \brief Get the coordinates of a voxel.
+    /// \param[in] _index Index of the voxel.
+    /// \return Coordinates.
+    private: std::array<int, 3> Coords(const unsigned int _index) const
+    {
+      const int i = static_cast<int>(_index);
+      return {{i % this->dims[0], (i / this->dims[0]) % this->dims[1],
+          i / (this->dims[0] * this->dims[1])}};
+    }
+
+    /// \brief Get the voxel containing a point.
+    /// \param[in] _p The point.
+    /// \return Coordinates, clamped to the grid.
+    private: std::array<int, 3> VoxelOf(const math::Vector3d &_p) const
+    {
+      std::array<int, 3> c;
+      for (unsigned int k = 0; k < 3; ++k)
+      {
+        c[k] = static_cast<int>(std::floor((_p[k] - this->origin[k]) /
+            this->size));
+        c[k] = std::max(0, std::min(this->dims[k] - 1, c[k]));
+      }
+      return c;
+    }
+
+    /// \brief Minimum corner of the grid
+    private: math::Vector3d origin;
+
+    /// \brief Side of a voxel
+    private: double size = 0;
+
+    /// \brief Number of voxels along each axis
+    private: std::array<int, 3> dims{{0, 0, 0}};
+
+    /// \brief Occupancy of each voxel: 0 for empty, 1 for inside the mesh
+    /// and 2 for crossed by the mesh surface
+    private: std::vector<uint8_t> occupancy;
+
+    /// \brief Index in surfacePoints of each surface voxel, -1 for others
+    private: std::vector<int> surfaceSlot;
+
+    /// \brief For each surface voxel, the points of the surface inside it
+    /// furthest along each diagonal direction
+    private: std::vector<std::array<math::Vector3d, 8>> surfacePoints;
+
+    /// \brief Part of each voxel, -1 for empty voxels
+    private: std::vector<int> labels;
+
+    /// \brief Maximum number of vertices of a hull
+    private: unsigned int maxHullVertices;
+
+    /// \brief Number of occupied voxels
+    private: size_t occupiedCount = 0;
+
+    /// \brief The parts
+    private: std::vector<Part> parts;
+  };
+
+  //////////////////////////////////////////////////
+  bool Decomposition::Voxelize(const Mesh &_mesh,
+      const unsigned int _resolution)
+  {
+    std::vector<std::array<math::Vector3d, 3>> triangles;
+    for (unsigned int i = 0; i < _mesh.SubMeshCount(); ++i)
+    {
+      auto subMesh = _mesh.SubMeshByIndex(i).lock();
+      if (!subMesh || subMesh->SubMeshPrimitiveType() != SubMesh::TRIANGLES)
+        continue;
+
+      for (unsigned int j = 0; j + 2 < subMesh->IndexCount(); j += 3)
+      {
+        std::array<math::Vector3d, 3> tri;
+        bool valid = true;
+        for (unsigned int k = 0; k < 3; ++k)
+        {
+          const int index = subMesh->Index(j + k);
+          valid = valid && subMesh->HasVertex(index);
+          if (valid)
+            tri[k] = subMesh->Vertex(index);
+        }
+        if (valid && (tri[1] - tri[0]).Cross(tri[2] - tri[0]).Length() > 0)
+          triangles.push_back(tri);
+      }
+    }
+
+    if (triangles.empty())
+      return false;
+
+    math::Vector3d min = triangles[0][0];
+    math::Vector3d max = triangles[0][0];
+    for (const auto &tri : triangles)
+    {
+      for (const auto &v : tri)
+      {
+        min.Min(v);
+        max.Max(v);
+      }
+    }
+
+    const math::Vector3d extent = max - min;
+    this->size = extent.Max() / std::max(1u, _resolution);
+    if (this->size <= 0)
+      return false;
+
+    this->origin = min;
+    for (unsigned int k = 0; k < 3; ++k)
+    {
+      this->dims[k] = std::max(1, static_cast<int>(
+          std::ceil(extent[k] / this->size)));
+    }
+
+    const size_t voxelCount =
+        static_cast<size_t>(this->dims[0]) * this->dims[1] * this->dims[2];
+    this->occupancy.assign(voxelCount, 0);
+    this->surfaceSlot.assign(voxelCount, -1);
+    this->surfacePoints.clear();
+
+    // Sample the triangles densely enough to hit every voxel they cross,
+    // keeping in each voxel the points which can be on a hull
+    const std::array<math::Vector3d, 8> diagonals = {{
+        {-1, -1, -1}, {1, -1, -1}, {-1, 1, -1}, {1, 1, -1},
+        {-1, -1, 1}, {1, -1, 1}, {-1, 1, 1}, {1, 1, 1}}};
+    auto addSample = [&](const math::Vector3d &_p)
+    {
+      const unsigned int index = this->Index(this->VoxelOf(_p));
+      int &slot = this->surfaceSlot[index];
+      if (slot < 0)
+      {
+        slot = static_cast<int>(this->surfacePoints.size());
+        std::array<math::Vector3d, 8> points;
+        points.fill(_p);
+        this->surfacePoints.push_back(points);
+        this->occupancy[index] = 2;
+        return;
+      }
+
+      auto &points = this->surfacePoints[slot];
+      for (unsigned int k = 0; k < 8; ++k)
+      {
+        if (diagonals[k].Dot(_p) > diagonals[k].Dot(points[k]))
+          points[k] = _p;
+      }
+    };
+
+    for (const auto &tri : triangles)
+    {
+      const double longest = std::max((tri[1] - tri[0]).Length(),
+          std::max((tri[2] - tri[1]).Length(), (tri[0] - tri[2]).Length()));
+      const int steps = std::max(1, static_cast<int>(
+          std::ceil(2.0 * longest / this->size)));
+      const math::Vector3d u = (tri[1] - tri[0]) / steps;
+      const math::Vector3d v = (tri[2] - tri[0]) / steps;
+      for (int i = 0; i <= steps; ++i)
+      {
+        for (int j = 0; i + j <= steps; ++j)
+          addSample(tri[0] + u * i + v * j);
+      }
+    }
+
+    // Fill the inside with rays along Z through the center of each column.
+    // The centers are offset slightly so that rays don't go through edges.
+    std::vector<std::vector<double>> columns(
+        static_cast<size_t>(this->dims[0]) * this->dims[1]);
+    const double jitter = 1e-4 * this->size;
+    for (const auto &tri : triangles)
+    {
+      const math::Vector3d n = (tri[1] - tri[0]).Cross(tri[2] - tri[0]);
+      if (std::abs(n.Z()) <= 0)
+        continue;
+
+      math::Vector3d tmin = tri[0];
+      math::Vector3d tmax = tri[0];
+      tmin.Min(tri[1]);
+      tmin.Min(tri[2]);
+      tmax.Max(tri[1]);
+      tmax.Max(tri[2]);
+
+      const int x0 = std::max(0, static_cast<int>(std::floor(
+          (tmin.X() - this->origin.X()) / this->size - 0.5)));
+      const int x1 = std::min(this->dims[0] - 1, static_cast<int>(std::ceil(
+          (tmax.X() - this->origin.X()) / this->size - 0.5)));
+      const int y0 = std::max(0, static_cast<int>(std::floor(
+          (tmin.Y() - this->origin.Y()) / this->size - 0.5)));
+      const int y1 = std::min(this->dims[1] - 1, static_cast<int>(std::ceil(
+          (tmax.Y() - this->origin.Y()) / this->size - 0.5)));
+
+      for (int y = y0; y <= y1; ++y)
+      {
+        for (int x = x0; x <= x1; ++x)
+        {
+          const double px = this->origin.X() + (x + 0.5) * this->size +
+              jitter;
+          const double py = this->origin.Y() + (y + 0.5) * this->size +
+              0.7 * jitter;
+
+          // Barycentric coordinates of the column in the XY projection
+          const double d = (tri[1].Y() - tri[2].Y()) * (tri[0].X() - tri[2].X())
+              + (tri[2].X() - tri[1].X()) * (tri[0].Y() - tri[2].Y());
+          const double a = ((tri[1].Y() - tri[2].Y()) * (px - tri[2].X()) +
+              (tri[2].X() - tri[1].X()) * (py - tri[2].Y())) / d;
+          const double b = ((tri[2].Y() - tri[0].Y()) * (px - tri[2].X()) +
+              (tri[0].X() - tri[2].X()) * (py - tri[2].Y())) / d;
+          const double c = 1.0 - a - b;
+          if (a < 0 || b < 0 || c < 0)
+            continue;
+
+          columns[y * this->dims[0] + x].push_back(
+              a * tri[0].Z() + b * tri[1].Z() + c * tri[2].Z());
+        }
+      }
+    }
+
+    for (int y = 0; y < this->dims[1]; ++y)
+    {
+      for (int x = 0; x < this->dims[0]; ++x)
+      {
+        auto &hits = columns[y * this->dims[0] + x];
+        // An odd number of crossings means the mesh isn't closed here
+        if (hits.empty() || hits.size() % 2 != 0)
+          continue;
+
+        std::sort(hits.begin(), hits.end());
+        for (size_t h = 0; h + 1 < hits.size(); h += 2)
+        {
+          for (int z = 0; z < this->dims[2]; ++z)
+          {
+            const double pz = this->origin.Z() + (z + 0.5) * this->size;
+            if (pz < hits[h] || pz > hits[h + 1])
+              continue;
+            uint8_t &voxel = this->occupancy[this->Index({{x, y, z}})];
+            if (voxel == 0)
+              voxel = 1;
+          }
+        }
+      }
+    }
+
+    Part all;
+    all.label = 0;
+    all.splittable = true;
+    this->labels.assign(voxelCount, -1);
+    for (unsigned int i = 0; i < voxelCount; ++i)
+    {
+      if (this->occupancy[i] == 0)
+        continue;
+      this->labels[i] = 0;
+      all.voxels.push_back(i);
+    }
+
+    this->occupiedCount = all.voxels.size();
+    all.concavity = this->Concavity(all.voxels, {0, -1, 0, true});
+    this->parts.push_back(std::move(all));
+    return true;
+  }
+
+  //////////////////////////////////////////////////
+  void Decomposition::HullPoints(const std::vector<unsigned int> &_voxels,
+      const Side &_side, std::vector<math::Vector3d> &_points) const
+  {
+    // Directions to the 6 neighbors, and the corners of the shared face
+    static const std::array<std::array<int, 3>, 6> kNeighbors = {{
+        {{-1, 0, 0}}, {{1, 0, 0}}, {{0, -1, 0}}, {{0, 1, 0}}, {{0, 0, -1}},
+        {{0, 0, 1}}}};
+
+    std::unordered_set<uint64_t> corners;
+    auto addCorner = [&corners](const std::array<int, 3> &_c)
+    {
+      corners.insert((static_cast<uint64_t>(_c[0]) << 42) |
+          (static_cast<uint64_t>(_c[1]) << 21) | static_cast<uint64_t>(_c[2]));
+    };
+
+    for (unsigned int index : _voxels)
+    {
+      const std::array<int, 3> c = this->Coords(index);
+      if (!this->OnSide(_side, c))
+        continue;
+
+      const bool surface = this->occupancy[index] == 2;
+      if (surface)
+      {
+        for (const auto &p : this->surfacePoints[this->surfaceSlot[index]])
+          _points.push_back(p);
+      }
+
+      for (unsigned int n = 0; n < 6; ++n)
+      {
+        const std::array<int, 3> nc = {{c[0] + kNeighbors[n][0],
+            c[1] + kNeighbors[n][1], c[2] + kNeighbors[n][2]}};
+        if (this->OnSide(_side, nc))
+          continue;
+
+        const bool occupied = this->InGrid(nc) &&
+            this->occupancy[this->Index(nc)] != 0;
+
+        // Faces cut from the rest of the mesh bound the part, and so do
+        // faces of inner voxels which have no surface points
+        if (!occupied && surface)
+          continue;
+
+        const int axis = n / 2;
+        const int offset = (n % 2 == 0) ? 0 : 1;
+        for (int a = 0; a < 2; ++a)
+        {
+          for (int b = 0; b < 2; ++b)
+          {
+            std::array<int, 3> corner = c;
+            corner[axis] += offset;
+            corner[(axis + 1) % 3] += a;
+            corner[(axis + 2) % 3] += b;
+            addCorner(corner);
+          }
+        }
+      }
+    }
+
+    const uint64_t mask = (1u << 21) - 1;
+    for (uint64_t key : corners)
+    {
+      _points.push_back(this->origin + math::Vector3d(
+          static_cast<double>(key >> 42),
+          static_cast<double>((key >> 21) & mask),
+          static_cast<double>(key & mask)) * this->size);
+    }
+  }
+
+  //////////////////////////////////////////////////
+  double Decomposition::Concavity(const std::vector<unsigned int> &_voxels,
+      const Side &_side) const
+  {
+    std::vector<math::Vector3d> points;
+    this->HullPoints(_voxels, _side, points);
+
+    Hull hull;
+    if (!hull.Build(points, this->maxHullVertices))
+      return 0;
+
+    // Measuring the empty space covered by the hull on the voxel grid, rather
+    // than comparing volumes, keeps the surface voxels from counting as
+    // concavity
+    math::Vector3d min = points[0];
+    math::Vector3d max = points[0];
+    for (const auto &p : points)
+    {
+      min.Min(p);
+      max.Max(p);
+    }
+    const std::array<int, 3> c0 = this->VoxelOf(min);
+    const std::array<int, 3> c1 = this->VoxelOf(max);
+
+    double concavity = 0;
+    std::array<int, 3> c;
+    for (c[2] = c0[2]; c[2] <= c1[2]; ++c[2])
+    {
+      for (c[1] = c0[1]; c[1] <= c1[1]; ++c[1])
+      {
+        for (c[0] = c0[0]; c[0] <= c1[0]; ++c[0])
+        {
+          if (this->occupancy[this->Index(c)] != 0)
+            continue;
+          const math::Vector3d center = this->origin + math::Vector3d(
+              c[0] + 0.5, c[1] + 0.5, c[2] + 0.5) * this->size;
+          if (hull.Contains(center))
+            concavity += 1.0;
+        }
+      }
+    }
+    return concavity;
+  }
+
+  //////////////////////////////////////////////////
+  bool Decomposition::SplitPart(const size_t _part)
+  {
+    const Part &part = this->parts[_part];
+
+    std::array<int, 3> min{{std::numeric_limits<int>::max(),
+        std::numeric_limits<int>::max(), std::numeric_limits<int>::max()}};
+    std::array<int, 3> max{{-1, -1, -1}};
+    for (unsigned int index : part.voxels)
+    {
+      const std::array<int, 3> c = this->Coords(index);
+      for (unsigned int k = 0; k < 3; ++k)
+      {
+        min[k] = std::min(min[k], c[k]);
+        max[k] = std::max(max[k], c[k]);
+      }
+    }
+
+    int bestAxis = -1;
+    int bestPlane = 0;
+    double bestCost = std::numeric_limits<double>::infinity();
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      const int extent = max[axis] - min[axis] + 1;
+      if (extent < 2)
+        continue;
+
+      const int step = std::max(1, extent / kCandidatesPerAxis);
+      for (int plane = min[axis] + step; plane <= max[axis]; plane += step)
+      {
+        const double cost =
+            this->Concavity(part.voxels, {part.label, axis, plane, true}) +
+            this->Concavity(part.voxels, {part.label, axis, plane, false});
+        if (cost < bestCost)
+        {
+          bestCost = cost;
+          bestAxis = axis;
+          bestPlane = plane;
+        }
+      }
+    }
+
+    if (bestAxis < 0)
+      return false;
+
+    Part above;
+    above.label = static_cast<int>(this->parts.size());
+    above.splittable = true;
+    std::vector<unsigned int> below;
+    for (unsigned int index : part.voxels)
+    {
+      if (this->Coords(index)[bestAxis] < bestPlane)
+        below.push_back(index);
+      else
+        above.voxels.push_back(index);
+    }
+
+    if (below.empty() || above.voxels.empty())
+      return false;
+
+    for (unsigned int index : above.voxels)
+      this->labels[index] = above.label;
+
+    Part &kept = this->parts[_part];
+    kept.voxels = std::move(below);
+    kept.concavity = this->Concavity(kept.voxels, {kept.label, -1, 0, true});
+    above.concavity =
+        this->Concavity(above.voxels, {above.label, -1, 0, true});
+    this->parts.push_back(std::move(above));
+    return true;
+  }
+
+  //////////////////////////////////////////////////
+  void Decomposition::Split(const unsigned int _maxParts,
+      const double _maxConcavity)
+  {
+    const double threshold = _maxConcavity * this->occupiedCount;
+    while (this->parts.size() < _maxParts)
+    {
+      size_t worst = 0;
+      for (size_t i = 1; i < this->parts.size(); ++i)
+      {
+        const Part &p = this->parts[i];
+        const Part &w = this->parts[worst];
+        if (!w.splittable || (p.splittable && p.concavity > w.concavity))
+          worst = i;
+      }
+
+      Part &part = this->parts[worst];
+      if (!part.splittable || part.concavity <= threshold)
+        break;
+
+      if (!this->SplitPart(worst))
+        this->parts[worst].splittable = false;
+    }
+  }
+
+  //////////////////////////////////////////////////
+  void Decomposition::BuildHulls(Mesh &_mesh) const
+  {
+    for (const auto &part : this->parts)
+    {
+      std::vector<math::Vector3d> points;
+      this->HullPoints(part.voxels, {part.label, -1, 0, true}, points);
+
+      Hull hull;
+      if (!hull.Build(points, this->maxHullVertices))
+        continue;
+
+      std::unique_ptr<SubMesh> subMesh = hull.ToSubMesh();
+      subMesh->SetName("convex_hull_" + std::to_string(_mesh.SubMeshCount()));
+      _mesh.AddSubMesh(std::move(subMesh));
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+ConvexDecomposition::ConvexDecomposition()
+  : dataPtr(new ConvexDecompositionPrivate)
+{
+}
+
+//////////////////////////////////////////////////
+ConvexDecomposition::~ConvexDecomposition()
+{
+}
+
+//////////////////////////////////////////////////
+void ConvexDecomposition::SetMaxConvexHulls(const unsigned int _count)
+{
+  this->dataPtr->maxConvexHulls = std::max(1u, _count);
+}
+
+//////////////////////////////////////////////////
+unsigned int ConvexDecomposition::MaxConvexHulls() const
+{
+  return this->dataPtr->maxConvexHulls;
+}
+
+//////////////////////////////////////////////////
+void ConvexDecomposition::SetVoxelResolution(const unsigned int _resolution)
+{
+  this->dataPtr->voxelResolution = std::max(1u, _resolution);
+}
+
+//////////////////////////////////////////////////
+unsigned int ConvexDecomposition::VoxelResolution() const
+{
+  return this->dataPtr->voxelResolution;
+}
+
+//////////////////////////////////////////////////
+void ConvexDecomposition::SetMaxConcavity(const double _concavity)
+{
+  this->dataPtr->maxConcavity = _concavity;
+}
+
+//////////////////////////////////////////////////
+double ConvexDecomposition::MaxConcavity() const
+{
+  return this->dataPtr->maxConcavity;
+}
+
+//////////////////////////////////////////////////
+void ConvexDecomposition::SetMaxHullVertices(const unsigned int _count)
+{
+  this->dataPtr->maxHullVertices = std::max(4u, _count);
+}
+
+//////////////////////////////////////////////////
+unsigned int ConvexDecomposition::MaxHullVertices() const
+{
+  return this->dataPtr->maxHullVertices;
+}
+
+//////////////////////////////////////////////////
+Mesh *ConvexDecomposition::Decompose(const Mesh &_mesh) const
+{
+  Decomposition decomposition(this->dataPtr->maxHullVertices);
+  if (!decomposition.Voxelize(_mesh, this->dataPtr->voxelResolution))
+    return nullptr;
+
+  decomposition.Split(this->dataPtr->maxConvexHulls,
+      this->dataPtr->maxConcavity);
+
+  Mesh *result = new Mesh();
+  result->SetName(_mesh.Name());
+  result->SetPath(_mesh.Path());
+  decomposition.BuildHulls(*result);
+  return result;
+}
+
+//////////////////////////////////////////////////
+std::unique_ptr<SubMesh> ConvexDecomposition::ConvexHull(
+    const std::vector<ignition::math::Vector3d> &_points,
+    const unsigned int _maxVertices)
+{
+  Hull hull;
+  if (!hull.Build(_points, _maxVertices))
+    return nullptr;
+  return hull.ToSubMesh();
+}
+
+//////////////////////////////////////////////////
+std::string ConvexDecomposition::CacheVariant() const
+{
+  std::ostringstream variant;
+  variant << "convex_" << this->dataPtr->maxConvexHulls << "_"
+          << this->dataPtr->voxelResolution << "_"
+          << this->dataPtr->maxConcavity << "_"
+          << this->dataPtr->maxHullVertices;
+  return variant.str();
+}
@@ -0,0 +1,226 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "test_config.h"
+#include "ignition/common/ConvexDecomposition.hh"
+#include "ignition/common/Mesh.hh"
+#include "ignition/common/MeshManager.hh"
+#include "ignition/common/SubMesh.hh"
+#include "test/util.hh"
+
+using namespace ignition;
+
+class ConvexDecompositionTest : public ignition::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+/// \brief Get the volume enclosed by a closed triangle submesh.
+/// \param[in] _subMesh The submesh.
+/// \return The volume, negative if the triangles face inwards.
+double volume(const common::SubMesh &_subMesh)
+{
+  double result = 0;
+  for (unsigned int i = 0; i + 2 < _subMesh.IndexCount(); i += 3)
+  {
+    math::Vector3d v0 = _subMesh.Vertex(_subMesh.Index(i));
+    math::Vector3d v1 = _subMesh.Vertex(_subMesh.Index(i + 1));
+    math::Vector3d v2 = _subMesh.Vertex(_subMesh.Index(i + 2));
+    result += v0.Dot(v1.Cross(v2));
+  }
+  return result / 6.0;
+}
+
+/////////////////////////////////////////////////
+/// \brief Create a box mesh and move it.
+/// \param[in] _name Name of the mesh.
+/// \param[in] _size Size of the box.
+/// \param[in] _offset Position of the center of the box.
+/// \return The submesh of the box.
+common::SubMesh box(const std::string &_name, const math::Vector3d &_size,
+    const math::Vector3d &_offset)
+{
+  common::MeshManager::Instance()->CreateBox(_name, _size,
+      math::Vector2d(1, 1));
+  const common::Mesh *mesh =
+      common::MeshManager::Instance()->MeshByName(_name);
+  common::SubMesh subMesh(*mesh->SubMeshByIndex(0).lock());
+  subMesh.Translate(_offset);
+  return subMesh;
+}
+
+/////////////////////////////////////////////////
+TEST_F(ConvexDecompositionTest, Defaults)
+{
+  common::ConvexDecomposition decomposition;
+  EXPECT_EQ(16u, decomposition.MaxConvexHulls());
+  EXPECT_EQ(32u, decomposition.VoxelResolution());
+  EXPECT_DOUBLE_EQ(0.01, decomposition.MaxConcavity());
+  EXPECT_EQ(64u, decomposition.MaxHullVertices());
+  EXPECT_EQ("convex_16_32_0.01_64", decomposition.CacheVariant());
+
+  decomposition.SetMaxConvexHulls(4);
+  decomposition.SetVoxelResolution(20);
+  decomposition.SetMaxConcavity(0.05);
+  decomposition.SetMaxHullVertices(32);
+  EXPECT_EQ(4u, decomposition.MaxConvexHulls());
+  EXPECT_EQ(20u, decomposition.VoxelResolution());
+  EXPECT_DOUBLE_EQ(0.05, decomposition.MaxConcavity());
+  EXPECT_EQ(32u, decomposition.MaxHullVertices());
+  EXPECT_EQ("convex_4_20_0.05_32", decomposition.CacheVariant());
+
+  decomposition.SetMaxConvexHulls(0);
+  EXPECT_EQ(1u, decomposition.MaxConvexHulls());
+  decomposition.SetMaxHullVertices(0);
+  EXPECT_EQ(4u, decomposition.MaxHullVertices());
+}
+
+/////////////////////////////////////////////////
+TEST_F(ConvexDecompositionTest, ConvexHull)
+{
+  // Corners of a cube, with points inside and on its faces
+  std::vector<math::Vector3d> points;
+  for (int x = 0; x < 3; ++x)
+  {
+    for (int y = 0; y < 3; ++y)
+    {
+      for (int z = 0; z < 3; ++z)
+        points.push_back(math::Vector3d(x, y, z) * 0.5);
+    }
+  }
+
+  auto hull = common::ConvexDecomposition::ConvexHull(points);
+  ASSERT_NE(nullptr, hull);
+  EXPECT_EQ(common::SubMesh::TRIANGLES, hull->SubMeshPrimitiveType());
+  EXPECT_EQ(8u, hull->VertexCount());
+  EXPECT_EQ(8u, hull->NormalCount());
+  EXPECT_EQ(36u, hull->IndexCount());
+  EXPECT_NEAR(1.0, volume(*hull), 1e-9);
+  EXPECT_EQ(math::Vector3d::Zero, hull->Min());
+  EXPECT_EQ(math::Vector3d::One, hull->Max());
+
+  // Normals point away from the center
+  for (unsigned int i = 0; i < hull->VertexCount(); ++i)
+  {
+    math::Vector3d out = hull->Vertex(i) - math::Vector3d(0.5, 0.5, 0.5);
+    EXPECT_GT(hull->Normal(i).Dot(out), 0.0);
+  }
+
+  // Limit the vertices of the hull of points on a sphere
+  std::vector<math::Vector3d> sphere;
+  for (int i = 0; i < 20; ++i)
+  {
+    for (int j = 0; j < 20; ++j)
+    {
+      const double theta = IGN_PI * (i + 0.5) / 20.0;
+      const double phi = 2.0 * IGN_PI * j / 20.0;
+      sphere.push_back(math::Vector3d(std::sin(theta) * std::cos(phi),
+          std::sin(theta) * std::sin(phi), std::cos(theta)));
+    }
+  }
+  hull = common::ConvexDecomposition::ConvexHull(sphere);
+  ASSERT_NE(nullptr, hull);
+  EXPECT_EQ(400u, hull->VertexCount());
+  hull = common::ConvexDecomposition::ConvexHull(sphere, 24);
+  ASSERT_NE(nullptr, hull);
+  EXPECT_EQ(24u, hull->VertexCount());
+  EXPECT_GT(volume(*hull), 0.5 * 4.0 / 3.0 * IGN_PI);
+  for (unsigned int i = 0; i < hull->VertexCount(); ++i)
+    EXPECT_NEAR(1.0, hull->Vertex(i).Length(), 1e-9);
+
+  // Flat and too small sets have no hull
+  std::vector<math::Vector3d> flat = {
+      {0, 0, 0}, {1, 0, 0}, {0, 1, 0}, {1, 1, 0}, {0.5, 0.5, 0}};
+  EXPECT_EQ(nullptr, common::ConvexDecomposition::ConvexHull(flat));
+  points.resize(3);
+  EXPECT_EQ(nullptr, common::ConvexDecomposition::ConvexHull(points));
+}
+
+/////////////////////////////////////////////////
+TEST_F(ConvexDecompositionTest, Box)
+{
+  common::Mesh mesh;
+  mesh.SetName("decomposition_box");
+  mesh.AddSubMesh(box("decomposition_box", math::Vector3d(1, 2, 3),
+      math::Vector3d::Zero));
+
+  common::ConvexDecomposition decomposition;
+  std::unique_ptr<common::Mesh> result(decomposition.Decompose(mesh));
+  ASSERT_NE(nullptr, result);
+  EXPECT_EQ("decomposition_box", result->Name());
+
+  // A convex mesh is its own hull
+  ASSERT_EQ(1u, result->SubMeshCount());
+  auto hull = result->SubMeshByIndex(0).lock();
+  EXPECT_EQ("convex_hull_0", hull->Name());
+  EXPECT_EQ(8u, hull->VertexCount());
+  EXPECT_NEAR(6.0, volume(*hull), 1e-6);
+  EXPECT_EQ(math::Vector3d(-0.5, -1, -1.5), hull->Min());
+  EXPECT_EQ(math::Vector3d(0.5, 1, 1.5), hull->Max());
+}
+
+/////////////////////////////////////////////////
+TEST_F(ConvexDecompositionTest, Concave)
+{
+  // L shape made of two boxes
+  common::Mesh mesh;
+  mesh.AddSubMesh(box("decomposition_l0", math::Vector3d(2, 1, 1),
+      math::Vector3d(1, 0.5, 0.5)));
+  mesh.AddSubMesh(box("decomposition_l1", math::Vector3d(1, 1, 1),
+      math::Vector3d(0.5, 1.5, 0.5)));
+
+  common::ConvexDecomposition decomposition;
+  std::unique_ptr<common::Mesh> result(decomposition.Decompose(mesh));
+  ASSERT_NE(nullptr, result);
+  EXPECT_GE(result->SubMeshCount(), 2u);
+  EXPECT_LE(result->SubMeshCount(), 16u);
+
+  // The hulls cover the L without filling its inner corner
+  double total = 0;
+  for (unsigned int i = 0; i < result->SubMeshCount(); ++i)
+  {
+    auto hull = result->SubMeshByIndex(i).lock();
+    EXPECT_GT(volume(*hull), 0.0);
+    total += volume(*hull);
+  }
+  EXPECT_NEAR(3.0, total, 0.1);
+  EXPECT_EQ(math::Vector3d::Zero, result->Min());
+  EXPECT_EQ(math::Vector3d(2, 2, 1), result->Max());
+
+  // Limit the number of hulls
+  decomposition.SetMaxConvexHulls(1);
+  result.reset(decomposition.Decompose(mesh));
+  ASSERT_NE(nullptr, result);
+  EXPECT_EQ(1u, result->SubMeshCount());
+  EXPECT_NEAR(3.5, volume(*result->SubMeshByIndex(0).lock()), 1e-6);
+
+  // Nothing to decompose
+  common::Mesh empty;
+  EXPECT_EQ(nullptr, decomposition.Decompose(empty));
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -15,6 +15,7 @@
  *
  */
 #include <algorithm>
+#include <atomic>
 #include <ignition/math/Color.hh>
 
 #include "ignition/common/Material.hh"
@@ -68,7 +69,7 @@ class ignition::common::MaterialPrivate
   public: Material::ShadeMode shadeMode;
 
   /// \brief the total number of instantiated Material instances
-  public: static unsigned int counter;
+  public: static std::atomic<unsigned int> counter;
 
   /// \brief flag to perform depth buffer write
   public: bool depthWrite = true;
@@ -83,7 +84,7 @@ class ignition::common::MaterialPrivate
   public: double dstBlendFactor;
 };
 
-unsigned int MaterialPrivate::counter = 0;
+std::atomic<unsigned int> MaterialPrivate::counter{0};
 
 //////////////////////////////////////////////////
 Material::Material()
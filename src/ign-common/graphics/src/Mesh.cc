@@ -378,6 +378,13 @@ void Mesh::Translate(const ignition::math::Vector3d &_vec)
     submesh->Translate(_vec);
 }
 
+//////////////////////////////////////////////////
+void Mesh::SetVertexPrecision(const SubMesh::VertexPrecision _precision)
+{
+  for (auto &submesh : this->dataPtr->submeshes)
+    submesh->SetVertexPrecision(_precision);
+}
+
 //////////////////////////////////////////////////
 void Mesh::AABB(ignition::math::Vector3d &_center,
                 ignition::math::Vector3d &_minXYZ,
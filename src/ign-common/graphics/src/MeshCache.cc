@@ -0,0 +1,774 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <sys/stat.h>
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "ignition/common/Console.hh"
+#include "ignition/common/Filesystem.hh"
+#include "ignition/common/Material.hh"
+#include "ignition/common/Mesh.hh"
+#include "ignition/common/NodeAnimation.hh"
+#include "ignition/common/NodeTransform.hh"
+#include "ignition/common/Skeleton.hh"
+#include "ignition/common/SkeletonAnimation.hh"
+#include "ignition/common/SkeletonNode.hh"
+#include "ignition/common/SubMesh.hh"
+#include "ignition/common/Uuid.hh"
+
+#include "ignition/common/MeshCache.hh"
+
+using namespace ignition;
+using namespace common;
+
+/// \brief Tag at the start of every cache file
+static const char kMagic[8] = {'I', 'G', 'N', 'M', 'E', 'S', 'H', '\0'};
+
+/// \brief Version of the cache file format, to be incremented whenever the
+/// format changes so that older cache files are ignored.
+static const uint32_t kVersion = 1;
+
+/// \brief Written as is after the version, to detect cache files written on
+/// a machine of different endianness.
+static const uint32_t kByteOrder = 0x01020304;
+
+/// \brief Identity of a mesh source file.
+struct SourceStamp
+{
+  /// \brief Full path to the file
+  std::string path;
+
+  /// \brief Modification time, in seconds since epoch
+  int64_t mtime = 0;
+
+  /// \brief Size in bytes
+  uint64_t size = 0;
+
+  /// \brief Hash of the file content
+  uint64_t hash = 0;
+};
+
+/// \brief Writes values to a binary buffer.
+class CacheWriter
+{
+  /// \brief Write a value of a trivially copyable type.
+  /// \param[in] _value Value to write.
+  public: template<typename T>
+  void Write(const T &_value)
+  {
+    static_assert(std::is_trivially_copyable<T>::value,
+        "Only plain values can be written");
+    this->buffer.append(reinterpret_cast<const char *>(&_value), sizeof(T));
+  }
+
+  /// \brief Write a string, preceded by its size.
+  /// \param[in] _str String to write.
+  public: void WriteString(const std::string &_str)
+  {
+    this->Write<uint64_t>(_str.size());
+    this->buffer.append(_str);
+  }
+
+  /// \brief Write an array of values, preceded by its size.
+  /// \param[in] _values Values to write.
+  public: template<typename T>
+  void WriteArray(const std::vector<T> &_values)
+  {
+    this->Write<uint64_t>(_values.size());
+    this->buffer.append(reinterpret_cast<const char *>(_values.data()),
+        _values.size() * sizeof(T));
+  }
+
+  /// \brief Write a matrix, row by row.
+  /// \param[in] _mat Matrix to write.
+  public: void WriteMatrix(const math::Matrix4d &_mat)
+  {
+    for (unsigned int r = 0; r < 4; ++r)
+    {
+      for (unsigned int c = 0; c < 4; ++c)
+        this->Write<double>(_mat(r, c));
+    }
+  }
+
+  /// \brief Content written so far.
+  public: std::string buffer;
+};
+
+/// \brief Reads values written by a CacheWriter from a buffer. Once a read
+/// goes past the end of the buffer, all reads return default values and
+/// Ok() returns false.
+class CacheReader
+{
+  /// \brief Constructor
+  /// \param[in] _buffer Buffer to read.
+  public: explicit CacheReader(const std::string &_buffer)
+    : data(_buffer.data()), end(_buffer.data() + _buffer.size())
+  {
+  }
+
+  /// \brief Read a value of a trivially copyable type.
+  /// \return The value.
+  public: template<typename T>
+  T Read()
+  {
+    T value{};
+    if (this->Has(sizeof(T)))
+    {
+      std::memcpy(&value, this->data, sizeof(T));
+      this->data += sizeof(T);
+    }
+    return value;
+  }
+
+  /// \brief Read a string.
+  /// \return The string.
+  public: std::string ReadString()
+  {
+    uint64_t size = this->Read<uint64_t>();
+    if (!this->Has(size))
+      return std::string();
+
+    std::string str(this->data, size);
+    this->data += size;
+    return str;
+  }
+
+  /// \brief Read an array of values.
+  /// \param[out] _values The values.
+  public: template<typename T>
+  void ReadArray(std::vector<T> &_values)
+  {
+    uint64_t count = this->Read<uint64_t>();
+    _values.clear();
+    if (count > static_cast<uint64_t>(this->end - this->data) / sizeof(T) ||
+        !this->Has(count * sizeof(T)))
+    {
+      this->ok = false;
+      return;
+    }
+
+    _values.resize(count);
+    std::memcpy(_values.data(), this->data, count * sizeof(T));
+    this->data += count * sizeof(T);
+  }
+
+  /// \brief Read a matrix.
+  /// \return The matrix.
+  public: math::Matrix4d ReadMatrix()
+  {
+    double v[16];
+    for (unsigned int i = 0; i < 16; ++i)
+      v[i] = this->Read<double>();
+
+    return math::Matrix4d(
+        v[0], v[1], v[2], v[3],
+        v[4], v[5], v[6], v[7],
+        v[8], v[9], v[10], v[11],
+        v[12], v[13], v[14], v[15]);
+  }
+
+  /// \brief Check that all reads so far were within the buffer.
+  /// \return True if no read went past the end of the buffer.
+  public: bool Ok() const
+  {
+    return this->ok;
+  }
+
+  /// \brief Check that a number of bytes is left to read.
+  /// \param[in] _size Number of bytes.
+  /// \return True if the bytes can be read.
+  private: bool Has(uint64_t _size)
+  {
+    if (this->ok && _size <= static_cast<uint64_t>(this->end - this->data))
+      return true;
+
+    this->ok = false;
+    return false;
+  }
+
+  /// \brief Next byte to read
+  private: const char *data;
+
+  /// \brief End of the buffer
+  private: const char *end;
+
+  /// \brief False once a read went past the end of the buffer
+  private: bool ok = true;
+};
+
+/// \brief Private data for the MeshCache class
+class ignition::common::MeshCachePrivate
+{
+  /// \brief Get the identity of a mesh source file.
+  /// \param[in] _filename Full path to the file.
+  /// \param[out] _stamp Identity of the file.
+  /// \return False if the file can't be read.
+  public: static bool Stamp(const std::string &_filename,
+      SourceStamp &_stamp);
+
+  /// \brief Write a mesh.
+  /// \param[in] _mesh Mesh to write.
+  /// \param[in,out] _writer Buffer to write to.
+  public: static void WriteMesh(const Mesh &_mesh, CacheWriter &_writer);
+
+  /// \brief Write a skeleton.
+  /// \param[in] _skel Skeleton to write.
+  /// \param[in,out] _writer Buffer to write to.
+  public: static void WriteSkeleton(const Skeleton &_skel,
+      CacheWriter &_writer);
+
+  /// \brief Read a mesh.
+  /// \param[in,out] _reader Buffer to read from.
+  /// \return The mesh, or nullptr if the buffer is truncated.
+  public: static std::unique_ptr<Mesh> ReadMesh(CacheReader &_reader);
+
+  /// \brief Read a skeleton.
+  /// \param[in,out] _reader Buffer to read from.
+  /// \return The skeleton, or nullptr if the buffer is truncated or invalid.
+  public: static SkeletonPtr ReadSkeleton(CacheReader &_reader);
+
+  /// \brief Directory holding the cached meshes
+  public: std::string path;
+};
+
+//////////////////////////////////////////////////
+MeshCache::MeshCache(const std::string &_path)
+  : dataPtr(new MeshCachePrivate)
+{
+  this->dataPtr->path = _path;
+}
+
+//////////////////////////////////////////////////
+MeshCache::~MeshCache()
+{
+}
+
+//////////////////////////////////////////////////
+std::string MeshCache::Path() const
+{
+  return this->dataPtr->path;
+}
+
+//////////////////////////////////////////////////
+std::string MeshCache::CacheFilename(const std::string &_filename,
+    const std::string &_variant) const
+{
+  // FNV-1a hash of the source path
+  uint64_t hash = 14695981039346656037ULL;
+  for (unsigned char c : _filename)
+  {
+    hash ^= c;
+    hash *= 1099511628211ULL;
+  }
+
+  std::stringstream name;
+  name << std::hex << std::setw(16) << std::setfill('0') << hash;
+  if (!_variant.empty())
+    name << "." << _variant;
+  name << ".ignmesh";
+  return joinPaths(this->dataPtr->path, name.str());
+}
+
+//////////////////////////////////////////////////
+Mesh *MeshCache::Load(const std::string &_filename,
+    const std::string &_variant) const
+{
+  std::ifstream in(this->CacheFilename(_filename, _variant),
+      std::ios::in | std::ios::binary);
+  if (!in)
+    return nullptr;
+
+  std::string buffer((std::istreambuf_iterator<char>(in)),
+      std::istreambuf_iterator<char>());
+  CacheReader reader(buffer);
+
+  char magic[sizeof(kMagic)];
+  for (char &c : magic)
+    c = reader.Read<char>();
+  if (std::memcmp(magic, kMagic, sizeof(kMagic)) != 0 ||
+      reader.Read<uint32_t>() != kVersion ||
+      reader.Read<uint32_t>() != kByteOrder)
+  {
+    return nullptr;
+  }
+
+  SourceStamp cached;
+  cached.path = reader.ReadString();
+  cached.mtime = reader.Read<int64_t>();
+  cached.size = reader.Read<uint64_t>();
+  cached.hash = reader.Read<uint64_t>();
+
+  // Check the cheap parts of the stamp before hashing the source file
+  struct stat st;
+  if (!reader.Ok() || cached.path != _filename ||
+      stat(_filename.c_str(), &st) != 0 ||
+      cached.mtime != static_cast<int64_t>(st.st_mtime) ||
+      cached.size != static_cast<uint64_t>(st.st_size))
+  {
+    return nullptr;
+  }
+
+  SourceStamp current;
+  if (!MeshCachePrivate::Stamp(_filename, current) ||
+      current.hash != cached.hash)
+  {
+    return nullptr;
+  }
+
+  auto mesh = MeshCachePrivate::ReadMesh(reader);
+  if (!mesh)
+  {
+    ignwarn << "Ignoring corrupted mesh cache file["
+            << this->CacheFilename(_filename, _variant) << "]\n";
+    return nullptr;
+  }
+
+  return mesh.release();
+}
+
+//////////////////////////////////////////////////
+bool MeshCache::Save(const Mesh &_mesh, const std::string &_filename,
+    const std::string &_variant) const
+{
+  SourceStamp stamp;
+  if (!MeshCachePrivate::Stamp(_filename, stamp))
+    return false;
+
+  CacheWriter writer;
+  for (char c : kMagic)
+    writer.Write<char>(c);
+  writer.Write<uint32_t>(kVersion);
+  writer.Write<uint32_t>(kByteOrder);
+  writer.WriteString(stamp.path);
+  writer.Write<int64_t>(stamp.mtime);
+  writer.Write<uint64_t>(stamp.size);
+  writer.Write<uint64_t>(stamp.hash);
+  MeshCachePrivate::WriteMesh(_mesh, writer);
+
+  if (!exists(this->dataPtr->path) &&
+      !createDirectories(this->dataPtr->path))
+  {
+    ignerr << "Unable to create mesh cache directory["
+           << this->dataPtr->path << "]\n";
+    return false;
+  }
+
+  // Write to a temporary file first, so that other processes sharing the
+  // cache never read a partially written file.
+  const std::string cacheFilename =
+      this->CacheFilename(_filename, _variant);
+  const std::string tmpFilename = cacheFilename + "." + Uuid().String();
+  {
+    std::ofstream out(tmpFilename,
+        std::ios::out | std::ios::binary | std::ios::trunc);
+    out.write(writer.buffer.data(), writer.buffer.size());
+    if (!out)
+    {
+      ignerr << "Unable to write mesh cache file[" << tmpFilename << "]\n";
+      out.close();
+      removeFile(tmpFilename);
+      return false;
+    }
+  }
+
+  if (!moveFile(tmpFilename, cacheFilename))
+  {
+    removeFile(tmpFilename);
+    return false;
+  }
+
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool MeshCachePrivate::Stamp(const std::string &_filename,
+    SourceStamp &_stamp)
+{
+  struct stat st;
+  if (stat(_filename.c_str(), &st) != 0)
+    return false;
+
+  std::ifstream in(_filename, std::ios::in | std::ios::binary);
+  if (!in)
+    return false;
+
+  // FNV-1a hash of the content
+  uint64_t hash = 14695981039346656037ULL;
+  uint64_t size = 0;
+  std::vector<char> chunk(1 << 16);
+  while (in)
+  {
+    in.read(chunk.data(), chunk.size());
+    const std::streamsize count = in.gcount();
+    for (std::streamsize i = 0; i < count; ++i)
+    {
+      hash ^= static_cast<unsigned char>(chunk[i]);
+      hash *= 1099511628211ULL;
+    }
+    size += static_cast<uint64_t>(count);
+  }
+
+  _stamp.path = _filename;
+  _stamp.mtime = static_cast<int64_t>(st.st_mtime);
+  _stamp.size = size;
+  _stamp.hash = hash;
+  return true;
+}
+
+//////////////////////////////////////////////////
+void MeshCachePrivate::WriteMesh(const Mesh &_mesh, CacheWriter &_writer)
+{
+  _writer.WriteString(_mesh.Path());
+
+  _writer.Write<uint32_t>(_mesh.MaterialCount());
+  for (unsigned int i = 0; i < _mesh.MaterialCount(); ++i)
+  {
+    MaterialPtr mat = _mesh.MaterialByIndex(i);
+    _writer.WriteString(mat->TextureImage());
+    for (const auto &color : {mat->Ambient(), mat->Diffuse(),
+        mat->Specular(), mat->Emissive()})
+    {
+      _writer.Write<float>(color.R());
+      _writer.Write<float>(color.G());
+      _writer.Write<float>(color.B());
+      _writer.Write<float>(color.A());
+    }
+    double srcFactor;
+    double dstFactor;
+    mat->BlendFactors(srcFactor, dstFactor);
+    _writer.Write<double>(mat->Transparency());
+    _writer.Write<double>(mat->Shininess());
+    _writer.Write<double>(srcFactor);
+    _writer.Write<double>(dstFactor);
+    _writer.Write<double>(mat->PointSize());
+    _writer.Write<uint32_t>(mat->Blend());
+    _writer.Write<uint32_t>(mat->Shade());
+    _writer.Write<uint8_t>(mat->DepthWrite());
+    _writer.Write<uint8_t>(mat->Lighting());
+  }
+
+  _writer.Write<uint32_t>(_mesh.SubMeshCount());
+  for (unsigned int i = 0; i < _mesh.SubMeshCount(); ++i)
+  {
+    auto subMesh = _mesh.SubMeshByIndex(i).lock();
+    _writer.WriteString(subMesh->Name());
+    _writer.Write<uint32_t>(subMesh->SubMeshPrimitiveType());
+    _writer.Write<uint32_t>(subMesh->MaterialIndex());
+
+    std::vector<double> values;
+    values.reserve(subMesh->VertexCount() * 3);
+    for (unsigned int v = 0; v < subMesh->VertexCount(); ++v)
+    {
+      auto vertex = subMesh->Vertex(v);
+      values.insert(values.end(), {vertex.X(), vertex.Y(), vertex.Z()});
+    }
+    _writer.WriteArray(values);
+
+    values.clear();
+    for (unsigned int n = 0; n < subMesh->NormalCount(); ++n)
+    {
+      auto normal = subMesh->Normal(n);
+      values.insert(values.end(), {normal.X(), normal.Y(), normal.Z()});
+    }
+    _writer.WriteArray(values);
+
+    values.clear();
+    for (unsigned int t = 0; t < subMesh->TexCoordCount(); ++t)
+    {
+      auto uv = subMesh->TexCoord(t);
+      values.insert(values.end(), {uv.X(), uv.Y()});
+    }
+    _writer.WriteArray(values);
+
+    std::vector<uint32_t> indices(subMesh->IndexCount());
+    for (unsigned int n = 0; n < subMesh->IndexCount(); ++n)
+      indices[n] = static_cast<uint32_t>(subMesh->Index(n));
+    _writer.WriteArray(indices);
+
+    _writer.Write<uint64_t>(subMesh->NodeAssignmentsCount());
+    for (unsigned int n = 0; n < subMesh->NodeAssignmentsCount(); ++n)
+    {
+      auto assignment = subMesh->NodeAssignmentByIndex(n);
+      _writer.Write<uint32_t>(assignment.vertexIndex);
+      _writer.Write<uint32_t>(assignment.nodeIndex);
+      _writer.Write<float>(assignment.weight);
+    }
+  }
+
+  _writer.Write<uint8_t>(_mesh.HasSkeleton());
+  if (_mesh.HasSkeleton())
+    WriteSkeleton(*_mesh.MeshSkeleton(), _writer);
+}
+
+//////////////////////////////////////////////////
+void MeshCachePrivate::WriteSkeleton(const Skeleton &_skel,
+    CacheWriter &_writer)
+{
+  // Nodes are written in handle order, which lists parents before their
+  // children, so that the tree and its handles can be rebuilt in order.
+  _writer.Write<uint32_t>(_skel.NodeCount());
+  for (unsigned int i = 0; i < _skel.NodeCount(); ++i)
+  {
+    SkeletonNode *node = _skel.NodeByHandle(i);
+    _writer.Write<int32_t>(node->Parent() ?
+        static_cast<int32_t>(node->Parent()->Handle()) : -1);
+    _writer.WriteString(node->Name());
+    _writer.WriteString(node->Id());
+    _writer.Write<uint8_t>(node->IsJoint());
+    _writer.WriteMatrix(node->Transform());
+    _writer.WriteMatrix(node->InverseBindTransform());
+
+    _writer.Write<uint32_t>(node->RawTransformCount());
+    for (unsigned int t = 0; t < node->RawTransformCount(); ++t)
+    {
+      NodeTransform raw = node->RawTransform(t);
+      _writer.Write<uint32_t>(raw.Type());
+      _writer.WriteString(raw.SID());
+      _writer.WriteMatrix(raw.Get());
+    }
+  }
+
+  _writer.WriteMatrix(_skel.BindShapeTransform());
+
+  _writer.Write<uint32_t>(_skel.NumVertAttached());
+  for (unsigned int v = 0; v < _skel.NumVertAttached(); ++v)
+  {
+    _writer.Write<uint32_t>(_skel.VertNodeWeightCount(v));
+    for (unsigned int w = 0; w < _skel.VertNodeWeightCount(v); ++w)
+    {
+      auto weight = _skel.VertNodeWeight(v, w);
+      _writer.WriteString(weight.first);
+      _writer.Write<double>(weight.second);
+    }
+  }
+
+  _writer.Write<uint32_t>(_skel.AnimationCount());
+  for (unsigned int a = 0; a < _skel.AnimationCount(); ++a)
+  {
+    SkeletonAnimation *anim = _skel.Animation(a);
+    _writer.WriteString(anim->Name());
+    _writer.Write<uint32_t>(anim->Nodes().size());
+    for (const auto &nodeAnim : anim->Nodes())
+    {
+      _writer.WriteString(nodeAnim.first);
+      const auto &frames = nodeAnim.second->KeyFrames();
+      _writer.Write<uint32_t>(frames.size());
+      for (const auto &frame : frames)
+      {
+        _writer.Write<double>(frame.first);
+        _writer.WriteMatrix(frame.second);
+      }
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+std::unique_ptr<Mesh> MeshCachePrivate::ReadMesh(CacheReader &_reader)
+{
+  std::unique_ptr<Mesh> mesh(new Mesh());
+  mesh->SetPath(_reader.ReadString());
+
+  const uint32_t materialCount = _reader.Read<uint32_t>();
+  for (uint32_t i = 0; i < materialCount && _reader.Ok(); ++i)
+  {
+    MaterialPtr mat(new Material());
+    mat->SetTextureImage(_reader.ReadString());
+
+    math::Color colors[4];
+    for (auto &color : colors)
+    {
+      float r = _reader.Read<float>();
+      float g = _reader.Read<float>();
+      float b = _reader.Read<float>();
+      float a = _reader.Read<float>();
+      color.Set(r, g, b, a);
+    }
+    mat->SetAmbient(colors[0]);
+    mat->SetDiffuse(colors[1]);
+    mat->SetSpecular(colors[2]);
+    mat->SetEmissive(colors[3]);
+
+    mat->SetTransparency(_reader.Read<double>());
+    mat->SetShininess(_reader.Read<double>());
+    double srcFactor = _reader.Read<double>();
+    double dstFactor = _reader.Read<double>();
+    mat->SetBlendFactors(srcFactor, dstFactor);
+    mat->SetPointSize(_reader.Read<double>());
+    mat->SetBlend(static_cast<Material::BlendMode>(_reader.Read<uint32_t>()));
+    mat->SetShade(static_cast<Material::ShadeMode>(_reader.Read<uint32_t>()));
+    mat->SetDepthWrite(_reader.Read<uint8_t>() != 0u);
+    mat->SetLighting(_reader.Read<uint8_t>() != 0u);
+    mesh->AddMaterial(mat);
+  }
+
+  const uint32_t subMeshCount = _reader.Read<uint32_t>();
+  std::vector<double> values;
+  std::vector<uint32_t> indices;
+  for (uint32_t i = 0; i < subMeshCount && _reader.Ok(); ++i)
+  {
+    std::unique_ptr<SubMesh> subMesh(new SubMesh(_reader.ReadString()));
+    subMesh->SetPrimitiveType(
+        static_cast<SubMesh::PrimitiveType>(_reader.Read<uint32_t>()));
+    subMesh->SetMaterialIndex(_reader.Read<uint32_t>());
+
+    _reader.ReadArray(values);
+    for (size_t v = 0; v + 2 < values.size(); v += 3)
+      subMesh->AddVertex(values[v], values[v + 1], values[v + 2]);
+
+    _reader.ReadArray(values);
+    for (size_t n = 0; n + 2 < values.size(); n += 3)
+      subMesh->AddNormal(values[n], values[n + 1], values[n + 2]);
+
+    _reader.ReadArray(values);
+    for (size_t t = 0; t + 1 < values.size(); t += 2)
+      subMesh->AddTexCoord(values[t], values[t + 1]);
+
+    _reader.ReadArray(indices);
+    for (auto index : indices)
+      subMesh->AddIndex(index);
+
+    const uint64_t assignmentCount = _reader.Read<uint64_t>();
+    for (uint64_t n = 0; n < assignmentCount && _reader.Ok(); ++n)
+    {
+      uint32_t vertex = _reader.Read<uint32_t>();
+      uint32_t node = _reader.Read<uint32_t>();
+      float weight = _reader.Read<float>();
+      subMesh->AddNodeAssignment(vertex, node, weight);
+    }
+
+    mesh->AddSubMesh(std::move(subMesh));
+  }
+
+  if (_reader.Read<uint8_t>() != 0u)
+  {
+    SkeletonPtr skel = ReadSkeleton(_reader);
+    if (!skel)
+      return nullptr;
+    mesh->SetSkeleton(skel);
+  }
+
+  if (!_reader.Ok())
+    return nullptr;
+
+  return mesh;
+}
+
+//////////////////////////////////////////////////
+SkeletonPtr MeshCachePrivate::ReadSkeleton(CacheReader &_reader)
+{
+  /// \brief A node read from the buffer
+  struct NodeData
+  {
+    /// \brief The node
+    SkeletonNode *node;
+
+    /// \brief Its local transform, set once all nodes are read
+    math::Matrix4d transform;
+  };
+
+  const uint32_t nodeCount = _reader.Read<uint32_t>();
+  std::vector<NodeData> nodes;
+  for (uint32_t i = 0; i < nodeCount && _reader.Ok(); ++i)
+  {
+    int32_t parent = _reader.Read<int32_t>();
+    std::string name = _reader.ReadString();
+    std::string id = _reader.ReadString();
+    bool joint = _reader.Read<uint8_t>() != 0u;
+
+    // Only the first node is a root, and parents come before children
+    if ((i == 0u) != (parent < 0) || parent >= static_cast<int32_t>(i))
+    {
+      for (auto &data : nodes)
+        delete data.node;
+      return nullptr;
+    }
+
+    NodeData data;
+    data.node = new SkeletonNode(parent < 0 ? nullptr : nodes[parent].node,
+        name, id, joint ? SkeletonNode::JOINT : SkeletonNode::NODE);
+    data.transform = _reader.ReadMatrix();
+    data.node->SetInverseBindTransform(_reader.ReadMatrix());
+
+    const uint32_t rawCount = _reader.Read<uint32_t>();
+    for (uint32_t t = 0; t < rawCount && _reader.Ok(); ++t)
+    {
+      auto type = static_cast<NodeTransformType>(_reader.Read<uint32_t>());
+      std::string sid = _reader.ReadString();
+      data.node->AddRawTransform(
+          NodeTransform(_reader.ReadMatrix(), sid, type));
+    }
+    nodes.push_back(data);
+  }
+
+  if (nodes.empty())
+    return nullptr;
+
+  SkeletonPtr skel(new Skeleton(nodes.front().node));
+
+  // Model transforms are computed from the local transforms, parents first
+  for (auto &data : nodes)
+    data.node->SetTransform(data.transform, false);
+
+  skel->SetBindShapeTransform(_reader.ReadMatrix());
+
+  const uint32_t vertexCount = _reader.Read<uint32_t>();
+  if (!_reader.Ok())
+    return nullptr;
+  skel->SetNumVertAttached(vertexCount);
+  for (uint32_t v = 0; v < vertexCount && _reader.Ok(); ++v)
+  {
+    const uint32_t weightCount = _reader.Read<uint32_t>();
+    for (uint32_t w = 0; w < weightCount && _reader.Ok(); ++w)
+    {
+      std::string node = _reader.ReadString();
+      skel->AddVertNodeWeight(v, node, _reader.Read<double>());
+    }
+  }
+
+  const uint32_t animCount = _reader.Read<uint32_t>();
+  for (uint32_t a = 0; a < animCount && _reader.Ok(); ++a)
+  {
+    SkeletonAnimation *anim = new SkeletonAnimation(_reader.ReadString());
+    const uint32_t animNodeCount = _reader.Read<uint32_t>();
+    for (uint32_t n = 0; n < animNodeCount && _reader.Ok(); ++n)
+    {
+      std::string node = _reader.ReadString();
+      const uint32_t frameCount = _reader.Read<uint32_t>();
+      for (uint32_t f = 0; f < frameCount && _reader.Ok(); ++f)
+      {
+        double time = _reader.Read<double>();
+        anim->AddKeyFrame(node, time, _reader.ReadMatrix());
+      }
+    }
+    skel->AddAnimation(anim);
+  }
+
+  if (!_reader.Ok())
+    return nullptr;
+
+  return skel;
+}
@@ -0,0 +1,321 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <memory>
+#include <string>
+
+#include "test_config.h"
+#include "ignition/common/ColladaLoader.hh"
+#include "ignition/common/ConvexDecomposition.hh"
+#include "ignition/common/Filesystem.hh"
+#include "ignition/common/Material.hh"
+#include "ignition/common/Mesh.hh"
+#include "ignition/common/MeshCache.hh"
+#include "ignition/common/MeshManager.hh"
+#include "ignition/common/Skeleton.hh"
+#include "ignition/common/SkeletonAnimation.hh"
+#include "ignition/common/SkeletonNode.hh"
+#include "ignition/common/SubMesh.hh"
+#include "test/util.hh"
+
+using namespace ignition;
+
+class MeshCacheTest : public ignition::testing::AutoLogFixture
+{
+  /// \brief Create an empty cache directory
+  protected: void SetUp() override
+  {
+    ignition::testing::AutoLogFixture::SetUp();
+    this->cachePath = common::joinPaths(common::cwd(), "tmp", "mesh_cache");
+    if (common::exists(this->cachePath))
+      common::removeAll(this->cachePath);
+  }
+
+  /// \brief Cache directory
+  protected: std::string cachePath;
+};
+
+/////////////////////////////////////////////////
+TEST_F(MeshCacheTest, Path)
+{
+  common::MeshCache cache(this->cachePath);
+  EXPECT_EQ(this->cachePath, cache.Path());
+
+  std::string filename = common::joinPaths(PROJECT_SOURCE_PATH, "test",
+      "data", "box.dae");
+  EXPECT_EQ(this->cachePath, cache.CacheFilename(filename).substr(0,
+      this->cachePath.size()));
+  EXPECT_NE(cache.CacheFilename(filename), cache.CacheFilename(
+      common::joinPaths(PROJECT_SOURCE_PATH, "test", "data", "box.obj")));
+
+  // Nothing is cached yet
+  EXPECT_EQ(nullptr, cache.Load(filename));
+  EXPECT_FALSE(common::exists(this->cachePath));
+}
+
+/////////////////////////////////////////////////
+TEST_F(MeshCacheTest, SaveLoad)
+{
+  std::string filename = common::joinPaths(PROJECT_SOURCE_PATH, "test",
+      "data", "box_with_animation_outside_skeleton.dae");
+
+  common::ColladaLoader loader;
+  std::unique_ptr<common::Mesh> source(loader.Load(filename));
+  ASSERT_NE(nullptr, source);
+
+  common::MeshCache cache(this->cachePath);
+  EXPECT_TRUE(cache.Save(*source, filename));
+  EXPECT_TRUE(common::exists(cache.CacheFilename(filename)));
+
+  std::unique_ptr<common::Mesh> mesh(cache.Load(filename));
+  ASSERT_NE(nullptr, mesh);
+
+  EXPECT_EQ(source->Path(), mesh->Path());
+  EXPECT_EQ(source->Min(), mesh->Min());
+  EXPECT_EQ(source->Max(), mesh->Max());
+
+  ASSERT_EQ(source->MaterialCount(), mesh->MaterialCount());
+  for (unsigned int i = 0; i < source->MaterialCount(); ++i)
+  {
+    auto sourceMat = source->MaterialByIndex(i);
+    auto mat = mesh->MaterialByIndex(i);
+    EXPECT_EQ(sourceMat->TextureImage(), mat->TextureImage());
+    EXPECT_EQ(sourceMat->Ambient(), mat->Ambient());
+    EXPECT_EQ(sourceMat->Diffuse(), mat->Diffuse());
+    EXPECT_EQ(sourceMat->Specular(), mat->Specular());
+    EXPECT_EQ(sourceMat->Emissive(), mat->Emissive());
+    EXPECT_DOUBLE_EQ(sourceMat->Transparency(), mat->Transparency());
+    EXPECT_DOUBLE_EQ(sourceMat->Shininess(), mat->Shininess());
+    EXPECT_EQ(sourceMat->Blend(), mat->Blend());
+    EXPECT_EQ(sourceMat->Shade(), mat->Shade());
+    EXPECT_EQ(sourceMat->Lighting(), mat->Lighting());
+    EXPECT_EQ(sourceMat->DepthWrite(), mat->DepthWrite());
+  }
+
+  ASSERT_EQ(source->SubMeshCount(), mesh->SubMeshCount());
+  for (unsigned int i = 0; i < source->SubMeshCount(); ++i)
+  {
+    auto sourceSubMesh = source->SubMeshByIndex(i).lock();
+    auto subMesh = mesh->SubMeshByIndex(i).lock();
+    EXPECT_EQ(sourceSubMesh->Name(), subMesh->Name());
+    EXPECT_EQ(sourceSubMesh->SubMeshPrimitiveType(),
+        subMesh->SubMeshPrimitiveType());
+    EXPECT_EQ(sourceSubMesh->MaterialIndex(), subMesh->MaterialIndex());
+
+    ASSERT_EQ(sourceSubMesh->VertexCount(), subMesh->VertexCount());
+    ASSERT_EQ(sourceSubMesh->NormalCount(), subMesh->NormalCount());
+    ASSERT_EQ(sourceSubMesh->TexCoordCount(), subMesh->TexCoordCount());
+    ASSERT_EQ(sourceSubMesh->IndexCount(), subMesh->IndexCount());
+    ASSERT_EQ(sourceSubMesh->NodeAssignmentsCount(),
+        subMesh->NodeAssignmentsCount());
+    for (unsigned int v = 0; v < subMesh->VertexCount(); ++v)
+      EXPECT_EQ(sourceSubMesh->Vertex(v), subMesh->Vertex(v));
+    for (unsigned int n = 0; n < subMesh->NormalCount(); ++n)
+      EXPECT_EQ(sourceSubMesh->Normal(n), subMesh->Normal(n));
+    for (unsigned int t = 0; t < subMesh->TexCoordCount(); ++t)
+      EXPECT_EQ(sourceSubMesh->TexCoord(t), subMesh->TexCoord(t));
+    for (unsigned int n = 0; n < subMesh->IndexCount(); ++n)
+      EXPECT_EQ(sourceSubMesh->Index(n), subMesh->Index(n));
+    for (unsigned int n = 0; n < subMesh->NodeAssignmentsCount(); ++n)
+    {
+      auto sourceAssignment = sourceSubMesh->NodeAssignmentByIndex(n);
+      auto assignment = subMesh->NodeAssignmentByIndex(n);
+      EXPECT_EQ(sourceAssignment.vertexIndex, assignment.vertexIndex);
+      EXPECT_EQ(sourceAssignment.nodeIndex, assignment.nodeIndex);
+      EXPECT_FLOAT_EQ(sourceAssignment.weight, assignment.weight);
+    }
+  }
+
+  ASSERT_TRUE(mesh->HasSkeleton());
+  auto sourceSkel = source->MeshSkeleton();
+  auto skel = mesh->MeshSkeleton();
+  EXPECT_EQ(sourceSkel->BindShapeTransform(), skel->BindShapeTransform());
+  ASSERT_EQ(sourceSkel->NodeCount(), skel->NodeCount());
+  for (unsigned int i = 0; i < skel->NodeCount(); ++i)
+  {
+    auto sourceNode = sourceSkel->NodeByHandle(i);
+    auto node = skel->NodeByHandle(i);
+    EXPECT_EQ(sourceNode->Name(), node->Name());
+    EXPECT_EQ(sourceNode->Id(), node->Id());
+    EXPECT_EQ(sourceNode->IsJoint(), node->IsJoint());
+    EXPECT_EQ(sourceNode->ChildCount(), node->ChildCount());
+    EXPECT_EQ(sourceNode->Transform(), node->Transform());
+    EXPECT_EQ(sourceNode->ModelTransform(), node->ModelTransform());
+    EXPECT_EQ(sourceNode->InverseBindTransform(),
+        node->InverseBindTransform());
+    EXPECT_EQ(sourceNode->RawTransformCount(), node->RawTransformCount());
+  }
+
+  ASSERT_EQ(sourceSkel->NumVertAttached(), skel->NumVertAttached());
+  for (unsigned int v = 0; v < skel->NumVertAttached(); ++v)
+  {
+    ASSERT_EQ(sourceSkel->VertNodeWeightCount(v), skel->VertNodeWeightCount(v));
+    for (unsigned int w = 0; w < skel->VertNodeWeightCount(v); ++w)
+      EXPECT_EQ(sourceSkel->VertNodeWeight(v, w), skel->VertNodeWeight(v, w));
+  }
+
+  ASSERT_EQ(sourceSkel->AnimationCount(), skel->AnimationCount());
+  for (unsigned int a = 0; a < skel->AnimationCount(); ++a)
+  {
+    auto sourceAnim = sourceSkel->Animation(a);
+    auto anim = skel->Animation(a);
+    EXPECT_EQ(sourceAnim->Name(), anim->Name());
+    EXPECT_DOUBLE_EQ(sourceAnim->Length(), anim->Length());
+    EXPECT_EQ(sourceAnim->NodeCount(), anim->NodeCount());
+    EXPECT_EQ(sourceAnim->PoseAt(0.5, true), anim->PoseAt(0.5, true));
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(MeshCacheTest, Invalidate)
+{
+  // Work on a copy of the source mesh, which is modified below
+  std::string filename = common::joinPaths(this->cachePath, "box.dae");
+  common::createDirectories(this->cachePath);
+  ASSERT_TRUE(common::copyFile(common::joinPaths(PROJECT_SOURCE_PATH,
+      "test", "data", "box.dae"), filename));
+
+  common::ColladaLoader loader;
+  std::unique_ptr<common::Mesh> source(loader.Load(filename));
+  ASSERT_NE(nullptr, source);
+
+  common::MeshCache cache(this->cachePath);
+  ASSERT_TRUE(cache.Save(*source, filename));
+  std::unique_ptr<common::Mesh> mesh(cache.Load(filename));
+  ASSERT_NE(nullptr, mesh);
+  EXPECT_EQ(source->VertexCount(), mesh->VertexCount());
+
+  // A different source path doesn't match the cached mesh
+  std::string otherFilename = common::joinPaths(this->cachePath, "other.dae");
+  ASSERT_TRUE(common::copyFile(filename, otherFilename));
+  EXPECT_EQ(nullptr, cache.Load(otherFilename));
+
+  // A truncated cache file is ignored
+  std::string cacheFilename = cache.CacheFilename(filename);
+  std::string content;
+  {
+    std::ifstream in(cacheFilename, std::ios::binary);
+    content.assign(std::istreambuf_iterator<char>(in),
+        std::istreambuf_iterator<char>());
+  }
+  {
+    std::ofstream out(cacheFilename, std::ios::binary | std::ios::trunc);
+    out << content.substr(0, content.size() / 2);
+  }
+  EXPECT_EQ(nullptr, cache.Load(filename));
+  {
+    std::ofstream out(cacheFilename, std::ios::binary | std::ios::trunc);
+    out << content;
+  }
+  mesh.reset(cache.Load(filename));
+  EXPECT_NE(nullptr, mesh);
+
+  // Modifying the source invalidates the cached mesh
+  {
+    std::ofstream out(filename, std::ios::app);
+    out << "<!-- modified -->\n";
+  }
+  EXPECT_EQ(nullptr, cache.Load(filename));
+}
+
+/////////////////////////////////////////////////
+TEST_F(MeshCacheTest, Variant)
+{
+  std::string filename = common::joinPaths(this->cachePath, "box.dae");
+  common::createDirectories(this->cachePath);
+  ASSERT_TRUE(common::copyFile(common::joinPaths(PROJECT_SOURCE_PATH,
+      "test", "data", "box.dae"), filename));
+
+  common::ColladaLoader loader;
+  std::unique_ptr<common::Mesh> source(loader.Load(filename));
+  ASSERT_NE(nullptr, source);
+
+  common::Mesh derived;
+  derived.SetName("derived");
+  common::SubMesh subMesh(*source->SubMeshByIndex(0).lock());
+  subMesh.Scale(2.0);
+  derived.AddSubMesh(subMesh);
+
+  common::MeshCache cache(this->cachePath);
+  EXPECT_NE(cache.CacheFilename(filename),
+      cache.CacheFilename(filename, "scaled"));
+
+  // Variants are cached separately from the source mesh
+  ASSERT_TRUE(cache.Save(derived, filename, "scaled"));
+  EXPECT_TRUE(common::exists(cache.CacheFilename(filename, "scaled")));
+  EXPECT_EQ(nullptr, cache.Load(filename));
+  EXPECT_EQ(nullptr, cache.Load(filename, "other"));
+  std::unique_ptr<common::Mesh> mesh(cache.Load(filename, "scaled"));
+  ASSERT_NE(nullptr, mesh);
+  EXPECT_EQ(derived.Max(), mesh->Max());
+
+  // and invalidated with it
+  {
+    std::ofstream out(filename, std::ios::app);
+    out << "<!-- modified -->\n";
+  }
+  EXPECT_EQ(nullptr, cache.Load(filename, "scaled"));
+}
+
+/////////////////////////////////////////////////
+TEST_F(MeshCacheTest, MeshManager)
+{
+  auto meshManager = common::MeshManager::Instance();
+
+  const std::string previousPath = meshManager->CachePath();
+  meshManager->SetCachePath(this->cachePath);
+  EXPECT_EQ(this->cachePath, meshManager->CachePath());
+
+  std::string filename = common::joinPaths(PROJECT_SOURCE_PATH, "test",
+      "data", "box.obj");
+  const common::Mesh *mesh = meshManager->Load(filename);
+  ASSERT_NE(nullptr, mesh);
+
+  common::MeshCache cache(this->cachePath);
+  EXPECT_TRUE(common::exists(cache.CacheFilename(filename)));
+  std::unique_ptr<common::Mesh> cached(cache.Load(filename));
+  ASSERT_NE(nullptr, cached);
+  EXPECT_EQ(mesh->VertexCount(), cached->VertexCount());
+  EXPECT_EQ(mesh->IndexCount(), cached->IndexCount());
+
+  // Convex decompositions are cached as variants of the mesh
+  const common::Mesh *hulls = meshManager->LoadConvexDecomposition(filename,
+      4);
+  ASSERT_NE(nullptr, hulls);
+  EXPECT_EQ(hulls, meshManager->LoadConvexDecomposition(filename, 4));
+  EXPECT_EQ(hulls, meshManager->MeshByName(hulls->Name()));
+  common::ConvexDecomposition decomposition;
+  decomposition.SetMaxConvexHulls(4);
+  EXPECT_EQ(filename + "#" + decomposition.CacheVariant(), hulls->Name());
+  cached.reset(cache.Load(filename, decomposition.CacheVariant()));
+  ASSERT_NE(nullptr, cached);
+  EXPECT_EQ(hulls->SubMeshCount(), cached->SubMeshCount());
+
+  meshManager->SetCachePath("");
+  EXPECT_TRUE(meshManager->CachePath().empty());
+  meshManager->SetCachePath(previousPath);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -17,8 +17,10 @@
 
 #include <sys/stat.h>
 #include <string>
+#include <future>
 #include <mutex>
 #include <map>
+#include <memory>
 #include <cctype>
 
 #ifndef _WIN32
@@ -27,12 +29,17 @@
 #endif
 
 #include "ignition/common/Console.hh"
+#include "ignition/common/ConvexDecomposition.hh"
 #include "ignition/common/Mesh.hh"
+#include "ignition/common/MeshCache.hh"
+#include "ignition/common/MeshSimplifier.hh"
 #include "ignition/common/SubMesh.hh"
 #include "ignition/common/ColladaLoader.hh"
 #include "ignition/common/ColladaExporter.hh"
 #include "ignition/common/OBJLoader.hh"
 #include "ignition/common/STLLoader.hh"
+#include "ignition/common/Util.hh"
+#include "ignition/common/WorkerPool.hh"
 #include "ignition/common/config.hh"
 
 #include "ignition/common/MeshManager.hh"
@@ -46,25 +53,50 @@ class ignition::common::MeshManagerPrivate
 #pragma warning(push)
 #pragma warning(disable: 4251)
 #endif
-  /// \brief 3D mesh loader for COLLADA files
-  public: ColladaLoader colladaLoader;
+  /// \brief Get a loaded mesh or the mesh being loaded from a file, or
+  /// claim the file to load it. Must be called with the mutex locked.
+  /// \param[in] _filename Name of the mesh file.
+  /// \param[out] _future Future holding the mesh.
+  /// \return A promise to fulfil with LoadFile if the caller must load the
+  /// mesh, or null if the mesh is loaded or being loaded.
+  public: std::shared_ptr<std::promise<const Mesh *>> Claim(
+      const std::string &_filename,
+      std::shared_future<const Mesh *> &_future);
+
+  /// \brief Load a mesh claimed with Claim, add it to the meshes and
+  /// fulfil its promise. Must be called with the mutex unlocked.
+  /// \param[in] _filename Name of the mesh file.
+  /// \param[in] _promise Promise returned by Claim.
+  /// \return The mesh, or nullptr if it couldn't be loaded.
+  public: const Mesh *LoadFile(const std::string &_filename,
+      std::promise<const Mesh *> &_promise);
+
+  /// \brief Add a mesh unless there is already a mesh with that name.
+  /// \param[in] _name Name of the mesh.
+  /// \param[in] _mesh The mesh, owned by the manager from now on.
+  public: void AddMesh(const std::string &_name, Mesh *_mesh);
 
   /// \brief 3D mesh exporter for COLLADA files
   public: ColladaExporter colladaExporter;
 
-  /// \brief 3D mesh loader for STL files
-  public: STLLoader stlLoader;
-
-  /// \brief 3D mesh loader for OBJ files
-  public: OBJLoader objLoader;
+  /// \brief On-disk cache of meshes loaded from files, null if disabled.
+  /// Shared with the loads in progress.
+  public: std::shared_ptr<MeshCache> cache;
 
   /// \brief Dictionary of meshes, indexed by name
   public: std::map<std::string, Mesh*> meshes;
 
+  /// \brief Meshes being loaded from files, indexed by name
+  public: std::map<std::string, std::shared_future<const Mesh *>> loading;
+
+  /// \brief Threads loading meshes for LoadAsync, created on first use
+  public: std::unique_ptr<WorkerPool> pool;
+
   /// \brief supported file extensions for meshes
   public: std::vector<std::string> fileExtensions;
 
-  /// \brief Mutex to protect the mesh map
+  /// \brief Mutex to protect the mesh map, the meshes being loaded and the
+  /// cache
   public: std::mutex mutex;
 #ifdef _WIN32
 #pragma warning(pop)
@@ -100,11 +132,18 @@ MeshManager::MeshManager()
   this->dataPtr->fileExtensions.push_back("stl");
   this->dataPtr->fileExtensions.push_back("dae");
   this->dataPtr->fileExtensions.push_back("obj");
+
+  std::string cachePath;
+  if (env("IGN_MESH_CACHE_PATH", cachePath) && !cachePath.empty())
+    this->SetCachePath(cachePath);
 }
 
 //////////////////////////////////////////////////
 MeshManager::~MeshManager()
 {
+  // Stop the loads in progress before deleting the meshes
+  this->dataPtr->pool.reset();
+
   for (auto iter = this->dataPtr->meshes.begin();
       iter != this->dataPtr->meshes.end(); ++iter)
     delete iter->second;
@@ -120,60 +159,294 @@ const Mesh *MeshManager::Load(const std::string &_filename)
     return nullptr;
   }
 
-  Mesh *mesh = nullptr;
+  std::shared_future<const Mesh *> future;
+  std::shared_ptr<std::promise<const Mesh *>> promise;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    promise = this->dataPtr->Claim(_filename, future);
+  }
 
-  std::string extension;
+  // Load the mesh on this thread, unless another thread is already
+  // loading it, in which case wait for it.
+  if (promise)
+    return this->dataPtr->LoadFile(_filename, *promise);
+
+  return future.get();
+}
+
+//////////////////////////////////////////////////
+std::shared_future<const Mesh *> MeshManager::LoadAsync(
+    const std::string &_filename)
+{
+  if (!this->IsValidFilename(_filename))
+  {
+    ignerr << "Invalid mesh filename extension[" << _filename << "]\n";
+    std::promise<const Mesh *> promise;
+    promise.set_value(nullptr);
+    return promise.get_future().share();
+  }
+
+  std::shared_future<const Mesh *> future;
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  auto promise = this->dataPtr->Claim(_filename, future);
+  if (promise)
+  {
+    if (!this->dataPtr->pool)
+      this->dataPtr->pool.reset(new WorkerPool());
+
+    MeshManagerPrivate *dataPtr = this->dataPtr.get();
+    this->dataPtr->pool->AddWork([dataPtr, _filename, promise]()
+        {
+          dataPtr->LoadFile(_filename, *promise);
+        });
+  }
+
+  return future;
+}
+
+//////////////////////////////////////////////////
+const Mesh *MeshManager::LoadConvexDecomposition(const std::string &_filename,
+    const unsigned int _maxConvexHulls)
+{
+  ConvexDecomposition decomposition;
+  decomposition.SetMaxConvexHulls(_maxConvexHulls);
+  const std::string variant = decomposition.CacheVariant();
+  const std::string name = _filename + "#" + variant;
+
+  std::shared_future<const Mesh *> future;
+  std::shared_ptr<std::promise<const Mesh *>> promise;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    promise = this->dataPtr->Claim(name, future);
+  }
+
+  if (!promise)
+    return future.get();
+
+  Mesh *result = nullptr;
+  const Mesh *mesh = this->Load(_filename);
+  if (mesh)
+  {
+    std::shared_ptr<MeshCache> meshCache;
+    {
+      std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+      meshCache = this->dataPtr->cache;
+    }
+
+    const std::string fullname = common::findFile(_filename);
+    if (meshCache)
+      result = meshCache->Load(fullname, variant);
+
+    if (!result && (result = decomposition.Decompose(*mesh)) != nullptr &&
+        meshCache)
+    {
+      meshCache->Save(*result, fullname, variant);
+    }
+
+    if (!result)
+      ignerr << "Unable to decompose mesh[" << _filename << "]\n";
+  }
+
+  if (result)
+    result->SetName(name);
+
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    if (result)
+      this->dataPtr->meshes.insert(std::make_pair(name, result));
+    this->dataPtr->loading.erase(name);
+  }
+  promise->set_value(result);
+
+  return result;
+}
+
+//////////////////////////////////////////////////
+const Mesh *MeshManager::LoadSimplified(const std::string &_filename,
+    const unsigned int _maxTriangles)
+{
+  const std::string variant = "simplified_" + std::to_string(_maxTriangles);
+  const std::string name = _filename + "#" + variant;
+
+  std::shared_future<const Mesh *> future;
+  std::shared_ptr<std::promise<const Mesh *>> promise;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    promise = this->dataPtr->Claim(name, future);
+  }
+
+  if (!promise)
+    return future.get();
+
+  Mesh *result = nullptr;
+  const Mesh *mesh = this->Load(_filename);
+  const unsigned int triangleCount = mesh ? mesh->IndexCount() / 3 : 0u;
+
+  // Small enough meshes are used as they are. They aren't kept under the
+  // simplified name, since they are owned by their own entry.
+  if (mesh && triangleCount <= _maxTriangles)
+  {
+    {
+      std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+      this->dataPtr->loading.erase(name);
+    }
+    promise->set_value(mesh);
+    return mesh;
+  }
+
+  if (mesh)
+  {
+    std::shared_ptr<MeshCache> meshCache;
+    {
+      std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+      meshCache = this->dataPtr->cache;
+    }
+
+    const std::string fullname = common::findFile(_filename);
+    if (meshCache)
+      result = meshCache->Load(fullname, variant);
+
+    if (!result)
+    {
+      MeshSimplifier simplifier;
+      result = simplifier.Simplify(*mesh,
+          static_cast<double>(_maxTriangles) / triangleCount);
+
+      igndbg << "Simplified mesh[" << _filename << "] from ["
+             << triangleCount << "] to [" << result->IndexCount() / 3
+             << "] triangles\n";
+
+      if (meshCache)
+        meshCache->Save(*result, fullname, variant);
+    }
+  }
+
+  if (result)
+    result->SetName(name);
+
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    if (result)
+      this->dataPtr->meshes.insert(std::make_pair(name, result));
+    this->dataPtr->loading.erase(name);
+  }
+  promise->set_value(result);
+
+  return result;
+}
+
+//////////////////////////////////////////////////
+std::shared_ptr<std::promise<const Mesh *>> MeshManagerPrivate::Claim(
+    const std::string &_filename, std::shared_future<const Mesh *> &_future)
+{
+  auto meshIt = this->meshes.find(_filename);
+  if (meshIt != this->meshes.end())
+  {
+    std::promise<const Mesh *> loaded;
+    loaded.set_value(meshIt->second);
+    _future = loaded.get_future().share();
+    return nullptr;
+  }
 
-  if (this->HasMesh(_filename))
+  auto loadingIt = this->loading.find(_filename);
+  if (loadingIt != this->loading.end())
   {
-    return this->dataPtr->meshes[_filename];
+    _future = loadingIt->second;
+    return nullptr;
   }
 
+  auto promise = std::make_shared<std::promise<const Mesh *>>();
+  _future = promise->get_future().share();
+  this->loading[_filename] = _future;
+  return promise;
+}
+
+//////////////////////////////////////////////////
+const Mesh *MeshManagerPrivate::LoadFile(const std::string &_filename,
+    std::promise<const Mesh *> &_promise)
+{
+  Mesh *mesh = nullptr;
+
   std::string fullname = common::findFile(_filename);
 
   if (!fullname.empty())
   {
-    extension = fullname.substr(fullname.rfind(".")+1, fullname.size());
+    std::string extension =
+        fullname.substr(fullname.rfind(".")+1, fullname.size());
     std::transform(extension.begin(), extension.end(),
         extension.begin(), ::tolower);
-    MeshLoader *loader = nullptr;
 
+    // Loaders keep state while loading, so each load uses its own loader
+    // to let different meshes load in parallel.
+    std::unique_ptr<MeshLoader> loader;
     if (extension == "stl" || extension == "stlb" || extension == "stla")
-      loader = &this->dataPtr->stlLoader;
+      loader.reset(new STLLoader());
     else if (extension == "dae")
-      loader = &this->dataPtr->colladaLoader;
+      loader.reset(new ColladaLoader());
     else if (extension == "obj")
-      loader = &this->dataPtr->objLoader;
+      loader.reset(new OBJLoader());
     else
-    {
       ignerr << "Unsupported mesh format for file[" << _filename << "]\n";
-      return nullptr;
-    }
 
-    // This mutex prevents two threads from loading the same mesh at the
-    // same time.
-    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
-    if (!this->HasMesh(_filename))
+    std::shared_ptr<MeshCache> meshCache;
     {
-      if ((mesh = loader->Load(fullname)) != nullptr)
-      {
-        mesh->SetName(_filename);
-        this->dataPtr->meshes.insert(std::make_pair(_filename, mesh));
-      }
-      else
-        ignerr << "Unable to load mesh[" << fullname << "]\n";
+      std::lock_guard<std::mutex> lock(this->mutex);
+      meshCache = this->cache;
     }
-    else
+
+    if (loader)
     {
-      mesh = this->dataPtr->meshes[_filename];
+      if (meshCache)
+        mesh = meshCache->Load(fullname);
+
+      if (!mesh && (mesh = loader->Load(fullname)) != nullptr && meshCache)
+        meshCache->Save(*mesh, fullname);
+
+      if (!mesh)
+        ignerr << "Unable to load mesh[" << fullname << "]\n";
     }
   }
   else
     ignerr << "Unable to find file[" << _filename << "]\n";
 
+  if (mesh)
+    mesh->SetName(_filename);
+
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    if (mesh)
+      this->meshes.insert(std::make_pair(_filename, mesh));
+    this->loading.erase(_filename);
+  }
+  _promise.set_value(mesh);
+
   return mesh;
 }
 
+//////////////////////////////////////////////////
+void MeshManagerPrivate::AddMesh(const std::string &_name, Mesh *_mesh)
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  this->meshes.insert(std::make_pair(_name, _mesh));
+}
+
+//////////////////////////////////////////////////
+void MeshManager::SetCachePath(const std::string &_path)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  if (_path.empty())
+    this->dataPtr->cache.reset();
+  else
+    this->dataPtr->cache.reset(new MeshCache(_path));
+}
+
+//////////////////////////////////////////////////
+std::string MeshManager::CachePath() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->cache ? this->dataPtr->cache->Path() : "";
+}
+
 //////////////////////////////////////////////////
 void MeshManager::Export(const Mesh *_mesh, const std::string &_filename,
     const std::string &_extension, bool _exportTextures)
@@ -209,28 +482,32 @@ void MeshManager::MeshAABB(const Mesh *_mesh,
     ignition::math::Vector3d &_center,
     ignition::math::Vector3d &_minXYZ, ignition::math::Vector3d &_maxXYZ)
 {
-  if (this->HasMesh(_mesh->Name()))
-    this->dataPtr->meshes[_mesh->Name()]->AABB(_center, _minXYZ, _maxXYZ);
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  auto iter = this->dataPtr->meshes.find(_mesh->Name());
+  if (iter != this->dataPtr->meshes.end())
+    iter->second->AABB(_center, _minXYZ, _maxXYZ);
 }
 
 //////////////////////////////////////////////////
 void MeshManager::GenSphericalTexCoord(const Mesh *_mesh,
     const ignition::math::Vector3d &_center)
 {
-  if (this->HasMesh(_mesh->Name()))
-    this->dataPtr->meshes[_mesh->Name()]->GenSphericalTexCoord(_center);
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  auto iter = this->dataPtr->meshes.find(_mesh->Name());
+  if (iter != this->dataPtr->meshes.end())
+    iter->second->GenSphericalTexCoord(_center);
 }
 
 //////////////////////////////////////////////////
 void MeshManager::AddMesh(Mesh *_mesh)
 {
-  if (!this->HasMesh(_mesh->Name()))
-    this->dataPtr->meshes[_mesh->Name()] = _mesh;
+  this->dataPtr->AddMesh(_mesh->Name(), _mesh);
 }
 
 //////////////////////////////////////////////////
 const Mesh *MeshManager::MeshByName(const std::string &_name) const
 {
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
   std::map<std::string, Mesh*>::const_iterator iter;
 
   iter = this->dataPtr->meshes.find(_name);
@@ -247,6 +524,7 @@ bool MeshManager::HasMesh(const std::string &_name) const
   if (_name.empty())
     return false;
 
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
   std::map<std::string, Mesh*>::const_iterator iter;
   iter = this->dataPtr->meshes.find(_name);
 
@@ -270,7 +548,7 @@ void MeshManager::CreateSphere(const std::string &name, float radius,
 
   Mesh *mesh = new Mesh();
   mesh->SetName(name);
-  this->dataPtr->meshes.insert(std::make_pair(name, mesh));
+  this->dataPtr->AddMesh(name, mesh);
 
   SubMesh subMesh;
 
@@ -338,7 +616,7 @@ void MeshManager::CreatePlane(const std::string &_name,
 
   Mesh *mesh = new Mesh();
   mesh->SetName(_name);
-  this->dataPtr->meshes.insert(std::make_pair(_name, mesh));
+  this->dataPtr->AddMesh(_name, mesh);
 
   SubMesh subMesh;
 
@@ -424,7 +702,7 @@ void MeshManager::CreateBox(const std::string &_name,
 
   Mesh *mesh = new Mesh();
   mesh->SetName(_name);
-  this->dataPtr->meshes.insert(std::make_pair(_name, mesh));
+  this->dataPtr->AddMesh(_name, mesh);
 
   SubMesh subMesh;
 
@@ -720,7 +998,7 @@ void MeshManager::CreateExtrudedPolyline(const std::string &_name,
   }
 
   mesh->AddSubMesh(subMesh);
-  this->dataPtr->meshes.insert(std::make_pair(_name, mesh));
+  this->dataPtr->AddMesh(_name, mesh);
 #endif
   return;
 }
@@ -737,7 +1015,7 @@ void MeshManager::CreateCamera(const std::string &_name, float _scale)
 
   Mesh *mesh = new Mesh();
   mesh->SetName(_name);
-  this->dataPtr->meshes.insert(std::make_pair(_name, mesh));
+  this->dataPtr->AddMesh(_name, mesh);
 
   SubMesh subMesh;
 
@@ -838,7 +1116,7 @@ void MeshManager::CreateCylinder(const std::string &name, float radius,
 
   Mesh *mesh = new Mesh();
   mesh->SetName(name);
-  this->dataPtr->meshes.insert(std::make_pair(name, mesh));
+  this->dataPtr->AddMesh(name, mesh);
 
   SubMesh subMesh;
 
@@ -955,7 +1233,7 @@ void MeshManager::CreateCone(const std::string &name, float radius,
 
   Mesh *mesh = new Mesh();
   mesh->SetName(name);
-  this->dataPtr->meshes.insert(std::make_pair(name, mesh));
+  this->dataPtr->AddMesh(name, mesh);
 
   SubMesh subMesh;
 
@@ -1072,7 +1350,7 @@ void MeshManager::CreateTube(const std::string &_name, float _innerRadius,
 
   Mesh *mesh = new Mesh();
   mesh->SetName(_name);
-  this->dataPtr->meshes.insert(std::make_pair(_name, mesh));
+  this->dataPtr->AddMesh(_name, mesh);
   SubMesh subMesh;
 
   // Generate the group of rings for the outsides of the cylinder
@@ -1293,7 +1571,7 @@ void MeshManager::CreateBoolean(const std::string &_name, const Mesh *_m1,
   MeshCSG csg;
   Mesh *mesh = csg.CreateBoolean(_m1, _m2, _operation, _offset);
   mesh->SetName(_name);
-  this->dataPtr->meshes.insert(std::make_pair(_name, mesh));
+  this->dataPtr->AddMesh(_name, mesh);
 #endif
 }
 
@@ -17,6 +17,11 @@
 
 #include <gtest/gtest.h>
 
+#include <future>
+#include <string>
+#include <thread>
+#include <vector>
+
 #include "test_config.h"
 #include "ignition/common/Mesh.hh"
 #include "ignition/common/SubMesh.hh"
@@ -268,6 +273,130 @@ TEST_F(MeshManager, CreateExtrudedPolylineInvalid)
   EXPECT_TRUE(!common::MeshManager::Instance()->HasMesh(meshName));
 }
 
+/////////////////////////////////////////////////
+TEST_F(MeshManager, LoadAsync)
+{
+  auto meshManager = common::MeshManager::Instance();
+
+  const std::string box = std::string(PROJECT_SOURCE_PATH) +
+      "/test/data/box.dae";
+  const std::string drill = std::string(PROJECT_SOURCE_PATH) +
+      "/test/data/cordless_drill/meshes/cordless_drill.dae";
+
+  auto boxFuture = meshManager->LoadAsync(box);
+  auto drillFuture = meshManager->LoadAsync(drill);
+
+  // Loading a mesh which is being loaded in the background waits for it
+  const common::Mesh *drillMesh = meshManager->Load(drill);
+  ASSERT_NE(nullptr, drillMesh);
+  EXPECT_EQ(drillMesh, drillFuture.get());
+  EXPECT_EQ(drill, drillMesh->Name());
+
+  const common::Mesh *boxMesh = boxFuture.get();
+  ASSERT_NE(nullptr, boxMesh);
+  EXPECT_EQ(24u, boxMesh->VertexCount());
+  EXPECT_EQ(boxMesh, meshManager->MeshByName(box));
+
+  // Loaded meshes are returned right away
+  auto loadedFuture = meshManager->LoadAsync(box);
+  EXPECT_EQ(std::future_status::ready,
+      loadedFuture.wait_for(std::chrono::seconds(0)));
+  EXPECT_EQ(boxMesh, loadedFuture.get());
+
+  EXPECT_EQ(nullptr, meshManager->LoadAsync("invalid_extension.xyz").get());
+  EXPECT_EQ(nullptr, meshManager->LoadAsync("missing_file.dae").get());
+}
+
+/////////////////////////////////////////////////
+TEST_F(MeshManager, LoadParallel)
+{
+  auto meshManager = common::MeshManager::Instance();
+
+  const std::vector<std::string> filenames = {
+      std::string(PROJECT_SOURCE_PATH) + "/test/data/box.obj",
+      std::string(PROJECT_SOURCE_PATH) + "/test/data/box_nested_animation.dae",
+      std::string(PROJECT_SOURCE_PATH) +
+          "/test/data/box_with_animation_outside_skeleton.dae",
+      std::string(PROJECT_SOURCE_PATH) +
+          "/test/data/multiple_texture_coordinates_triangle.dae"};
+
+  // Several threads load the same meshes in different orders
+  const unsigned int threadCount = 4;
+  std::vector<std::vector<const common::Mesh *>> results(threadCount);
+  std::vector<std::thread> threads;
+  for (unsigned int t = 0; t < threadCount; ++t)
+  {
+    threads.push_back(std::thread([&, t]()
+        {
+          results[t].resize(filenames.size());
+          for (unsigned int i = 0; i < filenames.size(); ++i)
+          {
+            unsigned int f = (i + t) % filenames.size();
+            results[t][f] = meshManager->Load(filenames[f]);
+          }
+        }));
+  }
+  for (auto &thread : threads)
+    thread.join();
+
+  // Each mesh is loaded once
+  for (unsigned int f = 0; f < filenames.size(); ++f)
+  {
+    const common::Mesh *mesh = meshManager->MeshByName(filenames[f]);
+    ASSERT_NE(nullptr, mesh) << filenames[f];
+    for (unsigned int t = 0; t < threadCount; ++t)
+      EXPECT_EQ(mesh, results[t][f]);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(MeshManager, LoadSimplified)
+{
+  auto meshManager = common::MeshManager::Instance();
+
+  const std::string drill = std::string(PROJECT_SOURCE_PATH) +
+      "/test/data/cordless_drill/meshes/cordless_drill.dae";
+  const common::Mesh *mesh = meshManager->Load(drill);
+  ASSERT_NE(nullptr, mesh);
+  const unsigned int triangleCount = mesh->IndexCount() / 3;
+  const unsigned int maxTriangles = triangleCount / 2;
+
+  const common::Mesh *simplified =
+      meshManager->LoadSimplified(drill, maxTriangles);
+  ASSERT_NE(nullptr, simplified);
+  EXPECT_NE(mesh, simplified);
+  EXPECT_EQ(drill + "#simplified_" + std::to_string(maxTriangles),
+      simplified->Name());
+  EXPECT_EQ(mesh->SubMeshCount(), simplified->SubMeshCount());
+
+  // Each submesh may round its share of the triangles up
+  EXPECT_LE(simplified->IndexCount() / 3,
+      maxTriangles + simplified->SubMeshCount());
+  EXPECT_GT(simplified->IndexCount() / 3, maxTriangles / 2);
+
+  // Vertices are kept in place, so the bounds can only shrink, and only a
+  // little
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    EXPECT_GE(simplified->Min()[i], mesh->Min()[i]);
+    EXPECT_LE(simplified->Max()[i], mesh->Max()[i]);
+  }
+  EXPECT_NEAR((mesh->Max() - mesh->Min()).Length(),
+      (simplified->Max() - simplified->Min()).Length(),
+      0.05 * (mesh->Max() - mesh->Min()).Length());
+
+  // The simplified mesh is computed once
+  EXPECT_EQ(simplified, meshManager->LoadSimplified(drill, maxTriangles));
+  EXPECT_EQ(simplified, meshManager->MeshByName(simplified->Name()));
+
+  // Meshes which are small enough are used as they are
+  EXPECT_EQ(mesh, meshManager->LoadSimplified(drill, triangleCount));
+  EXPECT_FALSE(meshManager->HasMesh(
+      drill + "#simplified_" + std::to_string(triangleCount)));
+
+  EXPECT_EQ(nullptr, meshManager->LoadSimplified("missing_file.dae", 10u));
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
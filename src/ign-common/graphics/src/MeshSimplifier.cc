@@ -0,0 +1,820 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <queue>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <ignition/math/Helpers.hh>
+#include <ignition/math/Vector2.hh>
+#include <ignition/math/Vector3.hh>
+
+#include "ignition/common/Mesh.hh"
+#include "ignition/common/MeshSimplifier.hh"
+#include "ignition/common/SubMesh.hh"
+
+using namespace ignition;
+using namespace common;
+
+/// \brief Weight of the planes constraining borders and creases, relative
+/// to the squared length of their edge.
+static const double kConstraintWeight = 10.0;
+
+/// \brief Largest distance between texture coordinates of welded vertices
+static const double kTexCoordTolerance = 1e-6;
+
+/// \brief Private data for MeshSimplifier
+class ignition::common::MeshSimplifierPrivate
+{
+  /// \brief Maximum distance the surface may move
+  public: double maxError = std::numeric_limits<double>::infinity();
+
+  /// \brief Angle above which normals are kept apart, in radians
+  public: double creaseAngle = IGN_PI / 4.0;
+};
+
+namespace
+{
+  /// \brief Symmetric 4x4 matrix accumulating squared distances to planes
+  class Quadric
+  {
+    /// \brief Add a plane.
+    /// \param[in] _n Unit normal of the plane.
+    /// \param[in] _d Offset of the plane, so that _n.Dot(p) + _d is zero on
+    /// the plane.
+    /// \param[in] _weight Weight of the plane.
+    public: void AddPlane(const math::Vector3d &_n, const double _d,
+                const double _weight)
+    {
+      const double a = _n.X();
+      const double b = _n.Y();
+      const double c = _n.Z();
+      this->m[0] += _weight * a * a;
+      this->m[1] += _weight * a * b;
+      this->m[2] += _weight * a * c;
+      this->m[3] += _weight * a * _d;
+      this->m[4] += _weight * b * b;
+      this->m[5] += _weight * b * c;
+      this->m[6] += _weight * b * _d;
+      this->m[7] += _weight * c * c;
+      this->m[8] += _weight * c * _d;
+      this->m[9] += _weight * _d * _d;
+    }
+
+    /// \brief Add another quadric.
+    /// \param[in] _other Quadric to add.
+    public: void Add(const Quadric &_other)
+    {
+      for (unsigned int i = 0; i < 10; ++i)
+        this->m[i] += _other.m[i];
+    }
+
+    /// \brief Weighted sum of the squared distances of a point to the
+    /// planes.
+    /// \param[in] _p The point.
+    /// \return The squared distance sum, never negative.
+    public: double Evaluate(const math::Vector3d &_p) const
+    {
+      const double x = _p.X();
+      const double y = _p.Y();
+      const double z = _p.Z();
+      double e = this->m[0] * x * x + 2 * this->m[1] * x * y +
+          2 * this->m[2] * x * z + 2 * this->m[3] * x +
+          this->m[4] * y * y + 2 * this->m[5] * y * z + 2 * this->m[6] * y +
+          this->m[7] * z * z + 2 * this->m[8] * z + this->m[9];
+      return std::max(0.0, e);
+    }
+
+    /// \brief Upper triangle of the matrix, row by row
+    public: std::array<double, 10> m{};
+  };
+
+  /// \brief A candidate collapse of a vertex onto a neighbor
+  struct Candidate
+  {
+    /// \brief Error introduced by the collapse
+    double cost;
+
+    /// \brief Vertex which is removed
+    unsigned int from;
+
+    /// \brief Vertex which is kept
+    unsigned int to;
+
+    /// \brief Version of the removed vertex when the cost was computed
+    unsigned int fromVersion;
+
+    /// \brief Version of the kept vertex when the cost was computed
+    unsigned int toVersion;
+
+    /// \brief Order candidates by cost.
+    bool operator>(const Candidate &_other) const
+    {
+      return this->cost > _other.cost;
+    }
+  };
+
+  /// \brief Hash of a position, for welding vertices.
+  struct PositionHash
+  {
+    size_t operator()(const std::array<double, 3> &_p) const
+    {
+      std::hash<double> h;
+      size_t seed = h(_p[0]);
+      seed ^= h(_p[1]) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+      seed ^= h(_p[2]) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+      return seed;
+    }
+  };
+
+  /// \brief The state of the simplification of a submesh.
+  ///
+  /// A "position" is a welded vertex position, which is what gets collapsed.
+  /// A "wedge" is a set of vertices sharing a position, texture coordinate
+  /// and, within the crease angle, a normal. Triangles refer to wedges, so a
+  /// position on a crease or texture seam has several wedges.
+  class Simplification
+  {
+    /// \brief Constructor
+    /// \param[in] _subMesh Submesh to simplify, which must be made of
+    /// triangles.
+    /// \param[in] _creaseAngle Crease angle, in radians.
+    public: Simplification(const SubMesh &_subMesh, const double _creaseAngle);
+
+    /// \brief Collapse edges until the triangle count or error is reached.
+    /// \param[in] _targetCount Number of triangles to reach.
+    /// \param[in] _maxCost Largest collapse cost allowed.
+    public: void Run(const size_t _targetCount, const double _maxCost);
+
+    /// \brief Build a submesh from the remaining triangles.
+    /// \return The simplified submesh.
+    public: std::unique_ptr<SubMesh> Extract() const;
+
+    /// \brief Number of triangles in the source submesh.
+    public: size_t triangleCount = 0;
+
+    /// \brief Number of triangles remaining.
+    public: size_t aliveCount = 0;
+
+    /// \brief Weld the vertices of the submesh into positions and wedges.
+    /// \param[in] _creaseAngle Crease angle, in radians.
+    private: void Weld(const double _creaseAngle);
+
+    /// \brief Compute the quadrics of the positions.
+    private: void ComputeQuadrics();
+
+    /// \brief Queue the collapses of a position and its neighbors.
+    /// \param[in] _a A position.
+    /// \param[in] _b A neighbor of _a.
+    private: void PushEdge(const unsigned int _a, const unsigned int _b);
+
+    /// \brief Get the positions sharing a triangle with a position.
+    /// \param[in] _p A position.
+    /// \return Sorted neighbors of _p.
+    private: std::vector<unsigned int> Neighbors(const unsigned int _p) const;
+
+    /// \brief Collapse a position onto a neighbor, if it keeps the mesh
+    /// manifold, doesn't flip triangles and doesn't cross a seam.
+    /// \param[in] _from Position removed.
+    /// \param[in] _to Position kept.
+    /// \return True if the collapse was done.
+    private: bool Collapse(const unsigned int _from, const unsigned int _to);
+
+    /// \brief Get the position of a corner of a triangle.
+    /// \param[in] _t Triangle index.
+    /// \param[in] _k Corner, 0 to 2.
+    /// \return Position index.
+    private: unsigned int Corner(const unsigned int _t,
+                 const unsigned int _k) const
+    {
+      return this->wedgePosition[this->triangles[_t][_k]];
+    }
+
+    /// \brief The submesh being simplified
+    private: const SubMesh &subMesh;
+
+    /// \brief True if the submesh has one normal per vertex
+    private: bool hasNormals = false;
+
+    /// \brief True if the submesh has one texture coordinate per vertex
+    private: bool hasTexCoords = false;
+
+    /// \brief Coordinates of each position
+    private: std::vector<math::Vector3d> positions;
+
+    /// \brief Quadric of each position
+    private: std::vector<Quadric> quadrics;
+
+    /// \brief Total area of the triangles in the quadric of each position
+    private: std::vector<double> areas;
+
+    /// \brief Triangles using each position, which may include removed
+    /// triangles
+    private: std::vector<std::vector<unsigned int>> positionTriangles;
+
+    /// \brief Incremented every time a position changes
+    private: std::vector<unsigned int> versions;
+
+    /// \brief False once a position is collapsed
+    private: std::vector<bool> positionAlive;
+
+    /// \brief Position of each wedge
+    private: std::vector<unsigned int> wedgePosition;
+
+    /// \brief Source vertex giving the attributes of each wedge
+    private: std::vector<unsigned int> wedgeVertex;
+
+    /// \brief Sum of the normals of the vertices of each wedge
+    private: std::vector<math::Vector3d> wedgeNormal;
+
+    /// \brief Wedge of each source vertex
+    private: std::vector<unsigned int> vertexWedge;
+
+    /// \brief Wedges of each triangle
+    private: std::vector<std::array<unsigned int, 3>> triangles;
+
+    /// \brief False once a triangle is removed
+    private: std::vector<bool> triangleAlive;
+
+    /// \brief Candidate collapses, cheapest first
+    private: std::priority_queue<Candidate, std::vector<Candidate>,
+             std::greater<Candidate>> queue;
+  };
+
+  //////////////////////////////////////////////////
+  Simplification::Simplification(const SubMesh &_subMesh,
+      const double _creaseAngle)
+    : subMesh(_subMesh)
+  {
+    this->Weld(_creaseAngle);
+    this->ComputeQuadrics();
+  }
+
+  //////////////////////////////////////////////////
+  void Simplification::Weld(const double _creaseAngle)
+  {
+    const unsigned int vertexCount = this->subMesh.VertexCount();
+    this->hasNormals = this->subMesh.NormalCount() == vertexCount;
+    this->hasTexCoords = this->subMesh.TexCoordCount() == vertexCount;
+    const double creaseCos = std::cos(_creaseAngle);
+
+    std::unordered_map<std::array<double, 3>, unsigned int, PositionHash>
+        positionIds;
+    std::vector<std::vector<unsigned int>> positionWedges;
+
+    this->vertexWedge.resize(vertexCount);
+    for (unsigned int i = 0; i < vertexCount; ++i)
+    {
+      const math::Vector3d v = this->subMesh.Vertex(i);
+      auto inserted = positionIds.emplace(
+          std::array<double, 3>{{v.X(), v.Y(), v.Z()}},
+          static_cast<unsigned int>(this->positions.size()));
+      const unsigned int p = inserted.first->second;
+      if (inserted.second)
+      {
+        this->positions.push_back(v);
+        positionWedges.emplace_back();
+      }
+
+      math::Vector3d normal;
+      if (this->hasNormals)
+        normal = this->subMesh.Normal(i);
+      const double normalLength = normal.Length();
+      if (normalLength > 0)
+        normal /= normalLength;
+
+      // Find a wedge of this position with the same attributes
+      int wedge = -1;
+      for (unsigned int w : positionWedges[p])
+      {
+        const unsigned int other = this->wedgeVertex[w];
+        if (this->hasTexCoords &&
+            this->subMesh.TexCoord(other).Distance(this->subMesh.TexCoord(i)) >
+            kTexCoordTolerance)
+        {
+          continue;
+        }
+
+        if (this->hasNormals && normalLength > 0)
+        {
+          math::Vector3d otherNormal = this->subMesh.Normal(other);
+          const double otherLength = otherNormal.Length();
+          if (otherLength > 0 &&
+              otherNormal.Dot(normal) < creaseCos * otherLength)
+          {
+            continue;
+          }
+        }
+
+        wedge = static_cast<int>(w);
+        break;
+      }
+
+      if (wedge < 0)
+      {
+        wedge = static_cast<int>(this->wedgePosition.size());
+        this->wedgePosition.push_back(p);
+        this->wedgeVertex.push_back(i);
+        this->wedgeNormal.push_back(math::Vector3d::Zero);
+        positionWedges[p].push_back(static_cast<unsigned int>(wedge));
+      }
+
+      this->wedgeNormal[wedge] += normal;
+      this->vertexWedge[i] = static_cast<unsigned int>(wedge);
+    }
+
+    const size_t positionCount = this->positions.size();
+    this->positionTriangles.resize(positionCount);
+    this->versions.assign(positionCount, 0u);
+    this->positionAlive.assign(positionCount, true);
+
+    // Triangles using the same position twice have no area and are dropped
+    const unsigned int indexCount = this->subMesh.IndexCount();
+    for (unsigned int i = 0; i + 2 < indexCount; i += 3)
+    {
+      std::array<unsigned int, 3> tri;
+      bool valid = true;
+      for (unsigned int k = 0; k < 3; ++k)
+      {
+        const int index = this->subMesh.Index(i + k);
+        if (index < 0 || static_cast<unsigned int>(index) >= vertexCount)
+        {
+          valid = false;
+          break;
+        }
+        tri[k] = this->vertexWedge[index];
+      }
+
+      ++this->triangleCount;
+      if (!valid)
+        continue;
+
+      const unsigned int p0 = this->wedgePosition[tri[0]];
+      const unsigned int p1 = this->wedgePosition[tri[1]];
+      const unsigned int p2 = this->wedgePosition[tri[2]];
+      if (p0 == p1 || p1 == p2 || p0 == p2)
+        continue;
+
+      const unsigned int t = static_cast<unsigned int>(this->triangles.size());
+      this->triangles.push_back(tri);
+      this->positionTriangles[p0].push_back(t);
+      this->positionTriangles[p1].push_back(t);
+      this->positionTriangles[p2].push_back(t);
+    }
+
+    this->triangleAlive.assign(this->triangles.size(), true);
+    this->aliveCount = this->triangles.size();
+  }
+
+  //////////////////////////////////////////////////
+  void Simplification::ComputeQuadrics()
+  {
+    this->quadrics.assign(this->positions.size(), Quadric());
+    this->areas.assign(this->positions.size(), 0.0);
+
+    /// \brief Triangles and wedges along an edge
+    struct EdgeUse
+    {
+      /// \brief A triangle using the edge
+      unsigned int triangle;
+
+      /// \brief Wedges of the lower and higher position of the edge
+      std::pair<unsigned int, unsigned int> wedges;
+    };
+    std::unordered_map<uint64_t, std::vector<EdgeUse>> edges;
+
+    for (unsigned int t = 0; t < this->triangles.size(); ++t)
+    {
+      const math::Vector3d &p0 = this->positions[this->Corner(t, 0)];
+      const math::Vector3d &p1 = this->positions[this->Corner(t, 1)];
+      const math::Vector3d &p2 = this->positions[this->Corner(t, 2)];
+      math::Vector3d n = (p1 - p0).Cross(p2 - p0);
+      const double length = n.Length();
+      if (length > 0)
+      {
+        n /= length;
+        const double area = 0.5 * length;
+        for (unsigned int k = 0; k < 3; ++k)
+        {
+          this->quadrics[this->Corner(t, k)].AddPlane(n, -n.Dot(p0), area);
+          this->areas[this->Corner(t, k)] += area;
+        }
+      }
+
+      for (unsigned int k = 0; k < 3; ++k)
+      {
+        unsigned int wa = this->triangles[t][k];
+        unsigned int wb = this->triangles[t][(k + 1) % 3];
+        if (this->wedgePosition[wa] > this->wedgePosition[wb])
+          std::swap(wa, wb);
+        const uint64_t key =
+            (static_cast<uint64_t>(this->wedgePosition[wa]) << 32) |
+            this->wedgePosition[wb];
+        edges[key].push_back({t, {wa, wb}});
+      }
+    }
+
+    // Borders, creases and texture seams are constrained by planes through
+    // the edge, perpendicular to the triangles, so that they keep their
+    // shape
+    for (const auto &edge : edges)
+    {
+      const auto &uses = edge.second;
+      bool constrained = uses.size() != 2u;
+      for (const auto &use : uses)
+        constrained = constrained || use.wedges != uses.front().wedges;
+
+      if (!constrained)
+        continue;
+
+      const unsigned int a = static_cast<unsigned int>(edge.first >> 32);
+      const unsigned int b = static_cast<unsigned int>(edge.first);
+      const math::Vector3d &pa = this->positions[a];
+      const math::Vector3d &pb = this->positions[b];
+      const math::Vector3d dir = pb - pa;
+      for (const auto &use : uses)
+      {
+        const unsigned int t = use.triangle;
+        const math::Vector3d &p0 = this->positions[this->Corner(t, 0)];
+        const math::Vector3d &p1 = this->positions[this->Corner(t, 1)];
+        const math::Vector3d &p2 = this->positions[this->Corner(t, 2)];
+        math::Vector3d n = dir.Cross((p1 - p0).Cross(p2 - p0));
+        const double length = n.Length();
+        if (length <= 0)
+          continue;
+        n /= length;
+
+        const double weight = kConstraintWeight * dir.SquaredLength();
+        this->quadrics[a].AddPlane(n, -n.Dot(pa), weight);
+        this->quadrics[b].AddPlane(n, -n.Dot(pa), weight);
+      }
+    }
+
+    for (const auto &edge : edges)
+    {
+      this->PushEdge(static_cast<unsigned int>(edge.first >> 32),
+          static_cast<unsigned int>(edge.first));
+    }
+  }
+
+  //////////////////////////////////////////////////
+  void Simplification::PushEdge(const unsigned int _a, const unsigned int _b)
+  {
+    Quadric q = this->quadrics[_a];
+    q.Add(this->quadrics[_b]);
+    const double area = std::max(this->areas[_a] + this->areas[_b],
+        std::numeric_limits<double>::min());
+
+    // Costs are mean squared distances to the original planes
+    this->queue.push({q.Evaluate(this->positions[_b]) / area, _a, _b,
+        this->versions[_a], this->versions[_b]});
+    this->queue.push({q.Evaluate(this->positions[_a]) / area, _b, _a,
+        this->versions[_b], this->versions[_a]});
+  }
+
+  //////////////////////////////////////////////////
+  std::vector<unsigned int> Simplification::Neighbors(
+      const unsigned int _p) const
+  {
+    std::vector<unsigned int> result;
+    for (unsigned int t : this->positionTriangles[_p])
+    {
+      if (!this->triangleAlive[t])
+        continue;
+      for (unsigned int k = 0; k < 3; ++k)
+      {
+        if (this->Corner(t, k) != _p)
+          result.push_back(this->Corner(t, k));
+      }
+    }
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+    return result;
+  }
+
+  //////////////////////////////////////////////////
+  bool Simplification::Collapse(const unsigned int _from,
+      const unsigned int _to)
+  {
+    std::vector<unsigned int> tris;
+    unsigned int shared = 0;
+    for (unsigned int t : this->positionTriangles[_from])
+    {
+      if (!this->triangleAlive[t])
+        continue;
+      tris.push_back(t);
+      for (unsigned int k = 0; k < 3; ++k)
+      {
+        if (this->Corner(t, k) == _to)
+          ++shared;
+      }
+    }
+
+    if (shared == 0)
+      return false;
+
+    // Link condition: the only positions adjacent to both ends of the edge
+    // must be the opposite corners of the triangles along it, otherwise the
+    // collapse makes the mesh non-manifold
+    const std::vector<unsigned int> fromNeighbors = this->Neighbors(_from);
+    const std::vector<unsigned int> toNeighbors = this->Neighbors(_to);
+    std::vector<unsigned int> common;
+    std::set_intersection(fromNeighbors.begin(), fromNeighbors.end(),
+        toNeighbors.begin(), toNeighbors.end(), std::back_inserter(common));
+    if (common.size() != shared)
+      return false;
+
+    // Each wedge of the removed position must become exactly one wedge of
+    // the kept position, which it shares a triangle with. This keeps the
+    // collapse along creases and texture seams rather than across them.
+    std::vector<std::pair<unsigned int, unsigned int>> wedgeMap;
+    auto findWedge = [&wedgeMap](const unsigned int _w)
+    {
+      return std::find_if(wedgeMap.begin(), wedgeMap.end(),
+          [_w](const std::pair<unsigned int, unsigned int> &_m)
+          {
+            return _m.first == _w;
+          });
+    };
+
+    for (unsigned int t : tris)
+    {
+      unsigned int fromWedge = 0;
+      int toWedge = -1;
+      for (unsigned int k = 0; k < 3; ++k)
+      {
+        if (this->Corner(t, k) == _from)
+          fromWedge = this->triangles[t][k];
+        else if (this->Corner(t, k) == _to)
+          toWedge = static_cast<int>(this->triangles[t][k]);
+      }
+      if (toWedge < 0)
+        continue;
+
+      auto it = findWedge(fromWedge);
+      if (it == wedgeMap.end())
+        wedgeMap.emplace_back(fromWedge, static_cast<unsigned int>(toWedge));
+      else if (it->second != static_cast<unsigned int>(toWedge))
+        return false;
+    }
+
+    const math::Vector3d &target = this->positions[_to];
+    for (unsigned int t : tris)
+    {
+      math::Vector3d p[3];
+      bool hasTo = false;
+      int fromCorner = 0;
+      for (unsigned int k = 0; k < 3; ++k)
+      {
+        p[k] = this->positions[this->Corner(t, k)];
+        if (this->Corner(t, k) == _to)
+          hasTo = true;
+        else if (this->Corner(t, k) == _from)
+          fromCorner = static_cast<int>(k);
+      }
+      if (hasTo)
+        continue;
+
+      if (findWedge(this->triangles[t][fromCorner]) == wedgeMap.end())
+        return false;
+
+      // Reject collapses which flip a triangle
+      const math::Vector3d before = (p[1] - p[0]).Cross(p[2] - p[0]);
+      p[fromCorner] = target;
+      const math::Vector3d after = (p[1] - p[0]).Cross(p[2] - p[0]);
+      if (before.Dot(after) <= 0)
+        return false;
+    }
+
+    for (unsigned int t : tris)
+    {
+      bool hasTo = false;
+      for (unsigned int k = 0; k < 3; ++k)
+        hasTo = hasTo || this->Corner(t, k) == _to;
+
+      if (hasTo)
+      {
+        this->triangleAlive[t] = false;
+        --this->aliveCount;
+        continue;
+      }
+
+      for (unsigned int k = 0; k < 3; ++k)
+      {
+        if (this->Corner(t, k) == _from)
+          this->triangles[t][k] = findWedge(this->triangles[t][k])->second;
+      }
+      this->positionTriangles[_to].push_back(t);
+    }
+
+    this->quadrics[_to].Add(this->quadrics[_from]);
+    this->areas[_to] += this->areas[_from];
+    this->positionAlive[_from] = false;
+    this->positionTriangles[_from].clear();
+    ++this->versions[_from];
+    ++this->versions[_to];
+
+    auto &toTriangles = this->positionTriangles[_to];
+    toTriangles.erase(std::remove_if(toTriangles.begin(), toTriangles.end(),
+        [this](unsigned int _t) { return !this->triangleAlive[_t]; }),
+        toTriangles.end());
+
+    for (unsigned int neighbor : this->Neighbors(_to))
+      this->PushEdge(_to, neighbor);
+
+    return true;
+  }
+
+  //////////////////////////////////////////////////
+  void Simplification::Run(const size_t _targetCount, const double _maxCost)
+  {
+    while (this->aliveCount > _targetCount && !this->queue.empty())
+    {
+      const Candidate c = this->queue.top();
+
+      if (!this->positionAlive[c.from] || !this->positionAlive[c.to] ||
+          this->versions[c.from] != c.fromVersion ||
+          this->versions[c.to] != c.toVersion)
+      {
+        this->queue.pop();
+        continue;
+      }
+
+      // Keep the candidate queued, a later level may allow a larger error
+      if (c.cost > _maxCost)
+        break;
+
+      this->queue.pop();
+      this->Collapse(c.from, c.to);
+    }
+  }
+
+  //////////////////////////////////////////////////
+  std::unique_ptr<SubMesh> Simplification::Extract() const
+  {
+    std::unique_ptr<SubMesh> result(new SubMesh(this->subMesh.Name()));
+    result->SetPrimitiveType(this->subMesh.SubMeshPrimitiveType());
+    result->SetMaterialIndex(this->subMesh.MaterialIndex());
+
+    std::vector<int> newIndex(this->wedgePosition.size(), -1);
+    int vertexCount = 0;
+    for (unsigned int t = 0; t < this->triangles.size(); ++t)
+    {
+      if (!this->triangleAlive[t])
+        continue;
+
+      for (unsigned int w : this->triangles[t])
+      {
+        if (newIndex[w] < 0)
+        {
+          newIndex[w] = vertexCount++;
+          const unsigned int v = this->wedgeVertex[w];
+          result->AddVertex(this->positions[this->wedgePosition[w]]);
+          if (this->hasNormals)
+          {
+            math::Vector3d normal = this->wedgeNormal[w];
+            if (normal.Length() > 0)
+              result->AddNormal(normal.Normalize());
+            else
+              result->AddNormal(this->subMesh.Normal(v));
+          }
+          if (this->hasTexCoords)
+            result->AddTexCoord(this->subMesh.TexCoord(v));
+        }
+        result->AddIndex(static_cast<unsigned int>(newIndex[w]));
+      }
+    }
+
+    // Kept vertices keep their skeleton node assignments
+    for (unsigned int i = 0; i < this->subMesh.NodeAssignmentsCount(); ++i)
+    {
+      const NodeAssignment na = this->subMesh.NodeAssignmentByIndex(i);
+      if (na.vertexIndex >= this->vertexWedge.size())
+        continue;
+      const unsigned int w = this->vertexWedge[na.vertexIndex];
+      if (this->wedgeVertex[w] != na.vertexIndex || newIndex[w] < 0)
+        continue;
+      result->AddNodeAssignment(static_cast<unsigned int>(newIndex[w]),
+          na.nodeIndex, na.weight);
+    }
+
+    result->SetVertexPrecision(this->subMesh.SubMeshVertexPrecision());
+    return result;
+  }
+}
+
+//////////////////////////////////////////////////
+MeshSimplifier::MeshSimplifier()
+  : dataPtr(new MeshSimplifierPrivate)
+{
+}
+
+//////////////////////////////////////////////////
+MeshSimplifier::~MeshSimplifier()
+{
+}
+
+//////////////////////////////////////////////////
+void MeshSimplifier::SetMaxError(const double _error)
+{
+  this->dataPtr->maxError = _error;
+}
+
+//////////////////////////////////////////////////
+double MeshSimplifier::MaxError() const
+{
+  return this->dataPtr->maxError;
+}
+
+//////////////////////////////////////////////////
+void MeshSimplifier::SetCreaseAngle(const double _angle)
+{
+  this->dataPtr->creaseAngle = _angle;
+}
+
+//////////////////////////////////////////////////
+double MeshSimplifier::CreaseAngle() const
+{
+  return this->dataPtr->creaseAngle;
+}
+
+//////////////////////////////////////////////////
+std::unique_ptr<SubMesh> MeshSimplifier::Simplify(const SubMesh &_subMesh,
+    const double _ratio) const
+{
+  auto levels = this->LodChain(_subMesh, {_ratio});
+  return std::move(levels.front());
+}
+
+//////////////////////////////////////////////////
+Mesh *MeshSimplifier::Simplify(const Mesh &_mesh, const double _ratio) const
+{
+  Mesh *result = new Mesh();
+  result->SetName(_mesh.Name());
+  result->SetPath(_mesh.Path());
+
+  for (unsigned int i = 0; i < _mesh.MaterialCount(); ++i)
+    result->AddMaterial(_mesh.MaterialByIndex(i));
+
+  if (_mesh.HasSkeleton())
+    result->SetSkeleton(_mesh.MeshSkeleton());
+
+  for (unsigned int i = 0; i < _mesh.SubMeshCount(); ++i)
+  {
+    auto subMesh = _mesh.SubMeshByIndex(i).lock();
+    if (subMesh)
+      result->AddSubMesh(this->Simplify(*subMesh, _ratio));
+  }
+
+  return result;
+}
+
+//////////////////////////////////////////////////
+std::vector<std::unique_ptr<SubMesh>> MeshSimplifier::LodChain(
+    const SubMesh &_subMesh, const std::vector<double> &_ratios) const
+{
+  std::vector<std::unique_ptr<SubMesh>> result;
+
+  if (_subMesh.SubMeshPrimitiveType() != SubMesh::TRIANGLES)
+  {
+    for (size_t i = 0; i < _ratios.size(); ++i)
+      result.emplace_back(new SubMesh(_subMesh));
+    return result;
+  }
+
+  Simplification simplification(_subMesh, this->dataPtr->creaseAngle);
+  const double maxCost = this->dataPtr->maxError * this->dataPtr->maxError;
+
+  for (double ratio : _ratios)
+  {
+    ratio = math::clamp(ratio, 0.0, 1.0);
+    const size_t target = static_cast<size_t>(
+        std::ceil(ratio * simplification.triangleCount));
+    simplification.Run(target, maxCost);
+    result.push_back(simplification.Extract());
+  }
+
+  return result;
+}
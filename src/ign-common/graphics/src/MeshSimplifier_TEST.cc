@@ -0,0 +1,283 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "test_config.h"
+#include "ignition/common/Material.hh"
+#include "ignition/common/Mesh.hh"
+#include "ignition/common/MeshManager.hh"
+#include "ignition/common/MeshSimplifier.hh"
+#include "ignition/common/Skeleton.hh"
+#include "ignition/common/SubMesh.hh"
+#include "test/util.hh"
+
+using namespace ignition;
+
+class MeshSimplifierTest : public ignition::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+/// \brief Get the first submesh of a mesh of the mesh manager.
+/// \param[in] _name Name of the mesh.
+/// \return The submesh.
+std::shared_ptr<common::SubMesh> firstSubMesh(const std::string &_name)
+{
+  const common::Mesh *mesh =
+      common::MeshManager::Instance()->MeshByName(_name);
+  if (!mesh)
+    return nullptr;
+  return mesh->SubMeshByIndex(0).lock();
+}
+
+/////////////////////////////////////////////////
+/// \brief Count the triangles of a submesh which have three distinct
+/// vertex positions. The others are dropped by simplification.
+/// \param[in] _subMesh The submesh.
+/// \return Number of triangles with an area.
+unsigned int validTriangleCount(const common::SubMesh &_subMesh)
+{
+  // Vector3d::operator== has a tolerance, positions are welded exactly
+  auto same = [](const math::Vector3d &_a, const math::Vector3d &_b)
+  {
+    return _a.X() == _b.X() && _a.Y() == _b.Y() && _a.Z() == _b.Z();
+  };
+
+  unsigned int count = 0;
+  for (unsigned int i = 0; i + 2 < _subMesh.IndexCount(); i += 3)
+  {
+    math::Vector3d v0 = _subMesh.Vertex(_subMesh.Index(i));
+    math::Vector3d v1 = _subMesh.Vertex(_subMesh.Index(i + 1));
+    math::Vector3d v2 = _subMesh.Vertex(_subMesh.Index(i + 2));
+    if (!same(v0, v1) && !same(v1, v2) && !same(v0, v2))
+      ++count;
+  }
+  return count;
+}
+
+/////////////////////////////////////////////////
+TEST_F(MeshSimplifierTest, Defaults)
+{
+  common::MeshSimplifier simplifier;
+  EXPECT_TRUE(std::isinf(simplifier.MaxError()));
+  EXPECT_DOUBLE_EQ(IGN_PI / 4.0, simplifier.CreaseAngle());
+
+  simplifier.SetMaxError(0.01);
+  EXPECT_DOUBLE_EQ(0.01, simplifier.MaxError());
+  simplifier.SetCreaseAngle(0.5);
+  EXPECT_DOUBLE_EQ(0.5, simplifier.CreaseAngle());
+}
+
+/////////////////////////////////////////////////
+TEST_F(MeshSimplifierTest, Plane)
+{
+  common::MeshManager::Instance()->CreatePlane("simplifier_plane",
+      math::Vector3d::UnitZ, 0, math::Vector2d(2, 4), math::Vector2d(20, 20),
+      math::Vector2d(1, 1));
+  auto plane = firstSubMesh("simplifier_plane");
+  ASSERT_NE(nullptr, plane);
+  EXPECT_EQ(800u, plane->IndexCount() / 3);
+
+  common::MeshSimplifier simplifier;
+  auto simplified = simplifier.Simplify(*plane, 0.1);
+  ASSERT_NE(nullptr, simplified);
+  EXPECT_EQ(common::SubMesh::TRIANGLES,
+      simplified->SubMeshPrimitiveType());
+  EXPECT_LE(simplified->IndexCount() / 3, 80u);
+  EXPECT_GT(simplified->IndexCount(), 0u);
+  EXPECT_EQ(simplified->VertexCount(), simplified->NormalCount());
+  EXPECT_EQ(simplified->VertexCount(), simplified->TexCoordCount());
+
+  // The borders are kept, so the plane keeps its extent, and every vertex
+  // is still on the plane
+  EXPECT_EQ(math::Vector3d(-1, -2, 0), simplified->Min());
+  EXPECT_EQ(math::Vector3d(1, 2, 0), simplified->Max());
+  for (unsigned int i = 0; i < simplified->VertexCount(); ++i)
+  {
+    EXPECT_DOUBLE_EQ(0.0, simplified->Vertex(i).Z());
+    EXPECT_EQ(math::Vector3d::UnitZ, simplified->Normal(i));
+  }
+
+  // The simplified triangles still cover the whole plane
+  double area = 0;
+  for (unsigned int i = 0; i < simplified->IndexCount(); i += 3)
+  {
+    math::Vector3d v0 = simplified->Vertex(simplified->Index(i));
+    math::Vector3d v1 = simplified->Vertex(simplified->Index(i + 1));
+    math::Vector3d v2 = simplified->Vertex(simplified->Index(i + 2));
+    math::Vector3d n = (v1 - v0).Cross(v2 - v0);
+    EXPECT_GT(n.Z(), 0.0);
+    area += 0.5 * n.Length();
+  }
+  EXPECT_NEAR(8.0, area, 1e-6);
+}
+
+/////////////////////////////////////////////////
+TEST_F(MeshSimplifierTest, Sphere)
+{
+  common::MeshManager::Instance()->CreateSphere("simplifier_sphere", 1.0f,
+      32, 32);
+  auto sphere = firstSubMesh("simplifier_sphere");
+  ASSERT_NE(nullptr, sphere);
+  const unsigned int triangleCount = sphere->IndexCount() / 3;
+
+  common::MeshSimplifier simplifier;
+  auto simplified = simplifier.Simplify(*sphere, 0.25);
+  ASSERT_NE(nullptr, simplified);
+  EXPECT_LE(simplified->IndexCount() / 3, triangleCount / 4 + 1);
+  EXPECT_GT(simplified->IndexCount() / 3, triangleCount / 8);
+
+  // Vertices keep their position on the sphere
+  for (unsigned int i = 0; i < simplified->VertexCount(); ++i)
+  {
+    EXPECT_NEAR(1.0, simplified->Vertex(i).Length(), 1e-5);
+    EXPECT_NEAR(1.0, simplified->Normal(i).Length(), 1e-5);
+  }
+
+  // A small maximum error stops the simplification early
+  simplifier.SetMaxError(1e-4);
+  auto limited = simplifier.Simplify(*sphere, 0.25);
+  ASSERT_NE(nullptr, limited);
+  EXPECT_GT(limited->IndexCount(), simplified->IndexCount());
+
+  // Only the triangles without area at the poles are removed with a ratio
+  // of 1
+  simplifier.SetMaxError(1.0);
+  auto same = simplifier.Simplify(*sphere, 1.0);
+  EXPECT_LT(validTriangleCount(*sphere), triangleCount);
+  EXPECT_EQ(validTriangleCount(*sphere), same->IndexCount() / 3);
+}
+
+/////////////////////////////////////////////////
+TEST_F(MeshSimplifierTest, Box)
+{
+  // The faces of a box have separate normals, so its edges are creases
+  // which can't be collapsed without changing its shape
+  common::MeshManager::Instance()->CreateBox("simplifier_box",
+      math::Vector3d(1, 2, 3), math::Vector2d(1, 1));
+  auto box = firstSubMesh("simplifier_box");
+  ASSERT_NE(nullptr, box);
+
+  common::MeshSimplifier simplifier;
+  auto simplified = simplifier.Simplify(*box, 0.1);
+  ASSERT_NE(nullptr, simplified);
+  EXPECT_EQ(box->IndexCount(), simplified->IndexCount());
+  EXPECT_EQ(box->Min(), simplified->Min());
+  EXPECT_EQ(box->Max(), simplified->Max());
+}
+
+/////////////////////////////////////////////////
+TEST_F(MeshSimplifierTest, LodChain)
+{
+  common::MeshManager::Instance()->CreateSphere("simplifier_lod", 1.0f,
+      24, 24);
+  auto sphere = firstSubMesh("simplifier_lod");
+  ASSERT_NE(nullptr, sphere);
+  sphere->SetMaterialIndex(2);
+  const unsigned int triangleCount = sphere->IndexCount() / 3;
+
+  common::MeshSimplifier simplifier;
+  auto levels = simplifier.LodChain(*sphere, {1.0, 0.5, 0.25, 0.1});
+  ASSERT_EQ(4u, levels.size());
+  EXPECT_EQ(validTriangleCount(*sphere), levels[0]->IndexCount() / 3);
+
+  const std::vector<double> ratios = {1.0, 0.5, 0.25, 0.1};
+  for (unsigned int i = 1; i < levels.size(); ++i)
+  {
+    EXPECT_LT(levels[i]->IndexCount(), levels[i - 1]->IndexCount());
+    EXPECT_LE(levels[i]->IndexCount() / 3,
+        static_cast<unsigned int>(std::ceil(ratios[i] * triangleCount)));
+    EXPECT_EQ(2u, levels[i]->MaterialIndex());
+    EXPECT_EQ(sphere->Name(), levels[i]->Name());
+  }
+
+  // Levels generated in one pass match simplifying directly
+  auto direct = simplifier.Simplify(*sphere, 0.5);
+  EXPECT_EQ(levels[1]->IndexCount(), direct->IndexCount());
+}
+
+/////////////////////////////////////////////////
+TEST_F(MeshSimplifierTest, Mesh)
+{
+  common::Mesh mesh;
+  mesh.SetName("simplifier_mesh");
+  mesh.SetPath("/tmp");
+  common::MaterialPtr material(new common::Material());
+  mesh.AddMaterial(material);
+  common::SkeletonPtr skeleton(new common::Skeleton());
+  mesh.SetSkeleton(skeleton);
+
+  common::MeshManager::Instance()->CreateSphere("simplifier_mesh_sphere",
+      0.5f, 16, 16);
+  auto sphere = firstSubMesh("simplifier_mesh_sphere");
+  ASSERT_NE(nullptr, sphere);
+  common::SubMesh skinned(*sphere);
+  for (unsigned int i = 0; i < skinned.VertexCount(); ++i)
+    skinned.AddNodeAssignment(i, i % 3, 1.0f);
+  mesh.AddSubMesh(skinned);
+
+  // Non triangle submeshes are copied
+  common::SubMesh lines;
+  lines.SetPrimitiveType(common::SubMesh::LINES);
+  lines.AddVertex(0, 0, 0);
+  lines.AddVertex(1, 0, 0);
+  lines.AddIndex(0);
+  lines.AddIndex(1);
+  mesh.AddSubMesh(lines);
+
+  common::MeshSimplifier simplifier;
+  std::unique_ptr<common::Mesh> simplified(simplifier.Simplify(mesh, 0.5));
+  ASSERT_NE(nullptr, simplified);
+  EXPECT_EQ("simplifier_mesh", simplified->Name());
+  EXPECT_EQ("/tmp", simplified->Path());
+  ASSERT_EQ(1u, simplified->MaterialCount());
+  EXPECT_EQ(material, simplified->MaterialByIndex(0));
+  EXPECT_EQ(skeleton, simplified->MeshSkeleton());
+  ASSERT_EQ(2u, simplified->SubMeshCount());
+
+  auto simplifiedSphere = simplified->SubMeshByIndex(0).lock();
+  ASSERT_NE(nullptr, simplifiedSphere);
+  EXPECT_LT(simplifiedSphere->IndexCount(), skinned.IndexCount());
+
+  // Kept vertices keep their node assignments
+  EXPECT_EQ(simplifiedSphere->VertexCount(),
+      simplifiedSphere->NodeAssignmentsCount());
+  for (unsigned int i = 0; i < simplifiedSphere->NodeAssignmentsCount(); ++i)
+  {
+    common::NodeAssignment na = simplifiedSphere->NodeAssignmentByIndex(i);
+    EXPECT_LT(na.vertexIndex, simplifiedSphere->VertexCount());
+    EXPECT_LT(na.nodeIndex, 3u);
+    EXPECT_FLOAT_EQ(1.0f, na.weight);
+  }
+
+  auto simplifiedLines = simplified->SubMeshByIndex(1).lock();
+  ASSERT_NE(nullptr, simplifiedLines);
+  EXPECT_EQ(common::SubMesh::LINES,
+      simplifiedLines->SubMeshPrimitiveType());
+  EXPECT_EQ(2u, simplifiedLines->IndexCount());
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -119,6 +119,12 @@ std::pair<double, math::Matrix4d> NodeAnimation::KeyFrame(
   return std::make_pair(t, mat);
 }
 
+//////////////////////////////////////////////////
+const std::map<double, math::Matrix4d> &NodeAnimation::KeyFrames() const
+{
+  return this->data->keyFrames;
+}
+
 //////////////////////////////////////////////////
 double NodeAnimation::Length() const
 {
@@ -131,7 +137,7 @@ math::Matrix4d NodeAnimation::FrameAt(double _time, bool _loop) const
   double time = _time;
   if (time > this->data->length)
   {
-    if (_loop)
+    if (_loop && this->data->length > 0.0)
     {
       while (time > this->data->length)
         time = time - this->data->length;
@@ -148,18 +154,21 @@ math::Matrix4d NodeAnimation::FrameAt(double _time, bool _loop) const
   std::map<double, math::Matrix4d>::const_iterator it1 =
     this->data->keyFrames.upper_bound(time);
 
+  if (it1 == this->data->keyFrames.end())
+    return this->data->keyFrames.rbegin()->second;
+
   if (it1 == this->data->keyFrames.begin() || math::equal(it1->first, time))
     return it1->second;
 
   std::map<double, math::Matrix4d>::const_iterator it2 = it1--;
 
-  if (it1 == this->data->keyFrames.begin() || math::equal(it1->first, time))
+  if (math::equal(it1->first, time))
     return it1->second;
 
   double nextKey = it2->first;
   math::Matrix4d nextTrans = it2->second;
   double prevKey = it1->first;
-  math::Matrix4d prevTrans = it2->second;
+  math::Matrix4d prevTrans = it1->second;
 
   double t = (time - prevKey) / (nextKey - prevKey);
 
@@ -15,6 +15,10 @@
  *
  */
 #include <list>
+#include <map>
+#include <string>
+#include <vector>
+
 #include <ignition/common/SkeletonAnimation.hh>
 #include <ignition/common/Skeleton.hh>
 #include <ignition/common/BVHLoader.hh>
@@ -262,6 +266,12 @@ void Skeleton::SetNumVertAttached(const unsigned int _vertices)
   this->data->rawNodeWeights.resize(_vertices);
 }
 
+//////////////////////////////////////////////////
+unsigned int Skeleton::NumVertAttached() const
+{
+  return this->data->rawNodeWeights.size();
+}
+
 //////////////////////////////////////////////////
 void Skeleton::AddVertNodeWeight(
     const unsigned int _vertex, const std::string &_node,
@@ -330,44 +340,31 @@ bool Skeleton::AddBvhAnimation(const std::string &_bvhFile, double _scale)
   if (nullptr == skel)
     return false;
 
-  bool compatible = true;
+  // Nodes correspond by handle
+  const unsigned int nodeCount = this->NodeCount();
+  if (nodeCount != skel->NodeCount())
+    return false;
 
+  std::vector<SkeletonNode *> skinNodes(nodeCount);
+  std::vector<SkeletonNode *> animNodes(nodeCount);
   std::map<std::string, std::string> skelMap;
-  if (this->NodeCount() != skel->NodeCount())
-  {
-    compatible = false;
-  }
-  else
-  {
-    for (unsigned int i = 0; i < this->NodeCount(); ++i)
-    {
-      SkeletonNode *skinNode = this->NodeByHandle(i);
-      SkeletonNode *animNode = skel->NodeByHandle(i);
-      if (skinNode->ChildCount() != animNode->ChildCount())
-      {
-        compatible = false;
-        break;
-      }
-      else
-      {
-        skelMap[animNode->Name()] = skinNode->Name();
-      }
-    }
-  }
-
-  if (!compatible)
+  for (unsigned int i = 0; i < nodeCount; ++i)
   {
-    return false;
+    skinNodes[i] = this->NodeByHandle(i);
+    animNodes[i] = skel->NodeByHandle(i);
+    if (skinNodes[i]->ChildCount() != animNodes[i]->ChildCount())
+      return false;
+    skelMap[animNodes[i]->Name()] = skinNodes[i]->Name();
   }
 
-  // align frames
-  std::map<std::string, math::Matrix4d> translations;
-  std::map<std::string, math::Matrix4d> rotations;
+  // align frames, indexed by handle. Translations left to zero are unset.
+  std::vector<math::Matrix4d> translations(nodeCount, math::Matrix4d::Zero);
+  std::vector<math::Matrix4d> rotations(nodeCount, math::Matrix4d::Zero);
 
-  for (unsigned int i = 0; i < skel->NodeCount(); ++i)
+  for (unsigned int i = 0; i < nodeCount; ++i)
   {
-    SkeletonNode *animNode = skel->NodeByHandle(i);
-    SkeletonNode *skinNode = this->NodeByHandle(i);
+    SkeletonNode *animNode = animNodes[i];
+    SkeletonNode *skinNode = skinNodes[i];
 
     if (animNode->Parent() != nullptr)
     {
@@ -375,7 +372,7 @@ bool Skeleton::AddBvhAnimation(const std::string &_bvhFile, double _scale)
               && skinNode->Transform().Translation() ==
               math::Vector3d::Zero)
       {
-        translations[animNode->Name()] = math::Matrix4d::Identity;
+        translations[i] = math::Matrix4d::Identity;
       }
     }
 
@@ -384,11 +381,11 @@ bool Skeleton::AddBvhAnimation(const std::string &_bvhFile, double _scale)
       continue;
     }
 
-    if (this->RootNode()->Name() == skelMap[animNode->Name()])
+    if (this->RootNode() == skinNode)
     {
-      translations[animNode->Name()] = math::Matrix4d(
+      translations[i] = math::Matrix4d(
         this->RootNode()->Transform().Rotation());
-      math::Matrix4d tmp(translations[animNode->Name()]);
+      math::Matrix4d tmp(translations[i]);
       tmp.SetTranslation(animNode->Transform().Translation());
       animNode->SetTransform(tmp, true);
     }
@@ -416,7 +413,7 @@ bool Skeleton::AddBvhAnimation(const std::string &_bvhFile, double _scale)
     double theta = asin(n.Length() /
           (relativeSkin.Length() * relativeBVH.Length()));
 
-    translations[animNode->Child(0)->Name()] =
+    translations[animNode->Child(0)->Handle()] =
         math::Matrix4d(skinNode->ModelTransform().Rotation()).Inverse()
         * math::Matrix4d(math::Quaterniond(n.Normalize(), theta))
         * math::Matrix4d(animNode->ModelTransform().Rotation());
@@ -428,32 +425,43 @@ bool Skeleton::AddBvhAnimation(const std::string &_bvhFile, double _scale)
     animNode->SetTransform(tmp, true);
   }
 
-  for (unsigned int i = 0; i < skel->NodeCount(); ++i)
+  for (unsigned int i = 0; i < nodeCount; ++i)
   {
-    SkeletonNode *animNode = skel->NodeByHandle(i);
-    SkeletonNode *skinNode = this->NodeByHandle(i);
+    SkeletonNode *animNode = animNodes[i];
+    SkeletonNode *skinNode = skinNodes[i];
 
-    if (skelMap[animNode->Name()] == this->RootNode()->Name())
+    if (skinNode == this->RootNode())
     {
-      rotations[animNode->Name()] = math::Matrix4d::Identity;
+      rotations[i] = math::Matrix4d::Identity;
       continue;
     }
 
-    if (translations[animNode->Name()] == math::Matrix4d::Zero)
+    if (translations[i] == math::Matrix4d::Zero)
     {
-        translations[animNode->Name()] = math::Matrix4d::Identity;
+        translations[i] = math::Matrix4d::Identity;
     }
 
-    rotations[animNode->Name()] =
+    rotations[i] =
           math::Matrix4d(animNode->Transform().Rotation()).Inverse()
-          * translations[animNode->Name()].Inverse()
+          * translations[i].Inverse()
           * math::Matrix4d(skinNode->Transform().Rotation());
   }
 
+  // Keyed by animation node name for NodeNameAnimToSkin, AlignTranslation
+  // and AlignRotation
+  std::map<std::string, math::Matrix4d> translationMap;
+  std::map<std::string, math::Matrix4d> rotationMap;
+  for (unsigned int i = 0; i < nodeCount; ++i)
+  {
+    if (translations[i] != math::Matrix4d::Zero)
+      translationMap[animNodes[i]->Name()] = translations[i];
+    rotationMap[animNodes[i]->Name()] = rotations[i];
+  }
+
   this->data->anims.push_back(skel->Animation(0u));
   this->data->mapAnimSkin.push_back(skelMap);
-  this->data->alignTranslate.push_back(translations);
-  this->data->alignRotate.push_back(rotations);
+  this->data->alignTranslate.push_back(translationMap);
+  this->data->alignRotate.push_back(rotationMap);
 
   return true;
 }
@@ -462,10 +470,19 @@ bool Skeleton::AddBvhAnimation(const std::string &_bvhFile, double _scale)
 std::string Skeleton::NodeNameAnimToSkin(unsigned int _index,
       const std::string &_animNodeName)
 {
-  if (this->data->mapAnimSkin[_index].find(_animNodeName)
-        != this->data->mapAnimSkin[_index].end())
+  return static_cast<const Skeleton *>(this)->NodeNameAnimToSkin(_index,
+      _animNodeName);
+}
+
+//////////////////////////////////////////////////
+std::string Skeleton::NodeNameAnimToSkin(unsigned int _index,
+      const std::string &_animNodeName) const
+{
+  if (_index < this->data->mapAnimSkin.size())
   {
-    return this->data->mapAnimSkin[_index][_animNodeName];
+    auto it = this->data->mapAnimSkin[_index].find(_animNodeName);
+    if (it != this->data->mapAnimSkin[_index].end())
+      return it->second;
   }
   return _animNodeName;
 }
@@ -474,10 +491,19 @@ std::string Skeleton::NodeNameAnimToSkin(unsigned int _index,
 math::Matrix4d Skeleton::AlignTranslation(unsigned int _index,
       const std::string &_animNodeName)
 {
-  if (this->data->alignTranslate[_index].find(_animNodeName)
-        != this->data->alignTranslate[_index].end())
+  return static_cast<const Skeleton *>(this)->AlignTranslation(_index,
+      _animNodeName);
+}
+
+//////////////////////////////////////////////////
+math::Matrix4d Skeleton::AlignTranslation(unsigned int _index,
+      const std::string &_animNodeName) const
+{
+  if (_index < this->data->alignTranslate.size())
   {
-    return this->data->alignTranslate[_index][_animNodeName];
+    auto it = this->data->alignTranslate[_index].find(_animNodeName);
+    if (it != this->data->alignTranslate[_index].end())
+      return it->second;
   }
   return math::Matrix4d::Identity;
 }
@@ -486,10 +512,19 @@ math::Matrix4d Skeleton::AlignTranslation(unsigned int _index,
 math::Matrix4d Skeleton::AlignRotation(unsigned int _index,
       const std::string &_animNodeName)
 {
-  if (this->data->alignRotate[_index].find(_animNodeName)
-        != this->data->alignRotate[_index].end())
+  return static_cast<const Skeleton *>(this)->AlignRotation(_index,
+      _animNodeName);
+}
+
+//////////////////////////////////////////////////
+math::Matrix4d Skeleton::AlignRotation(unsigned int _index,
+      const std::string &_animNodeName) const
+{
+  if (_index < this->data->alignRotate.size())
   {
-    return this->data->alignRotate[_index][_animNodeName];
+    auto it = this->data->alignRotate[_index].find(_animNodeName);
+    if (it != this->data->alignRotate[_index].end())
+      return it->second;
   }
   return math::Matrix4d::Identity;
 }
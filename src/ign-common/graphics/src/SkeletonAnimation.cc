@@ -29,7 +29,7 @@ class ignition::common::SkeletonAnimationPrivate
   public: std::string name;
 
   /// \brief the duration of the longest animation
-  public: double length;
+  public: double length = 0.0;
 
   /// \brief a dictionary of node animations
   public: std::map<std::string, NodeAnimation*> animations;
@@ -74,6 +74,12 @@ bool SkeletonAnimation::HasNode(const std::string &_node) const
   return (this->data->animations.find(_node) != this->data->animations.end());
 }
 
+//////////////////////////////////////////////////
+const std::map<std::string, NodeAnimation *> &SkeletonAnimation::Nodes() const
+{
+  return this->data->animations;
+}
+
 //////////////////////////////////////////////////
 void SkeletonAnimation::AddKeyFrame(const std::string &_node,
     const double _time, const math::Matrix4d &_mat)
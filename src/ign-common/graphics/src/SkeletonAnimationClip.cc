@@ -0,0 +1,444 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <vector>
+
+#include "ignition/common/NodeAnimation.hh"
+#include "ignition/common/Skeleton.hh"
+#include "ignition/common/SkeletonAnimation.hh"
+#include "ignition/common/SkeletonAnimationClip.hh"
+
+using namespace ignition;
+using namespace common;
+
+/// \brief Number of key frames a cursor is moved forward one at a time
+/// before falling back to a binary search.
+static const unsigned int kMaxCursorSteps = 4u;
+
+/// \brief Private data for SkeletonAnimationClip
+class ignition::common::SkeletonAnimationClipPrivate
+{
+  /// \brief Find the first key frame of a node after a given time.
+  /// \param[in] _node Index of the node.
+  /// \param[in] _time Time within the node's key frames.
+  /// \param[in] _cursor Index of the key frame found for the previous
+  /// sample, relative to the first key frame of the node.
+  /// \return Index of the first key frame later than _time, relative to
+  /// the first key frame of the node, or the key frame count if there is
+  /// none.
+  public: unsigned int UpperBound(const unsigned int _node,
+              const double _time, const unsigned int _cursor) const;
+
+  /// \brief Write the transform of a key frame.
+  /// \param[in] _key Absolute index of the key frame.
+  /// \param[out] _transform Transform of the key frame.
+  public: void KeyTransform(const unsigned int _key,
+              math::Matrix4d &_transform) const;
+
+  /// \brief Append the key frames of a node.
+  /// \param[in] _name Name of the node in the clip.
+  /// \param[in] _node Animation of the node.
+  /// \param[in] _pre Transform applied before each key frame.
+  /// \param[in] _post Rotation applied after each key frame. Applying a
+  /// rotation on both sides of the key frames doesn't change how they
+  /// interpolate, so the aligned key frames can be sampled directly.
+  public: void AddNode(const std::string &_name, const NodeAnimation &_node,
+              const math::Matrix4d &_pre, const math::Matrix4d &_post);
+
+  /// \brief Name of the animation.
+  public: std::string name;
+
+  /// \brief Duration of the animation.
+  public: double length = 0.0;
+
+  /// \brief Node names, sorted.
+  public: std::vector<std::string> nodeNames;
+
+  /// \brief Index of the first key frame of each node, followed by the
+  /// total number of key frames.
+  public: std::vector<unsigned int> firstKey;
+
+  /// \brief Duration of each node animation, the time of its last key frame.
+  public: std::vector<double> nodeLength;
+
+  /// \brief Whether the X translation of each node only increases from one
+  /// key frame to the next, in which case it can be searched by bisection.
+  public: std::vector<bool> increasingX;
+
+  /// \brief Key frame times.
+  public: std::vector<double> times;
+
+  /// \brief Key frame translations along X.
+  public: std::vector<double> posX;
+
+  /// \brief Key frame translations along X in the animation, before any
+  /// alignment. These are the ones TimeAtX searches.
+  public: std::vector<double> rawX;
+
+  /// \brief Key frame translations along Y.
+  public: std::vector<double> posY;
+
+  /// \brief Key frame translations along Z.
+  public: std::vector<double> posZ;
+
+  /// \brief Key frame rotations.
+  public: std::vector<math::Quaterniond> rot;
+};
+
+//////////////////////////////////////////////////
+unsigned int SkeletonAnimationClipPrivate::UpperBound(
+    const unsigned int _node, const double _time,
+    const unsigned int _cursor) const
+{
+  const double *t = this->times.data() + this->firstKey[_node];
+  const unsigned int count =
+    this->firstKey[_node + 1] - this->firstKey[_node];
+
+  // Most samples are a little later than the previous one, so start from the
+  // key frame that was found then.
+  if (_cursor < count && t[_cursor] <= _time)
+  {
+    unsigned int upper = _cursor + 1u;
+    for (unsigned int step = 0; step < kMaxCursorSteps && upper < count;
+         ++step, ++upper)
+    {
+      if (t[upper] > _time)
+        return upper;
+    }
+    if (upper == count)
+      return count;
+  }
+
+  return static_cast<unsigned int>(std::upper_bound(t, t + count, _time) - t);
+}
+
+//////////////////////////////////////////////////
+void SkeletonAnimationClipPrivate::KeyTransform(const unsigned int _key,
+    math::Matrix4d &_transform) const
+{
+  _transform = math::Matrix4d(this->rot[_key]);
+  _transform.SetTranslation(math::Vector3d(
+        this->posX[_key], this->posY[_key], this->posZ[_key]));
+}
+
+//////////////////////////////////////////////////
+SkeletonAnimationClip::SkeletonAnimationClip()
+  : dataPtr(new SkeletonAnimationClipPrivate)
+{
+  this->dataPtr->firstKey.push_back(0u);
+}
+
+//////////////////////////////////////////////////
+SkeletonAnimationClip::SkeletonAnimationClip(
+    const SkeletonAnimation &_animation)
+  : SkeletonAnimationClip()
+{
+  this->Load(_animation);
+}
+
+//////////////////////////////////////////////////
+SkeletonAnimationClip::SkeletonAnimationClip(const Skeleton &_skeleton,
+    const unsigned int _index)
+  : SkeletonAnimationClip()
+{
+  this->Load(_skeleton, _index);
+}
+
+//////////////////////////////////////////////////
+SkeletonAnimationClip::SkeletonAnimationClip(
+    const SkeletonAnimationClip &_other)
+  : dataPtr(new SkeletonAnimationClipPrivate(*_other.dataPtr))
+{
+}
+
+//////////////////////////////////////////////////
+SkeletonAnimationClip::~SkeletonAnimationClip()
+{
+}
+
+//////////////////////////////////////////////////
+SkeletonAnimationClip &SkeletonAnimationClip::operator=(
+    const SkeletonAnimationClip &_other)
+{
+  if (this != &_other)
+    *this->dataPtr = *_other.dataPtr;
+  return *this;
+}
+
+//////////////////////////////////////////////////
+void SkeletonAnimationClipPrivate::AddNode(const std::string &_name,
+    const NodeAnimation &_node, const math::Matrix4d &_pre,
+    const math::Matrix4d &_post)
+{
+  const bool align = _pre != math::Matrix4d::Identity ||
+      _post != math::Matrix4d::Identity;
+
+  this->nodeNames.push_back(_name);
+  this->nodeLength.push_back(_node.Length());
+
+  bool increasing = true;
+  for (const auto &keyFrame : _node.KeyFrames())
+  {
+    const double x = keyFrame.second.Translation().X();
+    if (this->times.size() > this->firstKey.back() && x < this->rawX.back())
+      increasing = false;
+
+    math::Matrix4d transform =
+        align ? _pre * keyFrame.second * _post : keyFrame.second;
+    const math::Vector3d pos = transform.Translation();
+
+    this->times.push_back(keyFrame.first);
+    this->posX.push_back(pos.X());
+    this->posY.push_back(pos.Y());
+    this->posZ.push_back(pos.Z());
+    this->rawX.push_back(x);
+    this->rot.push_back(transform.Rotation());
+  }
+
+  this->increasingX.push_back(increasing);
+  this->firstKey.push_back(static_cast<unsigned int>(this->times.size()));
+}
+
+//////////////////////////////////////////////////
+void SkeletonAnimationClip::Load(const SkeletonAnimation &_animation)
+{
+  SkeletonAnimationClipPrivate &d = *this->dataPtr;
+  d = SkeletonAnimationClipPrivate();
+  d.name = _animation.Name();
+  d.length = _animation.Length();
+  d.firstKey.push_back(0u);
+
+  for (const auto &node : _animation.Nodes())
+  {
+    d.AddNode(node.first, *node.second, math::Matrix4d::Identity,
+        math::Matrix4d::Identity);
+  }
+}
+
+//////////////////////////////////////////////////
+void SkeletonAnimationClip::Load(const Skeleton &_skeleton,
+    const unsigned int _index)
+{
+  SkeletonAnimationClipPrivate &d = *this->dataPtr;
+  d = SkeletonAnimationClipPrivate();
+  d.firstKey.push_back(0u);
+
+  const SkeletonAnimation *animation = _skeleton.Animation(_index);
+  if (nullptr == animation)
+    return;
+
+  d.name = animation->Name();
+  d.length = animation->Length();
+
+  // Nodes are sorted by the names of the skin nodes they drive
+  std::vector<std::pair<std::string, std::string>> names;
+  for (const auto &node : animation->Nodes())
+  {
+    names.emplace_back(_skeleton.NodeNameAnimToSkin(_index, node.first),
+        node.first);
+  }
+  std::sort(names.begin(), names.end());
+
+  const auto &nodes = animation->Nodes();
+  for (const auto &[skinName, animName] : names)
+  {
+    // The rotation alignment only holds a rotation, drop any rounding
+    // error in its translation
+    math::Matrix4d post(
+        _skeleton.AlignRotation(_index, animName).Rotation());
+    d.AddNode(skinName, *nodes.at(animName),
+        _skeleton.AlignTranslation(_index, animName), post);
+  }
+}
+
+//////////////////////////////////////////////////
+std::string SkeletonAnimationClip::Name() const
+{
+  return this->dataPtr->name;
+}
+
+//////////////////////////////////////////////////
+unsigned int SkeletonAnimationClip::NodeCount() const
+{
+  return static_cast<unsigned int>(this->dataPtr->nodeNames.size());
+}
+
+//////////////////////////////////////////////////
+std::string SkeletonAnimationClip::NodeName(const unsigned int _index) const
+{
+  if (_index >= this->dataPtr->nodeNames.size())
+    return std::string();
+  return this->dataPtr->nodeNames[_index];
+}
+
+//////////////////////////////////////////////////
+int SkeletonAnimationClip::NodeIndex(const std::string &_name) const
+{
+  const auto &names = this->dataPtr->nodeNames;
+  auto it = std::lower_bound(names.begin(), names.end(), _name);
+  if (it == names.end() || *it != _name)
+    return -1;
+  return static_cast<int>(it - names.begin());
+}
+
+//////////////////////////////////////////////////
+unsigned int SkeletonAnimationClip::FrameCount(
+    const unsigned int _index) const
+{
+  if (_index >= this->dataPtr->nodeNames.size())
+    return 0u;
+  return this->dataPtr->firstKey[_index + 1] - this->dataPtr->firstKey[_index];
+}
+
+//////////////////////////////////////////////////
+double SkeletonAnimationClip::Length() const
+{
+  return this->dataPtr->length;
+}
+
+//////////////////////////////////////////////////
+void SkeletonAnimationClip::PoseAt(const double _time,
+    math::Matrix4d *_transforms, unsigned int *_cursors,
+    const bool _loop) const
+{
+  const SkeletonAnimationClipPrivate &d = *this->dataPtr;
+  const unsigned int nodeCount = static_cast<unsigned int>(d.nodeNames.size());
+
+  for (unsigned int n = 0; n < nodeCount; ++n)
+  {
+    const unsigned int first = d.firstKey[n];
+    const unsigned int count = d.firstKey[n + 1] - first;
+    if (count == 0u)
+    {
+      _transforms[n] = math::Matrix4d::Identity;
+      continue;
+    }
+
+    const double length = d.nodeLength[n];
+    double time = _time;
+    if (time > length)
+    {
+      if (_loop && length > 0.0)
+      {
+        // Wrap to (0, length], like repeatedly subtracting the length
+        time = std::fmod(time, length);
+        if (time <= 0.0)
+          time = length;
+      }
+      else
+      {
+        time = length;
+      }
+    }
+
+    if (math::equal(time, length))
+    {
+      d.KeyTransform(first + count - 1u, _transforms[n]);
+      if (_cursors)
+        _cursors[n] = count - 1u;
+      continue;
+    }
+
+    const unsigned int upper =
+      d.UpperBound(n, time, _cursors ? _cursors[n] : 0u);
+    if (_cursors)
+      _cursors[n] = upper > 0u ? upper - 1u : 0u;
+
+    // Before the first key frame, or on a key frame
+    if (upper == 0u || (upper < count &&
+          math::equal(d.times[first + upper], time)))
+    {
+      d.KeyTransform(first + std::min(upper, count - 1u), _transforms[n]);
+      continue;
+    }
+    const unsigned int prev = first + upper - 1u;
+    if (upper == count || math::equal(d.times[prev], time))
+    {
+      d.KeyTransform(prev, _transforms[n]);
+      continue;
+    }
+
+    const unsigned int next = prev + 1u;
+    const double t = (time - d.times[prev]) / (d.times[next] - d.times[prev]);
+
+    math::Quaterniond rot =
+      math::Quaterniond::Slerp(t, d.rot[prev], d.rot[next], true);
+    _transforms[n] = math::Matrix4d(rot);
+    _transforms[n].SetTranslation(math::Vector3d(
+          d.posX[prev] + (d.posX[next] - d.posX[prev]) * t,
+          d.posY[prev] + (d.posY[next] - d.posY[prev]) * t,
+          d.posZ[prev] + (d.posZ[next] - d.posZ[prev]) * t));
+  }
+}
+
+//////////////////////////////////////////////////
+double SkeletonAnimationClip::TimeAtX(const double _x,
+    const unsigned int _index, const bool _loop) const
+{
+  const SkeletonAnimationClipPrivate &d = *this->dataPtr;
+  if (_index >= d.nodeNames.size())
+    return 0.0;
+
+  const unsigned int first = d.firstKey[_index];
+  const unsigned int count = d.firstKey[_index + 1] - first;
+  if (count == 0u)
+    return 0.0;
+
+  const double *x = d.rawX.data() + first;
+  const double *t = d.times.data() + first;
+  const double firstX = x[0];
+  const double lastX = x[count - 1u];
+
+  double target = std::max(_x, firstX);
+  if (target > lastX)
+  {
+    if (_loop && lastX > 0.0)
+    {
+      target = std::fmod(target, lastX);
+      if (target <= 0.0)
+        target = lastX;
+    }
+    else
+    {
+      target = lastX;
+    }
+  }
+
+  // First key frame at or past the target
+  unsigned int k;
+  if (d.increasingX[_index])
+  {
+    k = static_cast<unsigned int>(
+        std::lower_bound(x, x + count, target) - x);
+  }
+  else
+  {
+    k = 0u;
+    while (k < count && x[k] < target)
+      ++k;
+  }
+
+  if (k >= count)
+    return t[count - 1u];
+  if (k == 0u || math::equal(x[k], target))
+    return t[k];
+
+  return t[k - 1u] + (t[k] - t[k - 1u]) * (target - x[k - 1u]) /
+    (x[k] - x[k - 1u]);
+}
@@ -0,0 +1,244 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include <ignition/math/Pose3.hh>
+#include <ignition/common/Skeleton.hh>
+#include <ignition/common/SkeletonAnimation.hh>
+#include <ignition/common/SkeletonAnimationClip.hh>
+#include "test_config.h"
+#include "test/util.hh"
+
+using namespace ignition;
+
+class SkeletonAnimationClipTest : public ignition::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+/// \brief Build an animation with nodes that have different key frames.
+/// \param[out] _anim Animation to fill.
+void fillAnimation(common::SkeletonAnimation &_anim)
+{
+  // Walks forward along X while turning.
+  for (int i = 0; i <= 10; ++i)
+  {
+    _anim.AddKeyFrame("root", i * 0.1,
+        math::Pose3d(i * 0.5, 0.1 * i, 1.0, 0, 0, 0.2 * i));
+  }
+
+  // Fewer key frames, ending before the root.
+  _anim.AddKeyFrame("arm", 0.0, math::Pose3d(0, 0, 0, 0.5, 0, 0));
+  _anim.AddKeyFrame("arm", 0.35, math::Pose3d(0, 1, 0, -0.5, 0, 0));
+  _anim.AddKeyFrame("arm", 0.6, math::Pose3d(0, 2, 0, 0, 0.3, 0));
+
+  // A single key frame.
+  _anim.AddKeyFrame("head", 0.0, math::Pose3d(0, 0, 2, 0, 0, 1));
+}
+
+/////////////////////////////////////////////////
+TEST_F(SkeletonAnimationClipTest, Nodes)
+{
+  common::SkeletonAnimationClip empty;
+  EXPECT_EQ(0u, empty.NodeCount());
+  EXPECT_EQ(-1, empty.NodeIndex("root"));
+  EXPECT_DOUBLE_EQ(0.0, empty.TimeAtX(1.0, 0));
+
+  common::SkeletonAnimation anim("walk");
+  fillAnimation(anim);
+  common::SkeletonAnimationClip clip(anim);
+
+  EXPECT_EQ("walk", clip.Name());
+  EXPECT_DOUBLE_EQ(1.0, clip.Length());
+  ASSERT_EQ(3u, clip.NodeCount());
+
+  // Nodes are sorted by name
+  EXPECT_EQ("arm", clip.NodeName(0));
+  EXPECT_EQ("head", clip.NodeName(1));
+  EXPECT_EQ("root", clip.NodeName(2));
+  EXPECT_EQ("", clip.NodeName(3));
+  EXPECT_EQ(2, clip.NodeIndex("root"));
+  EXPECT_EQ(-1, clip.NodeIndex("leg"));
+
+  EXPECT_EQ(3u, clip.FrameCount(0));
+  EXPECT_EQ(1u, clip.FrameCount(1));
+  EXPECT_EQ(11u, clip.FrameCount(2));
+  EXPECT_EQ(0u, clip.FrameCount(3));
+
+  // Copies are independent of the animation
+  common::SkeletonAnimationClip copy;
+  copy = clip;
+  anim.AddKeyFrame("leg", 0.5, math::Pose3d::Zero);
+  EXPECT_EQ(3u, copy.NodeCount());
+}
+
+/////////////////////////////////////////////////
+TEST_F(SkeletonAnimationClipTest, PoseAt)
+{
+  common::SkeletonAnimation anim("walk");
+  fillAnimation(anim);
+  common::SkeletonAnimationClip clip(anim);
+
+  std::vector<math::Matrix4d> transforms(clip.NodeCount());
+  std::vector<unsigned int> cursors(clip.NodeCount(), 0u);
+
+  // Halfway between two key frames of the root
+  clip.PoseAt(0.25, transforms.data());
+  EXPECT_EQ(math::Vector3d(1.25, 0.25, 1.0), transforms[2].Translation());
+  EXPECT_EQ(math::Quaterniond(0, 0, 0.5), transforms[2].Rotation());
+
+  // Before the first key frame
+  clip.PoseAt(-1.0, transforms.data());
+  EXPECT_EQ(math::Vector3d(0, 0, 1.0), transforms[2].Translation());
+
+  for (bool loop : {true, false})
+  {
+    // Forward with cursors, then forward in large steps, then backward.
+    std::vector<double> times;
+    for (int i = 0; i < 300; ++i)
+      times.push_back(i * 0.0071);
+    for (int i = 0; i < 20; ++i)
+      times.push_back(i * 0.37);
+    for (int i = 60; i >= 0; --i)
+      times.push_back(i * 0.033);
+    times.push_back(0.35);
+    times.push_back(1.0);
+    times.push_back(2.0);
+
+    for (double time : times)
+    {
+      auto expected = anim.PoseAt(time, loop);
+
+      clip.PoseAt(time, transforms.data(), cursors.data(), loop);
+      for (unsigned int n = 0; n < clip.NodeCount(); ++n)
+      {
+        EXPECT_EQ(expected[clip.NodeName(n)], transforms[n])
+          << clip.NodeName(n) << " at " << time << " loop " << loop;
+      }
+
+      clip.PoseAt(time, transforms.data(), nullptr, loop);
+      for (unsigned int n = 0; n < clip.NodeCount(); ++n)
+        EXPECT_EQ(expected[clip.NodeName(n)], transforms[n]);
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(SkeletonAnimationClipTest, TimeAtX)
+{
+  common::SkeletonAnimation anim("walk");
+  fillAnimation(anim);
+  common::SkeletonAnimationClip clip(anim);
+  const unsigned int root = clip.NodeIndex("root");
+
+  EXPECT_NEAR(0.0, clip.TimeAtX(-1.0, root), 1e-9);
+  EXPECT_NEAR(0.3, clip.TimeAtX(1.5, root), 1e-9);
+  EXPECT_NEAR(0.25, clip.TimeAtX(1.25, root), 1e-9);
+  EXPECT_NEAR(1.0, clip.TimeAtX(5.0, root), 1e-9);
+
+  // Loops around the last key frame
+  EXPECT_NEAR(0.25, clip.TimeAtX(6.25, root), 1e-9);
+  EXPECT_NEAR(1.0, clip.TimeAtX(6.25, root, false), 1e-9);
+
+  // Matches SkeletonAnimation::PoseAtX
+  std::vector<math::Matrix4d> transforms(clip.NodeCount());
+  for (double x : {0.3, 1.7, 4.9, 7.3})
+  {
+    auto expected = anim.PoseAtX(x, "root");
+    clip.PoseAt(clip.TimeAtX(x, root), transforms.data());
+    for (unsigned int n = 0; n < clip.NodeCount(); ++n)
+      EXPECT_EQ(expected[clip.NodeName(n)], transforms[n]) << x;
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(SkeletonAnimationClipTest, Retarget)
+{
+  // A skin whose bones point along Z, while the BVH bones point along Y
+  auto root = new common::SkeletonNode(nullptr, "skin_hips", "skin_hips");
+  math::Matrix4d transform(math::Matrix4d::Identity);
+  root->SetTransform(transform);
+  auto spine = new common::SkeletonNode(root, "skin_spine", "skin_spine");
+  transform.SetTranslation(math::Vector3d(0, 0, 1));
+  spine->SetTransform(transform);
+  auto head = new common::SkeletonNode(spine, "skin_head", "skin_head");
+  head->SetTransform(transform);
+  common::Skeleton skeleton(root);
+
+  ASSERT_TRUE(skeleton.AddBvhAnimation(
+      std::string(PROJECT_SOURCE_PATH) + "/test/data/retarget.bvh", 1.0));
+  ASSERT_EQ(1u, skeleton.AnimationCount());
+
+  // Out of bounds
+  common::SkeletonAnimationClip empty(skeleton, 1u);
+  EXPECT_EQ(0u, empty.NodeCount());
+
+  const common::SkeletonAnimation *anim = skeleton.Animation(0u);
+  ASSERT_NE(nullptr, anim);
+  common::SkeletonAnimationClip clip(skeleton, 0u);
+  EXPECT_DOUBLE_EQ(anim->Length(), clip.Length());
+  ASSERT_EQ(3u, clip.NodeCount());
+
+  // Nodes are named after the skin
+  EXPECT_EQ("skin_head", clip.NodeName(0));
+  EXPECT_EQ("skin_hips", clip.NodeName(1));
+  EXPECT_EQ("skin_spine", clip.NodeName(2));
+  EXPECT_EQ("skin_spine", skeleton.NodeNameAnimToSkin(0u, "Spine"));
+
+  // The spine is rotated to align the bone directions
+  EXPECT_NE(math::Matrix4d::Identity, skeleton.AlignTranslation(0u, "Head"));
+
+  // The const accessors match
+  const common::Skeleton &constSkeleton = skeleton;
+  EXPECT_EQ("skin_spine", constSkeleton.NodeNameAnimToSkin(0u, "Spine"));
+  EXPECT_EQ(skeleton.AlignTranslation(0u, "Head"),
+      constSkeleton.AlignTranslation(0u, "Head"));
+  EXPECT_EQ(skeleton.AlignRotation(0u, "Spine"),
+      constSkeleton.AlignRotation(0u, "Spine"));
+
+  // Matches aligning the animation at every sample
+  std::vector<math::Matrix4d> transforms(clip.NodeCount());
+  std::vector<unsigned int> cursors(clip.NodeCount(), 0u);
+  for (int i = 0; i <= 25; ++i)
+  {
+    double time = i * 0.05;
+    auto frames = anim->PoseAt(time);
+    clip.PoseAt(time, transforms.data(), cursors.data());
+    for (const auto &frame : frames)
+    {
+      auto expected = skeleton.AlignTranslation(0u, frame.first) *
+          frame.second * skeleton.AlignRotation(0u, frame.first);
+      int index = clip.NodeIndex(
+          skeleton.NodeNameAnimToSkin(0u, frame.first));
+      ASSERT_GE(index, 0) << frame.first;
+      EXPECT_EQ(expected, transforms[index]) << frame.first << " " << time;
+    }
+  }
+
+  // Distances are searched in the animation, before alignment
+  int hips = clip.NodeIndex("skin_hips");
+  EXPECT_NEAR(0.5, clip.TimeAtX(1.0, hips), 1e-6);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -14,8 +14,12 @@
  * limitations under the License.
  *
  */
-#include <string>
 #include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <utility>
 
 #include "ignition/math/Helpers.hh"
 
@@ -26,21 +30,209 @@
 using namespace ignition;
 using namespace common;
 
+/// \brief Largest index that fits in the 16 bit index buffer
+static const unsigned int kMaxShortIndex = 0xffff;
+
+/// \brief Convert a single precision float to a half precision float,
+/// rounding to the nearest value.
+/// \param[in] _value Value to convert.
+/// \return Bits of the half precision float.
+static uint16_t floatToHalf(const float _value)
+{
+  uint32_t bits;
+  std::memcpy(&bits, &_value, sizeof(bits));
+
+  uint32_t sign = (bits >> 16) & 0x8000;
+  uint32_t floatExp = (bits >> 23) & 0xff;
+  uint32_t mantissa = bits & 0x7fffff;
+
+  // Infinity and NaN
+  if (floatExp == 0xff)
+    return static_cast<uint16_t>(sign | 0x7c00 | (mantissa ? 0x200 : 0));
+
+  int exp = static_cast<int>(floatExp) - 127 + 15;
+
+  // Too large, becomes infinity
+  if (exp >= 0x1f)
+    return static_cast<uint16_t>(sign | 0x7c00);
+
+  // Subnormal half, or too small and becomes zero
+  if (exp <= 0)
+  {
+    if (exp < -10)
+      return static_cast<uint16_t>(sign);
+
+    mantissa |= 0x800000;
+    uint32_t shift = static_cast<uint32_t>(14 - exp);
+    uint32_t half = mantissa >> shift;
+    uint32_t rest = mantissa & ((1u << shift) - 1);
+    uint32_t halfway = 1u << (shift - 1);
+    if (rest > halfway || (rest == halfway && (half & 1)))
+      ++half;
+    return static_cast<uint16_t>(sign | half);
+  }
+
+  // A carry out of the mantissa correctly bumps the exponent
+  uint32_t half = sign | (static_cast<uint32_t>(exp) << 10) | (mantissa >> 13);
+  uint32_t rest = mantissa & 0x1fff;
+  if (rest > 0x1000 || (rest == 0x1000 && (half & 1)))
+    ++half;
+  return static_cast<uint16_t>(half);
+}
+
+/// \brief Convert a half precision float to a single precision float.
+/// \param[in] _half Bits of the half precision float.
+/// \return The converted value.
+static float halfToFloat(const uint16_t _half)
+{
+  uint32_t sign = static_cast<uint32_t>(_half & 0x8000) << 16;
+  uint32_t exp = (_half >> 10) & 0x1f;
+  uint32_t mantissa = _half & 0x3ff;
+
+  if (exp == 0)
+  {
+    float value = std::ldexp(static_cast<float>(mantissa), -24);
+    return sign ? -value : value;
+  }
+
+  uint32_t bits;
+  if (exp == 0x1f)
+    bits = sign | 0x7f800000 | (mantissa << 13);
+  else
+    bits = sign | ((exp - 15 + 127) << 23) | (mantissa << 13);
+
+  float value;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
 /// \brief Private data for SubMesh
 class ignition::common::SubMeshPrivate
 {
-  /// \brief the vertex array
+  /// \brief Get the number of vertices.
+  /// \return Number of vertices.
+  public: size_t VertexCount() const;
+
+  /// \brief Get a vertex, which must exist.
+  /// \param[in] _index Index of the vertex.
+  /// \return The vertex.
+  public: math::Vector3d VertexAt(const size_t _index) const;
+
+  /// \brief Set a vertex, which must exist.
+  /// \param[in] _index Index of the vertex.
+  /// \param[in] _v New value of the vertex.
+  public: void SetVertexAt(const size_t _index, const math::Vector3d &_v);
+
+  /// \brief Append a vertex.
+  /// \param[in] _v The vertex.
+  public: void PushVertex(const math::Vector3d &_v);
+
+  /// \brief Get the number of normals.
+  /// \return Number of normals.
+  public: size_t NormalCount() const;
+
+  /// \brief Get a normal, which must exist.
+  /// \param[in] _index Index of the normal.
+  /// \return The normal.
+  public: math::Vector3d NormalAt(const size_t _index) const;
+
+  /// \brief Set a normal, which must exist.
+  /// \param[in] _index Index of the normal.
+  /// \param[in] _n New value of the normal.
+  public: void SetNormalAt(const size_t _index, const math::Vector3d &_n);
+
+  /// \brief Append a normal.
+  /// \param[in] _n The normal.
+  public: void PushNormal(const math::Vector3d &_n);
+
+  /// \brief Resize the normal array, new normals are zero.
+  /// \param[in] _count New number of normals.
+  public: void ResizeNormals(const size_t _count);
+
+  /// \brief Get the number of texture coordinates.
+  /// \return Number of texture coordinates.
+  public: size_t TexCoordCount() const;
+
+  /// \brief Get a texture coordinate, which must exist.
+  /// \param[in] _index Index of the texture coordinate.
+  /// \return The texture coordinate.
+  public: math::Vector2d TexCoordAt(const size_t _index) const;
+
+  /// \brief Set a texture coordinate, which must exist.
+  /// \param[in] _index Index of the texture coordinate.
+  /// \param[in] _uv New value of the texture coordinate.
+  public: void SetTexCoordAt(const size_t _index, const math::Vector2d &_uv);
+
+  /// \brief Append a texture coordinate.
+  /// \param[in] _uv The texture coordinate.
+  public: void PushTexCoord(const math::Vector2d &_uv);
+
+  /// \brief Remove all texture coordinates.
+  public: void ClearTexCoords();
+
+  /// \brief Get the number of indices.
+  /// \return Number of indices.
+  public: size_t IndexCount() const;
+
+  /// \brief Get an index, which must exist.
+  /// \param[in] _index Position in the index array.
+  /// \return The index.
+  public: unsigned int IndexAt(const size_t _index) const;
+
+  /// \brief Set an index, which must exist.
+  /// \param[in] _index Position in the index array.
+  /// \param[in] _i New value of the index.
+  public: void SetIndexAt(const size_t _index, const unsigned int _i);
+
+  /// \brief Append an index.
+  /// \param[in] _i The index.
+  public: void PushIndex(const unsigned int _i);
+
+  /// \brief Move the indices from the 16 bit buffer to the 32 bit one,
+  /// because an index doesn't fit in 16 bits.
+  public: void PromoteIndices();
+
+  /// \brief Change the storage of the vertex attributes and indices.
+  /// \param[in] _precision New precision.
+  public: void SetPrecision(const SubMesh::VertexPrecision _precision);
+
+  /// \brief the vertex array, in DOUBLE_PRECISION
   public: std::vector<ignition::math::Vector3d> vertices;
 
-  /// \brief the normal array
+  /// \brief the normal array, in DOUBLE_PRECISION
   public: std::vector<ignition::math::Vector3d> normals;
 
-  /// \brief the texture coordinate array
+  /// \brief the texture coordinate array, in DOUBLE_PRECISION
   public: std::vector<ignition::math::Vector2d> texCoords;
 
-  /// \brief the vertex index array
+  /// \brief the vertex index array, used unless shortIndices is in use
   public: std::vector<unsigned int> indices;
 
+  /// \brief Vertex positions, x y z for each vertex, in SINGLE_PRECISION
+  /// and HALF_PRECISION.
+  public: std::vector<float> vertexBuffer;
+
+  /// \brief Normals, x y z for each normal, in SINGLE_PRECISION.
+  public: std::vector<float> normalBuffer;
+
+  /// \brief Half precision normals, x y z for each normal, in
+  /// HALF_PRECISION.
+  public: std::vector<uint16_t> halfNormalBuffer;
+
+  /// \brief Texture coordinates, u v for each coordinate, in
+  /// SINGLE_PRECISION and HALF_PRECISION.
+  public: std::vector<float> texCoordBuffer;
+
+  /// \brief 16 bit vertex indices, used while useShortIndices is true.
+  public: std::vector<uint16_t> shortIndices;
+
+  /// \brief True if the indices are stored in shortIndices. Only possible
+  /// in the compact precisions.
+  public: bool useShortIndices = false;
+
+  /// \brief Precision of the vertex attributes
+  public: SubMesh::VertexPrecision precision = SubMesh::DOUBLE_PRECISION;
+
   /// \brief node assignment array
   public: std::vector<NodeAssignment> nodeAssignments;
 
@@ -55,6 +247,310 @@ class ignition::common::SubMeshPrivate
   public: std::string name;
 };
 
+//////////////////////////////////////////////////
+size_t SubMeshPrivate::VertexCount() const
+{
+  if (this->precision == SubMesh::DOUBLE_PRECISION)
+    return this->vertices.size();
+  return this->vertexBuffer.size() / 3;
+}
+
+//////////////////////////////////////////////////
+math::Vector3d SubMeshPrivate::VertexAt(const size_t _index) const
+{
+  if (this->precision == SubMesh::DOUBLE_PRECISION)
+    return this->vertices[_index];
+
+  const float *v = &this->vertexBuffer[_index * 3];
+  return math::Vector3d(v[0], v[1], v[2]);
+}
+
+//////////////////////////////////////////////////
+void SubMeshPrivate::SetVertexAt(const size_t _index,
+    const math::Vector3d &_v)
+{
+  if (this->precision == SubMesh::DOUBLE_PRECISION)
+  {
+    this->vertices[_index] = _v;
+    return;
+  }
+
+  float *v = &this->vertexBuffer[_index * 3];
+  v[0] = static_cast<float>(_v.X());
+  v[1] = static_cast<float>(_v.Y());
+  v[2] = static_cast<float>(_v.Z());
+}
+
+//////////////////////////////////////////////////
+void SubMeshPrivate::PushVertex(const math::Vector3d &_v)
+{
+  if (this->precision == SubMesh::DOUBLE_PRECISION)
+  {
+    this->vertices.push_back(_v);
+    return;
+  }
+
+  this->vertexBuffer.push_back(static_cast<float>(_v.X()));
+  this->vertexBuffer.push_back(static_cast<float>(_v.Y()));
+  this->vertexBuffer.push_back(static_cast<float>(_v.Z()));
+}
+
+//////////////////////////////////////////////////
+size_t SubMeshPrivate::NormalCount() const
+{
+  switch (this->precision)
+  {
+    case SubMesh::SINGLE_PRECISION:
+      return this->normalBuffer.size() / 3;
+    case SubMesh::HALF_PRECISION:
+      return this->halfNormalBuffer.size() / 3;
+    default:
+      return this->normals.size();
+  }
+}
+
+//////////////////////////////////////////////////
+math::Vector3d SubMeshPrivate::NormalAt(const size_t _index) const
+{
+  switch (this->precision)
+  {
+    case SubMesh::SINGLE_PRECISION:
+    {
+      const float *n = &this->normalBuffer[_index * 3];
+      return math::Vector3d(n[0], n[1], n[2]);
+    }
+    case SubMesh::HALF_PRECISION:
+    {
+      const uint16_t *n = &this->halfNormalBuffer[_index * 3];
+      return math::Vector3d(halfToFloat(n[0]), halfToFloat(n[1]),
+          halfToFloat(n[2]));
+    }
+    default:
+      return this->normals[_index];
+  }
+}
+
+//////////////////////////////////////////////////
+void SubMeshPrivate::SetNormalAt(const size_t _index,
+    const math::Vector3d &_n)
+{
+  switch (this->precision)
+  {
+    case SubMesh::SINGLE_PRECISION:
+    {
+      float *n = &this->normalBuffer[_index * 3];
+      n[0] = static_cast<float>(_n.X());
+      n[1] = static_cast<float>(_n.Y());
+      n[2] = static_cast<float>(_n.Z());
+      break;
+    }
+    case SubMesh::HALF_PRECISION:
+    {
+      uint16_t *n = &this->halfNormalBuffer[_index * 3];
+      n[0] = floatToHalf(static_cast<float>(_n.X()));
+      n[1] = floatToHalf(static_cast<float>(_n.Y()));
+      n[2] = floatToHalf(static_cast<float>(_n.Z()));
+      break;
+    }
+    default:
+      this->normals[_index] = _n;
+      break;
+  }
+}
+
+//////////////////////////////////////////////////
+void SubMeshPrivate::PushNormal(const math::Vector3d &_n)
+{
+  this->ResizeNormals(this->NormalCount() + 1);
+  this->SetNormalAt(this->NormalCount() - 1, _n);
+}
+
+//////////////////////////////////////////////////
+void SubMeshPrivate::ResizeNormals(const size_t _count)
+{
+  switch (this->precision)
+  {
+    case SubMesh::SINGLE_PRECISION:
+      this->normalBuffer.resize(_count * 3, 0.0f);
+      break;
+    case SubMesh::HALF_PRECISION:
+      // Half precision zero is all bits cleared
+      this->halfNormalBuffer.resize(_count * 3, 0u);
+      break;
+    default:
+      this->normals.resize(_count);
+      break;
+  }
+}
+
+//////////////////////////////////////////////////
+size_t SubMeshPrivate::TexCoordCount() const
+{
+  if (this->precision == SubMesh::DOUBLE_PRECISION)
+    return this->texCoords.size();
+  return this->texCoordBuffer.size() / 2;
+}
+
+//////////////////////////////////////////////////
+math::Vector2d SubMeshPrivate::TexCoordAt(const size_t _index) const
+{
+  if (this->precision == SubMesh::DOUBLE_PRECISION)
+    return this->texCoords[_index];
+
+  const float *uv = &this->texCoordBuffer[_index * 2];
+  return math::Vector2d(uv[0], uv[1]);
+}
+
+//////////////////////////////////////////////////
+void SubMeshPrivate::SetTexCoordAt(const size_t _index,
+    const math::Vector2d &_uv)
+{
+  if (this->precision == SubMesh::DOUBLE_PRECISION)
+  {
+    this->texCoords[_index] = _uv;
+    return;
+  }
+
+  float *uv = &this->texCoordBuffer[_index * 2];
+  uv[0] = static_cast<float>(_uv.X());
+  uv[1] = static_cast<float>(_uv.Y());
+}
+
+//////////////////////////////////////////////////
+void SubMeshPrivate::PushTexCoord(const math::Vector2d &_uv)
+{
+  if (this->precision == SubMesh::DOUBLE_PRECISION)
+  {
+    this->texCoords.push_back(_uv);
+    return;
+  }
+
+  this->texCoordBuffer.push_back(static_cast<float>(_uv.X()));
+  this->texCoordBuffer.push_back(static_cast<float>(_uv.Y()));
+}
+
+//////////////////////////////////////////////////
+void SubMeshPrivate::ClearTexCoords()
+{
+  this->texCoords.clear();
+  this->texCoordBuffer.clear();
+}
+
+//////////////////////////////////////////////////
+size_t SubMeshPrivate::IndexCount() const
+{
+  if (this->useShortIndices)
+    return this->shortIndices.size();
+  return this->indices.size();
+}
+
+//////////////////////////////////////////////////
+unsigned int SubMeshPrivate::IndexAt(const size_t _index) const
+{
+  if (this->useShortIndices)
+    return this->shortIndices[_index];
+  return this->indices[_index];
+}
+
+//////////////////////////////////////////////////
+void SubMeshPrivate::SetIndexAt(const size_t _index, const unsigned int _i)
+{
+  if (this->useShortIndices && _i > kMaxShortIndex)
+    this->PromoteIndices();
+
+  if (this->useShortIndices)
+    this->shortIndices[_index] = static_cast<uint16_t>(_i);
+  else
+    this->indices[_index] = _i;
+}
+
+//////////////////////////////////////////////////
+void SubMeshPrivate::PushIndex(const unsigned int _i)
+{
+  if (this->useShortIndices && _i > kMaxShortIndex)
+    this->PromoteIndices();
+
+  if (this->useShortIndices)
+    this->shortIndices.push_back(static_cast<uint16_t>(_i));
+  else
+    this->indices.push_back(_i);
+}
+
+//////////////////////////////////////////////////
+void SubMeshPrivate::PromoteIndices()
+{
+  this->indices.assign(this->shortIndices.begin(), this->shortIndices.end());
+  this->shortIndices.clear();
+  this->shortIndices.shrink_to_fit();
+  this->useShortIndices = false;
+}
+
+//////////////////////////////////////////////////
+void SubMeshPrivate::SetPrecision(const SubMesh::VertexPrecision _precision)
+{
+  if (_precision == this->precision)
+    return;
+
+  std::vector<math::Vector3d> oldVertices(this->VertexCount());
+  for (size_t i = 0; i < oldVertices.size(); ++i)
+    oldVertices[i] = this->VertexAt(i);
+
+  std::vector<math::Vector3d> oldNormals(this->NormalCount());
+  for (size_t i = 0; i < oldNormals.size(); ++i)
+    oldNormals[i] = this->NormalAt(i);
+
+  std::vector<math::Vector2d> oldTexCoords(this->TexCoordCount());
+  for (size_t i = 0; i < oldTexCoords.size(); ++i)
+    oldTexCoords[i] = this->TexCoordAt(i);
+
+  std::vector<unsigned int> oldIndices(this->IndexCount());
+  for (size_t i = 0; i < oldIndices.size(); ++i)
+    oldIndices[i] = this->IndexAt(i);
+
+  // Release the storage of the previous precision
+  std::vector<math::Vector3d>().swap(this->vertices);
+  std::vector<math::Vector3d>().swap(this->normals);
+  std::vector<math::Vector2d>().swap(this->texCoords);
+  std::vector<unsigned int>().swap(this->indices);
+  std::vector<float>().swap(this->vertexBuffer);
+  std::vector<float>().swap(this->normalBuffer);
+  std::vector<uint16_t>().swap(this->halfNormalBuffer);
+  std::vector<float>().swap(this->texCoordBuffer);
+  std::vector<uint16_t>().swap(this->shortIndices);
+
+  this->precision = _precision;
+
+  if (this->precision == SubMesh::DOUBLE_PRECISION)
+  {
+    this->vertices = std::move(oldVertices);
+    this->normals = std::move(oldNormals);
+    this->texCoords = std::move(oldTexCoords);
+    this->indices = std::move(oldIndices);
+    this->useShortIndices = false;
+    return;
+  }
+
+  this->vertexBuffer.reserve(oldVertices.size() * 3);
+  for (const auto &v : oldVertices)
+    this->PushVertex(v);
+
+  this->ResizeNormals(oldNormals.size());
+  for (size_t i = 0; i < oldNormals.size(); ++i)
+    this->SetNormalAt(i, oldNormals[i]);
+
+  this->texCoordBuffer.reserve(oldTexCoords.size() * 2);
+  for (const auto &uv : oldTexCoords)
+    this->PushTexCoord(uv);
+
+  auto maxIter = std::max_element(oldIndices.begin(), oldIndices.end());
+  this->useShortIndices =
+      maxIter == oldIndices.end() || *maxIter <= kMaxShortIndex;
+  if (this->useShortIndices)
+    this->shortIndices.assign(oldIndices.begin(), oldIndices.end());
+  else
+    this->indices = std::move(oldIndices);
+}
+
 //////////////////////////////////////////////////
 SubMesh::SubMesh()
 : dataPtr(new SubMeshPrivate)
@@ -70,36 +566,13 @@ SubMesh::SubMesh(const std::string &_name)
 
 //////////////////////////////////////////////////
 SubMesh::SubMesh(const SubMesh &_submesh)
-: dataPtr(new SubMeshPrivate)
+: dataPtr(new SubMeshPrivate(*_submesh.dataPtr))
 {
-  this->dataPtr->name = _submesh.dataPtr->name;
-  this->dataPtr->materialIndex = _submesh.dataPtr->materialIndex;
-  this->dataPtr->primitiveType = _submesh.dataPtr->primitiveType;
-
-  std::copy(_submesh.dataPtr->nodeAssignments.begin(),
-      _submesh.dataPtr->nodeAssignments.end(),
-      std::back_inserter(this->dataPtr->nodeAssignments));
-
-  std::copy(_submesh.dataPtr->indices.begin(),
-      _submesh.dataPtr->indices.end(),
-      std::back_inserter(this->dataPtr->indices));
-  std::copy(_submesh.dataPtr->normals.begin(),
-      _submesh.dataPtr->normals.end(),
-      std::back_inserter(this->dataPtr->normals));
-  std::copy(_submesh.dataPtr->texCoords.begin(),
-      _submesh.dataPtr->texCoords.end(),
-      std::back_inserter(this->dataPtr->texCoords));
-  std::copy(_submesh.dataPtr->vertices.begin(),
-      _submesh.dataPtr->vertices.end(),
-      std::back_inserter(this->dataPtr->vertices));
 }
 
 //////////////////////////////////////////////////
 SubMesh::~SubMesh()
 {
-  this->dataPtr->vertices.clear();
-  this->dataPtr->indices.clear();
-  this->dataPtr->nodeAssignments.clear();
 }
 
 //////////////////////////////////////////////////
@@ -114,16 +587,28 @@ SubMesh::PrimitiveType SubMesh::SubMeshPrimitiveType() const
   return this->dataPtr->primitiveType;
 }
 
+//////////////////////////////////////////////////
+void SubMesh::SetVertexPrecision(const VertexPrecision _precision)
+{
+  this->dataPtr->SetPrecision(_precision);
+}
+
+//////////////////////////////////////////////////
+SubMesh::VertexPrecision SubMesh::SubMeshVertexPrecision() const
+{
+  return this->dataPtr->precision;
+}
+
 //////////////////////////////////////////////////
 void SubMesh::AddIndex(const unsigned int _index)
 {
-  this->dataPtr->indices.push_back(_index);
+  this->dataPtr->PushIndex(_index);
 }
 
 //////////////////////////////////////////////////
 void SubMesh::AddVertex(const ignition::math::Vector3d &_v)
 {
-  this->dataPtr->vertices.push_back(_v);
+  this->dataPtr->PushVertex(_v);
 }
 
 //////////////////////////////////////////////////
@@ -135,7 +620,7 @@ void SubMesh::AddVertex(const double _x, const double _y, const double _z)
 //////////////////////////////////////////////////
 void SubMesh::AddNormal(const ignition::math::Vector3d &_n)
 {
-  this->dataPtr->normals.push_back(_n);
+  this->dataPtr->PushNormal(_n);
 }
 
 //////////////////////////////////////////////////
@@ -147,13 +632,13 @@ void SubMesh::AddNormal(const double _x, const double _y, const double _z)
 //////////////////////////////////////////////////
 void SubMesh::AddTexCoord(const double _u, const double _v)
 {
-  this->dataPtr->texCoords.push_back(ignition::math::Vector2d(_u, _v));
+  this->dataPtr->PushTexCoord(ignition::math::Vector2d(_u, _v));
 }
 
 //////////////////////////////////////////////////
 void SubMesh::AddTexCoord(const ignition::math::Vector2d &_uv)
 {
-  this->dataPtr->texCoords.push_back(_uv);
+  this->dataPtr->PushTexCoord(_uv);
 }
 
 //////////////////////////////////////////////////
@@ -171,56 +656,56 @@ void SubMesh::AddNodeAssignment(const unsigned int _vertex,
 //////////////////////////////////////////////////
 ignition::math::Vector3d SubMesh::Vertex(const unsigned int _index) const
 {
-  if (_index >= this->dataPtr->vertices.size())
+  if (_index >= this->dataPtr->VertexCount())
   {
     ignerr << "Index too large" << std::endl;
     return math::Vector3d::Zero;
   }
 
-  return this->dataPtr->vertices[_index];
+  return this->dataPtr->VertexAt(_index);
 }
 
 //////////////////////////////////////////////////
 bool SubMesh::HasVertex(const unsigned int _index) const
 {
-  return _index < this->dataPtr->vertices.size();
+  return _index < this->dataPtr->VertexCount();
 }
 
 //////////////////////////////////////////////////
 void SubMesh::SetVertex(const unsigned int _index,
     const ignition::math::Vector3d &_v)
 {
-  if (_index >= this->dataPtr->vertices.size())
+  if (_index >= this->dataPtr->VertexCount())
   {
     ignerr << "Index too large" << std::endl;
     return;
   }
 
-  this->dataPtr->vertices[_index] = _v;
+  this->dataPtr->SetVertexAt(_index, _v);
 }
 
 //////////////////////////////////////////////////
 ignition::math::Vector3d SubMesh::Normal(const unsigned int _index) const
 {
-  if (_index >= this->dataPtr->normals.size())
+  if (_index >= this->dataPtr->NormalCount())
   {
     ignerr << "Index too large" << std::endl;
     return math::Vector3d::Zero;
   }
 
-  return this->dataPtr->normals[_index];
+  return this->dataPtr->NormalAt(_index);
 }
 
 //////////////////////////////////////////////////
 bool SubMesh::HasNormal(const unsigned int _index) const
 {
-  return _index < this->dataPtr->normals.size();
+  return _index < this->dataPtr->NormalCount();
 }
 
 //////////////////////////////////////////////////
 bool SubMesh::HasTexCoord(const unsigned int _index) const
 {
-  return _index < this->dataPtr->texCoords.size();
+  return _index < this->dataPtr->TexCoordCount();
 }
 
 //////////////////////////////////////////////////
@@ -233,62 +718,62 @@ bool SubMesh::HasNodeAssignment(const unsigned int _index) const
 void SubMesh::SetNormal(const unsigned int _index,
     const ignition::math::Vector3d &_n)
 {
-  if (_index >= this->dataPtr->normals.size())
+  if (_index >= this->dataPtr->NormalCount())
   {
     ignerr << "Index too large" << std::endl;
     return;
   }
 
-  this->dataPtr->normals[_index] = _n;
+  this->dataPtr->SetNormalAt(_index, _n);
 }
 
 //////////////////////////////////////////////////
 ignition::math::Vector2d SubMesh::TexCoord(const unsigned int _index) const
 {
-  if (_index >= this->dataPtr->texCoords.size())
+  if (_index >= this->dataPtr->TexCoordCount())
   {
     ignerr << "Index too large" << std::endl;
     return math::Vector2d::Zero;
   }
 
-  return this->dataPtr->texCoords[_index];
+  return this->dataPtr->TexCoordAt(_index);
 }
 
 //////////////////////////////////////////////////
 void SubMesh::SetTexCoord(const unsigned int _index,
     const ignition::math::Vector2d &_t)
 {
-  if (_index >= this->dataPtr->texCoords.size())
+  if (_index >= this->dataPtr->TexCoordCount())
   {
     ignerr << "Index too large" << std::endl;
     return;
   }
 
-  this->dataPtr->texCoords[_index] = _t;
+  this->dataPtr->SetTexCoordAt(_index, _t);
 }
 
 //////////////////////////////////////////////////
 int SubMesh::Index(const unsigned int _index) const
 {
-  if (_index >= this->dataPtr->indices.size())
+  if (_index >= this->dataPtr->IndexCount())
   {
     ignerr << "Index too large" << std::endl;
     return -1;
   }
 
-  return this->dataPtr->indices[_index];
+  return this->dataPtr->IndexAt(_index);
 }
 
 //////////////////////////////////////////////////
 void SubMesh::SetIndex(const unsigned int _index, const unsigned int _i)
 {
-  if (_index >= this->dataPtr->indices.size())
+  if (_index >= this->dataPtr->IndexCount())
   {
     ignerr << "Index too large" << std::endl;
     return;
   }
 
-  this->dataPtr->indices[_index] = _i;
+  this->dataPtr->SetIndexAt(_index, _i);
 }
 
 //////////////////////////////////////////////////
@@ -307,7 +792,7 @@ NodeAssignment SubMesh::NodeAssignmentByIndex(
 //////////////////////////////////////////////////
 ignition::math::Vector3d SubMesh::Max() const
 {
-  if (this->dataPtr->vertices.empty())
+  if (this->dataPtr->VertexCount() == 0u)
     return ignition::math::Vector3d::Zero;
 
   ignition::math::Vector3d max;
@@ -316,8 +801,9 @@ ignition::math::Vector3d SubMesh::Max() const
   max.Y(-ignition::math::MAX_F);
   max.Z(-ignition::math::MAX_F);
 
-  for (const auto &v : this->dataPtr->vertices)
+  for (size_t i = 0; i < this->dataPtr->VertexCount(); ++i)
   {
+    ignition::math::Vector3d v = this->dataPtr->VertexAt(i);
     max.X(std::max(max.X(), v.X()));
     max.Y(std::max(max.Y(), v.Y()));
     max.Z(std::max(max.Z(), v.Z()));
@@ -329,7 +815,7 @@ ignition::math::Vector3d SubMesh::Max() const
 //////////////////////////////////////////////////
 ignition::math::Vector3d SubMesh::Min() const
 {
-  if (this->dataPtr->vertices.empty())
+  if (this->dataPtr->VertexCount() == 0u)
     return ignition::math::Vector3d::Zero;
 
   ignition::math::Vector3d min;
@@ -338,8 +824,9 @@ ignition::math::Vector3d SubMesh::Min() const
   min.Y(ignition::math::MAX_F);
   min.Z(ignition::math::MAX_F);
 
-  for (const auto &v : this->dataPtr->vertices)
+  for (size_t i = 0; i < this->dataPtr->VertexCount(); ++i)
   {
+    ignition::math::Vector3d v = this->dataPtr->VertexAt(i);
     min.X(std::min(min.X(), v.X()));
     min.Y(std::min(min.Y(), v.Y()));
     min.Z(std::min(min.Z(), v.Z()));
@@ -351,25 +838,25 @@ ignition::math::Vector3d SubMesh::Min() const
 //////////////////////////////////////////////////
 unsigned int SubMesh::VertexCount() const
 {
-  return this->dataPtr->vertices.size();
+  return this->dataPtr->VertexCount();
 }
 
 //////////////////////////////////////////////////
 unsigned int SubMesh::NormalCount() const
 {
-  return this->dataPtr->normals.size();
+  return this->dataPtr->NormalCount();
 }
 
 //////////////////////////////////////////////////
 unsigned int SubMesh::IndexCount() const
 {
-  return this->dataPtr->indices.size();
+  return this->dataPtr->IndexCount();
 }
 
 //////////////////////////////////////////////////
 unsigned int SubMesh::TexCoordCount() const
 {
-  return this->dataPtr->texCoords.size();
+  return this->dataPtr->TexCoordCount();
 }
 
 //////////////////////////////////////////////////
@@ -381,6 +868,17 @@ unsigned int SubMesh::NodeAssignmentsCount() const
 //////////////////////////////////////////////////
 unsigned int SubMesh::MaxIndex() const
 {
+  if (this->dataPtr->useShortIndices)
+  {
+    auto maxIter = std::max_element(this->dataPtr->shortIndices.begin(),
+        this->dataPtr->shortIndices.end());
+
+    if (maxIter != this->dataPtr->shortIndices.end())
+      return *maxIter;
+
+    return 0;
+  }
+
   auto maxIter = std::max_element(this->dataPtr->indices.begin(),
       this->dataPtr->indices.end());
 
@@ -390,6 +888,54 @@ unsigned int SubMesh::MaxIndex() const
   return 0;
 }
 
+//////////////////////////////////////////////////
+const float *SubMesh::VertexBuffer() const
+{
+  if (this->dataPtr->precision == DOUBLE_PRECISION)
+    return nullptr;
+  return this->dataPtr->vertexBuffer.data();
+}
+
+//////////////////////////////////////////////////
+const float *SubMesh::NormalBuffer() const
+{
+  if (this->dataPtr->precision != SINGLE_PRECISION)
+    return nullptr;
+  return this->dataPtr->normalBuffer.data();
+}
+
+//////////////////////////////////////////////////
+const uint16_t *SubMesh::HalfNormalBuffer() const
+{
+  if (this->dataPtr->precision != HALF_PRECISION)
+    return nullptr;
+  return this->dataPtr->halfNormalBuffer.data();
+}
+
+//////////////////////////////////////////////////
+const float *SubMesh::TexCoordBuffer() const
+{
+  if (this->dataPtr->precision == DOUBLE_PRECISION)
+    return nullptr;
+  return this->dataPtr->texCoordBuffer.data();
+}
+
+//////////////////////////////////////////////////
+const unsigned int *SubMesh::IndexBuffer() const
+{
+  if (this->dataPtr->useShortIndices)
+    return nullptr;
+  return this->dataPtr->indices.data();
+}
+
+//////////////////////////////////////////////////
+const uint16_t *SubMesh::ShortIndexBuffer() const
+{
+  if (!this->dataPtr->useShortIndices)
+    return nullptr;
+  return this->dataPtr->shortIndices.data();
+}
+
 //////////////////////////////////////////////////
 void SubMesh::SetMaterialIndex(const unsigned int _index)
 {
@@ -405,21 +951,16 @@ unsigned int SubMesh::MaterialIndex() const
 //////////////////////////////////////////////////
 bool SubMesh::HasVertex(const ignition::math::Vector3d &_v) const
 {
-  for (const auto &v : this->dataPtr->vertices)
-    if (_v.Equal(v))
-      return true;
-
-  return false;
+  return this->IndexOfVertex(_v) >= 0;
 }
 
 //////////////////////////////////////////////////
 int SubMesh::IndexOfVertex(const ignition::math::Vector3d &_v) const
 {
-  for (auto iter = this->dataPtr->vertices.begin();
-      iter != this->dataPtr->vertices.end(); ++iter)
+  for (size_t i = 0; i < this->dataPtr->VertexCount(); ++i)
   {
-    if (_v.Equal(*iter))
-      return iter - this->dataPtr->vertices.begin();
+    if (_v.Equal(this->dataPtr->VertexAt(i)))
+      return static_cast<int>(i);
   }
   return -1;
 }
@@ -427,7 +968,8 @@ int SubMesh::IndexOfVertex(const ignition::math::Vector3d &_v) const
 //////////////////////////////////////////////////
 void SubMesh::FillArrays(double **_vertArr, int **_indArr) const
 {
-  if (this->dataPtr->vertices.empty() || this->dataPtr->indices.empty())
+  if (this->dataPtr->VertexCount() == 0u ||
+      this->dataPtr->IndexCount() == 0u)
   {
     ignerr << "No vertices or indices\n";
     return;
@@ -439,72 +981,69 @@ void SubMesh::FillArrays(double **_vertArr, int **_indArr) const
   if (*_indArr)
     delete [] *_indArr;
 
-  *_vertArr = new double[this->dataPtr->vertices.size() * 3];
-  *_indArr = new int[this->dataPtr->indices.size()];
+  *_vertArr = new double[this->dataPtr->VertexCount() * 3];
+  *_indArr = new int[this->dataPtr->IndexCount()];
 
   unsigned int vi = 0;
-  for (auto &v : this->dataPtr->vertices)
+  for (size_t i = 0; i < this->dataPtr->VertexCount(); ++i)
   {
+    ignition::math::Vector3d v = this->dataPtr->VertexAt(i);
     (*_vertArr)[vi++] = static_cast<float>(v.X());
     (*_vertArr)[vi++] = static_cast<float>(v.Y());
     (*_vertArr)[vi++] = static_cast<float>(v.Z());
   }
 
-  unsigned int ii = 0;
-  for (auto &i : this->dataPtr->indices)
-  {
-    (*_indArr)[ii++] = i;
-  }
+  for (size_t i = 0; i < this->dataPtr->IndexCount(); ++i)
+    (*_indArr)[i] = this->dataPtr->IndexAt(i);
 }
 
 //////////////////////////////////////////////////
 void SubMesh::RecalculateNormals()
 {
-  if (this->dataPtr->normals.size() < 3u)
+  if (this->dataPtr->NormalCount() < 3u)
     return;
 
-  // Reset all the normals
-  for (auto &n : this->dataPtr->normals)
-    n.Set(0, 0, 0);
+  const size_t vertexCount = this->dataPtr->VertexCount();
+  std::vector<ignition::math::Vector3d> vertices(vertexCount);
+  for (size_t j = 0; j < vertexCount; ++j)
+    vertices[j] = this->dataPtr->VertexAt(j);
 
-  if (this->dataPtr->normals.size() != this->dataPtr->vertices.size())
-    this->dataPtr->normals.resize(this->dataPtr->vertices.size());
+  std::vector<ignition::math::Vector3d> normals(vertexCount,
+      ignition::math::Vector3d::Zero);
 
   // For each face, which is defined by three indices, calculate the normals
-  for (unsigned int i = 0; i < this->dataPtr->indices.size(); i+= 3)
+  for (size_t i = 0; i + 2 < this->dataPtr->IndexCount(); i += 3)
   {
-    ignition::math::Vector3d v1 =
-        this->dataPtr->vertices[this->dataPtr->indices[i]];
-    ignition::math::Vector3d v2 =
-        this->dataPtr->vertices[this->dataPtr->indices[i+1]];
-    ignition::math::Vector3d v3 =
-        this->dataPtr->vertices[this->dataPtr->indices[i+2]];
+    ignition::math::Vector3d v1 = vertices[this->dataPtr->IndexAt(i)];
+    ignition::math::Vector3d v2 = vertices[this->dataPtr->IndexAt(i+1)];
+    ignition::math::Vector3d v3 = vertices[this->dataPtr->IndexAt(i+2)];
     ignition::math::Vector3d n = ignition::math::Vector3d::Normal(v1, v2, v3);
 
-    for (unsigned int j = 0; j < this->dataPtr->vertices.size(); ++j)
+    for (size_t j = 0; j < vertexCount; ++j)
     {
-      ignition::math::Vector3d v = this->dataPtr->vertices[j];
+      const ignition::math::Vector3d &v = vertices[j];
       if (v == v1 || v == v2 || v == v3)
       {
-        this->dataPtr->normals[j] += n;
+        normals[j] += n;
       }
     }
   }
 
   // Normalize the results
-  for (auto &n : this->dataPtr->normals)
-  {
-    n.Normalize();
-  }
+  this->dataPtr->ResizeNormals(vertexCount);
+  for (size_t j = 0; j < vertexCount; ++j)
+    this->dataPtr->SetNormalAt(j, normals[j].Normalize());
 }
 
 //////////////////////////////////////////////////
 void SubMesh::GenSphericalTexCoord(const ignition::math::Vector3d &_center)
 {
-  this->dataPtr->texCoords.clear();
+  this->dataPtr->ClearTexCoords();
 
-  for (const auto &vert : this->dataPtr->vertices)
+  for (size_t i = 0; i < this->dataPtr->VertexCount(); ++i)
   {
+    ignition::math::Vector3d vert = this->dataPtr->VertexAt(i);
+
     // generate projected texture coordinates, projected from center
     //  x, y, z for computing texture coordinate projections
     double x = vert.X() - _center.X();
@@ -523,15 +1062,15 @@ void SubMesh::GenSphericalTexCoord(const ignition::math::Vector3d &_center)
 //////////////////////////////////////////////////
 void SubMesh::Scale(const ignition::math::Vector3d &_factor)
 {
-  for (auto &v : this->dataPtr->vertices)
-    v *= _factor;
+  for (size_t i = 0; i < this->dataPtr->VertexCount(); ++i)
+    this->dataPtr->SetVertexAt(i, this->dataPtr->VertexAt(i) * _factor);
 }
 
 //////////////////////////////////////////////////
 void SubMesh::Scale(const double &_factor)
 {
-  for (auto &v : this->dataPtr->vertices)
-    v *= _factor;
+  for (size_t i = 0; i < this->dataPtr->VertexCount(); ++i)
+    this->dataPtr->SetVertexAt(i, this->dataPtr->VertexAt(i) * _factor);
 }
 
 //////////////////////////////////////////////////
@@ -548,8 +1087,8 @@ void SubMesh::Center(const ignition::math::Vector3d &_center)
 //////////////////////////////////////////////////
 void SubMesh::Translate(const ignition::math::Vector3d &_vec)
 {
-  for (auto &v : this->dataPtr->vertices)
-    v += _vec;
+  for (size_t i = 0; i < this->dataPtr->VertexCount(); ++i)
+    this->dataPtr->SetVertexAt(i, this->dataPtr->VertexAt(i) + _vec);
 }
 
 //////////////////////////////////////////////////
@@ -345,6 +345,143 @@ TEST_F(SubMeshTest, SubMesh)
   }
 }
 
+/////////////////////////////////////////////////
+TEST_F(SubMeshTest, VertexPrecision)
+{
+  common::SubMesh submesh;
+  EXPECT_EQ(common::SubMesh::DOUBLE_PRECISION,
+      submesh.SubMeshVertexPrecision());
+
+  submesh.AddVertex(0.1, 0.2, 0.3);
+  submesh.AddVertex(1.5, -2.25, 3.0);
+  submesh.AddVertex(-4, 5, 6);
+  submesh.AddNormal(0, 0, 1);
+  submesh.AddNormal(0.6, 0.8, 0);
+  submesh.AddNormal(-1, 0, 0);
+  submesh.AddTexCoord(0.25, 0.75);
+  submesh.AddTexCoord(0.5, 1.0);
+  submesh.AddTexCoord(0.1, 0.3);
+  submesh.AddIndex(0);
+  submesh.AddIndex(1);
+  submesh.AddIndex(2);
+
+  // Double precision has no float buffers, and 32 bit indices
+  EXPECT_EQ(nullptr, submesh.VertexBuffer());
+  EXPECT_EQ(nullptr, submesh.NormalBuffer());
+  EXPECT_EQ(nullptr, submesh.HalfNormalBuffer());
+  EXPECT_EQ(nullptr, submesh.TexCoordBuffer());
+  EXPECT_EQ(nullptr, submesh.ShortIndexBuffer());
+  ASSERT_NE(nullptr, submesh.IndexBuffer());
+  EXPECT_EQ(2u, submesh.IndexBuffer()[2]);
+
+  // Single precision
+  submesh.SetVertexPrecision(common::SubMesh::SINGLE_PRECISION);
+  EXPECT_EQ(common::SubMesh::SINGLE_PRECISION,
+      submesh.SubMeshVertexPrecision());
+  EXPECT_EQ(3u, submesh.VertexCount());
+  EXPECT_EQ(3u, submesh.NormalCount());
+  EXPECT_EQ(3u, submesh.TexCoordCount());
+  EXPECT_EQ(3u, submesh.IndexCount());
+
+  const float *vertices = submesh.VertexBuffer();
+  ASSERT_NE(nullptr, vertices);
+  EXPECT_FLOAT_EQ(1.5f, vertices[3]);
+  EXPECT_FLOAT_EQ(-2.25f, vertices[4]);
+  EXPECT_FLOAT_EQ(6.0f, vertices[8]);
+  EXPECT_NEAR(0.1, submesh.Vertex(0).X(), 1e-6);
+
+  const float *normals = submesh.NormalBuffer();
+  ASSERT_NE(nullptr, normals);
+  EXPECT_EQ(nullptr, submesh.HalfNormalBuffer());
+  EXPECT_FLOAT_EQ(0.8f, normals[4]);
+
+  const float *texCoords = submesh.TexCoordBuffer();
+  ASSERT_NE(nullptr, texCoords);
+  EXPECT_FLOAT_EQ(0.5f, texCoords[2]);
+  EXPECT_FLOAT_EQ(1.0f, texCoords[3]);
+
+  EXPECT_EQ(nullptr, submesh.IndexBuffer());
+  const uint16_t *shortIndices = submesh.ShortIndexBuffer();
+  ASSERT_NE(nullptr, shortIndices);
+  EXPECT_EQ(0u, shortIndices[0]);
+  EXPECT_EQ(2u, shortIndices[2]);
+  EXPECT_EQ(2u, submesh.MaxIndex());
+
+  // Setters write to the float buffers
+  submesh.SetVertex(2, math::Vector3d(7, 8, 9));
+  EXPECT_FLOAT_EQ(7.0f, submesh.VertexBuffer()[6]);
+  EXPECT_EQ(math::Vector3d(7, 8, 9), submesh.Vertex(2));
+  submesh.SetTexCoord(0, math::Vector2d(0.125, 0.5));
+  EXPECT_EQ(math::Vector2d(0.125, 0.5), submesh.TexCoord(0));
+
+  // Half precision normals
+  submesh.SetVertexPrecision(common::SubMesh::HALF_PRECISION);
+  EXPECT_EQ(nullptr, submesh.NormalBuffer());
+  const uint16_t *halfNormals = submesh.HalfNormalBuffer();
+  ASSERT_NE(nullptr, halfNormals);
+  // 1.0 and -1.0 in binary16
+  EXPECT_EQ(0x3c00u, halfNormals[2]);
+  EXPECT_EQ(0xbc00u, halfNormals[6]);
+  EXPECT_NEAR(0.6, submesh.Normal(1).X(), 1e-3);
+  EXPECT_NEAR(0.8, submesh.Normal(1).Y(), 1e-3);
+  EXPECT_EQ(math::Vector3d(0, 0, 1), submesh.Normal(0));
+  EXPECT_NE(nullptr, submesh.VertexBuffer());
+  EXPECT_NE(nullptr, submesh.ShortIndexBuffer());
+
+  submesh.AddNormal(0, -0.5, 0.25);
+  EXPECT_EQ(4u, submesh.NormalCount());
+  EXPECT_EQ(math::Vector3d(0, -0.5, 0.25), submesh.Normal(3));
+  submesh.SetNormal(3, math::Vector3d(1, 0, 0));
+  EXPECT_EQ(math::Vector3d(1, 0, 0), submesh.Normal(3));
+
+  // Recalculating the normals keeps them in half precision
+  submesh.RecalculateNormals();
+  EXPECT_EQ(3u, submesh.NormalCount());
+  EXPECT_NE(nullptr, submesh.HalfNormalBuffer());
+  EXPECT_NEAR(1.0, submesh.Normal(0).Length(), 1e-3);
+
+  // Indices that don't fit in 16 bits switch to 32 bit indices
+  submesh.AddIndex(70000);
+  EXPECT_EQ(nullptr, submesh.ShortIndexBuffer());
+  ASSERT_NE(nullptr, submesh.IndexBuffer());
+  EXPECT_EQ(4u, submesh.IndexCount());
+  EXPECT_EQ(1u, submesh.IndexBuffer()[1]);
+  EXPECT_EQ(70000u, submesh.IndexBuffer()[3]);
+  EXPECT_EQ(70000, submesh.Index(3));
+  EXPECT_EQ(70000u, submesh.MaxIndex());
+
+  // Copies keep the precision
+  common::SubMesh copy(submesh);
+  EXPECT_EQ(common::SubMesh::HALF_PRECISION, copy.SubMeshVertexPrecision());
+  EXPECT_EQ(submesh.Vertex(1), copy.Vertex(1));
+  EXPECT_EQ(submesh.Normal(1), copy.Normal(1));
+  EXPECT_EQ(submesh.TexCoord(1), copy.TexCoord(1));
+  EXPECT_EQ(submesh.Index(3), copy.Index(3));
+
+  // Back to double precision
+  submesh.SetVertexPrecision(common::SubMesh::DOUBLE_PRECISION);
+  EXPECT_EQ(nullptr, submesh.VertexBuffer());
+  EXPECT_EQ(nullptr, submesh.HalfNormalBuffer());
+  EXPECT_EQ(nullptr, submesh.ShortIndexBuffer());
+  EXPECT_EQ(math::Vector3d(7, 8, 9), submesh.Vertex(2));
+  EXPECT_EQ(70000, submesh.Index(3));
+  EXPECT_EQ(copy.Normal(1), submesh.Normal(1));
+
+  // Converting a mesh converts all its submeshes
+  common::Mesh mesh;
+  mesh.AddSubMesh(submesh);
+  mesh.AddSubMesh(copy);
+  mesh.SetVertexPrecision(common::SubMesh::SINGLE_PRECISION);
+  for (unsigned int i = 0; i < mesh.SubMeshCount(); ++i)
+  {
+    auto sub = mesh.SubMeshByIndex(i).lock();
+    ASSERT_NE(nullptr, sub);
+    EXPECT_EQ(common::SubMesh::SINGLE_PRECISION,
+        sub->SubMeshVertexPrecision());
+    EXPECT_NE(nullptr, sub->NormalBuffer());
+  }
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
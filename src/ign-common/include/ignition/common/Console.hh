@@ -17,6 +17,8 @@
 #ifndef IGNITION_COMMON_CONSOLE_HH_
 #define IGNITION_COMMON_CONSOLE_HH_
 
+#include <atomic>
+#include <cstdint>
 #include <iostream>
 #include <fstream>
 #include <sstream>
@@ -30,17 +32,92 @@ namespace ignition
 {
   namespace common
   {
+    /// \brief Highest level of the messages which are compiled. Messages of
+    /// a higher level cost nothing at run time, whatever the verbosity. For
+    /// example, compiling with -DIGN_CONSOLE_MAX_LEVEL=2 removes the ignmsg
+    /// and igndbg messages. Defaults to 4, which keeps all the messages.
+    #ifndef IGN_CONSOLE_MAX_LEVEL
+    #define IGN_CONSOLE_MAX_LEVEL 4
+    #endif
+
+    /// \brief Log a message to _logger only if _condition is true, without
+    /// evaluating the message otherwise. Used by the macros below.
+    #define IGN_CONSOLE_IF_(_condition, _logger) \
+        !(_condition) ? (void)0 : \
+        ignition::common::detail::ConsoleVoid() & _logger
+
+    /// \brief True at most once per _period seconds for each place where it
+    /// appears. Used by the macros below.
+    #define IGN_CONSOLE_THROTTLE_(_period) \
+        ([]() -> ignition::common::ConsoleThrottle & \
+         { \
+           static ignition::common::ConsoleThrottle throttle; \
+           return throttle; \
+         }().Allow(_period))
+
+    #if IGN_CONSOLE_MAX_LEVEL >= 1
     /// \brief Output an error message, if the verbose level is >= 1
     #define ignerr (ignition::common::Console::err(__FILE__, __LINE__))
+    #else
+    #define ignerr IGN_CONSOLE_IF_(false, \
+        ignition::common::Console::err(__FILE__, __LINE__))
+    #endif
 
+    #if IGN_CONSOLE_MAX_LEVEL >= 2
     /// \brief Output a warning message, if the verbose level is >= 2
     #define ignwarn (ignition::common::Console::warn(__FILE__, __LINE__))
+    #else
+    #define ignwarn IGN_CONSOLE_IF_(false, \
+        ignition::common::Console::warn(__FILE__, __LINE__))
+    #endif
 
+    #if IGN_CONSOLE_MAX_LEVEL >= 3
     /// \brief Output a message, if the verbose level is >= 3
     #define ignmsg (ignition::common::Console::msg())
+    #else
+    #define ignmsg IGN_CONSOLE_IF_(false, ignition::common::Console::msg())
+    #endif
 
+    #if IGN_CONSOLE_MAX_LEVEL >= 4
     /// \brief Output a debug message, if the verbose level is >= 4
     #define igndbg (ignition::common::Console::dbg(__FILE__, __LINE__))
+    #else
+    #define igndbg IGN_CONSOLE_IF_(false, \
+        ignition::common::Console::dbg(__FILE__, __LINE__))
+    #endif
+
+    /// \brief Output an error message at most once every _period seconds
+    /// from the same place, for messages which may repeat in a loop.
+    /// The message isn't evaluated when it's skipped.
+    /// \param[in] _period Minimum time between two messages, in seconds.
+    #define ignerrThrottle(_period) \
+        IGN_CONSOLE_IF_(IGN_CONSOLE_MAX_LEVEL >= 1 && \
+            IGN_CONSOLE_THROTTLE_(_period), \
+            ignition::common::Console::err(__FILE__, __LINE__))
+
+    /// \brief Output a warning message at most once every _period seconds
+    /// from the same place.
+    /// \param[in] _period Minimum time between two messages, in seconds.
+    #define ignwarnThrottle(_period) \
+        IGN_CONSOLE_IF_(IGN_CONSOLE_MAX_LEVEL >= 2 && \
+            IGN_CONSOLE_THROTTLE_(_period), \
+            ignition::common::Console::warn(__FILE__, __LINE__))
+
+    /// \brief Output a message at most once every _period seconds from the
+    /// same place.
+    /// \param[in] _period Minimum time between two messages, in seconds.
+    #define ignmsgThrottle(_period) \
+        IGN_CONSOLE_IF_(IGN_CONSOLE_MAX_LEVEL >= 3 && \
+            IGN_CONSOLE_THROTTLE_(_period), \
+            ignition::common::Console::msg())
+
+    /// \brief Output a debug message at most once every _period seconds
+    /// from the same place.
+    /// \param[in] _period Minimum time between two messages, in seconds.
+    #define igndbgThrottle(_period) \
+        IGN_CONSOLE_IF_(IGN_CONSOLE_MAX_LEVEL >= 4 && \
+            IGN_CONSOLE_THROTTLE_(_period), \
+            ignition::common::Console::dbg(__FILE__, __LINE__))
 
     /// \brief Output a message to a log file, regardless of verbosity level
     #define ignlog (ignition::common::Console::log())
@@ -198,6 +275,33 @@ namespace ignition
       IGN_COMMON_WARN_RESUME__DLL_INTERFACE_MISSING
     };
 
+    /// \brief Limits how often a message is logged, see ignwarnThrottle.
+    class IGNITION_COMMON_VISIBLE ConsoleThrottle
+    {
+      /// \brief Check whether a message can be logged now.
+      /// \param[in] _period Minimum time between two messages, in seconds.
+      /// \return True if no message was allowed during the last _period
+      /// seconds, in which case the current time is recorded.
+      public: bool Allow(const double _period);
+
+      IGN_COMMON_WARN_IGNORE__DLL_INTERFACE_MISSING
+      /// \brief Steady clock time of the last allowed message, in
+      /// nanoseconds, or INT64_MIN if there was none.
+      private: std::atomic<int64_t> last{INT64_MIN};
+      IGN_COMMON_WARN_RESUME__DLL_INTERFACE_MISSING
+    };
+
+    namespace detail
+    {
+      /// \brief Turns a logging expression into a void expression, so that
+      /// it can be one of the branches of a conditional operator.
+      class ConsoleVoid
+      {
+        /// \brief Ignore the stream.
+        public: void operator&(std::ostream &) {}
+      };
+    }
+
     /// \class Console Console.hh common/common.hh
     /// \brief Container for loggers, and global logging options
     /// (such as verbose vs. quiet output).
@@ -237,6 +341,31 @@ namespace ignition
       /// \sa void SetPrefix(const std::string &_customPrefix)
       public: static std::string Prefix();
 
+      /// \brief Enable or disable asynchronous logging. When enabled, the
+      /// loggers queue their output in a lock-free ring buffer and return
+      /// immediately, and a background thread writes it to the terminal and
+      /// to the log file. If the buffer is full the output is dropped
+      /// rather than blocking the caller, and the number of dropped messages
+      /// is reported. Disabling asynchronous logging writes everything still
+      /// queued. It's disabled by default, and when the program exits.
+      /// \param[in] _async True to enable asynchronous logging.
+      /// \sa void Flush()
+      public: static void SetAsync(const bool _async);
+
+      /// \brief Get whether asynchronous logging is enabled.
+      /// \return True if asynchronous logging is enabled.
+      /// \sa void SetAsync(const bool _async)
+      public: static bool Async();
+
+      /// \brief Wait until all the output queued so far is written. Does
+      /// nothing if asynchronous logging is disabled.
+      public: static void Flush();
+
+      /// \brief Get the number of messages dropped because the asynchronous
+      /// logging buffer was full.
+      /// \return Number of dropped messages since the program started.
+      public: static uint64_t DroppedMessages();
+
       /// \brief Global instance of the message logger.
       public: static Logger msg;
 
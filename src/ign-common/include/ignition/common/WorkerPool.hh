@@ -18,8 +18,10 @@
 #ifndef IGNITION_COMMON_WORKER_POOL_HH_
 #define IGNITION_COMMON_WORKER_POOL_HH_
 
+#include <cstddef>
 #include <functional>
 #include <memory>
+#include <vector>
 
 #include <ignition/common/Export.hh>
 #include <ignition/common/Time.hh>
@@ -30,9 +32,21 @@ namespace ignition
   namespace common
   {
     /// \brief forward declaration
+    class TaskGroupPrivate;
     class WorkerPoolPrivate;
+    namespace detail { class WorkerTask; }
 
     /// \brief A pool of worker threads that do stuff in parallel
+    ///
+    /// Each worker has its own double ended queue of work. Work added from
+    /// a worker thread goes to the bottom of its queue, and work added from
+    /// other threads is handed to the next worker looking for work, without
+    /// locking in either case. Workers take work from the bottom of their
+    /// own queue and, when it's empty, steal from the top of the others',
+    /// sleeping only once there is nothing left to steal.
+    ///
+    /// Small work functions are stored inline in the work order, so adding
+    /// work costs a single allocation.
     class IGNITION_COMMON_VISIBLE WorkerPool
     {
       /// \brief Creates worker threads. The number of worker threads is
@@ -54,6 +68,11 @@ namespace ignition
       public: void AddWork(std::function<void()> _work,
                   std::function<void()> _cb = std::function<void()>());
 
+      /// \brief Adds several pieces of work at once, waking up as many
+      /// workers as needed in one go.
+      /// \param[in] _work functions to do one piece of work each
+      public: void AddWorkBatch(std::vector<std::function<void()>> _work);
+
       /// \brief Waits until all work is done and threads are idle
       /// \param[in] _timeout How long to wait, default to forever
       /// \returns true if all work was finished
@@ -61,12 +80,79 @@ namespace ignition
       //           the WorkerPool is destructed before all work is completed
       public: bool WaitForResults(const Time &_timeout = Time::Zero);
 
+      /// \brief Calls a function for each index of a range, in parallel.
+      /// The range is split in chunks of _grain indices, which the calling
+      /// thread and the workers take in turn until none are left. Returns
+      /// once the function was called for every index.
+      /// \param[in] _begin First index.
+      /// \param[in] _end One past the last index.
+      /// \param[in] _function Function called with each index.
+      /// \param[in] _grain Number of indices per chunk, or 0 to split the
+      /// range in a few chunks per worker.
+      /// \remark This may be called from work running in the pool, in which
+      /// case the worker runs other work while waiting.
+      public: template <typename Function>
+              void ParallelFor(const std::size_t _begin,
+                  const std::size_t _end, Function &&_function,
+                  const std::size_t _grain = 0);
+
+      /// \brief Get the number of worker threads.
+      /// \return Number of workers.
+      public: unsigned int ThreadCount() const;
+
+      /// \brief Run chunks of work on the calling thread and the workers.
+      /// \param[in] _count Number of chunks.
+      /// \param[in] _body Function running a chunk.
+      /// \param[in] _context First argument of _body.
+      private: void ParallelChunks(const std::size_t _count,
+                   void (*_body)(void *, const std::size_t),
+                   void *_context);
+
+      /// \brief Task groups add work to the pool directly.
+      friend class TaskGroup;
+
       IGN_COMMON_WARN_IGNORE__DLL_INTERFACE_MISSING
       /// \brief private implementation pointer
       private: std::unique_ptr<WorkerPoolPrivate> dataPtr;
       IGN_COMMON_WARN_RESUME__DLL_INTERFACE_MISSING
     };
+
+    /// \brief A set of pieces of work running in a WorkerPool, which can be
+    /// waited for independently of the rest of the work in the pool.
+    class IGNITION_COMMON_VISIBLE TaskGroup
+    {
+      /// \brief Constructor
+      /// \param[in] _pool Pool running the work. It must outlive the group.
+      public: explicit TaskGroup(WorkerPool &_pool);
+
+      /// \brief Destructor. Waits for the work of the group to finish.
+      public: ~TaskGroup();
+
+      /// \brief Adds work to the group.
+      /// \param[in] _function function to do one piece of work
+      public: template <typename Function>
+              void Run(Function &&_function);
+
+      /// \brief Waits until all the work of the group is done. When called
+      /// from work running in the pool, the worker runs other work while
+      /// waiting.
+      public: void Wait();
+
+      /// \brief Add a work order to the pool.
+      /// \param[in] _task The work order, owned by the pool from now on.
+      private: void Submit(detail::WorkerTask *_task);
+
+      /// \brief Called when a piece of work of the group is done.
+      private: void Finish();
+
+      IGN_COMMON_WARN_IGNORE__DLL_INTERFACE_MISSING
+      /// \brief private implementation pointer
+      private: std::unique_ptr<TaskGroupPrivate> dataPtr;
+      IGN_COMMON_WARN_RESUME__DLL_INTERFACE_MISSING
+    };
   }
 }
 
+#include "ignition/common/detail/WorkerPool.hh"
+
 #endif
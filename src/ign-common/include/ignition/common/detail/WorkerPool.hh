@@ -0,0 +1,159 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef IGNITION_COMMON_DETAIL_WORKERPOOL_HH_
+#define IGNITION_COMMON_DETAIL_WORKERPOOL_HH_
+
+#include <algorithm>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "ignition/common/WorkerPool.hh"
+
+namespace ignition
+{
+  namespace common
+  {
+    namespace detail
+    {
+      /// \brief A work order of a WorkerPool. Functions up to kInlineSize
+      /// bytes are stored in the work order itself rather than allocated
+      /// separately.
+      class WorkerTask
+      {
+        /// \brief Size of the inline storage, which fits a pair of
+        /// std::function
+        public: static constexpr std::size_t kInlineSize = 64;
+
+        /// \brief Constructor
+        /// \param[in] _function Function doing the work.
+        public: template <typename Function>
+                explicit WorkerTask(Function &&_function)
+        {
+          using Stored = typename std::decay<Function>::type;
+          if constexpr (sizeof(Stored) <= kInlineSize &&
+              alignof(Stored) <= alignof(std::max_align_t))
+          {
+            new (&this->storage) Stored(std::forward<Function>(_function));
+            this->run = [](void *_storage)
+            {
+              (*static_cast<Stored *>(_storage))();
+            };
+            this->destroy = [](void *_storage)
+            {
+              static_cast<Stored *>(_storage)->~Stored();
+            };
+          }
+          else
+          {
+            new (&this->storage) Stored *(
+                new Stored(std::forward<Function>(_function)));
+            this->run = [](void *_storage)
+            {
+              (**static_cast<Stored **>(_storage))();
+            };
+            this->destroy = [](void *_storage)
+            {
+              delete *static_cast<Stored **>(_storage);
+            };
+          }
+        }
+
+        /// \brief Destructor
+        public: ~WorkerTask()
+        {
+          this->destroy(&this->storage);
+        }
+
+        /// \brief Work orders aren't copied
+        public: WorkerTask(const WorkerTask &) = delete;
+
+        /// \brief Work orders aren't copied
+        public: WorkerTask &operator=(const WorkerTask &) = delete;
+
+        /// \brief Do the work.
+        public: void Run()
+        {
+          this->run(&this->storage);
+        }
+
+        /// \brief Next work order in a list of work orders
+        public: WorkerTask *next = nullptr;
+
+        /// \brief Storage of the function or of a pointer to it
+        private: typename std::aligned_storage<kInlineSize,
+                     alignof(std::max_align_t)>::type storage;
+
+        /// \brief Calls the stored function
+        private: void (*run)(void *);
+
+        /// \brief Destroys the stored function
+        private: void (*destroy)(void *);
+      };
+    }
+
+    //////////////////////////////////////////////////
+    template <typename Function>
+    void WorkerPool::ParallelFor(const std::size_t _begin,
+        const std::size_t _end, Function &&_function, const std::size_t _grain)
+    {
+      if (_end <= _begin)
+        return;
+
+      // A few chunks per worker balance uneven work without making chunks
+      // so small that taking them costs more than running them
+      const std::size_t count = _end - _begin;
+      const std::size_t grain = _grain > 0 ? _grain : std::max<std::size_t>(
+          1u, count / (4u * (this->ThreadCount() + 1u)));
+
+      struct Range
+      {
+        std::size_t begin;
+        std::size_t end;
+        std::size_t grain;
+        typename std::remove_reference<Function>::type *function;
+      };
+      Range range{_begin, _end, grain, &_function};
+
+      this->ParallelChunks((count + grain - 1) / grain,
+          [](void *_range, const std::size_t _chunk)
+          {
+            const Range &r = *static_cast<Range *>(_range);
+            const std::size_t first = r.begin + _chunk * r.grain;
+            const std::size_t last = std::min(r.end, first + r.grain);
+            for (std::size_t i = first; i < last; ++i)
+              (*r.function)(i);
+          }, &range);
+    }
+
+    //////////////////////////////////////////////////
+    template <typename Function>
+    void TaskGroup::Run(Function &&_function)
+    {
+      this->Submit(new detail::WorkerTask(
+          [this, function = std::forward<Function>(_function)]() mutable
+          {
+            function();
+            this->Finish();
+          }));
+    }
+  }
+}
+
+#endif
@@ -70,7 +70,8 @@ namespace ignition
       /// If the underlying profiler implementation supports additional
       /// log messages, this can be used to send.
       ///
-      /// Currently, the Remotery implentation supports this functionality.
+      /// Currently, the Remotery and trace implementations support this
+      /// functionality.
       /// \param[in] _text Text to log.
       public: void LogText(const char *_text);
 
@@ -86,6 +87,15 @@ namespace ignition
       /// \brief End a profiling sample.
       public: void EndSample();
 
+      /// \brief Write the samples recorded so far to a trace file (if
+      /// supported).
+      ///
+      /// Currently, the trace implementation supports this functionality,
+      /// writing files in the Chrome trace event format.
+      /// \param[in] _filename Path of the file.
+      /// \return True if the file was written.
+      public: bool WriteTrace(const std::string &_filename);
+
       /// \brief Get the underlying profiler implentation name
       public: std::string ImplementationName() const;
 
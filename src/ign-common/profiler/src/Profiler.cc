@@ -16,8 +16,10 @@
  */
 #include "ignition/common/Profiler.hh" // NOLINT(*)
 #include "ignition/common/Console.hh"
+#include "ignition/common/Util.hh"
 
 #include "ProfilerImpl.hh"
+#include "TraceProfilerImpl.hh"
 
 #ifdef IGN_PROFILER_REMOTERY
 #include "RemoteryProfilerImpl.hh"
@@ -30,8 +32,17 @@ using namespace common;
 Profiler::Profiler():
   impl(nullptr)
 {
+  // Record a trace file instead of streaming to Remotery when requested
+  std::string traceFile;
+  if (env("IGN_PROFILER_TRACE_FILE", traceFile) && !traceFile.empty())
+  {
+    impl = new TraceProfilerImpl(traceFile);
+  }
 #ifdef IGN_PROFILER_REMOTERY
-  impl = new RemoteryProfilerImpl();
+  else
+  {
+    impl = new RemoteryProfilerImpl();
+  }
 #endif  // IGN_PROFILER_REMOTERY
 
   if (this->impl == nullptr)
@@ -81,6 +92,14 @@ void Profiler::EndSample()
     this->impl->EndSample();
 }
 
+//////////////////////////////////////////////////
+bool Profiler::WriteTrace(const std::string &_filename)
+{
+  if (this->impl)
+    return this->impl->WriteTrace(_filename);
+  return false;
+}
+
 //////////////////////////////////////////////////
 std::string Profiler::ImplementationName() const
 {
@@ -57,6 +57,12 @@ namespace ignition
 
       /// \brief End a profiling sample.
       public: virtual void EndSample() = 0;
+
+      /// \brief Write the samples recorded so far to a trace file (if
+      /// supported).
+      /// \param[in] _filename Path of the file.
+      /// \return True if the file was written.
+      public: virtual bool WriteTrace(const std::string &_filename) = 0;
     };
   }
 }
@@ -0,0 +1,165 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "ignition/common/Profiler.hh" // NOLINT(*)
+#include <gtest/gtest.h> // NOLINT(*)
+
+#include <chrono> // NOLINT(*)
+#include <cstdlib> // NOLINT(*)
+#include <fstream> // NOLINT(*)
+#include <sstream> // NOLINT(*)
+#include <string> // NOLINT(*)
+#include <thread> // NOLINT(*)
+#include "ignition/common/Console.hh" // NOLINT(*)
+#include "ignition/common/Filesystem.hh" // NOLINT(*)
+#include "test_config.h" // NOLINT(*)
+
+using namespace ignition;
+using namespace common;
+
+/// \brief File written when the profiler is destroyed
+static const std::string kExitTrace =  // NOLINT(*)
+    joinPaths(PROJECT_BINARY_PATH, "Profiler_Trace_TEST_exit.json");
+
+/////////////////////////////////////////////////
+/// \brief Count the occurrences of a string in another.
+/// \param[in] _text String to search.
+/// \param[in] _pattern String to count.
+/// \return Number of occurrences.
+static std::size_t count(const std::string &_text,
+    const std::string &_pattern)
+{
+  std::size_t result = 0;
+  for (std::size_t pos = _text.find(_pattern); pos != std::string::npos;
+       pos = _text.find(_pattern, pos + _pattern.size()))
+  {
+    ++result;
+  }
+  return result;
+}
+
+/////////////////////////////////////////////////
+/// \brief Profiled work
+/// \param[in] _iterations Number of outer samples.
+void work(const int _iterations)
+{
+  for (int i = 0; i < _iterations; ++i)
+  {
+    IGN_PROFILE("outer");
+    IGN_PROFILE_BEGIN("inner \"quoted\"");
+    IGN_PROFILE_END();
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(Profiler, ProfilerTrace)
+{
+  EXPECT_TRUE(IGN_PROFILER_ENABLE);
+  EXPECT_TRUE(IGN_PROFILER_VALID);
+  EXPECT_EQ(Profiler::Instance()->ImplementationName(),
+            "ign_profiler_trace");
+}
+
+/////////////////////////////////////////////////
+TEST(Profiler, WriteTrace)
+{
+  std::thread first([]()
+  {
+    IGN_PROFILE_THREAD_NAME("first");
+    work(10);
+  });
+  std::thread second([]()
+  {
+    IGN_PROFILE_THREAD_NAME("second\n");
+    IGN_PROFILE_LOG_TEXT("log text");
+    work(20);
+  });
+  first.join();
+  second.join();
+
+  const std::string path =
+      joinPaths(PROJECT_BINARY_PATH, "Profiler_Trace_TEST.json");
+  ASSERT_TRUE(Profiler::Instance()->WriteTrace(path));
+
+  std::ifstream in(path);
+  std::stringstream buffer;
+  buffer << in.rdbuf();
+  const std::string trace = buffer.str();
+  removeFile(path);
+
+  EXPECT_EQ(0u, trace.find("{\"displayTimeUnit\":\"ns\",\"traceEvents\":["));
+  EXPECT_EQ(2u, count(trace, "\"thread_name\""));
+  EXPECT_EQ(1u, count(trace, "{\"name\":\"first\"}"));
+  EXPECT_EQ(1u, count(trace, "{\"name\":\"second\\u000a\"}"));
+  EXPECT_EQ(1u, count(trace, "\"ph\":\"i\",\"name\":\"log text\""));
+  EXPECT_EQ(30u, count(trace, "\"name\":\"outer\""));
+  EXPECT_EQ(30u, count(trace, "\"name\":\"inner \\\"quoted\\\"\""));
+  EXPECT_EQ(60u, count(trace, "\"ph\":\"B\""));
+  EXPECT_EQ(60u, count(trace, "\"ph\":\"E\""));
+  EXPECT_EQ(trace.size() - 4u, trace.rfind("\n]}\n"));
+}
+
+/////////////////////////////////////////////////
+TEST(Profiler, ChunkOverflow)
+{
+  Console::SetVerbosity(4);
+
+  // More events than fit in a single chunk
+  const int iterations = 20000;
+  auto start = std::chrono::steady_clock::now();
+  work(iterations);
+  auto elapsed = std::chrono::steady_clock::now() - start;
+
+  const std::string path =
+      joinPaths(PROJECT_BINARY_PATH, "Profiler_Trace_TEST_overflow.json");
+  ASSERT_TRUE(Profiler::Instance()->WriteTrace(path));
+
+  std::ifstream in(path);
+  std::stringstream buffer;
+  buffer << in.rdbuf();
+  const std::string trace = buffer.str();
+  removeFile(path);
+
+  EXPECT_EQ(30u + iterations, count(trace, "\"name\":\"outer\""));
+  EXPECT_EQ(2u * (30u + iterations), count(trace, "\"ph\":\"E\""));
+
+  igndbg << "Profiling time per sample: "
+         << std::chrono::duration<double, std::nano>(elapsed).count() /
+            (2 * iterations) << " ns" << std::endl;
+}
+
+/////////////////////////////////////////////////
+TEST(Profiler, WriteTraceFailure)
+{
+  EXPECT_FALSE(Profiler::Instance()->WriteTrace(
+      joinPaths(PROJECT_BINARY_PATH, "missing", "directory", "trace.json")));
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  // Select the trace profiler before it's created
+  removeFile(kExitTrace);
+#ifdef _WIN32
+  _putenv_s("IGN_PROFILER_TRACE_FILE", kExitTrace.c_str());
+#else
+  setenv("IGN_PROFILER_TRACE_FILE", kExitTrace.c_str(), 1);
+#endif
+
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -232,6 +232,14 @@ void RemoteryProfilerImpl::EndSample()
   rmt_EndCPUSample();
 }
 
+//////////////////////////////////////////////////
+bool RemoteryProfilerImpl::WriteTrace(const std::string &_filename)
+{
+  ignwarn << "The Remotery profiler doesn't write trace files, ["
+          << _filename << "] not written" << std::endl;
+  return false;
+}
+
 //////////////////////////////////////////////////
 void RemoteryProfilerImpl::HandleInput(const char *_text)
 {
@@ -76,6 +76,12 @@ namespace ignition
       /// \brief End a profiling sample.
       public: void EndSample() final;
 
+      /// \brief Remotery streams samples instead of recording them, so no
+      /// trace file is written.
+      /// \param[in] _filename Unused.
+      /// \return Always false.
+      public: bool WriteTrace(const std::string &_filename) final;
+
       /// \brief Handle input coming from Remotery web console.
       /// \param[in] _text Incoming input.
       public: void HandleInput(const char *_text);
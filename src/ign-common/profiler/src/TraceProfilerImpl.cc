@@ -0,0 +1,315 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define IGN_PROFILER_TRACE_TSC
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define IGN_PROFILER_TRACE_TSC
+#endif
+
+#include "TraceProfilerImpl.hh"
+#include "ignition/common/Console.hh"
+
+using namespace ignition;
+using namespace common;
+
+//////////////////////////////////////////////////
+/// \brief Read the steady clock.
+/// \return Time in nanoseconds.
+static int64_t now()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+//////////////////////////////////////////////////
+/// \brief Read the clock timing events. On x86 this is the time stamp
+/// counter, which takes half the time of the steady clock to read, and is
+/// converted to nanoseconds when writing the trace.
+/// \return Time in clock ticks.
+static int64_t ticks()
+{
+#ifdef IGN_PROFILER_TRACE_TSC
+  return static_cast<int64_t>(__rdtsc());
+#else
+  return now();
+#endif
+}
+
+//////////////////////////////////////////////////
+/// \brief Write a string as a JSON string literal.
+/// \param[in] _out Stream to write into.
+/// \param[in] _text The string.
+static void writeJsonString(std::ostream &_out, const std::string &_text)
+{
+  static const char kHex[] = "0123456789abcdef";
+
+  _out << '"';
+  for (const char c : _text)
+  {
+    if (c == '"' || c == '\\')
+      _out << '\\' << c;
+    else if (static_cast<unsigned char>(c) < 0x20)
+      _out << "\\u00" << kHex[(c >> 4) & 0xf] << kHex[c & 0xf];
+    else
+      _out << c;
+  }
+  _out << '"';
+}
+
+//////////////////////////////////////////////////
+/// \brief Write a time as a JSON number of microseconds, which is the unit
+/// of the Chrome trace format, keeping the nanoseconds.
+/// \param[in] _out Stream to write into.
+/// \param[in] _time Time in nanoseconds, not negative.
+static void writeMicroseconds(std::ostream &_out, const int64_t _time)
+{
+  const int64_t fraction = _time % 1000;
+  _out << _time / 1000 << '.'
+       << static_cast<char>('0' + fraction / 100)
+       << static_cast<char>('0' + fraction / 10 % 10)
+       << static_cast<char>('0' + fraction % 10);
+}
+
+//////////////////////////////////////////////////
+TraceProfilerImpl::ThreadBuffer::~ThreadBuffer()
+{
+  while (this->head)
+  {
+    Chunk *next = this->head->next.load(std::memory_order_relaxed);
+    delete this->head;
+    this->head = next;
+  }
+}
+
+//////////////////////////////////////////////////
+TraceProfilerImpl::TraceProfilerImpl(const std::string &_filename)
+  : filename(_filename), startTicks(ticks()), startTime(now())
+{
+}
+
+//////////////////////////////////////////////////
+TraceProfilerImpl::~TraceProfilerImpl()
+{
+  if (!this->filename.empty() && this->WriteTrace(this->filename))
+    ignmsg << "Profiler trace written to " << this->filename << std::endl;
+}
+
+//////////////////////////////////////////////////
+std::string TraceProfilerImpl::Name() const
+{
+  return "ign_profiler_trace";
+}
+
+//////////////////////////////////////////////////
+void TraceProfilerImpl::SetThreadName(const char *_name)
+{
+  ThreadBuffer &buffer = this->Buffer();
+  std::lock_guard<std::mutex> lock(this->mutex);
+  buffer.name = _name;
+}
+
+//////////////////////////////////////////////////
+void TraceProfilerImpl::LogText(const char *_text)
+{
+  ThreadBuffer &buffer = this->Buffer();
+  this->Record(buffer, this->NameId(buffer, _text), 'i');
+}
+
+//////////////////////////////////////////////////
+void TraceProfilerImpl::BeginSample(const char *_name, uint32_t *_hash)
+{
+  ThreadBuffer &buffer = this->Buffer();
+
+  // Identifiers are the same for all threads, so the hash cached by
+  // IGN_PROFILE can be shared by the threads running the same code
+  uint32_t id = _hash ? *_hash : 0u;
+  if (id == 0u)
+  {
+    id = this->NameId(buffer, _name);
+    if (_hash)
+      *_hash = id;
+  }
+
+  this->Record(buffer, id, 'B');
+}
+
+//////////////////////////////////////////////////
+void TraceProfilerImpl::EndSample()
+{
+  this->Record(this->Buffer(), 0u, 'E');
+}
+
+//////////////////////////////////////////////////
+TraceProfilerImpl::ThreadBuffer &TraceProfilerImpl::Buffer()
+{
+  // Plain data, so that reading it doesn't go through a thread local
+  // initialization guard
+  static thread_local struct
+  {
+    TraceProfilerImpl *owner;
+    ThreadBuffer *buffer;
+  } current = {nullptr, nullptr};
+
+  if (current.owner != this)
+  {
+    auto buffer = std::make_unique<ThreadBuffer>();
+    buffer->head = new Chunk;
+    buffer->tail = buffer->head;
+
+    std::lock_guard<std::mutex> lock(this->mutex);
+    buffer->id = static_cast<uint32_t>(this->threads.size() + 1);
+    current = {this, buffer.get()};
+    this->threads.push_back(std::move(buffer));
+  }
+
+  return *current.buffer;
+}
+
+//////////////////////////////////////////////////
+uint32_t TraceProfilerImpl::NameId(ThreadBuffer &_buffer, const char *_name)
+{
+  const std::string_view name(_name);
+  auto known = _buffer.names.find(name);
+  if (known != _buffer.names.end())
+    return known->second;
+
+  std::lock_guard<std::mutex> lock(this->mutex);
+  auto shared = this->nameIds.find(name);
+  if (shared == this->nameIds.end())
+  {
+    this->names.emplace_back(name);
+    shared = this->nameIds.emplace(this->names.back(),
+        static_cast<uint32_t>(this->names.size())).first;
+  }
+
+  // The key views the copy of the name, which doesn't move
+  _buffer.names.emplace(shared->first, shared->second);
+  return shared->second;
+}
+
+//////////////////////////////////////////////////
+void TraceProfilerImpl::Record(ThreadBuffer &_buffer, const uint32_t _name,
+    const char _phase)
+{
+  const int64_t time = ticks();
+
+  Chunk *chunk = _buffer.tail;
+  std::size_t count = chunk->count.load(std::memory_order_relaxed);
+  if (count == Chunk::kSize)
+  {
+    Chunk *next = new Chunk;
+    chunk->next.store(next, std::memory_order_release);
+    _buffer.tail = next;
+    chunk = next;
+    count = 0;
+  }
+
+  chunk->events[count] = {time, _name, _phase};
+
+  // Publish the event to WriteTrace
+  chunk->count.store(count + 1, std::memory_order_release);
+}
+
+//////////////////////////////////////////////////
+bool TraceProfilerImpl::WriteTrace(const std::string &_filename)
+{
+  // Copy what other threads may change while writing, the events themselves
+  // being read up to the counts published by their threads
+  std::vector<std::string> eventNames;
+  std::vector<std::pair<uint32_t, std::string>> threadNames;
+  std::vector<std::pair<uint32_t, Chunk *>> chunks;
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    eventNames.assign(this->names.begin(), this->names.end());
+    for (const auto &thread : this->threads)
+    {
+      if (!thread->name.empty())
+        threadNames.emplace_back(thread->id, thread->name);
+      chunks.emplace_back(thread->id, thread->head);
+    }
+  }
+
+  // Calibrate the clock over the whole recording
+  const int64_t elapsedTicks = ticks() - this->startTicks;
+  const int64_t elapsedTime = now() - this->startTime;
+  const double nsPerTick = elapsedTicks > 0 && elapsedTime > 0 ?
+      static_cast<double>(elapsedTime) / elapsedTicks : 1.0;
+
+  std::ofstream out(_filename);
+  if (!out)
+  {
+    ignerr << "Unable to open profiler trace file [" << _filename << "]"
+           << std::endl;
+    return false;
+  }
+
+  out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+  bool first = true;
+  for (const auto &[id, name] : threadNames)
+  {
+    out << (first ? "\n" : ",\n")
+        << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << id
+        << ",\"args\":{\"name\":";
+    writeJsonString(out, name);
+    out << "}}";
+    first = false;
+  }
+
+  for (const auto &[id, head] : chunks)
+  {
+    for (const Chunk *chunk = head; chunk;
+         chunk = chunk->next.load(std::memory_order_acquire))
+    {
+      const std::size_t count = chunk->count.load(std::memory_order_acquire);
+      for (std::size_t i = 0; i < count; ++i)
+      {
+        const Event &event = chunk->events[i];
+        out << (first ? "\n" : ",\n") << "{\"ph\":\"" << event.phase << '"';
+        if (event.name > 0u && event.name <= eventNames.size())
+        {
+          out << ",\"name\":";
+          writeJsonString(out, eventNames[event.name - 1]);
+        }
+        if (event.phase == 'i')
+          out << ",\"s\":\"t\"";
+        out << ",\"ts\":";
+        writeMicroseconds(out, std::max<int64_t>(0, static_cast<int64_t>(
+            (event.time - this->startTicks) * nsPerTick)));
+        out << ",\"pid\":1,\"tid\":" << id << '}';
+        first = false;
+      }
+    }
+  }
+  out << "\n]}\n";
+
+  out.close();
+  if (!out)
+  {
+    ignerr << "Unable to write profiler trace file [" << _filename << "]"
+           << std::endl;
+    return false;
+  }
+
+  return true;
+}
@@ -0,0 +1,190 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef IGNITION_COMMON_TRACEPROFILERIMPL_HH_
+#define IGNITION_COMMON_TRACEPROFILERIMPL_HH_
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "ProfilerImpl.hh"
+
+namespace ignition
+{
+  namespace common
+  {
+    /// \brief Trace profiler implementation
+    ///
+    /// Records the samples of each thread in memory, and writes them to a
+    /// file in the Chrome trace event format, which can be opened with
+    /// chrome://tracing or the Perfetto UI (https://ui.perfetto.dev). No
+    /// connection is needed while profiling, which makes it suited to
+    /// headless machines.
+    ///
+    /// Each thread appends the begin and end events of its samples to a
+    /// buffer of its own without locking, so that a sample costs little more
+    /// than reading the clock twice. On x86 events are timed with the time
+    /// stamp counter, calibrated against the steady clock when writing.
+    /// Sample names are copied the first time they're seen, and identified
+    /// by the hash cached by IGN_PROFILE after that. Events take 16 bytes
+    /// each and are kept until the profiler is destroyed.
+    ///
+    /// The trace profiler is used instead of Remotery when the
+    /// IGN_PROFILER_TRACE_FILE environment variable is set to the path of the
+    /// file to write when the program exits. It can also be written at any
+    /// time with Profiler::WriteTrace.
+    class TraceProfilerImpl: public ProfilerImpl
+    {
+      /// \brief Constructor.
+      /// \param[in] _filename File to write the trace into when the profiler
+      /// is destroyed, or empty to only write it on demand.
+      public: explicit TraceProfilerImpl(const std::string &_filename);
+
+      /// \brief Destructor.
+      public: ~TraceProfilerImpl() final;
+
+      /// \brief Retrieve profiler name.
+      public: std::string Name() const final;
+
+      /// \brief Set the name of the current thread
+      /// \param[in] _name Name to set
+      public: void SetThreadName(const char *_name) final;
+
+      /// \brief Log text to profiler output.
+      /// Recorded as an instant event of the current thread.
+      /// \param[in] _text Text to log.
+      public: void LogText(const char *_text) final;
+
+      /// \brief Begin a named profiling sample.
+      /// \param[in] _name Name of the sample
+      /// \param[in,out] _hash An optional hash value that can be cached
+      ///   between executions. Set to the identifier of the name.
+      public: void BeginSample(const char *_name, uint32_t *_hash) final;
+
+      /// \brief End a profiling sample.
+      public: void EndSample() final;
+
+      /// \brief Write the samples recorded so far to a file.
+      /// \param[in] _filename Path of the file.
+      /// \return True if the file was written.
+      public: bool WriteTrace(const std::string &_filename) final;
+
+      /// \brief A recorded event
+      private: struct Event
+      {
+        /// \brief Time of the event, in ticks of the event clock
+        int64_t time;
+
+        /// \brief Identifier of the name of the event, unused by end events
+        uint32_t name;
+
+        /// \brief Phase of the event in the Chrome trace format: 'B' for
+        /// begin, 'E' for end and 'i' for instant events.
+        char phase;
+      };
+
+      /// \brief Fixed size block of events of a thread
+      private: struct Chunk
+      {
+        /// \brief Number of events in a chunk
+        static constexpr std::size_t kSize = 16384;
+
+        /// \brief The events
+        Event events[kSize];
+
+        /// \brief Number of events recorded in the chunk
+        std::atomic<std::size_t> count{0};
+
+        /// \brief Next chunk of the thread
+        std::atomic<Chunk *> next{nullptr};
+      };
+
+      /// \brief Events of a thread. Only the thread itself records events,
+      /// and the chunks are read without locking when writing the trace.
+      private: struct ThreadBuffer
+      {
+        /// \brief Destructor. Frees the chunks.
+        ~ThreadBuffer();
+
+        /// \brief First chunk
+        Chunk *head = nullptr;
+
+        /// \brief Chunk receiving the events
+        Chunk *tail = nullptr;
+
+        /// \brief Identifier of the thread in the trace
+        uint32_t id = 0;
+
+        /// \brief Name of the thread, protected by the profiler's mutex
+        std::string name;
+
+        /// \brief Names already looked up by this thread, by content
+        std::unordered_map<std::string_view, uint32_t> names;
+      };
+
+      /// \brief Get the buffer of the current thread, creating it on first
+      /// use.
+      /// \return The buffer.
+      private: ThreadBuffer &Buffer();
+
+      /// \brief Get the identifier of a name, copying the name the first
+      /// time it's seen.
+      /// \param[in] _buffer Buffer of the current thread.
+      /// \param[in] _name The name.
+      /// \return Identifier of the name, which is never 0.
+      private: uint32_t NameId(ThreadBuffer &_buffer, const char *_name);
+
+      /// \brief Record an event of the current thread.
+      /// \param[in] _buffer Buffer of the current thread.
+      /// \param[in] _name Identifier of the name of the event.
+      /// \param[in] _phase Phase of the event.
+      private: void Record(ThreadBuffer &_buffer, const uint32_t _name,
+                   const char _phase);
+
+      /// \brief File written when the profiler is destroyed
+      private: std::string filename;
+
+      /// \brief Event clock time when the profiler started, in ticks
+      private: int64_t startTicks;
+
+      /// \brief Steady clock time when the profiler started, in nanoseconds
+      private: int64_t startTime;
+
+      /// \brief Protects the names, the thread list and the thread names
+      private: std::mutex mutex;
+
+      /// \brief Names of the events, the identifier of a name being its
+      /// index plus one. A deque so that names don't move.
+      private: std::deque<std::string> names;
+
+      /// \brief Identifiers of the names, by content
+      private: std::unordered_map<std::string_view, uint32_t> nameIds;
+
+      /// \brief Buffers of all the threads which recorded events
+      private: std::vector<std::unique_ptr<ThreadBuffer>> threads;
+    };
+  }
+}
+
+#endif  // IGNITION_COMMON_TRACEPROFILERIMPL_HH_
@@ -14,8 +14,16 @@
  * limitations under the License.
  *
  */
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <sstream>
+#include <thread>
+#include <vector>
 
 #include <ignition/common/Console.hh>
 #include <ignition/common/config.hh>
@@ -44,6 +52,366 @@ FileLogger ignition::common::Console::log("");
   const int blue = 36;
 #endif
 
+/// \brief Number of messages the asynchronous logging buffer holds. It must
+/// be a power of two.
+static const std::size_t kAsyncCapacity = 8192;
+
+/// \brief Longest time asynchronous output waits before being written.
+static const std::chrono::milliseconds kAsyncPeriod(10);
+
+/////////////////////////////////////////////////
+/// \brief Write output to the terminal, in color.
+/// \param[in] _type Output destination type (STDOUT, or STDERR).
+/// \param[in] _color Color of the output.
+/// \param[in] _text The output.
+static void writeToTerminal(const Logger::LogType _type, const int _color,
+    std::string _text)
+{
+#ifndef _WIN32
+  bool lastNewLine = _text.back() == '\n';
+  FILE *outstream = _type == Logger::STDOUT ? stdout : stderr;
+
+  if (lastNewLine)
+    _text.pop_back();
+
+  std::stringstream ss;
+  ss << "\033[1;" << _color << "m" << _text << "\033[0m";
+  if (lastNewLine)
+    ss << std::endl;
+
+  fprintf(outstream, "%s", ss.str().c_str());
+#else
+  HANDLE hConsole = GetStdHandle(
+        _type == Logger::STDOUT ? STD_OUTPUT_HANDLE : STD_ERROR_HANDLE);
+
+  CONSOLE_SCREEN_BUFFER_INFO originalBufferInfo;
+  GetConsoleScreenBufferInfo(hConsole, &originalBufferInfo);
+
+  SetConsoleTextAttribute(hConsole, _color);
+
+  std::ostream &outStream =
+      _type == Logger::STDOUT ? std::cout : std::cerr;
+
+  outStream << _text;
+
+  SetConsoleTextAttribute(hConsole, originalBufferInfo.wAttributes);
+#endif
+}
+
+namespace
+{
+  /// \brief Writes the output of the loggers on a background thread.
+  /// Loggers add their output to a bounded queue without locking (Vyukov's
+  /// bounded queue, with a single consumer), and the thread writes it out
+  /// when woken up, or at least every kAsyncPeriod.
+  class AsyncLog
+  {
+    /// \brief Get the instance. It's never destroyed, so that loggers
+    /// destroyed at exit can still use it.
+    /// \return The instance.
+    public: static AsyncLog &Instance()
+    {
+      static AsyncLog *instance = new AsyncLog;
+      return *instance;
+    }
+
+    /// \brief Constructor
+    public: AsyncLog()
+      : records(new Record[kAsyncCapacity])
+    {
+      for (std::size_t i = 0; i < kAsyncCapacity; ++i)
+        this->records[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    /// \brief Queue output.
+    /// \param[in] _file File to write into, or null to write to the
+    /// terminal.
+    /// \param[in] _type Terminal output destination type.
+    /// \param[in] _color Terminal output color.
+    /// \param[in] _text The output, moved from if it's queued.
+    /// \return False if asynchronous logging is disabled, in which case the
+    /// caller writes the output itself.
+    public: bool Write(std::ofstream *_file, const Logger::LogType _type,
+                const int _color, std::string &_text)
+    {
+      if (!this->enabled.load(std::memory_order_relaxed))
+        return false;
+
+      std::size_t pos = this->enqueuePos.load(std::memory_order_relaxed);
+      Record *record;
+      while (true)
+      {
+        record = &this->records[pos & (kAsyncCapacity - 1)];
+        const std::size_t sequence =
+            record->sequence.load(std::memory_order_acquire);
+        const std::intptr_t diff = static_cast<std::intptr_t>(sequence) -
+            static_cast<std::intptr_t>(pos);
+        if (diff == 0)
+        {
+          if (this->enqueuePos.compare_exchange_weak(pos, pos + 1,
+                std::memory_order_relaxed))
+          {
+            break;
+          }
+        }
+        else if (diff < 0)
+        {
+          // Full, drop the output rather than wait
+          this->dropped.fetch_add(1, std::memory_order_relaxed);
+          return true;
+        }
+        else
+        {
+          pos = this->enqueuePos.load(std::memory_order_relaxed);
+        }
+      }
+
+      record->file = _file;
+      record->type = _type;
+      record->color = _color;
+      record->text = std::move(_text);
+      record->sequence.store(pos + 1, std::memory_order_release);
+
+      // A wake up can be missed if the thread is just going to sleep, in
+      // which case the output waits at most kAsyncPeriod
+      if (this->sleeping.load(std::memory_order_relaxed) &&
+          this->sleeping.exchange(false))
+      {
+        this->signalWork.notify_one();
+      }
+      return true;
+    }
+
+    /// \brief Check whether asynchronous logging is enabled.
+    /// \return True if enabled.
+    public: bool Enabled() const
+    {
+      return this->enabled.load(std::memory_order_relaxed);
+    }
+
+    /// \brief Start the background thread.
+    public: void Start()
+    {
+      std::lock_guard<std::mutex> controlLock(this->controlMtx);
+      if (this->thread.joinable())
+        return;
+
+      // Write everything before the program exits
+      static const bool registered =
+          std::atexit([]() { AsyncLog::Instance().Stop(); }) == 0;
+      (void)registered;
+
+      this->stop = false;
+      this->thread = std::thread(&AsyncLog::Run, this);
+      this->enabled = true;
+    }
+
+    /// \brief Write everything queued and stop the background thread.
+    public: void Stop()
+    {
+      std::lock_guard<std::mutex> controlLock(this->controlMtx);
+      if (!this->thread.joinable())
+        return;
+
+      this->enabled = false;
+      {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->stop = true;
+      }
+      this->signalWork.notify_one();
+      this->thread.join();
+    }
+
+    /// \brief Wait until all the output queued so far is written.
+    public: void Flush()
+    {
+      if (!this->enabled)
+        return;
+
+      const std::size_t target = this->enqueuePos.load();
+      this->flushing.fetch_add(1);
+      {
+        std::unique_lock<std::mutex> lock(this->mutex);
+        this->signalWork.notify_one();
+        this->signalWritten.wait(lock, [this, target]
+            {
+              return this->stop || this->written.load() >= target;
+            });
+      }
+      this->flushing.fetch_sub(1);
+    }
+
+    /// \brief Get the number of dropped messages.
+    /// \return Number of messages dropped because the queue was full.
+    public: uint64_t Dropped() const
+    {
+      return this->dropped.load();
+    }
+
+    /// \brief Background thread writing the output.
+    private: void Run()
+    {
+      while (true)
+      {
+        if (this->WriteQueued())
+          continue;
+
+        std::unique_lock<std::mutex> lock(this->mutex);
+        if (this->stop)
+          break;
+
+        this->sleeping = true;
+        this->signalWork.wait_for(lock, kAsyncPeriod, [this]
+            {
+              return this->stop || !this->sleeping ||
+                  this->flushing.load() > 0;
+            });
+        this->sleeping = false;
+      }
+    }
+
+    /// \brief Write all the queued output.
+    /// \return True if there was output to write.
+    private: bool WriteQueued()
+    {
+      bool wrote = false;
+      while (true)
+      {
+        Record &record =
+            this->records[this->dequeuePos & (kAsyncCapacity - 1)];
+        if (record.sequence.load(std::memory_order_acquire) !=
+            this->dequeuePos + 1)
+        {
+          break;
+        }
+
+        std::ofstream *file = record.file;
+        const Logger::LogType type = record.type;
+        const int color = record.color;
+        std::string text = std::move(record.text);
+        record.sequence.store(this->dequeuePos + kAsyncCapacity,
+            std::memory_order_release);
+        ++this->dequeuePos;
+
+        if (file)
+        {
+          *file << text;
+          if (std::find(this->files.begin(), this->files.end(), file) ==
+              this->files.end())
+          {
+            this->files.push_back(file);
+          }
+        }
+        else
+        {
+          writeToTerminal(type, color, text);
+        }
+        wrote = true;
+      }
+
+      const uint64_t droppedNow = this->dropped.load();
+      if (droppedNow != this->droppedReported)
+      {
+        if (Console::Verbosity() >= 2)
+        {
+          writeToTerminal(Logger::STDERR, yellow, "[Wrn] Dropped " +
+              std::to_string(droppedNow - this->droppedReported) +
+              " log messages, the log buffer was full\n");
+        }
+        this->droppedReported = droppedNow;
+      }
+
+      if (!wrote)
+        return false;
+
+      for (auto file : this->files)
+        file->flush();
+      this->files.clear();
+
+      this->written.store(this->dequeuePos);
+      if (this->flushing.load() > 0)
+      {
+        {
+          std::lock_guard<std::mutex> lock(this->mutex);
+        }
+        this->signalWritten.notify_all();
+      }
+      return true;
+    }
+
+    /// \brief Queued output
+    private: struct Record
+    {
+      /// \brief Position of the record in the queue, plus one once it's
+      /// been written by a logger.
+      std::atomic<std::size_t> sequence{0};
+
+      /// \brief File to write into, or null to write to the terminal.
+      std::ofstream *file = nullptr;
+
+      /// \brief Terminal output destination type.
+      Logger::LogType type = Logger::STDOUT;
+
+      /// \brief Terminal output color.
+      int color = 0;
+
+      /// \brief The output.
+      std::string text;
+    };
+
+    /// \brief Circular buffer of records
+    private: std::unique_ptr<Record[]> records;
+
+    /// \brief Position of the next record to queue
+    private: alignas(64) std::atomic<std::size_t> enqueuePos{0};
+
+    /// \brief Position of the next record to write, only used by the
+    /// background thread
+    private: alignas(64) std::size_t dequeuePos = 0;
+
+    /// \brief Number of records written so far
+    private: std::atomic<std::size_t> written{0};
+
+    /// \brief Number of records dropped because the buffer was full
+    private: std::atomic<uint64_t> dropped{0};
+
+    /// \brief Number of dropped records reported so far, only used by the
+    /// background thread
+    private: uint64_t droppedReported = 0;
+
+    /// \brief Files written since they were last flushed, only used by the
+    /// background thread
+    private: std::vector<std::ofstream *> files;
+
+    /// \brief True while loggers queue their output
+    private: std::atomic<bool> enabled{false};
+
+    /// \brief True while the background thread waits for output
+    private: std::atomic<bool> sleeping{false};
+
+    /// \brief Number of threads waiting in Flush
+    private: std::atomic<int> flushing{0};
+
+    /// \brief True when the background thread must stop
+    private: bool stop = false;
+
+    /// \brief Protects stop, and used to wait on the condition variables
+    private: std::mutex mutex;
+
+    /// \brief Signaled to wake up the background thread
+    private: std::condition_variable signalWork;
+
+    /// \brief Signaled when output was written
+    private: std::condition_variable signalWritten;
+
+    /// \brief Serializes Start and Stop
+    private: std::mutex controlMtx;
+
+    /// \brief Background thread
+    private: std::thread thread;
+  };
+}
+
 Logger Console::err("[Err] ", red, Logger::STDERR, 1);
 Logger Console::warn("[Wrn] ", yellow, Logger::STDERR, 2);
 Logger Console::msg("[Msg] ", green, Logger::STDOUT, 3);
@@ -76,6 +444,50 @@ std::string Console::Prefix()
   return customPrefix;
 }
 
+//////////////////////////////////////////////////
+void Console::SetAsync(const bool _async)
+{
+  if (_async)
+    AsyncLog::Instance().Start();
+  else
+    AsyncLog::Instance().Stop();
+}
+
+//////////////////////////////////////////////////
+bool Console::Async()
+{
+  return AsyncLog::Instance().Enabled();
+}
+
+//////////////////////////////////////////////////
+void Console::Flush()
+{
+  AsyncLog::Instance().Flush();
+}
+
+//////////////////////////////////////////////////
+uint64_t Console::DroppedMessages()
+{
+  return AsyncLog::Instance().Dropped();
+}
+
+//////////////////////////////////////////////////
+bool ConsoleThrottle::Allow(const double _period)
+{
+  const int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+  int64_t previous = this->last.load(std::memory_order_relaxed);
+  if (previous != INT64_MIN &&
+      now - previous < static_cast<int64_t>(_period * 1e9))
+  {
+    return false;
+  }
+
+  // Only one of the threads racing for the message gets it
+  return this->last.compare_exchange_strong(previous, now,
+      std::memory_order_relaxed);
+}
+
 /////////////////////////////////////////////////
 Logger::Logger(const std::string &_prefix, const int _color,
                const LogType _type, const int _verbosity)
@@ -128,6 +540,14 @@ Logger::Buffer::~Buffer()
 /////////////////////////////////////////////////
 int Logger::Buffer::sync()
 {
+  // Asynchronous output is queued a line at a time, rather than once per
+  // insertion
+  if (AsyncLog::Instance().Enabled() && this->pptr() != this->pbase() &&
+      *(this->pptr() - 1) != '\n')
+  {
+    return 0;
+  }
+
   std::string outstr = this->str();
 
   // Log messages to disk
@@ -137,35 +557,8 @@ int Logger::Buffer::sync()
   // Output to terminal
   if (Console::Verbosity() >= this->verbosity && !outstr.empty())
   {
-#ifndef _WIN32
-    bool lastNewLine = outstr.back() == '\n';
-    FILE *outstream = this->type == Logger::STDOUT ? stdout : stderr;
-
-    if (lastNewLine)
-      outstr.pop_back();
-
-    std::stringstream ss;
-    ss << "\033[1;" << this->color << "m" << outstr << "\033[0m";
-    if (lastNewLine)
-      ss << std::endl;
-
-    fprintf(outstream, "%s", ss.str().c_str());
-#else
-    HANDLE hConsole = GetStdHandle(
-          this->type == Logger::STDOUT ? STD_OUTPUT_HANDLE : STD_ERROR_HANDLE);
-
-    CONSOLE_SCREEN_BUFFER_INFO originalBufferInfo;
-    GetConsoleScreenBufferInfo(hConsole, &originalBufferInfo);
-
-    SetConsoleTextAttribute(hConsole, this->color);
-
-    std::ostream &outStream =
-        this->type == Logger::STDOUT ? std::cout : std::cerr;
-
-    outStream << outstr;
-
-    SetConsoleTextAttribute(hConsole, originalBufferInfo.wAttributes);
-#endif
+    if (!AsyncLog::Instance().Write(nullptr, this->type, this->color, outstr))
+      writeToTerminal(this->type, this->color, outstr);
   }
 
   this->str("");
@@ -186,6 +579,9 @@ FileLogger::~FileLogger()
 {
   if (this->initialized && this->rdbuf())
   {
+    // Queued output may still refer to the stream
+    Console::Flush();
+
     FileLogger::Buffer *buf = static_cast<FileLogger::Buffer*>(
         this->rdbuf());
     if (buf->stream)
@@ -225,6 +621,7 @@ void FileLogger::Init(const std::string &_directory,
   // remove current buffer.
   if (buf->stream)
   {
+    Console::Flush();
     delete buf->stream;
     buf->stream = nullptr;
   }
@@ -298,10 +695,20 @@ int FileLogger::Buffer::sync()
   if (!this->stream)
     return -1;
 
-  *this->stream << this->str();
+  if (AsyncLog::Instance().Enabled() && this->pptr() != this->pbase() &&
+      *(this->pptr() - 1) != '\n')
+  {
+    return 0;
+  }
+
+  std::string outstr = this->str();
+  this->str("");
+  if (AsyncLog::Instance().Write(this->stream, Logger::STDOUT, 0, outstr))
+    return 0;
+
+  *this->stream << outstr;
 
   this->stream->flush();
 
-  this->str("");
   return !(*this->stream);
 }
@@ -0,0 +1,123 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <string>
+
+#include "ignition/common/Console.hh"
+#include "ignition/common/Filesystem.hh"
+#include "ignition/common/Util.hh"
+
+#include "test/util.hh"
+
+// This test is built with -DIGN_CONSOLE_MAX_LEVEL=1, which only keeps the
+// error messages.
+#if IGN_CONSOLE_MAX_LEVEL != 1
+#error "ConsoleMaxLevel_TEST must be compiled with IGN_CONSOLE_MAX_LEVEL=1"
+#endif
+
+#ifndef _WIN32
+class ConsoleMaxLevel_TEST : public ::testing::Test {
+  /// \brief Clear out all the directories we produced during this test.
+  public: virtual ~ConsoleMaxLevel_TEST()
+  {
+    std::string absPath;
+    ignition::common::env(IGN_HOMEDIR, absPath);
+    absPath = ignition::common::joinPaths(absPath, std::string(IGN_TMP_DIR));
+
+    if (ignition::common::isDirectory(absPath))
+    {
+      EXPECT_TRUE(ignition::common::removeAll(absPath));
+    }
+  }
+};
+
+/////////////////////////////////////////////////
+/// \brief Get the content of a log file.
+/// \param[in] _filename Path of the file, relative to the home directory.
+/// \return The content, without line breaks.
+std::string GetLogContent(const std::string &_filename)
+{
+  std::string path;
+  EXPECT_TRUE(ignition::common::env(IGN_HOMEDIR, path));
+  path = ignition::common::joinPaths(path, _filename);
+
+  std::ifstream ifs(path.c_str(), std::ios::in);
+  std::string loggedString;
+  std::string line;
+  while (std::getline(ifs, line))
+    loggedString += line;
+
+  return loggedString;
+}
+
+/////////////////////////////////////////////////
+/// \brief Messages above IGN_CONSOLE_MAX_LEVEL don't evaluate their stream
+/// arguments and produce no output, whatever the verbosity.
+TEST_F(ConsoleMaxLevel_TEST, CompiledOut)
+{
+  ignition::common::Console::SetVerbosity(4);
+
+  std::string path = ignition::common::joinPaths(
+        IGN_TMP_DIR, ignition::common::uuid());
+  ignLogInit(path, "test.log");
+  std::string logPath = ignition::common::joinPaths(path, "test.log");
+
+  int evaluated = 0;
+
+  ::testing::internal::CaptureStdout();
+  ::testing::internal::CaptureStderr();
+  ignwarn << "removed warning " << ++evaluated << std::endl;
+  ignmsg << "removed message " << ++evaluated << std::endl;
+  igndbg << "removed debug " << ++evaluated << std::endl;
+  ignwarnThrottle(0.0) << "removed warning " << ++evaluated << std::endl;
+  ignmsgThrottle(0.0) << "removed message " << ++evaluated << std::endl;
+  igndbgThrottle(0.0) << "removed debug " << ++evaluated << std::endl;
+  std::string out = ::testing::internal::GetCapturedStdout();
+  std::string err = ::testing::internal::GetCapturedStderr();
+
+  EXPECT_EQ(0, evaluated);
+  EXPECT_TRUE(out.empty()) << out;
+  EXPECT_TRUE(err.empty()) << err;
+
+  // The macros are still statements
+  if (evaluated == 0)
+    igndbg << "removed debug " << ++evaluated << std::endl;
+  else
+    FAIL();
+  EXPECT_EQ(0, evaluated);
+
+  // Errors are kept
+  ignerr << "kept error " << ++evaluated << std::endl;
+  ignerrThrottle(0.0) << "kept error " << ++evaluated << std::endl;
+  EXPECT_EQ(2, evaluated);
+
+  std::string logContent = GetLogContent(logPath);
+  EXPECT_TRUE(logContent.find("kept error 1") != std::string::npos);
+  EXPECT_TRUE(logContent.find("kept error 2") != std::string::npos);
+  EXPECT_TRUE(logContent.find("removed") == std::string::npos);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
+#endif
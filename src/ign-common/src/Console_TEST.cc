@@ -18,6 +18,10 @@
 #include <gtest/gtest.h>
 #include <stdlib.h>
 
+#include <chrono>
+#include <string>
+#include <thread>
+
 #include "ignition/common/Console.hh"
 #include "ignition/common/Filesystem.hh"
 #include "ignition/common/Time.hh"
@@ -543,6 +547,107 @@ TEST_F(Console_TEST, LogDirectory)
   EXPECT_EQ(logDir, absPath);
 }
 
+/////////////////////////////////////////////////
+/// \brief Test Console::SetAsync
+TEST_F(Console_TEST, Async)
+{
+  ignition::common::Console::SetVerbosity(4);
+
+  std::string path = ignition::common::joinPaths(
+        IGN_TMP_DIR, ignition::common::uuid());
+  ignLogInit(path, "test.log");
+  std::string logPath = ignition::common::joinPaths(path, "test.log");
+
+  EXPECT_FALSE(ignition::common::Console::Async());
+  ignition::common::Console::SetAsync(true);
+  EXPECT_TRUE(ignition::common::Console::Async());
+
+  for (int t = 0; t < 4; ++t)
+  {
+    for (int i = 0; i < g_messageRepeat; ++i)
+      ignwarn << "async " << t << " " << i << std::endl;
+  }
+  ignlog << "async log" << std::endl;
+
+  ignition::common::Console::Flush();
+  std::string logContent = GetLogContent(logPath);
+  for (int t = 0; t < 4; ++t)
+  {
+    for (int i = 0; i < g_messageRepeat; ++i)
+    {
+      std::stringstream stream;
+      stream << "async " << t << " " << i;
+      EXPECT_TRUE(logContent.find(stream.str()) != std::string::npos);
+    }
+  }
+  EXPECT_TRUE(logContent.find("async log") != std::string::npos);
+  EXPECT_EQ(0u, ignition::common::Console::DroppedMessages());
+
+  // Disabling writes what's left and goes back to synchronous logging
+  ignmsg << "last async message" << std::endl;
+  ignition::common::Console::SetAsync(false);
+  EXPECT_FALSE(ignition::common::Console::Async());
+  ignmsg << "sync message" << std::endl;
+  logContent = GetLogContent(logPath);
+  EXPECT_TRUE(logContent.find("last async message") != std::string::npos);
+  EXPECT_TRUE(logContent.find("sync message") != std::string::npos);
+
+  // Flushing without asynchronous logging does nothing
+  ignition::common::Console::Flush();
+}
+
+/////////////////////////////////////////////////
+/// \brief Test ignwarnThrottle and the other throttled macros
+TEST_F(Console_TEST, Throttle)
+{
+  ignition::common::Console::SetVerbosity(4);
+
+  std::string path = ignition::common::joinPaths(
+        IGN_TMP_DIR, ignition::common::uuid());
+  ignLogInit(path, "test.log");
+  std::string logPath = ignition::common::joinPaths(path, "test.log");
+
+  // Skipped messages aren't evaluated
+  int evaluated = 0;
+  for (int i = 0; i < 10; ++i)
+    ignwarnThrottle(100.0) << "throttled " << ++evaluated << std::endl;
+  EXPECT_EQ(1, evaluated);
+
+  // Each place has its own throttle, and the macros are statements
+  if (evaluated > 0)
+    igndbgThrottle(100.0) << "other place " << ++evaluated << std::endl;
+  else
+    FAIL();
+  ignerrThrottle(0.0) << "unthrottled " << ++evaluated << std::endl;
+  ignmsgThrottle(0.0) << "unthrottled " << ++evaluated << std::endl;
+  EXPECT_EQ(4, evaluated);
+
+  std::string logContent = GetLogContent(logPath);
+  EXPECT_TRUE(logContent.find("throttled 1") != std::string::npos);
+  EXPECT_TRUE(logContent.find("throttled 2") == std::string::npos);
+  EXPECT_TRUE(logContent.find("other place 2") != std::string::npos);
+  EXPECT_TRUE(logContent.find("unthrottled 4") != std::string::npos);
+
+  ignition::common::ConsoleThrottle throttle;
+  EXPECT_TRUE(throttle.Allow(0.05));
+  EXPECT_FALSE(throttle.Allow(0.05));
+  std::this_thread::sleep_for(std::chrono::milliseconds(60));
+  EXPECT_TRUE(throttle.Allow(0.05));
+  EXPECT_TRUE(throttle.Allow(0.0));
+}
+
+/////////////////////////////////////////////////
+/// \brief Messages compiled out with IGN_CONSOLE_MAX_LEVEL aren't evaluated
+TEST_F(Console_TEST, CompiledOut)
+{
+  ignition::common::Console::SetVerbosity(4);
+
+  int evaluated = 0;
+  IGN_CONSOLE_IF_(false, ignerr) << "compiled out " << ++evaluated;
+  IGN_CONSOLE_IF_(true, ignlog) << "compiled in " << ++evaluated << "\n";
+  EXPECT_EQ(1, evaluated);
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
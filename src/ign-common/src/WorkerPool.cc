@@ -15,8 +15,11 @@
  *
 */
 
-
-#include <queue>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
 #include <thread>
 #include <utility>
 
@@ -24,101 +27,496 @@
 
 namespace igncmn = ignition::common;
 using namespace igncmn;
+using igncmn::detail::WorkerTask;
+
+/// \brief Number of times an idle worker looks for work before sleeping
+static const int kSpinCount = 64;
 
 namespace ignition
 {
   namespace common
   {
-    /// \brief info needed to perform work
-    class WorkOrder
+    /// \brief Double ended queue of work orders owned by a worker, which
+    /// pushes and pops at the bottom while other threads steal from the top.
+    /// This is the Chase-Lev deque, with the memory orderings given by Le et
+    /// al. in "Correct and Efficient Work-Stealing for Weak Memory Models".
+    class TaskDeque
     {
-      /// \brief Default constructor
-      public: WorkOrder() = default;
-
-      /// \brief Constructor used by std::deque::emplace.
-      /// \param[in] _work Work function.
-      /// \param[in] _cb Callback function.
-      public: WorkOrder(const std::function<void()> &_work,
-                 const std::function<void()> &_cb)
-        : work(_work), callback(_cb) {}
-
-      /// \brief method that does the work
-      public: std::function<void()> work = std::function<void()>();
-
-      /// \brief callback to invoke after working
-      public: std::function<void()> callback = std::function<void()>();
+      /// \brief Constructor
+      public: TaskDeque()
+      {
+        this->rings.emplace_back(new Ring(256));
+        this->ring.store(this->rings.back().get(), std::memory_order_relaxed);
+      }
+
+      /// \brief Add a work order at the bottom. Only called by the owner.
+      /// \param[in] _task The work order.
+      public: void Push(WorkerTask *_task)
+      {
+        const int64_t b = this->bottom.load(std::memory_order_relaxed);
+        const int64_t t = this->top.load(std::memory_order_acquire);
+        Ring *a = this->ring.load(std::memory_order_relaxed);
+        if (b - t > a->capacity - 1)
+        {
+          // Thieves may still be reading the old ring, so it's kept until
+          // the deque is destroyed
+          this->rings.emplace_back(a->Grow(b, t));
+          a = this->rings.back().get();
+          this->ring.store(a, std::memory_order_release);
+        }
+        a->Put(b, _task);
+        this->bottom.store(b + 1, std::memory_order_release);
+      }
+
+      /// \brief Take the work order at the bottom. Only called by the owner.
+      /// \return The work order, or nullptr if the deque is empty.
+      public: WorkerTask *Pop()
+      {
+        const int64_t b = this->bottom.load(std::memory_order_relaxed) - 1;
+        Ring *a = this->ring.load(std::memory_order_relaxed);
+        this->bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t t = this->top.load(std::memory_order_relaxed);
+
+        WorkerTask *task = nullptr;
+        if (t <= b)
+        {
+          task = a->Get(b);
+          if (t == b)
+          {
+            // Last work order, race the thieves for it
+            if (!this->top.compare_exchange_strong(t, t + 1,
+                  std::memory_order_seq_cst, std::memory_order_relaxed))
+            {
+              task = nullptr;
+            }
+            this->bottom.store(b + 1, std::memory_order_relaxed);
+          }
+        }
+        else
+        {
+          this->bottom.store(b + 1, std::memory_order_relaxed);
+        }
+        return task;
+      }
+
+      /// \brief Take the work order at the top. Called by any thread.
+      /// \return The work order, or nullptr if the deque is empty.
+      public: WorkerTask *Steal()
+      {
+        while (true)
+        {
+          int64_t t = this->top.load(std::memory_order_acquire);
+          std::atomic_thread_fence(std::memory_order_seq_cst);
+          const int64_t b = this->bottom.load(std::memory_order_acquire);
+          if (t >= b)
+            return nullptr;
+
+          Ring *a = this->ring.load(std::memory_order_acquire);
+          WorkerTask *task = a->Get(t);
+          if (this->top.compare_exchange_strong(t, t + 1,
+                std::memory_order_seq_cst, std::memory_order_relaxed))
+          {
+            return task;
+          }
+        }
+      }
+
+      /// \brief Circular array of work orders
+      private: class Ring
+      {
+        /// \brief Constructor
+        /// \param[in] _capacity Number of slots, a power of two.
+        public: explicit Ring(const int64_t _capacity)
+          : capacity(_capacity), mask(_capacity - 1),
+            slots(new std::atomic<WorkerTask *>[_capacity])
+        {
+        }
+
+        /// \brief Get a slot.
+        /// \param[in] _i Index, wrapped around the capacity.
+        /// \return Work order in the slot.
+        public: WorkerTask *Get(const int64_t _i) const
+        {
+          return this->slots[_i & this->mask].load(std::memory_order_relaxed);
+        }
+
+        /// \brief Set a slot.
+        /// \param[in] _i Index, wrapped around the capacity.
+        /// \param[in] _task Work order.
+        public: void Put(const int64_t _i, WorkerTask *_task)
+        {
+          this->slots[_i & this->mask].store(_task, std::memory_order_relaxed);
+        }
+
+        /// \brief Copy the work orders to a ring twice as large.
+        /// \param[in] _bottom Index after the last work order.
+        /// \param[in] _top Index of the first work order.
+        /// \return The new ring.
+        public: Ring *Grow(const int64_t _bottom, const int64_t _top) const
+        {
+          Ring *grown = new Ring(this->capacity * 2);
+          for (int64_t i = _top; i < _bottom; ++i)
+            grown->Put(i, this->Get(i));
+          return grown;
+        }
+
+        /// \brief Number of slots
+        public: const int64_t capacity;
+
+        /// \brief Mask wrapping indices around the capacity
+        public: const int64_t mask;
+
+        /// \brief The slots
+        public: std::unique_ptr<std::atomic<WorkerTask *>[]> slots;
+      };
+
+      /// \brief Index of the first work order, advanced by thieves and by
+      /// the owner taking the last work order
+      private: alignas(64) std::atomic<int64_t> top{0};
+
+      /// \brief Index after the last work order, only written by the owner
+      private: alignas(64) std::atomic<int64_t> bottom{0};
+
+      /// \brief Current ring
+      private: std::atomic<Ring *> ring{nullptr};
+
+      /// \brief All the rings used so far, only accessed by the owner
+      private: std::vector<std::unique_ptr<Ring>> rings;
     };
 
     /// \brief Private implementation
     class WorkerPoolPrivate
     {
       /// \brief Does work until signaled to shut down
-      public: void Worker();
+      /// \param[in] _index Index of the worker.
+      public: void Worker(const std::size_t _index);
+
+      /// \brief Get the index of the worker running on the calling thread.
+      /// \return Index of the worker, or -1 if the calling thread isn't a
+      /// worker of this pool.
+      public: int WorkerIndex() const;
+
+      /// \brief Find work for a worker: from the bottom of its queue, then
+      /// from the work added by other threads, then from the other queues.
+      /// \param[in] _index Index of the worker.
+      /// \return A work order, or nullptr if none was found.
+      public: WorkerTask *FindWork(const std::size_t _index);
+
+      /// \brief Do the work of a work order and delete it.
+      /// \param[in] _task The work order.
+      public: void Execute(WorkerTask *_task);
+
+      /// \brief Add a list of work orders.
+      /// \param[in] _first First work order, linked to the others in order.
+      /// \param[in] _count Number of work orders.
+      public: void Submit(WorkerTask *_first, const std::size_t _count);
+
+      /// \brief Wake up sleeping workers after adding work.
+      /// \param[in] _count Number of work orders added.
+      public: void Wake(const std::size_t _count);
+
+      /// \brief Wake up the threads blocked in Block.
+      public: void NotifyWaiters();
+
+      /// \brief Block the calling thread until a condition is met or the
+      /// pool is shut down.
+      /// \param[in] _done The condition.
+      /// \param[in] _timeout How long to wait, or zero to wait forever.
+      /// \return False if the timeout expired.
+      public: bool Block(const std::function<bool()> &_done,
+                  const Time &_timeout);
+
+      /// \brief Wait until a condition is met, doing work on the calling
+      /// thread if it's a worker, or blocking it otherwise.
+      /// \param[in] _done The condition.
+      public: void Join(const std::function<bool()> &_done);
 
       /// \brief threads that do work
       public: std::vector<std::thread> workers;
 
-      /// \brief queue of work for workers
-      public: std::queue<WorkOrder> workOrders;
+      /// \brief queue of work of each worker
+      public: std::vector<std::unique_ptr<TaskDeque>> queues;
 
-      /// \brief used to count how many threads are actively working
-      public: int activeOrders = 0;
+      /// \brief Work added by threads which aren't workers, newest first.
+      /// Workers take the whole list at once.
+      public: std::atomic<WorkerTask *> injected{nullptr};
 
-      /// \brief lock for workOrders access
-      public: std::mutex queueMtx;
+      /// \brief Number of work orders added and not done yet
+      public: std::atomic<std::size_t> pending{0};
 
-      /// \brief used to signal when all work is done
-      public: std::condition_variable signalWorkDone;
+      /// \brief Number of workers going to sleep or sleeping
+      public: std::atomic<int> sleeping{0};
+
+      /// \brief Incremented when work is added while workers sleep
+      public: std::atomic<uint64_t> epoch{0};
+
+      /// \brief lock for sleeping
+      public: std::mutex sleepMtx;
 
       /// \brief used to signal when new work is available
       public: std::condition_variable signalNewWork;
 
+      /// \brief Number of threads blocked in Block
+      public: std::atomic<int> waiters{0};
+
+      /// \brief lock for waiting on work to be done
+      public: std::mutex waitMtx;
+
+      /// \brief used to signal when work is done
+      public: std::condition_variable signalWorkDone;
+
       /// \brief used to signal when the pool is being shut down
-      public: bool done = false;
+      public: std::atomic<bool> done{false};
+    };
+
+    /// \brief Private implementation
+    class TaskGroupPrivate
+    {
+      /// \brief Pool running the work
+      public: WorkerPoolPrivate *pool = nullptr;
+
+      /// \brief Number of pieces of work added and not done yet
+      public: std::atomic<std::size_t> pending{0};
     };
   }
 }
 
+/// \brief Pool of the worker running on this thread
+static thread_local WorkerPoolPrivate *tlPool = nullptr;
+
+/// \brief Index of the worker running on this thread
+static thread_local std::size_t tlIndex = 0;
+
+/// \brief State of the random number generator picking workers to steal
+/// from
+static thread_local uint32_t tlRandom = 1;
+
 //////////////////////////////////////////////////
-void WorkerPoolPrivate::Worker()
+int WorkerPoolPrivate::WorkerIndex() const
 {
-  WorkOrder order;
+  return tlPool == this ? static_cast<int>(tlIndex) : -1;
+}
+
+//////////////////////////////////////////////////
+WorkerTask *WorkerPoolPrivate::FindWork(const std::size_t _index)
+{
+  TaskDeque &queue = *this->queues[_index];
+  WorkerTask *task = queue.Pop();
+  if (task)
+    return task;
+
+  // Move the work added by other threads to this worker's queue, where
+  // other workers can steal it. The list is newest first, so the oldest
+  // ends up at the bottom and is done first.
+  task = this->injected.exchange(nullptr, std::memory_order_acquire);
+  if (task)
+  {
+    while (task->next)
+    {
+      WorkerTask *next = task->next;
+      task->next = nullptr;
+      queue.Push(task);
+      task = next;
+    }
+    return task;
+  }
+
+  // Steal, starting from a random worker to spread the thieves
+  const std::size_t count = this->queues.size();
+  tlRandom ^= tlRandom << 13;
+  tlRandom ^= tlRandom >> 17;
+  tlRandom ^= tlRandom << 5;
+  const std::size_t start = tlRandom % count;
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    const std::size_t victim = (start + i) % count;
+    if (victim == _index)
+      continue;
+    task = this->queues[victim]->Steal();
+    if (task)
+      return task;
+  }
+  return nullptr;
+}
+
+//////////////////////////////////////////////////
+void WorkerPoolPrivate::Execute(WorkerTask *_task)
+{
+  _task->Run();
+  delete _task;
+
+  if (this->pending.fetch_sub(1) == 1)
+    this->NotifyWaiters();
+}
+
+//////////////////////////////////////////////////
+void WorkerPoolPrivate::Worker(const std::size_t _index)
+{
+  tlPool = this;
+  tlIndex = _index;
+  tlRandom = static_cast<uint32_t>(_index) * 2654435761u + 1u;
 
   // Run until pool is destructed, waiting for work
-  while (true)
+  while (!this->done)
   {
-    // Scoped to release lock before doing work
+    WorkerTask *task = this->FindWork(_index);
+    for (int spin = 0; !task && spin < kSpinCount && !this->done; ++spin)
+    {
+      std::this_thread::yield();
+      task = this->FindWork(_index);
+    }
+
+    if (!task)
     {
-      std::unique_lock<std::mutex> queueLock(this->queueMtx);
+      // Announce the sleep before looking for work one last time, so that
+      // work added meanwhile is either found here or wakes this worker up
+      this->sleeping.fetch_add(1);
+      const uint64_t epochBefore = this->epoch.load();
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      task = this->FindWork(_index);
+      if (!task)
+      {
+        std::unique_lock<std::mutex> sleepLock(this->sleepMtx);
+        this->signalNewWork.wait(sleepLock, [this, epochBefore]
+            {
+              return this->done || this->epoch.load() != epochBefore;
+            });
+      }
+      this->sleeping.fetch_sub(1);
+    }
 
-      // Wait for a work order
-      while (!this->done && this->workOrders.empty())
-        this->signalNewWork.wait(queueLock);
+    if (task)
+      this->Execute(task);
+  }
 
-      // Destructor may have signaled to shutdown workers
-      if (this->done)
-        break;
+  tlPool = nullptr;
+}
 
-      // Take a work order from the queue
-      ++(this->activeOrders);
-      order = std::move(workOrders.front());
-      workOrders.pop();
+//////////////////////////////////////////////////
+void WorkerPoolPrivate::Submit(WorkerTask *_first, const std::size_t _count)
+{
+  this->pending.fetch_add(_count);
+
+  const int index = this->WorkerIndex();
+  if (index >= 0)
+  {
+    // Work added by a worker goes to its own queue
+    TaskDeque &queue = *this->queues[index];
+    for (WorkerTask *task = _first; task;)
+    {
+      WorkerTask *next = task->next;
+      task->next = nullptr;
+      queue.Push(task);
+      task = next;
     }
+  }
+  else
+  {
+    // Reverse the list to keep the injected list newest first, then push it
+    // in front of the list
+    WorkerTask *newest = nullptr;
+    for (WorkerTask *task = _first; task;)
+    {
+      WorkerTask *next = task->next;
+      task->next = newest;
+      newest = task;
+      task = next;
+    }
+
+    _first->next = this->injected.load(std::memory_order_relaxed);
+    while (!this->injected.compare_exchange_weak(_first->next, newest,
+          std::memory_order_release, std::memory_order_relaxed))
+    {
+    }
+  }
 
-    // Do the work
-    if (order.work)
-      order.work();
+  this->Wake(_count);
+}
 
-    if (order.callback)
-      order.callback();
+//////////////////////////////////////////////////
+void WorkerPoolPrivate::Wake(const std::size_t _count)
+{
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (this->sleeping.load(std::memory_order_relaxed) == 0)
+    return;
 
+  {
+    std::lock_guard<std::mutex> sleepLock(this->sleepMtx);
+    this->epoch.fetch_add(1);
+  }
+
+  if (_count > 1)
+    this->signalNewWork.notify_all();
+  else
+    this->signalNewWork.notify_one();
+}
+
+//////////////////////////////////////////////////
+void WorkerPoolPrivate::NotifyWaiters()
+{
+  if (this->waiters.load() == 0)
+    return;
+
+  // Taking the lock makes sure waiters are either waiting on the condition
+  // or haven't checked it yet
+  {
+    std::lock_guard<std::mutex> waitLock(this->waitMtx);
+  }
+  this->signalWorkDone.notify_all();
+}
+
+//////////////////////////////////////////////////
+bool WorkerPoolPrivate::Block(const std::function<bool()> &_done,
+    const Time &_timeout)
+{
+  auto haveResults = [this, &_done]() -> bool
+    {
+      return this->done || _done();
+    };
+
+  this->waiters.fetch_add(1);
+  bool signaled = true;
+  {
+    std::unique_lock<std::mutex> waitLock(this->waitMtx);
+    if (Time::Zero == _timeout)
     {
-      std::unique_lock<std::mutex> queueLock(this->queueMtx);
-      --(this->activeOrders);
-      if (this->workOrders.empty() && this->activeOrders <= 0)
-        this->signalWorkDone.notify_all();
+      // Wait forever
+      this->signalWorkDone.wait(waitLock, haveResults);
+    }
+    else
+    {
+      // Wait for timeout
+      signaled = this->signalWorkDone.wait_for(waitLock,
+          std::chrono::seconds(_timeout.sec) +
+          std::chrono::nanoseconds(_timeout.nsec),
+          haveResults);
     }
   }
+  this->waiters.fetch_sub(1);
+  return signaled;
+}
+
+//////////////////////////////////////////////////
+void WorkerPoolPrivate::Join(const std::function<bool()> &_done)
+{
+  const int index = this->WorkerIndex();
+  if (index < 0)
+  {
+    this->Block(_done, Time::Zero);
+    return;
+  }
+
+  // Blocking a worker could deadlock if the work being waited for is in its
+  // own queue, so do work instead
+  while (!_done() && !this->done)
+  {
+    WorkerTask *task = this->FindWork(index);
+    if (task)
+      this->Execute(task);
+    else
+      std::this_thread::yield();
+  }
 }
 
 //////////////////////////////////////////////////
@@ -128,11 +526,14 @@ WorkerPool::WorkerPool(const unsigned int _minThreadCount)
   unsigned int numWorkers = std::max(std::thread::hardware_concurrency(),
       std::max(_minThreadCount, 1u));
 
+  for (unsigned int w = 0; w < numWorkers; ++w)
+    this->dataPtr->queues.emplace_back(new TaskDeque);
+
   // create worker threads
   for (unsigned int w = 0; w < numWorkers; ++w)
   {
     this->dataPtr->workers.push_back(
-        std::thread(&WorkerPoolPrivate::Worker, this->dataPtr.get()));
+        std::thread(&WorkerPoolPrivate::Worker, this->dataPtr.get(), w));
   }
 }
 
@@ -141,7 +542,7 @@ WorkerPool::~WorkerPool()
 {
   // shutdown worker threads
   {
-    std::unique_lock<std::mutex> queueLock(this->dataPtr->queueMtx);
+    std::unique_lock<std::mutex> sleepLock(this->dataPtr->sleepMtx);
     this->dataPtr->done = true;
   }
   this->dataPtr->signalNewWork.notify_all();
@@ -152,45 +553,179 @@ WorkerPool::~WorkerPool()
   }
 
   // Signal in case anyone is still waiting for work to finish
+  {
+    std::lock_guard<std::mutex> waitLock(this->dataPtr->waitMtx);
+  }
   this->dataPtr->signalWorkDone.notify_all();
+
+  // Drop the work which didn't start
+  for (auto &queue : this->dataPtr->queues)
+  {
+    while (WorkerTask *task = queue->Pop())
+      delete task;
+  }
+  WorkerTask *task = this->dataPtr->injected.exchange(nullptr);
+  while (task)
+  {
+    WorkerTask *next = task->next;
+    delete task;
+    task = next;
+  }
 }
 
 //////////////////////////////////////////////////
 void WorkerPool::AddWork(std::function<void()> _work, std::function<void()> _cb)
 {
-  std::unique_lock<std::mutex> queueLock(this->dataPtr->queueMtx);
-  this->dataPtr->workOrders.emplace(_work, _cb);
-  this->dataPtr->signalNewWork.notify_one();
+  this->dataPtr->Submit(new WorkerTask(
+      [work = std::move(_work), cb = std::move(_cb)]()
+      {
+        if (work)
+          work();
+
+        if (cb)
+          cb();
+      }), 1);
+}
+
+//////////////////////////////////////////////////
+void WorkerPool::AddWorkBatch(std::vector<std::function<void()>> _work)
+{
+  if (_work.empty())
+    return;
+
+  WorkerTask *first = nullptr;
+  WorkerTask *last = nullptr;
+  for (auto &work : _work)
+  {
+    WorkerTask *task = new WorkerTask(
+        [work = std::move(work)]()
+        {
+          if (work)
+            work();
+        });
+    if (last)
+      last->next = task;
+    else
+      first = task;
+    last = task;
+  }
+  this->dataPtr->Submit(first, _work.size());
 }
 
 //////////////////////////////////////////////////
 bool WorkerPool::WaitForResults(const Time &_timeout)
 {
-  bool signaled = true;
-  std::unique_lock<std::mutex> queueLock(this->dataPtr->queueMtx);
+  bool signaled = this->dataPtr->Block([this]() -> bool
+      {
+        return this->dataPtr->pending.load() == 0;
+      }, _timeout);
+  return signaled && !this->dataPtr->done;
+}
 
-  // Lambda to keep logic in one place for both cases
-  std::function<bool()> haveResults = [this] () -> bool
+//////////////////////////////////////////////////
+unsigned int WorkerPool::ThreadCount() const
+{
+  return static_cast<unsigned int>(this->dataPtr->workers.size());
+}
+
+//////////////////////////////////////////////////
+void WorkerPool::ParallelChunks(const std::size_t _count,
+    void (*_body)(void *, const std::size_t), void *_context)
+{
+  if (_count == 0)
+    return;
+
+  if (_count == 1)
+  {
+    _body(_context, 0);
+    return;
+  }
+
+  /// \brief Chunks shared by the calling thread and the workers
+  struct Chunks
+  {
+    std::atomic<std::size_t> next{0};
+    std::atomic<std::size_t> finished{0};
+    std::size_t count;
+    void (*body)(void *, const std::size_t);
+    void *context;
+  };
+
+  // Workers which start after all the chunks were taken return without
+  // using the body or the context, but still need the counters
+  auto chunks = std::make_shared<Chunks>();
+  chunks->count = _count;
+  chunks->body = _body;
+  chunks->context = _context;
+
+  WorkerPoolPrivate *pool = this->dataPtr.get();
+  auto runChunks = [chunks, pool]()
     {
-      return this->dataPtr->done ||
-        (this->dataPtr->workOrders.empty() && !this->dataPtr->activeOrders);
+      std::size_t chunk;
+      while ((chunk = chunks->next.fetch_add(1)) < chunks->count)
+      {
+        chunks->body(chunks->context, chunk);
+        if (chunks->finished.fetch_add(1) + 1 == chunks->count)
+          pool->NotifyWaiters();
+      }
     };
 
-  if (!haveResults())
+  const std::size_t helpers =
+      std::min<std::size_t>(_count - 1, this->dataPtr->workers.size());
+  WorkerTask *first = nullptr;
+  WorkerTask *last = nullptr;
+  for (std::size_t i = 0; i < helpers; ++i)
   {
-    if (Time::Zero == _timeout)
-    {
-      // Wait forever
-      this->dataPtr->signalWorkDone.wait(queueLock);
-    }
+    WorkerTask *task = new WorkerTask(runChunks);
+    if (last)
+      last->next = task;
     else
-    {
-      // Wait for timeout
-      signaled = this->dataPtr->signalWorkDone.wait_for(queueLock,
-          std::chrono::seconds(_timeout.sec) +
-          std::chrono::nanoseconds(_timeout.nsec),
-          haveResults);
-    }
+      first = task;
+    last = task;
   }
-  return signaled && !this->dataPtr->done;
+  this->dataPtr->Submit(first, helpers);
+
+  runChunks();
+  this->dataPtr->Join([&chunks]()
+      {
+        return chunks->finished.load() == chunks->count;
+      });
+}
+
+//////////////////////////////////////////////////
+TaskGroup::TaskGroup(WorkerPool &_pool)
+  : dataPtr(new TaskGroupPrivate)
+{
+  this->dataPtr->pool = _pool.dataPtr.get();
+}
+
+//////////////////////////////////////////////////
+TaskGroup::~TaskGroup()
+{
+  this->Wait();
+}
+
+//////////////////////////////////////////////////
+void TaskGroup::Submit(WorkerTask *_task)
+{
+  this->dataPtr->pending.fetch_add(1);
+  this->dataPtr->pool->Submit(_task, 1);
+}
+
+//////////////////////////////////////////////////
+void TaskGroup::Finish()
+{
+  // The group may be destroyed as soon as the count reaches zero
+  WorkerPoolPrivate *pool = this->dataPtr->pool;
+  if (this->dataPtr->pending.fetch_sub(1) == 1)
+    pool->NotifyWaiters();
+}
+
+//////////////////////////////////////////////////
+void TaskGroup::Wait()
+{
+  this->dataPtr->pool->Join([this]()
+      {
+        return this->dataPtr->pending.load() == 0;
+      });
 }
@@ -17,7 +17,13 @@
 
 #include <gtest/gtest.h>
 
+#include <array>
 #include <atomic>
+#include <chrono>
+#include <functional>
+#include <numeric>
+#include <thread>
+#include <vector>
 
 #include "ignition/common/Console.hh"
 #include "ignition/common/WorkerPool.hh"
@@ -146,6 +152,195 @@ TEST(WorkerPool, ThingsRunInParallel)
   EXPECT_EQ(2, sentinel);
 }
 
+//////////////////////////////////////////////////
+TEST(WorkerPool, AddWorkBatch)
+{
+  WorkerPool pool;
+  std::atomic<int> workSentinel(0);
+
+  std::vector<std::function<void()>> work;
+  for (int i = 0; i < 1000; i++)
+  {
+    work.push_back([&workSentinel, i] ()
+        {
+          workSentinel += i;
+        });
+  }
+  pool.AddWorkBatch(work);
+  pool.AddWorkBatch({});
+  EXPECT_TRUE(pool.WaitForResults());
+  EXPECT_EQ(999 * 1000 / 2, workSentinel);
+}
+
+//////////////////////////////////////////////////
+TEST(WorkerPool, WorkAddedByWork)
+{
+  WorkerPool pool;
+  std::atomic<int> workSentinel(0);
+
+  for (int i = 0; i < 10; i++)
+  {
+    pool.AddWork([&pool, &workSentinel] ()
+        {
+          for (int j = 0; j < 100; j++)
+          {
+            pool.AddWork([&workSentinel] ()
+                {
+                  workSentinel += 1;
+                });
+          }
+        });
+  }
+  EXPECT_TRUE(pool.WaitForResults());
+  EXPECT_EQ(1000, workSentinel);
+}
+
+//////////////////////////////////////////////////
+TEST(WorkerPool, ParallelFor)
+{
+  WorkerPool pool;
+  EXPECT_GE(pool.ThreadCount(), 1u);
+
+  std::vector<int> values(10000, 0);
+  pool.ParallelFor(0, values.size(), [&values] (const std::size_t _i)
+      {
+        values[_i] = static_cast<int>(_i);
+      });
+  for (std::size_t i = 0; i < values.size(); ++i)
+    EXPECT_EQ(static_cast<int>(i), values[i]);
+
+  // Chunks of one index, and a range which doesn't start at zero
+  std::atomic<int> calls(0);
+  pool.ParallelFor(10, 20, [&calls] (const std::size_t _i)
+      {
+        EXPECT_GE(_i, 10u);
+        EXPECT_LT(_i, 20u);
+        ++calls;
+      }, 1);
+  EXPECT_EQ(10, calls);
+
+  // Empty ranges
+  pool.ParallelFor(5, 5, [&calls] (const std::size_t)
+      {
+        ++calls;
+      });
+  pool.ParallelFor(5, 0, [&calls] (const std::size_t)
+      {
+        ++calls;
+      });
+  EXPECT_EQ(10, calls);
+}
+
+//////////////////////////////////////////////////
+TEST(WorkerPool, NestedParallelFor)
+{
+  WorkerPool pool(2);
+  std::vector<std::atomic<int>> sums(8);
+  for (auto &sum : sums)
+    sum = 0;
+
+  // Workers wait for inner loops by running other work, so this doesn't
+  // deadlock even when every worker runs an outer index
+  pool.ParallelFor(0, sums.size(), [&pool, &sums] (const std::size_t _i)
+      {
+        pool.ParallelFor(0, 100, [&sums, _i] (const std::size_t _j)
+            {
+              sums[_i] += static_cast<int>(_j);
+            }, 7);
+      }, 1);
+  for (auto &sum : sums)
+    EXPECT_EQ(99 * 100 / 2, sum);
+}
+
+//////////////////////////////////////////////////
+TEST(WorkerPool, TaskGroup)
+{
+  WorkerPool pool;
+  std::atomic<int> first(0);
+  std::atomic<int> second(0);
+
+  TaskGroup group(pool);
+  TaskGroup otherGroup(pool);
+  for (int i = 0; i < 100; i++)
+  {
+    group.Run([&first] ()
+        {
+          first += 1;
+        });
+  }
+  otherGroup.Run([&second] ()
+      {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        second += 1;
+      });
+
+  // Waiting on a group doesn't wait on the work of other groups
+  group.Wait();
+  EXPECT_EQ(100, first);
+  otherGroup.Wait();
+  EXPECT_EQ(1, second);
+
+  // Groups can be reused and nested
+  std::atomic<int> nested(0);
+  for (int i = 0; i < 4; i++)
+  {
+    group.Run([&pool, &nested] ()
+        {
+          TaskGroup inner(pool);
+          for (int j = 0; j < 10; j++)
+          {
+            inner.Run([&nested] ()
+                {
+                  nested += 1;
+                });
+          }
+          inner.Wait();
+        });
+  }
+  group.Wait();
+  EXPECT_EQ(40, nested);
+  EXPECT_TRUE(pool.WaitForResults());
+}
+
+//////////////////////////////////////////////////
+TEST(WorkerPool, LargeWork)
+{
+  WorkerPool pool;
+  std::atomic<int> workSentinel(0);
+
+  // Captures too large to be stored in the work order
+  std::array<int, 32> big;
+  big.fill(1);
+  for (int i = 0; i < 100; i++)
+  {
+    pool.AddWork([&workSentinel, big] ()
+        {
+          workSentinel += std::accumulate(big.begin(), big.end(), 0);
+        });
+  }
+  EXPECT_TRUE(pool.WaitForResults());
+  EXPECT_EQ(3200, workSentinel);
+}
+
+//////////////////////////////////////////////////
+TEST(WorkerPool, DestroyWithPendingWork)
+{
+  std::atomic<int> workSentinel(0);
+  {
+    WorkerPool pool(1);
+    for (int i = 0; i < 1000; i++)
+    {
+      pool.AddWork([&workSentinel] ()
+          {
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+            workSentinel += 1;
+          });
+    }
+  }
+  // Work which didn't start is dropped
+  EXPECT_LE(workSentinel, 1000);
+}
+
 //////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
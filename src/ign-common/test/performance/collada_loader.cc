@@ -0,0 +1,230 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "ignition/common/ColladaLoader.hh"
+#include "ignition/common/Console.hh"
+#include "ignition/common/Filesystem.hh"
+#include "ignition/common/Mesh.hh"
+
+#include "test_config.h"
+
+using namespace ignition;
+
+/// \brief Number of geometries in the generated mesh
+static const unsigned int kGeometryCount = 200;
+
+/// \brief Number of grid cells along each side of a generated geometry
+static const unsigned int kGridSize = 40;
+
+/// \brief Number of times each file is loaded
+static const unsigned int kLoadCount = 3;
+
+/////////////////////////////////////////////////
+/// \brief Write a Collada file made of many triangulated grids, each one a
+/// separate geometry instanced by its own node, so that loading it resolves
+/// a large number of ids.
+/// \param[in] _path Path of the file to write.
+void writeGridMesh(const std::string &_path)
+{
+  const unsigned int vertCount = (kGridSize + 1) * (kGridSize + 1);
+  const unsigned int triCount = kGridSize * kGridSize * 2;
+
+  std::ofstream out(_path);
+  out << R"(<?xml version="1.0" encoding="utf-8"?>
+<COLLADA xmlns="http://www.collada.org/2005/11/COLLADASchema" version="1.4.1">
+  <asset>
+    <unit name="meter" meter="1"/>
+    <up_axis>Z_UP</up_axis>
+  </asset>
+  <library_geometries>)";
+
+  for (unsigned int g = 0; g < kGeometryCount; ++g)
+  {
+    const std::string id = "grid_" + std::to_string(g);
+
+    out << "\n    <geometry id=\"" << id << "\">\n      <mesh>"
+        << "\n        <source id=\"" << id << "-positions\">"
+        << "\n          <float_array id=\"" << id << "-positions-array\" "
+        << "count=\"" << vertCount * 3 << "\">";
+    for (unsigned int i = 0; i <= kGridSize; ++i)
+    {
+      for (unsigned int j = 0; j <= kGridSize; ++j)
+      {
+        out << i * 0.01 << " " << j * 0.01 << " "
+            << 0.001 * ((i * 7 + j * 3 + g) % 11) << " ";
+      }
+    }
+    out << "</float_array>"
+        << "\n          <technique_common>"
+        << "\n            <accessor source=\"#" << id << "-positions-array\" "
+        << "count=\"" << vertCount << "\" stride=\"3\">"
+        << "\n              <param name=\"X\" type=\"float\"/>"
+        << "\n              <param name=\"Y\" type=\"float\"/>"
+        << "\n              <param name=\"Z\" type=\"float\"/>"
+        << "\n            </accessor>"
+        << "\n          </technique_common>"
+        << "\n        </source>";
+
+    out << "\n        <source id=\"" << id << "-normals\">"
+        << "\n          <float_array id=\"" << id << "-normals-array\" "
+        << "count=\"" << vertCount * 3 << "\">";
+    for (unsigned int i = 0; i < vertCount; ++i)
+      out << "0 0 1 ";
+    out << "</float_array>"
+        << "\n          <technique_common>"
+        << "\n            <accessor source=\"#" << id << "-normals-array\" "
+        << "count=\"" << vertCount << "\" stride=\"3\">"
+        << "\n              <param name=\"X\" type=\"float\"/>"
+        << "\n              <param name=\"Y\" type=\"float\"/>"
+        << "\n              <param name=\"Z\" type=\"float\"/>"
+        << "\n            </accessor>"
+        << "\n          </technique_common>"
+        << "\n        </source>";
+
+    out << "\n        <vertices id=\"" << id << "-vertices\">"
+        << "\n          <input semantic=\"POSITION\" source=\"#" << id
+        << "-positions\"/>"
+        << "\n        </vertices>"
+        << "\n        <triangles count=\"" << triCount << "\">"
+        << "\n          <input semantic=\"VERTEX\" source=\"#" << id
+        << "-vertices\" offset=\"0\"/>"
+        << "\n          <input semantic=\"NORMAL\" source=\"#" << id
+        << "-normals\" offset=\"1\"/>"
+        << "\n          <p>";
+    for (unsigned int i = 0; i < kGridSize; ++i)
+    {
+      for (unsigned int j = 0; j < kGridSize; ++j)
+      {
+        unsigned int v0 = i * (kGridSize + 1) + j;
+        unsigned int v1 = v0 + 1;
+        unsigned int v2 = v0 + kGridSize + 1;
+        unsigned int v3 = v2 + 1;
+        for (auto v : {v0, v2, v1, v1, v2, v3})
+          out << v << " " << v << " ";
+      }
+    }
+    out << "</p>"
+        << "\n        </triangles>"
+        << "\n      </mesh>"
+        << "\n    </geometry>";
+  }
+
+  out << R"(
+  </library_geometries>
+  <library_visual_scenes>
+    <visual_scene id="Scene" name="Scene">)";
+  for (unsigned int g = 0; g < kGeometryCount; ++g)
+  {
+    out << "\n      <node id=\"node_" << g << "\" name=\"node_" << g << "\">"
+        << "\n        <matrix>1 0 0 " << g * 0.5 << " 0 1 0 0 0 0 1 0 "
+        << "0 0 0 1</matrix>"
+        << "\n        <instance_geometry url=\"#grid_" << g << "\"/>"
+        << "\n      </node>";
+  }
+  out << R"(
+    </visual_scene>
+  </library_visual_scenes>
+  <scene>
+    <instance_visual_scene url="#Scene"/>
+  </scene>
+</COLLADA>
+)";
+}
+
+/////////////////////////////////////////////////
+/// \brief Load a Collada file a few times.
+/// \param[in] _path Path to the file.
+/// \return Mean time taken to load the file, in milliseconds, or a negative
+/// number if it failed to load.
+double meanLoadTime(const std::string &_path)
+{
+  std::chrono::steady_clock::duration total{0};
+  for (unsigned int i = 0; i < kLoadCount; ++i)
+  {
+    common::ColladaLoader loader;
+    auto start = std::chrono::steady_clock::now();
+    std::unique_ptr<common::Mesh> mesh(loader.Load(_path));
+    total += std::chrono::steady_clock::now() - start;
+
+    if (!mesh || mesh->SubMeshCount() == 0u)
+      return -1.0;
+  }
+
+  return std::chrono::duration<double, std::milli>(total).count() /
+      kLoadCount;
+}
+
+/////////////////////////////////////////////////
+TEST(ColladaLoaderPerformance, LoadTime)
+{
+  common::Console::SetVerbosity(4);
+
+  std::vector<std::string> corpus;
+
+  const std::string generated = common::joinPaths(PROJECT_BINARY_PATH,
+      "test", "collada_loader_performance.dae");
+  writeGridMesh(generated);
+  corpus.push_back(generated);
+
+  corpus.push_back(common::joinPaths(PROJECT_SOURCE_PATH, "test", "data",
+      "cordless_drill", "meshes", "cordless_drill.dae"));
+
+  // Extra meshes can be given as a colon separated list of paths
+  const char *extra = std::getenv("IGN_COLLADA_BENCHMARK_MESHES");
+  if (extra)
+  {
+    std::stringstream ss(extra);
+    std::string path;
+    while (std::getline(ss, path, ':'))
+    {
+      if (!path.empty())
+        corpus.push_back(path);
+    }
+  }
+
+  std::stringstream report;
+  double totalTime = 0.0;
+  for (const auto &path : corpus)
+  {
+    double loadTime = meanLoadTime(path);
+    EXPECT_GT(loadTime, 0.0) << path;
+    totalTime += loadTime;
+    report << "  " << common::basename(path) << ": " << loadTime << " ms\n";
+  }
+
+  igndbg << "\nCollada load time over " << kLoadCount << " loads:\n"
+         << report.str()
+         << "Total = " << totalTime << " ms\n";
+
+  common::removeFile(generated);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,238 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include "ignition/common/Console.hh"
+#include "ignition/common/WorkerPool.hh"
+
+using namespace ignition;
+
+/// \brief Number of pieces of work added in each measurement
+static const unsigned int kTaskCount = 100000;
+
+/////////////////////////////////////////////////
+/// \brief Pool sharing a single locked queue between its workers, the way
+/// WorkerPool used to work. Used as a baseline.
+class LockedQueuePool
+{
+  /// \brief Constructor
+  public: LockedQueuePool()
+  {
+    const unsigned int count =
+        std::max(std::thread::hardware_concurrency(), 1u);
+    for (unsigned int i = 0; i < count; ++i)
+      this->workers.emplace_back(&LockedQueuePool::Worker, this);
+  }
+
+  /// \brief Destructor
+  public: ~LockedQueuePool()
+  {
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      this->done = true;
+    }
+    this->signalNewWork.notify_all();
+    for (auto &worker : this->workers)
+      worker.join();
+  }
+
+  /// \brief Add a piece of work.
+  /// \param[in] _work The work.
+  public: void AddWork(std::function<void()> _work)
+  {
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      this->work.push(std::move(_work));
+    }
+    this->signalNewWork.notify_one();
+  }
+
+  /// \brief Wait for all the work to be done.
+  public: void WaitForResults()
+  {
+    std::unique_lock<std::mutex> lock(this->mutex);
+    this->signalWorkDone.wait(lock, [this]
+        {
+          return this->work.empty() && this->active == 0;
+        });
+  }
+
+  /// \brief Worker thread.
+  private: void Worker()
+  {
+    std::unique_lock<std::mutex> lock(this->mutex);
+    while (true)
+    {
+      this->signalNewWork.wait(lock, [this]
+          {
+            return this->done || !this->work.empty();
+          });
+      if (this->done)
+        return;
+
+      auto next = std::move(this->work.front());
+      this->work.pop();
+      ++this->active;
+      lock.unlock();
+      next();
+      lock.lock();
+      --this->active;
+      if (this->work.empty() && this->active == 0)
+        this->signalWorkDone.notify_all();
+    }
+  }
+
+  /// \brief Worker threads
+  private: std::vector<std::thread> workers;
+
+  /// \brief Work not started yet
+  private: std::queue<std::function<void()>> work;
+
+  /// \brief Number of pieces of work running
+  private: unsigned int active = 0;
+
+  /// \brief True when shutting down
+  private: bool done = false;
+
+  /// \brief Protects everything above
+  private: std::mutex mutex;
+
+  /// \brief Signaled when work is added
+  private: std::condition_variable signalNewWork;
+
+  /// \brief Signaled when all the work is done
+  private: std::condition_variable signalWorkDone;
+};
+
+/////////////////////////////////////////////////
+/// \brief Measure how long a function takes per piece of work.
+/// \param[in] _function Function doing kTaskCount pieces of work.
+/// \return Time per piece of work, in nanoseconds.
+double perTask(const std::function<void()> &_function)
+{
+  auto start = std::chrono::steady_clock::now();
+  _function();
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  return std::chrono::duration<double, std::nano>(elapsed).count() /
+      kTaskCount;
+}
+
+/////////////////////////////////////////////////
+TEST(WorkerPoolPerformance, TaskOverhead)
+{
+  common::Console::SetVerbosity(4);
+
+  std::atomic<unsigned int> counter(0);
+  auto work = [&counter]()
+    {
+      counter.fetch_add(1, std::memory_order_relaxed);
+    };
+
+  std::stringstream report;
+
+  {
+    LockedQueuePool pool;
+    report << "  Locked queue AddWork: " << perTask([&]()
+        {
+          for (unsigned int i = 0; i < kTaskCount; ++i)
+            pool.AddWork(work);
+          pool.WaitForResults();
+        }) << " ns\n";
+  }
+  EXPECT_EQ(kTaskCount, counter);
+
+  common::WorkerPool pool;
+  counter = 0;
+  report << "  AddWork: " << perTask([&]()
+      {
+        for (unsigned int i = 0; i < kTaskCount; ++i)
+          pool.AddWork(work);
+        EXPECT_TRUE(pool.WaitForResults());
+      }) << " ns\n";
+  EXPECT_EQ(kTaskCount, counter);
+
+  counter = 0;
+  report << "  AddWorkBatch: " << perTask([&]()
+      {
+        std::vector<std::function<void()>> batch(kTaskCount, work);
+        pool.AddWorkBatch(std::move(batch));
+        EXPECT_TRUE(pool.WaitForResults());
+      }) << " ns\n";
+  EXPECT_EQ(kTaskCount, counter);
+
+  counter = 0;
+  report << "  TaskGroup: " << perTask([&]()
+      {
+        common::TaskGroup group(pool);
+        for (unsigned int i = 0; i < kTaskCount; ++i)
+          group.Run(work);
+        group.Wait();
+      }) << " ns\n";
+  EXPECT_EQ(kTaskCount, counter);
+
+  // Work added from a worker goes to its own queue
+  counter = 0;
+  report << "  AddWork from a worker: " << perTask([&]()
+      {
+        pool.AddWork([&]()
+            {
+              for (unsigned int i = 0; i < kTaskCount - 1; ++i)
+                pool.AddWork(work);
+              work();
+            });
+        EXPECT_TRUE(pool.WaitForResults());
+      }) << " ns\n";
+  EXPECT_EQ(kTaskCount, counter);
+
+  std::vector<double> values(kTaskCount, 1.0);
+  report << "  Sequential loop: " << perTask([&]()
+      {
+        for (unsigned int i = 0; i < kTaskCount; ++i)
+          values[i] = values[i] * 1.5 + 0.5;
+      }) << " ns\n";
+  report << "  ParallelFor: " << perTask([&]()
+      {
+        pool.ParallelFor(0, kTaskCount, [&](const std::size_t _i)
+            {
+              values[_i] = values[_i] * 1.5 + 0.5;
+            });
+      }) << " ns\n";
+  EXPECT_DOUBLE_EQ(3.5, values.front());
+  EXPECT_DOUBLE_EQ(3.5, values.back());
+
+  igndbg << "\nWorker pool time per piece of work over " << kTaskCount
+         << " pieces with " << pool.ThreadCount() << " workers:\n"
+         << report.str();
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_GAZEBO_ACTORANIMATIONS_HH_
+#define IGNITION_GAZEBO_ACTORANIMATIONS_HH_
+
+#include <chrono>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include <sdf/Actor.hh>
+
+#include <ignition/common/Animation.hh>
+#include <ignition/common/Skeleton.hh>
+#include <ignition/common/SkeletonAnimationClip.hh>
+#include <ignition/common/graphics/Types.hh>
+
+#include "ignition/gazebo/config.hh"
+#include "ignition/gazebo/Export.hh"
+
+namespace ignition
+{
+  namespace gazebo
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
+    //
+    /// \brief Skeleton animations and trajectories of an actor, as loaded by
+    /// loadActorAnimations.
+    struct ActorAnimations
+    {
+      /// \brief Skeleton of the actor's skin. It's shared by the actors with
+      /// the same skin, and holds the animations of all of them.
+      common::SkeletonPtr skeleton;
+
+      /// \brief Animations played by the trajectories of the actor, compiled
+      /// for sampling and retargeted to the skin, by index in the skeleton.
+      /// The clips are shared by the actors with the same skin.
+      std::map<unsigned int,
+          std::shared_ptr<const common::SkeletonAnimationClip>> clips;
+
+      /// \brief Trajectories, laid end to end.
+      std::vector<common::TrajectoryInfo> trajectories;
+
+      /// \brief Time at which each trajectory ends, counted from the start
+      /// of the first one. It is sorted, so the active trajectory can be
+      /// found by binary search.
+      std::vector<std::chrono::steady_clock::duration> trajectoryEnds;
+    };
+
+    /// \brief Helper function to load the skin, animations and trajectories
+    /// of an actor. Animations are added to the skin's skeleton and compiled
+    /// the first time an actor with that skin uses them, and reused by the
+    /// following actors.
+    ///
+    /// The returned ActorAnimations own the skeleton and the clips. The
+    /// helper only keeps weak references to them, so a compiled clip is
+    /// released once every ActorAnimations using it is destroyed, and
+    /// compiled again if another actor plays it later. The animations added
+    /// to a skeleton stay in it for as long as the skeleton lives.
+    /// \param[in] _actor Actor description.
+    /// \param[out] _animations Animations of the actor.
+    /// \return True on success, false if the skin or its skeleton can't be
+    /// loaded, or if the actor has no animation.
+    bool IGNITION_GAZEBO_VISIBLE loadActorAnimations(const sdf::Actor &_actor,
+        ActorAnimations &_animations);
+    }
+  }
+}
+#endif
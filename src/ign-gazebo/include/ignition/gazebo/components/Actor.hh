@@ -18,9 +18,17 @@
 #define IGNITION_GAZEBO_COMPONENTS_ACTOR_HH_
 
 #include <ignition/msgs/actor.pb.h>
+#include <ignition/msgs/pose_v.pb.h>
+
+#include <map>
+#include <string>
 
 #include <sdf/Actor.hh>
 
+#include <ignition/math/Matrix4.hh>
+#include <ignition/math/Pose3.hh>
+#include <ignition/msgs/Utility.hh>
+
 #include <ignition/gazebo/components/Factory.hh>
 #include <ignition/gazebo/components/Component.hh>
 #include <ignition/gazebo/components/Serialization.hh>
@@ -37,6 +45,45 @@ namespace serializers
 {
   using ActorSerializer =
       serializers::ComponentToMsgSerializer<sdf::Actor, msgs::Actor>;
+
+  /// \brief Serializer for bone transforms, stored as a msgs::Pose_V where
+  /// each pose is named after its bone. Scale is not kept.
+  class ActorBoneTransformsSerializer
+  {
+    /// \brief Serialization
+    /// \param[in] _out Output stream.
+    /// \param[in] _bones Bone transforms to stream
+    /// \return The stream.
+    public: static std::ostream &Serialize(std::ostream &_out,
+                const std::map<std::string, math::Matrix4d> &_bones)
+    {
+      msgs::Pose_V msg;
+      for (const auto &bone : _bones)
+      {
+        auto poseMsg = msg.add_pose();
+        msgs::Set(poseMsg, bone.second.Pose());
+        poseMsg->set_name(bone.first);
+      }
+      msg.SerializeToOstream(&_out);
+      return _out;
+    }
+
+    /// \brief Deserialization
+    /// \param[in] _in Input stream.
+    /// \param[out] _bones Bone transforms to populate
+    /// \return The stream.
+    public: static std::istream &Deserialize(std::istream &_in,
+                std::map<std::string, math::Matrix4d> &_bones)
+    {
+      msgs::Pose_V msg;
+      msg.ParseFromIstream(&_in);
+
+      _bones.clear();
+      for (const auto &poseMsg : msg.pose())
+        _bones[poseMsg.name()] = math::Matrix4d(msgs::Convert(poseMsg));
+      return _in;
+    }
+  };
 }
 
 namespace components
@@ -47,6 +94,21 @@ namespace components
   using Actor =
       Component<sdf::Actor, class ActorTag, serializers::ActorSerializer>;
   IGN_GAZEBO_REGISTER_COMPONENT("ign_gazebo_components.Actor", Actor)
+
+  /// \brief Pose of an actor along its trajectory, relative to its parent.
+  /// When the actor doesn't follow a trajectory, this is the translation of
+  /// the root bone of its animation.
+  using ActorPose = Component<math::Pose3d, class ActorPoseTag>;
+  IGN_GAZEBO_REGISTER_COMPONENT("ign_gazebo_components.ActorPose", ActorPose)
+
+  /// \brief Local transforms of the bones of an actor's skin, keyed by bone
+  /// name, at the current simulation time.
+  using ActorBoneTransforms =
+      Component<std::map<std::string, math::Matrix4d>,
+                class ActorBoneTransformsTag,
+                serializers::ActorBoneTransformsSerializer>;
+  IGN_GAZEBO_REGISTER_COMPONENT("ign_gazebo_components.ActorBoneTransforms",
+      ActorBoneTransforms)
 }
 }
 }
@@ -142,6 +142,46 @@ inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
         Entity _id, std::chrono::steady_clock::duration _time,
         bool _loop) const;
 
+    /// \brief Get the pose of an actor along its trajectory, without
+    /// evaluating its skeleton animation.
+    /// \param[in] _id Actor entity's unique id
+    /// \param[in] _time Timepoint for the animation
+    /// \param[in] _loop True if getting animation in loop
+    /// \param[out] _pose Pose of the actor
+    /// \return False if the actor doesn't follow a trajectory, in which
+    /// case its pose is given by the root of its skeleton.
+    public: bool ActorTrajectoryPoseAt(Entity _id,
+        std::chrono::steady_clock::duration _time, bool _loop,
+        math::Matrix4d &_pose) const;
+
+    /// \brief Update the animation level of detail of all actors from their
+    /// distance to the closest camera in the scene that can see them. The
+    /// distances are configured in the actor's <plugin> element named
+    /// "ignition::gazebo", for example:
+    ///
+    ///   <plugin name="ignition::gazebo" filename="dummy">
+    ///     <animation_lod>
+    ///       <full_distance>30</full_distance>
+    ///       <reduced_distance>100</reduced_distance>
+    ///       <reduced_rate>10</reduced_rate>
+    ///     </animation_lod>
+    ///   </plugin>
+    ///
+    /// Should be called from the rendering thread.
+    public: void UpdateActorAnimationLods();
+
+    /// \brief Check whether the skeleton of an actor should be animated at
+    /// a given time, according to its animation level of detail. Actors
+    /// within the full distance of a camera are animated every time, actors
+    /// within the reduced distance at the reduced rate, and actors further
+    /// away or out of sight are only moved along their trajectories. A due
+    /// skeleton is considered animated at _time.
+    /// \param[in] _id Actor entity's unique id
+    /// \param[in] _time Timepoint for the animation
+    /// \return True if the skeleton should be animated.
+    public: bool ActorSkeletonUpdateDue(Entity _id,
+        std::chrono::steady_clock::duration _time);
+
     /// \brief Remove an entity by id
     /// \param[in] _id Entity's unique id
     public: void RemoveEntity(Entity _id);
@@ -0,0 +1,261 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <mutex>
+#include <string>
+#include <utility>
+
+#include <ignition/common/Console.hh>
+#include <ignition/common/KeyFrame.hh>
+#include <ignition/common/Mesh.hh>
+#include <ignition/common/MeshManager.hh>
+#include <ignition/common/SkeletonAnimation.hh>
+
+#include "ignition/gazebo/ActorAnimations.hh"
+
+using namespace ignition;
+using namespace gazebo;
+
+/// \brief Animations added to a skin's skeleton by the actors using it.
+/// Nothing here keeps the skeleton or the clips alive, the actors own them.
+struct SkinAnimations
+{
+  /// \brief The skeleton. Once it expires, its address may be reused and
+  /// the entry is removed.
+  std::weak_ptr<common::Skeleton> skeleton;
+
+  /// \brief Index in the skeleton of each animation file, by file name and
+  /// scale.
+  std::map<std::pair<std::string, double>, unsigned int> indices;
+
+  /// \brief Compiled animations, by index in the skeleton. A clip is
+  /// compiled again if every actor playing it was removed.
+  std::map<unsigned int,
+      std::weak_ptr<const common::SkeletonAnimationClip>> clips;
+};
+
+/// \brief Protects the skeletons, which are shared by the MeshManager with
+/// everyone loading the skin, and the skins.
+static std::mutex g_skinsMutex;
+
+/// \brief Animations of the skins whose skeleton is still alive, by
+/// skeleton.
+static std::map<const common::Skeleton *, SkinAnimations> g_skins;
+
+//////////////////////////////////////////////////
+/// \brief Add an animation file to a skeleton, unless it was already added.
+/// \param[in,out] _skin Skin to add the animation to.
+/// \param[in] _skeleton Skeleton of the skin.
+/// \param[in] _filename BVH or COLLADA animation file.
+/// \param[in] _scale Scale of a BVH animation.
+/// \param[out] _index Index of the animation in the skeleton.
+/// \return True if the animation was found or added.
+static bool addAnimation(SkinAnimations &_skin, common::Skeleton &_skeleton,
+    const std::string &_filename, const double _scale, unsigned int &_index)
+{
+  auto key = std::make_pair(_filename, _scale);
+  auto it = _skin.indices.find(key);
+  if (it != _skin.indices.end())
+  {
+    _index = it->second;
+    return true;
+  }
+
+  std::string extension = _filename.substr(_filename.rfind('.') + 1,
+                                _filename.size());
+  std::transform(extension.begin(), extension.end(),
+                  extension.begin(), ::tolower);
+
+  const unsigned int index = _skeleton.AnimationCount();
+  if (extension == "bvh")
+  {
+    if (!_skeleton.AddBvhAnimation(_filename, _scale))
+    {
+      ignerr << "Animation [" << _filename << "] doesn't match the skeleton "
+             << "of the actor's skin." << std::endl;
+      return false;
+    }
+  }
+  else if (extension == "dae")
+  {
+    common::MeshManager *meshManager = common::MeshManager::Instance();
+    meshManager->Load(_filename);
+    auto animMesh = meshManager->MeshByName(_filename);
+    if (nullptr == animMesh || nullptr == animMesh->MeshSkeleton() ||
+        animMesh->MeshSkeleton()->AnimationCount() == 0)
+    {
+      ignerr << "Animation [" << _filename << "] not found." << std::endl;
+      return false;
+    }
+
+    // add the first animation
+    _skeleton.AddAnimation(animMesh->MeshSkeleton()->Animation(0));
+  }
+  else
+  {
+    ignerr << "Unsupported animation file [" << _filename << "]."
+           << std::endl;
+    return false;
+  }
+
+  _skin.indices[key] = index;
+  _index = index;
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool ignition::gazebo::loadActorAnimations(const sdf::Actor &_actor,
+    ActorAnimations &_animations)
+{
+  common::MeshManager *meshManager = common::MeshManager::Instance();
+  const common::Mesh *mesh = meshManager->Load(_actor.SkinFilename());
+  if (nullptr == mesh)
+  {
+    ignerr << "Actor skin mesh [" << _actor.SkinFilename() << "] not found."
+           << std::endl;
+    return false;
+  }
+
+  common::SkeletonPtr skeleton = mesh->MeshSkeleton();
+  if (nullptr == skeleton)
+  {
+    ignerr << "Mesh skeleton in [" << _actor.SkinFilename() << "] not found."
+           << std::endl;
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock(g_skinsMutex);
+
+  // Forget the skins whose skeleton was released
+  for (auto it = g_skins.begin(); it != g_skins.end();)
+  {
+    if (it->second.skeleton.expired())
+      it = g_skins.erase(it);
+    else
+      ++it;
+  }
+
+  SkinAnimations &skin = g_skins[skeleton.get()];
+  skin.skeleton = skeleton;
+
+  // The skin's own animation, if any, comes first
+  std::map<std::string, unsigned int> mapAnimNameId;
+  mapAnimNameId[_actor.SkinFilename()] = 0;
+
+  // Load all animations
+  for (unsigned i = 0; i < _actor.AnimationCount(); ++i)
+  {
+    const sdf::Animation *anim = _actor.AnimationByIndex(i);
+    unsigned int index;
+    if (addAnimation(skin, *skeleton, anim->Filename(), anim->Scale(),
+        index))
+      mapAnimNameId[anim->Name()] = index;
+  }
+
+  if (skeleton->AnimationCount() == 0)
+  {
+    ignerr << "Actor [" << _actor.Name() << "] has no animation."
+           << std::endl;
+    return false;
+  }
+
+  _animations.skeleton = skeleton;
+
+  using TP = std::chrono::steady_clock::time_point;
+
+  auto &trajectories = _animations.trajectories;
+  trajectories.clear();
+  if (_actor.TrajectoryCount() != 0)
+  {
+    // Load all trajectories specified in sdf
+    for (unsigned i = 0; i < _actor.TrajectoryCount(); i++)
+    {
+      common::TrajectoryInfo trajInfo;
+      const sdf::Trajectory *trajSdf = _actor.TrajectoryByIndex(i);
+      trajInfo.SetId(trajSdf->Id());
+      trajInfo.SetAnimIndex(mapAnimNameId[trajSdf->Type()]);
+
+      if (trajSdf->WaypointCount() != 0)
+      {
+        std::map<TP, math::Pose3d> waypoints;
+        for (unsigned j = 0; j < trajSdf->WaypointCount(); j++)
+        {
+          auto point = trajSdf->WaypointByIndex(j);
+          TP point_tp(std::chrono::milliseconds(
+                    static_cast<int>(point->Time()*1000)));
+          waypoints[point_tp] = point->Pose();
+        }
+        trajInfo.SetWaypoints(waypoints);
+      }
+      else
+      {
+        trajInfo.SetTranslated(false);
+      }
+      trajectories.push_back(trajInfo);
+    }
+  }
+  // if there are no trajectories, but there are animations, add a trajectory
+  else
+  {
+    common::TrajectoryInfo trajInfo;
+    trajInfo.SetId(0);
+    trajInfo.SetAnimIndex(0);
+    std::chrono::milliseconds timepoint(0);
+    trajInfo.SetStartTime(TP(timepoint));
+    timepoint = std::chrono::milliseconds(
+                  static_cast<int>(skeleton->Animation(0)->Length() * 1000));
+    trajInfo.SetEndTime(TP(timepoint));
+    trajInfo.SetTranslated(false);
+    trajectories.push_back(trajInfo);
+  }
+
+  // sequencing all trajectories
+  TP time(std::chrono::milliseconds(0));
+  _animations.trajectoryEnds.clear();
+  for (auto &trajectory : trajectories)
+  {
+    auto dura = trajectory.Duration();
+    trajectory.SetStartTime(time);
+    time += dura;
+    trajectory.SetEndTime(time);
+    _animations.trajectoryEnds.push_back(
+        time - TP(std::chrono::milliseconds(0)));
+  }
+
+  // Only compile the animations that this actor plays, and share them with
+  // the other actors playing them
+  _animations.clips.clear();
+  for (const auto &trajectory : trajectories)
+  {
+    const unsigned int index = trajectory.AnimIndex();
+    if (_animations.clips.count(index) > 0)
+      continue;
+
+    auto clip = skin.clips[index].lock();
+    if (nullptr == clip)
+    {
+      // Clips are retargeted to the skin, so their nodes are the skin's bones
+      clip = std::make_shared<const common::SkeletonAnimationClip>(
+          *skeleton, index);
+      skin.clips[index] = clip;
+    }
+    _animations.clips[index] = clip;
+  }
+
+  return true;
+}
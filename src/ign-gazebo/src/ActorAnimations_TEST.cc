@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+
+#include <sdf/Actor.hh>
+
+#include "ignition/gazebo/ActorAnimations.hh"
+#include "ignition/gazebo/test_config.hh"
+
+using namespace ignition;
+using namespace gazebo;
+
+/////////////////////////////////////////////////
+/// \brief Get an actor animated in place by its skin's animation, plus the
+/// same animation loaded from a file.
+/// \return The actor.
+sdf::Actor skinnedActor()
+{
+  const std::string skin = std::string(PROJECT_SOURCE_PATH) +
+      "/test/media/box_with_animation.dae";
+
+  sdf::Actor actor;
+  actor.SetName("actor");
+  actor.SetSkinFilename(skin);
+
+  sdf::Animation animation;
+  animation.SetName("extra");
+  animation.SetFilename(skin);
+  actor.AddAnimation(animation);
+  return actor;
+}
+
+/////////////////////////////////////////////////
+TEST(ActorAnimationsTest, MissingSkin)
+{
+  sdf::Actor actor;
+  actor.SetName("actor");
+  actor.SetSkinFilename("no_such_skin.dae");
+
+  ActorAnimations animations;
+  EXPECT_FALSE(loadActorAnimations(actor, animations));
+}
+
+/////////////////////////////////////////////////
+TEST(ActorAnimationsTest, SharedBySkin)
+{
+  const sdf::Actor actor = skinnedActor();
+
+  auto first = std::make_unique<ActorAnimations>();
+  ASSERT_TRUE(loadActorAnimations(actor, *first));
+  ASSERT_NE(nullptr, first->skeleton);
+  const unsigned int animationCount = first->skeleton->AnimationCount();
+  EXPECT_EQ(2u, animationCount);
+
+  // Without trajectories, the skin's animation is played in place
+  ASSERT_EQ(1u, first->trajectories.size());
+  EXPECT_EQ(0u, first->trajectories[0].AnimIndex());
+  ASSERT_EQ(1u, first->trajectoryEnds.size());
+  EXPECT_GT(first->trajectoryEnds[0].count(), 0);
+
+  // Only the played animation is compiled
+  ASSERT_EQ(1u, first->clips.size());
+  ASSERT_NE(first->clips.end(), first->clips.find(0u));
+
+  // Another actor with the same skin doesn't add the animations again, and
+  // shares the clip
+  auto second = std::make_unique<ActorAnimations>();
+  ASSERT_TRUE(loadActorAnimations(actor, *second));
+  EXPECT_EQ(first->skeleton, second->skeleton);
+  EXPECT_EQ(animationCount, second->skeleton->AnimationCount());
+  ASSERT_EQ(1u, second->clips.size());
+  EXPECT_EQ(first->clips.at(0u), second->clips.at(0u));
+
+  // The clip is released with the last actor playing it
+  std::weak_ptr<const common::SkeletonAnimationClip> clip =
+      first->clips.at(0u);
+  first.reset();
+  EXPECT_FALSE(clip.expired());
+  second.reset();
+  EXPECT_TRUE(clip.expired());
+
+  // And compiled again for the next one
+  ActorAnimations third;
+  ASSERT_TRUE(loadActorAnimations(actor, third));
+  EXPECT_EQ(animationCount, third.skeleton->AnimationCount());
+  ASSERT_EQ(1u, third.clips.size());
+  EXPECT_NE(nullptr, third.clips.at(0u));
+}
@@ -45,6 +45,7 @@
 #include "ignition/gazebo/components/Wind.hh"
 #include "ignition/gazebo/components/World.hh"
 
+#include "Constants.hh"
 #include "LevelManager.hh"
 #include "SimulationRunner.hh"
 
@@ -113,10 +114,6 @@ void LevelManager::ReadLevelPerformerInfo()
         components::Scene(*this->runner->sdfWorld->Scene()));
   }
 
-  // TODO(anyone) This should probably go somewhere else as it is a global
-  // constant.
-  const std::string kPluginName{"ignition::gazebo"};
-
   sdf::ElementPtr pluginElem;
   // Get the ignition::gazebo plugin element
   for (auto plugin = worldElem->GetElement("plugin"); plugin;
@@ -382,10 +382,12 @@ void SimulationRunner::UpdateSystems()
 {
   IGN_PROFILE("SimulationRunner::UpdateSystems");
   // \todo(nkoenig)  Systems used to be updated in parallel using
-  // an ignition::common::WorkerPool. There is overhead associated with
-  // this, most notably the creation and destruction of WorkOrders (see
-  // WorkerPool.cc). We could turn on parallel updates in the future, and/or
-  // turn it on if there are sufficient systems. More testing is required.
+  // an ignition::common::WorkerPool. There was overhead associated with
+  // this, most notably the creation and destruction of WorkOrders. The pool
+  // no longer locks to add work and TaskGroup can wait for a subset of it
+  // (see WorkerPool.hh), so we could turn on parallel updates in the future,
+  // and/or turn it on if there are sufficient systems. More testing is
+  // required.
 
   {
     IGN_PROFILE("PreUpdate");
@@ -63,6 +63,10 @@ extern "C" IGNITION_GAZEBO_VISIBLE int runServer(const char *_sdfString,
   ignmsg << "Ignition Gazebo Server v" << IGNITION_GAZEBO_VERSION_FULL
          << std::endl;
 
+  // Write the console output on a separate thread, so that messages logged
+  // while simulating don't hold up the simulation
+  ignition::common::Console::SetAsync(true);
+
   ignition::gazebo::ServerConfig serverConfig;
 
   // Set the SDF string to user
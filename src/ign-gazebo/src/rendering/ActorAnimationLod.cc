@@ -0,0 +1,175 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <cmath>
+#include <limits>
+#include <string>
+
+#include <ignition/common/Console.hh>
+#include <ignition/math/Helpers.hh>
+
+#include "ActorAnimationLod.hh"
+#include "Constants.hh"
+
+using namespace ignition;
+using namespace gazebo;
+
+/// \brief Radius of the sphere bounding an actor, used to check whether
+/// it is in sight of a camera.
+static const double kActorRadius = 1.0;
+
+//////////////////////////////////////////////////
+double ignition::gazebo::actorCameraHalfAngle(double _hfov,
+    double _aspectRatio)
+{
+  if (_hfov >= IGN_PI)
+    return IGN_PI;
+
+  // Half angle of the diagonal of the view frustum
+  double tanH = std::tan(_hfov * 0.5);
+  double tanV = _aspectRatio > 0.0 ? tanH / _aspectRatio : tanH;
+  return std::atan(std::sqrt(tanH * tanH + tanV * tanV));
+}
+
+//////////////////////////////////////////////////
+ActorAnimationLevel ignition::gazebo::actorAnimationLevel(
+    const ActorAnimationLod &_lod, const math::Vector3d &_position,
+    const std::vector<ActorCameraView> &_views)
+{
+  // Without cameras, there is nothing to base the level of detail on
+  if (_views.empty())
+    return ActorAnimationLevel::FULL;
+
+  // Distance to the closest camera which can see the actor
+  double distance = std::numeric_limits<double>::infinity();
+  for (const auto &view : _views)
+  {
+    math::Vector3d dir = _position - view.position;
+    double length = dir.Length();
+    if (length >= distance)
+      continue;
+
+    if (length > kActorRadius)
+    {
+      double angle = std::acos(math::clamp(
+            dir.Dot(view.axis) / length, -1.0, 1.0));
+      if (angle > view.halfAngle + std::asin(kActorRadius / length))
+        continue;
+    }
+    distance = length;
+  }
+
+  if (distance <= _lod.fullDistance)
+    return ActorAnimationLevel::FULL;
+  if (distance <= _lod.reducedDistance)
+    return ActorAnimationLevel::REDUCED;
+  return ActorAnimationLevel::ROOT_ONLY;
+}
+
+//////////////////////////////////////////////////
+bool ignition::gazebo::actorSkeletonUpdateDue(ActorAnimationLod &_lod,
+    std::chrono::steady_clock::duration _time)
+{
+  // Always animate the skeleton once so the actor isn't left in its bind
+  // pose, and again whenever time goes backwards
+  bool due = !_lod.animated || _time < _lod.lastUpdate;
+  if (!due)
+  {
+    switch (_lod.level)
+    {
+      case ActorAnimationLevel::FULL:
+        due = true;
+        break;
+      case ActorAnimationLevel::REDUCED:
+        due = _time - _lod.lastUpdate >= _lod.reducedPeriod;
+        break;
+      case ActorAnimationLevel::ROOT_ONLY:
+      default:
+        break;
+    }
+  }
+
+  if (due)
+  {
+    _lod.lastUpdate = _time;
+    _lod.animated = true;
+  }
+  return due;
+}
+
+//////////////////////////////////////////////////
+ActorAnimationLod ignition::gazebo::loadActorAnimationLod(
+    const sdf::ElementPtr &_sdf)
+{
+  ActorAnimationLod lod;
+
+  sdf::ElementPtr lodElem;
+  if (_sdf && _sdf->HasElement("plugin"))
+  {
+    for (auto plugin = _sdf->GetElement("plugin"); plugin;
+         plugin = plugin->GetNextElement("plugin"))
+    {
+      if (plugin->Get<std::string>("name") == kPluginName &&
+          plugin->HasElement("animation_lod"))
+      {
+        lodElem = plugin->GetElement("animation_lod");
+        break;
+      }
+    }
+  }
+
+  if (!lodElem)
+    return lod;
+
+  double fullDistance = lodElem->Get<double>("full_distance",
+      lod.fullDistance).first;
+  if (fullDistance >= 0.0)
+  {
+    lod.fullDistance = fullDistance;
+  }
+  else
+  {
+    ignwarn << "Actor animation <full_distance> must not be negative, got ["
+            << fullDistance << "]. Using the default." << std::endl;
+  }
+
+  lod.reducedDistance = lodElem->Get<double>("reduced_distance",
+      lod.reducedDistance).first;
+  if (!(lod.reducedDistance >= lod.fullDistance))
+  {
+    ignwarn << "Actor animation <reduced_distance> ["
+            << lod.reducedDistance << "] is smaller than <full_distance> ["
+            << lod.fullDistance << "], skipping the reduced rate."
+            << std::endl;
+    lod.reducedDistance = lod.fullDistance;
+  }
+
+  double rate = lodElem->Get<double>("reduced_rate", 10.0).first;
+  if (rate > 0.0)
+  {
+    lod.reducedPeriod =
+        std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(1.0 / rate));
+  }
+  else
+  {
+    ignwarn << "Actor animation <reduced_rate> must be positive, got ["
+            << rate << "]. Using the default." << std::endl;
+  }
+
+  return lod;
+}
@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_GAZEBO_RENDERING_ACTORANIMATIONLOD_HH_
+#define IGNITION_GAZEBO_RENDERING_ACTORANIMATIONLOD_HH_
+
+#include <chrono>
+#include <vector>
+
+#include <sdf/Element.hh>
+
+#include <ignition/math/Vector3.hh>
+
+#include "ignition/gazebo/config.hh"
+#include "ignition/gazebo/Export.hh"
+
+namespace ignition
+{
+  namespace gazebo
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
+    //
+    /// \brief Level of detail of an actor's animation.
+    enum class ActorAnimationLevel
+    {
+      /// \brief The skeleton is animated at every update.
+      FULL,
+
+      /// \brief The skeleton is animated at a reduced rate.
+      REDUCED,
+
+      /// \brief Only the pose of the actor is updated.
+      ROOT_ONLY
+    };
+
+    /// \brief Animation level of detail settings and state of an actor.
+    class ActorAnimationLod
+    {
+      /// \brief Up to this distance from a camera, the skeleton is animated
+      /// at every update.
+      public: double fullDistance = 30.0;
+
+      /// \brief Up to this distance from a camera, the skeleton is animated
+      /// at the reduced rate.
+      public: double reducedDistance = 100.0;
+
+      /// \brief Time between skeleton animations at the reduced rate.
+      public: std::chrono::steady_clock::duration reducedPeriod =
+          std::chrono::milliseconds(100);
+
+      /// \brief Current level of detail.
+      public: ActorAnimationLevel level = ActorAnimationLevel::FULL;
+
+      /// \brief Time at which the skeleton was last animated.
+      public: std::chrono::steady_clock::duration lastUpdate{0};
+
+      /// \brief Whether the skeleton has been animated at all.
+      public: bool animated = false;
+    };
+
+    /// \brief Part of the world a camera can see, as a cone around its
+    /// optical axis.
+    struct ActorCameraView
+    {
+      /// \brief Position of the camera in the world.
+      math::Vector3d position;
+
+      /// \brief Unit vector along the optical axis, in the world.
+      math::Vector3d axis;
+
+      /// \brief Angle between the optical axis and the edges of the cone.
+      double halfAngle;
+    };
+
+    /// \brief Get the angle between the optical axis of a camera and the
+    /// corners of its view frustum.
+    /// \param[in] _hfov Horizontal field of view, in radians.
+    /// \param[in] _aspectRatio Width over height of the image.
+    /// \return The half angle, in radians. It's pi for fields of view of pi
+    /// or more.
+    double IGNITION_GAZEBO_VISIBLE actorCameraHalfAngle(double _hfov,
+        double _aspectRatio);
+
+    /// \brief Get the animation level of detail of an actor, from its
+    /// distance to the closest camera which can see it. Actors within the
+    /// full distance are at the full level, actors within the reduced
+    /// distance at the reduced level, and actors further away or out of
+    /// sight only move along their trajectories. The distances are
+    /// inclusive.
+    /// \param[in] _lod Settings of the actor.
+    /// \param[in] _position Position of the actor in the world.
+    /// \param[in] _views Cameras of the scene.
+    /// \return The level of detail, full if there are no cameras.
+    ActorAnimationLevel IGNITION_GAZEBO_VISIBLE actorAnimationLevel(
+        const ActorAnimationLod &_lod, const math::Vector3d &_position,
+        const std::vector<ActorCameraView> &_views);
+
+    /// \brief Check whether the skeleton of an actor should be animated at
+    /// a given time, according to its level of detail. A due skeleton is
+    /// considered animated at _time.
+    /// \param[in,out] _lod Level of detail of the actor.
+    /// \param[in] _time Timepoint for the animation.
+    /// \return True if the skeleton should be animated.
+    bool IGNITION_GAZEBO_VISIBLE actorSkeletonUpdateDue(
+        ActorAnimationLod &_lod, std::chrono::steady_clock::duration _time);
+
+    /// \brief Load the animation level of detail settings of an actor from
+    /// the <animation_lod> element of its <plugin> named
+    /// "ignition::gazebo". Invalid values are replaced by the defaults, with
+    /// a warning.
+    /// \param[in] _sdf Actor's SDF element, may be null.
+    /// \return The settings.
+    ActorAnimationLod IGNITION_GAZEBO_VISIBLE loadActorAnimationLod(
+        const sdf::ElementPtr &_sdf);
+    }
+  }
+}
+#endif
@@ -0,0 +1,268 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include <sdf/Actor.hh>
+#include <sdf/Root.hh>
+#include <sdf/World.hh>
+
+#include <ignition/math/Helpers.hh>
+
+#include "ActorAnimationLod.hh"
+
+using namespace ignition;
+using namespace gazebo;
+using namespace std::chrono_literals;
+
+/////////////////////////////////////////////////
+/// \brief Get the SDF element of an actor.
+/// \param[in] _plugins <plugin> elements of the actor.
+/// \return The actor's element.
+sdf::ElementPtr actorElement(const std::string &_plugins)
+{
+  const std::string sdfString = R"(
+<?xml version="1.0" ?>
+<sdf version="1.6">
+  <world name="default">
+    <actor name="actor">
+      <skin>
+        <filename>skin.dae</filename>
+      </skin>)" + _plugins + R"(
+    </actor>
+  </world>
+</sdf>)";
+
+  sdf::Root root;
+  root.LoadSdfString(sdfString);
+  EXPECT_EQ(1u, root.WorldCount());
+  if (root.WorldCount() == 0u || root.WorldByIndex(0)->ActorCount() == 0u)
+    return nullptr;
+  return root.WorldByIndex(0)->ActorByIndex(0)->Element();
+}
+
+/////////////////////////////////////////////////
+/// \brief Get an <animation_lod> plugin element.
+/// \param[in] _lod Content of the <animation_lod> element.
+/// \return The plugin element.
+std::string lodPlugin(const std::string &_lod)
+{
+  return R"(
+      <plugin name="ignition::gazebo" filename="dummy">
+        <animation_lod>)" + _lod + R"(</animation_lod>
+      </plugin>)";
+}
+
+/////////////////////////////////////////////////
+TEST(ActorAnimationLodTest, CameraHalfAngle)
+{
+  // Square image: the corners are further from the axis than the sides
+  EXPECT_NEAR(std::atan(std::sqrt(2.0)),
+      actorCameraHalfAngle(IGN_PI * 0.5, 1.0), 1e-9);
+
+  // Wide image
+  EXPECT_NEAR(std::atan(std::sqrt(1.25)),
+      actorCameraHalfAngle(IGN_PI * 0.5, 2.0), 1e-9);
+
+  // Invalid aspect ratios are treated as square
+  EXPECT_NEAR(std::atan(std::sqrt(2.0)),
+      actorCameraHalfAngle(IGN_PI * 0.5, 0.0), 1e-9);
+
+  // Panoramic cameras see all around
+  EXPECT_DOUBLE_EQ(IGN_PI, actorCameraHalfAngle(IGN_PI, 1.0));
+  EXPECT_DOUBLE_EQ(IGN_PI, actorCameraHalfAngle(2.0 * IGN_PI, 1.0));
+}
+
+/////////////////////////////////////////////////
+TEST(ActorAnimationLodTest, Level)
+{
+  ActorAnimationLod lod;
+  ASSERT_DOUBLE_EQ(30.0, lod.fullDistance);
+  ASSERT_DOUBLE_EQ(100.0, lod.reducedDistance);
+
+  // Without cameras, actors are fully animated
+  EXPECT_EQ(ActorAnimationLevel::FULL,
+      actorAnimationLevel(lod, {1000, 0, 0}, {}));
+
+  // Camera at the origin looking along X
+  const double halfAngle = actorCameraHalfAngle(IGN_PI * 0.5, 1.0);
+  std::vector<ActorCameraView> views{
+      {math::Vector3d::Zero, math::Vector3d::UnitX, halfAngle}};
+
+  EXPECT_EQ(ActorAnimationLevel::FULL,
+      actorAnimationLevel(lod, {10, 0, 0}, views));
+  EXPECT_EQ(ActorAnimationLevel::REDUCED,
+      actorAnimationLevel(lod, {50, 0, 0}, views));
+  EXPECT_EQ(ActorAnimationLevel::ROOT_ONLY,
+      actorAnimationLevel(lod, {150, 0, 0}, views));
+
+  // The distances are inclusive
+  EXPECT_EQ(ActorAnimationLevel::FULL,
+      actorAnimationLevel(lod, {30, 0, 0}, views));
+  EXPECT_EQ(ActorAnimationLevel::REDUCED,
+      actorAnimationLevel(lod, {100, 0, 0}, views));
+
+  // Out of sight, behind or to the side of the camera
+  EXPECT_EQ(ActorAnimationLevel::ROOT_ONLY,
+      actorAnimationLevel(lod, {-10, 0, 0}, views));
+  EXPECT_EQ(ActorAnimationLevel::ROOT_ONLY,
+      actorAnimationLevel(lod, {0, 10, 0}, views));
+
+  // Partly in sight: the center is out of the frustum, but not the whole
+  // actor
+  EXPECT_EQ(ActorAnimationLevel::FULL,
+      actorAnimationLevel(lod, {10, 10.5, 0}, views));
+
+  // Around the camera, actors may be seen whatever their direction
+  EXPECT_EQ(ActorAnimationLevel::FULL,
+      actorAnimationLevel(lod, {-0.5, 0, 0}, views));
+
+  // The closest camera which can see the actor counts: the camera at the
+  // origin doesn't see the actor, the second camera looks at it from 50 m
+  views.push_back({{200, 0, 0}, -math::Vector3d::UnitX, halfAngle});
+  EXPECT_EQ(ActorAnimationLevel::REDUCED,
+      actorAnimationLevel(lod, {150, 0, 0}, views));
+  EXPECT_EQ(ActorAnimationLevel::FULL,
+      actorAnimationLevel(lod, {180, 0, 0}, views));
+}
+
+/////////////////////////////////////////////////
+TEST(ActorAnimationLodTest, UpdateDue)
+{
+  ActorAnimationLod lod;
+  lod.reducedPeriod = 100ms;
+
+  // Full: animated at every update
+  EXPECT_TRUE(actorSkeletonUpdateDue(lod, 0ms));
+  EXPECT_TRUE(actorSkeletonUpdateDue(lod, 10ms));
+  EXPECT_TRUE(actorSkeletonUpdateDue(lod, 10ms));
+  EXPECT_TRUE(actorSkeletonUpdateDue(lod, 20ms));
+
+  // Reduced: animated once per period
+  lod.level = ActorAnimationLevel::REDUCED;
+  EXPECT_FALSE(actorSkeletonUpdateDue(lod, 30ms));
+  EXPECT_FALSE(actorSkeletonUpdateDue(lod, 119ms));
+  EXPECT_TRUE(actorSkeletonUpdateDue(lod, 120ms));
+  EXPECT_EQ(120ms, lod.lastUpdate);
+  EXPECT_FALSE(actorSkeletonUpdateDue(lod, 170ms));
+  EXPECT_TRUE(actorSkeletonUpdateDue(lod, 350ms));
+
+  // Going back in time animates again
+  EXPECT_TRUE(actorSkeletonUpdateDue(lod, 200ms));
+  EXPECT_FALSE(actorSkeletonUpdateDue(lod, 250ms));
+
+  // Root only: never animated, unless going back in time
+  lod.level = ActorAnimationLevel::ROOT_ONLY;
+  EXPECT_FALSE(actorSkeletonUpdateDue(lod, 300ms));
+  EXPECT_FALSE(actorSkeletonUpdateDue(lod, 10s));
+  EXPECT_TRUE(actorSkeletonUpdateDue(lod, 100ms));
+  EXPECT_FALSE(actorSkeletonUpdateDue(lod, 10s));
+
+  // Root only actors are still animated once, so they aren't left in their
+  // bind pose
+  ActorAnimationLod farLod;
+  farLod.level = ActorAnimationLevel::ROOT_ONLY;
+  EXPECT_TRUE(actorSkeletonUpdateDue(farLod, 5s));
+  EXPECT_FALSE(actorSkeletonUpdateDue(farLod, 6s));
+}
+
+/////////////////////////////////////////////////
+TEST(ActorAnimationLodTest, Load)
+{
+  // Defaults
+  ActorAnimationLod defaults;
+  EXPECT_DOUBLE_EQ(30.0, defaults.fullDistance);
+  EXPECT_DOUBLE_EQ(100.0, defaults.reducedDistance);
+  EXPECT_EQ(std::chrono::steady_clock::duration(100ms),
+      defaults.reducedPeriod);
+
+  auto expectDefaults = [&](const ActorAnimationLod &_lod)
+  {
+    EXPECT_DOUBLE_EQ(defaults.fullDistance, _lod.fullDistance);
+    EXPECT_DOUBLE_EQ(defaults.reducedDistance, _lod.reducedDistance);
+    EXPECT_EQ(defaults.reducedPeriod, _lod.reducedPeriod);
+    EXPECT_EQ(ActorAnimationLevel::FULL, _lod.level);
+    EXPECT_FALSE(_lod.animated);
+  };
+
+  expectDefaults(loadActorAnimationLod(nullptr));
+  expectDefaults(loadActorAnimationLod(actorElement("")));
+
+  // Other plugins are ignored
+  expectDefaults(loadActorAnimationLod(actorElement(R"(
+      <plugin name="other" filename="other">
+        <animation_lod>
+          <full_distance>1</full_distance>
+        </animation_lod>
+      </plugin>)")));
+
+  // All values set
+  {
+    auto lod = loadActorAnimationLod(actorElement(lodPlugin(R"(
+          <full_distance>5</full_distance>
+          <reduced_distance>20</reduced_distance>
+          <reduced_rate>4</reduced_rate>)")));
+    EXPECT_DOUBLE_EQ(5.0, lod.fullDistance);
+    EXPECT_DOUBLE_EQ(20.0, lod.reducedDistance);
+    EXPECT_EQ(std::chrono::steady_clock::duration(250ms), lod.reducedPeriod);
+  }
+
+  // Missing values keep their defaults
+  {
+    auto lod = loadActorAnimationLod(actorElement(lodPlugin(R"(
+          <reduced_distance>60</reduced_distance>)")));
+    EXPECT_DOUBLE_EQ(defaults.fullDistance, lod.fullDistance);
+    EXPECT_DOUBLE_EQ(60.0, lod.reducedDistance);
+    EXPECT_EQ(defaults.reducedPeriod, lod.reducedPeriod);
+  }
+
+  // Reduced distance within the full distance: no reduced level
+  {
+    auto lod = loadActorAnimationLod(actorElement(lodPlugin(R"(
+          <full_distance>50</full_distance>
+          <reduced_distance>20</reduced_distance>)")));
+    EXPECT_DOUBLE_EQ(50.0, lod.fullDistance);
+    EXPECT_DOUBLE_EQ(50.0, lod.reducedDistance);
+    std::vector<ActorCameraView> views{{math::Vector3d::Zero,
+        math::Vector3d::UnitX, actorCameraHalfAngle(IGN_PI * 0.5, 1.0)}};
+    EXPECT_EQ(ActorAnimationLevel::FULL,
+        actorAnimationLevel(lod, {50, 0, 0}, views));
+    EXPECT_EQ(ActorAnimationLevel::ROOT_ONLY,
+        actorAnimationLevel(lod, {51, 0, 0}, views));
+  }
+
+  // Negative full distance
+  {
+    auto lod = loadActorAnimationLod(actorElement(lodPlugin(R"(
+          <full_distance>-1</full_distance>)")));
+    EXPECT_DOUBLE_EQ(defaults.fullDistance, lod.fullDistance);
+    EXPECT_DOUBLE_EQ(defaults.reducedDistance, lod.reducedDistance);
+  }
+
+  // Rates which aren't positive
+  for (const std::string rate : {"0", "-3"})
+  {
+    auto lod = loadActorAnimationLod(actorElement(lodPlugin(
+          "<reduced_rate>" + rate + "</reduced_rate>")));
+    EXPECT_EQ(defaults.reducedPeriod, lod.reducedPeriod) << rate;
+  }
+}
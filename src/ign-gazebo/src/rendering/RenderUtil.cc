@@ -16,9 +16,12 @@
  */
 
 #include <map>
+#include <string>
 #include <vector>
 
 #include <sdf/Element.hh>
+#include <sdf/Geometry.hh>
+#include <sdf/Mesh.hh>
 #include <sdf/Actor.hh>
 #include <sdf/Light.hh>
 #include <sdf/Link.hh>
@@ -28,6 +31,7 @@
 #include <sdf/SDFImpl.hh>
 #include <sdf/Visual.hh>
 
+#include <ignition/common/MeshManager.hh>
 #include <ignition/common/Profiler.hh>
 
 #include <ignition/math/Color.hh>
@@ -75,6 +79,16 @@ class ignition::gazebo::RenderUtilPrivate
   /// \param[in] _ecm The entity-component manager
   public: void CreateRenderingEntities(const EntityComponentManager &_ecm);
 
+  /// \brief Start loading the meshes of new visuals and actors on
+  /// background threads, so that they're loaded, or at least being loaded,
+  /// by the time the rendering thread creates them.
+  /// \param[in] _firstVisual Index of the first visual to prefetch in
+  /// newVisuals
+  /// \param[in] _firstActor Index of the first actor to prefetch in
+  /// newActors
+  public: void PrefetchMeshes(std::size_t _firstVisual,
+      std::size_t _firstActor) const;
+
   /// \brief Remove rendering entities
   /// \param[in] _ecm The entity-component manager
   public: void RemoveRenderingEntities(const EntityComponentManager &_ecm);
@@ -195,7 +209,10 @@ void RenderUtil::UpdateFromECM(const UpdateInfo &_info,
   std::lock_guard<std::mutex> lock(this->dataPtr->updateMutex);
   this->dataPtr->simTime = _info.simTime;
 
+  const std::size_t firstVisual = this->dataPtr->newVisuals.size();
+  const std::size_t firstActor = this->dataPtr->newActors.size();
   this->dataPtr->CreateRenderingEntities(_ecm);
+  this->dataPtr->PrefetchMeshes(firstVisual, firstActor);
   if (!_info.paused)
     this->dataPtr->UpdateRenderingEntities(_ecm);
   this->dataPtr->RemoveRenderingEntities(_ecm);
@@ -227,6 +244,10 @@ void RenderUtil::Update()
     return;
 
   this->dataPtr->updateMutex.lock();
+  // Decide how much actors are animated from where the cameras were in the
+  // last frame
+  this->dataPtr->sceneManager.UpdateActorAnimationLods();
+
   auto newScenes = std::move(this->dataPtr->newScenes);
   auto newModels = std::move(this->dataPtr->newModels);
   auto newLinks = std::move(this->dataPtr->newLinks);
@@ -377,17 +398,52 @@ void RenderUtil::Update()
       if (!actorMesh || !actorVisual)
         continue;
 
-      math::Pose3d actorPose;
-      actorPose.Pos() = tf.second["actorPose"].Translation();
-      actorPose.Rot() = tf.second["actorPose"].Rotation();
-      actorVisual->SetLocalPose(actorPose);
+      auto poseIt = tf.second.find("actorPose");
+      if (poseIt != tf.second.end())
+      {
+        math::Pose3d actorPose;
+        actorPose.Pos() = poseIt->second.Translation();
+        actorPose.Rot() = poseIt->second.Rotation();
+        actorVisual->SetLocalPose(actorPose);
+        tf.second.erase(poseIt);
+      }
 
-      tf.second.erase("actorPose");
-      actorMesh->SetSkeletonLocalTransforms(tf.second);
+      // Skeletons which aren't due at their level of detail are left as is
+      if (!tf.second.empty())
+        actorMesh->SetSkeletonLocalTransforms(tf.second);
     }
   }
 }
 
+//////////////////////////////////////////////////
+void RenderUtilPrivate::PrefetchMeshes(std::size_t _firstVisual,
+    std::size_t _firstActor) const
+{
+  IGN_PROFILE("RenderUtilPrivate::PrefetchMeshes");
+  auto meshManager = common::MeshManager::Instance();
+  auto prefetch = [&meshManager](const std::string &_filename)
+  {
+    if (!_filename.empty() && meshManager->IsValidFilename(_filename))
+      meshManager->LoadAsync(_filename);
+  };
+
+  for (auto i = _firstVisual; i < this->newVisuals.size(); ++i)
+  {
+    const sdf::Geometry *geom = std::get<1>(this->newVisuals[i]).Geom();
+    if (geom && geom->Type() == sdf::GeometryType::MESH && geom->MeshShape())
+      prefetch(geom->MeshShape()->Uri());
+  }
+
+  // BVH animations aren't meshes, and are filtered out by their extension
+  for (auto i = _firstActor; i < this->newActors.size(); ++i)
+  {
+    const sdf::Actor &actor = std::get<1>(this->newActors[i]);
+    prefetch(actor.SkinFilename());
+    for (uint64_t a = 0; a < actor.AnimationCount(); ++a)
+      prefetch(actor.AnimationByIndex(a)->Filename());
+  }
+}
+
 //////////////////////////////////////////////////
 void RenderUtilPrivate::CreateRenderingEntities(
     const EntityComponentManager &_ecm)
@@ -748,10 +804,38 @@ void RenderUtilPrivate::UpdateRenderingEntities(
         const components::Actor *,
         const components::Pose *)->bool
       {
-        // this->entityPoses[_entity] = _pose->Data();
-        this->actorTransforms[_entity] =
-              this->sceneManager.ActorMeshAnimationAt(_entity,
-                                    this->simTime, true);
+        // Use the animation evaluated by the ActorAnimation system if there
+        // is one, otherwise evaluate it locally
+        auto actorPose = _ecm.Component<components::ActorPose>(_entity);
+        auto actorBones =
+            _ecm.Component<components::ActorBoneTransforms>(_entity);
+        bool animate = this->sceneManager.ActorSkeletonUpdateDue(_entity,
+            this->simTime);
+        if (actorPose && actorBones)
+        {
+          auto &transforms = this->actorTransforms[_entity];
+          if (animate)
+            transforms = actorBones->Data();
+          transforms["actorPose"] = math::Matrix4d(actorPose->Data());
+          return true;
+        }
+
+        if (animate)
+        {
+          this->actorTransforms[_entity] =
+                this->sceneManager.ActorMeshAnimationAt(_entity,
+                                      this->simTime, true);
+          return true;
+        }
+
+        // Only move actors along their trajectories when their skeletons
+        // aren't due
+        math::Matrix4d trajPose;
+        if (this->sceneManager.ActorTrajectoryPoseAt(_entity, this->simTime,
+              true, trajPose))
+        {
+          this->actorTransforms[_entity]["actorPose"] = trajPose;
+        }
         return true;
       });
 
@@ -16,7 +16,13 @@
  */
 
 
+#include <algorithm>
+#include <chrono>
 #include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include <sdf/Box.hh>
 #include <sdf/Cylinder.hh>
@@ -30,22 +36,41 @@
 #include <ignition/common/KeyFrame.hh>
 #include <ignition/common/Skeleton.hh>
 #include <ignition/common/SkeletonAnimation.hh>
+#include <ignition/common/SkeletonAnimationClip.hh>
 #include <ignition/common/MeshManager.hh>
 
+#include <ignition/rendering/Camera.hh>
 #include <ignition/rendering/Geometry.hh>
 #include <ignition/rendering/Light.hh>
 #include <ignition/rendering/Material.hh>
 #include <ignition/rendering/Scene.hh>
 #include <ignition/rendering/Visual.hh>
 
+#include "ignition/gazebo/ActorAnimations.hh"
 #include "ignition/gazebo/rendering/SceneManager.hh"
 
+#include "ActorAnimationLod.hh"
+
 using namespace ignition;
 using namespace gazebo;
 
 /// \brief Private data class.
 class ignition::gazebo::SceneManagerPrivate
 {
+  /// \brief Find the trajectory of an actor which is active at a given
+  /// time, and the pose of the actor along it.
+  /// \param[in] _id Actor entity's unique id
+  /// \param[in,out] _time Timepoint for the animation. It's set to the time
+  /// since the start of the active trajectory.
+  /// \param[in] _loop True if getting animation in loop
+  /// \param[out] _pose Pose of the actor along the trajectory, the identity
+  /// if it doesn't follow one.
+  /// \param[out] _followTraj Whether the actor follows a trajectory.
+  /// \return The active trajectory, or nullptr if the actor has none.
+  public: const common::TrajectoryInfo *ActorTrajectoryAt(Entity _id,
+              std::chrono::steady_clock::duration &_time, bool _loop,
+              math::Matrix4d &_pose, bool &_followTraj) const;
+
   /// \brief Keep track of world ID, which is equivalent to the scene's
   /// root visual.
   /// Defaults to zero, which is considered invalid by Ignition Gazebo.
@@ -63,10 +88,33 @@ class ignition::gazebo::SceneManagerPrivate
   /// \brief Map of actor entity in Gazebo to actor animations.
   public: std::map<Entity, common::SkeletonPtr> actorSkeletons;
 
+  /// \brief Map of actor entity to the animations it plays, compiled for
+  /// sampling and retargeted to its skin, by index in the skeleton.
+  public: std::map<Entity, std::map<unsigned int,
+              std::shared_ptr<const common::SkeletonAnimationClip>>>
+                    actorClips;
+
+  /// \brief Map of actor entity to the key frame cursors of its last
+  /// sampled animation.
+  public: std::map<Entity, std::vector<unsigned int>> actorCursors;
+
+  /// \brief Node transforms of the last sampled animation, reused across
+  /// calls to avoid allocations.
+  public: std::vector<math::Matrix4d> nodeTransforms;
+
   /// \brief Map of actor entity to the associated trajectories.
   public: std::map<Entity, std::vector<common::TrajectoryInfo>>
                     actorTrajectories;
 
+  /// \brief Map of actor entity to the time at which each of its
+  /// trajectories ends, counted from the start of the first one. It is
+  /// sorted, so the active trajectory can be found by binary search.
+  public: std::map<Entity, std::vector<std::chrono::steady_clock::duration>>
+                    actorTrajectoryEnds;
+
+  /// \brief Map of actor entity to its animation level of detail.
+  public: std::map<Entity, ActorAnimationLod> actorLods;
+
   /// \brief Map of light entity in Gazebo to light pointers.
   public: std::map<Entity, rendering::LightPtr> lights;
 
@@ -473,24 +521,14 @@ rendering::VisualPtr SceneManager::CreateActor(Entity _id,
   if (parent)
     name = parent->Name() +  "::" + name;
 
-  rendering::MeshDescriptor descriptor;
-  descriptor.meshName = _actor.SkinFilename();
-  common::MeshManager *meshManager = common::MeshManager::Instance();
-  descriptor.mesh = meshManager->Load(descriptor.meshName);
-  if (nullptr == descriptor.mesh)
-  {
-    ignerr << "Actor skin mesh [" << _actor.SkinFilename() << "] not found."
-           << std::endl;
+  ActorAnimations animations;
+  if (!loadActorAnimations(_actor, animations))
     return rendering::VisualPtr();
-  }
 
-  common::SkeletonPtr meshSkel = descriptor.mesh->MeshSkeleton();
-  if (nullptr == meshSkel)
-  {
-    ignerr << "Mesh skeleton in [" << _actor.SkinFilename() << "] not found."
-           << std::endl;
-    return rendering::VisualPtr();
-  }
+  rendering::MeshDescriptor descriptor;
+  descriptor.meshName = _actor.SkinFilename();
+  descriptor.mesh =
+      common::MeshManager::Instance()->MeshByName(descriptor.meshName);
 
   rendering::MeshPtr actorMesh = this->dataPtr->scene->CreateMesh(descriptor);
   if (nullptr == actorMesh)
@@ -500,105 +538,18 @@ rendering::VisualPtr SceneManager::CreateActor(Entity _id,
     return rendering::VisualPtr();
   }
 
-  unsigned int numAnims = 0;
-  std::map<std::string, unsigned int> mapAnimNameId;
-  mapAnimNameId[descriptor.meshName] = numAnims++;
-
   rendering::VisualPtr actorVisual = this->dataPtr->scene->CreateVisual(name);
   actorVisual->SetLocalPose(_actor.Pose());
   actorVisual->AddGeometry(actorMesh);
 
   this->dataPtr->visuals[_id] = actorVisual;
   this->dataPtr->actors[_id] = actorMesh;
-
-  // Load all animations
-  for (unsigned i = 0; i < _actor.AnimationCount(); ++i)
-  {
-    std::string animName = _actor.AnimationByIndex(i)->Name();
-    std::string animFilename = _actor.AnimationByIndex(i)->Filename();
-    double animScale = _actor.AnimationByIndex(i)->Scale();
-
-    std::string extension = animFilename.substr(animFilename.rfind('.') + 1,
-                                  animFilename.size());
-    std::transform(extension.begin(), extension.end(),
-                    extension.begin(), ::tolower);
-
-    if (extension == "bvh")
-    {
-      meshSkel->AddBvhAnimation(animFilename, animScale);
-      mapAnimNameId[animName] = numAnims++;
-    }
-    else if (extension == "dae")
-    {
-      common::MeshManager::Instance()->Load(animFilename);
-      auto animMesh = common::MeshManager::Instance()->MeshByName(animFilename);
-      // add the first animation
-      meshSkel->AddAnimation(animMesh->MeshSkeleton()->Animation(0));
-      mapAnimNameId[animName] = numAnims++;
-    }
-  }
-  this->dataPtr->actorSkeletons[_id] = meshSkel;
-
-  using TP = std::chrono::steady_clock::time_point;
-
-  std::vector<common::TrajectoryInfo> trajectories;
-  if (_actor.TrajectoryCount() != 0)
-  {
-    // Load all trajectories specified in sdf
-    for (unsigned i = 0; i < _actor.TrajectoryCount(); i++)
-    {
-      common::TrajectoryInfo trajInfo;
-      const sdf::Trajectory *trajSdf = _actor.TrajectoryByIndex(i);
-      trajInfo.SetId(trajSdf->Id());
-      trajInfo.SetAnimIndex(mapAnimNameId[trajSdf->Type()]);
-
-      if (trajSdf->WaypointCount() != 0)
-      {
-        std::map<TP, math::Pose3d> waypoints;
-        for (unsigned j = 0; j < trajSdf->WaypointCount(); j++)
-        {
-          auto point = trajSdf->WaypointByIndex(j);
-          TP point_tp(std::chrono::milliseconds(
-                    static_cast<int>(point->Time()*1000)));
-          waypoints[point_tp] = point->Pose();
-        }
-        trajInfo.SetWaypoints(waypoints);
-      }
-      else
-      {
-        auto skel = this->dataPtr->actorSkeletons[_id];
-        trajInfo.SetTranslated(false);
-      }
-      trajectories.push_back(trajInfo);
-    }
-  }
-  // if there are no trajectories, but there are animations, add a trajectory
-  else
-  {
-    auto skel = this->dataPtr->actorSkeletons[_id];
-    common::TrajectoryInfo trajInfo;
-    trajInfo.SetId(0);
-    trajInfo.SetAnimIndex(0);
-    std::chrono::milliseconds timepoint(0);
-    trajInfo.SetStartTime(TP(timepoint));
-    timepoint = std::chrono::milliseconds(
-                  static_cast<int>(skel->Animation(0)->Length() * 1000));
-    trajInfo.SetEndTime(TP(timepoint));
-    trajInfo.SetTranslated(false);
-    trajectories.push_back(trajInfo);
-  }
-
-  // sequencing all trajectories
-  TP time(std::chrono::milliseconds(0));
-  for (auto &trajectory : trajectories)
-  {
-    auto dura = trajectory.Duration();
-    trajectory.SetStartTime(time);
-    time += dura;
-    trajectory.SetEndTime(time);
-  }
-
-  this->dataPtr->actorTrajectories[_id] = trajectories;
+  this->dataPtr->actorSkeletons[_id] = animations.skeleton;
+  this->dataPtr->actorClips[_id] = std::move(animations.clips);
+  this->dataPtr->actorTrajectories[_id] = std::move(animations.trajectories);
+  this->dataPtr->actorTrajectoryEnds[_id] =
+      std::move(animations.trajectoryEnds);
+  this->dataPtr->actorLods[_id] = loadActorAnimationLod(_actor.Element());
 
   if (parent)
     parent->AddChild(actorVisual);
@@ -778,55 +729,12 @@ rendering::MeshPtr SceneManager::ActorMeshById(Entity _id) const
 std::map<std::string, math::Matrix4d> SceneManager::ActorMeshAnimationAt(
     Entity _id, std::chrono::steady_clock::duration _time, bool _loop) const
 {
-  if (this->dataPtr->actorTrajectories.find(_id) 
-           == this->dataPtr->actorTrajectories.end())
-  {
-    return std::map<std::string, math::Matrix4d>();
-  }
-
-  auto trajs = this->dataPtr->actorTrajectories[_id];
+  math::Matrix4d rootTf;
   bool followTraj = true;
-  if ( 1 == trajs.size() && nullptr == trajs[0].Waypoints())
-  {
-    followTraj = false;
-  }
-
-  auto firstTraj = trajs.begin();
-  auto poseFrame = common::PoseKeyFrame(0.0);
-
-  common::TrajectoryInfo traj = trajs[0];
-
-  std::chrono::steady_clock::duration totalTime =
-          trajs.rbegin()->EndTime() - trajs.begin()->StartTime();
-
-  if (_loop || _time <= totalTime)
-  {
-    while (_time > totalTime)
-    {
-      _time = _time - totalTime;
-    }
-    if (followTraj)
-    {
-      for (auto &trajectory : trajs)
-      {
-        if (trajectory.StartTime() - firstTraj->StartTime() <= _time
-                  && trajectory.EndTime() - firstTraj->StartTime() >= _time)
-        {
-          traj = trajectory;
-          _time -= traj.StartTime() - firstTraj->StartTime();
-          auto [sec, nsec] = math::durationToSecNsec(_time);
-          double time_seconds = sec + nsec / 1000000000.0;
-
-          traj.Waypoints()->Time(time_seconds);
-          traj.Waypoints()->InterpolatedKeyFrame(poseFrame);
-          break;
-        }
-      }
-    }
-  }
-
-  math::Matrix4d rootTf(poseFrame.Rotation());
-  rootTf.SetTranslation(poseFrame.Translation());
+  const common::TrajectoryInfo *traj =
+      this->dataPtr->ActorTrajectoryAt(_id, _time, _loop, rootTf, followTraj);
+  if (nullptr == traj)
+    return std::map<std::string, math::Matrix4d>();
 
   std::map<std::string, math::Matrix4d> allFrames;
 
@@ -834,41 +742,36 @@ std::map<std::string, math::Matrix4d> SceneManager::ActorMeshAnimationAt(
   if (vIt != this->dataPtr->actorSkeletons.end())
   {
     auto skel = vIt->second;
-    unsigned int animIndex = traj.AnimIndex();
-    std::map<std::string, math::Matrix4d> rawFrames;
+    unsigned int animIndex = traj->AnimIndex();
+    const common::SkeletonAnimationClip &clip =
+        *this->dataPtr->actorClips[_id].at(animIndex);
 
     auto [sec, nsec] = math::durationToSecNsec(_time);
     double time_seconds = sec + nsec / 1000000000.0;
 
+    bool loop = _loop;
     if (followTraj)
     {
-      double distance = traj.DistanceSoFar(_time);
-      if (distance < 0.1)
-      {
-        rawFrames = skel->Animation(animIndex)->PoseAt(time_seconds, _loop);
-      }
-      else
+      double distance = traj->DistanceSoFar(_time);
+      int rootIndex = clip.NodeIndex(skel->RootNode()->Name());
+      if (distance >= 0.1 && rootIndex >= 0)
       {
-        rawFrames = skel->Animation(animIndex)->PoseAtX(distance,
-                                        skel->RootNode()->Name());
+        time_seconds = clip.TimeAtX(distance, rootIndex);
+        loop = true;
       }
     }
-    else
-    {
-      rawFrames = skel->Animation(animIndex)->PoseAt(time_seconds, _loop);
-    }
-
-    for (auto pair : rawFrames)
-    {
-      std::string nodeName = pair.first;
-      auto nodeTf = pair.second;
 
-      std::string skinName = skel->NodeNameAnimToSkin(animIndex, nodeName);
-      math::Matrix4d skinTf = skel->AlignTranslation(animIndex, nodeName)
-              * nodeTf * skel->AlignRotation(animIndex, nodeName);
+    // Cursors that belong to another animation are still valid, they only
+    // make the first sample slower
+    auto &cursors = this->dataPtr->actorCursors[_id];
+    cursors.resize(clip.NodeCount(), 0u);
+    auto &nodeTransforms = this->dataPtr->nodeTransforms;
+    nodeTransforms.resize(clip.NodeCount());
+    clip.PoseAt(time_seconds, nodeTransforms.data(), cursors.data(), loop);
 
-      allFrames[skinName] = skinTf;
-    }
+    // The clip is retargeted to the skin
+    for (unsigned int n = 0; n < clip.NodeCount(); ++n)
+      allFrames[clip.NodeName(n)] = nodeTransforms[n];
   }
 
   // correct animation root pose
@@ -889,6 +792,130 @@ std::map<std::string, math::Matrix4d> SceneManager::ActorMeshAnimationAt(
   return allFrames;
 }
 
+/////////////////////////////////////////////////
+bool SceneManager::ActorTrajectoryPoseAt(Entity _id,
+    std::chrono::steady_clock::duration _time, bool _loop,
+    math::Matrix4d &_pose) const
+{
+  bool followTraj = false;
+  auto traj = this->dataPtr->ActorTrajectoryAt(_id, _time, _loop, _pose,
+      followTraj);
+  return nullptr != traj && followTraj;
+}
+
+/////////////////////////////////////////////////
+void SceneManager::UpdateActorAnimationLods()
+{
+  if (this->dataPtr->actorLods.empty() || !this->dataPtr->scene)
+    return;
+
+  // Gather the cameras and the angle from their optical axis within which
+  // they can see
+  std::vector<ActorCameraView> views;
+  for (unsigned int i = 0; i < this->dataPtr->scene->SensorCount(); ++i)
+  {
+    auto camera = std::dynamic_pointer_cast<rendering::Camera>(
+        this->dataPtr->scene->SensorByIndex(i));
+    if (!camera)
+      continue;
+
+    views.push_back({camera->WorldPosition(),
+        camera->WorldRotation().RotateVector(math::Vector3d::UnitX),
+        actorCameraHalfAngle(camera->HFOV().Radian(),
+        camera->AspectRatio())});
+  }
+
+  for (auto &[id, lod] : this->dataPtr->actorLods)
+  {
+    // Without cameras, there is nothing to base the level of detail on
+    if (views.empty())
+    {
+      lod.level = ActorAnimationLevel::FULL;
+      continue;
+    }
+
+    auto vIt = this->dataPtr->visuals.find(id);
+    if (vIt == this->dataPtr->visuals.end())
+      continue;
+
+    lod.level = actorAnimationLevel(lod, vIt->second->WorldPosition(),
+        views);
+  }
+}
+
+/////////////////////////////////////////////////
+bool SceneManager::ActorSkeletonUpdateDue(Entity _id,
+    std::chrono::steady_clock::duration _time)
+{
+  auto it = this->dataPtr->actorLods.find(_id);
+  if (it == this->dataPtr->actorLods.end())
+    return true;
+
+  return actorSkeletonUpdateDue(it->second, _time);
+}
+
+/////////////////////////////////////////////////
+const common::TrajectoryInfo *SceneManagerPrivate::ActorTrajectoryAt(
+    Entity _id, std::chrono::steady_clock::duration &_time, bool _loop,
+    math::Matrix4d &_pose, bool &_followTraj) const
+{
+  auto trajIt = this->actorTrajectories.find(_id);
+  auto endsIt = this->actorTrajectoryEnds.find(_id);
+  if (trajIt == this->actorTrajectories.end() ||
+      trajIt->second.empty() || endsIt == this->actorTrajectoryEnds.end())
+  {
+    return nullptr;
+  }
+
+  const auto &trajs = trajIt->second;
+  const auto &trajEnds = endsIt->second;
+  _followTraj = true;
+  if ( 1 == trajs.size() && nullptr == trajs[0].Waypoints())
+  {
+    _followTraj = false;
+  }
+
+  auto poseFrame = common::PoseKeyFrame(0.0);
+
+  const common::TrajectoryInfo *traj = &trajs[0];
+
+  const std::chrono::steady_clock::duration zero{0};
+  std::chrono::steady_clock::duration totalTime = trajEnds.back();
+
+  if (_loop || _time <= totalTime)
+  {
+    // Wrap to (0, totalTime], like repeatedly subtracting the total time
+    if (_time > totalTime && totalTime > zero)
+    {
+      _time = _time % totalTime;
+      if (_time == zero)
+        _time = totalTime;
+    }
+    if (_followTraj)
+    {
+      // The active trajectory is the first one that ends at or after the
+      // time
+      auto endIt = std::lower_bound(trajEnds.begin(), trajEnds.end(), _time);
+      auto index = endIt - trajEnds.begin();
+      auto start = index > 0 ? trajEnds[index - 1] : zero;
+      if (endIt != trajEnds.end() && start <= _time &&
+          nullptr != trajs[index].Waypoints())
+      {
+        traj = &trajs[index];
+        _time -= start;
+        auto [sec, nsec] = math::durationToSecNsec(_time);
+        double time_seconds = sec + nsec / 1000000000.0;
+
+        traj->Waypoints()->InterpolatedKeyFrame(time_seconds, poseFrame);
+      }
+    }
+  }
+
+  _pose = math::Matrix4d(poseFrame.Rotation());
+  _pose.SetTranslation(poseFrame.Translation());
+  return traj;
+}
+
 /////////////////////////////////////////////////
 void SceneManager::RemoveEntity(Entity _id)
 {
@@ -898,6 +925,13 @@ void SceneManager::RemoveEntity(Entity _id)
     {
       this->dataPtr->scene->DestroyVisual(it->second);
       this->dataPtr->visuals.erase(it);
+      this->dataPtr->actors.erase(_id);
+      this->dataPtr->actorSkeletons.erase(_id);
+      this->dataPtr->actorTrajectories.erase(_id);
+      this->dataPtr->actorTrajectoryEnds.erase(_id);
+      this->dataPtr->actorClips.erase(_id);
+      this->dataPtr->actorCursors.erase(_id);
+      this->dataPtr->actorLods.erase(_id);
       return;
     }
   }
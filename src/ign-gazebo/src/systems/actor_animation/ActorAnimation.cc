@@ -0,0 +1,245 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <sdf/Actor.hh>
+
+#include <ignition/common/Animation.hh>
+#include <ignition/common/KeyFrame.hh>
+#include <ignition/common/Profiler.hh>
+#include <ignition/common/Skeleton.hh>
+#include <ignition/common/SkeletonAnimationClip.hh>
+#include <ignition/common/SkeletonNode.hh>
+#include <ignition/math/Helpers.hh>
+#include <ignition/plugin/Register.hh>
+
+#include "ignition/gazebo/ActorAnimations.hh"
+#include "ignition/gazebo/components/Actor.hh"
+
+#include "ActorAnimation.hh"
+
+using namespace ignition;
+using namespace gazebo;
+using namespace systems;
+
+/// \brief Animation state of one actor.
+class ActorState
+{
+  /// \brief Skeleton, animation clips and trajectories of the actor.
+  public: ActorAnimations animations;
+
+  /// \brief Key frame cursors of the last sampled animation.
+  public: std::vector<unsigned int> cursors;
+
+  /// \brief False if the actor is animated in place, without waypoints.
+  public: bool followTrajectory{true};
+};
+
+/// \brief Private data class for ActorAnimation
+class ignition::gazebo::systems::ActorAnimationPrivate
+{
+  /// \brief Load the skeleton, animations and trajectories of an actor.
+  /// \param[in] _actor Actor description.
+  /// \param[out] _state State to initialize.
+  /// \return True on success.
+  public: bool Load(const sdf::Actor &_actor, ActorState &_state);
+
+  /// \brief Evaluate the trajectory and skeleton of an actor.
+  /// \param[in] _state Actor to evaluate.
+  /// \param[in] _time Simulation time.
+  /// \param[out] _pose Pose of the actor.
+  /// \param[out] _bones Transforms of the skin bones.
+  public: void Evaluate(ActorState &_state,
+              std::chrono::steady_clock::duration _time,
+              math::Pose3d &_pose,
+              std::map<std::string, math::Matrix4d> &_bones);
+
+  /// \brief Animation state of each actor entity.
+  public: std::unordered_map<Entity, ActorState> actors;
+
+  /// \brief Node transforms of the last sampled animation, reused across
+  /// actors to avoid allocations.
+  public: std::vector<math::Matrix4d> nodeTransforms;
+};
+
+//////////////////////////////////////////////////
+bool ActorAnimationPrivate::Load(const sdf::Actor &_actor,
+    ActorState &_state)
+{
+  if (!loadActorAnimations(_actor, _state.animations))
+    return false;
+
+  const auto &trajectories = _state.animations.trajectories;
+  _state.followTrajectory =
+      !(1 == trajectories.size() && nullptr == trajectories[0].Waypoints());
+
+  return true;
+}
+
+//////////////////////////////////////////////////
+void ActorAnimationPrivate::Evaluate(ActorState &_state,
+    std::chrono::steady_clock::duration _time, math::Pose3d &_pose,
+    std::map<std::string, math::Matrix4d> &_bones)
+{
+  const auto &trajs = _state.animations.trajectories;
+  const auto &trajEnds = _state.animations.trajectoryEnds;
+
+  auto poseFrame = common::PoseKeyFrame(0.0);
+  const common::TrajectoryInfo *traj = &trajs[0];
+
+  const std::chrono::steady_clock::duration zero{0};
+  std::chrono::steady_clock::duration totalTime = trajEnds.back();
+
+  // Wrap to (0, totalTime], like repeatedly subtracting the total time
+  if (_time > totalTime && totalTime > zero)
+  {
+    _time = _time % totalTime;
+    if (_time == zero)
+      _time = totalTime;
+  }
+  if (_state.followTrajectory)
+  {
+    // The active trajectory is the first one that ends at or after the time
+    auto endIt = std::lower_bound(trajEnds.begin(), trajEnds.end(), _time);
+    auto index = endIt - trajEnds.begin();
+    auto start = index > 0 ? trajEnds[index - 1] : zero;
+    if (endIt != trajEnds.end() && start <= _time &&
+        nullptr != trajs[index].Waypoints())
+    {
+      traj = &trajs[index];
+      _time -= start;
+      auto [sec, nsec] = math::durationToSecNsec(_time);
+      double timeSeconds = sec + nsec / 1000000000.0;
+
+      traj->Waypoints()->InterpolatedKeyFrame(timeSeconds, poseFrame);
+    }
+  }
+
+  auto skel = _state.animations.skeleton;
+  const common::SkeletonAnimationClip &clip =
+      *_state.animations.clips.at(traj->AnimIndex());
+
+  auto [sec, nsec] = math::durationToSecNsec(_time);
+  double timeSeconds = sec + nsec / 1000000000.0;
+
+  if (_state.followTrajectory)
+  {
+    double distance = traj->DistanceSoFar(_time);
+    int rootIndex = clip.NodeIndex(skel->RootNode()->Name());
+    if (distance >= 0.1 && rootIndex >= 0)
+      timeSeconds = clip.TimeAtX(distance, rootIndex);
+  }
+
+  _state.cursors.resize(clip.NodeCount(), 0u);
+  this->nodeTransforms.resize(clip.NodeCount());
+  clip.PoseAt(timeSeconds, this->nodeTransforms.data(),
+      _state.cursors.data(), true);
+
+  for (unsigned int n = 0; n < clip.NodeCount(); ++n)
+    _bones[clip.NodeName(n)] = this->nodeTransforms[n];
+
+  // correct animation root pose
+  auto &rootTf = _bones[skel->RootNode()->Name()];
+  if (_state.followTrajectory)
+    _pose = math::Pose3d(poseFrame.Translation(), poseFrame.Rotation());
+  else
+    _pose = math::Pose3d(rootTf.Translation(), math::Quaterniond::Identity);
+
+  rootTf.SetTranslation(math::Vector3d::Zero);
+}
+
+//////////////////////////////////////////////////
+ActorAnimation::ActorAnimation()
+  : System(), dataPtr(std::make_unique<ActorAnimationPrivate>())
+{
+}
+
+//////////////////////////////////////////////////
+ActorAnimation::~ActorAnimation() = default;
+
+//////////////////////////////////////////////////
+void ActorAnimation::PreUpdate(const UpdateInfo &_info,
+    EntityComponentManager &_ecm)
+{
+  IGN_PROFILE("ActorAnimation::PreUpdate");
+
+  _ecm.EachRemoved<components::Actor>(
+      [&](const Entity &_entity, const components::Actor *)->bool
+      {
+        this->dataPtr->actors.erase(_entity);
+        return true;
+      });
+
+  _ecm.EachNew<components::Actor>(
+      [&](const Entity &_entity, const components::Actor *_actor)->bool
+      {
+        ActorState state;
+        if (this->dataPtr->Load(_actor->Data(), state))
+          this->dataPtr->actors[_entity] = std::move(state);
+        return true;
+      });
+
+  for (auto &[entity, state] : this->dataPtr->actors)
+  {
+    auto poseComp = _ecm.Component<components::ActorPose>(entity);
+    auto bonesComp = _ecm.Component<components::ActorBoneTransforms>(entity);
+
+    // Nothing changes while paused, once the actor has been evaluated
+    if (_info.paused && poseComp && bonesComp)
+      continue;
+
+    math::Pose3d pose;
+    std::map<std::string, math::Matrix4d> bones;
+    this->dataPtr->Evaluate(state, _info.simTime, pose, bones);
+
+    if (poseComp)
+    {
+      poseComp->Data() = pose;
+      _ecm.SetChanged(entity, components::ActorPose::typeId,
+          ComponentState::PeriodicChange);
+    }
+    else
+    {
+      _ecm.CreateComponent(entity, components::ActorPose(pose));
+    }
+
+    if (bonesComp)
+    {
+      bonesComp->Data() = std::move(bones);
+      _ecm.SetChanged(entity, components::ActorBoneTransforms::typeId,
+          ComponentState::PeriodicChange);
+    }
+    else
+    {
+      _ecm.CreateComponent(entity,
+          components::ActorBoneTransforms(std::move(bones)));
+    }
+  }
+}
+
+IGNITION_ADD_PLUGIN(ActorAnimation,
+                    System,
+                    ActorAnimation::ISystemPreUpdate)
+
+IGNITION_ADD_PLUGIN_ALIAS(ActorAnimation,
+                          "ignition::gazebo::systems::ActorAnimation")
@@ -0,0 +1,65 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef IGNITION_GAZEBO_SYSTEMS_ACTORANIMATION_HH_
+#define IGNITION_GAZEBO_SYSTEMS_ACTORANIMATION_HH_
+
+#include <memory>
+#include <ignition/gazebo/config.hh>
+#include <ignition/gazebo/Export.hh>
+#include <ignition/gazebo/System.hh>
+
+namespace ignition
+{
+namespace gazebo
+{
+// Inline bracket to help doxygen filtering.
+inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
+namespace systems
+{
+  // Forward declaration
+  class ActorAnimationPrivate;
+
+  /// \brief Actor animation system. Attach to a world to animate all its
+  /// actors on the server. At every step, the trajectory and the skeleton
+  /// animation of each actor are evaluated once, and the results are stored
+  /// in the components::ActorPose and components::ActorBoneTransforms
+  /// components of the actor. Rendering consumers, such as the GUI and the
+  /// sensors, use these components instead of evaluating the animations
+  /// themselves, and the actor state is logged with the rest of the world.
+  class IGNITION_GAZEBO_VISIBLE ActorAnimation
+      : public System,
+        public ISystemPreUpdate
+  {
+    /// \brief Constructor
+    public: ActorAnimation();
+
+    /// \brief Destructor
+    public: ~ActorAnimation() override;
+
+    // Documentation inherited
+    public: void PreUpdate(const UpdateInfo &_info,
+                EntityComponentManager &_ecm) override;
+
+    /// \brief Private data pointer
+    private: std::unique_ptr<ActorAnimationPrivate> dataPtr;
+  };
+  }
+}
+}
+}
+
+#endif
@@ -17,9 +17,15 @@
 
 #include "LogPlayback.hh"
 
+#include <google/protobuf/io/coded_stream.h>
+#include <ignition/msgs/header.pb.h>
 #include <ignition/msgs/pose_v.pb.h>
 
+#include <algorithm>
+#include <set>
 #include <string>
+#include <unordered_set>
+#include <vector>
 
 #include <ignition/msgs/Utility.hh>
 
@@ -30,6 +36,7 @@
 #include <ignition/common/Filesystem.hh>
 #include <ignition/common/Profiler.hh>
 #include <ignition/common/Time.hh>
+#include <ignition/transport/log/QualifiedTime.hh>
 #include <ignition/transport/log/QueryOptions.hh>
 #include <ignition/transport/log/Log.hh>
 #include <ignition/transport/log/Message.hh>
@@ -46,9 +53,61 @@ using namespace ignition;
 using namespace gazebo;
 using namespace systems;
 
+/// \brief Suffix of the topic which LogRecord publishes keyframes on.
+static const char kKeyframeTopicSuffix[] = "/state_keyframe";
+
+/// \brief How far before a keyframe's reception time to start reading
+/// incremental messages after a seek. Messages are stored by reception time,
+/// which may lag slightly behind the sim time in their headers.
+static const std::chrono::seconds kSeekQueryMargin{1};
+
+//////////////////////////////////////////////////
+/// \brief Read the sim time stamped on a serialized keyframe without
+/// decoding its entities. Fields are serialized in field number order, so
+/// the header, field 1 of SerializedStateMap, comes first when it's set.
+/// \param[in] _data Serialized msgs::SerializedStateMap.
+/// \return Sim time of the keyframe.
+static std::chrono::steady_clock::duration keyframeStamp(
+    const std::string &_data)
+{
+  google::protobuf::io::CodedInputStream input(
+      reinterpret_cast<const uint8_t *>(_data.data()),
+      static_cast<int>(_data.size()));
+
+  // Tag of field 1 with the length delimited wire type
+  const uint32_t headerTag = (1u << 3) | 2u;
+  uint32_t length{0};
+  if (input.ReadTag() == headerTag && input.ReadVarint32(&length))
+  {
+    auto limit = input.PushLimit(static_cast<int>(length));
+    msgs::Header header;
+    if (header.ParseFromCodedStream(&input) &&
+        input.ConsumedEntireMessage())
+    {
+      input.PopLimit(limit);
+      return convert<std::chrono::steady_clock::duration>(header.stamp());
+    }
+  }
+
+  // No header, or written by something else: decode the whole message
+  msgs::SerializedStateMap msg;
+  msg.ParseFromString(_data);
+  return convert<std::chrono::steady_clock::duration>(msg.header().stamp());
+}
+
 /// \brief Private LogPlayback data class.
 class ignition::gazebo::systems::LogPlaybackPrivate
 {
+  /// \brief Entry of the keyframe time index.
+  public: struct Keyframe
+  {
+    /// \brief Sim time stamped on the keyframe's header.
+    std::chrono::steady_clock::duration stamp;
+
+    /// \brief Time the keyframe was stored in the log.
+    std::chrono::nanoseconds timeReceived;
+  };
+
   /// \brief Start log playback.
   /// \param[in] _logPath Path of recorded state to playback.
   /// \param[in] _ecm The EntityComponentManager of the given simulation
@@ -73,6 +132,55 @@ class ignition::gazebo::systems::LogPlaybackPrivate
   public: void Parse(EntityComponentManager &_ecm,
       const msgs::SerializedStateMap &_msg);
 
+  /// \brief Jump to the given sim time by applying the latest keyframe at or
+  /// before it and positioning the iterator on the messages that follow.
+  /// \param[in] _ecm Mutable ECM.
+  /// \param[in] _time Sim time to seek to.
+  /// \return True if a keyframe was found and applied.
+  public: bool Seek(EntityComponentManager &_ecm,
+      const std::chrono::steady_clock::duration &_time);
+
+  /// \brief Index of the latest keyframe at or before the given time.
+  /// \param[in] _time Sim time.
+  /// \return Index into keyframes, or -1 if all keyframes are later.
+  public: int64_t KeyframeIndex(
+      const std::chrono::steady_clock::duration &_time) const;
+
+  /// \brief Apply the message the iterator points to, if it is due.
+  /// \param[in] _ecm Mutable ECM.
+  /// \param[in] _simTime Current sim time.
+  /// \return False if the message is stamped later than _simTime and should
+  /// wait for a future update.
+  public: bool ApplyIfDue(EntityComponentManager &_ecm,
+      const std::chrono::steady_clock::duration &_simTime);
+
+  /// \brief Parse the message the iterator points to and apply it if due.
+  /// \param[in] _ecm Mutable ECM.
+  /// \param[in] _simTime Current sim time.
+  /// \return False if the message should wait for a future update.
+  public: template <typename MsgT>
+  bool ApplyMsgIfDue(EntityComponentManager &_ecm,
+      const std::chrono::steady_clock::duration &_simTime);
+
+  /// \brief Log file being played back
+  public: std::unique_ptr<transport::log::Log> log;
+
+  /// \brief All topics in the log except the keyframe topic
+  public: std::set<std::string> topics;
+
+  /// \brief Topic holding keyframes, empty if the log has none
+  public: std::string keyframeTopic;
+
+  /// \brief Time index of keyframes, sorted by stamp
+  public: std::vector<Keyframe> keyframes;
+
+  /// \brief Stamp of the last message applied
+  public: std::chrono::steady_clock::duration lastStamp{0};
+
+  /// \brief Messages stamped earlier than this are already contained in the
+  /// last keyframe that was seeked to, and are skipped.
+  public: std::chrono::steady_clock::duration seekStamp{0};
+
   /// \brief A batch of data from log file, of all pose messages
   public: transport::log::Batch batch;
 
@@ -205,39 +313,84 @@ bool LogPlaybackPrivate::Start(const std::string &_logPath,
   }
 
   // Call Log.hh directly to load a .tlog file
-  auto log = std::make_unique<transport::log::Log>();
-  if (!log->Open(dbPath))
+  this->log = std::make_unique<transport::log::Log>();
+  if (!this->log->Open(dbPath))
   {
     ignerr << "Failed to open log file [" << dbPath << "]" << std::endl;
+    return false;
   }
 
-  // Access all messages in .tlog file
-  this->batch = log->QueryMessages();
-  this->iter = this->batch.begin();
+  // Keyframes are indexed separately from the incremental messages
+  const auto &allTopics = this->log->Descriptor()->TopicsToMsgTypesToId();
+  const std::string suffix(kKeyframeTopicSuffix);
+  for (const auto &topicEntry : allTopics)
+  {
+    const std::string &topic = topicEntry.first;
+    if (topic.size() > suffix.size() &&
+        topic.compare(topic.size() - suffix.size(), suffix.size(), suffix) == 0)
+    {
+      this->keyframeTopic = topic;
+    }
+    else
+    {
+      this->topics.insert(topic);
+    }
+  }
 
-  if (this->iter == this->batch.end())
+  // Build the time index. Only the stamps are kept in memory, keyframes are
+  // decoded from the log when seeking.
+  if (!this->keyframeTopic.empty())
   {
-    ignerr << "No messages found in log file [" << dbPath << "]" << std::endl;
+    auto keyframeBatch = this->log->QueryMessages(
+        transport::log::TopicList(this->keyframeTopic));
+    for (auto it = keyframeBatch.begin(); it != keyframeBatch.end(); ++it)
+    {
+      this->keyframes.push_back({keyframeStamp(it->Data()),
+          it->TimeReceived()});
+    }
+    std::stable_sort(this->keyframes.begin(), this->keyframes.end(),
+        [](const Keyframe &_a, const Keyframe &_b)
+        {
+          return _a.stamp < _b.stamp;
+        });
   }
 
-  // Look for the first SerializedState message and use it to set the initial
-  // state of the world. Messages received before this are ignored.
-  for (; this->iter != this->batch.end(); ++this->iter)
+  if (!this->keyframes.empty())
+  {
+    this->Seek(_ecm, this->keyframes.front().stamp);
+  }
+  else
   {
-    auto msgType = this->iter->Type();
-    if (msgType == "ignition.msgs.SerializedState")
+    // Access all messages in .tlog file
+    this->batch = this->log->QueryMessages(
+        transport::log::TopicList::Create(this->topics));
+    this->iter = this->batch.begin();
+
+    if (this->iter == this->batch.end())
     {
-      msgs::SerializedState msg;
-      msg.ParseFromString(this->iter->Data());
-      this->Parse(_ecm, msg);
-      break;
+      ignerr << "No messages found in log file [" << dbPath << "]"
+             << std::endl;
     }
-    else if (msgType == "ignition.msgs.SerializedStateMap")
+
+    // Look for the first SerializedState message and use it to set the
+    // initial state of the world. Messages received before this are ignored.
+    for (; this->iter != this->batch.end(); ++this->iter)
     {
-      msgs::SerializedStateMap msg;
-      msg.ParseFromString(this->iter->Data());
-      this->Parse(_ecm, msg);
-      break;
+      auto msgType = this->iter->Type();
+      if (msgType == "ignition.msgs.SerializedState")
+      {
+        msgs::SerializedState msg;
+        msg.ParseFromString(this->iter->Data());
+        this->Parse(_ecm, msg);
+        break;
+      }
+      else if (msgType == "ignition.msgs.SerializedStateMap")
+      {
+        msgs::SerializedStateMap msg;
+        msg.ParseFromString(this->iter->Data());
+        this->Parse(_ecm, msg);
+        break;
+      }
     }
   }
 
@@ -256,77 +409,158 @@ void LogPlayback::Update(const UpdateInfo &_info, EntityComponentManager &_ecm)
   if (!this->dataPtr->instStarted)
     return;
 
-  // TODO(anyone) Support rewind
-  // Sanity check. If playing reached the end, done.
-  if (this->dataPtr->iter == this->dataPtr->batch.end())
+  if (!this->dataPtr->keyframes.empty())
   {
-    // Print only once
-    if (!this->dataPtr->printedEnd)
+    // Rewind, or jump forward when more than a whole keyframe interval would
+    // otherwise have to be replayed message by message.
+    auto target = this->dataPtr->KeyframeIndex(_info.simTime);
+    if (target >= 0 && (_info.simTime < this->dataPtr->lastStamp ||
+        target > this->dataPtr->KeyframeIndex(this->dataPtr->lastStamp) + 1))
     {
-      ignmsg << "Finished playing all recorded data\n";
-      this->dataPtr->printedEnd = true;
+      this->dataPtr->Seek(_ecm, _info.simTime);
     }
-    return;
   }
 
-  auto msgType = this->dataPtr->iter->Type();
+  // Apply every message that is due, in case playback has a lower frequency
+  // than record
+  while (this->dataPtr->iter != this->dataPtr->batch.end())
+  {
+    if (!this->dataPtr->ApplyIfDue(_ecm, _info.simTime))
+      return;
+    ++(this->dataPtr->iter);
+  }
 
-  // Only playback if current sim time has exceeded next logged timestamp
-  // TODO(anyone) Support multiple msgs per update, in case playback has a lower
-  // frequency than record
-  if (msgType == "ignition.msgs.Pose_V")
+  // If playing reached the end, done. Print only once
+  if (!this->dataPtr->printedEnd)
   {
-    msgs::Pose_V msg;
-    msg.ParseFromString(this->dataPtr->iter->Data());
+    ignmsg << "Finished playing all recorded data\n";
+    this->dataPtr->printedEnd = true;
+  }
+}
 
-    auto stamp = convert<std::chrono::steady_clock::duration>(
-        msg.header().stamp());
+//////////////////////////////////////////////////
+int64_t LogPlaybackPrivate::KeyframeIndex(
+    const std::chrono::steady_clock::duration &_time) const
+{
+  auto it = std::upper_bound(this->keyframes.begin(), this->keyframes.end(),
+      _time, [](const std::chrono::steady_clock::duration &_t,
+                const Keyframe &_keyframe)
+      {
+        return _t < _keyframe.stamp;
+      });
+  return static_cast<int64_t>(it - this->keyframes.begin()) - 1;
+}
 
-    if (_info.simTime >= stamp)
-    {
-      this->dataPtr->Parse(_ecm, msg);
-      ++(this->dataPtr->iter);
-    }
+//////////////////////////////////////////////////
+bool LogPlaybackPrivate::Seek(EntityComponentManager &_ecm,
+    const std::chrono::steady_clock::duration &_time)
+{
+  IGN_PROFILE("LogPlayback::Seek");
+  auto index = this->KeyframeIndex(_time);
+  if (index < 0)
+  {
+    ignwarn << "No keyframe recorded before ["
+            << std::chrono::duration<double>(_time).count()
+            << "] s, can't seek.\n";
+    return false;
   }
-  else if (msgType == "ignition.msgs.SerializedState")
+  const Keyframe &keyframe = this->keyframes[index];
+
+  // The messages table is indexed by reception time, so both queries below
+  // are O(log n) lookups.
+  auto keyframeBatch = this->log->QueryMessages(transport::log::TopicList(
+      this->keyframeTopic, transport::log::QualifiedTimeRange(
+      keyframe.timeReceived, keyframe.timeReceived)));
+  auto keyframeIter = keyframeBatch.begin();
+  if (keyframeIter == keyframeBatch.end())
   {
-    msgs::SerializedState msg;
-    msg.ParseFromString(this->dataPtr->iter->Data());
+    ignerr << "Failed to load keyframe at ["
+           << std::chrono::duration<double>(keyframe.stamp).count()
+           << "] s.\n";
+    return false;
+  }
 
-    auto stamp = convert<std::chrono::steady_clock::duration>(
-        msg.header().stamp());
+  msgs::SerializedStateMap msg;
+  msg.ParseFromString(keyframeIter->Data());
 
-    if (_info.simTime >= stamp)
-    {
-      this->dataPtr->Parse(_ecm, msg);
-      ++(this->dataPtr->iter);
-    }
+  // A keyframe holds every entity that existed when it was recorded, so any
+  // other entity was created after it when rewinding, or removed before it
+  // when jumping forward.
+  std::unordered_set<Entity> keyframeEntities;
+  for (const auto &entityIt : msg.entities())
+  {
+    if (!entityIt.second.remove())
+      keyframeEntities.insert(entityIt.second.id());
   }
-  else if (msgType == "ignition.msgs.SerializedStateMap")
+  for (const auto &vertex : _ecm.Entities().Vertices())
   {
-    msgs::SerializedStateMap msg;
-    msg.ParseFromString(this->dataPtr->iter->Data());
+    if (keyframeEntities.find(vertex.first) == keyframeEntities.end())
+      _ecm.RequestRemoveEntity(vertex.first, false);
+  }
 
-    auto stamp = convert<std::chrono::steady_clock::duration>(
-        msg.header().stamp());
+  this->Parse(_ecm, msg);
 
-    if (_info.simTime >= stamp)
-    {
-      this->dataPtr->Parse(_ecm, msg);
-      ++(this->dataPtr->iter);
-    }
+  this->batch = this->log->QueryMessages(transport::log::TopicList::Create(
+      this->topics, transport::log::QualifiedTimeRange::From(
+      keyframe.timeReceived - kSeekQueryMargin)));
+  this->iter = this->batch.begin();
+  this->seekStamp = keyframe.stamp;
+  this->lastStamp = keyframe.stamp;
+  this->printedEnd = false;
+  return true;
+}
+
+//////////////////////////////////////////////////
+template <typename MsgT>
+bool LogPlaybackPrivate::ApplyMsgIfDue(EntityComponentManager &_ecm,
+    const std::chrono::steady_clock::duration &_simTime)
+{
+  MsgT msg;
+  msg.ParseFromString(this->iter->Data());
+
+  auto stamp = convert<std::chrono::steady_clock::duration>(
+      msg.header().stamp());
+
+  // Only playback if current sim time has exceeded next logged timestamp
+  if (_simTime < stamp)
+    return false;
+
+  if (stamp >= this->seekStamp)
+  {
+    this->Parse(_ecm, msg);
+    this->lastStamp = stamp;
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool LogPlaybackPrivate::ApplyIfDue(EntityComponentManager &_ecm,
+    const std::chrono::steady_clock::duration &_simTime)
+{
+  auto msgType = this->iter->Type();
+
+  if (msgType == "ignition.msgs.Pose_V")
+  {
+    return this->ApplyMsgIfDue<msgs::Pose_V>(_ecm, _simTime);
+  }
+  else if (msgType == "ignition.msgs.SerializedState")
+  {
+    return this->ApplyMsgIfDue<msgs::SerializedState>(_ecm, _simTime);
+  }
+  else if (msgType == "ignition.msgs.SerializedStateMap")
+  {
+    return this->ApplyMsgIfDue<msgs::SerializedStateMap>(_ecm, _simTime);
   }
   else if (msgType == "ignition.msgs.StringMsg")
   {
     // Do nothing, we assume this is the SDF string
-    ++(this->dataPtr->iter);
   }
   else
   {
     ignwarn << "Trying to playback unsupported message type ["
             << msgType << "]" << std::endl;
-    ++(this->dataPtr->iter);
   }
+  return true;
 }
 
 IGNITION_ADD_PLUGIN(ignition::gazebo::systems::LogPlayback,
@@ -35,6 +35,7 @@
 
 #include <sdf/World.hh>
 
+#include "ignition/gazebo/Conversions.hh"
 #include "ignition/gazebo/components/Light.hh"
 #include "ignition/gazebo/components/Link.hh"
 #include "ignition/gazebo/components/Model.hh"
@@ -89,6 +90,17 @@ class ignition::gazebo::systems::LogRecordPrivate
   /// \brief Publisher for state changes
   public: transport::Node::Publisher statePub;
 
+  /// \brief Publisher for periodic full state snapshots (keyframes)
+  public: transport::Node::Publisher keyframePub;
+
+  /// \brief Sim time period between keyframes. Zero disables keyframes.
+  public: std::chrono::steady_clock::duration keyframePeriod{
+      std::chrono::seconds(5)};
+
+  /// \brief Sim time of the last keyframe published, or a negative duration
+  /// if none has been published yet.
+  public: std::chrono::steady_clock::duration lastKeyframeTime{-1};
+
   /// \brief Message holding SDF string of world
   public: msgs::StringMsg sdfMsg;
 
@@ -140,6 +152,20 @@ void LogRecord::Configure(const Entity &_entity,
   // Get directory paths from SDF params
   auto logPath = _sdf->Get<std::string>("path");
 
+  if (_sdf->HasElement("keyframe_period"))
+  {
+    auto period = _sdf->Get<double>("keyframe_period");
+    if (period < 0)
+    {
+      ignwarn << "Negative <keyframe_period> [" << period << "], "
+        << "keyframes will not be recorded.\n";
+      period = 0;
+    }
+    this->dataPtr->keyframePeriod =
+        std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(period));
+  }
+
   this->dataPtr->worldName = _ecm.Component<components::Name>(_entity)->Data();
 
   // If plugin is specified in both the SDF tag and on command line, only
@@ -210,6 +236,11 @@ bool LogRecordPrivate::Start(const std::string &_logPath)
   std::string stateTopic = "/world/" + this->worldName + "/changed_state";
   this->statePub = this->node.Advertise<msgs::SerializedStateMap>(stateTopic);
 
+  // Full state snapshots, which playback uses as seek points
+  std::string keyframeTopic = "/world/" + this->worldName + "/state_keyframe";
+  this->keyframePub =
+      this->node.Advertise<msgs::SerializedStateMap>(keyframeTopic);
+
   // Append file name
   std::string dbPath = common::joinPaths(logPath, "state.tlog");
   ignmsg << "Recording to log file [" << dbPath << "]" << std::endl;
@@ -219,6 +250,8 @@ bool LogRecordPrivate::Start(const std::string &_logPath)
   this->recorder.AddTopic("/world/" + this->worldName + "/dynamic_pose/info");
   this->recorder.AddTopic(sdfTopic);
   this->recorder.AddTopic(stateTopic);
+  if (this->keyframePeriod.count() > 0)
+    this->recorder.AddTopic(keyframeTopic);
   // this->recorder.AddTopic(std::regex(".*"));
 
   // Timestamp messages with sim time from clock topic
@@ -240,7 +273,7 @@ bool LogRecordPrivate::Start(const std::string &_logPath)
 }
 
 //////////////////////////////////////////////////
-void LogRecord::PostUpdate(const UpdateInfo &,
+void LogRecord::PostUpdate(const UpdateInfo &_info,
     const EntityComponentManager &_ecm)
 {
   IGN_PROFILE("LogRecord::PostUpdate");
@@ -251,16 +284,32 @@ void LogRecord::PostUpdate(const UpdateInfo &,
     this->dataPtr->sdfPublished = true;
   }
 
+  // Periodically store the complete state, so playback can seek to any time
+  // by applying the closest preceding keyframe plus the changes after it.
+  if (this->dataPtr->keyframePeriod.count() > 0 &&
+      (this->dataPtr->lastKeyframeTime.count() < 0 ||
+       _info.simTime < this->dataPtr->lastKeyframeTime ||
+       _info.simTime - this->dataPtr->lastKeyframeTime >=
+       this->dataPtr->keyframePeriod))
+  {
+    msgs::SerializedStateMap keyframeMsg;
+    _ecm.State(keyframeMsg, {}, {}, true);
+    keyframeMsg.mutable_header()->mutable_stamp()->CopyFrom(
+        gazebo::convert<msgs::Time>(_info.simTime));
+    this->dataPtr->keyframePub.Publish(keyframeMsg);
+    this->dataPtr->lastKeyframeTime = _info.simTime;
+  }
+
   // TODO(louise) Use the SceneBroadcaster's topic once that publishes
   // the changed state
-  // \todo(anyone) A potential enhancement here is have a keyframe mechanism
-  // to store complete state periodically, and then store incremental from
-  // that. It would reduce some of the compute on replaying
-  // (especially in tools like plotting or seeking through logs).
   msgs::SerializedStateMap stateMsg;
   _ecm.ChangedState(stateMsg);
   if (!stateMsg.entities().empty())
+  {
+    stateMsg.mutable_header()->mutable_stamp()->CopyFrom(
+        gazebo::convert<msgs::Time>(_info.simTime));
     this->dataPtr->statePub.Publish(stateMsg);
+  }
 }
 
 IGNITION_ADD_PLUGIN(ignition::gazebo::systems::LogRecord,
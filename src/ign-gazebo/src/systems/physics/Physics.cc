@@ -462,8 +462,32 @@ void PhysicsPrivate::CreatePhysicsEntities(const EntityComponentManager &_ecm)
             return true;
           }
 
+          // <convex_decomposition> inside <mesh> replaces the mesh by a set
+          // of convex hulls, which collide faster and more robustly, and
+          // <simplify> by a copy with fewer triangles
           auto &meshManager = *ignition::common::MeshManager::Instance();
-          auto *mesh = meshManager.Load(meshSdf->Uri());
+          const ignition::common::Mesh *mesh{nullptr};
+          auto meshElem = meshSdf->Element();
+          if (meshElem && meshElem->HasElement("convex_decomposition"))
+          {
+            auto decompositionElem =
+                meshElem->GetElement("convex_decomposition");
+            unsigned int maxConvexHulls = decompositionElem->Get<unsigned int>(
+                "max_convex_hulls", 16u).first;
+            mesh = meshManager.LoadConvexDecomposition(meshSdf->Uri(),
+                maxConvexHulls);
+          }
+          else if (meshElem && meshElem->HasElement("simplify"))
+          {
+            auto simplifyElem = meshElem->GetElement("simplify");
+            unsigned int maxTriangles = simplifyElem->Get<unsigned int>(
+                "max_triangles", 10000u).first;
+            mesh = meshManager.LoadSimplified(meshSdf->Uri(), maxTriangles);
+          }
+          else
+          {
+            mesh = meshManager.Load(meshSdf->Uri());
+          }
           if (nullptr == mesh)
           {
             ignwarn << "Failed to load mesh from [" << meshSdf->Uri()
@@ -819,8 +843,9 @@ void PhysicsPrivate::UpdateSim(EntityComponentManager &_ecm) const
           // creation
           if (!parentPose)
           {
-            ignerr << "The pose component of " << _parent->Data()
-                   << " could not be found. This should never happen!\n";
+            ignerrThrottle(1.0) << "The pose component of "
+                << _parent->Data()
+                << " could not be found. This should never happen!\n";
             return true;
           }
           if (canonicalLink)
@@ -983,7 +1008,9 @@ void PhysicsPrivate::UpdateSim(EntityComponentManager &_ecm) const
         }
         else
         {
-          ignwarn << "Unknown link with id " << _entity << " found\n";
+          // Logged at most once a second, since this is checked every step
+          ignwarnThrottle(1.0) << "Unknown link with id " << _entity
+              << " found\n";
         }
         return true;
       });
@@ -25,6 +25,7 @@
 #include <ignition/plugin/Register.hh>
 #include <ignition/transport/Node.hh>
 
+#include "ignition/gazebo/components/Actor.hh"
 #include "ignition/gazebo/components/Geometry.hh"
 #include "ignition/gazebo/components/Light.hh"
 #include "ignition/gazebo/components/Link.hh"
@@ -277,7 +278,8 @@ void SceneBroadcaster::PostUpdate(const UpdateInfo &_info,
     {
       IGN_PROFILE("SceneBroadcast::PostUpdate UpdateState");
       _manager.State(*this->dataPtr->stepMsg.mutable_state(),
-          {}, {components::Pose::typeId});
+          {}, {components::Pose::typeId, components::ActorPose::typeId,
+          components::ActorBoneTransforms::typeId});
     }
 
     // Full state on demand
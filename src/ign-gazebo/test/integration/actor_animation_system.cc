@@ -0,0 +1,176 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <string>
+
+#include <ignition/common/Console.hh>
+#include <ignition/math/Pose3.hh>
+
+#include "ignition/gazebo/components/Actor.hh"
+#include "ignition/gazebo/components/Name.hh"
+#include "ignition/gazebo/Server.hh"
+#include "ignition/gazebo/SystemLoader.hh"
+#include "ignition/gazebo/test_config.hh"
+
+#include "plugins/MockSystem.hh"
+
+using namespace ignition;
+using namespace gazebo;
+
+/// \brief Test ActorAnimation system
+class ActorAnimationTest : public ::testing::Test
+{
+  // Documentation inherited
+  protected: void SetUp() override
+  {
+    common::Console::SetVerbosity(4);
+    setenv("IGN_GAZEBO_SYSTEM_PLUGIN_PATH",
+           (std::string(PROJECT_BINARY_PATH) + "/lib").c_str(), 1);
+  }
+};
+
+class Relay
+{
+  public: Relay()
+  {
+    auto plugin = loader.LoadPlugin("libMockSystem.so",
+                                "ignition::gazebo::MockSystem",
+                                nullptr);
+    EXPECT_TRUE(plugin.has_value());
+
+    this->systemPtr = plugin.value();
+
+    this->mockSystem =
+        dynamic_cast<MockSystem *>(systemPtr->QueryInterface<System>());
+    EXPECT_NE(nullptr, this->mockSystem);
+  }
+
+  public: Relay &OnPostUpdate(MockSystem::CallbackTypeConst _cb)
+  {
+    this->mockSystem->postUpdateCallback = std::move(_cb);
+    return *this;
+  }
+
+  public: SystemPluginPtr systemPtr;
+
+  private: SystemLoader loader;
+  private: MockSystem *mockSystem;
+};
+
+/////////////////////////////////////////////////
+/// \brief Get a world with two actors using the same skin, one that walks
+/// along a trajectory and one that is animated in place.
+/// \return The world SDF.
+std::string actorWorld()
+{
+  const std::string skin = std::string(PROJECT_SOURCE_PATH) +
+      "/test/media/box_with_animation.dae";
+
+  return std::string(R"(
+<?xml version="1.0" ?>
+<sdf version="1.6">
+  <world name="actors">
+    <plugin
+      filename="libignition-gazebo-actor-animation-system.so"
+      name="ignition::gazebo::systems::ActorAnimation">
+    </plugin>
+    <actor name="walker">
+      <skin>
+        <filename>)") + skin + R"(</filename>
+      </skin>
+      <script>
+        <loop>true</loop>
+        <trajectory id="0" type="walk">
+          <waypoint>
+            <time>0</time>
+            <pose>0 0 0 0 0 0</pose>
+          </waypoint>
+          <waypoint>
+            <time>1</time>
+            <pose>1 0 0 0 0 0</pose>
+          </waypoint>
+        </trajectory>
+      </script>
+    </actor>
+    <actor name="in_place">
+      <skin>
+        <filename>)" + skin + R"(</filename>
+      </skin>
+    </actor>
+  </world>
+</sdf>)";
+}
+
+/////////////////////////////////////////////////
+TEST_F(ActorAnimationTest, PoseAndBones)
+{
+  ServerConfig serverConfig;
+  serverConfig.SetSdfString(actorWorld());
+
+  Server server(serverConfig);
+  EXPECT_FALSE(server.Running());
+
+  std::map<std::string, math::Pose3d> poses;
+  std::map<std::string, std::map<std::string, math::Matrix4d>> bones;
+
+  Relay testSystem;
+  testSystem.OnPostUpdate([&](const gazebo::UpdateInfo &,
+                              const gazebo::EntityComponentManager &_ecm)
+      {
+        _ecm.Each<components::Actor, components::Name,
+                  components::ActorPose, components::ActorBoneTransforms>(
+            [&](const ignition::gazebo::Entity &,
+                const components::Actor *,
+                const components::Name *_name,
+                const components::ActorPose *_pose,
+                const components::ActorBoneTransforms *_bones) -> bool
+            {
+              poses[_name->Data()] = _pose->Data();
+              bones[_name->Data()] = _bones->Data();
+              return true;
+            });
+      });
+  server.AddSystem(testSystem.systemPtr);
+
+  // Halfway through the trajectory
+  server.Run(true, 500, false);
+
+  ASSERT_EQ(2u, poses.size());
+  ASSERT_EQ(2u, bones.size());
+
+  EXPECT_NEAR(0.5, poses["walker"].Pos().X(), 0.01);
+  EXPECT_NEAR(0.0, poses["walker"].Pos().Y(), 1e-6);
+
+  // Animated in place, the actor follows the root bone
+  EXPECT_NEAR(-1.0, poses["in_place"].Pos().Y(), 1e-6);
+  EXPECT_EQ(math::Quaterniond::Identity, poses["in_place"].Rot());
+
+  // The root bone translation is carried by the actor pose
+  for (auto &[name, actorBones] : bones)
+  {
+    ASSERT_EQ(1u, actorBones.count("Armature")) << name;
+    EXPECT_EQ(math::Vector3d::Zero, actorBones["Armature"].Translation())
+        << name;
+  }
+
+  // Past the end of the trajectory, it loops
+  server.Run(true, 1000, false);
+  EXPECT_NEAR(0.5, poses["walker"].Pos().X(), 0.01);
+}
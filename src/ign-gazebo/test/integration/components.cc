@@ -109,6 +109,35 @@ TEST_F(ComponentsTest, Actor)
   EXPECT_EQ(ignition::math::Pose3d(3, 2, 1, 0, 0, 0), comp3.Data().Pose());
 }
 
+/////////////////////////////////////////////////
+TEST_F(ComponentsTest, ActorBoneTransforms)
+{
+  std::map<std::string, math::Matrix4d> data1;
+  data1["root"] = math::Matrix4d(math::Pose3d(1, 2, 3, 0, 0, 0.5));
+  data1["arm"] = math::Matrix4d(math::Pose3d(0, 1, 0, 0.1, 0.2, 0.3));
+
+  // Create components
+  auto comp1 = components::ActorBoneTransforms(data1);
+
+  // Stream operators
+  std::ostringstream ostr;
+  comp1.Serialize(ostr);
+  std::istringstream istr(ostr.str());
+  components::ActorBoneTransforms comp2;
+  comp2.Deserialize(istr);
+  ASSERT_EQ(2u, comp2.Data().size());
+  EXPECT_EQ(data1["root"], comp2.Data()["root"]);
+  EXPECT_EQ(data1["arm"], comp2.Data()["arm"]);
+
+  auto pose = components::ActorPose(math::Pose3d(1, 2, 3, 0, 0, 0.5));
+  std::ostringstream poseOstr;
+  pose.Serialize(poseOstr);
+  std::istringstream poseIstr(poseOstr.str());
+  components::ActorPose pose2;
+  pose2.Deserialize(poseIstr);
+  EXPECT_EQ(math::Pose3d(1, 2, 3, 0, 0, 0.5), pose2.Data());
+}
+
 /////////////////////////////////////////////////
 TEST_F(ComponentsTest, AirPressureSensor)
 {
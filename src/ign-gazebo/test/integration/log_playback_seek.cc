@@ -0,0 +1,294 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <ignition/msgs/pose_v.pb.h>
+#include <ignition/msgs/serialized_map.pb.h>
+
+#include <chrono>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+
+#include <ignition/common/Console.hh>
+#include <ignition/common/Filesystem.hh>
+#include <ignition/math/Pose3.hh>
+#include <ignition/msgs/Utility.hh>
+#include <ignition/transport/log/Batch.hh>
+#include <ignition/transport/log/Log.hh>
+#include <ignition/transport/log/MsgIter.hh>
+#include <ignition/transport/log/QueryOptions.hh>
+
+#include <sdf/Element.hh>
+#include <sdf/Root.hh>
+#include <sdf/World.hh>
+
+#include "ignition/gazebo/Conversions.hh"
+#include "ignition/gazebo/EntityComponentManager.hh"
+#include "ignition/gazebo/EventManager.hh"
+#include "ignition/gazebo/Server.hh"
+#include "ignition/gazebo/ServerConfig.hh"
+#include "ignition/gazebo/System.hh"
+#include "ignition/gazebo/SystemLoader.hh"
+#include "ignition/gazebo/Types.hh"
+#include "ignition/gazebo/components/Pose.hh"
+#include "ignition/gazebo/test_config.hh"
+
+using namespace ignition;
+using namespace gazebo;
+using namespace std::chrono_literals;
+
+/// \brief Poses of entities, by entity
+using PoseMap = std::map<Entity, math::Pose3d>;
+
+/// \brief ECM exposing the removal of entities, which is done by the
+/// simulation runner between updates.
+class PlaybackEcm : public EntityComponentManager
+{
+  public: void ProcessEntityRemovals()
+  {
+    this->ProcessRemoveEntityRequests();
+  }
+};
+
+/// \brief Plays back a log by updating the LogPlayback system directly, so
+/// that sim time can go backwards and jump forward. Only one playback can be
+/// started per process, which is why these tests don't live in log_system.cc.
+class LogPlaybackSeekTest : public ::testing::Test
+{
+  // Documentation inherited
+  protected: void SetUp() override
+  {
+    common::Console::SetVerbosity(4);
+    setenv("IGN_GAZEBO_SYSTEM_PLUGIN_PATH",
+           (std::string(PROJECT_BINARY_PATH) + "/lib").c_str(), 1);
+
+    if (common::exists(this->logDir))
+      common::removeAll(this->logDir);
+    common::createDirectories(this->logDir);
+  }
+
+  // Documentation inherited
+  protected: void TearDown() override
+  {
+    common::removeAll(this->logDir);
+  }
+
+  /// \brief Record the double pendulum world with a keyframe every 100 ms.
+  /// \param[in] _iterations Number of 1 ms iterations to record.
+  public: void Record(const uint64_t _iterations)
+  {
+    const auto sdfPath = common::joinPaths(std::string(PROJECT_SOURCE_PATH),
+        "test", "worlds", "log_record_dbl_pendulum.sdf");
+    std::ifstream sdfFile(sdfPath);
+    std::stringstream buffer;
+    buffer << sdfFile.rdbuf();
+    std::string sdfString = buffer.str();
+
+    const std::string pathElem = "<path>/tmp/log</path>";
+    auto pos = sdfString.find(pathElem);
+    ASSERT_NE(std::string::npos, pos);
+    sdfString.replace(pos, pathElem.size(), "<path>" + this->logDir +
+        "</path><keyframe_period>0.1</keyframe_period>");
+
+    ServerConfig serverConfig;
+    serverConfig.SetSdfString(sdfString);
+    Server server(serverConfig);
+    server.Run(true, _iterations, false);
+  }
+
+  /// \brief Load and configure the LogPlayback system on the log recorded.
+  public: void StartPlayback()
+  {
+    const auto sdfPath = common::joinPaths(std::string(PROJECT_SOURCE_PATH),
+        "test", "worlds", "log_playback.sdf");
+    ASSERT_TRUE(this->playbackRoot.Load(sdfPath).empty());
+    ASSERT_EQ(1u, this->playbackRoot.WorldCount());
+
+    sdf::ElementPtr pluginElem =
+        this->playbackRoot.WorldByIndex(0)->Element()->GetElement("plugin");
+    while (pluginElem && pluginElem->Get<std::string>("name").find(
+        "LogPlayback") == std::string::npos)
+    {
+      pluginElem = pluginElem->GetNextElement("plugin");
+    }
+    ASSERT_NE(nullptr, pluginElem);
+    pluginElem->GetElement("path")->Set(this->logDir);
+
+    auto plugin = this->systemLoader.LoadPlugin(pluginElem);
+    ASSERT_TRUE(plugin.has_value());
+    this->systemPtr = plugin.value();
+
+    auto configure = this->systemPtr->QueryInterface<ISystemConfigure>();
+    ASSERT_NE(nullptr, configure);
+    configure->Configure(kNullEntity, pluginElem, this->ecm,
+        this->eventManager);
+
+    this->update = this->systemPtr->QueryInterface<ISystemUpdate>();
+    ASSERT_NE(nullptr, this->update);
+  }
+
+  /// \brief Update playback to the given sim time.
+  /// \param[in] _simTime Sim time.
+  public: void Update(const std::chrono::steady_clock::duration &_simTime)
+  {
+    UpdateInfo info;
+    info.simTime = _simTime;
+    info.dt = 1ms;
+    info.iterations = ++this->iterations;
+    info.paused = false;
+    this->update->Update(info, this->ecm);
+    this->ecm.ProcessEntityRemovals();
+  }
+
+  /// \brief Poses of all entities in the ECM.
+  /// \return The poses.
+  public: PoseMap Poses() const
+  {
+    PoseMap poses;
+    this->ecm.Each<components::Pose>(
+        [&](const Entity &_entity, const components::Pose *_pose) -> bool
+        {
+          poses[_entity] = _pose->Data();
+          return true;
+        });
+    return poses;
+  }
+
+  /// \brief Latest recorded pose of each dynamic entity, at or before a time.
+  /// \param[in] _simTime Sim time.
+  /// \return The poses.
+  public: PoseMap RecordedPoses(
+      const std::chrono::steady_clock::duration &_simTime) const
+  {
+    transport::log::Log log;
+    EXPECT_TRUE(log.Open(common::joinPaths(this->logDir, "state.tlog")));
+
+    PoseMap poses;
+    auto batch = log.QueryMessages();
+    for (auto it = batch.begin(); it != batch.end(); ++it)
+    {
+      if (it->Type() != "ignition.msgs.Pose_V")
+        continue;
+
+      msgs::Pose_V msg;
+      msg.ParseFromString(it->Data());
+      if (convert<std::chrono::steady_clock::duration>(msg.header().stamp()) >
+          _simTime)
+      {
+        continue;
+      }
+
+      for (int i = 0; i < msg.pose_size(); ++i)
+        poses[msg.pose(i).id()] = msgs::Convert(msg.pose(i));
+    }
+    return poses;
+  }
+
+  /// \brief Directory of the recorded log
+  public: std::string logDir = common::joinPaths(PROJECT_BINARY_PATH, "test",
+      "test_logs_seek");
+
+  /// \brief Playback world, which owns the plugin element
+  public: sdf::Root playbackRoot;
+
+  /// \brief ECM played back into
+  public: PlaybackEcm ecm;
+
+  /// \brief Event manager passed to the system
+  public: EventManager eventManager;
+
+  /// \brief Loads the system
+  public: SystemLoader systemLoader;
+
+  /// \brief The LogPlayback system
+  public: SystemPluginPtr systemPtr;
+
+  /// \brief Update interface of the system
+  public: ISystemUpdate *update{nullptr};
+
+  /// \brief Number of updates so far
+  public: uint64_t iterations{0};
+};
+
+/////////////////////////////////////////////////
+TEST_F(LogPlaybackSeekTest, SeekAndMultipleMessagesPerUpdate)
+{
+  this->Record(1000);
+  this->StartPlayback();
+
+  // Starts at the first keyframe, which holds the whole world
+  const auto keyframeEntityCount = this->ecm.EntityCount();
+  EXPECT_EQ(28u, keyframeEntityCount);
+
+  // Play every millisecond, keeping the state at a few times as reference
+  std::map<std::chrono::milliseconds, PoseMap> reference;
+  const std::chrono::milliseconds rewindTime{350};
+  const std::chrono::milliseconds multiTime{420};
+  const std::chrono::milliseconds spawnTime{500};
+  const std::chrono::milliseconds forwardTime{750};
+
+  const Entity spawned{1000};
+  for (std::chrono::milliseconds t{1}; t <= forwardTime; ++t)
+  {
+    this->Update(t);
+    if (t == rewindTime || t == multiTime || t == forwardTime)
+      reference[t] = this->Poses();
+
+    // Stands for an entity created by a logged state message after the
+    // keyframe before rewindTime
+    if (t == spawnTime)
+    {
+      msgs::SerializedStateMap spawnMsg;
+      (*spawnMsg.mutable_entities())[spawned].set_id(spawned);
+      this->ecm.SetState(spawnMsg);
+    }
+  }
+  EXPECT_EQ(keyframeEntityCount + 1, this->ecm.EntityCount());
+
+  // The reference matches the recorded poses of the dynamic entities, which
+  // move between the reference times
+  for (const auto &[t, poses] : reference)
+  {
+    auto recorded = this->RecordedPoses(t);
+    EXPECT_EQ(4u, recorded.size());
+    for (const auto &[entity, pose] : recorded)
+    {
+      ASSERT_NE(poses.end(), poses.find(entity));
+      EXPECT_EQ(pose, poses.at(entity));
+    }
+  }
+  EXPECT_NE(reference[rewindTime], reference[forwardTime]);
+
+  // Rewind: loads the keyframe before rewindTime, removing the entity created
+  // after it, and applies the messages up to rewindTime within this update
+  this->Update(rewindTime);
+  EXPECT_FALSE(this->ecm.HasEntity(spawned));
+  EXPECT_EQ(keyframeEntityCount, this->ecm.EntityCount());
+  EXPECT_EQ(reference[rewindTime], this->Poses());
+
+  // Less than a keyframe interval later: no seek, several messages are
+  // applied within this update
+  this->Update(multiTime);
+  EXPECT_EQ(reference[multiTime], this->Poses());
+
+  // Seek forward over several keyframes
+  this->Update(forwardTime);
+  EXPECT_EQ(keyframeEntityCount, this->ecm.EntityCount());
+  EXPECT_EQ(reference[forwardTime], this->Poses());
+}
@@ -19,6 +19,7 @@
 #include <ignition/msgs/pose_v.pb.h>
 
 #include <climits>
+#include <set>
 #include <string>
 
 #include <ignition/common/Console.hh>
@@ -28,6 +29,7 @@
 #include <ignition/transport/log/Log.hh>
 #include <ignition/transport/log/MsgIter.hh>
 #include <ignition/transport/log/QualifiedTime.hh>
+#include <ignition/transport/log/QueryOptions.hh>
 #include <ignition/math/Pose3.hh>
 
 #include <sdf/Root.hh>
@@ -164,7 +166,29 @@ TEST_F(LogSystemTest, RecordAndPlayback)
   // Load log file recorded above
   transport::log::Log log;
   log.Open(logPlaybackFile);
-  auto batch = log.QueryMessages();
+
+  // Check keyframes, which are full state snapshots
+  const std::string keyframeTopic = "/world/log_pendulum/state_keyframe";
+  auto keyframeBatch = log.QueryMessages(
+      transport::log::TopicList(keyframeTopic));
+  auto keyframeIter = keyframeBatch.begin();
+  ASSERT_NE(keyframeBatch.end(), keyframeIter);
+  EXPECT_EQ("ignition.msgs.SerializedStateMap", keyframeIter->Type());
+  {
+    msgs::SerializedStateMap keyframeMsg;
+    keyframeMsg.ParseFromString(keyframeIter->Data());
+    EXPECT_TRUE(keyframeMsg.has_header());
+    EXPECT_EQ(28, keyframeMsg.entities_size());
+  }
+
+  // All other messages
+  std::set<std::string> topics;
+  for (const auto &topicEntry : log.Descriptor()->TopicsToMsgTypesToId())
+  {
+    if (topicEntry.first != keyframeTopic)
+      topics.insert(topicEntry.first);
+  }
+  auto batch = log.QueryMessages(transport::log::TopicList::Create(topics));
 
   // Pass changed SDF to server
   ServerConfig playServerConfig;
@@ -18,9 +18,15 @@
 #include <gtest/gtest.h>
 
 #include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <string>
 #include <vector>
 
 #include <ignition/common/Console.hh>
+#include <ignition/common/ConvexDecomposition.hh>
+#include <ignition/common/Mesh.hh>
+#include <ignition/common/MeshManager.hh>
 #include <sdf/Collision.hh>
 #include <sdf/Cylinder.hh>
 #include <sdf/Geometry.hh>
@@ -591,3 +597,79 @@ TEST_F(PhysicsSystemFixture, MultiAxisJointPosition)
     EXPECT_EQ(jDof, jointPosDof[jName]) << jName;
   }
 }
+
+/////////////////////////////////////////////////
+/// Test that a mesh collision with <convex_decomposition> collides with the
+/// convex hulls of the mesh
+TEST_F(PhysicsSystemFixture, ConvexDecomposition)
+{
+  std::ifstream sdfFile(std::string(PROJECT_SOURCE_PATH) +
+    "/test/worlds/convex_decomposition.sdf");
+  std::stringstream buffer;
+  buffer << sdfFile.rdbuf();
+  std::string sdfString = buffer.str();
+
+  // Use the absolute path of the mesh
+  const std::string uriElem = "file://test/media/duck_collider.dae";
+  const std::string meshPath = std::string(PROJECT_SOURCE_PATH) +
+    "/test/media/duck_collider.dae";
+  auto pos = sdfString.find(uriElem);
+  ASSERT_NE(std::string::npos, pos);
+  sdfString.replace(pos, uriElem.size(), meshPath);
+
+  ignition::gazebo::ServerConfig serverConfig;
+  serverConfig.SetSdfString(sdfString);
+
+  gazebo::Server server(serverConfig);
+
+  server.SetUpdatePeriod(1us);
+
+  const std::string modelName = "duck";
+  std::vector<ignition::math::Pose3d> duckPoses;
+
+  // Create a system that records the poses of the duck
+  Relay testSystem;
+
+  testSystem.OnPostUpdate(
+    [modelName, &duckPoses](const gazebo::UpdateInfo &,
+    const gazebo::EntityComponentManager &_ecm)
+    {
+      _ecm.Each<components::Model, components::Name, components::Pose>(
+        [&](const ignition::gazebo::Entity &, const components::Model *,
+        const components::Name *_name, const components::Pose *_pose)->bool
+        {
+          if (_name->Data() == modelName) {
+            duckPoses.push_back(_pose->Data());
+          }
+          return true;
+        });
+    });
+
+  server.AddSystem(testSystem.systemPtr);
+  server.Run(true, 1, false);
+
+  // The collision was created from the decomposition, which the mesh manager
+  // keeps under the name of the mesh followed by the decomposition
+  // parameters
+  common::ConvexDecomposition decomposition;
+  decomposition.SetMaxConvexHulls(4u);
+  auto *meshManager = common::MeshManager::Instance();
+  const std::string hullsName = meshPath + "#" +
+    decomposition.CacheVariant();
+  ASSERT_TRUE(meshManager->HasMesh(hullsName));
+  const common::Mesh *hulls = meshManager->MeshByName(hullsName);
+  ASSERT_NE(nullptr, hulls);
+  EXPECT_GE(hulls->SubMeshCount(), 1u);
+  EXPECT_LE(hulls->SubMeshCount(), 4u);
+
+  // Drop the duck on the plane
+  server.Run(true, 2000, false);
+  ASSERT_GT(duckPoses.size(), 100u);
+
+  // The duck rests on the lowest point of the hulls, which is rotated from Y
+  // to Z by the collision pose
+  const double zStopped = -hulls->Min().Y();
+  EXPECT_NEAR(duckPoses.back().Pos().Z(), zStopped, 2e-2);
+  EXPECT_NEAR(duckPoses[duckPoses.size() - 100].Pos().Z(),
+      duckPoses.back().Pos().Z(), 1e-3);
+}
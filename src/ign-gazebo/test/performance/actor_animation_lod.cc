@@ -0,0 +1,211 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <ctime>
+#include <string>
+
+#include <ignition/common/Console.hh>
+#include <ignition/rendering/Camera.hh>
+#include <ignition/rendering/Scene.hh>
+#include <ignition/rendering/Visual.hh>
+
+#include "ignition/gazebo/Server.hh"
+#include "ignition/gazebo/SystemLoader.hh"
+#include "ignition/gazebo/rendering/RenderUtil.hh"
+#include "ignition/gazebo/test_config.hh"  // NOLINT(build/include)
+
+#include "plugins/MockSystem.hh"
+
+using namespace ignition;
+using namespace gazebo;
+
+/// \brief Number of actors in the world
+static const unsigned int kActorCount = 500;
+
+/// \brief Distance between neighbouring actors
+static const double kActorSpacing = 6.0;
+
+/// \brief Iterations run before measuring, while actors are created
+static const uint64_t kWarmupIterations = 10;
+
+/// \brief Iterations measured
+static const uint64_t kMeasuredIterations = 200;
+
+class Relay
+{
+  public: Relay()
+  {
+    auto plugin = loader.LoadPlugin("libMockSystem.so",
+                                "ignition::gazebo::MockSystem",
+                                nullptr);
+    EXPECT_TRUE(plugin.has_value());
+
+    this->systemPtr = plugin.value();
+
+    this->mockSystem =
+        dynamic_cast<MockSystem *>(systemPtr->QueryInterface<System>());
+    EXPECT_NE(nullptr, this->mockSystem);
+  }
+
+  public: Relay &OnPostUpdate(MockSystem::CallbackTypeConst _cb)
+  {
+    this->mockSystem->postUpdateCallback = std::move(_cb);
+    return *this;
+  }
+
+  public: SystemPluginPtr systemPtr;
+
+  private: SystemLoader loader;
+  private: MockSystem *mockSystem;
+};
+
+/////////////////////////////////////////////////
+/// \brief Get a world with actors walking on a grid around the origin.
+/// \param[in] _lod Content of the actors' <animation_lod> element.
+/// \return The world SDF.
+std::string actorGridWorld(const std::string &_lod)
+{
+  const std::string skin = std::string(PROJECT_SOURCE_PATH) +
+      "/test/media/box_with_animation.dae";
+
+  std::string world = R"(<?xml version="1.0" ?>
+<sdf version="1.6">
+  <world name="actors">)";
+
+  const unsigned int side = 23;
+  for (unsigned int i = 0; i < kActorCount; ++i)
+  {
+    double x = (static_cast<double>(i % side) - side / 2) * kActorSpacing;
+    double y = (static_cast<double>(i / side) - side / 2) * kActorSpacing;
+    std::string start = std::to_string(x) + " " + std::to_string(y);
+    std::string end = std::to_string(x + 2.0) + " " + std::to_string(y);
+
+    world += R"(
+    <actor name="actor_)" + std::to_string(i) + R"(">
+      <skin>
+        <filename>)" + skin + R"(</filename>
+      </skin>
+      <script>
+        <loop>true</loop>
+        <trajectory id="0" type="walk">
+          <waypoint>
+            <time>0</time>
+            <pose>)" + start + R"( 0 0 0 0</pose>
+          </waypoint>
+          <waypoint>
+            <time>2</time>
+            <pose>)" + end + R"( 0 0 0 0</pose>
+          </waypoint>
+        </trajectory>
+      </script>
+      <plugin name="ignition::gazebo" filename="dummy">
+        <animation_lod>)" + _lod + R"(</animation_lod>
+      </plugin>
+    </actor>)";
+  }
+
+  world += R"(
+  </world>
+</sdf>)";
+  return world;
+}
+
+/////////////////////////////////////////////////
+/// \brief Run the actor world, updating a rendering scene with a camera at
+/// its center from the entity component manager at every iteration.
+/// \param[in] _lod Content of the actors' <animation_lod> element.
+/// \param[in] _sceneName Name of the rendering scene, unique per run.
+/// \return Mean CPU time spent updating the scene per iteration, in
+/// milliseconds, or a negative number if the scene couldn't be created.
+double cpuTimePerFrame(const std::string &_lod, const std::string &_sceneName)
+{
+  ServerConfig serverConfig;
+  serverConfig.SetSdfString(actorGridWorld(_lod));
+  Server server(serverConfig);
+
+  RenderUtil renderUtil;
+  renderUtil.SetEngineName("ogre2");
+  renderUtil.SetSceneName(_sceneName);
+  renderUtil.Init();
+
+  auto scene = renderUtil.Scene();
+  if (!scene)
+    return -1.0;
+
+  // Looking along +X, so half of the actors are behind the camera
+  auto camera = scene->CreateCamera("camera");
+  camera->SetLocalPosition(0.0, 0.0, 2.0);
+  camera->SetImageWidth(320);
+  camera->SetImageHeight(240);
+  camera->SetAspectRatio(320.0 / 240.0);
+  camera->SetHFOV(IGN_PI * 0.5);
+  scene->RootVisual()->AddChild(camera);
+
+  std::clock_t cpuTime{0};
+  uint64_t frames{0};
+
+  Relay testSystem;
+  testSystem.OnPostUpdate([&](const UpdateInfo &_info,
+                              const EntityComponentManager &_ecm)
+      {
+        std::clock_t start = std::clock();
+        renderUtil.UpdateFromECM(_info, _ecm);
+        renderUtil.Update();
+        if (_info.iterations > kWarmupIterations)
+        {
+          cpuTime += std::clock() - start;
+          ++frames;
+        }
+      });
+  server.AddSystem(testSystem.systemPtr);
+  server.Run(true, kWarmupIterations + kMeasuredIterations, false);
+
+  if (frames == 0u)
+    return -1.0;
+  return 1000.0 * cpuTime / CLOCKS_PER_SEC / frames;
+}
+
+/////////////////////////////////////////////////
+TEST(ActorAnimationLodPerformance, LodVsFull)
+{
+  common::Console::SetVerbosity(4);
+
+  setenv("IGN_GAZEBO_SYSTEM_PLUGIN_PATH",
+         (std::string(PROJECT_BINARY_PATH) + "/lib").c_str(), 1);
+
+  // Every actor is animated at every iteration
+  const double fullTime = cpuTimePerFrame(
+      "<full_distance>10000</full_distance>"
+      "<reduced_distance>10000</reduced_distance>", "actor_lod_full");
+  ASSERT_GT(fullTime, 0.0);
+
+  // Only actors in front of the camera and close to it are animated at
+  // every iteration
+  const double lodTime = cpuTimePerFrame(
+      "<full_distance>10</full_distance>"
+      "<reduced_distance>30</reduced_distance>"
+      "<reduced_rate>10</reduced_rate>", "actor_lod_reduced");
+  ASSERT_GT(lodTime, 0.0);
+
+  igndbg << "\nCPU time per frame for " << kActorCount << " actors:\n"
+         << "Without level of detail = " << fullTime << " ms\n"
+         << "With level of detail = " << lodTime << " ms\n";
+
+  EXPECT_LT(lodTime, fullTime);
+}
@@ -0,0 +1,178 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_MATH_RANDOMSTREAM_HH_
+#define IGNITION_MATH_RANDOMSTREAM_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <ignition/math/Export.hh>
+#include <ignition/math/config.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+    //
+    /// \class RandomStream RandomStream.hh ignition/math/RandomStream.hh
+    /// \brief A deterministic stream of random numbers, based on the
+    /// counter-based Philox4x32-10 generator.
+    ///
+    /// Unlike Rand, which shares one global generator, each RandomStream is
+    /// an independent object that can be used from its own thread. The n-th
+    /// value of a stream only depends on its seed, its stream id and n, so:
+    /// - Streams with the same seed and different ids are independent. Fork()
+    /// derives such streams, e.g. one per sensor from a world seed.
+    /// - Discard() jumps ahead in constant time.
+    /// - The Fill functions generate many values at once.
+    ///
+    /// RandomStream satisfies the UniformRandomBitGenerator requirements, so
+    /// it can also be used with the distributions of <random>.
+    class IGNITION_MATH_VISIBLE RandomStream
+    {
+      /// \brief Type of the values returned by operator().
+      public: using result_type = uint64_t;
+
+      /// \brief Constructor.
+      /// \param[in] _seed Seed of the stream.
+      /// \param[in] _stream Id of the stream. Streams that share a seed but
+      /// have different ids produce independent values.
+      public: explicit RandomStream(uint64_t _seed = 0u,
+                                    uint64_t _stream = 0u);
+
+      /// \brief Create a new stream with the same seed and a different id,
+      /// derived from the id of this stream and _id. Forking doesn't advance
+      /// this stream, and forking twice with the same _id returns the same
+      /// stream.
+      /// \param[in] _id Id of the child stream, e.g. the index of a sensor.
+      /// \return The new stream, positioned at its beginning.
+      public: RandomStream Fork(uint64_t _id) const;
+
+      /// \brief Get the seed of the stream.
+      /// \return The seed.
+      public: uint64_t Seed() const;
+
+      /// \brief Get the id of the stream.
+      /// \return The stream id.
+      public: uint64_t Stream() const;
+
+      /// \brief Get the number of 64-bit values drawn from the stream since
+      /// its creation.
+      /// \return The position in the stream.
+      public: uint64_t Position() const;
+
+      /// \brief Skip values of the stream. This takes constant time.
+      /// \param[in] _count Number of 64-bit values to skip.
+      public: void Discard(uint64_t _count);
+
+      /// \brief Get the next 64-bit value of the stream.
+      /// \return A uniformly distributed value.
+      public: result_type operator()();
+
+      /// \brief Smallest value returned by operator().
+      /// \return Zero.
+      public: static constexpr result_type min()
+      {
+        return 0u;
+      }
+
+      /// \brief Largest value returned by operator().
+      /// \return The largest 64-bit unsigned integer.
+      public: static constexpr result_type max()
+      {
+        return std::numeric_limits<result_type>::max();
+      }
+
+      /// \brief Get a double from a uniform distribution. Uses one value of
+      /// the stream.
+      /// \param[in] _min Minimum bound for the random number
+      /// \param[in] _max Maximum bound for the random number
+      /// \return A number in [_min, _max).
+      public: double DblUniform(double _min = 0, double _max = 1);
+
+      /// \brief Get a double from a normal distribution. Uses two values of
+      /// the stream.
+      /// \param[in] _mean Mean value for the distribution
+      /// \param[in] _sigma Sigma value for the distribution
+      /// \return The random number.
+      public: double DblNormal(double _mean = 0, double _sigma = 1);
+
+      /// \brief Get an integer from a uniform distribution.
+      /// \param[in] _min Minimum bound for the random number
+      /// \param[in] _max Maximum bound for the random number
+      /// \return A number in [_min, _max].
+      public: int32_t IntUniform(int32_t _min, int32_t _max);
+
+      /// \brief Fill an array with doubles from a uniform distribution. Uses
+      /// _count values of the stream.
+      /// \param[out] _out Output array.
+      /// \param[in] _count Number of values to generate.
+      /// \param[in] _min Minimum bound for the random numbers
+      /// \param[in] _max Maximum bound for the random numbers
+      public: void FillUniform(double *_out, std::size_t _count,
+                               double _min = 0, double _max = 1);
+
+      /// \brief Fill an array with floats from a uniform distribution.
+      /// \param[out] _out Output array.
+      /// \param[in] _count Number of values to generate.
+      /// \param[in] _min Minimum bound for the random numbers
+      /// \param[in] _max Maximum bound for the random numbers
+      /// \sa FillUniform(double *, std::size_t, double, double)
+      public: void FillUniform(float *_out, std::size_t _count,
+                               float _min = 0, float _max = 1);
+
+      /// \brief Fill an array with doubles from a normal distribution, using
+      /// the Box-Muller transform on pairs of values. Uses _count values of
+      /// the stream, rounded up to an even number. The result differs from
+      /// calling DblNormal() _count times.
+      /// \param[out] _out Output array.
+      /// \param[in] _count Number of values to generate.
+      /// \param[in] _mean Mean value for the distribution
+      /// \param[in] _sigma Sigma value for the distribution
+      public: void FillNormal(double *_out, std::size_t _count,
+                              double _mean = 0, double _sigma = 1);
+
+      /// \brief Fill an array with floats from a normal distribution.
+      /// \param[out] _out Output array.
+      /// \param[in] _count Number of values to generate.
+      /// \param[in] _mean Mean value for the distribution
+      /// \param[in] _sigma Sigma value for the distribution
+      /// \sa FillNormal(double *, std::size_t, double, double)
+      public: void FillNormal(float *_out, std::size_t _count,
+                              float _mean = 0, float _sigma = 1);
+
+      /// \brief Seed of the stream.
+      private: uint64_t seed;
+
+      /// \brief Id of the stream.
+      private: uint64_t stream;
+
+      /// \brief Number of values drawn.
+      private: uint64_t position = 0u;
+
+      /// \brief Last block generated, which holds two values.
+      private: uint64_t block[2] = {0u, 0u};
+
+      /// \brief Index of the block stored in 'block'.
+      private: uint64_t blockIndex = std::numeric_limits<uint64_t>::max();
+    };
+    }
+  }
+}
+#endif
@@ -0,0 +1,245 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <cmath>
+#include <utility>
+
+#include "ignition/math/Helpers.hh"
+#include "ignition/math/RandomStream.hh"
+
+using namespace ignition;
+using namespace math;
+
+/// \brief Philox4x32 multipliers.
+static constexpr uint32_t kPhiloxM0 = 0xD2511F53u;
+static constexpr uint32_t kPhiloxM1 = 0xCD9E8D57u;
+
+/// \brief Philox4x32 key increments (golden ratio and sqrt(3) - 1).
+static constexpr uint32_t kPhiloxW0 = 0x9E3779B9u;
+static constexpr uint32_t kPhiloxW1 = 0xBB67AE85u;
+
+/// \brief Scale that maps the 53 most significant bits of a value to [0, 1).
+static constexpr double kToUnit = 1.0 / 9007199254740992.0;
+
+//////////////////////////////////////////////////
+/// \brief Compute one block of the Philox4x32-10 generator.
+/// \param[in] _ctr Counter.
+/// \param[in] _key Key.
+/// \param[out] _out Four 32-bit random values.
+static void philox4x32(const uint32_t _ctr[4], const uint32_t _key[2],
+    uint32_t _out[4])
+{
+  uint32_t c0 = _ctr[0], c1 = _ctr[1], c2 = _ctr[2], c3 = _ctr[3];
+  uint32_t k0 = _key[0], k1 = _key[1];
+
+  for (int round = 0; round < 10; ++round)
+  {
+    const uint64_t p0 = static_cast<uint64_t>(kPhiloxM0) * c0;
+    const uint64_t p1 = static_cast<uint64_t>(kPhiloxM1) * c2;
+
+    c0 = static_cast<uint32_t>(p1 >> 32) ^ c1 ^ k0;
+    c1 = static_cast<uint32_t>(p1);
+    c2 = static_cast<uint32_t>(p0 >> 32) ^ c3 ^ k1;
+    c3 = static_cast<uint32_t>(p0);
+
+    k0 += kPhiloxW0;
+    k1 += kPhiloxW1;
+  }
+
+  _out[0] = c0;
+  _out[1] = c1;
+  _out[2] = c2;
+  _out[3] = c3;
+}
+
+//////////////////////////////////////////////////
+/// \brief SplitMix64 mixing function, used to derive stream ids.
+/// \param[in] _x Value to mix.
+/// \return Mixed value.
+static uint64_t splitMix64(uint64_t _x)
+{
+  _x += 0x9E3779B97F4A7C15ull;
+  _x = (_x ^ (_x >> 30)) * 0xBF58476D1CE4E5B9ull;
+  _x = (_x ^ (_x >> 27)) * 0x94D049BB133111EBull;
+  return _x ^ (_x >> 31);
+}
+
+//////////////////////////////////////////////////
+RandomStream::RandomStream(uint64_t _seed, uint64_t _stream)
+  : seed(_seed), stream(_stream)
+{
+}
+
+//////////////////////////////////////////////////
+RandomStream RandomStream::Fork(uint64_t _id) const
+{
+  return RandomStream(this->seed, splitMix64(this->stream ^ splitMix64(_id)));
+}
+
+//////////////////////////////////////////////////
+uint64_t RandomStream::Seed() const
+{
+  return this->seed;
+}
+
+//////////////////////////////////////////////////
+uint64_t RandomStream::Stream() const
+{
+  return this->stream;
+}
+
+//////////////////////////////////////////////////
+uint64_t RandomStream::Position() const
+{
+  return this->position;
+}
+
+//////////////////////////////////////////////////
+void RandomStream::Discard(uint64_t _count)
+{
+  this->position += _count;
+}
+
+//////////////////////////////////////////////////
+RandomStream::result_type RandomStream::operator()()
+{
+  // Each Philox block holds two 64-bit values. The block index is the low
+  // half of the counter and the stream id the high half.
+  const uint64_t index = this->position / 2u;
+  if (index != this->blockIndex)
+  {
+    const uint32_t ctr[4] = {
+      static_cast<uint32_t>(index), static_cast<uint32_t>(index >> 32),
+      static_cast<uint32_t>(this->stream),
+      static_cast<uint32_t>(this->stream >> 32)};
+    const uint32_t key[2] = {
+      static_cast<uint32_t>(this->seed),
+      static_cast<uint32_t>(this->seed >> 32)};
+
+    uint32_t out[4];
+    philox4x32(ctr, key, out);
+    this->block[0] = (static_cast<uint64_t>(out[1]) << 32) | out[0];
+    this->block[1] = (static_cast<uint64_t>(out[3]) << 32) | out[2];
+    this->blockIndex = index;
+  }
+
+  return this->block[this->position++ % 2u];
+}
+
+//////////////////////////////////////////////////
+double RandomStream::DblUniform(double _min, double _max)
+{
+  return _min + (_max - _min) * (((*this)() >> 11) * kToUnit);
+}
+
+//////////////////////////////////////////////////
+double RandomStream::DblNormal(double _mean, double _sigma)
+{
+  // Box-Muller transform. The first uniform is in (0, 1] to avoid log(0).
+  const double u1 = (((*this)() >> 11) + 1u) * kToUnit;
+  const double u2 = ((*this)() >> 11) * kToUnit;
+  return _mean + _sigma *
+    std::sqrt(-2.0 * std::log(u1)) * std::cos(2.0 * IGN_PI * u2);
+}
+
+//////////////////////////////////////////////////
+int32_t RandomStream::IntUniform(int32_t _min, int32_t _max)
+{
+  if (_min > _max)
+    std::swap(_min, _max);
+
+  const uint64_t range = static_cast<uint64_t>(
+      static_cast<int64_t>(_max) - static_cast<int64_t>(_min)) + 1u;
+
+  // Reject the lowest values so that every residue is equally likely.
+  const uint64_t threshold = (0u - range) % range;
+  uint64_t value;
+  do
+  {
+    value = (*this)();
+  } while (value < threshold);
+
+  return static_cast<int32_t>(
+      static_cast<int64_t>(_min) + static_cast<int64_t>(value % range));
+}
+
+//////////////////////////////////////////////////
+/// \brief Fill an array with uniform values.
+/// \param[in,out] _stream Random stream.
+/// \param[out] _out Output array.
+/// \param[in] _count Number of values.
+/// \param[in] _min Minimum bound.
+/// \param[in] _max Maximum bound.
+template<typename T>
+static void fillUniform(RandomStream &_stream, T *_out, std::size_t _count,
+    T _min, T _max)
+{
+  const double scale = (static_cast<double>(_max) - _min) * kToUnit;
+  for (std::size_t i = 0; i < _count; ++i)
+    _out[i] = static_cast<T>(_min + scale * (_stream() >> 11));
+}
+
+//////////////////////////////////////////////////
+/// \brief Fill an array with normally distributed values.
+/// \param[in,out] _stream Random stream.
+/// \param[out] _out Output array.
+/// \param[in] _count Number of values.
+/// \param[in] _mean Mean value.
+/// \param[in] _sigma Sigma value.
+template<typename T>
+static void fillNormal(RandomStream &_stream, T *_out, std::size_t _count,
+    T _mean, T _sigma)
+{
+  for (std::size_t i = 0; i < _count; i += 2u)
+  {
+    const double u1 = ((_stream() >> 11) + 1u) * kToUnit;
+    const double u2 = (_stream() >> 11) * kToUnit;
+    const double radius = _sigma * std::sqrt(-2.0 * std::log(u1));
+    const double angle = 2.0 * IGN_PI * u2;
+
+    _out[i] = static_cast<T>(_mean + radius * std::cos(angle));
+    if (i + 1u < _count)
+      _out[i + 1u] = static_cast<T>(_mean + radius * std::sin(angle));
+  }
+}
+
+//////////////////////////////////////////////////
+void RandomStream::FillUniform(double *_out, std::size_t _count,
+    double _min, double _max)
+{
+  fillUniform(*this, _out, _count, _min, _max);
+}
+
+//////////////////////////////////////////////////
+void RandomStream::FillUniform(float *_out, std::size_t _count,
+    float _min, float _max)
+{
+  fillUniform(*this, _out, _count, _min, _max);
+}
+
+//////////////////////////////////////////////////
+void RandomStream::FillNormal(double *_out, std::size_t _count,
+    double _mean, double _sigma)
+{
+  fillNormal(*this, _out, _count, _mean, _sigma);
+}
+
+//////////////////////////////////////////////////
+void RandomStream::FillNormal(float *_out, std::size_t _count,
+    float _mean, float _sigma)
+{
+  fillNormal(*this, _out, _count, _mean, _sigma);
+}
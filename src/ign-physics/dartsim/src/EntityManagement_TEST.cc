@@ -15,10 +15,16 @@
  *
 */
 
+#include <dart/dynamics/BodyNode.hpp>
+#include <dart/dynamics/MeshShape.hpp>
+
 #include <gtest/gtest.h>
 
+#include <string>
+
 #include <ignition/plugin/Loader.hh>
 
+#include <ignition/common/Mesh.hh>
 #include <ignition/common/MeshManager.hh>
 
 #include <ignition/math/eigen3/Conversions.hh>
@@ -27,6 +33,8 @@
 #include <ignition/physics/RequestEngine.hh>
 #include <ignition/physics/RevoluteJoint.hh>
 
+#include <ignition/physics/dartsim/World.hh>
+
 #include "EntityManagementFeatures.hh"
 #include "JointFeatures.hh"
 #include "KinematicsFeatures.hh"
@@ -36,7 +44,8 @@ using TestFeatureList = ignition::physics::FeatureList<
   ignition::physics::dartsim::EntityManagementFeatureList,
   ignition::physics::dartsim::JointFeatureList,
   ignition::physics::dartsim::KinematicsFeatureList,
-  ignition::physics::dartsim::ShapeFeatureList
+  ignition::physics::dartsim::ShapeFeatureList,
+  ignition::physics::dartsim::RetrieveWorld
 >;
 
 TEST(EntityManagement_TEST, ConstructEmptyWorld)
@@ -221,6 +230,96 @@ TEST(EntityManagement_TEST, RemoveEntities)
   EXPECT_EQ(0ul, world->GetModelCount());
 }
 
+/// \brief Count the triangles of a dartsim mesh shape.
+/// \param[in] _shape The shape.
+/// \return Number of triangles of all the meshes of the shape.
+unsigned int TriangleCount(const dart::dynamics::MeshShape &_shape)
+{
+  unsigned int count = 0u;
+  const aiScene *scene = _shape.getMesh();
+  for (unsigned int i = 0; i < scene->mNumMeshes; ++i)
+  {
+    const aiMesh *mesh = scene->mMeshes[i];
+    if (nullptr == mesh)
+      continue;
+
+    for (unsigned int j = 0; j < mesh->mNumFaces; ++j)
+    {
+      if (3u == mesh->mFaces[j].mNumIndices)
+        ++count;
+    }
+  }
+  return count;
+}
+
+TEST(EntityManagement_TEST, SimplifiedMeshShape)
+{
+  ignition::plugin::Loader loader;
+  loader.LoadLib(dartsim_plugin_LIB);
+
+  ignition::plugin::PluginPtr dartsim =
+      loader.Instantiate("ignition::physics::dartsim::Plugin");
+
+  auto engine =
+      ignition::physics::RequestEngine3d<TestFeatureList>::From(dartsim);
+  ASSERT_NE(nullptr, engine);
+
+  auto world = engine->ConstructEmptyWorld("mesh world");
+  auto model = world->ConstructEmptyModel("mesh model");
+  auto link = model->ConstructEmptyLink("mesh_link");
+
+  const std::string meshFilename = IGNITION_PHYSICS_RESOURCE_DIR "/chassis.dae";
+  auto &meshManager = *ignition::common::MeshManager::Instance();
+  const auto *mesh = meshManager.Load(meshFilename);
+  ASSERT_NE(nullptr, mesh);
+
+  const unsigned int maxTriangles = 500u;
+  const auto *simplified = meshManager.LoadSimplified(meshFilename,
+      maxTriangles);
+  ASSERT_NE(nullptr, simplified);
+  ASSERT_NE(mesh, simplified);
+
+  auto meshShape = link->AttachMeshShape("chassis", *mesh);
+  auto simplifiedShape = link->AttachMeshShape("simplified_chassis",
+      *simplified);
+
+  const dart::dynamics::BodyNode *bn =
+      world->GetDartsimWorld()->getSkeleton("mesh model")->getBodyNode(
+      "mesh_link");
+  ASSERT_NE(nullptr, bn);
+  ASSERT_EQ(2u, bn->getNumShapeNodes());
+  const auto *dartMesh = dynamic_cast<const dart::dynamics::MeshShape *>(
+      bn->getShapeNode(0)->getShape().get());
+  const auto *dartSimplified =
+      dynamic_cast<const dart::dynamics::MeshShape *>(
+      bn->getShapeNode(1)->getShape().get());
+  ASSERT_NE(nullptr, dartMesh);
+  ASSERT_NE(nullptr, dartSimplified);
+
+  // Meshes are used as they are, only simplified when asked to
+  EXPECT_EQ(mesh->IndexCount() / 3, TriangleCount(*dartMesh));
+
+  // The simplified shape has the triangles of the simplified mesh. Some of
+  // the small submeshes of the chassis can't lose their share of the
+  // triangles without folding, so there are a few more than requested.
+  const unsigned int simplifiedCount = TriangleCount(*dartSimplified);
+  EXPECT_EQ(simplified->IndexCount() / 3, simplifiedCount);
+  EXPECT_NEAR(maxTriangles, simplifiedCount, 0.1 * maxTriangles);
+  EXPECT_LT(simplifiedCount, mesh->IndexCount() / 3);
+
+  // Simplification keeps vertices in place, so the shape keeps the bounds of
+  // the simplified mesh, and about those of the original mesh
+  const auto meshShapeSize = meshShape->GetSize();
+  const auto simplifiedShapeSize = simplifiedShape->GetSize();
+  const auto simplifiedMeshSize = simplified->Max() - simplified->Min();
+  for (std::size_t i = 0; i < 3; ++i)
+  {
+    EXPECT_NEAR(simplifiedMeshSize[i], simplifiedShapeSize[i], 1e-6);
+    EXPECT_LE(simplifiedShapeSize[i], meshShapeSize[i] + 1e-6);
+    EXPECT_NEAR(meshShapeSize[i], simplifiedShapeSize[i], 1e-2);
+  }
+}
+
 int main(int argc, char *argv[])
 {
   ::testing::InitGoogleTest(&argc, argv);
@@ -16,6 +16,7 @@
  */
 
 
+#include <cstring>
 #include <sstream>
 
 #include <ignition/common/Console.hh>
@@ -303,21 +304,49 @@ bool Ogre2MeshFactory::LoadImpl(const MeshDescriptor &_desc)
         }
       }
 
+      // Submeshes stored in single or half precision expose float arrays
+      // which are copied as is, instead of converting every value
+      const float *vertexBuffer = subMesh.VertexBuffer();
+      const float *normalBuffer =
+          subMesh.NormalCount() == subMesh.VertexCount() ?
+          subMesh.NormalBuffer() : nullptr;
+      const float *texCoordBuffer =
+          subMesh.TexCoordCount() == subMesh.VertexCount() ?
+          subMesh.TexCoordBuffer() : nullptr;
+
       // Add all the vertices
       for (unsigned int j = 0; j < subMesh.VertexCount(); ++j)
       {
-        *vertices++ = subMesh.Vertex(j).X();
-        *vertices++ = subMesh.Vertex(j).Y();
-        *vertices++ = subMesh.Vertex(j).Z();
+        if (vertexBuffer)
+        {
+          std::memcpy(vertices, vertexBuffer + j * 3, 3 * sizeof(float));
+          vertices += 3;
+        }
+        else
+        {
+          *vertices++ = subMesh.Vertex(j).X();
+          *vertices++ = subMesh.Vertex(j).Y();
+          *vertices++ = subMesh.Vertex(j).Z();
+        }
 
-        if (subMesh.NormalCount() > 0)
+        if (normalBuffer)
+        {
+          std::memcpy(vertices, normalBuffer + j * 3, 3 * sizeof(float));
+          vertices += 3;
+        }
+        else if (subMesh.NormalCount() > 0)
         {
           *vertices++ = subMesh.Normal(j).X();
           *vertices++ = subMesh.Normal(j).Y();
           *vertices++ = subMesh.Normal(j).Z();
         }
 
-        if (subMesh.TexCoordCount() > 0)
+        if (texCoordBuffer)
+        {
+          std::memcpy(vertices, texCoordBuffer + j * 2, 2 * sizeof(float));
+          vertices += 2;
+        }
+        else if (subMesh.TexCoordCount() > 0)
         {
           *vertices++ = subMesh.TexCoord(j).X();
           *vertices++ = subMesh.TexCoord(j).Y();
@@ -330,20 +359,32 @@ bool Ogre2MeshFactory::LoadImpl(const MeshDescriptor &_desc)
       // allocate index buffer
       ogreSubMesh->indexData[Ogre::VpNormal]->indexCount = subMesh.IndexCount();
 
+      // Use 16 bit indices when the submesh stores them that way
+      const uint16_t *shortIndices = subMesh.ShortIndexBuffer();
+
       ogreSubMesh->indexData[Ogre::VpNormal]->indexBuffer =
         Ogre::v1::HardwareBufferManager::getSingleton().createIndexBuffer(
+            shortIndices ? Ogre::v1::HardwareIndexBuffer::IT_16BIT :
             Ogre::v1::HardwareIndexBuffer::IT_32BIT,
             ogreSubMesh->indexData[Ogre::VpNormal]->indexCount,
             Ogre::v1::HardwareBuffer::HBU_STATIC,
             true);
 
       iBuf = ogreSubMesh->indexData[Ogre::VpNormal]->indexBuffer;
-      indices = static_cast<uint32_t*>(
-          iBuf->lock(Ogre::v1::HardwareBuffer::HBL_DISCARD));
 
+      if (shortIndices)
+      {
+        std::memcpy(iBuf->lock(Ogre::v1::HardwareBuffer::HBL_DISCARD),
+            shortIndices, subMesh.IndexCount() * sizeof(uint16_t));
+      }
+      else
+      {
+        indices = static_cast<uint32_t*>(
+            iBuf->lock(Ogre::v1::HardwareBuffer::HBL_DISCARD));
 
-      for (unsigned int j = 0; j < subMesh.IndexCount(); ++j)
-        *indices++ = static_cast<uint32_t>(subMesh.Index(j));
+        for (unsigned int j = 0; j < subMesh.IndexCount(); ++j)
+          *indices++ = static_cast<uint32_t>(subMesh.Index(j));
+      }
 
       iBuf->unlock();
 
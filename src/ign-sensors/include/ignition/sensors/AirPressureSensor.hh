@@ -69,6 +69,9 @@ namespace ignition
       /// \return true if the update was successfull
       public: virtual bool Update(const common::Time &_now) override;
 
+      // Documentation inherited.
+      public: virtual bool ConcurrentUpdate() const override;
+
       /// \brief Set the reference altitude.
       /// \param[in] _ref Verical reference position in meters
       public: void SetReferenceAltitude(double _reference);
@@ -61,6 +61,7 @@ namespace ignition
     //
     /// \brief forward declarations
     class CameraSensorPrivate;
+    class ImagePipeline;
 
     /// \brief Camera Sensor Class
     ///
@@ -100,10 +101,13 @@ namespace ignition
       /// generated.
       /// \param[in] _callback This callback will be called every time the
       /// camera produces image data. The Update function will be blocked
-      /// while the callbacks are executed.
+      /// while the callbacks are executed, unless the pipeline depth is
+      /// greater than zero, in which case they are called from a worker
+      /// thread.
       /// \remark Do not block inside of the callback.
       /// \return A connection pointer that must remain in scope. When the
       /// connection pointer falls out of scope, the connection is broken.
+      /// \sa SetPipelineDepth
       public: ignition::common::ConnectionPtr ConnectImageCallback(
                   std::function<
                   void(const ignition::msgs::Image &)> _callback);
@@ -113,6 +117,26 @@ namespace ignition
       public: virtual void SetScene(
                   ignition::rendering::ScenePtr _scene) override;
 
+      /// \brief Set how many captured images can wait to be published.
+      /// With a depth of zero, the default, Update converts and publishes
+      /// each image before returning. With a greater depth, Update returns
+      /// once the image is copied from the GPU, and a worker thread
+      /// publishes it and calls the image callbacks, in capture order. If
+      /// _depth images are still waiting, the next updates skip rendering
+      /// and the frames are counted as dropped.
+      /// \param[in] _depth Maximum number of images waiting to be published.
+      /// \sa DroppedFrameCount
+      public: void SetPipelineDepth(const unsigned int _depth);
+
+      /// \brief Get how many captured images can wait to be published.
+      /// \return Zero if images are published during Update.
+      public: unsigned int PipelineDepth() const;
+
+      /// \brief Get the number of frames skipped because the publishing
+      /// stage fell behind.
+      /// \return Number of dropped frames.
+      public: uint64_t DroppedFrameCount() const;
+
       /// \brief Get image width.
       /// \return width of the image
       public: virtual unsigned int ImageWidth() const;
@@ -158,6 +182,10 @@ namespace ignition
       /// \param[in] _now The current time
       protected: void PublishInfo(const ignition::common::Time &_now);
 
+      /// \brief Get the pipeline that publishes the captured images.
+      /// \return The image pipeline.
+      protected: ImagePipeline &Pipeline();
+
       /// \brief Create a camera in a scene
       /// \return True on success.
       private: bool CreateCamera();
@@ -18,6 +18,8 @@
 #ifndef IGNITION_SENSORS_GAUSSIANNOISEMODEL_HH_
 #define IGNITION_SENSORS_GAUSSIANNOISEMODEL_HH_
 
+#include <cstdint>
+
 #include <sdf/sdf.hh>
 
 #include "ignition/sensors/config.hh"
@@ -53,6 +55,27 @@ namespace ignition
       // Documentation inherited.
       public: double ApplyImpl(double _in, double _dt) override;
 
+      /// \brief Apply Gaussian noise to a batch of values. The samples are
+      /// generated in blocks from the random stream of this noise model.
+      /// \param[in,out] _data Data values.
+      /// \param[in] _count Number of values in _data.
+      /// \param[in] _dt Input data time step.
+      /// \sa SetSeed
+      public: void ApplyBatchImpl(double *_data, std::size_t _count,
+                  double _dt) override;
+
+      // Documentation inherited.
+      public: void ApplyBatchImpl(float *_data, std::size_t _count,
+                  double _dt) override;
+
+      /// \brief Set the seed of the random stream of this noise model. By
+      /// default, the stream is seeded from math::Rand::Seed(). Each noise
+      /// model draws from a stream identified by the scoped name of its noise
+      /// element, so a given seed reproduces the same noise whatever the
+      /// order in which the sensors are created.
+      /// \param[in] _seed New seed.
+      public: void SetSeed(uint64_t _seed);
+
       /// \brief Accessor for mean.
       /// \return Mean of Gaussian noise.
       public: double Mean() const;
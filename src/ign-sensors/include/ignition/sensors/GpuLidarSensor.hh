@@ -119,6 +119,19 @@ namespace ignition
       /// \return Vertical field of view.
       public: ignition::math::Angle VFOV() const;
 
+      /// \brief Set whether the point cloud published on the "points" topic
+      /// is organized. An organized point cloud has one point per ray, in
+      /// scan order, including rays that didn't hit anything. An unorganized
+      /// point cloud only has the points with a finite range, in a single
+      /// row. It's organized by default.
+      /// \param[in] _organized True for an organized point cloud.
+      public: void SetOrganizedPointCloud(const bool _organized);
+
+      /// \brief Get whether the published point cloud is organized.
+      /// \return True if the point cloud is organized.
+      /// \sa SetOrganizedPointCloud()
+      public: bool OrganizedPointCloud() const;
+
       /// \brief Connect function pointer to internal GpuRays callback
       /// \return ignition::common::Connection pointer
       public: virtual ignition::common::ConnectionPtr ConnectNewLidarFrame(
@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_SENSORS_IMAGEPIPELINE_HH_
+#define IGNITION_SENSORS_IMAGEPIPELINE_HH_
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+#include <ignition/rendering/Image.hh>
+
+#include "ignition/sensors/config.hh"
+#include "ignition/sensors/rendering/Export.hh"
+
+namespace ignition
+{
+  namespace sensors
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_SENSORS_VERSION_NAMESPACE {
+    //
+    /// \brief forward declarations
+    class ImagePipelinePrivate;
+
+    /// \brief Hands captured images over to a worker thread.
+    ///
+    ///   A rendering sensor acquires an image, copies its render target into
+    ///   it and pushes it with the work that turns it into a message,
+    ///   publishes it and triggers callbacks. With a depth of zero, the
+    ///   default, that work runs immediately on the calling thread. With a
+    ///   depth greater than zero, it runs on a pool of threads shared by all
+    ///   pipelines, in the order it was pushed, and the render thread can
+    ///   move on to the next sensor. At most Depth() images are in flight;
+    ///   when the workers fall behind, new frames are dropped and counted.
+    ///
+    ///   Images are recycled once their work is done, so a pipeline doesn't
+    ///   allocate after its first few frames.
+    class IGNITION_SENSORS_RENDERING_VISIBLE ImagePipeline
+    {
+      /// \brief Work done on a captured image.
+      public: using Stage = std::function<void(const rendering::Image &)>;
+
+      /// \brief Constructor
+      public: ImagePipeline();
+
+      /// \brief Destructor. Waits for the pending images to be processed.
+      public: ~ImagePipeline();
+
+      /// \brief Set the maximum number of images in flight.
+      /// \param[in] _depth Zero to process images on the calling thread.
+      public: void SetDepth(const unsigned int _depth);
+
+      /// \brief Get the maximum number of images in flight.
+      /// \return Zero if images are processed on the calling thread.
+      public: unsigned int Depth() const;
+
+      /// \brief Get an image to capture a frame into.
+      /// \param[in] _width Image width in pixels.
+      /// \param[in] _height Image height in pixels.
+      /// \param[in] _format Image pixel format.
+      /// \param[out] _image An image of the requested size and format,
+      /// recycled if possible.
+      /// \return False if Depth() images are already in flight. The frame is
+      /// then counted as dropped and shouldn't be rendered.
+      public: bool Acquire(const unsigned int _width,
+                  const unsigned int _height,
+                  const rendering::PixelFormat _format,
+                  rendering::Image &_image);
+
+      /// \brief Queue the work to do on an image returned by Acquire.
+      /// \param[in] _image Captured image.
+      /// \param[in] _stage Work to do on the image. It runs after the work of
+      /// the images pushed before it. Exceptions it throws are logged.
+      public: void Push(const rendering::Image &_image, Stage _stage);
+
+      /// \brief Block until all the pushed images are processed.
+      public: void Wait();
+
+      /// \brief Get the number of images pushed but not processed yet.
+      /// \return Number of images in flight.
+      public: std::size_t PendingCount() const;
+
+      /// \brief Get the number of images processed.
+      /// \return Number of processed images.
+      public: uint64_t ProcessedCount() const;
+
+      /// \brief Get the number of frames dropped because Depth() images were
+      /// in flight.
+      /// \return Number of dropped frames.
+      public: uint64_t DroppedCount() const;
+
+      /// \brief Data pointer for private data
+      /// \internal
+      private: std::unique_ptr<ImagePipelinePrivate> dataPtr;
+    };
+    }
+  }
+}
+
+#endif
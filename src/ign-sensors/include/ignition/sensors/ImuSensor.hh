@@ -70,6 +70,9 @@ namespace ignition
       /// \return true if the update was successfull
       public: virtual bool Update(const common::Time &_now) override;
 
+      // Documentation inherited.
+      public: virtual bool ConcurrentUpdate() const override;
+
       /// \brief Set the angular velocity of the imu
       /// \param[in] _angularVel Angular velocity of the imu in body frame
       /// expressed in radians per second
@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_SENSORS_LIDARPOINTCLOUD_HH_
+#define IGNITION_SENSORS_LIDARPOINTCLOUD_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include <ignition/math/Angle.hh>
+
+#include "ignition/sensors/config.hh"
+
+#ifndef _WIN32
+#  define GpuLidarSensor_EXPORTS_API
+#else
+#  if (defined(GpuLidarSensor_EXPORTS))
+#    define GpuLidarSensor_EXPORTS_API __declspec(dllexport)
+#  else
+#    define GpuLidarSensor_EXPORTS_API __declspec(dllimport)
+#  endif
+#endif
+
+namespace ignition
+{
+  namespace sensors
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_SENSORS_VERSION_NAMESPACE {
+    //
+    /// \brief forward declarations
+    class LidarPointCloudPrivate;
+
+    /// \brief Converts lidar ranges into the packed buffer of a point cloud.
+    ///
+    ///   The sines and cosines of the ray angles are computed once, when the
+    ///   ray layout changes, instead of once per point. Each point is packed
+    ///   with its intensity and its ring, the index of its row.
+    class GpuLidarSensor_EXPORTS_API LidarPointCloud
+    {
+      /// \brief Constructor
+      public: LidarPointCloud();
+
+      /// \brief Destructor
+      public: ~LidarPointCloud();
+
+      /// \brief Set the layout of the rays. Rays are evenly spaced between
+      /// the minimum and maximum angles, both included.
+      /// \param[in] _angleMin Minimum horizontal angle (azimuth).
+      /// \param[in] _angleMax Maximum horizontal angle (azimuth).
+      /// \param[in] _count Number of horizontal rays, the width of the scan.
+      /// \param[in] _verticalAngleMin Minimum vertical angle (inclination).
+      /// \param[in] _verticalAngleMax Maximum vertical angle (inclination).
+      /// \param[in] _verticalCount Number of vertical rays, the height of
+      /// the scan.
+      public: void SetRays(const ignition::math::Angle &_angleMin,
+                  const ignition::math::Angle &_angleMax,
+                  const unsigned int _count,
+                  const ignition::math::Angle &_verticalAngleMin,
+                  const ignition::math::Angle &_verticalAngleMax,
+                  const unsigned int _verticalCount);
+
+      /// \brief Get the width of the scan.
+      /// \return Number of horizontal rays.
+      public: unsigned int Width() const;
+
+      /// \brief Get the height of the scan.
+      /// \return Number of vertical rays.
+      public: unsigned int Height() const;
+
+      /// \brief Set the location of the fields in each point of the packed
+      /// buffer. x, y, z and intensity are stored as FLOAT32 and ring as
+      /// UINT16.
+      /// \param[in] _pointStep Size of a point in bytes.
+      /// \param[in] _x Offset of the x coordinate.
+      /// \param[in] _y Offset of the y coordinate.
+      /// \param[in] _z Offset of the z coordinate.
+      /// \param[in] _intensity Offset of the intensity.
+      /// \param[in] _ring Offset of the ring.
+      public: void SetFieldOffsets(const uint32_t _pointStep,
+                  const uint32_t _x, const uint32_t _y, const uint32_t _z,
+                  const uint32_t _intensity, const uint32_t _ring);
+
+      /// \brief Get the size of a point in bytes.
+      /// \return The point step.
+      public: uint32_t PointStep() const;
+
+      /// \brief Set whether the output is organized. An organized point cloud
+      /// has one point per ray, in scan order, including rays that didn't
+      /// hit anything. An unorganized point cloud only has the points with a
+      /// finite range. It's organized by default.
+      /// \param[in] _organized True for an organized output.
+      public: void SetOrganized(const bool _organized);
+
+      /// \brief Get whether the output is organized.
+      /// \return True if the output is organized.
+      public: bool Organized() const;
+
+      /// \brief Convert a scan to points.
+      /// \param[in] _data Scan data, Height() rows of Width() readings, each
+      /// reading having _channels floats: range, then intensity.
+      /// \param[in] _channels Number of floats per reading, at least 2.
+      /// \param[out] _buffer Output buffer, at least PointStep() * Width() *
+      /// Height() bytes.
+      /// \return Number of points with a finite range. Only these points are
+      /// written when the output is unorganized.
+      public: std::size_t Fill(const float *_data,
+                  const unsigned int _channels, char *_buffer);
+
+      /// \brief Data pointer for private data
+      /// \internal
+      private: std::unique_ptr<LidarPointCloudPrivate> dataPtr;
+    };
+    }
+  }
+}
+
+#endif
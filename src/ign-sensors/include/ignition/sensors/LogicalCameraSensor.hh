@@ -84,6 +84,9 @@ namespace ignition
       /// \return true if the update was successfull
       public: virtual bool Update(const common::Time &_now) override;
 
+      // Documentation inherited.
+      public: virtual bool ConcurrentUpdate() const override;
+
       /// \brief Get the near distance. This is the distance from the
       /// frustum's vertex to the closest plane.
       /// \return Near distance.
@@ -70,6 +70,9 @@ namespace ignition
       /// \return true if the update was successfull
       public: virtual bool Update(const common::Time &_now) override;
 
+      // Documentation inherited.
+      public: virtual bool ConcurrentUpdate() const override;
+
       /// \brief Set the world pose of the sensor
       /// \param[in] _pose Pose in world frame
       public: void SetWorldPose(const math::Pose3d _pose);
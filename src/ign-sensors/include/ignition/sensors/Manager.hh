@@ -24,6 +24,7 @@
 #include <sdf/sdf.hh>
 #include <ignition/common/Time.hh>
 #include <ignition/common/Console.hh>
+#include <ignition/math/SignalStats.hh>
 #include <ignition/rendering/Scene.hh>
 #include <ignition/sensors/config.hh>
 #include <ignition/sensors/Export.hh>
@@ -206,12 +207,42 @@ namespace ignition
       public: bool Remove(const ignition::sensors::SensorId _id);
 
       /// \brief Run the sensor generation one step.
+      ///
+      ///   Sensors are kept in a queue ordered by their next update time, so
+      ///   only the sensors that are due are visited. Due sensors that support
+      ///   concurrent updates are updated on a pool of worker threads while
+      ///   the others, such as rendering sensors, are updated on the calling
+      ///   thread. The function returns once all the updates are done.
       /// \param _time: The current simulated time
       /// \param _force: If true, all sensors are forced to update. Otherwise
       ///        a sensor will update based on it's Hz rate.
+      /// \remark A sensor whose update rate is changed from a positive value
+      /// to zero is updated every step only after its next scheduled update.
+      /// \sa Sensor::ConcurrentUpdate()
       public: void RunOnce(const ignition::common::Time &_time,
                   bool _force = false);
 
+      /// \brief Set whether RunOnce updates sensors in parallel. If disabled,
+      /// all sensors are updated on the calling thread. It's enabled by
+      /// default.
+      /// \param[in] _enable True to update sensors in parallel.
+      public: void SetParallelUpdate(const bool _enable);
+
+      /// \brief Get whether RunOnce updates sensors in parallel.
+      /// \return True if sensors are updated in parallel.
+      /// \sa SetParallelUpdate()
+      public: bool ParallelUpdate() const;
+
+      /// \brief Get the statistics of the wall clock time, in seconds, taken
+      /// by the updates of a sensor triggered by RunOnce. The statistics
+      /// hold the mean, min, max and variance, and their count is the number
+      /// of updates.
+      /// \param[in] _id ID of the sensor.
+      /// \return The update latency statistics, which are empty if the
+      /// sensor doesn't exist.
+      public: ignition::math::SignalStats UpdateStats(
+                  const ignition::sensors::SensorId _id) const;
+
       /// \brief Adds colon delimited paths sensor plugins may be
       public: void AddPluginPaths(const std::string &_path);
 
@@ -18,6 +18,7 @@
 #ifndef IGNITION_SENSORS_NOISE_HH_
 #define IGNITION_SENSORS_NOISE_HH_
 
+#include <cstddef>
 #include <functional>
 #include <string>
 #include <vector>
@@ -107,6 +108,42 @@ namespace ignition
       /// \return Data with noise applied.
       public: virtual double ApplyImpl(double _in, double _dt);
 
+      /// \brief Apply noise in place to a batch of data values, such as all
+      /// the ranges of a lidar scan. The values are considered to be sampled
+      /// at the same time, so time-correlated noise is advanced only once by
+      /// _dt for the whole batch.
+      /// \param[in,out] _data Data values.
+      /// \param[in] _count Number of values in _data.
+      /// \param[in] _dt Input data time step.
+      public: void ApplyBatch(double *_data, std::size_t _count,
+                  double _dt = 0.0);
+
+      /// \brief Apply noise in place to a batch of data values.
+      /// \param[in,out] _data Data values.
+      /// \param[in] _count Number of values in _data.
+      /// \param[in] _dt Input data time step.
+      /// \sa ApplyBatch(double *, std::size_t, double)
+      public: void ApplyBatch(float *_data, std::size_t _count,
+                  double _dt = 0.0);
+
+      /// \brief Apply noise to a batch of data values. This gets overriden by
+      /// derived classes, and called by ApplyBatch. The default
+      /// implementation calls ApplyImpl for each value.
+      /// \param[in,out] _data Data values.
+      /// \param[in] _count Number of values in _data.
+      /// \param[in] _dt Input data time step.
+      public: virtual void ApplyBatchImpl(double *_data, std::size_t _count,
+                  double _dt);
+
+      /// \brief Apply noise to a batch of data values. This gets overriden by
+      /// derived classes, and called by ApplyBatch. The default
+      /// implementation calls ApplyImpl for each value.
+      /// \param[in,out] _data Data values.
+      /// \param[in] _count Number of values in _data.
+      /// \param[in] _dt Input data time step.
+      public: virtual void ApplyBatchImpl(float *_data, std::size_t _count,
+                  double _dt);
+
       /// \brief Accessor for NoiseType.
       /// \return Type of noise currently in use.
       public: NoiseType Type() const;
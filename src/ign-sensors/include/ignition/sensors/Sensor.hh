@@ -113,6 +113,13 @@ namespace ignition
       /// \param[in] _hz Update rate of sensor in Hertz.
       public: void SetUpdateRate(const double _hz);
 
+      /// \brief Get whether Update() can run on a worker thread, at the same
+      /// time as the updates of other sensors. Sensors that share state with
+      /// other sensors, such as a rendering scene, must return false.
+      /// \return True if the Manager may update this sensor in parallel. It's
+      /// false by default.
+      public: virtual bool ConcurrentUpdate() const;
+
       /// \brief Get the current pose.
       /// \return Current pose of the sensor.
       public: ignition::math::Pose3d Pose() const;
@@ -192,6 +192,12 @@ bool AirPressureSensor::Update(const ignition::common::Time &_now)
   return true;
 }
 
+//////////////////////////////////////////////////
+bool AirPressureSensor::ConcurrentUpdate() const
+{
+  return true;
+}
+
 //////////////////////////////////////////////////
 void AirPressureSensor::SetReferenceAltitude(double _reference)
 {
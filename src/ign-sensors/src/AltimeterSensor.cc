@@ -174,6 +174,12 @@ bool AltimeterSensor::Update(const ignition::common::Time &_now)
   return true;
 }
 
+//////////////////////////////////////////////////
+bool AltimeterSensor::ConcurrentUpdate() const
+{
+  return true;
+}
+
 //////////////////////////////////////////////////
 void AltimeterSensor::SetVerticalReference(double _reference)
 {
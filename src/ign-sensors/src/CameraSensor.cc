@@ -21,6 +21,7 @@
 #include <ignition/math/Helpers.hh>
 
 #include "ignition/sensors/CameraSensor.hh"
+#include "ignition/sensors/ImagePipeline.hh"
 #include "ignition/sensors/Noise.hh"
 #include "ignition/sensors/SensorFactory.hh"
 #include "ignition/sensors/SensorTypes.hh"
@@ -44,6 +45,14 @@ class ignition::sensors::CameraSensorPrivate
   public: bool SaveImage(const unsigned char *_data, unsigned int _width,
     unsigned int _height, ignition::common::Image::PixelFormatType _format);
 
+  /// \brief Convert a captured image to a message, publish it, trigger
+  /// the image callbacks and save it if requested.
+  /// \param[in] _image Captured image.
+  /// \param[in] _now Time of the capture.
+  /// \param[in] _frameId Name of the camera frame.
+  public: void Publish(const rendering::Image &_image,
+    const common::Time &_now, const std::string &_frameId);
+
   /// \brief node to create publisher
   public: transport::Node node;
 
@@ -59,9 +68,6 @@ class ignition::sensors::CameraSensorPrivate
   /// \brief Rendering camera
   public: ignition::rendering::CameraPtr camera;
 
-  /// \brief Pointer to an image to be published
-  public: ignition::rendering::Image image;
-
   /// \brief Noise added to sensor data
   public: std::map<SensorNoiseType, NoisePtr> noises;
 
@@ -99,6 +105,11 @@ class ignition::sensors::CameraSensorPrivate
 
   /// \brief Baseline for stereo cameras.
   public: double baseline{0.0};
+
+  /// \brief Hands captured images over to the publishing stage. Declared
+  /// last so that it finishes its pending work before the members it uses
+  /// are destroyed.
+  public: ImagePipeline pipeline;
 };
 
 //////////////////////////////////////////////////
@@ -176,8 +187,6 @@ bool CameraSensor::CreateCamera()
       break;
   }
 
-  this->dataPtr->image = this->dataPtr->camera->CreateImage();
-
   this->Scene()->RootVisual()->AddChild(this->dataPtr->camera);
 
   // Create the directory to store frames
@@ -200,6 +209,7 @@ CameraSensor::CameraSensor()
 //////////////////////////////////////////////////
 CameraSensor::~CameraSensor()
 {
+  this->dataPtr->pipeline.Wait();
 }
 
 //////////////////////////////////////////////////
@@ -302,6 +312,15 @@ bool CameraSensor::Update(const ignition::common::Time &_now)
 
   std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
 
+  // Skip the frame if the previous ones are still being published
+  rendering::Image image;
+  if (!this->dataPtr->pipeline.Acquire(this->dataPtr->camera->ImageWidth(),
+      this->dataPtr->camera->ImageHeight(),
+      this->dataPtr->camera->ImageFormat(), image))
+  {
+    return true;
+  }
+
   // move the camera to the current pose
   this->dataPtr->camera->SetLocalPose(this->Pose());
 
@@ -309,38 +328,55 @@ bool CameraSensor::Update(const ignition::common::Time &_now)
   this->Render();
   {
     IGN_PROFILE("CameraSensor::Update Copy image");
-    this->dataPtr->camera->Copy(this->dataPtr->image);
+    this->dataPtr->camera->Copy(image);
   }
 
-  unsigned int width = this->dataPtr->camera->ImageWidth();
-  unsigned int height = this->dataPtr->camera->ImageHeight();
-  unsigned char *data = this->dataPtr->image.Data<unsigned char>();
+  // The rest runs on a worker thread when the pipeline has a depth, so it
+  // must only use values captured here and members that don't change after
+  // the camera is created.
+  this->dataPtr->pipeline.Push(image,
+      [this, _now](const rendering::Image &_image)
+  {
+    this->dataPtr->Publish(_image, _now, this->Name());
+    this->PublishInfo(_now);
+  });
+
+  return true;
+}
+
+//////////////////////////////////////////////////
+void CameraSensorPrivate::Publish(const rendering::Image &_image,
+    const common::Time &_now, const std::string &_frameId)
+{
+  IGN_PROFILE("CameraSensor::Publish");
+  unsigned int width = _image.Width();
+  unsigned int height = _image.Height();
+  const unsigned char *data = _image.Data<unsigned char>();
 
   ignition::common::Image::PixelFormatType
       format{common::Image::UNKNOWN_PIXEL_FORMAT};
   msgs::PixelFormatType msgsPixelFormat =
     msgs::PixelFormatType::UNKNOWN_PIXEL_FORMAT;
 
-  switch (this->dataPtr->camera->ImageFormat())
+  switch (_image.Format())
   {
     case ignition::rendering::PF_R8G8B8:
       format = ignition::common::Image::RGB_INT8;
       msgsPixelFormat = msgs::PixelFormatType::RGB_INT8;
       break;
     default:
-      ignerr << "Unsupported pixel format ["
-        << this->dataPtr->camera->ImageFormat() << "]\n";
+      ignerr << "Unsupported pixel format [" << _image.Format() << "]\n";
       break;
   }
 
   // create message
   ignition::msgs::Image msg;
   {
-    IGN_PROFILE("CameraSensor::Update Message");
+    IGN_PROFILE("CameraSensor::Publish Message");
     msg.set_width(width);
     msg.set_height(height);
     msg.set_step(width * rendering::PixelUtil::BytesPerPixel(
-                 this->dataPtr->camera->ImageFormat()));
+                 _image.Format()));
     // TODO(anyone) Deprecated in ign-msgs4, will be removed on ign-msgs5
     // in favor of set_pixel_format_type.
     msg.set_pixel_format(format);
@@ -349,23 +385,20 @@ bool CameraSensor::Update(const ignition::common::Time &_now)
     msg.mutable_header()->mutable_stamp()->set_nsec(_now.nsec);
     auto frame = msg.mutable_header()->add_data();
     frame->set_key("frame_id");
-    frame->add_value(this->Name());
-    msg.set_data(data, this->dataPtr->camera->ImageMemorySize());
+    frame->add_value(_frameId);
+    msg.set_data(data, _image.MemorySize());
   }
 
   // publish the image message
   {
-    IGN_PROFILE("CameraSensor::Update Publish");
-    this->dataPtr->pub.Publish(msg);
-
-    // publish the camera info message
-    this->PublishInfo(_now);
+    IGN_PROFILE("CameraSensor::Publish Publish");
+    this->pub.Publish(msg);
   }
 
   // Trigger callbacks.
   try
   {
-    this->dataPtr->imageEvent(msg);
+    this->imageEvent(msg);
   }
   catch(...)
   {
@@ -373,12 +406,10 @@ bool CameraSensor::Update(const ignition::common::Time &_now)
   }
 
   // Save image
-  if (this->dataPtr->saveImage)
+  if (this->saveImage)
   {
-    this->dataPtr->SaveImage(data, width, height, format);
+    this->SaveImage(data, width, height, format);
   }
-
-  return true;
 }
 
 //////////////////////////////////////////////////
@@ -571,4 +602,28 @@ double CameraSensor::Baseline() const
   return this->dataPtr->baseline;
 }
 
+//////////////////////////////////////////////////
+void CameraSensor::SetPipelineDepth(const unsigned int _depth)
+{
+  this->dataPtr->pipeline.SetDepth(_depth);
+}
+
+//////////////////////////////////////////////////
+unsigned int CameraSensor::PipelineDepth() const
+{
+  return this->dataPtr->pipeline.Depth();
+}
+
+//////////////////////////////////////////////////
+uint64_t CameraSensor::DroppedFrameCount() const
+{
+  return this->dataPtr->pipeline.DroppedCount();
+}
+
+//////////////////////////////////////////////////
+ImagePipeline &CameraSensor::Pipeline()
+{
+  return this->dataPtr->pipeline;
+}
+
 IGN_SENSORS_REGISTER_SENSOR(CameraSensor)
@@ -19,6 +19,7 @@
 #include <ignition/math/Helpers.hh>
 
 #include "ignition/sensors/DepthCameraSensor.hh"
+#include "ignition/sensors/ImagePipeline.hh"
 #include "ignition/sensors/SensorFactory.hh"
 #include "ignition/sensors/GaussianNoiseModel.hh"
 
@@ -43,6 +44,14 @@ class ignition::sensors::DepthCameraSensorPrivate
   public: bool SaveImage(const float *_data, unsigned int _width,
     unsigned int _height, ignition::common::Image::PixelFormatType _format);
 
+  /// \brief Convert a captured depth image to a message, publish it and
+  /// trigger the image callbacks.
+  /// \param[in] _image Captured depth image.
+  /// \param[in] _now Time of the capture.
+  /// \param[in] _frameId Name of the camera frame.
+  public: void Publish(const rendering::Image &_image,
+    const common::Time &_now, const std::string &_frameId);
+
   /// \brief node to create publisher
   public: transport::Node node;
 
@@ -161,6 +170,9 @@ DepthCameraSensor::DepthCameraSensor()
 //////////////////////////////////////////////////
 DepthCameraSensor::~DepthCameraSensor()
 {
+  // The pending images use this class' members, which are destroyed before
+  // the base class' pipeline.
+  this->Pipeline().Wait();
   this->dataPtr->connection.reset();
   if (this->dataPtr->depthBuffer)
     delete [] this->dataPtr->depthBuffer;
@@ -424,21 +436,54 @@ bool DepthCameraSensor::Update(const ignition::common::Time &_now)
     return false;
   }
 
+  unsigned int width = this->dataPtr->depthCamera->ImageWidth();
+  unsigned int height = this->dataPtr->depthCamera->ImageHeight();
+
+  // Skip the frame if the previous ones are still being published
+  rendering::Image image;
+  if (!this->Pipeline().Acquire(width, height,
+      this->dataPtr->depthCamera->ImageFormat(), image))
+  {
+    return true;
+  }
+
   // generate sensor data
   this->Render();
 
-  unsigned int width = this->dataPtr->depthCamera->ImageWidth();
-  unsigned int height = this->dataPtr->depthCamera->ImageHeight();
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    if (!this->dataPtr->depthBuffer)
+    {
+      ignerr << "No depth frame received.\n";
+      return false;
+    }
+    memcpy(image.Data(), this->dataPtr->depthBuffer, image.MemorySize());
+  }
+
+  this->Pipeline().Push(image,
+      [this, _now](const rendering::Image &_image)
+  {
+    this->dataPtr->Publish(_image, _now, this->Name());
+    this->PublishInfo(_now);
+  });
 
+  return true;
+}
+
+//////////////////////////////////////////////////
+void DepthCameraSensorPrivate::Publish(const rendering::Image &_image,
+    const common::Time &_now, const std::string &_frameId)
+{
+  IGN_PROFILE("DepthCameraSensor::Publish");
   auto commonFormat = common::Image::R_FLOAT32;
   auto msgsFormat = msgs::PixelFormatType::R_FLOAT32;
 
   // create message
   ignition::msgs::Image msg;
-  msg.set_width(width);
-  msg.set_height(height);
-  msg.set_step(width * rendering::PixelUtil::BytesPerPixel(
-               this->dataPtr->depthCamera->ImageFormat()));
+  msg.set_width(_image.Width());
+  msg.set_height(_image.Height());
+  msg.set_step(_image.Width() * rendering::PixelUtil::BytesPerPixel(
+               _image.Format()));
   // TODO(anyone) Deprecated in ign-msgs4, will be removed on ign-msgs5
   // in favor of set_pixel_format_type.
   msg.set_pixel_format(commonFormat);
@@ -447,29 +492,21 @@ bool DepthCameraSensor::Update(const ignition::common::Time &_now)
   msg.mutable_header()->mutable_stamp()->set_nsec(_now.nsec);
   auto frame = msg.mutable_header()->add_data();
   frame->set_key("frame_id");
-  frame->add_value(this->Name());
-
-  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
-  msg.set_data(this->dataPtr->depthBuffer,
-      this->dataPtr->depthCamera->ImageMemorySize());
+  frame->add_value(_frameId);
+  msg.set_data(_image.Data(), _image.MemorySize());
 
   // publish
-  this->dataPtr->pub.Publish(msg);
-
-  // publish the camera info message
-  this->PublishInfo(_now);
+  this->pub.Publish(msg);
 
   // Trigger callbacks.
   try
   {
-    this->dataPtr->imageEvent(msg);
+    this->imageEvent(msg);
   }
   catch(...)
   {
     ignerr << "Exception thrown in an image callback.\n";
   }
-
-  return true;
 }
 
 //////////////////////////////////////////////////
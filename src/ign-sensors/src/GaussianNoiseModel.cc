@@ -20,9 +20,15 @@
   #include <Winsock2.h>
 #endif
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <string>
+
 #include "ignition/sensors/GaussianNoiseModel.hh"
 #include <ignition/math/Helpers.hh>
 #include <ignition/math/Rand.hh>
+#include <ignition/math/RandomStream.hh>
 
 #include "ignition/common/Console.hh"
 #include "ignition/rendering/GaussianNoisePass.hh"
@@ -34,8 +40,71 @@
 using namespace ignition;
 using namespace sensors;
 
+/// \brief Number of noise samples generated at once by ApplyBatch.
+static constexpr std::size_t kNoiseBlockSize = 256u;
+
+/// \brief Hash bytes with 64-bit FNV-1a, which unlike std::hash gives the
+/// same value on every platform.
+/// \param[in] _data Bytes to hash.
+/// \param[in] _size Number of bytes.
+/// \param[in] _hash Hash of the preceding bytes, if any.
+/// \return The hash.
+static uint64_t fnv1a(const void *_data, std::size_t _size,
+    uint64_t _hash = 14695981039346656037ull)
+{
+  const unsigned char *bytes = static_cast<const unsigned char *>(_data);
+  for (std::size_t i = 0; i < _size; ++i)
+  {
+    _hash ^= bytes[i];
+    _hash *= 1099511628211ull;
+  }
+  return _hash;
+}
+
+/// \brief Identify the random stream of a noise model. It's the hash of the
+/// scoped name of the noise element, e.g. "model::link::imu::imu::
+/// angular_velocity::x::noise", so that each noise of each sensor has its own
+/// stream whatever the order in which the sensors are created. A noise which
+/// doesn't belong to a sensor is identified by its parameters.
+/// \param[in] _sdf Noise parameters.
+/// \return Identifier of the stream.
+static uint64_t noiseStreamId(const sdf::Noise &_sdf)
+{
+  std::string name;
+  for (sdf::ElementPtr elem = _sdf.Element(); elem && elem->GetParent();
+       elem = elem->GetParent())
+  {
+    const std::string part = elem->HasAttribute("name") ?
+        elem->Get<std::string>("name") : elem->GetName();
+    name = name.empty() ? part : part + "::" + name;
+  }
+
+  if (!name.empty())
+    return fnv1a(name.data(), name.size());
+
+  const double params[] = {_sdf.Mean(), _sdf.StdDev(), _sdf.BiasMean(),
+      _sdf.BiasStdDev(), _sdf.Precision(), _sdf.DynamicBiasStdDev(),
+      _sdf.DynamicBiasCorrelationTime()};
+  const int type = static_cast<int>(_sdf.Type());
+  return fnv1a(params, sizeof(params), fnv1a(&type, sizeof(type)));
+}
+
 class ignition::sensors::GaussianNoiseModelPrivate
 {
+  /// \brief Apply Gaussian noise to a batch of values.
+  /// \param[in,out] _data Data values.
+  /// \param[in] _count Number of values in _data.
+  /// \param[in] _dt Input data time step.
+  public: template<typename T>
+          void ApplyBatch(T *_data, std::size_t _count, double _dt);
+
+  /// \brief Random stream of this noise model. It is not shared with other
+  /// models, so that sensors can apply noise from different threads.
+  public: math::RandomStream stream;
+
+  /// \brief Identifier of the random stream within the seed.
+  public: uint64_t streamId = 0u;
+
   /// \brief If type starts with GAUSSIAN, the mean of the distribution
   /// from which we sample when adding noise.
   public: double mean = 0.0;
@@ -77,10 +146,55 @@ class ignition::sensors::ImageGaussianNoiseModelPrivate
   public: rendering::GaussianNoisePassPtr gaussianNoisePass;
 };
 
+//////////////////////////////////////////////////
+template<typename T>
+void GaussianNoiseModelPrivate::ApplyBatch(T *_data, std::size_t _count,
+    double _dt)
+{
+  if (_count == 0u)
+    return;
+
+  double normals[kNoiseBlockSize];
+
+  // Advance the dynamic bias once for the whole batch, following the same
+  // process as GaussianNoiseModel::ApplyImpl.
+  if (this->dynamicBiasStdDev > 0 && this->dynamicBiasCorrTime > 0)
+  {
+    double sigma_b = this->dynamicBiasStdDev;
+    double tau = this->dynamicBiasCorrTime;
+
+    double sigma_b_d = sqrt(-sigma_b * sigma_b *
+        tau / 2 * expm1(-2 * _dt / tau));
+    double phi_d = exp(-_dt / tau);
+    this->bias = phi_d * this->bias + this->stream.DblNormal(0, sigma_b_d);
+  }
+
+  const double offset = this->mean + this->bias;
+  for (std::size_t start = 0; start < _count; start += kNoiseBlockSize)
+  {
+    const std::size_t n = std::min(kNoiseBlockSize, _count - start);
+    this->stream.FillNormal(normals, n);
+
+    T *out = _data + start;
+    for (std::size_t i = 0; i < n; ++i)
+      out[i] = static_cast<T>(out[i] + offset + this->stdDev * normals[i]);
+
+    if (this->quantized)
+    {
+      for (std::size_t i = 0; i < n; ++i)
+      {
+        out[i] = static_cast<T>(
+            std::round(out[i] / this->precision) * this->precision);
+      }
+    }
+  }
+}
+
 //////////////////////////////////////////////////
 GaussianNoiseModel::GaussianNoiseModel()
   : Noise(NoiseType::GAUSSIAN), dataPtr(new GaussianNoiseModelPrivate())
 {
+  this->dataPtr->stream = math::RandomStream(math::Rand::Seed());
 }
 
 //////////////////////////////////////////////////
@@ -96,6 +210,10 @@ void GaussianNoiseModel::Load(const sdf::Noise &_sdf)
   Noise::Load(_sdf);
   std::ostringstream out;
 
+  this->dataPtr->streamId = noiseStreamId(_sdf);
+  this->dataPtr->stream = math::RandomStream(math::Rand::Seed(),
+      this->dataPtr->streamId);
+
   this->dataPtr->mean = _sdf.Mean();
   this->dataPtr->stdDev = _sdf.StdDev();
   this->dataPtr->dynamicBiasStdDev = _sdf.DynamicBiasStdDev();
@@ -106,12 +224,13 @@ void GaussianNoiseModel::Load(const sdf::Noise &_sdf)
   double biasStdDev = 0;
   biasMean = _sdf.BiasMean();
   biasStdDev = _sdf.BiasStdDev();
-  this->dataPtr->bias = ignition::math::Rand::DblNormal(biasMean, biasStdDev);
+  this->dataPtr->bias =
+    this->dataPtr->stream.DblNormal(biasMean, biasStdDev);
 
   // With equal probability, we pick a negative bias (by convention,
   // rateBiasMean should be positive, though it would work fine if
   // negative).
-  if (ignition::math::Rand::DblUniform() < 0.5)
+  if (this->dataPtr->stream.DblUniform() < 0.5)
     this->dataPtr->bias = -this->dataPtr->bias;
 
   this->Print(out);
@@ -127,7 +246,7 @@ void GaussianNoiseModel::Load(const sdf::Noise &_sdf)
 double GaussianNoiseModel::ApplyImpl(double _in, double _dt)
 {
   // Generate independent (uncorrelated) Gaussian noise to each input value.
-  double whiteNoise = ignition::math::Rand::DblNormal(
+  double whiteNoise = this->dataPtr->stream.DblNormal(
       this->dataPtr->mean, this->dataPtr->stdDev);
 
   // Generate varying (correlated) bias to each input value.
@@ -148,7 +267,7 @@ double GaussianNoiseModel::ApplyImpl(double _in, double _dt)
         tau / 2 * expm1(-2 * _dt / tau));
     double phi_d = exp(-_dt / tau);
     this->dataPtr->bias = phi_d * this->dataPtr->bias +
-      ignition::math::Rand::DblNormal(0, sigma_b_d);
+      this->dataPtr->stream.DblNormal(0, sigma_b_d);
   }
 
   double output = _in + this->dataPtr->bias + whiteNoise;
@@ -165,6 +284,26 @@ double GaussianNoiseModel::ApplyImpl(double _in, double _dt)
   return output;
 }
 
+//////////////////////////////////////////////////
+void GaussianNoiseModel::ApplyBatchImpl(double *_data, std::size_t _count,
+    double _dt)
+{
+  this->dataPtr->ApplyBatch(_data, _count, _dt);
+}
+
+//////////////////////////////////////////////////
+void GaussianNoiseModel::ApplyBatchImpl(float *_data, std::size_t _count,
+    double _dt)
+{
+  this->dataPtr->ApplyBatch(_data, _count, _dt);
+}
+
+//////////////////////////////////////////////////
+void GaussianNoiseModel::SetSeed(uint64_t _seed)
+{
+  this->dataPtr->stream = math::RandomStream(_seed, this->dataPtr->streamId);
+}
+
 //////////////////////////////////////////////////
 double GaussianNoiseModel::Mean() const
 {
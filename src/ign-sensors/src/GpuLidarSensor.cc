@@ -20,6 +20,7 @@
 #include <ignition/common/Console.hh>
 #include <ignition/common/Profiler.hh>
 #include "ignition/sensors/GpuLidarSensor.hh"
+#include "ignition/sensors/LidarPointCloud.hh"
 #include "ignition/sensors/SensorFactory.hh"
 
 using namespace ignition::sensors;
@@ -39,6 +40,9 @@ class ignition::sensors::GpuLidarSensorPrivate
   /// \brief The point cloud message.
   public: msgs::PointCloudPacked pointMsg;
 
+  /// \brief Converts the scan into the point cloud message.
+  public: LidarPointCloud pointCloud;
+
   /// \brief Transport node.
   public: transport::Node node;
 
@@ -109,7 +113,15 @@ bool GpuLidarSensor::Load(const sdf::Sensor &_sdf)
   // alignment should be configured. This same problem is in the
   // RgbdCameraSensor.
   msgs::InitPointCloudPacked(this->dataPtr->pointMsg, this->Name(), true,
-      {{"xyz", msgs::PointCloudPacked::Field::FLOAT32}});
+      {{"xyz", msgs::PointCloudPacked::Field::FLOAT32},
+      {"intensity", msgs::PointCloudPacked::Field::FLOAT32},
+      {"ring", msgs::PointCloudPacked::Field::UINT16}});
+
+  const auto &fields = this->dataPtr->pointMsg.field();
+  this->dataPtr->pointCloud.SetFieldOffsets(
+      this->dataPtr->pointMsg.point_step(), fields.Get(0).offset(),
+      fields.Get(1).offset(), fields.Get(2).offset(), fields.Get(3).offset(),
+      fields.Get(4).offset());
 
   if (this->Scene())
     this->CreateLidar();
@@ -189,6 +201,13 @@ bool GpuLidarSensor::CreateLidar()
       this->dataPtr->pointMsg.point_step() *
       this->dataPtr->pointMsg.width());
 
+  this->dataPtr->pointCloud.SetRays(
+      this->dataPtr->gpuRays->AngleMin(), this->dataPtr->gpuRays->AngleMax(),
+      this->dataPtr->gpuRays->RangeCount(),
+      this->dataPtr->gpuRays->VerticalAngleMin(),
+      this->dataPtr->gpuRays->VerticalAngleMax(),
+      this->dataPtr->gpuRays->VerticalRangeCount());
+
   this->AddSensor(this->dataPtr->gpuRays);
 
   return true;
@@ -233,8 +252,6 @@ bool GpuLidarSensor::Update(const ignition::common::Time &_now)
     this->dataPtr->pointMsg.mutable_header()->mutable_stamp()->set_nsec(
         _now.nsec);
 
-    this->dataPtr->pointMsg.set_is_dense(true);
-
     this->dataPtr->FillPointCloudMsg();
 
     {
@@ -279,62 +296,49 @@ ignition::math::Angle GpuLidarSensor::VFOV() const
 }
 
 //////////////////////////////////////////////////
-void GpuLidarSensorPrivate::FillPointCloudMsg()
+void GpuLidarSensor::SetOrganizedPointCloud(const bool _organized)
 {
-  IGN_PROFILE("GpuLidarSensorPrivate::FillPointCloudMsg");
-  uint32_t width = this->pointMsg.width();
-  uint32_t height = this->pointMsg.height();
-  unsigned int channels = 3;
-
-  float angleStep =
-    (this->gpuRays->AngleMax() - this->gpuRays->AngleMin()).Radian() /
-    (this->gpuRays->RangeCount()-1);
+  this->dataPtr->pointCloud.SetOrganized(_organized);
+}
 
-  float verticleAngleStep = (this->gpuRays->VerticalAngleMax() -
-      this->gpuRays->VerticalAngleMin()).Radian() /
-    (this->gpuRays->VerticalRangeCount()-1);
+//////////////////////////////////////////////////
+bool GpuLidarSensor::OrganizedPointCloud() const
+{
+  return this->dataPtr->pointCloud.Organized();
+}
 
-  // Angles of ray currently processing, azimuth is horizontal, inclination
-  // is vertical
-  float inclination = this->gpuRays->VerticalAngleMin().Radian();
+//////////////////////////////////////////////////
+void GpuLidarSensorPrivate::FillPointCloudMsg()
+{
+  IGN_PROFILE("GpuLidarSensorPrivate::FillPointCloudMsg");
+  const uint32_t width = this->pointCloud.Width();
+  const uint32_t height = this->pointCloud.Height();
+  const uint32_t pointStep = this->pointMsg.point_step();
 
   std::string *msgBuffer = this->pointMsg.mutable_data();
-  msgBuffer->resize(this->pointMsg.row_step() *
-      this->pointMsg.height());
-  char *msgBufferIndex = msgBuffer->data();
+  msgBuffer->resize(pointStep * width * height);
 
-  // Iterate over scan and populate point cloud
-  for (uint32_t j = 0; j < height; ++j)
-  {
-    float azimuth = this->gpuRays->AngleMin().Radian();
+  std::size_t count = this->pointCloud.Fill(this->gpuRays->Data(),
+      this->gpuRays->Channels(), &(*msgBuffer)[0]);
 
-    for (uint32_t i = 0; i < width; ++i)
-    {
-      // Index of current point, and the depth value at that point
-      auto index = j * width * channels + i * channels;
-      float depth = this->gpuRays->Data()[index];
-
-      int fieldIndex = 0;
-
-      // Convert spherical coordinates to Cartesian for pointcloud
-      // See https://en.wikipedia.org/wiki/Spherical_coordinate_system
-      *reinterpret_cast<float*>(msgBufferIndex +
-          this->pointMsg.field(fieldIndex++).offset()) =
-        depth * std::cos(inclination) * std::cos(azimuth);
-      *reinterpret_cast<float*>(msgBufferIndex +
-          this->pointMsg.field(fieldIndex++).offset()) =
-        depth * std::cos(inclination) * std::sin(azimuth);
-      *reinterpret_cast<float*>(msgBufferIndex +
-          this->pointMsg.field(fieldIndex++).offset()) =
-        depth * std::sin(inclination);
-
-      // Move the index to the next point.
-      msgBufferIndex += this->pointMsg.point_step();
-
-      azimuth += angleStep;
-    }
-    inclination += verticleAngleStep;
+  if (this->pointCloud.Organized())
+  {
+    this->pointMsg.set_width(width);
+    this->pointMsg.set_height(height);
+  }
+  else
+  {
+    msgBuffer->resize(pointStep * count);
+    this->pointMsg.set_width(static_cast<uint32_t>(count));
+    this->pointMsg.set_height(1u);
   }
+  this->pointMsg.set_row_step(pointStep * this->pointMsg.width());
+
+  // An organized cloud keeps the points of the rays without a return, whose
+  // coordinates aren't finite.
+  this->pointMsg.set_is_dense(count ==
+      static_cast<std::size_t>(this->pointMsg.width()) *
+      this->pointMsg.height());
 }
 
 IGN_SENSORS_REGISTER_SENSOR(GpuLidarSensor)
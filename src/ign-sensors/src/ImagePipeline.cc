@@ -0,0 +1,267 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include <ignition/common/Console.hh>
+#include <ignition/common/Profiler.hh>
+#include <ignition/common/WorkerPool.hh>
+
+#include "ignition/sensors/ImagePipeline.hh"
+
+using namespace ignition;
+using namespace sensors;
+
+/// \brief Private data for the ImagePipeline class
+class ignition::sensors::ImagePipelinePrivate
+{
+  /// \brief Get the worker pool shared by all the pipelines, creating it if
+  /// needed. The pool lives as long as a pipeline holds it.
+  /// \return The shared pool.
+  public: static std::shared_ptr<common::WorkerPool> SharedPool();
+
+  /// \brief Run a stage, logging the exceptions it throws.
+  /// \param[in] _stage Stage to run.
+  /// \param[in] _image Image to run it on.
+  public: static void Run(const ImagePipeline::Stage &_stage,
+      const rendering::Image &_image);
+
+  /// \brief Process the queued images in order, until the queue is empty.
+  /// Only one Drain runs at a time for a pipeline.
+  public: void Drain();
+
+  /// \brief Return an image to the free list.
+  /// \param[in] _image Image to recycle.
+  public: void Recycle(const rendering::Image &_image);
+
+  /// \brief An image and the work to do on it.
+  public: using Entry = std::pair<rendering::Image, ImagePipeline::Stage>;
+
+  /// \brief Maximum number of images in flight, 0 to run synchronously.
+  public: unsigned int depth = 0u;
+
+  /// \brief Queued images. The front entry stays in the queue while it's
+  /// processed, so that the queue size is the number of images in flight.
+  public: std::deque<Entry> queue;
+
+  /// \brief Images ready to be acquired again.
+  public: std::vector<rendering::Image> free;
+
+  /// \brief True while a Drain task is queued or running in the pool.
+  public: bool draining = false;
+
+  /// \brief Number of processed images.
+  public: uint64_t processed = 0u;
+
+  /// \brief Number of dropped frames.
+  public: uint64_t dropped = 0u;
+
+  /// \brief Pool running the Drain tasks.
+  public: std::shared_ptr<common::WorkerPool> pool;
+
+  /// \brief Protects the members above.
+  public: mutable std::mutex mutex;
+
+  /// \brief Notified when the queue becomes empty.
+  public: std::condition_variable idle;
+};
+
+//////////////////////////////////////////////////
+std::shared_ptr<common::WorkerPool> ImagePipelinePrivate::SharedPool()
+{
+  static std::mutex poolMutex;
+  static std::weak_ptr<common::WorkerPool> sharedPool;
+
+  std::lock_guard<std::mutex> lock(poolMutex);
+  auto pool = sharedPool.lock();
+  if (!pool)
+  {
+    pool = std::make_shared<common::WorkerPool>();
+    sharedPool = pool;
+  }
+  return pool;
+}
+
+//////////////////////////////////////////////////
+void ImagePipelinePrivate::Run(const ImagePipeline::Stage &_stage,
+    const rendering::Image &_image)
+{
+  try
+  {
+    _stage(_image);
+  }
+  catch (...)
+  {
+    ignerr << "Exception thrown while processing an image.\n";
+  }
+}
+
+//////////////////////////////////////////////////
+void ImagePipelinePrivate::Drain()
+{
+  IGN_PROFILE("ImagePipeline::Drain");
+
+  std::unique_lock<std::mutex> lock(this->mutex);
+  while (!this->queue.empty())
+  {
+    // The entry stays at the front of the queue, and Push only appends to
+    // it, so the references remain valid while the lock is released.
+    const Entry &entry = this->queue.front();
+    lock.unlock();
+    Run(entry.second, entry.first);
+    lock.lock();
+
+    this->Recycle(entry.first);
+    this->queue.pop_front();
+    ++this->processed;
+  }
+
+  this->draining = false;
+  this->idle.notify_all();
+}
+
+//////////////////////////////////////////////////
+void ImagePipelinePrivate::Recycle(const rendering::Image &_image)
+{
+  // Keep one spare image for the frame that is rendered while the others
+  // are in flight.
+  if (this->free.size() <= this->depth)
+    this->free.push_back(_image);
+}
+
+//////////////////////////////////////////////////
+ImagePipeline::ImagePipeline()
+  : dataPtr(new ImagePipelinePrivate())
+{
+}
+
+//////////////////////////////////////////////////
+ImagePipeline::~ImagePipeline()
+{
+  this->Wait();
+}
+
+//////////////////////////////////////////////////
+void ImagePipeline::SetDepth(const unsigned int _depth)
+{
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->depth = _depth;
+    if (_depth > 0u && !this->dataPtr->pool)
+      this->dataPtr->pool = ImagePipelinePrivate::SharedPool();
+  }
+
+  // Going back to synchronous processing must not overtake the images that
+  // are still queued.
+  if (_depth == 0u)
+    this->Wait();
+}
+
+//////////////////////////////////////////////////
+unsigned int ImagePipeline::Depth() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->depth;
+}
+
+//////////////////////////////////////////////////
+bool ImagePipeline::Acquire(const unsigned int _width,
+    const unsigned int _height, const rendering::PixelFormat _format,
+    rendering::Image &_image)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  if (this->dataPtr->depth > 0u &&
+      this->dataPtr->queue.size() >= this->dataPtr->depth)
+  {
+    ++this->dataPtr->dropped;
+    return false;
+  }
+
+  auto &free = this->dataPtr->free;
+  while (!free.empty())
+  {
+    rendering::Image image = std::move(free.back());
+    free.pop_back();
+    if (image.Width() == _width && image.Height() == _height &&
+        image.Format() == _format)
+    {
+      _image = std::move(image);
+      return true;
+    }
+  }
+
+  _image = rendering::Image(_width, _height, _format);
+  return true;
+}
+
+//////////////////////////////////////////////////
+void ImagePipeline::Push(const rendering::Image &_image, Stage _stage)
+{
+  std::unique_lock<std::mutex> lock(this->dataPtr->mutex);
+  if (this->dataPtr->depth == 0u)
+  {
+    lock.unlock();
+    ImagePipelinePrivate::Run(_stage, _image);
+    lock.lock();
+
+    this->dataPtr->Recycle(_image);
+    ++this->dataPtr->processed;
+    return;
+  }
+
+  this->dataPtr->queue.emplace_back(_image, std::move(_stage));
+  if (!this->dataPtr->draining)
+  {
+    this->dataPtr->draining = true;
+    this->dataPtr->pool->AddWork(
+        std::bind(&ImagePipelinePrivate::Drain, this->dataPtr.get()));
+  }
+}
+
+//////////////////////////////////////////////////
+void ImagePipeline::Wait()
+{
+  std::unique_lock<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->idle.wait(lock, [this]
+      {
+        return !this->dataPtr->draining && this->dataPtr->queue.empty();
+      });
+}
+
+//////////////////////////////////////////////////
+std::size_t ImagePipeline::PendingCount() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->queue.size();
+}
+
+//////////////////////////////////////////////////
+uint64_t ImagePipeline::ProcessedCount() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->processed;
+}
+
+//////////////////////////////////////////////////
+uint64_t ImagePipeline::DroppedCount() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->dropped;
+}
@@ -0,0 +1,145 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <gtest/gtest.h>
+
+#include <future>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "ignition/sensors/ImagePipeline.hh"
+
+using namespace ignition;
+
+//////////////////////////////////////////////////
+TEST(ImagePipeline, Synchronous)
+{
+  sensors::ImagePipeline pipeline;
+  EXPECT_EQ(0u, pipeline.Depth());
+
+  rendering::Image image;
+  ASSERT_TRUE(pipeline.Acquire(4, 2, rendering::PF_R8G8B8, image));
+  EXPECT_EQ(4u, image.Width());
+  EXPECT_EQ(2u, image.Height());
+  EXPECT_EQ(rendering::PF_R8G8B8, image.Format());
+  const void *data = image.Data();
+  image.Data<unsigned char>()[0] = 42;
+
+  // The stage runs before Push returns, on this thread.
+  const auto caller = std::this_thread::get_id();
+  bool ran = false;
+  pipeline.Push(image, [&](const rendering::Image &_image)
+  {
+    EXPECT_EQ(caller, std::this_thread::get_id());
+    EXPECT_EQ(42, _image.Data<unsigned char>()[0]);
+    ran = true;
+  });
+  EXPECT_TRUE(ran);
+  EXPECT_EQ(1u, pipeline.ProcessedCount());
+  EXPECT_EQ(0u, pipeline.PendingCount());
+
+  // The image is recycled, unless the size changes.
+  rendering::Image again;
+  ASSERT_TRUE(pipeline.Acquire(4, 2, rendering::PF_R8G8B8, again));
+  EXPECT_EQ(data, again.Data());
+  pipeline.Push(again, [](const rendering::Image &) {});
+
+  rendering::Image larger;
+  ASSERT_TRUE(pipeline.Acquire(8, 2, rendering::PF_R8G8B8, larger));
+  EXPECT_EQ(8u, larger.Width());
+
+  // Exceptions are caught.
+  pipeline.Push(larger, [](const rendering::Image &)
+  {
+    throw std::runtime_error("stage failure");
+  });
+  EXPECT_EQ(3u, pipeline.ProcessedCount());
+  EXPECT_EQ(0u, pipeline.DroppedCount());
+}
+
+//////////////////////////////////////////////////
+TEST(ImagePipeline, Asynchronous)
+{
+  sensors::ImagePipeline pipeline;
+  pipeline.SetDepth(2u);
+  EXPECT_EQ(2u, pipeline.Depth());
+
+  // Block the first stage until the test releases it.
+  std::promise<void> release;
+  std::shared_future<void> released = release.get_future().share();
+  std::vector<int> order;
+
+  const int frames = 5;
+  int pushed = 0;
+  for (int i = 0; i < frames; ++i)
+  {
+    rendering::Image image;
+    if (!pipeline.Acquire(2, 2, rendering::PF_FLOAT32_R, image))
+      continue;
+
+    image.Data<unsigned char>()[0] = static_cast<unsigned char>(i);
+    pipeline.Push(image, [&, released](const rendering::Image &_image)
+    {
+      released.wait();
+      order.push_back(_image.Data<unsigned char>()[0]);
+    });
+    ++pushed;
+  }
+
+  // Only two frames fit in the pipeline while the first one is blocked.
+  EXPECT_EQ(2, pushed);
+  EXPECT_EQ(2u, pipeline.PendingCount());
+  EXPECT_EQ(3u, pipeline.DroppedCount());
+
+  release.set_value();
+  pipeline.Wait();
+  EXPECT_EQ(0u, pipeline.PendingCount());
+  EXPECT_EQ(2u, pipeline.ProcessedCount());
+  ASSERT_EQ(2u, order.size());
+  EXPECT_EQ(0, order[0]);
+  EXPECT_EQ(1, order[1]);
+
+  // Images are processed in order once the workers keep up.
+  order.clear();
+  for (int i = 0; i < 100; ++i)
+  {
+    rendering::Image image;
+    while (!pipeline.Acquire(2, 2, rendering::PF_FLOAT32_R, image))
+      std::this_thread::yield();
+
+    image.Data<unsigned char>()[0] = static_cast<unsigned char>(i);
+    pipeline.Push(image, [&](const rendering::Image &_image)
+    {
+      order.push_back(_image.Data<unsigned char>()[0]);
+    });
+  }
+
+  // Going back to synchronous processing waits for the queued images.
+  pipeline.SetDepth(0u);
+  EXPECT_EQ(0u, pipeline.PendingCount());
+  EXPECT_EQ(102u, pipeline.ProcessedCount());
+  ASSERT_EQ(100u, order.size());
+  for (int i = 0; i < 100; ++i)
+    EXPECT_EQ(i, order[i]);
+}
+
+//////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
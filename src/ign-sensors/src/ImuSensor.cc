@@ -194,6 +194,12 @@ bool ImuSensor::Update(const ignition::common::Time &_now)
   return true;
 }
 
+//////////////////////////////////////////////////
+bool ImuSensor::ConcurrentUpdate() const
+{
+  return true;
+}
+
 //////////////////////////////////////////////////
 void ImuSensor::SetAngularVelocity(const math::Vector3d &_angularVel)
 {
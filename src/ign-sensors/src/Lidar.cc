@@ -224,26 +224,34 @@ bool Lidar::PublishLidarScan(const ignition::common::Time &_now)
     }
   }
 
-  for (unsigned int j = 0; j < this->VerticalRangeCount(); ++j)
+  const unsigned int numRanges =
+    this->VerticalRangeCount() * this->RangeCount();
+  float *ranges = this->dataPtr->laserMsg.mutable_ranges()->mutable_data();
+  float *intensities =
+    this->dataPtr->laserMsg.mutable_intensities()->mutable_data();
+
+  for (unsigned int index = 0; index < numRanges; ++index)
   {
-    for (unsigned int i = 0; i < this->RangeCount(); ++i)
-    {
-      int index = j * this->RangeCount() + i;
-      double range = this->laserBuffer[index*3];
-
-      if (this->dataPtr->noises.find(LIDAR_NOISE) !=
-          this->dataPtr->noises.end())
-      {
-        range = this->dataPtr->noises[LIDAR_NOISE]->Apply(range);
-        range = ignition::math::clamp(range,
-            this->RangeMin(), this->RangeMax());
-      }
-
-      range = ignition::math::isnan(range) ? this->RangeMax() : range;
-      this->dataPtr->laserMsg.set_ranges(index, range);
-      this->dataPtr->laserMsg.set_intensities(index,
-          this->laserBuffer[index * 3 + 1]);
-    }
+    ranges[index] = this->laserBuffer[index * 3];
+    intensities[index] = this->laserBuffer[index * 3 + 1];
+  }
+
+  // Apply the noise to the whole scan at once.
+  auto noise = this->dataPtr->noises.find(LIDAR_NOISE);
+  if (noise != this->dataPtr->noises.end())
+  {
+    noise->second->ApplyBatch(ranges, numRanges);
+
+    const float rangeMin = static_cast<float>(this->RangeMin());
+    const float rangeMax = static_cast<float>(this->RangeMax());
+    for (unsigned int index = 0; index < numRanges; ++index)
+      ranges[index] = ignition::math::clamp(ranges[index], rangeMin, rangeMax);
+  }
+
+  for (unsigned int index = 0; index < numRanges; ++index)
+  {
+    if (ignition::math::isnan(ranges[index]))
+      ranges[index] = static_cast<float>(this->RangeMax());
   }
 
   // publish
@@ -0,0 +1,231 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#include <ignition/common/Profiler.hh>
+#include "ignition/sensors/LidarPointCloud.hh"
+
+using namespace ignition::sensors;
+
+/// \brief Private data for the LidarPointCloud class
+class ignition::sensors::LidarPointCloudPrivate
+{
+  /// \brief Compute the sines and cosines of evenly spaced angles.
+  /// \param[in] _min First angle in radians.
+  /// \param[in] _max Last angle in radians.
+  /// \param[in] _count Number of angles.
+  /// \param[out] _cos Cosines.
+  /// \param[out] _sin Sines.
+  public: static void Tabulate(const double _min, const double _max,
+      const unsigned int _count, std::vector<float> &_cos,
+      std::vector<float> &_sin);
+
+  /// \brief Minimum horizontal angle in radians.
+  public: double angleMin = 0.0;
+
+  /// \brief Maximum horizontal angle in radians.
+  public: double angleMax = 0.0;
+
+  /// \brief Minimum vertical angle in radians.
+  public: double verticalAngleMin = 0.0;
+
+  /// \brief Maximum vertical angle in radians.
+  public: double verticalAngleMax = 0.0;
+
+  /// \brief Cosine of the azimuth of each column.
+  public: std::vector<float> cosAzimuth;
+
+  /// \brief Sine of the azimuth of each column.
+  public: std::vector<float> sinAzimuth;
+
+  /// \brief Cosine of the inclination of each row.
+  public: std::vector<float> cosInclination;
+
+  /// \brief Sine of the inclination of each row.
+  public: std::vector<float> sinInclination;
+
+  /// \brief Size of a point in bytes.
+  public: uint32_t pointStep = 0u;
+
+  /// \brief Offset of the x coordinate.
+  public: uint32_t xOffset = 0u;
+
+  /// \brief Offset of the y coordinate.
+  public: uint32_t yOffset = 0u;
+
+  /// \brief Offset of the z coordinate.
+  public: uint32_t zOffset = 0u;
+
+  /// \brief Offset of the intensity.
+  public: uint32_t intensityOffset = 0u;
+
+  /// \brief Offset of the ring.
+  public: uint32_t ringOffset = 0u;
+
+  /// \brief True if the output is organized.
+  public: bool organized = true;
+};
+
+//////////////////////////////////////////////////
+void LidarPointCloudPrivate::Tabulate(const double _min, const double _max,
+    const unsigned int _count, std::vector<float> &_cos,
+    std::vector<float> &_sin)
+{
+  _cos.resize(_count);
+  _sin.resize(_count);
+
+  const double step = _count > 1u ? (_max - _min) / (_count - 1u) : 0.0;
+  for (unsigned int i = 0; i < _count; ++i)
+  {
+    const double angle = _min + step * i;
+    _cos[i] = static_cast<float>(std::cos(angle));
+    _sin[i] = static_cast<float>(std::sin(angle));
+  }
+}
+
+//////////////////////////////////////////////////
+LidarPointCloud::LidarPointCloud()
+  : dataPtr(new LidarPointCloudPrivate())
+{
+}
+
+//////////////////////////////////////////////////
+LidarPointCloud::~LidarPointCloud()
+{
+}
+
+//////////////////////////////////////////////////
+void LidarPointCloud::SetRays(const ignition::math::Angle &_angleMin,
+    const ignition::math::Angle &_angleMax, const unsigned int _count,
+    const ignition::math::Angle &_verticalAngleMin,
+    const ignition::math::Angle &_verticalAngleMax,
+    const unsigned int _verticalCount)
+{
+  auto &d = *this->dataPtr;
+  if (d.angleMin != _angleMin.Radian() || d.angleMax != _angleMax.Radian() ||
+      d.cosAzimuth.size() != _count)
+  {
+    d.angleMin = _angleMin.Radian();
+    d.angleMax = _angleMax.Radian();
+    d.Tabulate(d.angleMin, d.angleMax, _count, d.cosAzimuth, d.sinAzimuth);
+  }
+
+  if (d.verticalAngleMin != _verticalAngleMin.Radian() ||
+      d.verticalAngleMax != _verticalAngleMax.Radian() ||
+      d.cosInclination.size() != _verticalCount)
+  {
+    d.verticalAngleMin = _verticalAngleMin.Radian();
+    d.verticalAngleMax = _verticalAngleMax.Radian();
+    d.Tabulate(d.verticalAngleMin, d.verticalAngleMax, _verticalCount,
+        d.cosInclination, d.sinInclination);
+  }
+}
+
+//////////////////////////////////////////////////
+unsigned int LidarPointCloud::Width() const
+{
+  return static_cast<unsigned int>(this->dataPtr->cosAzimuth.size());
+}
+
+//////////////////////////////////////////////////
+unsigned int LidarPointCloud::Height() const
+{
+  return static_cast<unsigned int>(this->dataPtr->cosInclination.size());
+}
+
+//////////////////////////////////////////////////
+void LidarPointCloud::SetFieldOffsets(const uint32_t _pointStep,
+    const uint32_t _x, const uint32_t _y, const uint32_t _z,
+    const uint32_t _intensity, const uint32_t _ring)
+{
+  this->dataPtr->pointStep = _pointStep;
+  this->dataPtr->xOffset = _x;
+  this->dataPtr->yOffset = _y;
+  this->dataPtr->zOffset = _z;
+  this->dataPtr->intensityOffset = _intensity;
+  this->dataPtr->ringOffset = _ring;
+}
+
+//////////////////////////////////////////////////
+uint32_t LidarPointCloud::PointStep() const
+{
+  return this->dataPtr->pointStep;
+}
+
+//////////////////////////////////////////////////
+void LidarPointCloud::SetOrganized(const bool _organized)
+{
+  this->dataPtr->organized = _organized;
+}
+
+//////////////////////////////////////////////////
+bool LidarPointCloud::Organized() const
+{
+  return this->dataPtr->organized;
+}
+
+//////////////////////////////////////////////////
+std::size_t LidarPointCloud::Fill(const float *_data,
+    const unsigned int _channels, char *_buffer)
+{
+  IGN_PROFILE("LidarPointCloud::Fill");
+  auto &d = *this->dataPtr;
+  const std::size_t width = d.cosAzimuth.size();
+  const std::size_t height = d.cosInclination.size();
+
+  const float *cosAzimuth = d.cosAzimuth.data();
+  const float *sinAzimuth = d.sinAzimuth.data();
+
+  // A single pass over the scan is faster than converting each row in a
+  // separate vectorized loop, since the cost is dominated by memory writes.
+  std::size_t valid = 0u;
+  char *out = _buffer;
+  for (std::size_t j = 0; j < height; ++j)
+  {
+    const float *reading = _data + j * width * _channels;
+    const float cosInclination = d.cosInclination[j];
+    const float sinInclination = d.sinInclination[j];
+    const uint16_t ring = static_cast<uint16_t>(j);
+
+    for (std::size_t i = 0; i < width; ++i, reading += _channels)
+    {
+      const float range = reading[0];
+      const bool finite = std::isfinite(range);
+      valid += finite;
+      if (!finite && !d.organized)
+        continue;
+
+      // Convert spherical coordinates to Cartesian for pointcloud
+      // See https://en.wikipedia.org/wiki/Spherical_coordinate_system
+      const float horizontal = range * cosInclination;
+      const float x = horizontal * cosAzimuth[i];
+      const float y = horizontal * sinAzimuth[i];
+      const float z = range * sinInclination;
+
+      std::memcpy(out + d.xOffset, &x, sizeof(float));
+      std::memcpy(out + d.yOffset, &y, sizeof(float));
+      std::memcpy(out + d.zOffset, &z, sizeof(float));
+      std::memcpy(out + d.intensityOffset, &reading[1], sizeof(float));
+      std::memcpy(out + d.ringOffset, &ring, sizeof(uint16_t));
+      out += d.pointStep;
+    }
+  }
+
+  return valid;
+}
@@ -0,0 +1,136 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include <ignition/math/Helpers.hh>
+
+#include "ignition/sensors/LidarPointCloud.hh"
+
+using namespace ignition;
+
+/// \brief Read a value from a packed point.
+/// \param[in] _point Start of the point.
+/// \param[in] _offset Offset of the field.
+/// \return The value.
+template<typename T>
+T field(const char *_point, uint32_t _offset)
+{
+  T value;
+  std::memcpy(&value, _point + _offset, sizeof(T));
+  return value;
+}
+
+//////////////////////////////////////////////////
+TEST(LidarPointCloud, Fill)
+{
+  sensors::LidarPointCloud cloud;
+  EXPECT_TRUE(cloud.Organized());
+
+  const unsigned int width = 5;
+  const unsigned int height = 3;
+  cloud.SetRays(math::Angle(-IGN_PI / 2), math::Angle(IGN_PI / 2), width,
+      math::Angle(-0.2), math::Angle(0.2), height);
+  cloud.SetFieldOffsets(32, 0, 4, 8, 16, 24);
+  EXPECT_EQ(width, cloud.Width());
+  EXPECT_EQ(height, cloud.Height());
+  EXPECT_EQ(32u, cloud.PointStep());
+
+  // Three channels per reading: range, intensity and an unused value.
+  const float inf = std::numeric_limits<float>::infinity();
+  std::vector<float> data(width * height * 3, 0.0f);
+  for (unsigned int j = 0; j < height; ++j)
+  {
+    for (unsigned int i = 0; i < width; ++i)
+    {
+      unsigned int index = (j * width + i) * 3;
+      data[index] = 1.0f + i + 10.0f * j;
+      data[index + 1] = 0.5f * i;
+    }
+  }
+  data[(1 * width + 2) * 3] = inf;
+
+  std::vector<char> buffer(32 * width * height);
+  EXPECT_EQ(width * height - 1u, cloud.Fill(data.data(), 3, buffer.data()));
+
+  for (unsigned int j = 0; j < height; ++j)
+  {
+    const double inclination = -0.2 + 0.2 * j;
+    for (unsigned int i = 0; i < width; ++i)
+    {
+      const double azimuth = -IGN_PI / 2 + IGN_PI / 4 * i;
+      const char *point = buffer.data() + 32 * (j * width + i);
+      const double range = data[(j * width + i) * 3];
+      if (std::isinf(range))
+      {
+        EXPECT_TRUE(std::isinf(field<float>(point, 0)));
+        continue;
+      }
+
+      EXPECT_NEAR(range * std::cos(inclination) * std::cos(azimuth),
+          field<float>(point, 0), 1e-5);
+      EXPECT_NEAR(range * std::cos(inclination) * std::sin(azimuth),
+          field<float>(point, 4), 1e-5);
+      EXPECT_NEAR(range * std::sin(inclination), field<float>(point, 8), 1e-5);
+      EXPECT_FLOAT_EQ(0.5f * i, field<float>(point, 16));
+      EXPECT_EQ(j, field<uint16_t>(point, 24));
+    }
+  }
+
+  // Unorganized output skips the point without a return.
+  cloud.SetOrganized(false);
+  EXPECT_FALSE(cloud.Organized());
+  std::vector<char> unorganized(32 * width * height);
+  EXPECT_EQ(width * height - 1u,
+      cloud.Fill(data.data(), 3, unorganized.data()));
+
+  const char *point = unorganized.data() + 32 * (1 * width + 2);
+  EXPECT_FLOAT_EQ(data[(1 * width + 3) * 3] * std::cos(0.0) *
+      std::cos(IGN_PI / 4), field<float>(point, 0));
+  EXPECT_EQ(1u, field<uint16_t>(point, 24));
+  EXPECT_EQ(0, std::memcmp(buffer.data(), unorganized.data(),
+      32 * (1 * width + 2)));
+}
+
+//////////////////////////////////////////////////
+TEST(LidarPointCloud, SingleRay)
+{
+  sensors::LidarPointCloud cloud;
+  cloud.SetRays(math::Angle(0.3), math::Angle(0.3), 1,
+      math::Angle(0.0), math::Angle(0.0), 1);
+  cloud.SetFieldOffsets(20, 0, 4, 8, 12, 16);
+
+  const float data[2] = {2.0f, 7.0f};
+  std::vector<char> buffer(20);
+  EXPECT_EQ(1u, cloud.Fill(data, 2, buffer.data()));
+  EXPECT_NEAR(2.0 * std::cos(0.3), field<float>(buffer.data(), 0), 1e-6);
+  EXPECT_NEAR(2.0 * std::sin(0.3), field<float>(buffer.data(), 4), 1e-6);
+  EXPECT_FLOAT_EQ(0.0f, field<float>(buffer.data(), 8));
+  EXPECT_FLOAT_EQ(7.0f, field<float>(buffer.data(), 12));
+}
+
+//////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
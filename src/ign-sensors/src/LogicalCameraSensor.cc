@@ -167,6 +167,12 @@ bool LogicalCameraSensor::Update(const ignition::common::Time &_now)
   return true;
 }
 
+//////////////////////////////////////////////////
+bool LogicalCameraSensor::ConcurrentUpdate() const
+{
+  return true;
+}
+
 //////////////////////////////////////////////////
 double LogicalCameraSensor::Near() const
 {
@@ -188,6 +188,12 @@ bool MagnetometerSensor::Update(const ignition::common::Time &_now)
   return true;
 }
 
+//////////////////////////////////////////////////
+bool MagnetometerSensor::ConcurrentUpdate() const
+{
+  return true;
+}
+
 //////////////////////////////////////////////////
 void MagnetometerSensor::SetWorldPose(const math::Pose3d _pose)
 {
@@ -20,13 +20,19 @@
 // #pragma GCC diagnostic ignored "-Wdeprecated-declarations"
 
 #include "ignition/sensors/Manager.hh"
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <limits>
 #include <memory>
 #include <unordered_map>
+#include <utility>
 #include <ignition/common/PluginLoader.hh>
 #include <ignition/common/Plugin.hh>
 #include <ignition/common/Profiler.hh>
 #include <ignition/common/SystemPaths.hh>
 #include <ignition/common/Console.hh>
+#include <ignition/common/WorkerPool.hh>
 
 #include "ignition/sensors/config.hh"
 #include "ignition/sensors/Events.hh"
@@ -34,6 +40,16 @@
 
 using namespace ignition::sensors;
 
+/// \brief Statistics recorded for the update latency of each sensor.
+static const char kUpdateStats[] = "mean,min,max,var";
+
+/// \brief Queue key of sensors that are updated every step.
+static const ignition::common::Time kAlwaysDue(
+    std::numeric_limits<int32_t>::min(), 0);
+
+/// \brief A sensor in the update queue.
+using QueueEntry = std::pair<ignition::common::Time, SensorId>;
+
 class ignition::sensors::ManagerPrivate
 {
   /// \brief constructor
@@ -42,9 +58,45 @@ class ignition::sensors::ManagerPrivate
   /// \brief destructor
   public: ~ManagerPrivate();
 
+  /// \brief Add a sensor to the update queue.
+  /// \param[in] _sensor The sensor.
+  public: void Enqueue(const Sensor &_sensor);
+
+  /// \brief Remove a sensor from the update queue.
+  /// \param[in] _id ID of the sensor.
+  public: void Dequeue(const SensorId _id);
+
+  /// \brief Add a new sensor.
+  /// \param[in] _sensor The sensor.
+  /// \return ID of the sensor.
+  public: SensorId Add(std::unique_ptr<Sensor> _sensor);
+
+  /// \brief Update a sensor and record the time it took.
+  /// \param[in] _sensor The sensor.
+  /// \param[in] _time The current simulated time.
+  /// \param[in] _force True to force the update.
+  /// \param[out] _stats Latency statistics of the sensor.
+  public: static void UpdateSensor(Sensor *_sensor,
+      const ignition::common::Time &_time, const bool _force,
+      ignition::math::SignalStats &_stats);
+
   /// \brief Loaded sensors.
   public: std::map<SensorId, std::unique_ptr<Sensor>> sensors;
 
+  /// \brief Min-heap of the sensors, ordered by the time of their next
+  /// update. Each sensor appears once.
+  public: std::vector<QueueEntry> queue;
+
+  /// \brief Update latency statistics of each sensor.
+  public: std::map<SensorId, ignition::math::SignalStats> stats;
+
+  /// \brief Threads used to update sensors in parallel, created on first
+  /// use.
+  public: std::unique_ptr<ignition::common::WorkerPool> pool;
+
+  /// \brief True to update sensors in parallel.
+  public: bool parallelUpdate = true;
+
   /// \brief Ignition Rendering manager
   public: ignition::rendering::ScenePtr renderingScene;
 
@@ -62,6 +114,61 @@ ManagerPrivate::~ManagerPrivate()
 {
 }
 
+//////////////////////////////////////////////////
+/// \brief Get the queue key of a sensor.
+/// \param[in] _sensor The sensor.
+/// \return The time at which the sensor is due.
+static ignition::common::Time dueTime(const Sensor &_sensor)
+{
+  return _sensor.UpdateRate() > 0 ? _sensor.NextUpdateTime() : kAlwaysDue;
+}
+
+//////////////////////////////////////////////////
+void ManagerPrivate::Enqueue(const Sensor &_sensor)
+{
+  this->queue.emplace_back(dueTime(_sensor), _sensor.Id());
+  std::push_heap(this->queue.begin(), this->queue.end(),
+      std::greater<QueueEntry>());
+}
+
+//////////////////////////////////////////////////
+void ManagerPrivate::Dequeue(const SensorId _id)
+{
+  auto iter = std::remove_if(this->queue.begin(), this->queue.end(),
+      [_id](const QueueEntry &_entry) {return _entry.second == _id;});
+  if (iter == this->queue.end())
+    return;
+
+  this->queue.erase(iter, this->queue.end());
+  std::make_heap(this->queue.begin(), this->queue.end(),
+      std::greater<QueueEntry>());
+}
+
+//////////////////////////////////////////////////
+SensorId ManagerPrivate::Add(std::unique_ptr<Sensor> _sensor)
+{
+  SensorId id = _sensor->Id();
+
+  // Replacing a sensor with the same ID drops its queue entry.
+  this->Dequeue(id);
+  this->Enqueue(*_sensor);
+  this->stats[id].InsertStatistics(kUpdateStats);
+  this->sensors[id] = std::move(_sensor);
+  return id;
+}
+
+//////////////////////////////////////////////////
+void ManagerPrivate::UpdateSensor(Sensor *_sensor,
+    const ignition::common::Time &_time, const bool _force,
+    ignition::math::SignalStats &_stats)
+{
+  auto start = std::chrono::steady_clock::now();
+  _sensor->Update(_time, _force);
+  std::chrono::duration<double> elapsed =
+    std::chrono::steady_clock::now() - start;
+  _stats.InsertData(elapsed.count());
+}
+
 //////////////////////////////////////////////////
 Manager::Manager() :
   dataPtr(new ManagerPrivate)
@@ -130,17 +237,124 @@ void Manager::AddPluginPaths(const std::string &_paths)
 //////////////////////////////////////////////////
 bool Manager::Remove(const ignition::sensors::SensorId _id)
 {
-  return this->dataPtr->sensors.erase(_id) > 0;
+  if (this->dataPtr->sensors.erase(_id) == 0)
+    return false;
+
+  this->dataPtr->Dequeue(_id);
+  this->dataPtr->stats.erase(_id);
+  return true;
 }
 
 //////////////////////////////////////////////////
 void Manager::RunOnce(const ignition::common::Time &_time, bool _force)
 {
   IGN_PROFILE("SensorManager::RunOnce");
-  for (auto &s : this->dataPtr->sensors)
+  auto &queue = this->dataPtr->queue;
+  const auto later = std::greater<QueueEntry>();
+
+  // Take the due sensors out of the queue.
+  std::vector<ignition::sensors::Sensor *> due;
+  if (_force)
   {
-    s.second->Update(_time, _force);
+    for (auto &s : this->dataPtr->sensors)
+      due.push_back(s.second.get());
+    queue.clear();
   }
+  else
+  {
+    while (!queue.empty() && queue.front().first <= _time)
+    {
+      std::pop_heap(queue.begin(), queue.end(), later);
+      auto iter = this->dataPtr->sensors.find(queue.back().second);
+      queue.pop_back();
+
+      if (iter == this->dataPtr->sensors.end())
+        continue;
+
+      // The sensor may have been updated outside of the manager since it was
+      // queued.
+      if (dueTime(*iter->second) > _time)
+        this->dataPtr->Enqueue(*iter->second);
+      else
+        due.push_back(iter->second.get());
+    }
+  }
+
+  // Split them between the worker threads and this thread.
+  std::vector<ignition::sensors::Sensor *> concurrent;
+  std::vector<ignition::sensors::Sensor *> serial;
+  for (auto *sensor : due)
+  {
+    if (this->dataPtr->parallelUpdate && sensor->ConcurrentUpdate())
+      concurrent.push_back(sensor);
+    else
+      serial.push_back(sensor);
+  }
+
+  // A single sensor isn't worth a thread switch.
+  if (concurrent.size() < 2u)
+  {
+    serial.insert(serial.end(), concurrent.begin(), concurrent.end());
+    concurrent.clear();
+  }
+
+  if (!concurrent.empty())
+  {
+    if (!this->dataPtr->pool)
+      this->dataPtr->pool.reset(new ignition::common::WorkerPool());
+
+    for (auto *sensor : concurrent)
+    {
+      auto &stats = this->dataPtr->stats[sensor->Id()];
+      this->dataPtr->pool->AddWork([sensor, &_time, _force, &stats]()
+      {
+        ManagerPrivate::UpdateSensor(sensor, _time, _force, stats);
+      });
+    }
+  }
+
+  for (auto *sensor : serial)
+  {
+    ManagerPrivate::UpdateSensor(sensor, _time, _force,
+        this->dataPtr->stats[sensor->Id()]);
+  }
+
+  if (!concurrent.empty())
+    this->dataPtr->pool->WaitForResults();
+
+  // Put the sensors back in the queue with their new update time.
+  if (_force)
+  {
+    for (auto &s : this->dataPtr->sensors)
+      this->dataPtr->Enqueue(*s.second);
+  }
+  else
+  {
+    for (auto *sensor : due)
+      this->dataPtr->Enqueue(*sensor);
+  }
+}
+
+//////////////////////////////////////////////////
+void Manager::SetParallelUpdate(const bool _enable)
+{
+  this->dataPtr->parallelUpdate = _enable;
+}
+
+//////////////////////////////////////////////////
+bool Manager::ParallelUpdate() const
+{
+  return this->dataPtr->parallelUpdate;
+}
+
+//////////////////////////////////////////////////
+ignition::math::SignalStats Manager::UpdateStats(
+    const ignition::sensors::SensorId _id) const
+{
+  auto iter = this->dataPtr->stats.find(_id);
+  if (iter == this->dataPtr->stats.end())
+    return ignition::math::SignalStats();
+  return iter->second;
 }
 
 /////////////////////////////////////////////////
@@ -157,9 +371,7 @@ ignition::sensors::SensorId Manager::CreateSensor(const sdf::Sensor &_sdf)
   sensor->SetScene(this->dataPtr->renderingScene);
 #pragma GCC diagnostic pop
 
-  SensorId id = sensor->Id();
-  this->dataPtr->sensors[id] = std::move(sensor);
-  return id;
+  return this->dataPtr->Add(std::move(sensor));
 }
 
 /////////////////////////////////////////////////
@@ -176,7 +388,5 @@ ignition::sensors::SensorId Manager::CreateSensor(sdf::ElementPtr _sdf)
   sensor->SetScene(this->dataPtr->renderingScene);
 #pragma GCC diagnostic pop
 
-  SensorId id = sensor->Id();
-  this->dataPtr->sensors[id] = std::move(sensor);
-  return id;
+  return this->dataPtr->Add(std::move(sensor));
 }
@@ -46,6 +46,23 @@ TEST(Manager, removeSensor)
   // \todo(nkoenig) Add a sensor, then remove it
 }
 
+//////////////////////////////////////////////////
+TEST(Manager, parallelUpdate)
+{
+  ignition::sensors::Manager mgr;
+  EXPECT_TRUE(mgr.Init());
+
+  EXPECT_TRUE(mgr.ParallelUpdate());
+  mgr.SetParallelUpdate(false);
+  EXPECT_FALSE(mgr.ParallelUpdate());
+
+  // Running without sensors is fine.
+  mgr.RunOnce(ignition::common::Time(1, 0));
+  mgr.RunOnce(ignition::common::Time(2, 0), true);
+
+  EXPECT_EQ(0u, mgr.UpdateStats(ignition::sensors::NO_SENSOR).Count());
+}
+
 //////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
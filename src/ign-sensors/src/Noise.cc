@@ -158,6 +158,82 @@ double Noise::ApplyImpl(double _in, double /*_dt*/)
   return _in;
 }
 
+//////////////////////////////////////////////////
+/// \brief Apply the noise types handled by the base class to a batch of
+/// values.
+/// \param[in] _type Noise type.
+/// \param[in] _cb Custom noise callback.
+/// \param[in,out] _data Data values.
+/// \param[in] _count Number of values in _data.
+/// \param[in] _dt Input data time step.
+/// \return True if the noise was applied, false if the derived class should
+/// apply it.
+template<typename T>
+static bool applyBatchCommon(NoiseType _type,
+    const std::function<double(double, double)> &_cb,
+    T *_data, std::size_t _count, double _dt)
+{
+  if (_type == NoiseType::NONE || _count == 0u)
+    return true;
+
+  if (_type == NoiseType::CUSTOM)
+  {
+    if (_cb)
+    {
+      for (std::size_t i = 0; i < _count; ++i)
+        _data[i] = static_cast<T>(_cb(_data[i], _dt));
+    }
+    else
+    {
+      ignerr << "Custom noise callback function not set!"
+          << " Please call SetCustomNoiseCallback within a sensor plugin."
+          << std::endl;
+    }
+    return true;
+  }
+
+  return false;
+}
+
+//////////////////////////////////////////////////
+void Noise::ApplyBatch(double *_data, std::size_t _count, double _dt)
+{
+  if (!applyBatchCommon(this->dataPtr->type,
+        this->dataPtr->customNoiseCallback, _data, _count, _dt))
+  {
+    this->ApplyBatchImpl(_data, _count, _dt);
+  }
+}
+
+//////////////////////////////////////////////////
+void Noise::ApplyBatch(float *_data, std::size_t _count, double _dt)
+{
+  if (!applyBatchCommon(this->dataPtr->type,
+        this->dataPtr->customNoiseCallback, _data, _count, _dt))
+  {
+    this->ApplyBatchImpl(_data, _count, _dt);
+  }
+}
+
+//////////////////////////////////////////////////
+void Noise::ApplyBatchImpl(double *_data, std::size_t _count, double _dt)
+{
+  // Only the first value advances the time-correlated noise.
+  for (std::size_t i = 0; i < _count; ++i)
+    _data[i] = this->ApplyImpl(_data[i], i == 0u ? _dt : 0.0);
+}
+
+//////////////////////////////////////////////////
+void Noise::ApplyBatchImpl(float *_data, std::size_t _count, double _dt)
+{
+  // Only the first value advances the time-correlated noise.
+  for (std::size_t i = 0; i < _count; ++i)
+  {
+    _data[i] = static_cast<float>(
+        this->ApplyImpl(_data[i], i == 0u ? _dt : 0.0));
+  }
+}
+
 //////////////////////////////////////////////////
 NoiseType Noise::Type() const
 {
@@ -408,6 +408,120 @@ TEST(NoiseTest, OnApplyNoise)
   }
 }
 
+//////////////////////////////////////////////////
+TEST(NoiseTest, ApplyBatchNoneAndCustom)
+{
+  std::vector<double> values(100);
+  std::iota(values.begin(), values.end(), 0.0);
+
+  // NONE leaves the values untouched.
+  sensors::NoisePtr noise = sensors::NoiseFactory::NewNoiseModel(
+      NoiseSdf("none", 0, 0, 0, 0, 0));
+  noise->ApplyBatch(values.data(), values.size());
+  for (unsigned int i = 0; i < values.size(); ++i)
+    EXPECT_DOUBLE_EQ(values[i], i);
+
+  // CUSTOM calls the callback for each value.
+  noise.reset(new sensors::Noise(sensors::NoiseType::CUSTOM));
+  noise->SetCustomNoiseCallback(
+    std::bind(&OnApplyCustomNoise,
+      std::placeholders::_1, std::placeholders::_2));
+
+  std::vector<float> floats(values.begin(), values.end());
+  noise->ApplyBatch(floats.data(), floats.size());
+  for (unsigned int i = 0; i < floats.size(); ++i)
+    EXPECT_FLOAT_EQ(floats[i], i * 2.0f);
+}
+
+//////////////////////////////////////////////////
+TEST(NoiseTest, ApplyBatchGaussian)
+{
+  const double mean = 10.0;
+  const double stddev = 5.0;
+  const unsigned int count = 128 * 2048;
+
+  sensors::NoisePtr noise = sensors::NoiseFactory::NewNoiseModel(
+      NoiseSdf("gaussian", mean, stddev, 0, 0, 0));
+  auto noiseModel =
+    std::dynamic_pointer_cast<sensors::GaussianNoiseModel>(noise);
+  ASSERT_NE(nullptr, noiseModel);
+
+  // Apply the noise to a constant input, as in GaussianNoise().
+  const double x = 42.0;
+  std::vector<double> values(count, x);
+  noise->ApplyBatch(values.data(), values.size());
+
+  double sum = std::accumulate(values.begin(), values.end(), 0.0);
+  double sampleMean = sum / count;
+  double sqSum = 0.0;
+  for (double value : values)
+    sqSum += (value - sampleMean) * (value - sampleMean);
+  double sampleVariance = sqSum / count;
+
+  double variance = stddev * stddev;
+  EXPECT_NEAR(sampleMean, x + mean + noiseModel->Bias(),
+      g_sigma * stddev / sqrt(count));
+  EXPECT_NEAR(sampleVariance, variance,
+      g_sigma * sqrt(2 * variance * variance / (count - 1)));
+
+  // The same seed reproduces the same noise, for both float and double.
+  std::vector<float> floats1(1001, 1.0f);
+  std::vector<float> floats2(1001, 1.0f);
+  noiseModel->SetSeed(1234u);
+  noise->ApplyBatch(floats1.data(), floats1.size());
+  noiseModel->SetSeed(1234u);
+  noise->ApplyBatch(floats2.data(), floats2.size());
+  EXPECT_EQ(floats1, floats2);
+
+  // The stream continues across batches.
+  noise->ApplyBatch(floats2.data(), floats2.size());
+  EXPECT_NE(floats1, floats2);
+
+  // Apply draws from the same stream.
+  noiseModel->SetSeed(99u);
+  const double first = noise->Apply(x);
+  noiseModel->SetSeed(99u);
+  EXPECT_DOUBLE_EQ(first, noise->Apply(x));
+
+  // The stream doesn't depend on the order in which noise models are
+  // created, but on the sensor that they belong to.
+  auto sensorNoise = [&](const std::string &_sensorName)
+  {
+    sdf::ElementPtr sensorElem(new sdf::Element);
+    sensorElem->SetName("sensor");
+    sensorElem->AddAttribute("name", "string", _sensorName, true);
+    sdf::ElementPtr noiseElem = NoiseSdf("gaussian", mean, stddev, 0, 0, 0);
+    noiseElem->SetParent(sensorElem);
+
+    std::vector<double> result(1000, x);
+    sensors::NoiseFactory::NewNoiseModel(noiseElem)->ApplyBatch(
+        result.data(), result.size());
+    return result;
+  };
+  const auto sensor1Values = sensorNoise("sensor1");
+  const auto sensor2Values = sensorNoise("sensor2");
+  EXPECT_NE(sensor1Values, sensor2Values);
+  EXPECT_EQ(sensor1Values, sensorNoise("sensor1"));
+  EXPECT_EQ(sensor2Values, sensorNoise("sensor2"));
+}
+
+//////////////////////////////////////////////////
+TEST(NoiseTest, ApplyBatchGaussianQuantized)
+{
+  sensors::NoisePtr noise = sensors::NoiseFactory::NewNoiseModel(
+      NoiseSdf("gaussian_quantized", 0, 0, 0, 0, 0.3));
+
+  // Zero noise with quantization, as in ApplyGaussianQuantized.
+  std::vector<double> values = {0.32, 0.31, 0.30, 0.29, 0.28, -12.34};
+  noise->ApplyBatch(values.data(), values.size());
+  EXPECT_NEAR(values[0], 0.3, 1e-6);
+  EXPECT_NEAR(values[1], 0.3, 1e-6);
+  EXPECT_NEAR(values[2], 0.3, 1e-6);
+  EXPECT_NEAR(values[3], 0.3, 1e-6);
+  EXPECT_NEAR(values[4], 0.3, 1e-6);
+  EXPECT_NEAR(values[5], -12.3, 1e-6);
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
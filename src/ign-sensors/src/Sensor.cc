@@ -194,6 +194,12 @@ void Sensor::SetUpdateRate(const double _hz)
   }
 }
 
+//////////////////////////////////////////////////
+bool Sensor::ConcurrentUpdate() const
+{
+  return false;
+}
+
 //////////////////////////////////////////////////
 bool Sensor::Update(const ignition::common::Time &_now,
                   const bool _force)
@@ -0,0 +1,125 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <sdf/sdf.hh>
+
+#include <ignition/common/Filesystem.hh>
+#include <ignition/sensors/AltimeterSensor.hh>
+#include <ignition/sensors/ImuSensor.hh>
+#include <ignition/sensors/Manager.hh>
+
+#include "test_config.h"  // NOLINT(build/include)
+
+/// \brief Helper function to create a sensor sdf element
+/// \param[in] _name Name of the sensor.
+/// \param[in] _type Type of the sensor.
+/// \param[in] _updateRate Update rate of the sensor.
+/// \return The sensor element, or null on failure.
+sdf::ElementPtr SensorToSDF(const std::string &_name,
+    const std::string &_type, const double _updateRate)
+{
+  std::ostringstream stream;
+  stream
+    << "<?xml version='1.0'?>"
+    << "<sdf version='1.6'>"
+    << " <model name='m1'>"
+    << "  <link name='link1'>"
+    << "    <sensor name='" << _name << "' type='" << _type << "'>"
+    << "      <topic>/ignition/sensors/test/" << _name << "</topic>"
+    << "      <update_rate>"<< _updateRate <<"</update_rate>"
+    << "      <always_on>1</always_on>"
+    << "    </sensor>"
+    << "  </link>"
+    << " </model>"
+    << "</sdf>";
+
+  sdf::SDFPtr sdfParsed(new sdf::SDF());
+  sdf::init(sdfParsed);
+  if (!sdf::readString(stream.str(), sdfParsed))
+    return sdf::ElementPtr();
+
+  return sdfParsed->Root()->GetElement("model")->GetElement("link")
+    ->GetElement("sensor");
+}
+
+class SensorManagerTest: public testing::TestWithParam<bool>
+{
+};
+
+/////////////////////////////////////////////////
+TEST_P(SensorManagerTest, RunOnce)
+{
+  ignition::sensors::Manager mgr;
+  mgr.AddPluginPaths(ignition::common::joinPaths(PROJECT_BUILD_PATH, "lib"));
+  mgr.SetParallelUpdate(GetParam());
+
+  // Sensors at 10 Hz, one updated every step and one at 100 Hz
+  std::vector<ignition::sensors::SensorId> slow;
+  for (int i = 0; i < 6; ++i)
+  {
+    auto *sensor = mgr.CreateSensor<ignition::sensors::AltimeterSensor>(
+        SensorToSDF("altimeter" + std::to_string(i), "altimeter", 10));
+    ASSERT_NE(nullptr, sensor);
+    EXPECT_TRUE(sensor->ConcurrentUpdate());
+    slow.push_back(sensor->Id());
+  }
+
+  auto *always = mgr.CreateSensor<ignition::sensors::ImuSensor>(
+      SensorToSDF("imu_always", "imu", 0));
+  ASSERT_NE(nullptr, always);
+  auto *fast = mgr.CreateSensor<ignition::sensors::ImuSensor>(
+      SensorToSDF("imu_fast", "imu", 100));
+  ASSERT_NE(nullptr, fast);
+
+  // One second of simulation at 1 kHz
+  for (int step = 0; step <= 1000; ++step)
+    mgr.RunOnce(ignition::common::Time(step * 0.001));
+
+  for (auto id : slow)
+  {
+    EXPECT_EQ(11u, mgr.UpdateStats(id).Count());
+    EXPECT_GE(mgr.UpdateStats(id).Map()["min"], 0.0);
+    EXPECT_EQ(ignition::common::Time(1.1), mgr.Sensor(id)->NextUpdateTime());
+  }
+  EXPECT_EQ(1001u, mgr.UpdateStats(always->Id()).Count());
+  EXPECT_EQ(101u, mgr.UpdateStats(fast->Id()).Count());
+
+  // Forced updates don't change the schedule.
+  mgr.RunOnce(ignition::common::Time(1.0005), true);
+  EXPECT_EQ(12u, mgr.UpdateStats(slow[0]).Count());
+  EXPECT_EQ(ignition::common::Time(1.1),
+      mgr.Sensor(slow[0])->NextUpdateTime());
+
+  mgr.RunOnce(ignition::common::Time(1.1));
+  EXPECT_EQ(13u, mgr.UpdateStats(slow[0]).Count());
+
+  // Removed sensors are not updated anymore.
+  EXPECT_TRUE(mgr.Remove(slow[1]));
+  EXPECT_EQ(0u, mgr.UpdateStats(slow[1]).Count());
+  mgr.RunOnce(ignition::common::Time(1.2));
+  EXPECT_EQ(14u, mgr.UpdateStats(slow[0]).Count());
+  EXPECT_EQ(nullptr, mgr.Sensor(slow[1]));
+}
+
+INSTANTIATE_TEST_CASE_P(ParallelUpdate, SensorManagerTest,
+    ::testing::Bool());
@@ -0,0 +1,147 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+#include <ignition/math/Helpers.hh>
+#include <ignition/math/Stopwatch.hh>
+
+#include "ignition/sensors/LidarPointCloud.hh"
+
+using namespace ignition;
+
+/// \brief Point layout used by GpuLidarSensor: x, y, z, intensity and ring,
+/// aligned to 8 bytes.
+static const uint32_t kPointStep = 32;
+
+/// \brief Convert a scan the way GpuLidarSensor did before LidarPointCloud,
+/// computing the trigonometric functions of each point.
+/// \param[in] _data Scan data with 3 channels.
+/// \param[in] _width Width of the scan.
+/// \param[in] _height Height of the scan.
+/// \param[in] _hfov Horizontal field of view.
+/// \param[in] _vfov Vertical field of view.
+/// \param[out] _buffer Output buffer.
+void fillReference(const float *_data, uint32_t _width, uint32_t _height,
+    double _hfov, double _vfov, char *_buffer)
+{
+  const uint32_t offsets[3] = {0, 4, 8};
+  float angleStep = _hfov / (_width - 1);
+  float verticalAngleStep = _vfov / (_height - 1);
+  float inclination = -_vfov / 2;
+
+  char *index = _buffer;
+  for (uint32_t j = 0; j < _height; ++j)
+  {
+    float azimuth = -_hfov / 2;
+    for (uint32_t i = 0; i < _width; ++i)
+    {
+      float depth = _data[(j * _width + i) * 3];
+      float intensity = _data[(j * _width + i) * 3 + 1];
+      uint16_t ring = static_cast<uint16_t>(j);
+
+      int fieldIndex = 0;
+      *reinterpret_cast<float *>(index + offsets[fieldIndex++]) =
+        depth * std::cos(inclination) * std::cos(azimuth);
+      *reinterpret_cast<float *>(index + offsets[fieldIndex++]) =
+        depth * std::cos(inclination) * std::sin(azimuth);
+      *reinterpret_cast<float *>(index + offsets[fieldIndex++]) =
+        depth * std::sin(inclination);
+      *reinterpret_cast<float *>(index + 16) = intensity;
+      *reinterpret_cast<uint16_t *>(index + 24) = ring;
+
+      index += kPointStep;
+      azimuth += angleStep;
+    }
+    inclination += verticalAngleStep;
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(LidarPointCloudPerformance, Fill)
+{
+  // A 2048x128 lidar at 10 Hz produces 2.6M points per second.
+  const uint32_t width = 2048;
+  const uint32_t height = 128;
+  const double hfov = 2 * IGN_PI - 2 * IGN_PI / width;
+  const double vfov = 0.8;
+  const int iterations = 20;
+
+  // Synthetic scan, with some rays that don't hit anything.
+  std::vector<float> data(width * height * 3);
+  for (uint32_t i = 0; i < width * height; ++i)
+  {
+    data[i * 3] = (i % 97 == 0) ? std::numeric_limits<float>::infinity() :
+      1.0f + (i % 1000) * 0.01f;
+    data[i * 3 + 1] = (i % 255) / 255.0f;
+    data[i * 3 + 2] = 0.0f;
+  }
+
+  sensors::LidarPointCloud cloud;
+  cloud.SetRays(math::Angle(-hfov / 2), math::Angle(hfov / 2), width,
+      math::Angle(-vfov / 2), math::Angle(vfov / 2), height);
+  cloud.SetFieldOffsets(kPointStep, 0, 4, 8, 16, 24);
+
+  std::vector<char> buffer(kPointStep * width * height);
+  std::vector<char> reference(kPointStep * width * height);
+
+  math::Stopwatch watch;
+  watch.Start(true);
+  for (int i = 0; i < iterations; ++i)
+    fillReference(data.data(), width, height, hfov, vfov, reference.data());
+  watch.Stop();
+  const double referenceTime = std::chrono::duration<double>(
+      watch.ElapsedRunTime()).count() / iterations;
+
+  watch.Start(true);
+  for (int i = 0; i < iterations; ++i)
+    cloud.Fill(data.data(), 3, buffer.data());
+  watch.Stop();
+  const double fillTime = std::chrono::duration<double>(
+      watch.ElapsedRunTime()).count() / iterations;
+
+  // Both versions produce the same points, up to the float error of the
+  // accumulated angles of the reference.
+  for (uint32_t p = 0; p < width * height; p += 13)
+  {
+    if (std::isinf(data[p * 3]))
+      continue;
+
+    for (uint32_t offset : {0u, 4u, 8u, 16u})
+    {
+      float expected;
+      float actual;
+      std::memcpy(&expected, reference.data() + p * kPointStep + offset, 4);
+      std::memcpy(&actual, buffer.data() + p * kPointStep + offset, 4);
+      EXPECT_NEAR(expected, actual, 1e-3 * (1.0f + std::fabs(expected)));
+    }
+  }
+  EXPECT_EQ(0, std::memcmp(reference.data() + 24, buffer.data() + 24, 2));
+
+  const double points = static_cast<double>(width) * height;
+  std::cout << "Points per scan: " << points << "\n"
+            << "Reference: " << referenceTime * 1e3 << " ms, "
+            << points / referenceTime * 1e-6 << " Mpoints/s\n"
+            << "LidarPointCloud: " << fillTime * 1e3 << " ms, "
+            << points / fillTime * 1e-6 << " Mpoints/s\n";
+}
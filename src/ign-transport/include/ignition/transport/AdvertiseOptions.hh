@@ -18,6 +18,7 @@
 #ifndef IGN_TRANSPORT_ADVERTISEOPTIONS_HH_
 #define IGN_TRANSPORT_ADVERTISEOPTIONS_HH_
 
+#include <chrono>
 #include <cstdint>
 #include <iostream>
 #include <memory>
@@ -193,6 +194,13 @@ namespace ignition
         else
           _out << "\tThrottled? No" << std::endl;
 
+        if (_other.Batched())
+        {
+          _out << "\tBatch window: " << std::chrono::duration_cast<
+            std::chrono::microseconds>(_other.BatchWindow()).count()
+               << " us" << std::endl;
+        }
+
         return _out;
       }
 
@@ -213,6 +221,29 @@ namespace ignition
       /// \param[in] _newMsgsPerSec Maximum number of messages per second.
       public: void SetMsgsPerSec(const uint64_t _newMsgsPerSec);
 
+      /// \brief Whether the publication is batched.
+      /// \return true when messages sent to remote subscribers are coalesced
+      /// or false otherwise.
+      /// \sa SetBatchWindow
+      /// \sa BatchWindow
+      public: bool Batched() const;
+
+      /// \brief Get the maximum time that a message can be held back while
+      /// it is coalesced with other messages of the same topic.
+      /// \return The batching window. A zero window means that batching is
+      /// disabled.
+      public: std::chrono::nanoseconds BatchWindow() const;
+
+      /// \brief Set the maximum time that a message can be held back while
+      /// it is coalesced with other messages of the same topic. All the
+      /// messages published within the window are sent to the remote
+      /// subscribers as a single frame and unbatched transparently before
+      /// being dispatched. Batching is only useful for small messages
+      /// published at a high rate (e.g.: > 1 kHz). Local subscribers are not
+      /// affected. Note that this option is not propagated through discovery.
+      /// \param[in] _window Batching window. A zero window disables batching.
+      public: void SetBatchWindow(const std::chrono::nanoseconds &_window);
+
       /// \brief Serialize the options. The caller has ownership of the
       /// buffer and is responsible for its [de]allocation.
       /// \param[out] _buffer Destination buffer in which the options
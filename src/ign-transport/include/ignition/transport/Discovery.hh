@@ -61,8 +61,10 @@
 #include <map>
 #include <memory>
 #include <mutex>
+#include <set>
 #include <string>
 #include <thread>
+#include <utility>
 #include <vector>
 
 #include "ignition/transport/config.hh"
@@ -109,6 +111,19 @@ namespace ignition
     /// discovery uses heartbeats to track the state of other peers in the
     /// network. The discovery clients can register callbacks to detect when
     /// new topics are discovered or topics are no longer available.
+    ///
+    /// Advertisements are sent incrementally: each process only broadcasts
+    /// the publishers that it advertises or unadvertises. Each heartbeat is
+    /// accompanied by a DIGEST message, with a sequence number and a digest
+    /// of the sender's publishers. When a receiver detects that its
+    /// information about a process is out of date, it sends a SYNC request
+    /// and the process answers with all its publishers. Messages forwarded to
+    /// unicast relays are aggregated into BUNDLE messages.
+    ///
+    /// DIGEST, SYNC and BUNDLE are message types that processes using a
+    /// previous release ignore, so the wire version is unchanged. While any
+    /// of these processes, which don't send digests, is alive, the
+    /// publishers are still re-advertised after every heartbeat.
     template<typename Pub>
     class Discovery
     {
@@ -251,6 +266,9 @@ namespace ignition
         if (this->threadReception.joinable())
           this->threadReception.join();
 
+        // Forward any discovery message still waiting for the relays.
+        this->FlushRelay();
+
         // Broadcast a BYE message to trigger the remote cancellation of
         // all our advertised topics.
         this->SendMsg(DestinationType::ALL, ByeType,
@@ -286,6 +304,7 @@ namespace ignition
         auto now = std::chrono::steady_clock::now();
         this->timeNextHeartbeat = now;
         this->timeNextActivity = now;
+        this->timeNextSync = now;
 
         // Start the thread that receives discovery information.
         this->threadReception = std::thread(&Discovery::RecvMessages, this);
@@ -306,6 +325,9 @@ namespace ignition
           // Add the addressing information (local publisher).
           if (!this->info.AddPublisher(_publisher))
             return false;
+
+          if (_publisher.Options().Scope() != Scope_t::PROCESS)
+            ++this->seq;
         }
 
         // Only advertise a message outside this process if the scope
@@ -416,6 +438,9 @@ namespace ignition
 
           // Remove the topic information.
           this->info.DelPublisherByNode(_topic, this->pUuid, _nUuid);
+
+          if (inf.Options().Scope() != Scope_t::PROCESS)
+            ++this->seq;
         }
 
         // Only unadvertise a message outside this process if the scope
@@ -607,6 +632,7 @@ namespace ignition
             {
               // Remove all the info entries for this process UUID.
               this->info.DelPublishersByProc(it->first);
+              this->remotes.erase(it->first);
 
               uuids.push_back(it->first);
 
@@ -647,15 +673,21 @@ namespace ignition
             return;
         }
 
+        // The digest summarizes our publishers. The other processes will
+        // request a SYNC if they missed any of our advertisements. It goes
+        // first, so that the heartbeat finds us known as a digest sender.
+        this->SendDigest();
+
         Publisher pub("", "", this->pUuid, "", AdvertiseOptions());
         this->SendMsg(DestinationType::ALL, HeartbeatType, pub);
 
+        // Processes that don't send digests don't request a SYNC either, and
+        // rely on the periodic re-advertisement of our topics instead.
         std::map<std::string, std::vector<Pub>> nodes;
         {
           std::lock_guard<std::mutex> lock(this->mutex);
-
-          // Re-advertise topics that are advertised inside this process.
-          this->info.PublishersByProc(this->pUuid, nodes);
+          if (this->LegacyPeers())
+            this->info.PublishersByProc(this->pUuid, nodes);
         }
 
         for (const auto &topic : nodes)
@@ -685,6 +717,54 @@ namespace ignition
         }
       }
 
+      /// \brief Answer the pending SYNC requests by advertising all the
+      /// publishers of this process. Requests received within half a
+      /// heartbeat interval are coalesced into a single answer, which bounds
+      /// the traffic when many processes join at the same time.
+      private: void UpdateSync()
+      {
+        Timestamp now = std::chrono::steady_clock::now();
+
+        std::map<std::string, std::vector<Pub>> nodes;
+        {
+          std::lock_guard<std::mutex> lock(this->mutex);
+
+          if (!this->syncPending || now < this->timeNextSync)
+            return;
+
+          this->syncPending = false;
+          ++this->numSyncs;
+          this->info.PublishersByProc(this->pUuid, nodes);
+
+          this->timeNextSync = now +
+            std::chrono::milliseconds(this->heartbeatInterval / 2);
+        }
+
+        for (const auto &topic : nodes)
+        {
+          for (const auto &node : topic.second)
+          {
+            if (node.Options().Scope() != Scope_t::PROCESS)
+              this->SendMsg(DestinationType::ALL, AdvType, node);
+          }
+        }
+
+        // The digest carries the new number of dumps, which tells the
+        // requesters that the dump is complete.
+        this->SendDigest();
+      }
+
+      /// \brief Forward the aggregated discovery messages to the relays if
+      /// they have been waiting for long enough.
+      protected: void UpdateRelay()
+      {
+        if (!this->relayBuffer.empty() &&
+            std::chrono::steady_clock::now() >= this->timeNextRelayFlush)
+        {
+          this->FlushRelay();
+        }
+      }
+
       /// \brief Calculate the next timeout. There are three main activities to
       /// perform by the discovery component:
       /// 1. Receive discovery messages.
@@ -700,9 +780,24 @@ namespace ignition
         auto timeUntilNextHeartbeat = this->timeNextHeartbeat - now;
         auto timeUntilNextActivity = this->timeNextActivity - now;
 
+        auto timeUntilNext =
+          std::min(timeUntilNextHeartbeat, timeUntilNextActivity);
+
+        {
+          std::lock_guard<std::mutex> lock(this->mutex);
+          if (this->syncPending)
+            timeUntilNext = std::min(timeUntilNext, this->timeNextSync - now);
+        }
+
+        if (!this->relayBuffer.empty())
+        {
+          timeUntilNext =
+            std::min(timeUntilNext, this->timeNextRelayFlush - now);
+        }
+
         int t = static_cast<int>(
           std::chrono::duration_cast<std::chrono::milliseconds>
-            (std::min(timeUntilNextHeartbeat, timeUntilNextActivity)).count());
+            (timeUntilNext).count());
         int t2 = std::min(t, this->kTimeout);
         return std::max(t2, 0);
       }
@@ -726,6 +821,8 @@ namespace ignition
 
           this->UpdateHeartbeat();
           this->UpdateActivity();
+          this->UpdateSync();
+          this->UpdateRelay();
 
           // Is it time to exit?
           {
@@ -745,11 +842,12 @@ namespace ignition
         sockaddr_in clntAddr;
         socklen_t addrLen = sizeof(clntAddr);
 
-        if ((recvfrom(this->sockets.at(0),
+        auto received = recvfrom(this->sockets.at(0),
               reinterpret_cast<raw_type *>(rcvStr),
               this->kMaxRcvStr, 0,
               reinterpret_cast<sockaddr *>(&clntAddr),
-              reinterpret_cast<socklen_t *>(&addrLen))) < 0)
+              reinterpret_cast<socklen_t *>(&addrLen));
+        if (received < 0)
         {
           std::cerr << "Discovery::RecvDiscoveryUpdate() recvfrom error"
                     << std::endl;
@@ -764,9 +862,62 @@ namespace ignition
                     << srcPort << std::endl;
         }
 
-        this->DispatchDiscoveryMsg(srcAddr, rcvStr);
+        this->DispatchDatagram(srcAddr, rcvStr, static_cast<size_t>(received));
       }
 
+      /// \brief Parse a datagram received via the UDP socket. It contains a
+      /// single discovery message, or a BUNDLE of messages forwarded by a
+      /// relay.
+      /// \param[in] _fromIp IP address of the datagram sender.
+      /// \param[in] _data Received datagram.
+      /// \param[in] _size Size of the datagram in bytes.
+      protected: void DispatchDatagram(const std::string &_fromIp,
+                                       char *_data,
+                                       const size_t _size)
+      {
+        // Entire length of the first message in octets.
+        uint16_t len;
+        if (_size <= sizeof(len))
+          return;
+        memcpy(&len, _data, sizeof(len));
+        if (len <= sizeof(len) || len > _size)
+          return;
+
+        Header header;
+        header.Unpack(_data + sizeof(len));
+        if (this->kWireVersion != header.Version() ||
+            header.Type() != BundleType)
+        {
+          this->DispatchDiscoveryMsg(_fromIp, _data);
+          return;
+        }
+
+        // The sender accepts BUNDLE messages too. Tell it that we do, the
+        // first time, in case it missed our probe.
+        if (this->bundleRelays.insert(_fromIp).second)
+        {
+          for (const auto &sockAddr : this->relayAddrs)
+          {
+            if (sockAddr.sin_addr.s_addr == inet_addr(_fromIp.c_str()))
+              this->SendBundleProbe(sockAddr);
+          }
+        }
+
+        // The body of a BUNDLE is a sequence of discovery messages, each of
+        // them starting with its own length.
+        size_t offset = sizeof(len) + header.HeaderLength();
+        const size_t end = len;
+        while (offset + sizeof(len) <= end)
+        {
+          uint16_t msgLen;
+          memcpy(&msgLen, _data + offset, sizeof(msgLen));
+          if (msgLen <= sizeof(msgLen) || offset + msgLen > end)
+            break;
+
+          this->DispatchDiscoveryMsg(_fromIp, _data + offset);
+          offset += msgLen;
+        }
+      }
 
       /// \brief Parse a discovery message received via the UDP socket
       /// \param[in] _fromIp IP address of the message sender.
@@ -828,7 +979,7 @@ namespace ignition
           flags |= FlagRelay;
           header.SetFlags(flags);
           header.Pack(headerPtr);
-          this->SendBytesUnicast(_msg, len);
+          this->QueueRelay(_msg, len);
         }
 
         // Update timestamp and cache the callbacks.
@@ -864,6 +1015,15 @@ namespace ignition
             {
               std::lock_guard<std::mutex> lock(this->mutex);
               added = this->info.AddPublisher(advMsg.Publisher());
+
+              // Remember the publishers confirmed by the remote process
+              // while we wait for the answer to a SYNC request.
+              auto remote = this->remotes.find(recvPUuid);
+              if (remote != this->remotes.end() && remote->second.awaitingSync)
+              {
+                remote->second.refreshed.emplace(
+                  advMsg.Publisher().Topic(), advMsg.Publisher().NUuid());
+              }
             }
 
             if (added && connectCb)
@@ -915,12 +1075,35 @@ namespace ignition
             // The timestamp has already been updated.
             break;
           }
+          case DigestType:
+          {
+            // Check that we know about all the publishers of the sender.
+            DigestMsg digestMsg;
+            digestMsg.Unpack(pBody);
+            this->CheckDigest(recvPUuid, _fromIp, digestMsg, disconnectCb);
+            break;
+          }
+          case SyncType:
+          {
+            SyncMsg syncMsg;
+            syncMsg.Unpack(pBody);
+
+            // Another process needs all our publishers. The answer is sent
+            // from UpdateSync().
+            if (syncMsg.Target() == this->pUuid)
+            {
+              std::lock_guard<std::mutex> lock(this->mutex);
+              this->syncPending = true;
+            }
+            break;
+          }
           case ByeType:
           {
             // Remove the activity entry for this publisher.
             {
               std::lock_guard<std::mutex> lock(this->mutex);
               this->activity.erase(recvPUuid);
+              this->remotes.erase(recvPUuid);
             }
 
             if (disconnectCb)
@@ -976,6 +1159,199 @@ namespace ignition
         }
       }
 
+      /// \brief Compare the digest received from a process with the
+      /// publishers that we know from the sender. If they differ, request a
+      /// SYNC. Once the sender has answered, drop the publishers that it
+      /// didn't confirm, as we missed their unadvertisement.
+      /// \param[in] _pUuid UUID of the process that sent the digest.
+      /// \param[in] _fromIp IP address of the message sender.
+      /// \param[in] _msg Received digest.
+      /// \param[in] _disconnectCb Callback executed for each dropped
+      /// publisher.
+      private: void CheckDigest(const std::string &_pUuid,
+                                const std::string &_fromIp,
+                                const DigestMsg &_msg,
+                                const DiscoveryCallback<Pub> &_disconnectCb)
+      {
+        std::vector<Pub> dropped;
+        bool requestSync = false;
+
+        {
+          std::lock_guard<std::mutex> lock(this->mutex);
+          auto &remote = this->remotes[_pUuid];
+
+          // Nothing changed since the last time that we were in sync.
+          if (remote.synced && remote.seq == _msg.Seq())
+            return;
+
+          // Publishers with scope HOST are only visible from the same host.
+          uint64_t expected = _msg.Digest();
+          if (_fromIp == this->hostAddr)
+            expected += _msg.HostDigest();
+
+          bool match = this->DigestByProc(_pUuid) == expected;
+
+          if (!match && remote.awaitingSync &&
+              _msg.Syncs() != remote.syncsAtRequest)
+          {
+            std::map<std::string, std::vector<Pub>> nodes;
+            this->info.PublishersByProc(_pUuid, nodes);
+            for (const auto &nodePubs : nodes)
+            {
+              for (const auto &pub : nodePubs.second)
+              {
+                if (remote.refreshed.count({pub.Topic(), pub.NUuid()}) > 0)
+                  continue;
+
+                this->info.DelPublisherByNode(pub.Topic(), _pUuid,
+                  pub.NUuid());
+                dropped.push_back(pub);
+              }
+            }
+
+            remote.awaitingSync = false;
+            match = this->DigestByProc(_pUuid) == expected;
+          }
+
+          if (match)
+          {
+            remote.seq = _msg.Seq();
+            remote.synced = true;
+            remote.awaitingSync = false;
+            remote.refreshed.clear();
+          }
+          else
+          {
+            // Keep requesting the publishers until we are in sync, in case
+            // the request or part of the answer were lost.
+            if (!remote.awaitingSync)
+            {
+              remote.awaitingSync = true;
+              remote.syncsAtRequest = _msg.Syncs();
+              remote.refreshed.clear();
+            }
+            remote.synced = false;
+            requestSync = true;
+          }
+        }
+
+        if (_disconnectCb)
+        {
+          for (const auto &pub : dropped)
+            _disconnectCb(pub);
+        }
+
+        if (requestSync)
+          this->SendSync(_pUuid);
+      }
+
+      /// \brief Compute the digest of the publishers that we know from a
+      /// given process. The digest is the sum of the publishers' hashes, so it
+      /// doesn't depend on the order in which they were stored. The caller
+      /// should hold the mutex.
+      /// \param[in] _pUuid Process UUID.
+      /// \return The digest.
+      private: uint64_t DigestByProc(const std::string &_pUuid) const
+      {
+        std::map<std::string, std::vector<Pub>> nodes;
+        this->info.PublishersByProc(_pUuid, nodes);
+
+        uint64_t digest = 0u;
+        for (const auto &topic : nodes)
+        {
+          for (const auto &node : topic.second)
+            digest += Hash(node);
+        }
+        return digest;
+      }
+
+      /// \brief Hash the serialized form of a publisher (64-bit FNV-1a).
+      /// \param[in] _pub Publisher.
+      /// \return The hash.
+      private: static uint64_t Hash(const Pub &_pub)
+      {
+        std::vector<char> buffer(_pub.MsgLength());
+        _pub.Pack(buffer.data());
+
+        uint64_t hash = 14695981039346656037ull;
+        for (const char c : buffer)
+        {
+          hash ^= static_cast<unsigned char>(c);
+          hash *= 1099511628211ull;
+        }
+        return hash;
+      }
+
+      /// \brief Whether any remote process doesn't send digests, as is the
+      /// case of the processes using a previous release. The caller should
+      /// hold the mutex.
+      /// \return True if there is at least one such process.
+      private: bool LegacyPeers() const
+      {
+        for (const auto &entry : this->activity)
+        {
+          if (this->remotes.find(entry.first) == this->remotes.end())
+            return true;
+        }
+        return false;
+      }
+
+      /// \brief Broadcast the digest of our publishers.
+      private: void SendDigest() const
+      {
+        DigestMsg digestMsg;
+        {
+          std::lock_guard<std::mutex> lock(this->mutex);
+
+          std::map<std::string, std::vector<Pub>> nodes;
+          this->info.PublishersByProc(this->pUuid, nodes);
+
+          uint64_t digest = 0u;
+          uint64_t hostDigest = 0u;
+          for (const auto &topic : nodes)
+          {
+            for (const auto &node : topic.second)
+            {
+              if (node.Options().Scope() == Scope_t::ALL)
+                digest += Hash(node);
+              else if (node.Options().Scope() == Scope_t::HOST)
+                hostDigest += Hash(node);
+            }
+          }
+
+          digestMsg = DigestMsg(
+            Header(this->Version(), this->pUuid, DigestType),
+            this->seq, digest, hostDigest, this->numSyncs);
+        }
+
+        uint16_t lengthField = 0u;
+        std::vector<char> buffer(digestMsg.MsgLength() + sizeof(lengthField));
+        digestMsg.Pack(&buffer[sizeof(lengthField)]);
+        this->SendBuffer(DestinationType::ALL, digestMsg.Header(), buffer);
+
+        if (this->verbose)
+          std::cout << "\t* Sending " << MsgTypesStr[DigestType] << " msg\n";
+      }
+
+      /// \brief Request all the publishers advertised by a process.
+      /// \param[in] _target UUID of the process.
+      private: void SendSync(const std::string &_target) const
+      {
+        SyncMsg syncMsg(Header(this->Version(), this->pUuid, SyncType),
+          _target);
+
+        uint16_t lengthField = 0u;
+        std::vector<char> buffer(syncMsg.MsgLength() + sizeof(lengthField));
+        syncMsg.Pack(&buffer[sizeof(lengthField)]);
+        this->SendBuffer(DestinationType::ALL, syncMsg.Header(), buffer);
+
+        if (this->verbose)
+        {
+          std::cout << "\t* Sending " << MsgTypesStr[SyncType]
+                    << " msg [" << _target << "]" << std::endl;
+        }
+      }
+
       /// \brief Broadcast a discovery message.
       /// \param[in] _type Message type.
       /// \param[in] _pub Publishers's information to send.
@@ -1032,14 +1408,32 @@ namespace ignition
             return;
         }
 
-        lengthField = static_cast<uint16_t>(buffer.size());
-        memcpy(&buffer[0], &lengthField, sizeof(lengthField));
-        char *headerPtr = &buffer[0] + sizeof(lengthField);
+        this->SendBuffer(_destType, header, buffer);
+
+        if (this->verbose)
+        {
+          std::cout << "\t* Sending " << MsgTypesStr[_type]
+                    << " msg [" << topic << "]" << std::endl;
+        }
+      }
+
+      /// \brief Send a serialized discovery message.
+      /// \param[in] _destType Destination of the message.
+      /// \param[in] _header Header of the message.
+      /// \param[in, out] _buffer Serialized message, preceded by room for the
+      /// length field.
+      private: void SendBuffer(const DestinationType &_destType,
+                               Header _header,
+                               std::vector<char> &_buffer) const
+      {
+        uint16_t lengthField = static_cast<uint16_t>(_buffer.size());
+        memcpy(&_buffer[0], &lengthField, sizeof(lengthField));
+        char *headerPtr = &_buffer[0] + sizeof(lengthField);
 
         if (_destType == DestinationType::MULTICAST ||
             _destType == DestinationType::ALL)
         {
-          this->SendBytesMulticast(&buffer[0], buffer.size());
+          this->SendBytesMulticast(&_buffer[0], lengthField);
         }
 
         // Send the discovery message to the unicast relays.
@@ -1047,18 +1441,105 @@ namespace ignition
             _destType == DestinationType::ALL)
         {
           // Set the RELAY flag in the header.
-          uint16_t flags = header.Flags();
+          uint16_t flags = _header.Flags();
           flags |= FlagRelay;
-          header.SetFlags(flags);
-          header.Pack(headerPtr);
-          this->SendBytesUnicast(&buffer[0], buffer.size());
+          _header.SetFlags(flags);
+          _header.Pack(headerPtr);
+          this->SendBytesUnicast(&_buffer[0], lengthField);
         }
+      }
 
-        if (this->verbose)
+      /// \brief Queue a discovery message for the unicast relays. The queued
+      /// messages are sent together in a single BUNDLE message.
+      /// \param[in] _msg Serialized message, starting with its length.
+      /// \param[in] _len Length in bytes.
+      protected: void QueueRelay(const char *_msg, const uint16_t _len)
+      {
+        if (this->relayAddrs.empty())
+          return;
+
+        const Header header = this->BundleHeader();
+        const size_t headerLength = sizeof(_len) + header.HeaderLength();
+
+        // Keep the order of the messages.
+        if (this->relayBuffer.size() + _len > this->kMaxRelayBundle ||
+            headerLength + _len > this->kMaxRelayBundle)
         {
-          std::cout << "\t* Sending " << MsgTypesStr[_type]
-                    << " msg [" << topic << "]" << std::endl;
+          this->FlushRelay();
         }
+
+        // A message too large to share a datagram is forwarded on its own.
+        if (headerLength + _len > this->kMaxRelayBundle)
+        {
+          std::vector<char> buffer(_msg, _msg + _len);
+          this->SendBytesUnicast(buffer.data(), _len);
+          return;
+        }
+
+        if (this->relayBuffer.empty())
+        {
+          this->relayBuffer.resize(headerLength);
+          header.Pack(&this->relayBuffer[sizeof(_len)]);
+          this->timeNextRelayFlush = std::chrono::steady_clock::now() +
+            std::chrono::milliseconds(this->kRelayFlushInterval);
+        }
+
+        this->relayBuffer.insert(this->relayBuffer.end(), _msg, _msg + _len);
+      }
+
+      /// \brief Send the queued discovery messages to the unicast relays, in
+      /// a BUNDLE to the relays known to accept them and one by one to the
+      /// others.
+      private: void FlushRelay()
+      {
+        if (this->relayBuffer.empty())
+          return;
+
+        uint16_t len = static_cast<uint16_t>(this->relayBuffer.size());
+        memcpy(&this->relayBuffer[0], &len, sizeof(len));
+        const size_t headerLength =
+          sizeof(len) + this->BundleHeader().HeaderLength();
+
+        for (const auto &sockAddr : this->relayAddrs)
+        {
+          if (this->bundleRelays.count(inet_ntoa(sockAddr.sin_addr)) > 0)
+          {
+            this->SendBytesTo(sockAddr, this->relayBuffer.data(), len);
+            continue;
+          }
+
+          size_t offset = headerLength;
+          while (offset < this->relayBuffer.size())
+          {
+            uint16_t msgLen;
+            memcpy(&msgLen, &this->relayBuffer[offset], sizeof(msgLen));
+            this->SendBytesTo(sockAddr, &this->relayBuffer[offset], msgLen);
+            offset += msgLen;
+          }
+        }
+
+        this->relayBuffer.clear();
+      }
+
+      /// \brief Header of the BUNDLE messages that we send. Processes that
+      /// receive them don't forward them.
+      /// \return The header.
+      private: Header BundleHeader() const
+      {
+        return Header(this->Version(), this->pUuid, BundleType, FlagNoRelay);
+      }
+
+      /// \brief Tell a relay that we accept BUNDLE messages by sending it an
+      /// empty one. Processes using a previous release ignore it.
+      /// \param[in] _sockAddr Address of the relay.
+      private: void SendBundleProbe(const sockaddr_in &_sockAddr) const
+      {
+        const Header header = this->BundleHeader();
+        std::vector<char> buffer(sizeof(uint16_t) + header.HeaderLength());
+        uint16_t len = static_cast<uint16_t>(buffer.size());
+        memcpy(&buffer[0], &len, sizeof(len));
+        header.Pack(&buffer[sizeof(len)]);
+        this->SendBytesTo(_sockAddr, buffer.data(), len);
       }
 
       /// \brief Send bytes through all unicast relays.
@@ -1070,21 +1551,35 @@ namespace ignition
         // Send the discovery message to the unicast relays.
         for (const auto &sockAddr : this->relayAddrs)
         {
-          auto sent = sendto(this->sockets.at(0),
-            reinterpret_cast<const raw_type *>(
-              reinterpret_cast<const unsigned char*>(_buffer)),
-            _len, 0,
-            reinterpret_cast<const sockaddr *>(&sockAddr),
-            sizeof(sockAddr));
-
-          if (sent != _len)
-          {
-            std::cerr << "Exception sending a unicast message" << std::endl;
+          if (!this->SendBytesTo(sockAddr, _buffer, _len))
             return;
-          }
         }
       }
 
+      /// \brief Send bytes to a unicast address.
+      /// \param[in] _sockAddr Destination address.
+      /// \param[in] _buffer Data.
+      /// \param[in] _len Length in bytes.
+      /// \return True if the bytes were sent.
+      private: bool SendBytesTo(const sockaddr_in &_sockAddr,
+                                const char *_buffer,
+                                uint16_t _len) const
+      {
+        auto sent = sendto(this->sockets.at(0),
+          reinterpret_cast<const raw_type *>(
+            reinterpret_cast<const unsigned char*>(_buffer)),
+          _len, 0,
+          reinterpret_cast<const sockaddr *>(&_sockAddr),
+          sizeof(_sockAddr));
+
+        if (sent != _len)
+        {
+          std::cerr << "Exception sending a unicast message" << std::endl;
+          return false;
+        }
+        return true;
+      }
+
       /// \brief Send bytes through the multicast group.
       /// \param[in] _buffer Data.
       /// \param[in] _len Length in bytes.
@@ -1135,7 +1630,7 @@ namespace ignition
 
       /// \brief Get the discovery protocol version.
       /// \return The discovery version.
-      private: uint8_t Version() const
+      protected: uint8_t Version() const
       {
         return this->kWireVersion;
       }
@@ -1205,6 +1700,7 @@ namespace ignition
         addr.sin_port = htons(static_cast<u_short>(this->port));
 
         this->relayAddrs.push_back(addr);
+        this->SendBundleProbe(addr);
       }
 
       /// \brief Default activity interval value (ms.).
@@ -1231,6 +1727,14 @@ namespace ignition
       /// \brief Longest string to receive.
       private: static const int kMaxRcvStr = 65536;
 
+      /// \brief Largest datagram aggregated for the unicast relays. It fits in
+      /// a typical Ethernet MTU to avoid IP fragmentation.
+      protected: static const size_t kMaxRelayBundle = 1400;
+
+      /// \brief Maximum time that a message waits to be forwarded to the
+      /// unicast relays (ms.).
+      private: static const unsigned int kRelayFlushInterval = 10;
+
       /// \brief Wire protocol version. Bump up the version number if you modify
       /// the wire protocol (for discovery or message/service exchange).
       private: static const uint8_t kWireVersion = 9;
@@ -1289,6 +1793,57 @@ namespace ignition
       /// \brief Collection of socket addresses used as remote relays.
       private: std::vector<sockaddr_in> relayAddrs;
 
+      /// \brief BUNDLE message waiting to be forwarded to the relays, whose
+      /// length field is set when it's sent.
+      protected: std::vector<char> relayBuffer;
+
+      /// \brief IP addresses of the processes known to accept BUNDLE
+      /// messages.
+      private: std::set<std::string> bundleRelays;
+
+      /// \brief Time at which the queued relay messages will be sent.
+      private: Timestamp timeNextRelayFlush;
+
+      /// \brief What we know about the advertisements of a remote process.
+      private: struct RemoteState
+      {
+        /// \brief Last sequence number for which our information matched the
+        /// digest of the remote process.
+        uint64_t seq = 0u;
+
+        /// \brief True if our information matched the last digest received.
+        bool synced = false;
+
+        /// \brief True while we wait for the answer to a SYNC request.
+        bool awaitingSync = false;
+
+        /// \brief Number of dumps sent by the remote process when we
+        /// requested the SYNC.
+        uint32_t syncsAtRequest = 0u;
+
+        /// \brief Topic and node UUID of the publishers advertised by the
+        /// remote process since we requested the SYNC.
+        std::set<std::pair<std::string, std::string>> refreshed;
+      };
+
+      /// \brief Advertisement state of the remote processes. The key is the
+      /// process UUID.
+      private: std::map<std::string, RemoteState> remotes;
+
+      /// \brief Sequence number of our advertisements. It is incremented each
+      /// time that a publisher of this process is advertised or unadvertised.
+      private: uint64_t seq = 0u;
+
+      /// \brief Number of times that we sent all our publishers to answer a
+      /// SYNC request.
+      private: uint32_t numSyncs = 0u;
+
+      /// \brief True when a remote process requested all our publishers.
+      private: bool syncPending = false;
+
+      /// \brief Earliest time at which we can answer the next SYNC request.
+      private: Timestamp timeNextSync;
+
       /// \brief Mutex to guarantee exclusive access between the threads.
       private: mutable std::mutex mutex;
 
@@ -26,6 +26,7 @@
 #pragma warning(pop)
 #endif
 
+#include <chrono>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -88,6 +89,31 @@ namespace ignition
                            DeallocFunc *_ffn,
                            const std::string &_msgType);
 
+      /// \brief Queue data to be published as part of a batch. All the data
+      /// queued for the same topic and message type within the batching
+      /// window is coalesced and sent as a single frame. The receiving side
+      /// unbatches the frame transparently in RecvMsgUpdate().
+      /// \param[in] _topic Topic to be published.
+      /// \param[in] _data Serialized data. The data is copied.
+      /// \param[in] _dataSize Data size (bytes).
+      /// \param[in] _msgType Message type in string format.
+      /// \param[in] _window Maximum time that the data can be held back.
+      /// \return true when success or false otherwise.
+      public: bool PublishBatched(const std::string &_topic,
+                                  const char *_data,
+                                  const size_t _dataSize,
+                                  const std::string &_msgType,
+                                  const std::chrono::nanoseconds &_window);
+
+      /// \brief Start the thread publishing the batched messages, unless it
+      /// is already running. Called when a batched topic is advertised.
+      public: void EnableBatching();
+
+      /// \brief Publish the batches whose window has expired or which are
+      /// full. This method runs in its own thread until the NodeShared object
+      /// is destroyed.
+      public: void RunBatchTask();
+
       /// \brief Method in charge of receiving the topic updates.
       public: void RecvMsgUpdate();
 
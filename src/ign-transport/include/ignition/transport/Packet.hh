@@ -43,6 +43,9 @@ namespace ignition
     static const uint8_t ByeType        = 5;
     static const uint8_t NewConnection  = 6;
     static const uint8_t EndConnection  = 7;
+    static const uint8_t SyncType       = 8;
+    static const uint8_t DigestType     = 9;
+    static const uint8_t BundleType     = 10;
 
     // Flag set when a discovery message is relayed.
     static const uint16_t FlagRelay   = 0b000000000000'0001;
@@ -54,7 +57,7 @@ namespace ignition
     static const std::vector<std::string> MsgTypesStr =
     {
       "UNINITIALIZED", "ADVERTISE", "SUBSCRIBE", "UNADVERTISE", "HEARTBEAT",
-      "BYE", "NEW_CONNECTION", "END_CONNECTION"
+      "BYE", "NEW_CONNECTION", "END_CONNECTION", "SYNC", "DIGEST", "BUNDLE"
     };
 
     /// \class Header Packet.hh ignition/transport/Packet.hh
@@ -248,6 +251,205 @@ namespace ignition
 #endif
     };
 
+    /// \class DigestMsg Packet.hh ignition/transport/Packet.hh
+    /// \brief Digest packet used in the discovery protocol. Sent along with
+    /// each heartbeat, it summarizes the sender's advertised publishers with
+    /// a sequence number and a digest, so the receivers can detect missed
+    /// advertisements without a periodic dump of every publisher.
+    class IGNITION_TRANSPORT_VISIBLE DigestMsg
+    {
+      /// \brief Constructor.
+      public: DigestMsg() = default;
+
+      /// \brief Constructor.
+      /// \param[in] _header Message header.
+      /// \param[in] _seq Sequence number of the sender's advertisements.
+      /// \param[in] _digest Digest of the publishers with scope ALL.
+      /// \param[in] _hostDigest Digest of the publishers with scope HOST.
+      /// \param[in] _syncs Number of full advertisement dumps sent.
+      public: DigestMsg(const transport::Header &_header,
+                        const uint64_t _seq,
+                        const uint64_t _digest,
+                        const uint64_t _hostDigest,
+                        const uint32_t _syncs);
+
+      /// \brief Get the message header.
+      /// \return Reference to the message header.
+      /// \sa SetHeader.
+      public: transport::Header Header() const;
+
+      /// \brief Get the sequence number. The sender increments it each time
+      /// it advertises or unadvertises a publisher.
+      /// \return The sequence number.
+      /// \sa SetSeq.
+      public: uint64_t Seq() const;
+
+      /// \brief Get the digest of the sender's publishers with scope ALL.
+      /// \return The digest.
+      /// \sa SetDigest.
+      public: uint64_t Digest() const;
+
+      /// \brief Get the digest of the sender's publishers with scope HOST.
+      /// \return The digest.
+      /// \sa SetHostDigest.
+      public: uint64_t HostDigest() const;
+
+      /// \brief Get the number of full advertisement dumps that the sender
+      /// has sent in response to SYNC requests.
+      /// \return The number of dumps.
+      /// \sa SetSyncs.
+      public: uint32_t Syncs() const;
+
+      /// \brief Set the header of the message.
+      /// \param[in] _header Message header.
+      /// \sa Header.
+      public: void SetHeader(const transport::Header &_header);
+
+      /// \brief Set the sequence number.
+      /// \param[in] _seq The sequence number.
+      /// \sa Seq.
+      public: void SetSeq(const uint64_t _seq);
+
+      /// \brief Set the digest of the publishers with scope ALL.
+      /// \param[in] _digest The digest.
+      /// \sa Digest.
+      public: void SetDigest(const uint64_t _digest);
+
+      /// \brief Set the digest of the publishers with scope HOST.
+      /// \param[in] _digest The digest.
+      /// \sa HostDigest.
+      public: void SetHostDigest(const uint64_t _digest);
+
+      /// \brief Set the number of full advertisement dumps.
+      /// \param[in] _syncs The number of dumps.
+      /// \sa Syncs.
+      public: void SetSyncs(const uint32_t _syncs);
+
+      /// \brief Get the total length of the message.
+      /// \return Return the length of the message in bytes.
+      public: size_t MsgLength() const;
+
+      /// \brief Stream insertion operator.
+      /// \param[out] _out The output stream.
+      /// \param[in] _msg DigestMsg message to write to the stream.
+      public: friend std::ostream &operator<<(std::ostream &_out,
+                                              const DigestMsg &_msg)
+      {
+        _out << _msg.Header()
+             << "Body:" << std::endl
+             << "\tSeq: " << _msg.Seq() << std::endl
+             << "\tDigest: " << _msg.Digest() << std::endl
+             << "\tHost digest: " << _msg.HostDigest() << std::endl
+             << "\tSyncs: " << _msg.Syncs() << std::endl;
+
+        return _out;
+      }
+
+      /// \brief Serialize the digest message.
+      /// \param[out] _buffer Buffer where the message will be serialized.
+      /// \return The length of the serialized message in bytes.
+      public: size_t Pack(char *_buffer) const;
+
+      /// \brief Unserialize a stream of bytes into a DigestMsg.
+      /// \param[out] _buffer Unpack the body from the buffer.
+      /// \return The number of bytes from the body.
+      public: size_t Unpack(const char *_buffer);
+
+      /// \brief Message header.
+      private: transport::Header header;
+
+      /// \brief Sequence number of the sender's advertisements.
+      private: uint64_t seq = 0;
+
+      /// \brief Digest of the publishers with scope ALL.
+      private: uint64_t digest = 0;
+
+      /// \brief Digest of the publishers with scope HOST.
+      private: uint64_t hostDigest = 0;
+
+      /// \brief Number of full advertisement dumps sent.
+      private: uint32_t syncs = 0;
+    };
+
+    /// \class SyncMsg Packet.hh ignition/transport/Packet.hh
+    /// \brief Sync packet used in the discovery protocol for requesting all
+    /// the publishers advertised by a given process. It is sent when the
+    /// digest received from that process doesn't match the local
+    /// information.
+    class IGNITION_TRANSPORT_VISIBLE SyncMsg
+    {
+      /// \brief Constructor.
+      public: SyncMsg() = default;
+
+      /// \brief Constructor.
+      /// \param[in] _header Message header.
+      /// \param[in] _target UUID of the process that should send its state.
+      public: SyncMsg(const transport::Header &_header,
+                      const std::string &_target);
+
+      /// \brief Get the message header.
+      /// \return Reference to the message header.
+      /// \sa SetHeader.
+      public: transport::Header Header() const;
+
+      /// \brief Get the UUID of the process that should send its state.
+      /// \return Process UUID.
+      /// \sa SetTarget.
+      public: std::string Target() const;
+
+      /// \brief Set the header of the message.
+      /// \param[in] _header Message header.
+      /// \sa Header.
+      public: void SetHeader(const transport::Header &_header);
+
+      /// \brief Set the UUID of the process that should send its state.
+      /// \param[in] _target Process UUID.
+      /// \sa Target.
+      public: void SetTarget(const std::string &_target);
+
+      /// \brief Get the total length of the message.
+      /// \return Return the length of the message in bytes.
+      public: size_t MsgLength() const;
+
+      /// \brief Stream insertion operator.
+      /// \param[out] _out The output stream.
+      /// \param[in] _msg SyncMsg message to write to the stream.
+      public: friend std::ostream &operator<<(std::ostream &_out,
+                                              const SyncMsg &_msg)
+      {
+        _out << _msg.Header()
+             << "Body:" << std::endl
+             << "\tTarget: [" << _msg.Target() << "]" << std::endl;
+
+        return _out;
+      }
+
+      /// \brief Serialize the sync message.
+      /// \param[out] _buffer Buffer where the message will be serialized.
+      /// \return The length of the serialized message in bytes.
+      public: size_t Pack(char *_buffer) const;
+
+      /// \brief Unserialize a stream of bytes into a SyncMsg.
+      /// \param[out] _buffer Unpack the body from the buffer.
+      /// \return The number of bytes from the body.
+      public: size_t Unpack(const char *_buffer);
+
+      /// \brief Message header.
+      private: transport::Header header;
+
+#ifdef _WIN32
+// Disable warning C4251 which is triggered by
+// std::string
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+      /// \brief Target process UUID.
+      private: std::string target = "";
+#ifdef _WIN32
+#pragma warning(pop)
+#endif
+    };
+
     /// \class AdvertiseMessage Packet.hh ignition/transport/Packet.hh
     /// \brief Advertise packet used in the discovery protocol to broadcast
     /// information about the node advertising a topic. The information sent
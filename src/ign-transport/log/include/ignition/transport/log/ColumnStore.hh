@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef IGNITION_TRANSPORT_LOG_COLUMNSTORE_HH_
+#define IGNITION_TRANSPORT_LOG_COLUMNSTORE_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <ignition/transport/config.hh>
+#include <ignition/transport/log/Export.hh>
+#include <ignition/transport/log/Log.hh>
+#include <ignition/transport/log/QueryOptions.hh>
+
+namespace ignition
+{
+  namespace transport
+  {
+    namespace log
+    {
+      // Inline bracket to help doxygen filtering.
+      inline namespace IGNITION_TRANSPORT_VERSION_NAMESPACE {
+      //
+      /// \brief Columnar, memory-mapped copy of the numeric data in a log.
+      ///
+      /// Export() parses every message of a log once and writes each numeric
+      /// field of each topic to its own column file inside a directory.
+      /// Field names are the protobuf field paths, with the index of repeated
+      /// fields in brackets, e.g. "pose[0].position.x". A column has one
+      /// value per message of its topic, so the values of all the columns of
+      /// a topic line up with its Times(). Floating point fields are stored
+      /// as double and filled with NaN where a message lacks the field. All
+      /// other numeric fields, including bools and enums, are stored as
+      /// int64_t and filled with 0.
+      ///
+      /// Open() maps the column files, so reading a column requires no
+      /// parsing and no copy.
+      class IGNITION_TRANSPORT_LOG_VISIBLE ColumnStore
+      {
+        /// \brief Constructor
+        public: ColumnStore();
+
+        /// \brief Move constructor
+        /// \param[in] _old the instance being moved into this one
+        public: ColumnStore(ColumnStore &&_old);  // NOLINT
+
+        /// \brief Destructor. Unmaps the column files.
+        public: ~ColumnStore();
+
+        /// \brief Write the numeric fields of the messages in a log to a
+        /// directory of column files. Messages whose type is unknown to
+        /// this process are skipped.
+        /// \param[in] _log An open log
+        /// \param[in] _directory Directory to write to. It is created if
+        /// needed, and must not already contain an export.
+        /// \param[in] _options Messages to export
+        /// \return true if the export succeeded
+        public: static bool Export(Log &_log, const std::string &_directory,
+            const QueryOptions &_options = AllTopics());
+
+        /// \brief Map the columns exported to a directory
+        /// \param[in] _directory Directory given to Export()
+        /// \return true if the columns were mapped
+        public: bool Open(const std::string &_directory);
+
+        /// \brief Check if the columns were opened successfully
+        /// \return true if Open() succeeded
+        public: bool Valid() const;
+
+        /// \brief Get the exported topics
+        /// \return The topic names
+        public: std::vector<std::string> Topics() const;
+
+        /// \brief Get the fields exported for a topic
+        /// \param[in] _topic Topic name
+        /// \return The field names, empty if the topic was not exported
+        public: std::vector<std::string> Fields(
+            const std::string &_topic) const;
+
+        /// \brief Get the number of messages exported for a topic, which is
+        /// the length of each of its columns
+        /// \param[in] _topic Topic name
+        /// \return The number of messages
+        public: std::size_t Size(const std::string &_topic) const;
+
+        /// \brief Get the time each message of a topic was received
+        /// \param[in] _topic Topic name
+        /// \return Size(_topic) times in nanoseconds, or nullptr if the topic
+        /// was not exported
+        public: const int64_t *Times(const std::string &_topic) const;
+
+        /// \brief Get a floating point column
+        /// \param[in] _topic Topic name
+        /// \param[in] _field Field name
+        /// \return Size(_topic) values, or nullptr if there is no floating
+        /// point column for the field
+        public: const double *Doubles(const std::string &_topic,
+            const std::string &_field) const;
+
+        /// \brief Get an integer column
+        /// \param[in] _topic Topic name
+        /// \param[in] _field Field name
+        /// \return Size(_topic) values, or nullptr if there is no integer
+        /// column for the field
+        public: const int64_t *Integers(const std::string &_topic,
+            const std::string &_field) const;
+
+        /// \internal Implementation for this class
+        private: class Implementation;
+
+#ifdef _WIN32
+// Disable warning C4251 which is triggered by
+// std::*
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+        /// \brief Private implementation
+        private: std::unique_ptr<Implementation> dataPtr;
+#ifdef _WIN32
+#pragma warning(pop)
+#endif
+      };
+      }
+    }
+  }
+}
+#endif
@@ -96,6 +96,65 @@ namespace ignition
             const std::string &_topic, const std::string &_type,
             const void *_data, std::size_t _len);
 
+        /// \brief Set how long a transaction stays open before it is
+        /// committed. Messages inserted within the period are committed
+        /// together, so longer periods increase the insertion rate at the
+        /// cost of losing more data if the process crashes. Defaults to
+        /// 500 ms.
+        /// \param[in] _period Duration of a transaction
+        public: void SetTransactionPeriod(
+            const std::chrono::milliseconds &_period);
+
+        /// \brief Get how long a transaction stays open before it is
+        /// committed.
+        /// \return Duration of a transaction
+        public: std::chrono::milliseconds TransactionPeriod() const;
+
+        /// \brief Set the SQLite journal mode of an open log.
+        /// "WAL" usually gives the best insertion rate while recording.
+        /// \param[in] _mode One of "DELETE", "TRUNCATE", "PERSIST", "MEMORY",
+        /// "WAL" or "OFF".
+        /// \return true if the journal mode was changed
+        /// \sa https://www.sqlite.org/pragma.html#pragma_journal_mode
+        public: bool SetJournalMode(const std::string &_mode);
+
+        /// \brief Set the SQLite synchronous level of an open log.
+        /// \param[in] _level One of "OFF", "NORMAL", "FULL" or "EXTRA".
+        /// \return true if the synchronous level was changed
+        /// \sa https://www.sqlite.org/pragma.html#pragma_synchronous
+        public: bool SetSynchronous(const std::string &_level);
+
+        /// \brief Store message data compressed, in chunks of consecutive
+        /// messages of the same topic. Must be called on a log opened for
+        /// writing, before any message is inserted. Messages are written
+        /// once their chunk is full, once the chunk period has passed since
+        /// the first message of the chunk (checked when inserting messages),
+        /// or when the log is closed, so they are not visible to queries
+        /// before then. Reading compressed logs requires no configuration,
+        /// and decompresses a whole chunk to read any of its messages.
+        /// \param[in] _codec Compression codec. Only "zlib" is supported.
+        /// \param[in] _chunkSize Uncompressed size, in bytes, at which a
+        /// chunk is compressed and written. Must be less than 4 GiB.
+        /// \return true if compression was enabled
+        /// \sa SetChunkPeriod
+        public: bool SetCompression(const std::string &_codec,
+            std::size_t _chunkSize = 1024 * 1024);
+
+        /// \brief Get the codec used to compress new messages.
+        /// \return The codec, or an empty string if compression is disabled
+        public: std::string Compression() const;
+
+        /// \brief Set the time after which a compressed chunk is written
+        /// even if it isn't full. Defaults to 1 second.
+        /// \param[in] _period Period of time
+        /// \sa SetCompression
+        public: void SetChunkPeriod(const std::chrono::milliseconds &_period);
+
+        /// \brief Get the time after which a compressed chunk is written
+        /// even if it isn't full.
+        /// \return Period of time
+        public: std::chrono::milliseconds ChunkPeriod() const;
+
         /// \brief Get messages according to the specified options. By default,
         /// it will query all messages over the entire time range of the log.
         /// \param[in] _options A QueryOptions type to indicate what kind of
@@ -101,6 +101,26 @@ namespace ignition
         /// not been successfully called.
         public: std::string Filename() const;
 
+        /// \brief Set the maximum amount of message data waiting to be
+        /// written to the log file. When the disk can't keep up with the
+        /// incoming messages, the messages which don't fit are dropped and
+        /// counted by DroppedMessages(), so that memory stays bounded.
+        /// \param[in] _bytes Maximum size of the queued messages, in bytes.
+        /// The default is 64 MiB.
+        public: void SetMaxQueueSize(const std::size_t _bytes);
+
+        /// \brief Get the maximum amount of message data waiting to be
+        /// written to the log file.
+        /// \return Maximum size of the queued messages, in bytes.
+        /// \sa SetMaxQueueSize
+        public: std::size_t MaxQueueSize() const;
+
+        /// \brief Get the number of messages dropped because the queue of
+        /// messages waiting to be written was full.
+        /// \return Number of messages dropped since recording last started.
+        /// \sa SetMaxQueueSize
+        public: uint64_t DroppedMessages() const;
+
         /// \brief Get the set of topics have have been added.
         /// \return The set of topic names that have been added using the
         /// AddTopic functions.
@@ -0,0 +1,43 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+/* Migrates a 0.1.0 database to 0.2.0, which stores message data in
+   compressed chunks. In a 0.2.0 database, messages.message holds a reference
+   to a message inside a chunk rather than the message itself. */
+
+/* Contains the data of consecutive messages of one topic, compressed */
+CREATE TABLE chunks (
+  /* Uniquely identifies a row in this table. Sqlite3 will make it an alias of rowid. */
+  id INTEGER PRIMARY KEY AUTOINCREMENT,
+  /* Topic of all the messages in this chunk */
+  topic_id REFERENCES topics (id) ON DELETE CASCADE,
+  /* Time the first message in the chunk was received (utc nanoseconds) */
+  time_start INTEGER NOT NULL,
+  /* Time the last message in the chunk was received (utc nanoseconds) */
+  time_end INTEGER NOT NULL,
+  /* Compression codec (e.g. zlib) */
+  codec TEXT NOT NULL,
+  /* Size of the data once uncompressed */
+  raw_size INTEGER NOT NULL,
+  /* Compressed message data, concatenated */
+  data BLOB NOT NULL
+);
+
+/* Index of the chunks of each topic by time */
+CREATE INDEX idx_chunk_time ON chunks (topic_id, time_start);
+
+INSERT INTO migrations (from_version, to_version) VALUES ('0.1.0', '0.2.0');
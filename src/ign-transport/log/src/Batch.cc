@@ -28,8 +28,10 @@ using namespace ignition::transport::log;
 
 //////////////////////////////////////////////////
 BatchPrivate::BatchPrivate(const std::shared_ptr<raii_sqlite3::Database> &_db,
-      std::vector<SqlStatement> &&_statements)  // NOLINT(build/c++11)
-  : statements(new std::vector<SqlStatement>(std::move(_statements))), db(_db)
+      std::vector<SqlStatement> &&_statements,  // NOLINT(build/c++11)
+      bool _compressed)
+  : statements(new std::vector<SqlStatement>(std::move(_statements))), db(_db),
+    compressed(_compressed)
 {
 }
 
@@ -74,7 +76,8 @@ Batch::iterator Batch::begin()
   }
 
   std::unique_ptr<MsgIterPrivate> msgPriv(new MsgIterPrivate(
-        this->dataPtr->db, this->dataPtr->statements));
+        this->dataPtr->db, this->dataPtr->statements,
+        this->dataPtr->compressed));
   return Batch::iterator(std::move(msgPriv));
 }
 
@@ -33,9 +33,12 @@ class ignition::transport::log::BatchPrivate
   /// \brief constructor
   /// \param[in] _db an open sqlite3 database handle wrapper
   /// \param[in] _statements a list of statments to be executed to get messages
+  /// \param[in] _compressed true if the log stores messages in compressed
+  /// chunks
   public: explicit BatchPrivate(
       const std::shared_ptr<raii_sqlite3::Database> &_db,
-      std::vector<SqlStatement> &&_statements);  // NOLINT(build/c++11)
+      std::vector<SqlStatement> &&_statements,  // NOLINT(build/c++11)
+      bool _compressed = false);
 
   /// \brief destructor
   public: ~BatchPrivate();
@@ -45,6 +48,9 @@ class ignition::transport::log::BatchPrivate
 
   /// \brief SQLite3 database pointer wrapper
   public: std::shared_ptr<raii_sqlite3::Database> db;
+
+  /// \brief True if the log stores messages in compressed chunks
+  public: bool compressed;
 };
 
 #endif
@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <zlib.h>
+
+#include <string>
+
+#include "Chunk.hh"
+#include "Console.hh"
+
+using namespace ignition::transport;
+using namespace ignition::transport::log;
+
+//////////////////////////////////////////////////
+/// \brief Append _size little endian bytes of _value to _out.
+static void AppendLittleEndian(uint64_t _value, std::size_t _size,
+    std::string &_out)
+{
+  for (std::size_t i = 0; i < _size; ++i)
+    _out.push_back(static_cast<char>((_value >> (8 * i)) & 0xFF));
+}
+
+//////////////////////////////////////////////////
+/// \brief Read _size little endian bytes starting at _data.
+static uint64_t ReadLittleEndian(const unsigned char *_data, std::size_t _size)
+{
+  uint64_t value = 0;
+  for (std::size_t i = 0; i < _size; ++i)
+    value |= static_cast<uint64_t>(_data[i]) << (8 * i);
+  return value;
+}
+
+//////////////////////////////////////////////////
+std::string log::EncodeChunkEntry(const ChunkEntry &_entry)
+{
+  std::string out;
+  out.reserve(kChunkEntrySize);
+  AppendLittleEndian(static_cast<uint64_t>(_entry.chunkId), 8, out);
+  AppendLittleEndian(_entry.offset, 4, out);
+  AppendLittleEndian(_entry.length, 4, out);
+  return out;
+}
+
+//////////////////////////////////////////////////
+bool log::DecodeChunkEntry(const void *_data, std::size_t _len,
+    ChunkEntry &_entry)
+{
+  if (_len != kChunkEntrySize || !_data)
+    return false;
+
+  const unsigned char *bytes = static_cast<const unsigned char *>(_data);
+  _entry.chunkId = static_cast<int64_t>(ReadLittleEndian(bytes, 8));
+  _entry.offset = static_cast<uint32_t>(ReadLittleEndian(bytes + 8, 4));
+  _entry.length = static_cast<uint32_t>(ReadLittleEndian(bytes + 12, 4));
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool log::CompressChunk(const std::string &_codec, const std::string &_raw,
+    std::string &_compressed)
+{
+  if (_codec != kZlibCodec)
+  {
+    LERR("Unsupported compression codec [" << _codec << "]\n");
+    return false;
+  }
+
+  uLongf compressedSize = compressBound(_raw.size());
+  _compressed.resize(compressedSize);
+
+  // Favor speed: chunks are compressed on the recording path.
+  int returnCode = compress2(
+      reinterpret_cast<Bytef *>(&_compressed[0]), &compressedSize,
+      reinterpret_cast<const Bytef *>(_raw.data()), _raw.size(),
+      Z_BEST_SPEED);
+  if (returnCode != Z_OK)
+  {
+    LERR("Failed to compress chunk: " << returnCode << "\n");
+    return false;
+  }
+  _compressed.resize(compressedSize);
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool log::DecompressChunk(const std::string &_codec, const void *_data,
+    std::size_t _len, std::size_t _rawSize, std::string &_raw)
+{
+  if (_codec != kZlibCodec)
+  {
+    LERR("Unsupported compression codec [" << _codec << "]\n");
+    return false;
+  }
+
+  _raw.resize(_rawSize);
+  uLongf rawSize = _rawSize;
+  int returnCode = uncompress(
+      reinterpret_cast<Bytef *>(&_raw[0]), &rawSize,
+      reinterpret_cast<const Bytef *>(_data), _len);
+  if (returnCode != Z_OK || rawSize != _rawSize)
+  {
+    LERR("Failed to decompress chunk: " << returnCode << "\n");
+    _raw.clear();
+    return false;
+  }
+  return true;
+}
@@ -0,0 +1,97 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_TRANSPORT_LOG_CHUNK_HH_
+#define IGNITION_TRANSPORT_LOG_CHUNK_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "ignition/transport/config.hh"
+
+namespace ignition
+{
+namespace transport
+{
+namespace log
+{
+// Inline bracket to help doxygen filtering.
+inline namespace IGNITION_TRANSPORT_VERSION_NAMESPACE
+{
+  /// \brief Name of the zlib codec, as stored in the chunks table.
+  /// \internal
+  const std::string kZlibCodec = "zlib";
+
+  /// \brief Location of one message inside a compressed chunk. In a
+  /// compressed log, this is what the messages table stores instead of the
+  /// message data.
+  /// \internal
+  struct ChunkEntry
+  {
+    /// \brief Row of the chunk in the chunks table
+    int64_t chunkId = 0;
+
+    /// \brief Offset of the message in the uncompressed chunk
+    uint32_t offset = 0;
+
+    /// \brief Length of the message
+    uint32_t length = 0;
+  };
+
+  /// \brief Size of a serialized ChunkEntry.
+  /// \internal
+  const std::size_t kChunkEntrySize = 16;
+
+  /// \brief Serialize a chunk entry.
+  /// \param[in] _entry Entry to serialize.
+  /// \return kChunkEntrySize bytes, in little endian order.
+  /// \internal
+  std::string EncodeChunkEntry(const ChunkEntry &_entry);
+
+  /// \brief Deserialize a chunk entry.
+  /// \param[in] _data Serialized entry.
+  /// \param[in] _len Length of _data.
+  /// \param[out] _entry Deserialized entry.
+  /// \return False if _len is not kChunkEntrySize.
+  /// \internal
+  bool DecodeChunkEntry(const void *_data, std::size_t _len,
+      ChunkEntry &_entry);
+
+  /// \brief Compress a chunk.
+  /// \param[in] _codec Codec to use. Only kZlibCodec is supported.
+  /// \param[in] _raw Uncompressed data.
+  /// \param[out] _compressed Compressed data.
+  /// \return True on success.
+  /// \internal
+  bool CompressChunk(const std::string &_codec, const std::string &_raw,
+      std::string &_compressed);
+
+  /// \brief Decompress a chunk.
+  /// \param[in] _codec Codec the chunk was compressed with.
+  /// \param[in] _data Compressed data.
+  /// \param[in] _len Length of _data.
+  /// \param[in] _rawSize Size of the uncompressed data.
+  /// \param[out] _raw Uncompressed data.
+  /// \return True on success.
+  /// \internal
+  bool DecompressChunk(const std::string &_codec, const void *_data,
+      std::size_t _len, std::size_t _rawSize, std::string &_raw);
+}
+}
+}
+}
+#endif
@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <string>
+
+#include "Chunk.hh"
+#include "gtest/gtest.h"
+
+using namespace ignition;
+
+//////////////////////////////////////////////////
+TEST(Chunk, EntryRoundTrip)
+{
+  transport::log::ChunkEntry entry;
+  entry.chunkId = 0x0102030405060708;
+  entry.offset = 123456;
+  entry.length = 789;
+
+  const std::string encoded = transport::log::EncodeChunkEntry(entry);
+  EXPECT_EQ(transport::log::kChunkEntrySize, encoded.size());
+
+  transport::log::ChunkEntry decoded;
+  EXPECT_TRUE(transport::log::DecodeChunkEntry(
+      encoded.data(), encoded.size(), decoded));
+  EXPECT_EQ(entry.chunkId, decoded.chunkId);
+  EXPECT_EQ(entry.offset, decoded.offset);
+  EXPECT_EQ(entry.length, decoded.length);
+
+  // Regular message data is rejected
+  EXPECT_FALSE(transport::log::DecodeChunkEntry(
+      encoded.data(), encoded.size() - 1, decoded));
+}
+
+//////////////////////////////////////////////////
+TEST(Chunk, CompressRoundTrip)
+{
+  std::string raw;
+  for (int i = 0; i < 1000; ++i)
+    raw += "/model/box_" + std::to_string(i % 10) + "/pose;";
+
+  std::string compressed;
+  ASSERT_TRUE(transport::log::CompressChunk(
+      transport::log::kZlibCodec, raw, compressed));
+  EXPECT_LT(compressed.size(), raw.size());
+
+  std::string decompressed;
+  ASSERT_TRUE(transport::log::DecompressChunk(transport::log::kZlibCodec,
+      compressed.data(), compressed.size(), raw.size(), decompressed));
+  EXPECT_EQ(raw, decompressed);
+
+  // Wrong size or corrupted data
+  EXPECT_FALSE(transport::log::DecompressChunk(transport::log::kZlibCodec,
+      compressed.data(), compressed.size(), raw.size() + 1, decompressed));
+  EXPECT_FALSE(transport::log::DecompressChunk(transport::log::kZlibCodec,
+      raw.data(), raw.size(), raw.size(), decompressed));
+}
+
+//////////////////////////////////////////////////
+TEST(Chunk, UnsupportedCodec)
+{
+  std::string out;
+  EXPECT_FALSE(transport::log::CompressChunk("lz4", "data", out));
+  EXPECT_FALSE(transport::log::DecompressChunk("lz4", "data", 4, 4, out));
+}
+
+//////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,803 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifdef _WIN32
+  #include <direct.h>
+#else
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <unistd.h>
+#endif
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#include <google/protobuf/descriptor.h>
+#include <google/protobuf/message.h>
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <ignition/msgs/Factory.hh>
+
+#include "ignition/transport/log/ColumnStore.hh"
+#include "Console.hh"
+
+using namespace ignition::transport;
+using namespace ignition::transport::log;
+
+namespace
+{
+/// \brief Name of the file listing the columns of an export
+const char kManifestName[] = "columns.txt";
+
+/// \brief Magic bytes at the beginning of every column file
+const char kColumnMagic[8] = {'I', 'G', 'N', 'C', 'O', 'L', '0', '1'};
+
+/// \brief Size of the header of a column file. Values start after it, so
+/// they stay 8 byte aligned in the mapped file.
+const std::size_t kColumnHeaderSize = 16;
+
+/// \brief Values buffered for a column before they are appended to its
+/// file. Columns are not kept open, so a topic can have more columns than
+/// the process may have open files.
+const std::size_t kColumnBufferSize = 64 * 1024;
+
+/// \brief Type of the values in a column
+enum class ColumnType : uint32_t
+{
+  /// \brief int64_t time received, in nanoseconds
+  TIME = 0,
+
+  /// \brief double
+  DOUBLE = 1,
+
+  /// \brief int64_t
+  INTEGER = 2
+};
+
+/// \brief Name of each column type in the manifest
+const char *kColumnTypeNames[] = {"time", "f64", "i64"};
+
+//////////////////////////////////////////////////
+/// \brief Create a directory and its parents if they do not exist
+/// \param[in] _path Directory path
+/// \return true if the directory exists when this returns
+bool CreateDirectories(const std::string &_path)
+{
+  for (std::size_t pos = _path.find('/', 1); ;
+       pos = _path.find('/', pos + 1))
+  {
+    const std::string dir = _path.substr(0, pos);
+    if (!dir.empty())
+    {
+#ifdef _WIN32
+      int result = _mkdir(dir.c_str());
+#else
+      int result = mkdir(dir.c_str(), 0755);
+#endif
+      if (result != 0 && errno != EEXIST)
+      {
+        LERR("Failed to create directory [" << dir << "]: "
+            << std::strerror(errno) << "\n");
+        return false;
+      }
+    }
+    if (pos == std::string::npos)
+      return true;
+  }
+}
+
+//////////////////////////////////////////////////
+/// \brief Values of one column of a topic being exported
+class ColumnWriter
+{
+  /// \brief Constructor. Creates the column file.
+  /// \param[in] _path Path of the column file
+  /// \param[in] _type Type of the values
+  /// \param[in] _rows Number of rows to fill before the first value, for
+  /// fields that appear after the first message of a topic
+  public: ColumnWriter(const std::string &_path, ColumnType _type,
+      uint64_t _rows)
+    : path(_path), type(_type)
+  {
+    std::ofstream out(this->path, std::ios::binary | std::ios::trunc);
+    const uint32_t header[2] = {static_cast<uint32_t>(this->type), 0};
+    out.write(kColumnMagic, sizeof(kColumnMagic));
+    out.write(reinterpret_cast<const char *>(header), sizeof(header));
+    this->ok = out.good();
+
+    this->FillUntil(_rows);
+  }
+
+  /// \brief Append a value
+  /// \param[in] _value Value, converted to the type of the column
+  public: template <typename T>
+  void Append(T _value)
+  {
+    if (this->type == ColumnType::DOUBLE)
+      this->AppendRaw(static_cast<double>(_value));
+    else
+      this->AppendRaw(static_cast<int64_t>(_value));
+  }
+
+  /// \brief Append fill values until the column has _rows values
+  /// \param[in] _rows Number of rows
+  public: void FillUntil(uint64_t _rows)
+  {
+    while (this->rows < _rows)
+    {
+      if (this->type == ColumnType::DOUBLE)
+        this->AppendRaw(std::numeric_limits<double>::quiet_NaN());
+      else
+        this->AppendRaw(int64_t{0});
+    }
+  }
+
+  /// \brief Append buffered values to the file
+  /// \return true if all the values written so far are in the file
+  public: bool Flush()
+  {
+    if (!this->buffer.empty())
+    {
+      std::ofstream out(this->path, std::ios::binary | std::ios::app);
+      out.write(this->buffer.data(), this->buffer.size());
+      this->ok = this->ok && out.good();
+      this->buffer.clear();
+    }
+    return this->ok;
+  }
+
+  /// \brief Append a value of the exact type stored
+  /// \param[in] _value Value
+  private: template <typename T>
+  void AppendRaw(T _value)
+  {
+    const char *bytes = reinterpret_cast<const char *>(&_value);
+    this->buffer.insert(this->buffer.end(), bytes, bytes + sizeof(T));
+    ++this->rows;
+    if (this->buffer.size() >= kColumnBufferSize)
+      this->Flush();
+  }
+
+  /// \brief Path of the column file
+  public: const std::string path;
+
+  /// \brief Type of the values
+  public: const ColumnType type;
+
+  /// \brief Number of values in the column
+  public: uint64_t rows = 0;
+
+  /// \brief Values not written to the file yet
+  private: std::vector<char> buffer;
+
+  /// \brief False if writing the file failed
+  private: bool ok = true;
+};
+
+//////////////////////////////////////////////////
+/// \brief Columns of one topic being exported
+class TopicWriter
+{
+  /// \brief Constructor
+  /// \param[in] _directory Export directory
+  /// \param[in] _prefix Prefix of the column file names of this topic
+  public: TopicWriter(const std::string &_directory, const std::string &_prefix)
+    : directory(_directory), prefix(_prefix),
+      times(_directory + "/" + _prefix + "_time.col", ColumnType::TIME, 0)
+  {
+  }
+
+  /// \brief Start a new row
+  /// \param[in] _time Time the message was received
+  public: void BeginRow(const std::chrono::nanoseconds &_time)
+  {
+    this->times.Append(_time.count());
+  }
+
+  /// \brief Finish the current row, filling the fields it did not have
+  public: void EndRow()
+  {
+    ++this->rows;
+    for (auto &column : this->columns)
+      column.second->FillUntil(this->rows);
+  }
+
+  /// \brief Set the value of a field in the current row
+  /// \param[in] _field Field name
+  /// \param[in] _type Type of the column
+  /// \param[in] _value Value
+  public: template <typename T>
+  void Set(const std::string &_field, ColumnType _type, T _value)
+  {
+    auto it = this->columns.find(_field);
+    if (it == this->columns.end())
+    {
+      const std::string file =
+          this->prefix + "_" + std::to_string(this->columns.size()) + ".col";
+      it = this->columns.emplace(_field, std::make_unique<ColumnWriter>(
+          this->directory + "/" + file, _type, this->rows)).first;
+      this->files[_field] = file;
+    }
+    else if (it->second->type != _type)
+    {
+      // The topic carries more than one message type
+      return;
+    }
+
+    // Repeated fields are flattened by index, so a field can only be set
+    // once per row.
+    if (it->second->rows == this->rows)
+      it->second->Append(_value);
+  }
+
+  /// \brief Flatten a message into the current row
+  /// \param[in] _msg Message
+  /// \param[in] _prefix Path of _msg in the top level message
+  public: void Flatten(const google::protobuf::Message &_msg,
+      const std::string &_prefix)
+  {
+    using google::protobuf::FieldDescriptor;
+    const google::protobuf::Descriptor *desc = _msg.GetDescriptor();
+    const google::protobuf::Reflection *refl = _msg.GetReflection();
+
+    for (int i = 0; i < desc->field_count(); ++i)
+    {
+      const FieldDescriptor *field = desc->field(i);
+      const std::string name = _prefix + field->name();
+
+      if (field->is_repeated())
+      {
+        const int size = refl->FieldSize(_msg, field);
+        for (int j = 0; j < size; ++j)
+        {
+          const std::string item = name + "[" + std::to_string(j) + "]";
+          switch (field->cpp_type())
+          {
+            case FieldDescriptor::CPPTYPE_MESSAGE:
+              this->Flatten(refl->GetRepeatedMessage(_msg, field, j),
+                  item + ".");
+              break;
+            case FieldDescriptor::CPPTYPE_DOUBLE:
+              this->Set(item, ColumnType::DOUBLE,
+                  refl->GetRepeatedDouble(_msg, field, j));
+              break;
+            case FieldDescriptor::CPPTYPE_FLOAT:
+              this->Set(item, ColumnType::DOUBLE,
+                  refl->GetRepeatedFloat(_msg, field, j));
+              break;
+            case FieldDescriptor::CPPTYPE_INT32:
+              this->Set(item, ColumnType::INTEGER,
+                  refl->GetRepeatedInt32(_msg, field, j));
+              break;
+            case FieldDescriptor::CPPTYPE_INT64:
+              this->Set(item, ColumnType::INTEGER,
+                  refl->GetRepeatedInt64(_msg, field, j));
+              break;
+            case FieldDescriptor::CPPTYPE_UINT32:
+              this->Set(item, ColumnType::INTEGER,
+                  refl->GetRepeatedUInt32(_msg, field, j));
+              break;
+            case FieldDescriptor::CPPTYPE_UINT64:
+              this->Set(item, ColumnType::INTEGER,
+                  refl->GetRepeatedUInt64(_msg, field, j));
+              break;
+            case FieldDescriptor::CPPTYPE_BOOL:
+              this->Set(item, ColumnType::INTEGER,
+                  refl->GetRepeatedBool(_msg, field, j));
+              break;
+            case FieldDescriptor::CPPTYPE_ENUM:
+              this->Set(item, ColumnType::INTEGER,
+                  refl->GetRepeatedEnumValue(_msg, field, j));
+              break;
+            default:
+              // Strings and bytes are not numeric data
+              break;
+          }
+        }
+        continue;
+      }
+
+      switch (field->cpp_type())
+      {
+        case FieldDescriptor::CPPTYPE_MESSAGE:
+          if (refl->HasField(_msg, field))
+            this->Flatten(refl->GetMessage(_msg, field), name + ".");
+          break;
+        case FieldDescriptor::CPPTYPE_DOUBLE:
+          this->Set(name, ColumnType::DOUBLE, refl->GetDouble(_msg, field));
+          break;
+        case FieldDescriptor::CPPTYPE_FLOAT:
+          this->Set(name, ColumnType::DOUBLE, refl->GetFloat(_msg, field));
+          break;
+        case FieldDescriptor::CPPTYPE_INT32:
+          this->Set(name, ColumnType::INTEGER, refl->GetInt32(_msg, field));
+          break;
+        case FieldDescriptor::CPPTYPE_INT64:
+          this->Set(name, ColumnType::INTEGER, refl->GetInt64(_msg, field));
+          break;
+        case FieldDescriptor::CPPTYPE_UINT32:
+          this->Set(name, ColumnType::INTEGER, refl->GetUInt32(_msg, field));
+          break;
+        case FieldDescriptor::CPPTYPE_UINT64:
+          this->Set(name, ColumnType::INTEGER, refl->GetUInt64(_msg, field));
+          break;
+        case FieldDescriptor::CPPTYPE_BOOL:
+          this->Set(name, ColumnType::INTEGER, refl->GetBool(_msg, field));
+          break;
+        case FieldDescriptor::CPPTYPE_ENUM:
+          this->Set(name, ColumnType::INTEGER,
+              refl->GetEnumValue(_msg, field));
+          break;
+        default:
+          // Strings and bytes are not numeric data
+          break;
+      }
+    }
+  }
+
+  /// \brief Write the remaining values and list the columns
+  /// \param[in] _topic Topic name
+  /// \param[out] _manifest Stream to list the columns in
+  /// \return true if all the columns were written
+  public: bool Finish(const std::string &_topic, std::ostream &_manifest)
+  {
+    bool ok = this->times.Flush();
+    _manifest << kColumnTypeNames[static_cast<uint32_t>(ColumnType::TIME)]
+              << "\t" << this->prefix << "_time.col\t" << _topic << "\t\n";
+
+    for (auto &column : this->columns)
+    {
+      ok = column.second->Flush() && ok;
+      _manifest << kColumnTypeNames[static_cast<uint32_t>(column.second->type)]
+                << "\t" << this->files[column.first] << "\t" << _topic
+                << "\t" << column.first << "\n";
+    }
+    return ok;
+  }
+
+  /// \brief Export directory
+  private: const std::string directory;
+
+  /// \brief Prefix of the column file names of this topic
+  private: const std::string prefix;
+
+  /// \brief Time column
+  private: ColumnWriter times;
+
+  /// \brief Columns by field name
+  private: std::map<std::string, std::unique_ptr<ColumnWriter>> columns;
+
+  /// \brief Column file names by field name
+  private: std::map<std::string, std::string> files;
+
+  /// \brief Number of complete rows
+  private: uint64_t rows = 0;
+};
+
+//////////////////////////////////////////////////
+/// \brief Read-only view of a column file
+class MappedColumn
+{
+  /// \brief Destructor
+  public: ~MappedColumn()
+  {
+#ifndef _WIN32
+    if (this->mapping)
+      munmap(this->mapping, this->mappingSize);
+#endif
+  }
+
+  /// \brief Map a column file
+  /// \param[in] _path Path of the column file
+  /// \param[in] _type Type the column is expected to hold
+  /// \return true if the file is a valid column of type _type
+  public: bool Open(const std::string &_path, ColumnType _type)
+  {
+    const char *bytes = nullptr;
+    std::size_t size = 0;
+#ifdef _WIN32
+    std::ifstream in(_path, std::ios::binary | std::ios::ate);
+    if (!in)
+    {
+      LERR("Failed to open column [" << _path << "]\n");
+      return false;
+    }
+    size = static_cast<std::size_t>(in.tellg());
+    this->buffer.resize((size + sizeof(int64_t) - 1) / sizeof(int64_t));
+    in.seekg(0);
+    in.read(reinterpret_cast<char *>(this->buffer.data()), size);
+    bytes = reinterpret_cast<const char *>(this->buffer.data());
+#else
+    int fd = open(_path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+      LERR("Failed to open column [" << _path << "]: "
+          << std::strerror(errno) << "\n");
+      return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) == 0 && info.st_size > 0)
+    {
+      size = static_cast<std::size_t>(info.st_size);
+      void *mapped = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+      if (mapped != MAP_FAILED)
+      {
+        this->mapping = mapped;
+        this->mappingSize = size;
+        bytes = static_cast<const char *>(mapped);
+      }
+    }
+    close(fd);
+    if (!bytes)
+    {
+      LERR("Failed to map column [" << _path << "]\n");
+      return false;
+    }
+#endif
+
+    uint32_t header[2];
+    if (size < kColumnHeaderSize ||
+        std::memcmp(bytes, kColumnMagic, sizeof(kColumnMagic)) != 0 ||
+        (size - kColumnHeaderSize) % sizeof(int64_t) != 0)
+    {
+      LERR("[" << _path << "] is not a column file\n");
+      return false;
+    }
+    std::memcpy(header, bytes + sizeof(kColumnMagic), sizeof(header));
+    if (header[0] != static_cast<uint32_t>(_type))
+    {
+      LERR("Column [" << _path << "] has an unexpected type\n");
+      return false;
+    }
+
+    this->data = bytes + kColumnHeaderSize;
+    this->rows = (size - kColumnHeaderSize) / sizeof(int64_t);
+    this->type = _type;
+    return true;
+  }
+
+  /// \brief Start of the values
+  public: const char *data = nullptr;
+
+  /// \brief Number of values
+  public: std::size_t rows = 0;
+
+  /// \brief Type of the values
+  public: ColumnType type = ColumnType::TIME;
+
+#ifdef _WIN32
+  /// \brief Contents of the file, 8 byte aligned
+  private: std::vector<int64_t> buffer;
+#else
+  /// \brief Start of the mapping
+  private: void *mapping = nullptr;
+
+  /// \brief Size of the mapping
+  private: std::size_t mappingSize = 0;
+#endif
+};
+
+}
+
+//////////////////////////////////////////////////
+/// \brief Private implementation of ColumnStore
+class ignition::transport::log::ColumnStore::Implementation
+{
+  /// \brief Columns of a topic
+  public: struct Topic
+  {
+    /// \brief Time column
+    std::unique_ptr<MappedColumn> times;
+
+    /// \brief Field columns, by field name
+    std::map<std::string, std::unique_ptr<MappedColumn>> fields;
+  };
+
+  /// \brief Get a field column
+  /// \param[in] _topic Topic name
+  /// \param[in] _field Field name
+  /// \param[in] _type Expected type
+  /// \return The column, or nullptr if there is no such column
+  public: const MappedColumn *Column(const std::string &_topic,
+      const std::string &_field, ColumnType _type) const
+  {
+    auto topicIt = this->topics.find(_topic);
+    if (topicIt == this->topics.end())
+      return nullptr;
+    auto fieldIt = topicIt->second.fields.find(_field);
+    if (fieldIt == topicIt->second.fields.end() ||
+        fieldIt->second->type != _type)
+    {
+      return nullptr;
+    }
+    return fieldIt->second.get();
+  }
+
+  /// \brief Topics, by name
+  public: std::map<std::string, Topic> topics;
+
+  /// \brief True if Open() succeeded
+  public: bool valid = false;
+};
+
+//////////////////////////////////////////////////
+ColumnStore::ColumnStore()
+  : dataPtr(new Implementation)
+{
+}
+
+//////////////////////////////////////////////////
+ColumnStore::ColumnStore(ColumnStore &&_old)  // NOLINT
+  : dataPtr(std::move(_old.dataPtr))
+{
+}
+
+//////////////////////////////////////////////////
+ColumnStore::~ColumnStore()
+{
+}
+
+//////////////////////////////////////////////////
+bool ColumnStore::Export(Log &_log, const std::string &_directory,
+    const QueryOptions &_options)
+{
+  if (!_log.Valid())
+  {
+    LERR("Cannot export an invalid log\n");
+    return false;
+  }
+
+  if (!CreateDirectories(_directory))
+    return false;
+
+  const std::string manifestPath = _directory + "/" + kManifestName;
+  if (std::ifstream(manifestPath))
+  {
+    LERR("[" << _directory << "] already contains an export\n");
+    return false;
+  }
+
+  std::map<std::string, std::unique_ptr<TopicWriter>> topics;
+  std::map<std::string, std::unique_ptr<google::protobuf::Message>> prototypes;
+
+  for (const Message &logMsg : _log.QueryMessages(_options))
+  {
+    // One parser per message type, reused for every message
+    auto protoIt = prototypes.find(logMsg.Type());
+    if (protoIt == prototypes.end())
+    {
+      std::unique_ptr<google::protobuf::Message> msg;
+      const google::protobuf::Descriptor *desc =
+        google::protobuf::DescriptorPool::generated_pool()
+          ->FindMessageTypeByName(logMsg.Type());
+      if (desc)
+      {
+        msg.reset(google::protobuf::MessageFactory::generated_factory()
+          ->GetPrototype(desc)->New());
+      }
+      else
+      {
+        msg = ignition::msgs::Factory::New(logMsg.Type());
+      }
+
+      if (!msg)
+      {
+        LWRN("Skipping messages of unknown type [" << logMsg.Type() << "]\n");
+      }
+      protoIt = prototypes.emplace(logMsg.Type(), std::move(msg)).first;
+    }
+    if (!protoIt->second)
+      continue;
+
+    google::protobuf::Message &msg = *protoIt->second;
+    if (!msg.ParseFromString(logMsg.Data()))
+    {
+      LWRN("Skipping message on [" << logMsg.Topic() << "] that failed to "
+           "parse\n");
+      continue;
+    }
+
+    auto topicIt = topics.find(logMsg.Topic());
+    if (topicIt == topics.end())
+    {
+      const std::string prefix = "t" + std::to_string(topics.size());
+      topicIt = topics.emplace(logMsg.Topic(),
+          std::make_unique<TopicWriter>(_directory, prefix)).first;
+    }
+
+    TopicWriter &topic = *topicIt->second;
+    topic.BeginRow(logMsg.TimeReceived());
+    topic.Flatten(msg, "");
+    topic.EndRow();
+  }
+
+  // The manifest is written last, so an interrupted export is not mistaken
+  // for a complete one.
+  std::ostringstream manifest;
+  bool ok = true;
+  for (auto &topic : topics)
+    ok = topic.second->Finish(topic.first, manifest) && ok;
+
+  if (!ok)
+  {
+    LERR("Failed to write columns to [" << _directory << "]\n");
+    return false;
+  }
+
+  std::ofstream manifestFile(manifestPath);
+  manifestFile << manifest.str();
+  return manifestFile.good();
+}
+
+//////////////////////////////////////////////////
+bool ColumnStore::Open(const std::string &_directory)
+{
+  if (this->dataPtr->valid)
+  {
+    LERR("Columns are already open\n");
+    return false;
+  }
+
+  std::ifstream manifest(_directory + "/" + kManifestName);
+  if (!manifest)
+  {
+    LERR("No columns found in [" << _directory << "]\n");
+    return false;
+  }
+
+  std::map<std::string, Implementation::Topic> topics;
+  std::string line;
+  while (std::getline(manifest, line))
+  {
+    // Lines are: type, file, topic, field, separated by tabs
+    std::vector<std::string> parts;
+    std::size_t start = 0;
+    for (std::size_t end = line.find('\t'); end != std::string::npos;
+         end = line.find('\t', start))
+    {
+      parts.push_back(line.substr(start, end - start));
+      start = end + 1;
+    }
+    parts.push_back(line.substr(start));
+    if (parts.size() != 4)
+    {
+      LERR("Invalid line in column manifest [" << line << "]\n");
+      return false;
+    }
+
+    ColumnType type;
+    if (parts[0] == kColumnTypeNames[0])
+      type = ColumnType::TIME;
+    else if (parts[0] == kColumnTypeNames[1])
+      type = ColumnType::DOUBLE;
+    else if (parts[0] == kColumnTypeNames[2])
+      type = ColumnType::INTEGER;
+    else
+    {
+      LERR("Unknown column type [" << parts[0] << "]\n");
+      return false;
+    }
+
+    auto column = std::make_unique<MappedColumn>();
+    if (!column->Open(_directory + "/" + parts[1], type))
+      return false;
+
+    Implementation::Topic &topic = topics[parts[2]];
+    if (type == ColumnType::TIME)
+      topic.times = std::move(column);
+    else
+      topic.fields[parts[3]] = std::move(column);
+  }
+
+  // Every column of a topic has one value per message
+  for (const auto &topic : topics)
+  {
+    if (!topic.second.times)
+    {
+      LERR("Missing time column for [" << topic.first << "]\n");
+      return false;
+    }
+    for (const auto &field : topic.second.fields)
+    {
+      if (field.second->rows != topic.second.times->rows)
+      {
+        LERR("Column [" << field.first << "] of [" << topic.first
+            << "] has " << field.second->rows << " values, expected "
+            << topic.second.times->rows << "\n");
+        return false;
+      }
+    }
+  }
+
+  this->dataPtr->topics = std::move(topics);
+  this->dataPtr->valid = true;
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool ColumnStore::Valid() const
+{
+  return this->dataPtr->valid;
+}
+
+//////////////////////////////////////////////////
+std::vector<std::string> ColumnStore::Topics() const
+{
+  std::vector<std::string> result;
+  for (const auto &topic : this->dataPtr->topics)
+    result.push_back(topic.first);
+  return result;
+}
+
+//////////////////////////////////////////////////
+std::vector<std::string> ColumnStore::Fields(const std::string &_topic) const
+{
+  std::vector<std::string> result;
+  auto it = this->dataPtr->topics.find(_topic);
+  if (it != this->dataPtr->topics.end())
+  {
+    for (const auto &field : it->second.fields)
+      result.push_back(field.first);
+  }
+  return result;
+}
+
+//////////////////////////////////////////////////
+std::size_t ColumnStore::Size(const std::string &_topic) const
+{
+  auto it = this->dataPtr->topics.find(_topic);
+  if (it == this->dataPtr->topics.end())
+    return 0;
+  return it->second.times->rows;
+}
+
+//////////////////////////////////////////////////
+const int64_t *ColumnStore::Times(const std::string &_topic) const
+{
+  auto it = this->dataPtr->topics.find(_topic);
+  if (it == this->dataPtr->topics.end())
+    return nullptr;
+  return reinterpret_cast<const int64_t *>(it->second.times->data);
+}
+
+//////////////////////////////////////////////////
+const double *ColumnStore::Doubles(const std::string &_topic,
+    const std::string &_field) const
+{
+  const MappedColumn *column =
+      this->dataPtr->Column(_topic, _field, ColumnType::DOUBLE);
+  return column ? reinterpret_cast<const double *>(column->data) : nullptr;
+}
+
+//////////////////////////////////////////////////
+const int64_t *ColumnStore::Integers(const std::string &_topic,
+    const std::string &_field) const
+{
+  const MappedColumn *column =
+      this->dataPtr->Column(_topic, _field, ColumnType::INTEGER);
+  return column ? reinterpret_cast<const int64_t *>(column->data) : nullptr;
+}
@@ -22,15 +22,20 @@
 #include <cstdlib>
 #include <fstream>
 #include <functional>
+#include <limits>
+#include <map>
 #include <memory>
+#include <set>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "ignition/transport/log/Descriptor.hh"
 #include "ignition/transport/log/Log.hh"
 #include "ignition/transport/log/SqlStatement.hh"
 #include "BatchPrivate.hh"
 #include "build_config.hh"
+#include "Chunk.hh"
 #include "Console.hh"
 #include "Descriptor.hh"
 #include "raii-sqlite3.hh"
@@ -48,10 +53,29 @@ class ignition::transport::log::Log::Implementation
   /// \return one of the SQLite error codes
   public: int EndTransactionIfEnoughTimeHasPassed();
 
+  /// \brief End the current transaction, if any
+  /// \return one of the SQLite error codes
+  public: int EndTransaction();
+
   /// \brief Begin transaction if one isn't already open
   /// \return one of the SQLite error codes
   public: int BeginTransactionIfNotInOne();
 
+  /// \brief Get a cached prepared statement, compiling it the first time
+  /// \param[in, out] _statement the cached statement
+  /// \param[in] _sql the SQL used to compile the statement
+  /// \return the statement reset and with its bindings cleared, or nullptr
+  /// if it could not be compiled
+  public: raii_sqlite3::Statement *CachedStatement(
+      std::unique_ptr<raii_sqlite3::Statement> &_statement,
+      const std::string &_sql);
+
+  /// \brief Set a pragma on the database
+  /// \param[in] _pragma name of the pragma
+  /// \param[in] _value value of the pragma
+  /// \return true if the pragma was set
+  public: bool SetPragma(const std::string &_pragma, const std::string &_value);
+
   /// \brief Get topic_id associated with a topic name and message type
   /// If the topic is not in the log it will be added
   /// \note Invalidates the descriptor if a topic is inserted
@@ -65,6 +89,28 @@ class ignition::transport::log::Log::Implementation
   public: bool InsertMessage(const std::chrono::nanoseconds &_time,
       int64_t _topic, const void *_data, std::size_t _len);
 
+  /// \brief Read a file from the schema directory and execute it
+  /// \param[in] _db the database to execute it on
+  /// \param[in] _name name of the file in the schema directory
+  /// \return true if the file was executed successfully
+  public: static bool ExecuteSqlFile(raii_sqlite3::Database &_db,
+      const std::string &_name);
+
+  /// \brief Compress the pending messages of a topic into a chunk and
+  /// insert it, along with a reference to it for each message
+  /// \param[in] _topic the topic_id whose messages are flushed
+  /// \return true if the chunk was inserted
+  public: bool FlushChunk(int64_t _topic);
+
+  /// \brief Flush the pending messages of all topics
+  /// \return true if all chunks were inserted
+  public: bool FlushChunks();
+
+  /// \brief Compress and insert the pending chunks started at least
+  /// chunkPeriod ago
+  /// \return true if all these chunks were inserted
+  public: bool FlushExpiredChunks();
+
   /// \brief Return true if enough time has passed since the last transaction
   /// \return true if the transaction has lasted long enough
   public: bool TimeForNewTransaction() const;
@@ -92,6 +138,67 @@ class ignition::transport::log::Log::Implementation
 
   /// \brief Name of the log file.
   public: std::string filename = "";
+
+  /// \brief Cached statement to insert a message. Declared after the
+  /// database so it is finalized before the database is closed.
+  public: std::unique_ptr<raii_sqlite3::Statement> insertMessageStatement;
+
+  /// \brief Cached statement to insert a message type
+  public: std::unique_ptr<raii_sqlite3::Statement> insertMessageTypeStatement;
+
+  /// \brief Cached statement to insert a topic
+  public: std::unique_ptr<raii_sqlite3::Statement> insertTopicStatement;
+
+  /// \brief Cached statement to insert a chunk
+  public: std::unique_ptr<raii_sqlite3::Statement> insertChunkStatement;
+
+  /// \brief True if the messages table stores references into compressed
+  /// chunks instead of message data
+  public: bool compressed = false;
+
+  /// \brief Codec used to compress new chunks, empty if disabled
+  public: std::string codec;
+
+  /// \brief Uncompressed size above which a chunk is written
+  public: std::size_t chunkSize = 0;
+
+  /// \brief Time after which a chunk is written even if not full
+  public: std::chrono::milliseconds chunkPeriod{1000};
+
+  /// \brief A message waiting in a chunk that has not been written yet
+  public: struct PendingMessage
+  {
+    /// \brief Time the message was received
+    std::chrono::nanoseconds time;
+
+    /// \brief Offset of the message in the chunk
+    uint32_t offset;
+
+    /// \brief Length of the message
+    uint32_t length;
+  };
+
+  /// \brief A chunk that has not been written yet
+  public: struct PendingChunk
+  {
+    /// \brief Concatenated message data
+    std::string data;
+
+    /// \brief Messages in the chunk
+    std::vector<PendingMessage> messages;
+
+    /// \brief When the first message was appended
+    std::chrono::steady_clock::time_point started;
+  };
+
+  /// \brief Chunks being filled, by topic_id
+  public: std::map<int64_t, PendingChunk> pendingChunks;
+
+  /// \brief True once a message has been inserted
+  public: bool messagesInserted = false;
+
+  /// \brief True if the log was opened for writing
+  public: bool writable = false;
 };
 
 //////////////////////////////////////////////////
@@ -169,7 +276,15 @@ int Log::Implementation::EndTransactionIfEnoughTimeHasPassed()
     return SQLITE_OK;
   }
 
-  // End the transaction
+  return this->EndTransaction();
+}
+
+//////////////////////////////////////////////////
+int Log::Implementation::EndTransaction()
+{
+  if (!this->inTransaction)
+    return SQLITE_OK;
+
   int returnCode = sqlite3_exec(
       this->db->Handle(), "END;", NULL, 0, nullptr);
   if (returnCode != SQLITE_OK)
@@ -182,6 +297,46 @@ int Log::Implementation::EndTransactionIfEnoughTimeHasPassed()
   return returnCode;
 }
 
+//////////////////////////////////////////////////
+raii_sqlite3::Statement *Log::Implementation::CachedStatement(
+    std::unique_ptr<raii_sqlite3::Statement> &_statement,
+    const std::string &_sql)
+{
+  if (!_statement)
+  {
+    std::unique_ptr<raii_sqlite3::Statement> statement(
+        new raii_sqlite3::Statement(*(this->db), _sql));
+    if (!*statement)
+      return nullptr;
+    _statement = std::move(statement);
+  }
+  else
+  {
+    sqlite3_reset(_statement->Handle());
+    sqlite3_clear_bindings(_statement->Handle());
+  }
+  return _statement.get();
+}
+
+//////////////////////////////////////////////////
+bool Log::Implementation::SetPragma(
+    const std::string &_pragma, const std::string &_value)
+{
+  // Pending statements and transactions prevent some pragmas from changing
+  this->EndTransaction();
+
+  const std::string sql = "PRAGMA " + _pragma + " = " + _value + ";";
+  int returnCode = sqlite3_exec(
+      this->db->Handle(), sql.c_str(), NULL, 0, nullptr);
+  if (returnCode != SQLITE_OK)
+  {
+    LERR("Failed to set " << _pragma << ": " << sqlite3_errmsg(
+        this->db->Handle()) << "\n");
+    return false;
+  }
+  return true;
+}
+
 //////////////////////////////////////////////////
 int Log::Implementation::BeginTransactionIfNotInOne()
 {
@@ -237,15 +392,15 @@ int64_t Log::Implementation::InsertOrGetTopicId(
     "INSERT INTO topics (name, message_type_id)"
     " SELECT ?002, id FROM message_types WHERE name = ?001 LIMIT 1;";
 
-  raii_sqlite3::Statement messageTypeStatement(
-      *(this->db), sqlMessageType);
+  raii_sqlite3::Statement *messageTypeStatement = this->CachedStatement(
+      this->insertMessageTypeStatement, sqlMessageType);
   if (!messageTypeStatement)
   {
     LERR("Failed to compile statement to insert message type\n");
     return -1;
   }
-  raii_sqlite3::Statement topicStatement(
-      *(this->db), sqlTopic);
+  raii_sqlite3::Statement *topicStatement = this->CachedStatement(
+      this->insertTopicStatement, sqlTopic);
   if (!topicStatement)
   {
     LERR("Failed to compile statement to insert topic\n");
@@ -255,21 +410,21 @@ int64_t Log::Implementation::InsertOrGetTopicId(
   int returnCode;
   // Bind parameters
   returnCode = sqlite3_bind_text(
-      messageTypeStatement.Handle(), 1, _type.c_str(), _type.size(), nullptr);
+      messageTypeStatement->Handle(), 1, _type.c_str(), _type.size(), nullptr);
   if (returnCode != SQLITE_OK)
   {
     LERR("Failed to bind message type name(1): " << returnCode << "\n");
     return -1;
   }
   returnCode = sqlite3_bind_text(
-      topicStatement.Handle(), 1, _type.c_str(), _type.size(), nullptr);
+      topicStatement->Handle(), 1, _type.c_str(), _type.size(), nullptr);
   if (returnCode != SQLITE_OK)
   {
     LERR("Failed to bind message type name(2): " << returnCode << "\n");
     return -1;
   }
   returnCode = sqlite3_bind_text(
-      topicStatement.Handle(), 2, _name.c_str(), _name.size(), nullptr);
+      topicStatement->Handle(), 2, _name.c_str(), _name.size(), nullptr);
   if (returnCode != SQLITE_OK)
   {
     LERR("Failed to bind topic name: " << returnCode << "\n");
@@ -277,13 +432,13 @@ int64_t Log::Implementation::InsertOrGetTopicId(
   }
 
   // Execute the statements
-  returnCode = sqlite3_step(messageTypeStatement.Handle());
+  returnCode = sqlite3_step(messageTypeStatement->Handle());
   if (returnCode != SQLITE_DONE)
   {
     LERR("Failed to insert message type: " << returnCode << "\n");
     return -1;
   }
-  returnCode = sqlite3_step(topicStatement.Handle());
+  returnCode = sqlite3_step(topicStatement->Handle());
   if (returnCode != SQLITE_DONE)
   {
     LERR("Faild to insert topic: " << returnCode << "\n");
@@ -292,6 +447,8 @@ int64_t Log::Implementation::InsertOrGetTopicId(
 
   // topics.id is an alias for rowid
   int64_t id = sqlite3_last_insert_rowid(this->db->Handle());
+  sqlite3_reset(messageTypeStatement->Handle());
+  sqlite3_reset(topicStatement->Handle());
   LDBG("Inserted '" << _name << "'[" << _type << "]\n");
   return id;
 }
@@ -308,8 +465,9 @@ bool Log::Implementation::InsertMessage(
     "INSERT INTO messages (time_recv, message, topic_id)"
     "VALUES (?001, ?002, ?003);";
 
-  // Compile the statement
-  raii_sqlite3::Statement statement(*(this->db), sql);
+  // Compile the statement the first time, reuse it afterwards
+  raii_sqlite3::Statement *statement = this->CachedStatement(
+      this->insertMessageStatement, sql);
   if (!statement)
   {
     LERR("Failed to compile insert message statement\n");
@@ -317,19 +475,19 @@ bool Log::Implementation::InsertMessage(
   }
 
   // Bind parameters
-  returnCode = sqlite3_bind_int64(statement.Handle(), 1, _time.count());
+  returnCode = sqlite3_bind_int64(statement->Handle(), 1, _time.count());
   if (returnCode != SQLITE_OK)
   {
     LERR("Failed to bind time received: " << returnCode << "\n");
     return false;
   }
-  returnCode = sqlite3_bind_blob(statement.Handle(), 2, _data, _len, nullptr);
+  returnCode = sqlite3_bind_blob(statement->Handle(), 2, _data, _len, nullptr);
   if (returnCode != SQLITE_OK)
   {
     LERR("Failed to bind message data: " << returnCode << "\n");
     return false;
   }
-  returnCode = sqlite3_bind_int(statement.Handle(), 3, _topic);
+  returnCode = sqlite3_bind_int(statement->Handle(), 3, _topic);
   if (returnCode != SQLITE_OK)
   {
     LERR("Failed to bind topic_id: " << returnCode << "\n");
@@ -337,12 +495,166 @@ bool Log::Implementation::InsertMessage(
   }
 
   // Execute the statement
-  returnCode = sqlite3_step(statement.Handle());
+  returnCode = sqlite3_step(statement->Handle());
   if (returnCode != SQLITE_DONE)
   {
     LERR("Failed to insert message: " << returnCode << "\n");
     return false;
   }
+
+  // Release the blob, which is bound without being copied
+  sqlite3_reset(statement->Handle());
+  sqlite3_clear_bindings(statement->Handle());
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool Log::Implementation::ExecuteSqlFile(raii_sqlite3::Database &_db,
+    const std::string &_name)
+{
+  // Test hook so tests can be run before `make install`
+  std::string schemaFile;
+  const char *envPath = std::getenv(SchemaLocationEnvVar.c_str());
+  if (envPath)
+  {
+    schemaFile = envPath;
+  }
+  else
+  {
+    schemaFile = SCHEMA_INSTALL_PATH;
+  }
+  schemaFile += "/" + _name;
+
+  LDBG("Schema file: " << schemaFile << "\n");
+  std::ifstream fin(schemaFile, std::ifstream::in);
+  if (!fin)
+  {
+    LERR("Failed to open schema [" << schemaFile << "].\n"
+        << " Set " << SchemaLocationEnvVar << " to the schema location.\n");
+    return false;
+  }
+
+  // Read the schema file
+  std::string schema;
+  char buffer[4096];
+  while (fin)
+  {
+    fin.read(buffer, sizeof(buffer));
+    schema.insert(schema.size(), buffer, fin.gcount());
+  }
+  if (schema.empty())
+  {
+    LERR("Failed to read schema file [" << schemaFile << "]\n");
+    return false;
+  }
+
+  // Apply the schema to the database
+  int returnCode = sqlite3_exec(_db.Handle(), schema.c_str(), NULL, 0, NULL);
+  if (returnCode != SQLITE_OK)
+  {
+    LERR("Failed to open log: " << sqlite3_errmsg(_db.Handle()) << "\n");
+    return false;
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool Log::Implementation::FlushChunk(const int64_t _topic)
+{
+  auto chunkIter = this->pendingChunks.find(_topic);
+  if (chunkIter == this->pendingChunks.end())
+    return true;
+  const PendingChunk &chunk = chunkIter->second;
+
+  std::string compressedData;
+  if (!CompressChunk(this->codec, chunk.data, compressedData))
+    return false;
+
+  const std::string sql =
+    "INSERT INTO chunks (topic_id, time_start, time_end, codec, raw_size,"
+    " data) VALUES (?001, ?002, ?003, ?004, ?005, ?006);";
+  raii_sqlite3::Statement *statement = this->CachedStatement(
+      this->insertChunkStatement, sql);
+  if (!statement)
+  {
+    LERR("Failed to compile insert chunk statement\n");
+    return false;
+  }
+
+  if (sqlite3_bind_int64(statement->Handle(), 1, _topic) != SQLITE_OK ||
+      sqlite3_bind_int64(statement->Handle(), 2,
+        chunk.messages.front().time.count()) != SQLITE_OK ||
+      sqlite3_bind_int64(statement->Handle(), 3,
+        chunk.messages.back().time.count()) != SQLITE_OK ||
+      sqlite3_bind_text(statement->Handle(), 4, this->codec.c_str(),
+        this->codec.size(), nullptr) != SQLITE_OK ||
+      sqlite3_bind_int64(statement->Handle(), 5, chunk.data.size())
+        != SQLITE_OK ||
+      sqlite3_bind_blob(statement->Handle(), 6, compressedData.data(),
+        compressedData.size(), nullptr) != SQLITE_OK)
+  {
+    LERR("Failed to bind chunk: " << sqlite3_errmsg(this->db->Handle())
+        << "\n");
+    return false;
+  }
+
+  int returnCode = sqlite3_step(statement->Handle());
+  sqlite3_reset(statement->Handle());
+  sqlite3_clear_bindings(statement->Handle());
+  if (returnCode != SQLITE_DONE)
+  {
+    LERR("Failed to insert chunk: " << returnCode << "\n");
+    return false;
+  }
+
+  // chunks.id is an alias for rowid
+  ChunkEntry entry;
+  entry.chunkId = sqlite3_last_insert_rowid(this->db->Handle());
+
+  // The messages table keeps one row per message, so time queries and the
+  // time_recv index work as for uncompressed logs.
+  for (const PendingMessage &msg : chunk.messages)
+  {
+    entry.offset = msg.offset;
+    entry.length = msg.length;
+    const std::string reference = EncodeChunkEntry(entry);
+    if (!this->InsertMessage(msg.time, _topic, reference.data(),
+          reference.size()))
+    {
+      return false;
+    }
+  }
+
+  this->pendingChunks.erase(chunkIter);
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool Log::Implementation::FlushChunks()
+{
+  while (!this->pendingChunks.empty())
+  {
+    if (!this->FlushChunk(this->pendingChunks.begin()->first))
+      return false;
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool Log::Implementation::FlushExpiredChunks()
+{
+  const auto now = std::chrono::steady_clock::now();
+  auto chunkIter = this->pendingChunks.begin();
+  while (chunkIter != this->pendingChunks.end())
+  {
+    const int64_t topic = chunkIter->first;
+    const bool expired = now - chunkIter->second.started >= this->chunkPeriod;
+
+    // Flushing erases the chunk
+    ++chunkIter;
+    if (expired && !this->FlushChunk(topic))
+      return false;
+  }
   return true;
 }
 
@@ -363,9 +675,15 @@ Log::Log(Log &&_other)  // NOLINT
 //////////////////////////////////////////////////
 Log::~Log()
 {
+  if (this->dataPtr && !this->dataPtr->pendingChunks.empty() &&
+      SQLITE_OK == this->dataPtr->BeginTransactionIfNotInOne())
+  {
+    this->dataPtr->FlushChunks();
+  }
+
   if (this->dataPtr && this->dataPtr->inTransaction)
   {
-    this->dataPtr->EndTransactionIfEnoughTimeHasPassed();
+    this->dataPtr->EndTransaction();
   }
 }
 
@@ -406,63 +724,23 @@ bool Log::Open(const std::string &_file, const std::ios_base::openmode _mode)
   // Don't need to create a schema if this is read only
   if (std::ios_base::out & _mode)
   {
-    // Test hook so tests can be run before `make install`
-    std::string schemaFile;
-    const char *envPath = std::getenv(SchemaLocationEnvVar.c_str());
-    if (envPath)
-    {
-      schemaFile = envPath;
-    }
-    else
-    {
-      schemaFile = SCHEMA_INSTALL_PATH;
-    }
-    schemaFile += "/0.1.0.sql";
-
     // Assume the database is uninitialized; use the schema to initialize it
-    LDBG("Schema file: " << schemaFile << "\n");
-    std::ifstream fin(schemaFile, std::ifstream::in);
-    if (!fin)
-    {
-      LERR("Failed to open schema [" << schemaFile << "].\n"
-          << " Set " << SchemaLocationEnvVar << " to the schema location.\n");
-      return false;
-    }
-
-    // Read the schema file
-    std::string schema;
-    char buffer[4096];
-    while (fin)
-    {
-      fin.read(buffer, sizeof(buffer));
-      schema.insert(schema.size(), buffer, fin.gcount());
-    }
-    if (schema.empty())
-    {
-      LERR("Failed to read schema file [" << schemaFile << "]\n");
+    if (!Implementation::ExecuteSqlFile(*db, "0.1.0.sql"))
       return false;
-    }
-
-    // Apply the schema to the database
-    int returnCode = sqlite3_exec(db->Handle(), schema.c_str(), NULL, 0, NULL);
-    if (returnCode != SQLITE_OK)
-    {
-      LERR("Failed to open log: " << sqlite3_errmsg(db->Handle()) << "\n");
-      return false;
-    }
   }
 
   this->dataPtr->db = std::move(db);
 
-  // Check the schema version
-  // TODO(sloretz) handle multiple versions
+  // Check the schema version. 0.2.0 adds compressed chunks to 0.1.0.
   std::string version = this->Version();
-  if ("0.1.0" != this->Version())
+  if ("0.1.0" != version && "0.2.0" != version)
   {
     LERR("Log file Version '" << version << "' is unsupported by this tool\n");
     this->dataPtr->db.reset();
     return false;
   }
+  this->dataPtr->compressed = ("0.2.0" == version);
+  this->dataPtr->writable = (std::ios_base::out & _mode) != 0;
 
   this->dataPtr->filename = _file;
   return true;
@@ -498,8 +776,38 @@ bool Log::InsertMessage(
     return false;
   }
 
+  this->dataPtr->messagesInserted = true;
+
+  if (!this->dataPtr->codec.empty())
+  {
+    if (_len > std::numeric_limits<uint32_t>::max())
+    {
+      LERR("Message on [" << _topic << "] is too large to be compressed\n");
+      return false;
+    }
+
+    // Append the message to its topic's chunk, and write the chunk once full
+    Implementation::PendingChunk &chunk =
+        this->dataPtr->pendingChunks[topicId];
+    if (chunk.messages.empty())
+      chunk.started = std::chrono::steady_clock::now();
+    chunk.messages.push_back({_time, static_cast<uint32_t>(chunk.data.size()),
+        static_cast<uint32_t>(_len)});
+    chunk.data.append(static_cast<const char *>(_data), _len);
+
+    if (chunk.data.size() >= this->dataPtr->chunkSize &&
+        !this->dataPtr->FlushChunk(topicId))
+    {
+      return false;
+    }
+
+    // Also write the chunks of topics that are slow to fill, so that their
+    // messages become visible and don't stay in memory
+    if (!this->dataPtr->FlushExpiredChunks())
+      return false;
+  }
   // Insert the message into the database
-  if (!this->dataPtr->InsertMessage(_time, topicId, _data, _len))
+  else if (!this->dataPtr->InsertMessage(_time, topicId, _data, _len))
   {
     return false;
   }
@@ -516,6 +824,109 @@ bool Log::InsertMessage(
   return true;
 }
 
+//////////////////////////////////////////////////
+void Log::SetTransactionPeriod(const std::chrono::milliseconds &_period)
+{
+  this->dataPtr->transactionPeriod = _period;
+}
+
+//////////////////////////////////////////////////
+std::chrono::milliseconds Log::TransactionPeriod() const
+{
+  return this->dataPtr->transactionPeriod;
+}
+
+//////////////////////////////////////////////////
+bool Log::SetJournalMode(const std::string &_mode)
+{
+  if (!this->Valid())
+    return false;
+
+  static const std::set<std::string> kModes =
+    {"DELETE", "TRUNCATE", "PERSIST", "MEMORY", "WAL", "OFF"};
+  if (kModes.find(_mode) == kModes.end())
+  {
+    LERR("Invalid journal mode [" << _mode << "]\n");
+    return false;
+  }
+
+  return this->dataPtr->SetPragma("journal_mode", _mode);
+}
+
+//////////////////////////////////////////////////
+bool Log::SetSynchronous(const std::string &_level)
+{
+  if (!this->Valid())
+    return false;
+
+  static const std::set<std::string> kLevels =
+    {"OFF", "NORMAL", "FULL", "EXTRA"};
+  if (kLevels.find(_level) == kLevels.end())
+  {
+    LERR("Invalid synchronous level [" << _level << "]\n");
+    return false;
+  }
+
+  return this->dataPtr->SetPragma("synchronous", _level);
+}
+
+//////////////////////////////////////////////////
+bool Log::SetCompression(const std::string &_codec,
+    const std::size_t _chunkSize)
+{
+  if (!this->Valid())
+    return false;
+
+  if (_codec != kZlibCodec)
+  {
+    LERR("Unsupported compression codec [" << _codec << "]\n");
+    return false;
+  }
+
+  // Offsets of messages in a chunk are stored on 32 bits
+  if (static_cast<uint64_t>(_chunkSize) > std::numeric_limits<uint32_t>::max())
+  {
+    LERR("Chunk size [" << _chunkSize << "] must be less than 4 GiB\n");
+    return false;
+  }
+
+  if (this->dataPtr->messagesInserted || !this->dataPtr->writable)
+  {
+    LERR("Compression must be enabled on a new log before inserting "
+         "messages\n");
+    return false;
+  }
+
+  if (!this->dataPtr->compressed)
+  {
+    if (!Implementation::ExecuteSqlFile(*this->dataPtr->db, "0.2.0.sql"))
+      return false;
+    this->dataPtr->compressed = true;
+  }
+
+  this->dataPtr->codec = _codec;
+  this->dataPtr->chunkSize = _chunkSize;
+  return true;
+}
+
+//////////////////////////////////////////////////
+std::string Log::Compression() const
+{
+  return this->dataPtr->codec;
+}
+
+//////////////////////////////////////////////////
+void Log::SetChunkPeriod(const std::chrono::milliseconds &_period)
+{
+  this->dataPtr->chunkPeriod = _period;
+}
+
+//////////////////////////////////////////////////
+std::chrono::milliseconds Log::ChunkPeriod() const
+{
+  return this->dataPtr->chunkPeriod;
+}
+
 //////////////////////////////////////////////////
 Batch Log::QueryMessages(const QueryOptions &_options)
 {
@@ -528,7 +939,8 @@ Batch Log::QueryMessages(const QueryOptions &_options)
 
   std::unique_ptr<BatchPrivate> batchPriv(
         new BatchPrivate(this->dataPtr->db,
-                         _options.GenerateStatements(*desc)));
+                         _options.GenerateStatements(*desc),
+                         this->dataPtr->compressed));
 
   return Batch(std::move(batchPriv));
 }
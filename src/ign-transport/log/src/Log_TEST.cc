@@ -16,8 +16,11 @@
 */
 
 #include <chrono>
+#include <cstdint>
 #include <ios>
+#include <limits>
 #include <string>
+#include <thread>
 #include <unordered_set>
 
 #include "ignition/transport/log/Log.hh"
@@ -238,6 +241,211 @@ TEST(Log, CheckVersion)
   EXPECT_EQ("0.1.0", logFile.Version());
 }
 
+//////////////////////////////////////////////////
+TEST(Log, TransactionPeriod)
+{
+  log::Log logFile;
+  EXPECT_EQ(500ms, logFile.TransactionPeriod());
+  logFile.SetTransactionPeriod(2s);
+  EXPECT_EQ(2s, logFile.TransactionPeriod());
+}
+
+//////////////////////////////////////////////////
+TEST(Log, Pragmas)
+{
+  log::Log logFile;
+  EXPECT_FALSE(logFile.SetJournalMode("WAL"));
+  EXPECT_FALSE(logFile.SetSynchronous("NORMAL"));
+
+  ASSERT_TRUE(logFile.Open(":memory:", std::ios_base::out));
+  EXPECT_TRUE(logFile.SetJournalMode("MEMORY"));
+  EXPECT_TRUE(logFile.SetSynchronous("NORMAL"));
+  EXPECT_FALSE(logFile.SetJournalMode("bogus"));
+  EXPECT_FALSE(logFile.SetSynchronous("NORMAL; DROP TABLE messages"));
+
+  // The log is still usable after changing the pragmas mid-transaction.
+  std::string data("Hello World");
+  EXPECT_TRUE(logFile.InsertMessage(1s, "/foo", "foo.type",
+      reinterpret_cast<const void *>(data.c_str()), data.size()));
+  EXPECT_TRUE(logFile.SetSynchronous("OFF"));
+  EXPECT_TRUE(logFile.InsertMessage(2s, "/foo", "foo.type",
+      reinterpret_cast<const void *>(data.c_str()), data.size()));
+
+  int count = 0;
+  for (const auto &msg : logFile.QueryMessages())
+  {
+    EXPECT_EQ(data, msg.Data());
+    ++count;
+  }
+  EXPECT_EQ(2, count);
+}
+
+//////////////////////////////////////////////////
+TEST(Log, InsertManyMessagesReusesStatements)
+{
+  log::Log logFile;
+  ASSERT_TRUE(logFile.Open(":memory:", std::ios_base::out));
+
+  for (int i = 0; i < 100; ++i)
+  {
+    const std::string data = std::to_string(i);
+    const std::string topic = "/topic" + std::to_string(i % 3);
+    EXPECT_TRUE(logFile.InsertMessage(std::chrono::seconds(i), topic,
+        "some.message.type", reinterpret_cast<const void *>(data.c_str()),
+        data.size()));
+  }
+
+  int i = 0;
+  for (const auto &msg : logFile.QueryMessages())
+  {
+    EXPECT_EQ(std::to_string(i), msg.Data());
+    EXPECT_EQ("/topic" + std::to_string(i % 3), msg.Topic());
+    ++i;
+  }
+  EXPECT_EQ(100, i);
+}
+
+//////////////////////////////////////////////////
+TEST(Log, SetCompressionErrors)
+{
+  log::Log unopened;
+  EXPECT_FALSE(unopened.SetCompression("zlib"));
+
+  const std::string uri = "file:compression_errors?mode=memory&cache=shared";
+  log::Log logFile;
+  ASSERT_TRUE(logFile.Open(uri, std::ios_base::out));
+
+  log::Log readOnly;
+  ASSERT_TRUE(readOnly.Open(uri, std::ios_base::in));
+  EXPECT_FALSE(readOnly.SetCompression("zlib"));
+
+  EXPECT_EQ("", logFile.Compression());
+  EXPECT_FALSE(logFile.SetCompression("lz4"));
+  EXPECT_EQ("", logFile.Compression());
+
+  const std::string data = "data";
+  EXPECT_TRUE(logFile.InsertMessage(1s, "/topic", "some.message.type",
+      reinterpret_cast<const void *>(data.c_str()), data.size()));
+
+  // Too late, messages were already inserted uncompressed
+  EXPECT_FALSE(logFile.SetCompression("zlib"));
+  EXPECT_EQ("0.1.0", logFile.Version());
+
+  // Offsets in a chunk wouldn't fit in 32 bits
+  log::Log newLog;
+  ASSERT_TRUE(newLog.Open(":memory:", std::ios_base::out));
+  EXPECT_FALSE(newLog.SetCompression("zlib",
+      static_cast<std::size_t>(std::numeric_limits<uint32_t>::max()) + 1u));
+  EXPECT_EQ("", newLog.Compression());
+  EXPECT_TRUE(newLog.SetCompression("zlib",
+      std::numeric_limits<uint32_t>::max()));
+}
+
+//////////////////////////////////////////////////
+TEST(Log, ChunkPeriod)
+{
+  log::Log logFile;
+  EXPECT_EQ(1s, logFile.ChunkPeriod());
+  logFile.SetChunkPeriod(2s);
+  EXPECT_EQ(2s, logFile.ChunkPeriod());
+}
+
+//////////////////////////////////////////////////
+TEST(Log, FlushExpiredChunks)
+{
+  const std::string uri = "file:expired_chunks?mode=memory&cache=shared";
+  log::Log writer;
+  ASSERT_TRUE(writer.Open(uri, std::ios_base::out));
+  ASSERT_TRUE(writer.SetCompression("zlib"));
+  writer.SetTransactionPeriod(0ms);
+
+  log::Log reader;
+  ASSERT_TRUE(reader.Open(uri, std::ios_base::in));
+
+  auto count = [&reader]()
+  {
+    int result = 0;
+    for (const auto &msg : reader.QueryMessages())
+    {
+      EXPECT_EQ("data", msg.Data());
+      ++result;
+    }
+    return result;
+  };
+
+  // Far from filling a chunk, so nothing is written within the period
+  const std::string data = "data";
+  EXPECT_TRUE(writer.InsertMessage(1s, "/slow", "some.message.type",
+      reinterpret_cast<const void *>(data.c_str()), data.size()));
+  EXPECT_EQ(0, count());
+
+  // Once the period has passed, inserting a message on any topic writes the
+  // chunks started before
+  writer.SetChunkPeriod(10ms);
+  std::this_thread::sleep_for(20ms);
+  EXPECT_TRUE(writer.InsertMessage(2s, "/other", "some.message.type",
+      reinterpret_cast<const void *>(data.c_str()), data.size()));
+  EXPECT_EQ(1, count());
+
+  // A zero period writes every message immediately
+  writer.SetChunkPeriod(0ms);
+  EXPECT_TRUE(writer.InsertMessage(3s, "/slow", "some.message.type",
+      reinterpret_cast<const void *>(data.c_str()), data.size()));
+  EXPECT_EQ(3, count());
+}
+
+//////////////////////////////////////////////////
+TEST(Log, InsertCompressedMessages)
+{
+  // A shared in-memory database lets a second connection read the log after
+  // the writer is closed and its last chunks are flushed.
+  const std::string uri = "file:compressed?mode=memory&cache=shared";
+  log::Log reader;
+  {
+    log::Log writer;
+    ASSERT_TRUE(writer.Open(uri, std::ios_base::out));
+    ASSERT_TRUE(writer.SetCompression("zlib", 64));
+    EXPECT_EQ("zlib", writer.Compression());
+    EXPECT_EQ("0.2.0", writer.Version());
+
+    ASSERT_TRUE(reader.Open(uri, std::ios_base::in));
+
+    for (int i = 0; i < 100; ++i)
+    {
+      const std::string data = "message " + std::to_string(i);
+      const std::string topic = "/topic" + std::to_string(i % 3);
+      EXPECT_TRUE(writer.InsertMessage(std::chrono::seconds(i), topic,
+          "some.message.type", reinterpret_cast<const void *>(data.c_str()),
+          data.size()));
+    }
+  }
+
+  int i = 0;
+  for (const auto &msg : reader.QueryMessages())
+  {
+    EXPECT_EQ("message " + std::to_string(i), msg.Data());
+    EXPECT_EQ("/topic" + std::to_string(i % 3), msg.Topic());
+    EXPECT_EQ(std::chrono::seconds(i), msg.TimeReceived());
+    ++i;
+  }
+  EXPECT_EQ(100, i);
+
+  // Time range queries go through the messages table as usual
+  i = 40;
+  for (const auto &msg : reader.QueryMessages(log::TopicList("/topic1",
+          log::QualifiedTimeRange(40s, 60s))))
+  {
+    while (i % 3 != 1)
+      ++i;
+    EXPECT_EQ("message " + std::to_string(i), msg.Data());
+    ++i;
+  }
+  EXPECT_EQ(59, i);
+
+  EXPECT_EQ(0s, reader.StartTime());
+  EXPECT_EQ(99s, reader.EndTime());
+}
+
 //////////////////////////////////////////////////
 TEST(Log, NullDescriptorUnopenedLog)
 {
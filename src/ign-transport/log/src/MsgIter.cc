@@ -18,8 +18,10 @@
 #include <sqlite3.h>
 
 #include <memory>
+#include <string>
 #include <vector>
 
+#include "Chunk.hh"
 #include "Console.hh"
 #include "ignition/transport/log/MsgIter.hh"
 #include "MsgIterPrivate.hh"
@@ -36,8 +38,9 @@ MsgIterPrivate::MsgIterPrivate()
 //////////////////////////////////////////////////
 MsgIterPrivate::MsgIterPrivate(
     const std::shared_ptr<raii_sqlite3::Database> &_db,
-    const std::shared_ptr<std::vector<SqlStatement>> &_statements)
-  : db(_db), statements(_statements)
+    const std::shared_ptr<std::vector<SqlStatement>> &_statements,
+    const bool _compressed)
+  : db(_db), statements(_statements), compressed(_compressed)
 {
   PrepareNextStatement();
 }
@@ -105,6 +108,54 @@ bool MsgIterPrivate::PrepareNextStatement()
   return true;
 }
 
+//////////////////////////////////////////////////
+const std::string *MsgIterPrivate::Chunk(const std::string &_key,
+    const int64_t _chunkId)
+{
+  auto &cached = this->chunks[_key];
+  if (!cached.second.empty() && cached.first == _chunkId)
+    return &cached.second;
+
+  if (!this->chunkStatement)
+  {
+    this->chunkStatement.reset(new raii_sqlite3::Statement(*(this->db),
+        "SELECT codec, raw_size, data FROM chunks WHERE id = ?001;"));
+    if (!*this->chunkStatement)
+    {
+      LERR("Failed to prepare chunk query: " << sqlite3_errmsg(
+          this->db->Handle()) << "\n");
+      this->chunkStatement.reset();
+      return nullptr;
+    }
+  }
+
+  sqlite3_stmt *handle = this->chunkStatement->Handle();
+  sqlite3_reset(handle);
+  sqlite3_bind_int64(handle, 1, _chunkId);
+  if (sqlite3_step(handle) != SQLITE_ROW)
+  {
+    LERR("Chunk [" << _chunkId << "] is missing from the log\n");
+    return nullptr;
+  }
+
+  const std::string codec(reinterpret_cast<const char *>(
+      sqlite3_column_text(handle, 0)), sqlite3_column_bytes(handle, 0));
+  const sqlite_int64 rawSize = sqlite3_column_int64(handle, 1);
+  const void *data = sqlite3_column_blob(handle, 2);
+  const std::size_t numData = sqlite3_column_bytes(handle, 2);
+
+  // The previous chunk of this topic is released here, which is safe because
+  // the message pointing into it is being replaced.
+  const bool success = DecompressChunk(codec, data, numData,
+      static_cast<std::size_t>(rawSize), cached.second);
+  sqlite3_reset(handle);
+  if (!success)
+    return nullptr;
+
+  cached.first = _chunkId;
+  return &cached.second;
+}
+
 //////////////////////////////////////////////////
 void MsgIterPrivate::StepStatement()
 {
@@ -141,6 +192,33 @@ void MsgIterPrivate::StepStatement()
       const void *data = sqlite3_column_blob(this->statement->Handle(), 4);
       std::size_t numData = sqlite3_column_bytes(this->statement->Handle(), 4);
 
+      // In compressed logs the data is a reference into a chunk
+      if (this->compressed)
+      {
+        ChunkEntry entry;
+        const std::string *chunk = nullptr;
+        if (DecodeChunkEntry(data, numData, entry))
+        {
+          std::string key(reinterpret_cast<const char*>(topic), numTopic);
+          key.push_back('\0');
+          key.append(reinterpret_cast<const char*>(type), numType);
+          chunk = this->Chunk(key, entry.chunkId);
+        }
+
+        if (chunk && static_cast<std::size_t>(entry.offset) + entry.length
+            <= chunk->size())
+        {
+          data = chunk->data() + entry.offset;
+          numData = entry.length;
+        }
+        else
+        {
+          LERR("Failed to read compressed message\n");
+          data = nullptr;
+          numData = 0;
+        }
+      }
+
       this->message.reset(new Message(
             timeRecv,
             data, numData,
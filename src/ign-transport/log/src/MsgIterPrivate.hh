@@ -18,7 +18,11 @@
 #ifndef IGNITION_TRANSPORT_LOG_MSGITERPRIVATE_HH_
 #define IGNITION_TRANSPORT_LOG_MSGITERPRIVATE_HH_
 
+#include <cstdint>
 #include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "ignition/transport/log/Message.hh"
@@ -46,8 +50,11 @@ inline namespace IGNITION_TRANSPORT_VERSION_NAMESPACE
     /// \param[in] _db Shared reference to a database
     /// \param[in] _statements A set of SQL statements that this message will
     /// iterate through
+    /// \param[in] _compressed True if the log stores messages in compressed
+    /// chunks
     public: MsgIterPrivate(const std::shared_ptr<raii_sqlite3::Database> &_db,
-        const std::shared_ptr<std::vector<SqlStatement>> &_statements);
+        const std::shared_ptr<std::vector<SqlStatement>> &_statements,
+        bool _compressed = false);
 
     /// \brief destructor
     public: ~MsgIterPrivate();
@@ -59,6 +66,14 @@ inline namespace IGNITION_TRANSPORT_VERSION_NAMESPACE
     /// \return true if the statement was sucessfully prepared
     public: bool PrepareNextStatement();
 
+    /// \brief Get the uncompressed data of a chunk, loading it if it is not
+    /// the one currently cached for its topic
+    /// \param[in] _key Topic name and message type of the chunk
+    /// \param[in] _chunkId Row of the chunk in the chunks table
+    /// \return The uncompressed data, or nullptr if it could not be loaded
+    public: const std::string *Chunk(const std::string &_key,
+        int64_t _chunkId);
+
     /// \brief a statement that is being stepped
     public: std::unique_ptr<raii_sqlite3::Statement> statement;
 
@@ -73,6 +88,18 @@ inline namespace IGNITION_TRANSPORT_VERSION_NAMESPACE
 
     /// \brief the message this iterator is at
     public: std::unique_ptr<Message> message;
+
+    /// \brief True if message data are references into compressed chunks
+    public: bool compressed = false;
+
+    /// \brief Statement used to load chunks
+    public: std::unique_ptr<raii_sqlite3::Statement> chunkStatement;
+
+    /// \brief The uncompressed chunk in use by each topic and message type.
+    /// Messages of a topic are read in order, so only one chunk per topic
+    /// needs to be kept in memory.
+    public: std::unordered_map<std::string,
+        std::pair<int64_t, std::string>> chunks;
   };
 }
 }
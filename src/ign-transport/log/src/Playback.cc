@@ -556,7 +556,8 @@ void PlaybackHandle::Implementation::StartPlayback()
           this->playbackTime = this->nextMessageTime;
           this->lastEventTime =
               std::chrono::steady_clock::now().time_since_epoch();
-          this->nextMessageTime = messageIter->TimeReceived();
+          if (this->messageIter != this->batch.end())
+            this->nextMessageTime = this->messageIter->TimeReceived();
           }
         }
         // If a custom step has been requested, always from a paused state,
@@ -644,17 +645,29 @@ void PlaybackHandle::Implementation::Seek(
     LERR("Seek can't be called from a stopped playback.\n");
     return;
   }
-  const QualifiedTime beginTime(this->firstMessageTime + _newElapsedTime);
-  const QualifiedTime endTime(std::chrono::nanoseconds::max());
-  const QualifiedTimeRange timeRange(beginTime, endTime);
+  // The messages table is indexed by time_recv, so the query below lands on
+  // the first message at or after the target time in O(log n), rather than
+  // stepping through every message that precedes it.
+  const QualifiedTimeRange timeRange = QualifiedTimeRange::From(
+      QualifiedTime(this->firstMessageTime + _newElapsedTime));
   {
     std::unique_lock<std::mutex> lk(this->batchMutex);
     this->batch = this->logFile->QueryMessages(
         TopicList::Create(this->trackedTopics, timeRange));
     this->messageIter = this->batch.begin();
+
+    if (this->messageIter == this->batch.end())
+    {
+      // Seeking past the last message is the same as reaching the end.
+      this->playbackTime = this->playbackEndTime;
+      this->nextMessageTime = this->playbackEndTime;
+    }
+    else
+    {
+      this->playbackTime = this->messageIter->TimeReceived();
+      this->nextMessageTime = this->messageIter->TimeReceived();
+    }
   }
-  this->playbackTime = this->messageIter->TimeReceived();
-  this->nextMessageTime = this->messageIter->TimeReceived();
   this->boundaryTime = std::chrono::nanoseconds::max();
   this->lastEventTime = std::chrono::steady_clock::now().time_since_epoch();
 }
@@ -16,12 +16,15 @@
 */
 
 #include <chrono>
+#include <condition_variable>
 #include <cstdint>
 #include <functional>
 #include <memory>
 #include <mutex>
 #include <regex>
 #include <set>
+#include <string>
+#include <thread>
 #include <vector>
 
 #include <ignition/transport/Clock.hh>
@@ -64,6 +67,26 @@ class ignition::transport::log::Recorder::Implementation
   /// \sa Recorder::AddTopic(const std::regex&)
   public: int64_t AddTopic(const std::regex &_pattern);
 
+  /// \brief Write the queued messages into the log file until recording
+  /// stops. This function is designed to be run in a thread.
+  public: void WriteQueuedMessages();
+
+  /// \brief A message received but not yet written to the log file
+  public: struct QueuedMessage
+          {
+            /// \brief Time the message was received
+            public: std::chrono::nanoseconds time;
+
+            /// \brief Topic the message was received on
+            public: std::string topic;
+
+            /// \brief Message type
+            public: std::string type;
+
+            /// \brief Serialized message
+            public: std::string data;
+          };
+
   /// \brief log file or nullptr if not recording
   public: std::unique_ptr<Log> logFile;
 
@@ -81,6 +104,37 @@ class ignition::transport::log::Recorder::Implementation
   /// \brief mutex for thread safety with log file
   public: std::mutex logFileMutex;
 
+  /// \brief Messages waiting to be written by the writer thread. Subscriber
+  /// callbacks only copy the data here, so a slow disk does not stall them.
+  public: std::vector<QueuedMessage> queue;
+
+  /// \brief Size of the data of the queued messages, in bytes
+  public: std::size_t queuedBytes = 0;
+
+  /// \brief Maximum value of queuedBytes
+  public: std::size_t maxQueueSize = 64 * 1024 * 1024;
+
+  /// \brief Number of messages dropped since recording started
+  public: uint64_t droppedMessages = 0;
+
+  /// \brief True while messages are dropped, so that the warning is printed
+  /// once each time the queue fills up
+  public: bool dropping = false;
+
+  /// \brief mutex to protect the queue, its size, the dropped messages and
+  /// the recording flag
+  public: mutable std::mutex queueMutex;
+
+  /// \brief Used to signal the writer thread when messages are queued or
+  /// when recording stops
+  public: std::condition_variable queueCondition;
+
+  /// \brief True while the writer thread should accept messages
+  public: bool recording = false;
+
+  /// \brief Thread writing the queued messages into the log file
+  public: std::thread writerThread;
+
   /// \brief node used to create subscriptions
   public: Node node;
 
@@ -130,19 +184,74 @@ void Recorder::Implementation::OnMessageReceived(
     LWRN("Clock isn't ready yet. Dropping message\n");
   }
 
-  std::lock_guard<std::mutex> lock(this->logFileMutex);
-
-  // Note: this->logFile will only be a nullptr before Start() has been called
-  // or after Stop() has been called. If it is a nullptr, then we are not
-  // recording anything yet, so we can just skip inserting the message.
-  if (this->logFile && !this->logFile->InsertMessage(
-        this->clock->Time(),
-        _info.Topic(),
-        _info.Type(),
-        reinterpret_cast<const void *>(_data),
-        _len))
+  const std::chrono::nanoseconds time = this->clock->Time();
+
+  {
+    std::lock_guard<std::mutex> lock(this->queueMutex);
+
+    // Note: recording will only be false before Start() has been called
+    // or after Stop() has been called. If it is false, then we are not
+    // recording anything yet, so we can just skip queueing the message.
+    if (!this->recording)
+      return;
+
+    // Drop the message rather than letting the memory grow without limit
+    // when the disk is slower than the incoming messages.
+    if (this->queuedBytes + _len > this->maxQueueSize)
+    {
+      ++this->droppedMessages;
+      if (!this->dropping)
+      {
+        LWRN("The queue of messages to be written is full. Dropping "
+             "messages\n");
+        this->dropping = true;
+      }
+      return;
+    }
+
+    this->queuedBytes += _len;
+    this->queue.push_back(
+        QueuedMessage{time, _info.Topic(), _info.Type(),
+                      std::string(_data, _len)});
+  }
+  this->queueCondition.notify_one();
+}
+
+//////////////////////////////////////////////////
+void Recorder::Implementation::WriteQueuedMessages()
+{
+  std::vector<QueuedMessage> messages;
+  while (true)
   {
-    LWRN("Failed to insert message into log file\n");
+    {
+      std::unique_lock<std::mutex> lock(this->queueMutex);
+      this->queueCondition.wait(lock, [this]
+        {
+          return !this->queue.empty() || !this->recording;
+        });
+
+      // Take every queued message at once so they are inserted together.
+      messages.swap(this->queue);
+      this->queuedBytes = 0;
+      this->dropping = false;
+      if (messages.empty() && !this->recording)
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(this->logFileMutex);
+    for (const QueuedMessage &msg : messages)
+    {
+      if (!this->logFile->InsertMessage(
+            msg.time,
+            msg.topic,
+            msg.type,
+            reinterpret_cast<const void *>(msg.data.c_str()),
+            msg.data.size()))
+      {
+        LWRN("Failed to insert message into log file\n");
+      }
+    }
+    messages.clear();
   }
 }
 
@@ -278,6 +387,14 @@ RecorderError Recorder::Start(const std::string &_file)
     return RecorderError::FAILED_TO_OPEN;
   }
 
+  {
+    std::lock_guard<std::mutex> queueLock(this->dataPtr->queueMutex);
+    this->dataPtr->recording = true;
+    this->dataPtr->droppedMessages = 0;
+  }
+  this->dataPtr->writerThread = std::thread(
+      &Recorder::Implementation::WriteQueuedMessages, this->dataPtr.get());
+
   LMSG("Started recording to [" << _file << "]\n");
 
   return RecorderError::SUCCESS;
@@ -286,10 +403,41 @@ RecorderError Recorder::Start(const std::string &_file)
 //////////////////////////////////////////////////
 void Recorder::Stop()
 {
+  {
+    std::lock_guard<std::mutex> queueLock(this->dataPtr->queueMutex);
+    this->dataPtr->recording = false;
+  }
+  this->dataPtr->queueCondition.notify_all();
+
+  // The writer thread flushes the messages still queued before exiting.
+  if (this->dataPtr->writerThread.joinable())
+    this->dataPtr->writerThread.join();
+
   std::lock_guard<std::mutex> lock(this->dataPtr->logFileMutex);
   this->dataPtr->logFile.reset(nullptr);
 }
 
+//////////////////////////////////////////////////
+void Recorder::SetMaxQueueSize(const std::size_t _bytes)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->queueMutex);
+  this->dataPtr->maxQueueSize = _bytes;
+}
+
+//////////////////////////////////////////////////
+std::size_t Recorder::MaxQueueSize() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->queueMutex);
+  return this->dataPtr->maxQueueSize;
+}
+
+//////////////////////////////////////////////////
+uint64_t Recorder::DroppedMessages() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->queueMutex);
+  return this->dataPtr->droppedMessages;
+}
+
 //////////////////////////////////////////////////
 RecorderError Recorder::AddTopic(const std::string &_topic)
 {
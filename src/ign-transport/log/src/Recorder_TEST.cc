@@ -89,6 +89,16 @@ TEST(Record, AddTopicRegex)
   EXPECT_EQ(0, recorder.AddTopic(std::regex("////")));
 }
 
+//////////////////////////////////////////////////
+TEST(Record, MaxQueueSize)
+{
+  transport::log::Recorder recorder;
+  EXPECT_EQ(64u * 1024u * 1024u, recorder.MaxQueueSize());
+  recorder.SetMaxQueueSize(1024u);
+  EXPECT_EQ(1024u, recorder.MaxQueueSize());
+  EXPECT_EQ(0u, recorder.DroppedMessages());
+}
+
 //////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
@@ -18,7 +18,9 @@
 #include <iostream>
 #include <regex>
 
+#include <ignition/transport/log/ColumnStore.hh>
 #include <ignition/transport/log/Export.hh>
+#include <ignition/transport/log/Log.hh>
 #include <ignition/transport/log/Playback.hh>
 #include <ignition/transport/log/Recorder.hh>
 #include <ignition/transport/Node.hh>
@@ -120,3 +122,31 @@ int playbackTopics(const char *_file, const char *_pattern, const int _wait_ms,
   LDBG("Shutting down\n");
   return SUCCESS;
 }
+
+//////////////////////////////////////////////////
+int exportColumns(const char *_file, const char *_directory,
+  const char *_pattern)
+{
+  std::regex regexPattern;
+  try
+  {
+    regexPattern = _pattern;
+  }
+  catch (const std::regex_error &e)
+  {
+    LERR("Regex pattern is invalid\n");
+    return BAD_REGEX;
+  }
+
+  transport::log::Log logFile;
+  if (!logFile.Open(_file, std::ios_base::in))
+    return FAILED_TO_OPEN;
+
+  if (!transport::log::ColumnStore::Export(logFile, _directory,
+        transport::log::TopicPattern(regexPattern)))
+  {
+    return FAILED_TO_EXPORT;
+  }
+
+  return SUCCESS;
+}
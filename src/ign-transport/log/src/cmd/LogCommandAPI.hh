@@ -27,6 +27,7 @@ extern "C"
     FAILED_TO_SUBSCRIBE = 4,
     INVALID_VERSION     = 5,
     INVALID_REMAP       = 6,
+    FAILED_TO_EXPORT    = 7,
   };
 
   /// \brief Sets verbosity of library
@@ -50,4 +51,14 @@ extern "C"
     const char *_pattern,
     const int _wait_ms,
     const char *_remap);
+
+  /// \brief Export the numeric fields of topics whose name matches the given
+  /// pattern to memory-mappable column files
+  /// \param[in] _file Path to the log file to export
+  /// \param[in] _directory Directory to write the column files to
+  /// \param[in] _pattern ECMAScript regular expression to match against topics
+  int IGNITION_TRANSPORT_LOG_VISIBLE exportColumns(
+    const char *_file,
+    const char *_directory,
+    const char *_pattern);
 }
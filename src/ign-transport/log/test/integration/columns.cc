@@ -0,0 +1,177 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <ignition/msgs/pose_v.pb.h>
+#include <ignition/msgs/time.pb.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "ignition/transport/log/ColumnStore.hh"
+#include "ignition/transport/log/Log.hh"
+#include "gtest/gtest.h"
+
+using namespace ignition;
+using namespace ignition::transport;
+using namespace std::chrono_literals;
+
+//////////////////////////////////////////////////
+/// \brief Insert a message into a log
+/// \param[in] _log Log to insert into
+/// \param[in] _time Time received
+/// \param[in] _topic Topic name
+/// \param[in] _msg Message
+void Insert(log::Log &_log, const std::chrono::nanoseconds &_time,
+    const std::string &_topic, const google::protobuf::Message &_msg)
+{
+  const std::string data = _msg.SerializeAsString();
+  ASSERT_TRUE(_log.InsertMessage(_time, _topic, _msg.GetTypeName(),
+      data.c_str(), data.size()));
+}
+
+//////////////////////////////////////////////////
+/// \brief Remove the files of an export
+/// \param[in] _directory Export directory
+void RemoveExport(const std::string &_directory)
+{
+  std::remove((_directory + "/columns.txt").c_str());
+  for (int t = 0; t < 4; ++t)
+  {
+    const std::string prefix = _directory + "/t" + std::to_string(t);
+    std::remove((prefix + "_time.col").c_str());
+    for (int c = 0; c < 64; ++c)
+      std::remove((prefix + "_" + std::to_string(c) + ".col").c_str());
+  }
+}
+
+//////////////////////////////////////////////////
+TEST(ColumnStore, ExportAndMap)
+{
+  const std::string dir =
+      std::string(IGN_TRANSPORT_LOG_BUILD_PATH) + "/columns_test";
+  RemoveExport(dir);
+
+  log::Log logFile;
+  ASSERT_TRUE(logFile.Open(":memory:", std::ios_base::out));
+
+  // The second pose only appears from the third message on
+  for (int i = 0; i < 5; ++i)
+  {
+    msgs::Pose_V poses;
+    for (int p = 0; p < (i < 2 ? 1 : 2); ++p)
+    {
+      msgs::Pose *pose = poses.add_pose();
+      pose->set_id(p + 10);
+      pose->mutable_position()->set_x(i + p * 0.5);
+    }
+    Insert(logFile, std::chrono::seconds(i), "/poses", poses);
+
+    msgs::Time clock;
+    clock.set_sec(i);
+    clock.set_nsec(500);
+    Insert(logFile, std::chrono::seconds(i) + 1ms, "/clock", clock);
+  }
+
+  // Unknown types are skipped
+  const std::string bytes = "not a protobuf message";
+  ASSERT_TRUE(logFile.InsertMessage(10s, "/unknown", "no.such.Type",
+      bytes.c_str(), bytes.size()));
+
+  ASSERT_TRUE(log::ColumnStore::Export(logFile, dir));
+
+  // Don't overwrite an export
+  EXPECT_FALSE(log::ColumnStore::Export(logFile, dir));
+
+  log::ColumnStore columns;
+  EXPECT_FALSE(columns.Valid());
+  ASSERT_TRUE(columns.Open(dir));
+  EXPECT_TRUE(columns.Valid());
+
+  EXPECT_EQ((std::vector<std::string>{"/clock", "/poses"}), columns.Topics());
+
+  // Clock
+  ASSERT_EQ(5u, columns.Size("/clock"));
+  const int64_t *clockTimes = columns.Times("/clock");
+  const int64_t *sec = columns.Integers("/clock", "sec");
+  const int64_t *nsec = columns.Integers("/clock", "nsec");
+  ASSERT_NE(nullptr, clockTimes);
+  ASSERT_NE(nullptr, sec);
+  ASSERT_NE(nullptr, nsec);
+  EXPECT_EQ(nullptr, columns.Doubles("/clock", "sec"));
+  for (int i = 0; i < 5; ++i)
+  {
+    EXPECT_EQ(std::chrono::nanoseconds(std::chrono::seconds(i) + 1ms).count(),
+        clockTimes[i]);
+    EXPECT_EQ(i, sec[i]);
+    EXPECT_EQ(500, nsec[i]);
+  }
+
+  // Poses
+  ASSERT_EQ(5u, columns.Size("/poses"));
+  const double *x0 = columns.Doubles("/poses", "pose[0].position.x");
+  const double *x1 = columns.Doubles("/poses", "pose[1].position.x");
+  const int64_t *id1 = columns.Integers("/poses", "pose[1].id");
+  ASSERT_NE(nullptr, x0);
+  ASSERT_NE(nullptr, x1);
+  ASSERT_NE(nullptr, id1);
+  for (int i = 0; i < 5; ++i)
+  {
+    EXPECT_DOUBLE_EQ(i, x0[i]);
+    if (i < 2)
+    {
+      EXPECT_TRUE(std::isnan(x1[i]));
+      EXPECT_EQ(0, id1[i]);
+    }
+    else
+    {
+      EXPECT_DOUBLE_EQ(i + 0.5, x1[i]);
+      EXPECT_EQ(11, id1[i]);
+    }
+  }
+
+  // Missing data
+  EXPECT_EQ(0u, columns.Size("/unknown"));
+  EXPECT_EQ(nullptr, columns.Times("/unknown"));
+  EXPECT_EQ(nullptr, columns.Doubles("/poses", "pose[2].position.x"));
+  EXPECT_TRUE(columns.Fields("/unknown").empty());
+
+  // Can't open twice
+  EXPECT_FALSE(columns.Open(dir));
+
+  RemoveExport(dir);
+}
+
+//////////////////////////////////////////////////
+TEST(ColumnStore, OpenMissing)
+{
+  log::ColumnStore columns;
+  EXPECT_FALSE(columns.Open(
+      std::string(IGN_TRANSPORT_LOG_BUILD_PATH) + "/no_columns_here"));
+  EXPECT_FALSE(columns.Valid());
+  EXPECT_TRUE(columns.Topics().empty());
+}
+
+//////////////////////////////////////////////////
+TEST(ColumnStore, ExportInvalidLog)
+{
+  log::Log logFile;
+  EXPECT_FALSE(log::ColumnStore::Export(logFile,
+      std::string(IGN_TRANSPORT_LOG_BUILD_PATH) + "/columns_invalid"));
+}
@@ -271,6 +271,86 @@ TEST(recorder, BeginRecordingAllBeforeAdvertisement)
   RecordPatternBeforeAdvertisement(std::regex(".*"));
 }
 
+//////////////////////////////////////////////////
+/// \brief Record with a bounded queue of messages waiting to be written.
+/// Messages which don't fit in the queue are dropped and counted, and the
+/// others are recorded.
+/// \param[in] _maxQueueSize Maximum size of the queue, in bytes.
+/// \param[in] _logName Name of the log.
+/// \param[out] _recorded Number of messages recorded.
+/// \param[out] _dropped Number of messages dropped.
+/// \return Number of messages published.
+int64_t RecordWithBoundedQueue(const std::size_t _maxQueueSize,
+    const std::string &_logName, int64_t &_recorded, uint64_t &_dropped)
+{
+  std::vector<std::string> topics = {"/foo", "/bar"};
+
+  ignition::transport::log::Recorder recorder;
+  recorder.SetMaxQueueSize(_maxQueueSize);
+  EXPECT_EQ(_maxQueueSize, recorder.MaxQueueSize());
+  for (const std::string &topic : topics)
+    recorder.AddTopic(topic);
+
+  EXPECT_EQ(recorder.Start(_logName),
+            ignition::transport::log::RecorderError::SUCCESS);
+  EXPECT_EQ(0u, recorder.DroppedMessages());
+
+  const int numChirps = 100;
+  testing::forkHandlerType chirper =
+      ignition::transport::log::test::BeginChirps(topics, numChirps, partition);
+
+  // Wait for the chirping to finish
+  testing::waitAndCleanupFork(chirper);
+
+  // Wait to make sure our callbacks are done processing the incoming messages
+  std::this_thread::sleep_for(std::chrono::seconds(1));
+
+  // Open log before stopping so sqlite memory database is shared
+  ignition::transport::log::Log log;
+  EXPECT_TRUE(log.Open(_logName));
+  recorder.Stop();
+
+  _dropped = recorder.DroppedMessages();
+  _recorded = 0;
+  for (const ignition::transport::log::Message &msg : log.QueryMessages())
+  {
+    EXPECT_FALSE(msg.Data().empty());
+    ++_recorded;
+  }
+
+  return numChirps * static_cast<int64_t>(topics.size());
+}
+
+//////////////////////////////////////////////////
+/// \brief No message fits in an empty queue, so every message is dropped.
+TEST(recorder, DropMessagesWhenQueueIsFull)
+{
+  int64_t recorded;
+  uint64_t dropped;
+  const int64_t published = RecordWithBoundedQueue(0u,
+      "file:recorderDropMessagesWhenQueueIsFull?mode=memory&cache=shared",
+      recorded, dropped);
+
+  EXPECT_EQ(0, recorded);
+  EXPECT_EQ(static_cast<uint64_t>(published), dropped);
+}
+
+//////////////////////////////////////////////////
+/// \brief The queue only holds a couple of chirps, so how many messages are
+/// dropped depends on how fast they are written, but each message is either
+/// recorded or dropped.
+TEST(recorder, SmallQueueAccountsForEveryMessage)
+{
+  int64_t recorded;
+  uint64_t dropped;
+  const int64_t published = RecordWithBoundedQueue(4u,
+      "file:recorderSmallQueueAccountsForEveryMessage?mode=memory&cache=shared",
+      recorded, dropped);
+
+  EXPECT_LT(0, recorded);
+  EXPECT_EQ(published, recorded + static_cast<int64_t>(dropped));
+}
+
 //////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
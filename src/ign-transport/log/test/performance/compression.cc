@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include <ignition/transport/log/Log.hh>
+
+using namespace ignition;
+using namespace ignition::transport;
+
+/// \brief Number of messages written by each benchmark.
+static const int kNumMessages = 100000;
+
+/// \brief Number of topics the messages are spread over.
+static const int kNumTopics = 10;
+
+/// \brief Number of poses in each message.
+static const int kNumPoses = 20;
+
+//////////////////////////////////////////////////
+/// \brief Create a message resembling a serialized list of named poses
+/// following smooth trajectories, which is typical of recorded state.
+/// \param[in] _index Index of the message.
+/// \return Message data
+std::string PoseMessage(int _index)
+{
+  std::string data;
+  for (int i = 0; i < kNumPoses; ++i)
+  {
+    data += "model_" + std::to_string(i) + "::link";
+    for (int j = 0; j < 7; ++j)
+    {
+      const double value = (i + 1) * 0.1 * j + _index * 1e-4 * (j + 1);
+      char bytes[sizeof(double)];
+      std::memcpy(bytes, &value, sizeof(double));
+      data.append(bytes, sizeof(double));
+    }
+  }
+  return data;
+}
+
+//////////////////////////////////////////////////
+/// \brief Write and read back kNumMessages, reporting file size and
+/// throughput.
+/// \param[in] _codec Compression codec, or empty for none.
+void WriteAndRead(const std::string &_codec)
+{
+  const std::string name = _codec.empty() ? "none" : _codec;
+  const std::string logName = std::string(IGN_TRANSPORT_LOG_BUILD_PATH) +
+    "/compression_" + name + ".tlog";
+  std::remove(logName.c_str());
+
+  std::size_t rawBytes = 0;
+  auto start = std::chrono::steady_clock::now();
+  {
+    log::Log logFile;
+    ASSERT_TRUE(logFile.Open(logName, std::ios_base::out));
+    if (!_codec.empty())
+      ASSERT_TRUE(logFile.SetCompression(_codec));
+
+    for (int i = 0; i < kNumMessages; ++i)
+    {
+      const std::string data = PoseMessage(i);
+      rawBytes += data.size();
+      ASSERT_TRUE(logFile.InsertMessage(
+          std::chrono::milliseconds(i),
+          "/topic" + std::to_string(i % kNumTopics),
+          "ignition.msgs.Pose_V",
+          reinterpret_cast<const void *>(data.c_str()),
+          data.size()));
+    }
+    // Pending chunks and the last transaction are written on close.
+  }
+  const double writeSeconds = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - start).count();
+
+  std::ifstream file(logName, std::ios::binary | std::ios::ate);
+  const double fileBytes = static_cast<double>(file.tellg());
+
+  start = std::chrono::steady_clock::now();
+  std::size_t readBytes = 0;
+  int count = 0;
+  {
+    log::Log logFile;
+    ASSERT_TRUE(logFile.Open(logName, std::ios_base::in));
+    for (const log::Message &msg : logFile.QueryMessages())
+    {
+      readBytes += msg.Data().size();
+      ++count;
+    }
+  }
+  const double readSeconds = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - start).count();
+
+  EXPECT_EQ(kNumMessages, count);
+  EXPECT_EQ(rawBytes, readBytes);
+
+  const double mb = rawBytes / (1024.0 * 1024.0);
+  std::cout << "[" << name << "] "
+            << "file " << fileBytes / (1024.0 * 1024.0) << " MiB, "
+            << "ratio " << rawBytes / fileBytes << ", "
+            << "write " << mb / writeSeconds << " MiB/s, "
+            << "read " << mb / readSeconds << " MiB/s"
+            << std::endl;
+
+  std::remove(logName.c_str());
+}
+
+//////////////////////////////////////////////////
+TEST(LogCompression, None)
+{
+  WriteAndRead("");
+}
+
+//////////////////////////////////////////////////
+TEST(LogCompression, Zlib)
+{
+  WriteAndRead("zlib");
+}
@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <iostream>
+#include <string>
+
+#include <ignition/transport/log/Log.hh>
+
+using namespace ignition;
+using namespace ignition::transport;
+using namespace std::chrono_literals;
+
+/// \brief Number of messages inserted by each benchmark.
+static const int kNumMessages = 200000;
+
+/// \brief Number of topics the messages are spread over.
+static const int kNumTopics = 20;
+
+/// \brief Size of each message (bytes).
+static const std::size_t kMessageSize = 256;
+
+//////////////////////////////////////////////////
+/// \brief Insert kNumMessages into a new log file and report the sustained
+/// insertion rate.
+/// \param[in] _name Name of the configuration being measured.
+/// \param[in] _configure Function used to configure the log once opened.
+void InsertMessages(const std::string &_name,
+                    const std::function<void(log::Log &)> &_configure)
+{
+  const std::string logName =
+    std::string(IGN_TRANSPORT_LOG_BUILD_PATH) + "/insert_" + _name + ".tlog";
+  std::remove(logName.c_str());
+
+  const std::string data(kMessageSize, 'x');
+  std::chrono::steady_clock::time_point start;
+  {
+    log::Log logFile;
+    ASSERT_TRUE(logFile.Open(logName, std::ios_base::out));
+    _configure(logFile);
+
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kNumMessages; ++i)
+    {
+      ASSERT_TRUE(logFile.InsertMessage(
+          std::chrono::milliseconds(i),
+          "/topic" + std::to_string(i % kNumTopics),
+          "ignition.msgs.Bytes",
+          reinterpret_cast<const void *>(data.c_str()),
+          data.size()));
+    }
+    // The last transaction is committed when the log is closed.
+  }
+  auto elapsed = std::chrono::steady_clock::now() - start;
+
+  const double seconds = std::chrono::duration<double>(elapsed).count();
+  std::cout << "[" << _name << "] " << kNumMessages << " messages in "
+            << seconds << " s: " << kNumMessages / seconds << " msgs/sec"
+            << std::endl;
+
+  // Make sure everything made it to the file.
+  log::Log logFile;
+  ASSERT_TRUE(logFile.Open(logName, std::ios_base::in));
+  int count = 0;
+  for (const log::Message &msg : logFile.QueryMessages())
+  {
+    EXPECT_EQ(kMessageSize, msg.Data().size());
+    ++count;
+  }
+  EXPECT_EQ(kNumMessages, count);
+
+  std::remove(logName.c_str());
+}
+
+//////////////////////////////////////////////////
+TEST(LogInsert, Default)
+{
+  InsertMessages("default", [](log::Log &){});
+}
+
+//////////////////////////////////////////////////
+TEST(LogInsert, WalNormalSync)
+{
+  InsertMessages("wal", [](log::Log &_log)
+  {
+    EXPECT_TRUE(_log.SetJournalMode("WAL"));
+    EXPECT_TRUE(_log.SetSynchronous("NORMAL"));
+    _log.SetTransactionPeriod(2s);
+  });
+}
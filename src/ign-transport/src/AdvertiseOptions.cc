@@ -15,6 +15,7 @@
  *
 */
 
+#include <chrono>
 #include <cstdint>
 #include <cstring>
 #include <iostream>
@@ -57,6 +58,9 @@ namespace ignition
 
       /// \brief Default message publication rate.
       public: uint64_t msgsPerSec = kUnthrottled;
+
+      /// \brief Default batching window (no batching).
+      public: std::chrono::nanoseconds batchWindow{0};
     };
 
     /// \internal
@@ -190,6 +194,7 @@ AdvertiseMessageOptions &AdvertiseMessageOptions::operator=(
 {
   AdvertiseOptions::operator=(_other);
   this->SetMsgsPerSec(_other.MsgsPerSec());
+  this->SetBatchWindow(_other.BatchWindow());
   return *this;
 }
 
@@ -198,7 +203,8 @@ bool AdvertiseMessageOptions::operator==(
   const AdvertiseMessageOptions &_other) const
 {
   return AdvertiseOptions::operator==(_other) &&
-         this->MsgsPerSec() == _other.MsgsPerSec();
+         this->MsgsPerSec() == _other.MsgsPerSec() &&
+         this->BatchWindow() == _other.BatchWindow();
 }
 
 //////////////////////////////////////////////////
@@ -226,6 +232,25 @@ void AdvertiseMessageOptions::SetMsgsPerSec(const uint64_t _newMsgsPerSec)
   this->dataPtr->msgsPerSec = _newMsgsPerSec;
 }
 
+//////////////////////////////////////////////////
+bool AdvertiseMessageOptions::Batched() const
+{
+  return this->BatchWindow().count() > 0;
+}
+
+//////////////////////////////////////////////////
+std::chrono::nanoseconds AdvertiseMessageOptions::BatchWindow() const
+{
+  return this->dataPtr->batchWindow;
+}
+
+//////////////////////////////////////////////////
+void AdvertiseMessageOptions::SetBatchWindow(
+  const std::chrono::nanoseconds &_window)
+{
+  this->dataPtr->batchWindow = _window;
+}
+
 //////////////////////////////////////////////////
 size_t AdvertiseMessageOptions::Pack(char *_buffer) const
 {
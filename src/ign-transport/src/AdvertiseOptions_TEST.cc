@@ -15,6 +15,7 @@
  *
 */
 
+#include <chrono>
 #include <iostream>
 #include <string>
 #include <vector>
@@ -192,6 +193,18 @@ TEST(AdvertiseOptionsTest, msgStreamInsertion)
     "\tThrottled? Yes\n"
     "\tRate: 10 msgs/sec\n";
   EXPECT_EQ(output.str(), expectedOutput);
+
+  output.clear();
+  output.str("");
+  opts.SetBatchWindow(std::chrono::milliseconds(1));
+  output << opts;
+  expectedOutput =
+    "Advertise options:\n"
+    "\tScope: All\n"
+    "\tThrottled? Yes\n"
+    "\tRate: 10 msgs/sec\n"
+    "\tBatch window: 1000 us\n";
+  EXPECT_EQ(output.str(), expectedOutput);
 }
 
 //////////////////////////////////////////////////
@@ -210,6 +223,18 @@ TEST(AdvertiseOptionsTest, msgAccessors)
   opts.SetMsgsPerSec(10u);
   EXPECT_EQ(opts.MsgsPerSec(), 10u);
   EXPECT_TRUE(opts.Throttled());
+
+  // BatchWindow
+  EXPECT_FALSE(opts.Batched());
+  EXPECT_EQ(opts.BatchWindow(), std::chrono::nanoseconds::zero());
+  opts.SetBatchWindow(std::chrono::milliseconds(1));
+  EXPECT_EQ(opts.BatchWindow(), std::chrono::milliseconds(1));
+  EXPECT_TRUE(opts.Batched());
+
+  AdvertiseMessageOptions opts2(opts);
+  EXPECT_EQ(opts, opts2);
+  opts2.SetBatchWindow(std::chrono::nanoseconds::zero());
+  EXPECT_NE(opts, opts2);
 }
 
 //////////////////////////////////////////////////
@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef IGN_TRANSPORT_BATCHFRAME_HH_
+#define IGN_TRANSPORT_BATCHFRAME_HH_
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "ignition/transport/config.hh"
+
+namespace ignition
+{
+  namespace transport
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_TRANSPORT_VERSION_NAMESPACE {
+    //
+    /// \brief Prefix prepended to the message type of a batched frame.
+    /// The data of a batched frame is a sequence of
+    /// [uint32_t length][serialized message] records.
+    static constexpr const char *kBatchPrefix = "ign.batch:";
+
+    /// \brief Append a record to the data of a batched frame.
+    /// \param[in, out] _frame Data of the frame.
+    /// \param[in] _data Serialized message.
+    /// \param[in] _dataSize Size of the serialized message.
+    inline void AppendToBatch(std::string &_frame, const char *_data,
+        const std::size_t _dataSize)
+    {
+      const uint32_t len = static_cast<uint32_t>(_dataSize);
+      _frame.append(reinterpret_cast<const char *>(&len), sizeof(len));
+      _frame.append(_data, _dataSize);
+    }
+
+    /// \brief Split the data of a batched frame into its records.
+    /// \param[in] _frame Data of the frame.
+    /// \param[out] _records Serialized messages contained in the frame, in
+    /// the order they were appended.
+    /// \return True if the frame was well formed or false otherwise.
+    inline bool Unbatch(const std::string &_frame,
+        std::vector<std::string> &_records)
+    {
+      _records.clear();
+      std::size_t offset = 0;
+      while (offset < _frame.size())
+      {
+        uint32_t len;
+        if (_frame.size() - offset < sizeof(len))
+          return false;
+        memcpy(&len, _frame.data() + offset, sizeof(len));
+        offset += sizeof(len);
+
+        if (_frame.size() - offset < len)
+          return false;
+        _records.emplace_back(_frame, offset, len);
+        offset += len;
+      }
+      return true;
+    }
+    }
+  }
+}
+#endif
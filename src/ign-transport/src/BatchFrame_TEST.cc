@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "BatchFrame.hh"
+
+using namespace ignition;
+
+//////////////////////////////////////////////////
+/// \brief Check that the records of a frame come out in order.
+TEST(BatchFrameTest, RoundTrip)
+{
+  const std::vector<std::string> messages =
+    {"first", "", std::string("with\0null", 9), std::string(70000, 'x'),
+     "last"};
+
+  std::string frame;
+  for (const auto &msg : messages)
+    transport::AppendToBatch(frame, msg.data(), msg.size());
+
+  std::vector<std::string> records;
+  EXPECT_TRUE(transport::Unbatch(frame, records));
+  EXPECT_EQ(messages, records);
+
+  // An empty frame contains no records.
+  records.push_back("stale");
+  EXPECT_TRUE(transport::Unbatch("", records));
+  EXPECT_TRUE(records.empty());
+}
+
+//////////////////////////////////////////////////
+/// \brief Check that malformed frames are rejected.
+TEST(BatchFrameTest, Malformed)
+{
+  std::string frame;
+  transport::AppendToBatch(frame, "abc", 3);
+  transport::AppendToBatch(frame, "defgh", 5);
+
+  std::vector<std::string> records;
+
+  // Truncated payload.
+  EXPECT_FALSE(transport::Unbatch(frame.substr(0, frame.size() - 1), records));
+
+  // Truncated length.
+  EXPECT_FALSE(transport::Unbatch(frame.substr(0, 4 + 3 + 2), records));
+  EXPECT_FALSE(transport::Unbatch(std::string(3, '\0'), records));
+
+  // A length larger than the whole frame.
+  std::string huge(4, '\xff');
+  huge += "abc";
+  EXPECT_FALSE(transport::Unbatch(huge, records));
+}
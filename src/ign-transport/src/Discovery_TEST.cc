@@ -17,9 +17,11 @@
 
 #include <chrono>
 #include <cstdlib>
+#include <cstring>
 #include <memory>
 #include <string>
 #include <thread>
+#include <vector>
 
 #include "gtest/gtest.h"
 #include "ignition/transport/AdvertiseOptions.hh"
@@ -79,6 +81,67 @@ template<typename T> class DiscoveryDerived : public transport::Discovery<T>
     EXPECT_EQ(this->activity.find(_pUuid) !=
               this->activity.end(), _expectedActivity);
   };
+
+  /// \brief Serialize an ADVERTISE message.
+  /// \param[in] _pub Publisher advertised.
+  /// \return The message, starting with its length.
+  public: std::vector<char> AdvertiseBytes(const T &_pub) const
+  {
+    Header header(this->Version(), _pub.PUuid(), AdvType);
+    AdvertiseMessage<T> advMsg(header, _pub);
+    uint16_t len = static_cast<uint16_t>(advMsg.MsgLength() + sizeof(len));
+    std::vector<char> buffer(len);
+    memcpy(&buffer[0], &len, sizeof(len));
+    advMsg.Pack(&buffer[sizeof(len)]);
+    return buffer;
+  }
+
+  /// \brief Serialize a BUNDLE header.
+  /// \param[in] _pUuid Process UUID of the sender.
+  /// \return The header, preceded by room for the length of the BUNDLE.
+  public: std::vector<char> BundleBytes(const std::string &_pUuid) const
+  {
+    Header header(this->Version(), _pUuid, BundleType, FlagNoRelay);
+    std::vector<char> buffer(sizeof(uint16_t) + header.HeaderLength());
+    header.Pack(&buffer[sizeof(uint16_t)]);
+    return buffer;
+  }
+
+  /// \brief Process a datagram as if it had been received from a socket.
+  /// \param[in] _fromIp IP address of the sender.
+  /// \param[in] _datagram The datagram.
+  public: void Receive(const std::string &_fromIp,
+                       std::vector<char> _datagram)
+  {
+    this->DispatchDatagram(_fromIp, _datagram.data(), _datagram.size());
+  }
+
+  /// \brief Queue a message for the unicast relays.
+  /// \param[in] _msg The message, starting with its length.
+  public: void Relay(const std::vector<char> &_msg)
+  {
+    this->QueueRelay(_msg.data(), static_cast<uint16_t>(_msg.size()));
+  }
+
+  /// \brief Forward the queued messages if they waited for long enough.
+  public: void FlushRelay()
+  {
+    this->UpdateRelay();
+  }
+
+  /// \brief Size of the BUNDLE waiting to be sent to the relays.
+  /// \return Size in bytes, 0 if nothing is queued.
+  public: size_t RelayBufferSize() const
+  {
+    return this->relayBuffer.size();
+  }
+
+  /// \brief Largest BUNDLE sent to the relays.
+  /// \return Size in bytes.
+  public: size_t MaxRelayBundle() const
+  {
+    return this->kMaxRelayBundle;
+  }
 };
 
 //////////////////////////////////////////////////
@@ -523,6 +586,189 @@ TEST(DiscoveryTest, TestActivity)
   discovery1.TestActivity(proc2Uuid, false);
 }
 
+//////////////////////////////////////////////////
+/// \brief Check that a process that missed an advertisement recovers it
+/// after receiving the digest of the advertiser, as the advertisements are
+/// not periodically repeated.
+TEST(DiscoveryTest, TestSyncMissedAdvertise)
+{
+  reset();
+
+  auto proc1Uuid = testing::getRandomNumber();
+  auto proc2Uuid = testing::getRandomNumber();
+  MessagePublisher publisher(g_topic, addr1, ctrl1, proc1Uuid, nUuid1, "t",
+    AdvertiseMessageOptions());
+
+  MsgDiscovery discovery1(proc1Uuid, g_msgPort);
+  discovery1.SetHeartbeatInterval(200);
+  discovery1.Start();
+  EXPECT_TRUE(discovery1.Advertise(publisher));
+
+  // Give some time for the advertisement to be sent before discovery2 starts.
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+  MsgDiscovery discovery2(proc2Uuid, g_msgPort);
+  discovery2.SetHeartbeatInterval(200);
+  discovery2.ConnectionsCb(onDiscoveryResponseMultiple);
+  discovery2.Start();
+
+  waitForCallback(MaxIters, Nap, connectionExecuted);
+
+  EXPECT_TRUE(connectionExecuted);
+  EXPECT_FALSE(disconnectionExecuted);
+  EXPECT_EQ(g_counter, 1);
+
+  Addresses_M<MessagePublisher> addresses;
+  EXPECT_TRUE(discovery2.Publishers(g_topic, addresses));
+  EXPECT_EQ(addresses[proc1Uuid].size(), 1u);
+}
+
+//////////////////////////////////////////////////
+/// \brief Check that a publisher that a process no longer advertises, for
+/// instance because the unadvertisement was lost, is removed once its digest
+/// doesn't match the one of that process and the process answers the SYNC.
+TEST(DiscoveryTest, TestSyncMissedUnadvertise)
+{
+  reset();
+
+  auto proc1Uuid = testing::getRandomNumber();
+  auto proc2Uuid = testing::getRandomNumber();
+  MessagePublisher publisher(g_topic, addr1, ctrl1, proc1Uuid, nUuid1, "t",
+    AdvertiseMessageOptions());
+  MessagePublisher stale(g_topic, addr2, ctrl2, proc1Uuid, nUuid2, "t",
+    AdvertiseMessageOptions());
+
+  MsgDiscovery discovery1(proc1Uuid, g_msgPort);
+  discovery1.SetHeartbeatInterval(200);
+  discovery1.Start();
+  EXPECT_TRUE(discovery1.Advertise(publisher));
+
+  DiscoveryDerived<MessagePublisher> discovery2(proc2Uuid, g_msgPort);
+  discovery2.SetHeartbeatInterval(200);
+  discovery2.DisconnectionsCb([](const MessagePublisher &_publisher)
+  {
+    EXPECT_EQ(_publisher.NUuid(), nUuid2);
+    disconnectionExecuted = true;
+  });
+
+  // The advertisement of a publisher that proc1 doesn't have anymore.
+  discovery2.Receive(discovery2.HostAddr(), discovery2.AdvertiseBytes(stale));
+  Addresses_M<MessagePublisher> addresses;
+  EXPECT_TRUE(discovery2.Publishers(g_topic, addresses));
+  EXPECT_EQ(addresses[proc1Uuid].size(), 1u);
+
+  discovery2.Start();
+  waitForCallback(MaxIters, Nap, disconnectionExecuted);
+  EXPECT_TRUE(disconnectionExecuted);
+
+  // Only the publisher still advertised remains.
+  std::this_thread::sleep_for(std::chrono::milliseconds(
+    discovery1.HeartbeatInterval() * 2));
+  addresses.clear();
+  EXPECT_TRUE(discovery2.Publishers(g_topic, addresses));
+  ASSERT_EQ(addresses[proc1Uuid].size(), 1u);
+  EXPECT_EQ(addresses[proc1Uuid].at(0).NUuid(), nUuid1);
+}
+
+//////////////////////////////////////////////////
+/// \brief Check that the messages forwarded to the relays are sent in
+/// bundles that fit in a datagram, and at most after a few milliseconds.
+TEST(DiscoveryTest, TestRelayBundle)
+{
+  setenv("IGN_RELAY", "127.0.0.1", 1);
+  auto procUuid = testing::getRandomNumber();
+  DiscoveryDerived<MessagePublisher> discovery(procUuid, g_msgPort);
+  unsetenv("IGN_RELAY");
+
+  MessagePublisher publisher(g_topic, addr1, ctrl1,
+    testing::getRandomNumber(), nUuid1, "t", AdvertiseMessageOptions());
+  auto msg = discovery.AdvertiseBytes(publisher);
+  const size_t headerLength = discovery.BundleBytes(procUuid).size();
+
+  // Messages are aggregated until the next one doesn't fit.
+  EXPECT_EQ(0u, discovery.RelayBufferSize());
+  discovery.Relay(msg);
+  EXPECT_EQ(headerLength + msg.size(), discovery.RelayBufferSize());
+
+  const size_t perBundle =
+    (discovery.MaxRelayBundle() - headerLength) / msg.size();
+  ASSERT_GT(perBundle, 1u);
+  for (size_t i = 1; i < perBundle; ++i)
+    discovery.Relay(msg);
+  EXPECT_EQ(headerLength + perBundle * msg.size(),
+    discovery.RelayBufferSize());
+  EXPECT_LE(discovery.RelayBufferSize(), discovery.MaxRelayBundle());
+
+  discovery.Relay(msg);
+  EXPECT_EQ(headerLength + msg.size(), discovery.RelayBufferSize());
+
+  // A message too large for a bundle is sent on its own, after the ones
+  // already queued.
+  std::vector<char> large(discovery.MaxRelayBundle(), 0);
+  uint16_t len = static_cast<uint16_t>(large.size());
+  memcpy(&large[0], &len, sizeof(len));
+  discovery.Relay(large);
+  EXPECT_EQ(0u, discovery.RelayBufferSize());
+
+  // The bundle is sent once its first message waited for 10 ms.
+  discovery.Relay(msg);
+  discovery.FlushRelay();
+  EXPECT_EQ(headerLength + msg.size(), discovery.RelayBufferSize());
+  std::this_thread::sleep_for(std::chrono::milliseconds(15));
+  discovery.FlushRelay();
+  EXPECT_EQ(0u, discovery.RelayBufferSize());
+}
+
+//////////////////////////////////////////////////
+/// \brief Check that all the complete messages of a BUNDLE are processed.
+TEST(DiscoveryTest, TestBundleDatagram)
+{
+  auto proc1Uuid = testing::getRandomNumber();
+  auto proc2Uuid = testing::getRandomNumber();
+  MessagePublisher publisher1(g_topic, addr1, ctrl1, proc1Uuid, nUuid1, "t",
+    AdvertiseMessageOptions());
+  MessagePublisher publisher2(g_topic, addr2, ctrl2, proc1Uuid, nUuid2, "t",
+    AdvertiseMessageOptions());
+  MessagePublisher publisher3(g_topic, addr2, ctrl2, proc1Uuid,
+    testing::getRandomNumber(), "t", AdvertiseMessageOptions());
+
+  DiscoveryDerived<MessagePublisher> discovery(proc2Uuid, g_msgPort);
+
+  auto datagram = discovery.BundleBytes(proc1Uuid);
+  for (const auto &pub : {publisher1, publisher2})
+  {
+    auto msg = discovery.AdvertiseBytes(pub);
+    datagram.insert(datagram.end(), msg.begin(), msg.end());
+  }
+
+  // The third message is truncated, but its length field isn't.
+  auto msg = discovery.AdvertiseBytes(publisher3);
+  datagram.insert(datagram.end(), msg.begin(), msg.end() - 4);
+
+  uint16_t len = static_cast<uint16_t>(datagram.size());
+  memcpy(&datagram[0], &len, sizeof(len));
+  discovery.Receive(discovery.HostAddr(), datagram);
+
+  Addresses_M<MessagePublisher> addresses;
+  EXPECT_TRUE(discovery.Publishers(g_topic, addresses));
+  ASSERT_EQ(addresses[proc1Uuid].size(), 2u);
+  EXPECT_EQ(addresses[proc1Uuid].at(0).NUuid(), nUuid1);
+  EXPECT_EQ(addresses[proc1Uuid].at(1).NUuid(), nUuid2);
+
+  // A BUNDLE whose length exceeds the datagram is dropped.
+  auto truncated = discovery.BundleBytes(proc1Uuid);
+  msg = discovery.AdvertiseBytes(publisher3);
+  truncated.insert(truncated.end(), msg.begin(), msg.end());
+  len = static_cast<uint16_t>(truncated.size());
+  memcpy(&truncated[0], &len, sizeof(len));
+  truncated.pop_back();
+  discovery.Receive(discovery.HostAddr(), truncated);
+
+  addresses.clear();
+  EXPECT_TRUE(discovery.Publishers(g_topic, addresses));
+  EXPECT_EQ(addresses[proc1Uuid].size(), 2u);
+}
+
 //////////////////////////////////////////////////
 /// \brief Check that a wrong IGN_IP value makes HostAddr() to return 127.0.0.1
 TEST(DiscoveryTest, WrongIgnIp)
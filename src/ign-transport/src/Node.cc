@@ -380,7 +380,18 @@ bool Node::Publisher::Publish(const ProtoMsg &_msg)
   }
 
   // Handle remote subscribers.
-  if (subscribers.haveRemote)
+  if (subscribers.haveRemote &&
+      this->dataPtr->publisher.Options().Batched())
+  {
+    // The message is coalesced with others published on the same topic.
+    bool result = this->dataPtr->shared->PublishBatched(
+          this->dataPtr->publisher.Topic(), msgBuffer, msgSize,
+          _msg.GetTypeName(), this->dataPtr->publisher.Options().BatchWindow());
+    delete[] msgBuffer;
+    if (!result)
+      return false;
+  }
+  else if (subscribers.haveRemote)
   {
     // Zmq will call this lambda when the message is published.
     // We use it to deallocate the buffer.
@@ -436,7 +447,17 @@ bool Node::Publisher::PublishRaw(
 
   // Remote subscribers. Note that the data is already presumed to be
   // serialized, so we just pass it along for publication.
-  if (subscribers.haveRemote)
+  if (subscribers.haveRemote &&
+      this->dataPtr->publisher.Options().Batched())
+  {
+    if (!this->dataPtr->shared->PublishBatched(
+          this->dataPtr->publisher.Topic(), _msgData.data(), _msgData.size(),
+          _msgType, this->dataPtr->publisher.Options().BatchWindow()))
+    {
+      return false;
+    }
+  }
+  else if (subscribers.haveRemote)
   {
     const std::size_t msgSize = _msgData.size();
     char *msgBuffer = static_cast<char *>(new char[msgSize]);
@@ -937,6 +958,9 @@ Node::Publisher Node::Advertise(const std::string &_topic,
     return Publisher();
   }
 
+  if (_options.Batched())
+    this->Shared()->EnableBatching();
+
   return Publisher(publisher);
 }
 
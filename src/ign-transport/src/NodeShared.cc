@@ -30,6 +30,7 @@
 #include <mutex>
 #include <string>
 #include <thread>
+#include <utility>
 #include <vector>
 
 // TODO(anyone): Remove after fixing the warnings.
@@ -52,6 +53,7 @@
 #include "ignition/transport/TransportTypes.hh"
 #include "ignition/transport/Uuid.hh"
 
+#include "BatchFrame.hh"
 #include "NodeSharedPrivate.hh"
 
 #ifdef _MSC_VER
@@ -216,13 +218,23 @@ NodeShared::NodeShared()
 //////////////////////////////////////////////////
 NodeShared::~NodeShared()
 {
-  // Tell the service thread to terminate.
-  this->dataPtr->exit = true;
+  // Tell the service thread to terminate. The flag is set while holding the
+  // batch mutex, so that the batch thread can't miss the notification
+  // between checking the flag and waiting.
+  {
+    std::lock_guard<std::mutex> lk(this->dataPtr->batchMutex);
+    this->dataPtr->exit = true;
+  }
 
   // Notify the local pubthread and join.
   this->dataPtr->signalNewPub.notify_all();
   this->dataPtr->pubThread.join();
 
+  // Notify the batch thread and join. Pending batches are flushed.
+  this->dataPtr->signalNewBatch.notify_all();
+  if (this->dataPtr->batchThread.joinable())
+    this->dataPtr->batchThread.join();
+
   // Wait for the service thread before exit.
   if (this->threadReception.joinable())
     this->threadReception.join();
@@ -299,6 +311,121 @@ bool NodeShared::Publish(
   return true;
 }
 
+//////////////////////////////////////////////////
+bool NodeShared::PublishBatched(
+    const std::string &_topic,
+    const char *_data,
+    const size_t _dataSize,
+    const std::string &_msgType,
+    const std::chrono::nanoseconds &_window)
+{
+  if (!_data && _dataSize > 0)
+  {
+    std::cerr << "NodeShared::PublishBatched() error: NULL input buffer"
+              << std::endl;
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lk(this->dataPtr->batchMutex);
+  auto key = std::make_pair(_topic, _msgType);
+  auto it = this->dataPtr->batches.find(key);
+  if (it == this->dataPtr->batches.end())
+  {
+    it = this->dataPtr->batches.emplace(
+      key, NodeSharedPrivate::BatchDetails()).first;
+    it->second.deadline = std::chrono::steady_clock::now() + _window;
+    this->dataPtr->signalNewBatch.notify_one();
+  }
+
+  AppendToBatch(it->second.buffer, _data, _dataSize);
+
+  // Do not wait for the window if the batch is already large enough. The
+  // batch thread publishes it, so that it can't overtake an older batch of
+  // the same topic that the thread is publishing.
+  if (it->second.buffer.size() >= NodeSharedPrivate::kMaxBatchSize)
+  {
+    this->dataPtr->fullBatches.emplace_back(key, std::move(it->second));
+    this->dataPtr->batches.erase(it);
+    this->dataPtr->signalNewBatch.notify_one();
+  }
+
+  return true;
+}
+
+//////////////////////////////////////////////////
+void NodeShared::EnableBatching()
+{
+  std::lock_guard<std::mutex> lk(this->dataPtr->batchMutex);
+  if (!this->dataPtr->batchThread.joinable())
+    this->dataPtr->batchThread = std::thread(&NodeShared::RunBatchTask, this);
+}
+
+//////////////////////////////////////////////////
+void NodeShared::RunBatchTask()
+{
+  auto myDeallocator = [](void *_buffer, void *)
+  {
+    delete[] reinterpret_cast<char*>(_buffer);
+  };
+
+  bool done = false;
+  while (!done)
+  {
+    std::vector<std::pair<std::pair<std::string, std::string>,
+      NodeSharedPrivate::BatchDetails>> ready;
+    {
+      std::unique_lock<std::mutex> lk(this->dataPtr->batchMutex);
+
+      // Sleep until the oldest batch expires or a new batch is created.
+      auto wakeUp = std::chrono::steady_clock::now() +
+        std::chrono::milliseconds(
+          static_cast<int64_t>(NodeSharedPrivate::Timeout));
+      for (const auto &batch : this->dataPtr->batches)
+        wakeUp = std::min(wakeUp, batch.second.deadline);
+
+      const std::size_t numBatches = this->dataPtr->batches.size();
+      this->dataPtr->signalNewBatch.wait_until(lk, wakeUp, [&]
+        {
+          return this->dataPtr->exit ||
+            !this->dataPtr->fullBatches.empty() ||
+            this->dataPtr->batches.size() != numBatches;
+        });
+
+      // Flush everything on exit.
+      done = this->dataPtr->exit;
+
+      // Full batches are older than any pending batch of the same topic,
+      // so they go first. This thread is the only one publishing batches,
+      // which keeps the messages of a topic in order.
+      for (auto &batch : this->dataPtr->fullBatches)
+        ready.push_back(std::move(batch));
+      this->dataPtr->fullBatches.clear();
+
+      auto now = std::chrono::steady_clock::now();
+      for (auto it = this->dataPtr->batches.begin();
+           it != this->dataPtr->batches.end();)
+      {
+        if (done || it->second.deadline <= now)
+        {
+          ready.emplace_back(it->first, std::move(it->second));
+          it = this->dataPtr->batches.erase(it);
+        }
+        else
+          ++it;
+      }
+    }
+
+    for (const auto &batch : ready)
+    {
+      const std::size_t size = batch.second.buffer.size();
+      char *buffer = new char[size];
+      memcpy(buffer, batch.second.buffer.data(), size);
+      this->Publish(batch.first.first, buffer, size, myDeallocator,
+        kBatchPrefix + batch.first.second);
+    }
+  }
+}
+
 //////////////////////////////////////////////////
 void NodeShared::RecvMsgUpdate()
 {
@@ -340,6 +467,24 @@ void NodeShared::RecvMsgUpdate()
     handlerInfo = this->CheckHandlerInfo(topic);
   }
 
+  // Batched frame: dispatch every message contained.
+  const std::string batchPrefix = kBatchPrefix;
+  if (msgType.compare(0, batchPrefix.size(), batchPrefix) == 0)
+  {
+    std::vector<std::string> records;
+    if (!Unbatch(data, records))
+    {
+      std::cerr << "NodeShared::RecvMsgUpdate() error: Malformed batch "
+                << "received on topic [" << topic << "]" << std::endl;
+      return;
+    }
+
+    msgType.erase(0, batchPrefix.size());
+    for (const auto &record : records)
+      this->TriggerSubscriberCallbacks(topic, record, msgType, handlerInfo);
+    return;
+  }
+
   this->TriggerSubscriberCallbacks(topic, data, msgType, handlerInfo);
 }
 
@@ -27,8 +27,14 @@
 #endif
 
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <map>
 #include <memory>
 #include <queue>
+#include <string>
+#include <utility>
 #include <vector>
 
 #include "ignition/transport/Discovery.hh"
@@ -169,6 +175,45 @@ namespace ignition
 
       /// \brief Handles local publication of messages on the pubQueue.
       public: void PublishThread();
+
+      ////////////////////////////////////////////////////////////////
+      /////// The following is for coalescing messages sent to   ///////
+      /////// remote subscribers (see AdvertiseMessageOptions). ///////
+      ////////////////////////////////////////////////////////////////
+
+      /// \brief A batch is flushed as soon as it reaches this size (bytes),
+      /// regardless of its window.
+      public: static const std::size_t kMaxBatchSize = 65536;
+
+      /// \brief Messages pending to be published for a [topic, type] pair.
+      public: struct BatchDetails
+              {
+                /// \brief Coalesced records.
+                public: std::string buffer;
+
+                /// \brief Time when the batch has to be published.
+                public: std::chrono::steady_clock::time_point deadline;
+              };
+
+      /// \brief Thread used to publish the batches, started when the first
+      /// batched topic is advertised.
+      public: std::thread batchThread;
+
+      /// \brief Mutex to protect the batches.
+      public: std::mutex batchMutex;
+
+      /// \brief Pending batches indexed by [topic, message type].
+      public: std::map<std::pair<std::string, std::string>,
+                       BatchDetails> batches;
+
+      /// \brief Batches which reached kMaxBatchSize, in the order they
+      /// filled up, waiting for the batch thread to publish them.
+      public: std::deque<std::pair<std::pair<std::string, std::string>,
+                         BatchDetails>> fullBatches;
+
+      /// \brief Used to signal when a new batch has been created or has
+      /// filled up.
+      public: std::condition_variable signalNewBatch;
     };
     }
   }
@@ -254,3 +254,224 @@ size_t SubscriptionMsg::Unpack(const char *_buffer)
 
   return sizeof(topicLength) + static_cast<size_t>(topicLength);
 }
+
+//////////////////////////////////////////////////
+DigestMsg::DigestMsg(const transport::Header &_header,
+                     const uint64_t _seq,
+                     const uint64_t _digest,
+                     const uint64_t _hostDigest,
+                     const uint32_t _syncs)
+{
+  this->SetHeader(_header);
+  this->SetSeq(_seq);
+  this->SetDigest(_digest);
+  this->SetHostDigest(_hostDigest);
+  this->SetSyncs(_syncs);
+}
+
+//////////////////////////////////////////////////
+transport::Header DigestMsg::Header() const
+{
+  return this->header;
+}
+
+//////////////////////////////////////////////////
+uint64_t DigestMsg::Seq() const
+{
+  return this->seq;
+}
+
+//////////////////////////////////////////////////
+uint64_t DigestMsg::Digest() const
+{
+  return this->digest;
+}
+
+//////////////////////////////////////////////////
+uint64_t DigestMsg::HostDigest() const
+{
+  return this->hostDigest;
+}
+
+//////////////////////////////////////////////////
+uint32_t DigestMsg::Syncs() const
+{
+  return this->syncs;
+}
+
+//////////////////////////////////////////////////
+void DigestMsg::SetHeader(const transport::Header &_header)
+{
+  this->header = _header;
+}
+
+//////////////////////////////////////////////////
+void DigestMsg::SetSeq(const uint64_t _seq)
+{
+  this->seq = _seq;
+}
+
+//////////////////////////////////////////////////
+void DigestMsg::SetDigest(const uint64_t _digest)
+{
+  this->digest = _digest;
+}
+
+//////////////////////////////////////////////////
+void DigestMsg::SetHostDigest(const uint64_t _digest)
+{
+  this->hostDigest = _digest;
+}
+
+//////////////////////////////////////////////////
+void DigestMsg::SetSyncs(const uint32_t _syncs)
+{
+  this->syncs = _syncs;
+}
+
+//////////////////////////////////////////////////
+size_t DigestMsg::MsgLength() const
+{
+  return this->header.HeaderLength() + sizeof(this->seq) +
+    sizeof(this->digest) + sizeof(this->hostDigest) + sizeof(this->syncs);
+}
+
+//////////////////////////////////////////////////
+size_t DigestMsg::Pack(char *_buffer) const
+{
+  // Pack the header.
+  size_t headerLen = this->Header().Pack(_buffer);
+  if (headerLen == 0)
+    return 0;
+
+  _buffer += headerLen;
+
+  // Pack the sequence number.
+  memcpy(_buffer, &this->seq, sizeof(this->seq));
+  _buffer += sizeof(this->seq);
+
+  // Pack the digests.
+  memcpy(_buffer, &this->digest, sizeof(this->digest));
+  _buffer += sizeof(this->digest);
+  memcpy(_buffer, &this->hostDigest, sizeof(this->hostDigest));
+  _buffer += sizeof(this->hostDigest);
+
+  // Pack the number of dumps.
+  memcpy(_buffer, &this->syncs, sizeof(this->syncs));
+
+  return this->MsgLength();
+}
+
+//////////////////////////////////////////////////
+size_t DigestMsg::Unpack(const char *_buffer)
+{
+  // null buffer.
+  if (!_buffer)
+  {
+    std::cerr << "DigestMsg::Unpack() error: NULL input buffer" << std::endl;
+    return 0;
+  }
+
+  // Unpack the sequence number.
+  memcpy(&this->seq, _buffer, sizeof(this->seq));
+  _buffer += sizeof(this->seq);
+
+  // Unpack the digests.
+  memcpy(&this->digest, _buffer, sizeof(this->digest));
+  _buffer += sizeof(this->digest);
+  memcpy(&this->hostDigest, _buffer, sizeof(this->hostDigest));
+  _buffer += sizeof(this->hostDigest);
+
+  // Unpack the number of dumps.
+  memcpy(&this->syncs, _buffer, sizeof(this->syncs));
+
+  return sizeof(this->seq) + sizeof(this->digest) + sizeof(this->hostDigest) +
+    sizeof(this->syncs);
+}
+
+//////////////////////////////////////////////////
+SyncMsg::SyncMsg(const transport::Header &_header,
+                 const std::string &_target)
+{
+  this->SetHeader(_header);
+  this->SetTarget(_target);
+}
+
+//////////////////////////////////////////////////
+transport::Header SyncMsg::Header() const
+{
+  return this->header;
+}
+
+//////////////////////////////////////////////////
+std::string SyncMsg::Target() const
+{
+  return this->target;
+}
+
+//////////////////////////////////////////////////
+void SyncMsg::SetHeader(const transport::Header &_header)
+{
+  this->header = _header;
+}
+
+//////////////////////////////////////////////////
+void SyncMsg::SetTarget(const std::string &_target)
+{
+  this->target = _target;
+}
+
+//////////////////////////////////////////////////
+size_t SyncMsg::MsgLength() const
+{
+  return this->header.HeaderLength() + sizeof(uint16_t) + this->target.size();
+}
+
+//////////////////////////////////////////////////
+size_t SyncMsg::Pack(char *_buffer) const
+{
+  // Pack the header.
+  size_t headerLen = this->Header().Pack(_buffer);
+  if (headerLen == 0)
+    return 0;
+
+  if (this->target == "")
+  {
+    std::cerr << "SyncMsg::Pack() error: You're trying to pack a "
+              << "message with an empty target" << std::endl;
+    return 0;
+  }
+
+  _buffer += headerLen;
+
+  // Pack the target length.
+  uint16_t targetLength = static_cast<uint16_t>(this->target.size());
+  memcpy(_buffer, &targetLength, sizeof(targetLength));
+  _buffer += sizeof(targetLength);
+
+  // Pack the target.
+  memcpy(_buffer, this->target.data(), static_cast<size_t>(targetLength));
+
+  return this->MsgLength();
+}
+
+//////////////////////////////////////////////////
+size_t SyncMsg::Unpack(const char *_buffer)
+{
+  // null buffer.
+  if (!_buffer)
+  {
+    std::cerr << "SyncMsg::Unpack() error: NULL input buffer" << std::endl;
+    return 0;
+  }
+
+  // Unpack the target length.
+  uint16_t targetLength;
+  memcpy(&targetLength, _buffer, sizeof(targetLength));
+  _buffer += sizeof(targetLength);
+
+  // Unpack the target.
+  this->target = std::string(_buffer, _buffer + targetLength);
+
+  return sizeof(targetLength) + static_cast<size_t>(targetLength);
+}
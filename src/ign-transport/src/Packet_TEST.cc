@@ -199,6 +199,88 @@ TEST(PacketTest, SubscriptionIO)
   EXPECT_EQ(otherSubMsg.Unpack(nullptr), 0u);
 }
 
+//////////////////////////////////////////////////
+/// \brief Check the serialization and unserialization of a DIGEST message.
+TEST(PacketTest, DigestIO)
+{
+  std::string pUuid = "Process-UUID-1";
+  uint8_t version   = 1;
+
+  // Try to pack an empty DigestMsg.
+  DigestMsg emptyMsg;
+  std::vector<char> buffer(emptyMsg.MsgLength());
+  EXPECT_EQ(emptyMsg.Pack(&buffer[0]), 0u);
+
+  // Pack a DigestMsg.
+  Header otherHeader(version, pUuid, DigestType, 3);
+  DigestMsg digestMsg(otherHeader, 42u, 0xDEADBEEFCAFEu, 7u, 3u);
+  buffer.resize(digestMsg.MsgLength());
+  size_t bytes = digestMsg.Pack(&buffer[0]);
+  EXPECT_EQ(bytes, digestMsg.MsgLength());
+
+  // Unpack a DigestMsg.
+  Header header;
+  DigestMsg otherDigestMsg;
+  size_t headerBytes = header.Unpack(&buffer[0]);
+  EXPECT_EQ(headerBytes, static_cast<size_t>(header.HeaderLength()));
+  EXPECT_EQ(header.Type(), DigestType);
+  otherDigestMsg.SetHeader(header);
+  char *pBody = &buffer[0] + header.HeaderLength();
+  size_t bodyBytes = otherDigestMsg.Unpack(pBody);
+
+  // Check that after Pack() and Unpack() the data does not change.
+  EXPECT_EQ(otherDigestMsg.Seq(), 42u);
+  EXPECT_EQ(otherDigestMsg.Digest(), 0xDEADBEEFCAFEu);
+  EXPECT_EQ(otherDigestMsg.HostDigest(), 7u);
+  EXPECT_EQ(otherDigestMsg.Syncs(), 3u);
+  EXPECT_EQ(bodyBytes, otherDigestMsg.MsgLength() -
+            otherDigestMsg.Header().HeaderLength());
+
+  // Try to pack a DigestMsg passing a NULL buffer.
+  EXPECT_EQ(otherDigestMsg.Pack(nullptr), 0u);
+
+  // Try to unpack a DigestMsg passing a NULL buffer.
+  EXPECT_EQ(otherDigestMsg.Unpack(nullptr), 0u);
+}
+
+//////////////////////////////////////////////////
+/// \brief Check the serialization and unserialization of a SYNC message.
+TEST(PacketTest, SyncIO)
+{
+  std::string pUuid = "Process-UUID-1";
+  uint8_t version   = 1;
+
+  // Pack a SyncMsg with an empty target.
+  Header otherHeader(version, pUuid, SyncType);
+  SyncMsg incompleteMsg(otherHeader, "");
+  std::vector<char> buffer(incompleteMsg.MsgLength());
+  EXPECT_EQ(0u, incompleteMsg.Pack(&buffer[0]));
+
+  // Pack a SyncMsg.
+  std::string target = "Process-UUID-2";
+  SyncMsg syncMsg(otherHeader, target);
+  buffer.resize(syncMsg.MsgLength());
+  size_t bytes = syncMsg.Pack(&buffer[0]);
+  EXPECT_EQ(bytes, syncMsg.MsgLength());
+
+  // Unpack a SyncMsg.
+  Header header;
+  SyncMsg otherSyncMsg;
+  header.Unpack(&buffer[0]);
+  otherSyncMsg.SetHeader(header);
+  char *pBody = &buffer[0] + header.HeaderLength();
+  size_t bodyBytes = otherSyncMsg.Unpack(pBody);
+
+  // Check that after Pack() and Unpack() the data does not change.
+  EXPECT_EQ(otherSyncMsg.Target(), target);
+  EXPECT_EQ(bodyBytes, otherSyncMsg.MsgLength() -
+            otherSyncMsg.Header().HeaderLength());
+
+  std::ostringstream output;
+  output << otherSyncMsg;
+  EXPECT_NE(output.str().find("SYNC"), std::string::npos);
+}
+
 //////////////////////////////////////////////////
 /// \brief Check the basic API for creating/reading an ADV message.
 TEST(PacketTest, BasicAdvertiseMsgAPI)
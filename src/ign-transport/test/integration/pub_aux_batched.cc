@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include <ignition/msgs.hh>
+
+#include "gtest/gtest.h"
+#include "ignition/transport/Node.hh"
+#include "ignition/transport/test_config.h"
+
+using namespace ignition;
+
+static std::string g_topic = "/foo"; // NOLINT(*)
+
+//////////////////////////////////////////////////
+/// \brief A publisher node with batching enabled. It publishes a sequence of
+/// numbers, first as fast as possible, so that some batches fill up before
+/// their window expires, then slowly, so that the window flushes the batches.
+void advertiseAndPublish()
+{
+  transport::Node node;
+  ignition::transport::AdvertiseMessageOptions opts;
+  opts.SetBatchWindow(std::chrono::milliseconds(5));
+
+  auto pub = node.Advertise<ignition::msgs::Int32>(g_topic, opts);
+  std::this_thread::sleep_for(std::chrono::milliseconds(500));
+
+  ignition::msgs::Int32 msg;
+  int data = 0;
+  for (; data < 20000; ++data)
+  {
+    msg.set_data(data);
+    EXPECT_TRUE(pub.Publish(msg));
+  }
+
+  for (; data < 20010; ++data)
+  {
+    msg.set_data(data);
+    EXPECT_TRUE(pub.Publish(msg));
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(500));
+}
+
+//////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  if (argc < 2)
+  {
+    std::cerr << "Partition name has not be passed as argument" << std::endl;
+    return -1;
+  }
+
+  // Set the partition name for this test.
+  setenv("IGN_PARTITION", argv[1], 1);
+
+  advertiseAndPublish();
+}
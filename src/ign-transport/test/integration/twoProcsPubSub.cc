@@ -16,7 +16,10 @@
 */
 
 #include <chrono>
+#include <functional>
+#include <mutex>
 #include <string>
+#include <vector>
 #include <ignition/msgs.hh>
 
 #include "gtest/gtest.h"
@@ -418,6 +421,38 @@ TEST(twoProcPubSub, PubThrottled)
   testing::waitAndCleanupFork(pi);
 }
 
+//////////////////////////////////////////////////
+/// \brief This test creates one publisher and one subscriber on different
+/// processes. The publisher batches its messages. Check that all the messages
+/// are unbatched by the subscriber, in the order they were published.
+TEST(twoProcPubSub, PubBatched)
+{
+  std::string publisherPath = testing::portablePathUnion(
+     IGN_TRANSPORT_TEST_DIR, "INTEGRATION_pub_aux_batched");
+
+  testing::forkHandlerType pi = testing::forkAndRun(publisherPath.c_str(),
+    partition.c_str());
+
+  std::mutex mutex;
+  std::vector<int> received;
+  std::function<void(const ignition::msgs::Int32 &)> cbBatched =
+    [&](const ignition::msgs::Int32 &_msg)
+    {
+      std::lock_guard<std::mutex> lk(mutex);
+      received.push_back(_msg.data());
+    };
+
+  transport::Node node;
+  EXPECT_TRUE(node.Subscribe(g_topic, cbBatched));
+
+  testing::waitAndCleanupFork(pi);
+
+  std::lock_guard<std::mutex> lk(mutex);
+  ASSERT_EQ(20010u, received.size());
+  for (int i = 0; i < static_cast<int>(received.size()); ++i)
+    ASSERT_EQ(i, received[i]);
+}
+
 //////////////////////////////////////////////////
 /// \brief Check that a message is received after Advertise->Subscribe->Publish
 /// using a callback that accepts message information.